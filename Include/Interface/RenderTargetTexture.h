@@ -8,12 +8,15 @@
 #include "Types/Matrix4.hpp"
 #include "Types/Transform.h"
 #include "Types/Color.hpp"
+#include "Types/MeshPrimitives.hpp"
 #include "Types/Multisamples.h"
 #include "Types/RenderCoordinateSpace.hpp"
+#include "Types/DescriptorCacheStatistics.h"
 
 #include "Interface/Texture.h"
 
 #include <memory>
+#include <functional>
 
 namespace vk2d {
 
@@ -448,6 +451,32 @@ public:
 		const vk2d::Mesh									&	mesh,
 		const std::vector<vk2d::Matrix4f>					&	transformations );
 
+	/// @brief		Request a copy of the render target texture contents back to the host without
+	///				waiting for the GPU. Contents are copied at the end of the next render of this
+	///				render target texture into one of a few host cached staging buffers that are
+	///				reused between requests. Once the GPU has finished that render, usually a few
+	///				frames later, texels are handed to the callback. Nothing ever waits for the GPU,
+	///				finished readbacks are checked at every vk2d::RenderTargetTexture::BeginRender()
+	///				and after every vk2d::Window::EndRender(), so the callback arrives even if this
+	///				render target texture is not rendered again. Useful for thumbnails and exporting
+	///				images.
+	/// @note		Multithreading: Main thread only. Callback is called from the main thread, inside
+	///				vk2d::RenderTargetTexture::BeginRender(), vk2d::Window::EndRender() or when the
+	///				render target texture is destroyed.
+	/// @param[in]	callback
+	///				Called once with the texels of mip level 0 and true, or with empty image data and
+	///				false if the readback could not be done or the render target texture was destroyed
+	///				before it was rendered again.
+	/// @return		true if the readback was requested, false if every staging buffer is already in use,
+	///				try again after the next render.
+	VK2D_API bool												VK2D_APIENTRY				RequestReadback(
+		std::function<void( const vk2d::ImageData & image_data, bool success )>	callback );
+
+	/// @brief		Get texture and sampler descriptor set cache totals of this render target texture.
+	/// @note		Multithreading: Main thread only.
+	/// @return		Descriptor set cache totals, texture and sampler caches combined.
+	VK2D_API vk2d::DescriptorCacheStatistics					VK2D_APIENTRY				GetDescriptorCacheStatistics() const;
+
 	/// @brief		VK2D class object checker function.
 	/// @note		Multithreading: Any thread.
 	/// @return		true if class object was created successfully,
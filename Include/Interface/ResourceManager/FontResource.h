@@ -6,6 +6,7 @@
 #include "Types/Vector2.hpp"
 
 #include <filesystem>
+#include <string_view>
 
 namespace vk2d {
 
@@ -101,6 +102,11 @@ class FontResource
 	///				together in the final render, to decrease the amount of this
 	///				"UV bleeding" you can increase the gap between glyphs in the texture
 	///				atlas here.
+	/// @param[in]	load_glyphs_on_demand
+	///				Render glyphs when they're first used instead of while loading.
+	///				See vk2d::ResourceManager::LoadFontResource().
+	/// @param[in]	preload_characters
+	///				Characters rendered while loading if glyphs are loaded on demand.
 	VK2D_API																					FontResource(
 		vk2d::_internal::ResourceManagerImpl			*	resource_manager,
 		uint32_t											loader_thread_index,
@@ -109,7 +115,51 @@ class FontResource
 		uint32_t											glyph_texel_size,
 		bool												use_alpha,
 		uint32_t											fallback_character,
-		uint32_t											glyph_atlas_padding );
+		uint32_t											glyph_atlas_padding,
+		bool												load_glyphs_on_demand,
+		std::string_view									preload_characters );
+
+	/// @brief		This constructor is meant for internal use only. All resources are
+	///				created from vk2d::ResourceManager only.
+	/// @note		Multithreading: Any thread, selected managed by vk2d::ResourceManager.
+	/// @param[in]	resource_manager
+	///				Pointer to resource manager implementation object responsible for
+	///				creating this resource.
+	/// @param[in]	loader_thread_index
+	///				Index to thread pool thread index. Tells which thread pool thread
+	///				is responsible for creation and destruction of the internal data
+	///				of this resource.
+	/// @param[in]	parent_resource
+	///				Pointer to a resource that owns this resource.
+	/// @param[in]	font_file_data
+	///				Pointer to a font file in memory, not copied.
+	///				See vk2d::ResourceManager::LoadFontResourceFromMemory().
+	/// @param[in]	font_file_size
+	///				Size of the font file in bytes.
+	/// @param[in]	glyph_texel_size
+	///				See the file path constructor.
+	/// @param[in]	use_alpha
+	///				See the file path constructor.
+	/// @param[in]	fallback_character
+	///				See the file path constructor.
+	/// @param[in]	glyph_atlas_padding
+	///				See the file path constructor.
+	/// @param[in]	load_glyphs_on_demand
+	///				See the file path constructor.
+	/// @param[in]	preload_characters
+	///				See the file path constructor.
+	VK2D_API																					FontResource(
+		vk2d::_internal::ResourceManagerImpl			*	resource_manager,
+		uint32_t											loader_thread_index,
+		vk2d::Resource									*	parent_resource,
+		const void										*	font_file_data,
+		size_t												font_file_size,
+		uint32_t											glyph_texel_size,
+		bool												use_alpha,
+		uint32_t											fallback_character,
+		uint32_t											glyph_atlas_padding,
+		bool												load_glyphs_on_demand,
+		std::string_view									preload_characters );
 
 public:
 	VK2D_API																					~FontResource();
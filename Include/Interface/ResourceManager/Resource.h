@@ -28,6 +28,26 @@ enum class ResourceStatus
 
 
 
+/// @brief		Time spent in each phase of loading a resource, phases that don't apply to
+///				the resource are zero. Only the first load is timed.
+/// @see		vk2d::Resource::GetLoadTiming()
+struct ResourceLoadTiming {
+	std::chrono::nanoseconds				queue_wait						= {};			///< From scheduling the load until a loader thread started it.
+	std::chrono::nanoseconds				file_read						= {};			///< Reading image files, font files are read by FreeType during decode. Summed over layers decoded in parallel.
+	std::chrono::nanoseconds				decode							= {};			///< Decoding images, or opening font faces. Summed over layers decoded in parallel.
+	std::chrono::nanoseconds				mip_generation					= {};			///< Making mip levels on the CPU or reading them from the mip cache, see vk2d::ResourceManager::SetTextureMipGeneration(). Summed over layers decoded in parallel.
+	std::chrono::nanoseconds				staging_copy					= {};			///< Copying texels to GPU visible staging memory.
+	std::chrono::nanoseconds				upload_record					= {};			///< Creating the image and recording upload and mip map commands.
+	std::chrono::nanoseconds				gpu_upload						= {};			///< From submitting the upload until it was seen finished, includes mip map generation.
+	std::chrono::nanoseconds				glyph_rasterization				= {};			///< Measuring and rendering glyphs into font atlases, glyphs are rendered in parallel.
+	std::chrono::nanoseconds				glyph_rasterization_thread_total	= {};		///< Glyph rendering summed over every thread that took part, about what rendering would take on a single thread.
+	std::chrono::nanoseconds				total							= {};			///< From scheduling the load until the status was known.
+	uint64_t								source_bytes					= {};			///< Bytes read from files or memory.
+	uint64_t								uploaded_bytes					= {};			///< Bytes uploaded to the GPU, without mip maps.
+};
+
+
+
 /// @brief		VK2D resource is an object that has background loading capability.
 ///				vk2d::Resource is meant to be used in situations where somewhat significant
 ///				amount of time is required to prepare some data for later use, such as
@@ -113,6 +133,12 @@ public:
 	/// @return		List of file paths.
 	VK2D_API const std::vector<std::filesystem::path>	&	VK2D_APIENTRY						GetFilePaths() const;
 
+	/// @brief		Get how long each phase of loading this resource took.
+	/// @note		Multithreading: Any thread.
+	/// @return		Load timing, only complete once the resource status is no longer
+	///				vk2d::ResourceStatus::UNDETERMINED.
+	VK2D_API vk2d::ResourceLoadTiming						VK2D_APIENTRY						GetLoadTiming() const;
+
 	/// @brief		VK2D class object checker function.
 	/// @note		Multithreading: Any thread.
 	/// @return		true if class object was created successfully,
@@ -7,6 +7,9 @@
 
 #include <memory>
 #include <filesystem>
+#include <functional>
+#include <string_view>
+#include <vector>
 
 namespace vk2d {
 
@@ -22,6 +25,68 @@ class ResourceManagerImpl;
 
 
 
+/// @brief		Output format of vk2d::ResourceManager::GetLoadTimingReport().
+enum class LoadTimingReportFormat : uint32_t
+{
+	JSON		= 0,	///< Object with a summary and an array of resources.
+	CSV,				///< Row for every resource and a last row with totals.
+};
+
+/// @brief		Totals of everything vk2d::ResourceManager::DefragmentMemory() has done so far.
+struct MemoryDefragmentationReport {
+	uint64_t								moved_bytes						= {};			///< Bytes copied to another memory location.
+	uint64_t								moved_resource_count			= {};			///< Number of resources moved.
+	uint64_t								reclaimed_bytes					= {};			///< Bytes of device memory released back to the driver.
+	uint64_t								released_chunk_count			= {};			///< Number of device memory allocations released back to the driver.
+};
+
+/// @brief		State and totals of texture residency, see vk2d::ResourceManager::SetTextureResidencyBudget().
+struct TextureResidencyReport {
+	uint64_t								budget							= {};			///< Texture memory budget in bytes, 0 if texture residency is disabled.
+	uint64_t								resident_bytes					= {};			///< Device memory used by texture images at the last update.
+	uint64_t								evicted_texture_count			= {};			///< Textures evicted at the last update.
+	uint64_t								eviction_count					= {};			///< Times any texture has been evicted.
+	uint64_t								reload_count					= {};			///< Times any evicted texture has been loaded again.
+};
+
+/// @brief		How mip levels of textures loaded from images are made, see
+///				vk2d::ResourceManager::SetTextureMipGeneration().
+enum class TextureMipFilter : uint32_t
+{
+	GPU_LINEAR		= 0,	///< Blitted on the GPU with a linear filter. Fastest, but not gamma correct and blurry on small mip levels.
+	BOX,					///< Average of 2 * 2 texels on the CPU, softest of the CPU filters.
+	KAISER,					///< Kaiser windowed sinc on the CPU, sharp with very little ringing. Good default for the CPU filters.
+	LANCZOS,				///< Lanczos 3 windowed sinc on the CPU, sharpest but may ring around hard edges.
+};
+
+/// @brief		Settings of vk2d::ResourceManager::SetTextureMipGeneration().
+struct TextureMipGenerationSettings {
+	vk2d::TextureMipFilter					filter							= vk2d::TextureMipFilter::GPU_LINEAR;	///< Filter used to make the mip levels.
+	bool									gamma_correct					= true;			///< CPU filters average sRGB colors in linear light, alpha is always linear.
+	bool									use_cache						= false;		///< Store mip levels made on the CPU to files and use them on later loads.
+	std::filesystem::path					cache_directory					= {};			///< Directory of the mip level files. If empty, files are stored next to the images as "<image file name>.vk2dmips".
+};
+
+/// @brief		Totals of how often loads were served from already existing resources.
+///				Hit rate is hit_count / lookup_count.
+struct ResourceCacheStatistics {
+	uint64_t								lookup_count					= {};			///< File loads that could be shared.
+	uint64_t								hit_count						= {};			///< File loads that returned an already existing resource.
+	uint64_t								cached_resource_count			= {};			///< Resources currently shared through the cache.
+};
+
+
+/// @brief		Progress of a single vk2d::ResourceManager::LoadTextureResources() call.
+///				Batch is done when uploaded_count + failed_count == total_count.
+struct TextureBatchLoadProgress {
+	uint32_t								total_count						= {};			///< Textures loaded by the batch, already existing textures are not counted.
+	uint32_t								decoded_count					= {};			///< Textures decoded and copied to staging memory.
+	uint32_t								uploaded_count					= {};			///< Textures uploaded to the GPU and ready to use.
+	uint32_t								failed_count					= {};			///< Textures that failed to load.
+};
+
+
+
 /// @brief		VK2D Is capable of loading and unloading resources in a background thread,
 ///				and vk2d::ResourceManager is responsible of making it happen.
 class ResourceManager {
@@ -50,13 +115,17 @@ public:
 	///				- This data is copied over to internal memory before returning so
 	///				you do not need to keep the vector around.
 	/// @return		Handle to newly created texture resource you can use when rendering.
+	///				Resources created from texel data are never shared, every call creates
+	///				a new resource.
 	VK2D_API TextureResource								*	VK2D_APIENTRY				CreateTextureResource(
 		vk2d::Vector2u											size,
 		const std::vector<vk2d::Color8>						&	texels );
 
 	/// @brief		Load a single layer texture resource from a file. File format is always
 	///				converted to 8 bits-per-channel RGBA format internally regardless of file
-	///				format used. No HDRI support.
+	///				format used. No HDRI support. KTX2 and DDS files are the exception, they're
+	///				uploaded in the format they're stored in along with their mip levels and
+	///				array layers.
 	/// @note		Multithreading: Any thread.
 	/// @param[in]	file_path
 	///				File path to the texture. Internally VK2D uses stb image loading library so
@@ -88,11 +157,66 @@ public:
 	///					<tr>
 	///						<td>PNM</td>	<td>PPM and PGM binary only</td>
 	///					</tr>
+	///					<tr>
+	///						<td>QOI</td>	<td>RGB and RGBA, lossless like PNG but many times faster to load</td>
+	///					</tr>
+	///					<tr>
+	///						<td>KTX2</td>	<td>2D and 2D array textures, RGBA8, BGRA8 and BC1 to BC7, no supercompression or cube maps</td>
+	///					</tr>
+	///					<tr>
+	///						<td>DDS</td>	<td>2D and 2D array textures, RGBA8, BGRA8 and BC1 to BC7, no cube maps or volume textures</td>
+	///					</tr>
 	///				</table>
+	///				- KTX2 and DDS files may contain all mip levels, those are used instead
+	///				of generating them. Block compressed files without mip levels have no
+	///				mip levels.
+	///				- Block compressed formats are decoded to RGBA when the GPU does not
+	///				support them. sRGB formats are treated as UNORM.
 	/// @return		Handle to newly created texture resource you can use when rendering.
 	VK2D_API vk2d::TextureResource							*	VK2D_APIENTRY				LoadTextureResource(
 		const std::filesystem::path							&	file_path );
 
+	/// @brief		Load a texture resource from an encoded image file that is already in
+	///				memory, for example read from an archive or a memory mapped file.
+	///				Decoding reads the memory in place, it's not copied.
+	/// @note		Multithreading: Any thread.
+	/// @warning	The memory is owned by the caller and must stay valid and unchanged
+	///				until the resource has finished loading, that is until
+	///				vk2d::Resource::WaitUntilLoaded() returns or
+	///				vk2d::Resource::GetStatus() no longer returns
+	///				vk2d::ResourceStatus::UNDETERMINED. It can be released after that.
+	/// @param[in]	encoded_image_data
+	///				Pointer to the beginning of the encoded image. Supported file formats
+	///				are listed in vk2d::ResourceManager::LoadTextureResource().
+	/// @param[in]	encoded_image_size
+	///				Size of the encoded image in bytes.
+	/// @return		Handle to newly created texture resource you can use when rendering.
+	///				Resources loaded from memory are never shared, every call creates a
+	///				new resource.
+	VK2D_API vk2d::TextureResource							*	VK2D_APIENTRY				LoadTextureResourceFromMemory(
+		const void											*	encoded_image_data,
+		size_t													encoded_image_size );
+
+	/// @brief		Load many single layer texture resources at once. Works like calling
+	///				vk2d::ResourceManager::LoadTextureResource() for every file but GPU uploads
+	///				of the whole batch are submitted together and tracked with a single fence,
+	///				which is much faster when loading hundreds or thousands of small textures.
+	///				Files are still decoded in parallel in the resource loader threads.
+	/// @note		Multithreading: Any thread.
+	/// @param[in]	file_paths
+	///				File paths to the textures, supported file formats are listed in
+	///				vk2d::ResourceManager::LoadTextureResource().
+	/// @param[in]	progress_callback
+	///				Optional. Called every time a texture has been decoded or has failed to
+	///				load, and once more when the batch has been uploaded to the GPU. Called
+	///				from internal threads, one call at a time.
+	/// @return		Handles to texture resources in the same order as file_paths. Entry is
+	///				nullptr if the resource could not be created. Each texture is destroyed
+	///				individually with vk2d::ResourceManager::DestroyResource().
+	VK2D_API std::vector<vk2d::TextureResource*>				VK2D_APIENTRY				LoadTextureResources(
+		const std::vector<std::filesystem::path>			&	file_paths,
+		std::function<void( const vk2d::TextureBatchLoadProgress & )>	progress_callback	= {} );
+
 	/// @brief		Create a multi-layer texture resource from data.
 	/// @note		Multithreading: Any thread.
 	/// @param[in]	size
@@ -109,6 +233,8 @@ public:
 	///				- This data is copied over to internal memory before returning so you do
 	///				not need to keep the vector around.
 	/// @return		Handle to newly created texture resource you can use when rendering.
+	///				Resources created from texel data are never shared, every call creates
+	///				a new resource.
 	VK2D_API TextureResource								*	VK2D_APIENTRY				CreateArrayTextureResource(
 		vk2d::Vector2u											size,
 		const std::vector<const std::vector<vk2d::Color8>*>	&	texels_listing );
@@ -124,6 +250,8 @@ public:
 	///				texture array layer 1.
 	///				- Each texture layer must be the same size. If images in these file paths
 	///				are not same size then texture loading will fail.
+	///				- KTX2 and DDS files contain their own array layers, load them with
+	///				vk2d::ResourceManager::LoadTextureResource() instead.
 	/// @return		Handle to newly created texture resource you can use when rendering.
 	VK2D_API vk2d::TextureResource							*	VK2D_APIENTRY				LoadArrayTextureResource(
 		const std::vector<std::filesystem::path>			&	file_path_listing );
@@ -207,13 +335,93 @@ public:
 	///				together in the final render, to decrease the amount of this
 	///				"UV bleeding" you can increase the gap between glyphs in the texture
 	///				atlas here.
+	/// @param[in]	load_glyphs_on_demand
+	///				If false, every glyph of every face in the font is rendered into the
+	///				texture atlas while loading. If true, only the fallback character and
+	///				the characters in preload_characters are rendered while loading, other
+	///				glyphs are rendered and added to the atlas the first time they're used
+	///				by vk2d::GenerateTextMesh() or vk2d::FontResource::CalculateRenderedSize().
+	///				Large fonts load a lot faster and use a lot less memory this way as
+	///				applications rarely use more than a few hundred characters. New glyphs
+	///				are uploaded to the GPU when text is generated on the main thread, text
+	///				generated on other threads may show glyphs that are new to the font
+	///				only after text has been generated on the main thread once. When the
+	///				atlas needs another page a larger texture is loaded in the background,
+	///				glyphs on the new page are left out of generated text until then. The
+	///				previous texture is destroyed once frames that used it are done, text
+	///				meshes generated before that must be generated again to be drawn.
+	/// @param[in]	preload_characters
+	///				Characters rendered while loading if load_glyphs_on_demand is true,
+	///				eg. the characters the application shows first. Ignored otherwise.
 	/// @return		Handle to newly created font resource you can use when rendering text.
 	VK2D_API vk2d::FontResource								*	VK2D_APIENTRY				LoadFontResource(
 		const std::filesystem::path							&	file_path,
 		uint32_t												glyph_texel_size			= 32,
 		bool													use_alpha					= true,
 		uint32_t												fallback_character			= '*',
-		uint32_t												glyph_atlas_padding			= 8 );
+		uint32_t												glyph_atlas_padding			= 8,
+		bool													load_glyphs_on_demand		= false,
+		std::string_view										preload_characters			= {} );
+
+	/// @brief		Load a font resource from a font file that is already in memory, for
+	///				example read from an archive or a memory mapped file. FreeType reads
+	///				the memory in place, it's not copied.
+	/// @note		Multithreading: Any thread.
+	/// @warning	The memory is owned by the caller and must stay valid and unchanged
+	///				until the resource has finished loading, that is until
+	///				vk2d::Resource::WaitUntilLoaded() returns or
+	///				vk2d::Resource::GetStatus() no longer returns
+	///				vk2d::ResourceStatus::UNDETERMINED. It can be released after that.
+	/// @param[in]	font_file_data
+	///				Pointer to the beginning of the font file. Supported formats are listed
+	///				in vk2d::ResourceManager::LoadFontResource().
+	/// @param[in]	font_file_size
+	///				Size of the font file in bytes.
+	/// @param[in]	glyph_texel_size
+	///				See vk2d::ResourceManager::LoadFontResource().
+	/// @param[in]	use_alpha
+	///				See vk2d::ResourceManager::LoadFontResource().
+	/// @param[in]	fallback_character
+	///				See vk2d::ResourceManager::LoadFontResource().
+	/// @param[in]	glyph_atlas_padding
+	///				See vk2d::ResourceManager::LoadFontResource().
+	/// @param[in]	load_glyphs_on_demand
+	///				See vk2d::ResourceManager::LoadFontResource(). Fonts that load glyphs on
+	///				demand keep a copy of the font file, the memory can still be released
+	///				after loading.
+	/// @param[in]	preload_characters
+	///				See vk2d::ResourceManager::LoadFontResource().
+	/// @return		Handle to newly created font resource you can use when rendering text.
+	///				Resources loaded from memory are never shared, every call creates a
+	///				new resource.
+	VK2D_API vk2d::FontResource								*	VK2D_APIENTRY				LoadFontResourceFromMemory(
+		const void											*	font_file_data,
+		size_t													font_file_size,
+		uint32_t												glyph_texel_size			= 32,
+		bool													use_alpha					= true,
+		uint32_t												fallback_character			= '*',
+		uint32_t												glyph_atlas_padding			= 8,
+		bool													load_glyphs_on_demand		= false,
+		std::string_view										preload_characters			= {} );
+
+	/// @brief		Mount an asset pack. Asset packs contain many files in a single file,
+	///				which is a lot faster to load than thousands of small loose files. Packs
+	///				are built with the PackAssets tool.
+	///				After mounting, file paths given to vk2d::ResourceManager::LoadTextureResource(),
+	///				vk2d::ResourceManager::LoadTextureResources() and
+	///				vk2d::ResourceManager::LoadFontResource() are first looked up from mounted
+	///				packs, most recently mounted first, and only then from the file system.
+	///				Paths are matched as given, relative to the directory the pack was built
+	///				from, eg. "Data/Textures/Icon.png".
+	/// @note		Multithreading: Any thread.
+	/// @param[in]	pack_path
+	///				File path to the asset pack. The pack is memory mapped and stays
+	///				mapped until the resource manager is destroyed, so the file must not be
+	///				modified while the resource manager exists.
+	/// @return		true if the pack was mounted, false if it could not be opened or is
+	///				not a valid asset pack.
+	VK2D_API bool											VK2D_APIENTRY				MountAssetPack(
+		const std::filesystem::path							&	pack_path );
 
 	/// @brief		Destroy a resource. VK2D does not track resource usage and it does
 	///				not have a garbage collector, it is up to the host application to
@@ -222,6 +430,10 @@ public:
 	///				resources for you, it can be a good idea to manually free some unused
 	///				resources from time to time to save on memory usage, especially for
 	///				larger applications.
+	///				Loading the same file with the same parameters returns the already
+	///				existing resource. Such resources are reference counted, every load
+	///				must be paired with a destroy and the resource is destroyed with the
+	///				last one.
 	/// @note		Multithreading: Any thread.
 	/// @param[in]	resource
 	///				Pointer to vk2d::Resource to destroy. After this the resource is no
@@ -229,6 +441,105 @@ public:
 	VK2D_API void												VK2D_APIENTRY				DestroyResource(
 		vk2d::Resource																	*	resource );
 
+	/// @brief		Incrementally defragment resource memory. Applications that run for a long
+	///				time while loading and unloading textures end up with device memory that
+	///				is only partially used, this moves textures out of the least used memory
+	///				allocations so that those can be released. Work is done in the background
+	///				by the resource loader threads and textures remain usable during the move.
+	///				Call this once per frame, if the previous call is still being processed
+	///				this call does nothing.
+	/// @note		Multithreading: Main thread only. Must not be called between BeginRender()
+	///				and EndRender() of any window or render target texture, such calls do nothing.
+	/// @param[in]	byte_budget
+	///				Maximum amount of bytes to move per call, higher values reclaim memory
+	///				faster but use more GPU time.
+	VK2D_API void												VK2D_APIENTRY				DefragmentMemory(
+		uint64_t												byte_budget					= 8 * 1024 * 1024 );
+
+	/// @brief		Get totals of what memory defragmentation has done so far.
+	/// @see		vk2d::ResourceManager::DefragmentMemory()
+	/// @note		Multithreading: Any thread.
+	/// @return		Memory defragmentation totals.
+	VK2D_API vk2d::MemoryDefragmentationReport					VK2D_APIENTRY				GetMemoryDefragmentationReport() const;
+
+	/// @brief		Limit how much device memory textures may use. Every frame the least
+	///				recently drawn textures are evicted until textures fit in the budget,
+	///				evicted textures are replaced with a low resolution placeholder made
+	///				from their smallest mip levels. When an evicted texture is drawn again
+	///				it's loaded again in the background and the placeholder is shown until
+	///				then. Textures drawn during the latest frame are never evicted.
+	///				Textures loaded from memory owned by the application can't be loaded
+	///				again and are never evicted, textures from asset packs can be.
+	/// @see		vk2d::ResourceManager::UpdateTextureResidency()
+	/// @note		Multithreading: Any thread.
+	/// @param[in]	byte_budget
+	///				Maximum amount of device memory for texture images in bytes, textures
+	///				drawn during the latest frame may still go over it. 0 disables texture
+	///				residency and loads every evicted texture back.
+	/// @param[in]	placeholder_size
+	///				Maximum width and height of evicted texture placeholders in texels.
+	///				1 practically drops the texture until it's used again.
+	VK2D_API void												VK2D_APIENTRY				SetTextureResidencyBudget(
+		uint64_t												byte_budget,
+		uint32_t												placeholder_size			= 16 );
+
+	/// @brief		Evict and reload textures according to how they were used since the
+	///				previous call. Work is done in the background by the resource loader
+	///				threads. Call this once per frame, if the previous call is still
+	///				being processed this call does nothing. Memory of evicted textures is
+	///				released by a later call once frames no longer use it.
+	/// @see		vk2d::ResourceManager::SetTextureResidencyBudget()
+	/// @note		Multithreading: Main thread only. Must not be called between BeginRender()
+	///				and EndRender() of any window or render target texture, such calls do nothing.
+	VK2D_API void												VK2D_APIENTRY				UpdateTextureResidency();
+
+	/// @brief		Get texture residency state and totals.
+	/// @see		vk2d::ResourceManager::SetTextureResidencyBudget()
+	/// @note		Multithreading: Any thread.
+	/// @return		Texture residency state and totals.
+	VK2D_API vk2d::TextureResidencyReport						VK2D_APIENTRY				GetTextureResidencyReport() const;
+
+	/// @brief		Choose how mip levels of textures loaded from images are made. By default
+	///				they are blitted on the GPU, CPU filters make them on the loader threads
+	///				instead which gives better quality at the cost of a slower load. CPU mip
+	///				levels can be stored to files in which case later loads of the same image
+	///				read them from the file and skip both filtering and blitting, files are
+	///				made again if the image, filter or gamma_correct changes. Failing to write
+	///				the files is not an error, the mip levels are just made again next time.
+	///				KTX2 and DDS textures use the mip levels they contain and are never
+	///				filtered. Only textures loaded after this call are affected, textures
+	///				keep using their settings when evicted and loaded again.
+	/// @see		vk2d::TextureMipFilter
+	/// @note		Multithreading: Any thread.
+	/// @param[in]	settings
+	///				Filter and mip level cache settings, see vk2d::TextureMipGenerationSettings.
+	VK2D_API void												VK2D_APIENTRY				SetTextureMipGeneration(
+		const vk2d::TextureMipGenerationSettings			&	settings );
+
+	/// @brief		Get the settings set with vk2d::ResourceManager::SetTextureMipGeneration().
+	/// @note		Multithreading: Any thread.
+	/// @return		Current mip level generation settings.
+	VK2D_API vk2d::TextureMipGenerationSettings					VK2D_APIENTRY				GetTextureMipGeneration() const;
+
+	/// @brief		Get a report of how long loading every existing resource took, broken down
+	///				into load phases, see vk2d::ResourceLoadTiming. Only resources that have
+	///				finished loading are included. Totals include throughput in MB/s of source
+	///				data and textures/s, measured over the time from the earliest load being
+	///				scheduled to the latest load finishing. Times are in milliseconds and
+	///				1 MB is 1024 * 1024 bytes.
+	/// @note		Multithreading: Any thread.
+	/// @param[in]	format
+	///				Report format, see vk2d::LoadTimingReportFormat.
+	/// @return		Report as text in the requested format.
+	VK2D_API std::string										VK2D_APIENTRY				GetLoadTimingReport(
+		vk2d::LoadTimingReportFormat							format						= vk2d::LoadTimingReportFormat::JSON ) const;
+
+	/// @brief		Get totals of how often loads returned an already existing resource.
+	/// @see		vk2d::ResourceManager::DestroyResource()
+	/// @note		Multithreading: Any thread.
+	/// @return		Resource cache totals.
+	VK2D_API vk2d::ResourceCacheStatistics						VK2D_APIENTRY				GetResourceCacheStatistics() const;
+
 	/// @brief		VK2D class object checker function.
 	/// @note		Multithreading: Any thread.
 	/// @return		true if class object was created successfully,
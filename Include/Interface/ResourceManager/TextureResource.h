@@ -3,6 +3,7 @@
 #include "Core/Common.h"
 
 #include "Types/Vector2.hpp"
+#include "Types/Rect2.hpp"
 #include "Types/Color.hpp"
 
 #include "Interface/ResourceManager/Resource.h"
@@ -105,6 +106,30 @@ class TextureResource :
 		vk2d::Vector2u											size,
 		const std::vector<const std::vector<vk2d::Color8>*>	&	texels_listing );
 
+	/// @brief		This constructor is meant for internal use only. All resources are
+	///				created from vk2d::ResourceManager only.
+	/// @note		Multithreading: Any thread, selected managed by vk2d::ResourceManager.
+	/// @param[in]	resource_manager
+	///				Pointer to resource manager implementation object responsible for
+	///				creating this resource.
+	/// @param[in]	loader_thread_index
+	///				Index to thread pool thread index. Tells which thread pool thread
+	///				is responsible for creation and destruction of the internal data
+	///				of this resource.
+	/// @param[in]	parent_resource
+	///				Pointer to a resource that owns this resource.
+	/// @param[in]	encoded_image_data
+	///				Pointer to an encoded image file in memory, not copied.
+	///				See vk2d::ResourceManager::LoadTextureResourceFromMemory().
+	/// @param[in]	encoded_image_size
+	///				Size of the encoded image in bytes.
+	VK2D_API																				TextureResource(
+		vk2d::_internal::ResourceManagerImpl				*	resource_manager,
+		uint32_t												loader_thread,
+		vk2d::Resource										*	parent_resource,
+		const void											*	encoded_image_data,
+		size_t													encoded_image_size );
+
 public:
 	VK2D_API																				~TextureResource();
 
@@ -155,6 +180,42 @@ public:
 	/// @return		Number of layers in this texture.
 	VK2D_API uint32_t											VK2D_APIENTRY				GetLayerCount() const;
 
+	/// @brief		Writes new texels into an area of an already loaded texture, without
+	///				creating a new texture. Meant for textures that change often, like video
+	///				frames or minimaps. Texels are copied into a staging buffer before this
+	///				returns and the copy to the texture is submitted to the GPU right away,
+	///				frames submitted after this see the new texels. Two updates can be in
+	///				flight at a time, a third one waits for the oldest one to finish on the GPU.
+	///				Only textures with 8 bits per channel RGBA format can be updated, this
+	///				excludes KTX2 and DDS textures stored in other formats.
+	/// @note		Multithreading: Main thread only.
+	/// @note		Textures loaded more than once from the same file are shared, see
+	///				vk2d::ResourceManager::DestroyResource(), and can not be updated while
+	///				shared. Once updated, later loads of the file create a new texture.
+	/// @note		Updated textures are never evicted, see
+	///				vk2d::ResourceManager::SetTextureResidencyBudget(), as their contents can
+	///				no longer be loaded again from the source. Textures that are evicted when
+	///				this is called can not be updated.
+	/// @param[in]	area
+	///				Area of the texture to update in texels. Bottom right corner is exclusive,
+	///				area size is bottom_right - top_left. Must be within the texture size.
+	/// @param[in]	layer
+	///				Texture layer to update.
+	/// @param[in]	texels
+	///				New texels of the area, row by row. Must contain at least
+	///				area width * area height texels.
+	/// @param[in]	update_mip_levels
+	///				If true, mip levels are generated again from the updated area with linear
+	///				filtering, only the parts of them that the area affects. If false, mip
+	///				levels keep their old contents until an update that updates them.
+	/// @return		true if the update was submitted, false if the texture is not loaded,
+	///				the area or layer is out of bounds, or something went wrong.
+	VK2D_API bool												VK2D_APIENTRY				UpdateRegion(
+		vk2d::Rect2u											area,
+		uint32_t												layer,
+		const std::vector<vk2d::Color8>						&	texels,
+		bool													update_mip_levels			= true );
+
 	/// @brief		VK2D class object checker function.
 	/// @note		Multithreading: Any thread.
 	/// @return		true if class object was created successfully,
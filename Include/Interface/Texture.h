@@ -11,6 +11,7 @@ namespace _internal {
 class WindowImpl;
 class RenderTargetTextureImpl;
 class TextureImpl;
+class BindlessTextureTable;
 } // _internal
 
 
@@ -23,6 +24,7 @@ class Texture
 {
 	friend class vk2d::_internal::WindowImpl;
 	friend class vk2d::_internal::RenderTargetTextureImpl;
+	friend class vk2d::_internal::BindlessTextureTable;
 
 public:
 	/// @brief		Tells if the texture data is ready to be used.
@@ -10,6 +10,7 @@
 #include "Types/MeshPrimitives.hpp"
 #include "Types/Multisamples.h"
 #include "Types/RenderCoordinateSpace.hpp"
+#include "Types/DescriptorCacheStatistics.h"
 
 #include <memory>
 #include <string>
@@ -521,6 +522,7 @@ public:
 	///				<tr><td> Microsoft Windows Bitmap 24-bit (BGR) non-RLE		<td> <tt>.bmp</tt>
 	///				<tr><td> Truevision Targa (RGBA) or (RGB) RLE compressed	<td> <tt>.tga</tt>
 	///				<tr><td> JPEG (RGB)											<td> <tt>.jpg</tt> or <tt>.jpeg</tt>
+	///				<tr><td> Quite OK Image format (RGBA) or (RGB), fastest to save	<td> <tt>.qoi</tt>
 	///				</table>
 	///				Unsupported or unknown extensions will be saved as PNG.
 	/// @param[in]	include_alpha
@@ -1020,6 +1022,11 @@ public:
 		const vk2d::Mesh							&	mesh,
 		const std::vector<vk2d::Matrix4f>			&	transformations );
 
+	/// @brief		Get texture and sampler descriptor set cache totals of this window.
+	/// @note		Multithreading: Main thread only.
+	/// @return		Descriptor set cache totals, texture and sampler caches combined.
+	VK2D_API vk2d::DescriptorCacheStatistics			VK2D_APIENTRY				GetDescriptorCacheStatistics() const;
+
 	/// @brief		VK2D class object checker function.
 	/// @note		Multithreading: Any thread.
 	/// @return		true if class object was created successfully,
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../Core/Common.h"
+
+namespace vk2d {
+
+
+
+/// @brief		Totals of how well texture and sampler descriptor sets of a render target
+///				have been reused, useful for spotting textures that get recreated every frame.
+struct DescriptorCacheStatistics {
+	uint64_t								hit_count						= {};			///< Lookups that found an up to date descriptor set.
+	uint64_t								miss_count						= {};			///< Lookups that had to allocate and write a new descriptor set.
+	uint64_t								eviction_count					= {};			///< Descriptor sets released because they were not used for a while.
+	uint64_t								entry_count						= {};			///< Descriptor sets currently cached.
+};
+
+
+
+} // vk2d
@@ -483,6 +483,9 @@ VK2D_API vk2d::Mesh									VK2D_APIENTRY					GenerateLatticeMesh(
 	bool											filled							= true );
 
 /// @brief		Generate a text mesh that can be used to render text.
+/// @note		Fonts that load glyphs on demand upload glyphs new to the font to the GPU
+///				only when this is called on the main thread, see
+///				vk2d::ResourceManager::LoadFontResource().
 /// @param[in]	font
 ///				A pointer to font resource to use.
 /// @param[in]	origin
@@ -19,6 +19,7 @@
 #include "Types/Mesh.h"
 #include "Types/Multisamples.h"
 #include "Types/RenderCoordinateSpace.hpp"
+#include "Types/DescriptorCacheStatistics.h"
 
 #include "Interface/Instance.h"
 #include "Interface/Window.h"
@@ -15,7 +15,9 @@ layout(std140, set=4, binding=1) uniform			image_sampler_data {
 } sampler_data;
 
 // Set 5: Texture
-layout(set=5, binding=0) uniform texture2DArray		sampled_image;
+// Texture array size is 1 unless bindless textures are used.
+layout(constant_id=0) const uint TEXTURE_ARRAY_SIZE = 1;
+layout(set=5, binding=0) uniform texture2DArray		sampled_images[ TEXTURE_ARRAY_SIZE ];
 
 // Push constants.
 layout(std140, push_constant) uniform PushConstants {
@@ -25,6 +27,7 @@ layout(std140, push_constant) uniform PushConstants {
 	uint		vertex_offset;					// Offset to first vertex in vertex buffer.
 	uint		texture_channel_weight_offset;	// Location of the texture channels in the texture channel weights ssbo.
 	uint		texture_channel_weight_count;	// Just the amount of texture channels.
+	uint		texture_index;					// Index into the texture array, always 0 if not bindless.
 } push_constants;
 
 // From vertex shader.
@@ -58,7 +61,7 @@ void SingleTexturedFragmentWithUVBorderColor()
 		}
 	}
 
-	vec4	texture_color		= texture( sampler2DArray( sampled_image, image_sampler ), vec3( fragment_input_UV, float( fragment_input_texture_channel ) ) );
+	vec4	texture_color		= texture( sampler2DArray( sampled_images[ push_constants.texture_index ], image_sampler ), vec3( fragment_input_UV, float( fragment_input_texture_channel ) ) );
 	final_fragment_color		= texture_color * fragment_input_color;
 }
 
@@ -68,6 +71,6 @@ void SingleTexturedFragmentWithUVBorderColor()
 // Only a single texture channel can be used per vertex.
 void SingleTexturedFragment()
 {
-	vec4	texture_color		= texture( sampler2DArray( sampled_image, image_sampler ), vec3( fragment_input_UV, float( fragment_input_texture_channel ) ) );
+	vec4	texture_color		= texture( sampler2DArray( sampled_images[ push_constants.texture_index ], image_sampler ), vec3( fragment_input_UV, float( fragment_input_texture_channel ) ) );
 	final_fragment_color		= texture_color * fragment_input_color;
 }
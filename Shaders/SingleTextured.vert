@@ -42,6 +42,7 @@ layout(std140, push_constant) uniform PushConstants {
 	uint		vertex_offset;					// Offset to first vertex in vertex buffer.
 	uint		texture_channel_weight_offset;	// Location of the texture channels in the texture channel weights ssbo.
 	uint		texture_channel_weight_count;	// Just the amount of texture channels.
+	uint		texture_index;					// Index into the texture array, always 0 if not bindless.
 } push_constants;
 
 // Output to fragment shader
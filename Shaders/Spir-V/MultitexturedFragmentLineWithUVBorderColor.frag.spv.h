@@ -1,8 +1,8 @@
 #pragma once
 #include <array>
 #include <stdint.h>
-std::array<uint32_t, 2320> MultitexturedFragmentLineWithUVBorderColor_frag_shader_data {
-	0x07230203, 0x00010000, 0x00080008, 0x00000158, 0x00000000, 0x00020011, 0x00000001, 0x00020011, 0x00000002, 0x0006000B, 
+std::array<uint32_t, 2374> MultitexturedFragmentLineWithUVBorderColor_frag_shader_data {
+	0x07230203, 0x00010000, 0x00080008, 0x0000015F, 0x00000000, 0x00020011, 0x00000001, 0x00020011, 0x00000002, 0x0006000B, 
 	0x00000001, 0x4C534C47, 0x6474732E, 0x3035342E, 0x00000000, 0x0003000E, 0x00000000, 0x00000001, 0x000B000F, 0x00000004, 
 	0x00000004, 0x6E69616D, 0x00000000, 0x00000025, 0x00000088, 0x000000FF, 0x00000128, 0x00000153, 0x00000157, 0x00030010, 
 	0x00000004, 0x00000007, 0x00030003, 0x00000002, 0x000001C2, 0x00040005, 0x00000004, 0x6E69616D, 0x00000000, 0x00060005, 
@@ -41,7 +41,7 @@ std::array<uint32_t, 2320> MultitexturedFragmentLineWithUVBorderColor_frag_shade
 	0x74786574, 0x5F657275, 0x6E616863, 0x5F6C656E, 0x67696577, 0x00737468, 0x000A0005, 0x000000E6, 0x74726576, 0x635F7865, 
 	0x69626D6F, 0x5F64656E, 0x6E616863, 0x5F6C656E, 0x67696577, 0x00737468, 0x00070005, 0x000000EA, 0x61746F74, 0x69705F6C, 
 	0x5F6C6578, 0x67696577, 0x00007468, 0x00030005, 0x000000F4, 0x00006374, 0x00060005, 0x000000F7, 0x706D6173, 0x5F64656C, 
-	0x67616D69, 0x00000065, 0x00060005, 0x000000FB, 0x67616D69, 0x61735F65, 0x656C706D, 0x00000072, 0x00070005, 0x000000FF, 
+	0x67616D69, 0x00007365, 0x00060005, 0x000000FB, 0x67616D69, 0x61735F65, 0x656C706D, 0x00000072, 0x00070005, 0x000000FF, 
 	0x67617266, 0x746E656D, 0x706E695F, 0x555F7475, 0x00000056, 0x00070005, 0x00000112, 0x67616D69, 0x61735F65, 0x656C706D, 
 	0x61645F72, 0x00006174, 0x00070006, 0x00000112, 0x00000000, 0x64726F62, 0x635F7265, 0x726F6C6F, 0x00000000, 0x00080006, 
 	0x00000112, 0x00000001, 0x64726F62, 0x635F7265, 0x726F6C6F, 0x616E655F, 0x00656C62, 0x00060005, 0x00000114, 0x706D6173, 
@@ -51,59 +51,63 @@ std::array<uint32_t, 2320> MultitexturedFragmentLineWithUVBorderColor_frag_shade
 	0x00040005, 0x00000148, 0x61726170, 0x0000006D, 0x00060005, 0x0000014B, 0x74786574, 0x5F657275, 0x6F6C6F63, 0x00000072, 
 	0x00040005, 0x0000014C, 0x61726170, 0x0000006D, 0x00040005, 0x0000014E, 0x61726170, 0x0000006D, 0x00080005, 0x00000153, 
 	0x67617266, 0x746E656D, 0x706E695F, 0x635F7475, 0x726F6C6F, 0x00000000, 0x00090005, 0x00000157, 0x67617266, 0x746E656D, 
-	0x706E695F, 0x765F7475, 0x65747265, 0x6E695F78, 0x00786564, 0x00030047, 0x00000025, 0x0000000E, 0x00040047, 0x00000025, 
-	0x0000000B, 0x00000007, 0x00050048, 0x00000028, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000028, 0x00000001, 
-	0x00000023, 0x00000004, 0x00050048, 0x00000028, 0x00000002, 0x00000023, 0x00000008, 0x00050048, 0x00000028, 0x00000003, 
-	0x00000023, 0x0000000C, 0x00050048, 0x00000028, 0x00000004, 0x00000023, 0x00000010, 0x00050048, 0x00000028, 0x00000005, 
-	0x00000023, 0x00000014, 0x00030047, 0x00000028, 0x00000002, 0x00040047, 0x00000035, 0x00000006, 0x00000004, 0x00040048, 
-	0x00000036, 0x00000000, 0x00000018, 0x00050048, 0x00000036, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000036, 
-	0x00000003, 0x00040047, 0x00000038, 0x00000022, 0x00000002, 0x00040047, 0x00000038, 0x00000021, 0x00000000, 0x00050048, 
-	0x0000004E, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x0000004E, 0x00000001, 0x00000023, 0x00000008, 0x00050048, 
-	0x0000004E, 0x00000002, 0x00000023, 0x00000010, 0x00050048, 0x0000004E, 0x00000003, 0x00000023, 0x00000020, 0x00050048, 
-	0x0000004E, 0x00000004, 0x00000023, 0x00000024, 0x00040047, 0x0000004F, 0x00000006, 0x00000030, 0x00040048, 0x00000050, 
-	0x00000000, 0x00000018, 0x00050048, 0x00000050, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000050, 0x00000003, 
-	0x00040047, 0x00000052, 0x00000022, 0x00000003, 0x00040047, 0x00000052, 0x00000021, 0x00000000, 0x00040047, 0x00000088, 
-	0x0000001E, 0x00000002, 0x00040047, 0x000000CD, 0x00000006, 0x00000004, 0x00040048, 0x000000CE, 0x00000000, 0x00000018, 
-	0x00050048, 0x000000CE, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x000000CE, 0x00000003, 0x00040047, 0x000000D0, 
-	0x00000022, 0x00000006, 0x00040047, 0x000000D0, 0x00000021, 0x00000000, 0x00040047, 0x000000F7, 0x00000022, 0x00000005, 
-	0x00040047, 0x000000F7, 0x00000021, 0x00000000, 0x00040047, 0x000000FB, 0x00000022, 0x00000004, 0x00040047, 0x000000FB, 
-	0x00000021, 0x00000000, 0x00040047, 0x000000FF, 0x0000001E, 0x00000000, 0x00050048, 0x00000112, 0x00000000, 0x00000023, 
-	0x00000000, 0x00050048, 0x00000112, 0x00000001, 0x00000023, 0x00000010, 0x00030047, 0x00000112, 0x00000002, 0x00040047, 
-	0x00000114, 0x00000022, 0x00000004, 0x00040047, 0x00000114, 0x00000021, 0x00000001, 0x00040047, 0x00000128, 0x0000001E, 
-	0x00000000, 0x00040047, 0x00000153, 0x0000001E, 0x00000001, 0x00030047, 0x00000157, 0x0000000E, 0x00040047, 0x00000157, 
-	0x0000001E, 0x00000003, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00040015, 0x00000006, 0x00000020, 
-	0x00000000, 0x00040017, 0x00000007, 0x00000006, 0x00000002, 0x00030021, 0x00000008, 0x00000007, 0x00040020, 0x0000000B, 
-	0x00000007, 0x00000007, 0x00030016, 0x0000000C, 0x00000020, 0x00040017, 0x0000000D, 0x0000000C, 0x00000002, 0x00040017, 
-	0x0000000E, 0x0000000C, 0x00000004, 0x0007001E, 0x0000000F, 0x0000000D, 0x0000000D, 0x0000000E, 0x0000000C, 0x00000006, 
-	0x0004002B, 0x00000006, 0x00000010, 0x00000002, 0x0004001C, 0x00000011, 0x0000000F, 0x00000010, 0x00040021, 0x00000012, 
-	0x00000011, 0x0000000B, 0x00040020, 0x00000016, 0x00000007, 0x00000011, 0x00040021, 0x00000017, 0x0000000D, 0x00000016, 
-	0x00040020, 0x0000001B, 0x00000007, 0x0000000D, 0x00050021, 0x0000001C, 0x0000000E, 0x0000000B, 0x0000001B, 0x00040020, 
-	0x00000021, 0x00000007, 0x00000006, 0x00040015, 0x00000023, 0x00000020, 0x00000001, 0x00040020, 0x00000024, 0x00000001, 
-	0x00000023, 0x0004003B, 0x00000024, 0x00000025, 0x00000001, 0x0008001E, 0x00000028, 0x00000006, 0x00000006, 0x00000006, 
-	0x00000006, 0x00000006, 0x00000006, 0x00040020, 0x00000029, 0x00000009, 0x00000028, 0x0004003B, 0x00000029, 0x0000002A, 
-	0x00000009, 0x0004002B, 0x00000023, 0x0000002B, 0x00000002, 0x00040020, 0x0000002C, 0x00000009, 0x00000006, 0x0004002B, 
-	0x00000023, 0x00000030, 0x00000001, 0x0003001D, 0x00000035, 0x00000006, 0x0003001E, 0x00000036, 0x00000035, 0x00040020, 
-	0x00000037, 0x00000002, 0x00000036, 0x0004003B, 0x00000037, 0x00000038, 0x00000002, 0x0004002B, 0x00000023, 0x00000039, 
-	0x00000000, 0x0004002B, 0x00000006, 0x0000003B, 0x00000000, 0x00040020, 0x0000003D, 0x00000002, 0x00000006, 0x0004002B, 
-	0x00000006, 0x00000041, 0x00000001, 0x0004002B, 0x00000023, 0x0000004A, 0x00000003, 0x0007001E, 0x0000004E, 0x0000000D, 
-	0x0000000D, 0x0000000E, 0x0000000C, 0x00000006, 0x0003001D, 0x0000004F, 0x0000004E, 0x0003001E, 0x00000050, 0x0000004F, 
-	0x00040020, 0x00000051, 0x00000002, 0x00000050, 0x0004003B, 0x00000051, 0x00000052, 0x00000002, 0x00040020, 0x00000057, 
-	0x00000002, 0x0000004E, 0x00040020, 0x0000005A, 0x00000007, 0x0000000F, 0x00040020, 0x00000061, 0x00000007, 0x0000000E, 
-	0x00040020, 0x00000064, 0x00000007, 0x0000000C, 0x0004002B, 0x00000023, 0x00000067, 0x00000004, 0x0004001C, 0x0000007D, 
-	0x0000000D, 0x00000010, 0x00040020, 0x0000007E, 0x00000007, 0x0000007D, 0x00040020, 0x00000087, 0x00000001, 0x0000000D, 
-	0x0004003B, 0x00000087, 0x00000088, 0x00000001, 0x0004002B, 0x0000000C, 0x0000009D, 0x00000000, 0x00020014, 0x0000009E, 
-	0x0004002B, 0x0000000C, 0x000000B7, 0x3F800000, 0x0005002C, 0x0000000D, 0x000000BC, 0x000000B7, 0x0000009D, 0x0007002C, 
-	0x0000000E, 0x000000C0, 0x0000009D, 0x0000009D, 0x0000009D, 0x0000009D, 0x0004002B, 0x00000023, 0x000000C8, 0x00000005, 
-	0x0003001D, 0x000000CD, 0x0000000C, 0x0003001E, 0x000000CE, 0x000000CD, 0x00040020, 0x000000CF, 0x00000002, 0x000000CE, 
-	0x0004003B, 0x000000CF, 0x000000D0, 0x00000002, 0x00040020, 0x000000D8, 0x00000002, 0x0000000C, 0x00090019, 0x000000F5, 
-	0x0000000C, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00040020, 0x000000F6, 0x00000000, 
-	0x000000F5, 0x0004003B, 0x000000F6, 0x000000F7, 0x00000000, 0x0002001A, 0x000000F9, 0x00040020, 0x000000FA, 0x00000000, 
+	0x706E695F, 0x765F7475, 0x65747265, 0x6E695F78, 0x00786564, 0x00070006, 0x00000028, 0x00000006, 0x74786574, 0x5F657275, 
+	0x65646E69, 0x00000078, 0x00070005, 0x00000159, 0x54584554, 0x5F455255, 0x41525241, 0x49535F59, 0x0000455A, 0x00030047, 
+	0x00000025, 0x0000000E, 0x00040047, 0x00000025, 0x0000000B, 0x00000007, 0x00050048, 0x00000028, 0x00000000, 0x00000023, 
+	0x00000000, 0x00050048, 0x00000028, 0x00000001, 0x00000023, 0x00000004, 0x00050048, 0x00000028, 0x00000002, 0x00000023, 
+	0x00000008, 0x00050048, 0x00000028, 0x00000003, 0x00000023, 0x0000000C, 0x00050048, 0x00000028, 0x00000004, 0x00000023, 
+	0x00000010, 0x00050048, 0x00000028, 0x00000005, 0x00000023, 0x00000014, 0x00050048, 0x00000028, 0x00000006, 0x00000023, 
+	0x00000018, 0x00030047, 0x00000028, 0x00000002, 0x00040047, 0x00000035, 0x00000006, 0x00000004, 0x00040048, 0x00000036, 
+	0x00000000, 0x00000018, 0x00050048, 0x00000036, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000036, 0x00000003, 
+	0x00040047, 0x00000038, 0x00000022, 0x00000002, 0x00040047, 0x00000038, 0x00000021, 0x00000000, 0x00050048, 0x0000004E, 
+	0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x0000004E, 0x00000001, 0x00000023, 0x00000008, 0x00050048, 0x0000004E, 
+	0x00000002, 0x00000023, 0x00000010, 0x00050048, 0x0000004E, 0x00000003, 0x00000023, 0x00000020, 0x00050048, 0x0000004E, 
+	0x00000004, 0x00000023, 0x00000024, 0x00040047, 0x0000004F, 0x00000006, 0x00000030, 0x00040048, 0x00000050, 0x00000000, 
+	0x00000018, 0x00050048, 0x00000050, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000050, 0x00000003, 0x00040047, 
+	0x00000052, 0x00000022, 0x00000003, 0x00040047, 0x00000052, 0x00000021, 0x00000000, 0x00040047, 0x00000088, 0x0000001E, 
+	0x00000002, 0x00040047, 0x000000CD, 0x00000006, 0x00000004, 0x00040048, 0x000000CE, 0x00000000, 0x00000018, 0x00050048, 
+	0x000000CE, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x000000CE, 0x00000003, 0x00040047, 0x000000D0, 0x00000022, 
+	0x00000006, 0x00040047, 0x000000D0, 0x00000021, 0x00000000, 0x00040047, 0x000000F7, 0x00000022, 0x00000005, 0x00040047, 
+	0x000000F7, 0x00000021, 0x00000000, 0x00040047, 0x000000FB, 0x00000022, 0x00000004, 0x00040047, 0x000000FB, 0x00000021, 
+	0x00000000, 0x00040047, 0x000000FF, 0x0000001E, 0x00000000, 0x00050048, 0x00000112, 0x00000000, 0x00000023, 0x00000000, 
+	0x00050048, 0x00000112, 0x00000001, 0x00000023, 0x00000010, 0x00030047, 0x00000112, 0x00000002, 0x00040047, 0x00000114, 
+	0x00000022, 0x00000004, 0x00040047, 0x00000114, 0x00000021, 0x00000001, 0x00040047, 0x00000128, 0x0000001E, 0x00000000, 
+	0x00040047, 0x00000153, 0x0000001E, 0x00000001, 0x00030047, 0x00000157, 0x0000000E, 0x00040047, 0x00000157, 0x0000001E, 
+	0x00000003, 0x00040047, 0x00000159, 0x00000001, 0x00000000, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 
+	0x00040015, 0x00000006, 0x00000020, 0x00000000, 0x00040017, 0x00000007, 0x00000006, 0x00000002, 0x00030021, 0x00000008, 
+	0x00000007, 0x00040020, 0x0000000B, 0x00000007, 0x00000007, 0x00030016, 0x0000000C, 0x00000020, 0x00040017, 0x0000000D, 
+	0x0000000C, 0x00000002, 0x00040017, 0x0000000E, 0x0000000C, 0x00000004, 0x0007001E, 0x0000000F, 0x0000000D, 0x0000000D, 
+	0x0000000E, 0x0000000C, 0x00000006, 0x0004002B, 0x00000006, 0x00000010, 0x00000002, 0x0004001C, 0x00000011, 0x0000000F, 
+	0x00000010, 0x00040021, 0x00000012, 0x00000011, 0x0000000B, 0x00040020, 0x00000016, 0x00000007, 0x00000011, 0x00040021, 
+	0x00000017, 0x0000000D, 0x00000016, 0x00040020, 0x0000001B, 0x00000007, 0x0000000D, 0x00050021, 0x0000001C, 0x0000000E, 
+	0x0000000B, 0x0000001B, 0x00040020, 0x00000021, 0x00000007, 0x00000006, 0x00040015, 0x00000023, 0x00000020, 0x00000001, 
+	0x00040020, 0x00000024, 0x00000001, 0x00000023, 0x0004003B, 0x00000024, 0x00000025, 0x00000001, 0x0009001E, 0x00000028, 
+	0x00000006, 0x00000006, 0x00000006, 0x00000006, 0x00000006, 0x00000006, 0x00000006, 0x00040020, 0x00000029, 0x00000009, 
+	0x00000028, 0x0004003B, 0x00000029, 0x0000002A, 0x00000009, 0x0004002B, 0x00000023, 0x0000002B, 0x00000002, 0x00040020, 
+	0x0000002C, 0x00000009, 0x00000006, 0x0004002B, 0x00000023, 0x00000030, 0x00000001, 0x0003001D, 0x00000035, 0x00000006, 
+	0x0003001E, 0x00000036, 0x00000035, 0x00040020, 0x00000037, 0x00000002, 0x00000036, 0x0004003B, 0x00000037, 0x00000038, 
+	0x00000002, 0x0004002B, 0x00000023, 0x00000039, 0x00000000, 0x0004002B, 0x00000006, 0x0000003B, 0x00000000, 0x00040020, 
+	0x0000003D, 0x00000002, 0x00000006, 0x0004002B, 0x00000006, 0x00000041, 0x00000001, 0x0004002B, 0x00000023, 0x0000004A, 
+	0x00000003, 0x0007001E, 0x0000004E, 0x0000000D, 0x0000000D, 0x0000000E, 0x0000000C, 0x00000006, 0x0003001D, 0x0000004F, 
+	0x0000004E, 0x0003001E, 0x00000050, 0x0000004F, 0x00040020, 0x00000051, 0x00000002, 0x00000050, 0x0004003B, 0x00000051, 
+	0x00000052, 0x00000002, 0x00040020, 0x00000057, 0x00000002, 0x0000004E, 0x00040020, 0x0000005A, 0x00000007, 0x0000000F, 
+	0x00040020, 0x00000061, 0x00000007, 0x0000000E, 0x00040020, 0x00000064, 0x00000007, 0x0000000C, 0x0004002B, 0x00000023, 
+	0x00000067, 0x00000004, 0x0004001C, 0x0000007D, 0x0000000D, 0x00000010, 0x00040020, 0x0000007E, 0x00000007, 0x0000007D, 
+	0x00040020, 0x00000087, 0x00000001, 0x0000000D, 0x0004003B, 0x00000087, 0x00000088, 0x00000001, 0x0004002B, 0x0000000C, 
+	0x0000009D, 0x00000000, 0x00020014, 0x0000009E, 0x0004002B, 0x0000000C, 0x000000B7, 0x3F800000, 0x0005002C, 0x0000000D, 
+	0x000000BC, 0x000000B7, 0x0000009D, 0x0007002C, 0x0000000E, 0x000000C0, 0x0000009D, 0x0000009D, 0x0000009D, 0x0000009D, 
+	0x0004002B, 0x00000023, 0x000000C8, 0x00000005, 0x0003001D, 0x000000CD, 0x0000000C, 0x0003001E, 0x000000CE, 0x000000CD, 
+	0x00040020, 0x000000CF, 0x00000002, 0x000000CE, 0x0004003B, 0x000000CF, 0x000000D0, 0x00000002, 0x00040020, 0x000000D8, 
+	0x00000002, 0x0000000C, 0x00090019, 0x000000F5, 0x0000000C, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00000001, 
+	0x00000000, 0x00040020, 0x000000F6, 0x00000000, 0x000000F5, 0x0002001A, 0x000000F9, 0x00040020, 0x000000FA, 0x00000000, 
 	0x000000F9, 0x0004003B, 0x000000FA, 0x000000FB, 0x00000000, 0x0003001B, 0x000000FD, 0x000000F5, 0x0004003B, 0x00000087, 
 	0x000000FF, 0x00000001, 0x00040017, 0x00000103, 0x0000000C, 0x00000003, 0x0004001E, 0x00000112, 0x0000000E, 0x00000007, 
 	0x00040020, 0x00000113, 0x00000002, 0x00000112, 0x0004003B, 0x00000113, 0x00000114, 0x00000002, 0x00040020, 0x0000011A, 
 	0x00000001, 0x0000000C, 0x00040020, 0x00000127, 0x00000003, 0x0000000E, 0x0004003B, 0x00000127, 0x00000128, 0x00000003, 
 	0x00040020, 0x00000129, 0x00000002, 0x0000000E, 0x00040020, 0x00000152, 0x00000001, 0x0000000E, 0x0004003B, 0x00000152, 
 	0x00000153, 0x00000001, 0x00040020, 0x00000156, 0x00000001, 0x00000006, 0x0004003B, 0x00000156, 0x00000157, 0x00000001, 
+	0x0004002B, 0x00000023, 0x00000158, 0x00000006, 0x00040032, 0x00000006, 0x00000159, 0x00000001, 0x0004001C, 0x0000015A, 
+	0x000000F5, 0x00000159, 0x00040020, 0x0000015B, 0x00000000, 0x0000015A, 0x0004003B, 0x0000015B, 0x000000F7, 0x00000000, 
 	0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200F8, 0x00000005, 0x0004003B, 0x0000000B, 0x00000141, 
 	0x00000007, 0x0004003B, 0x00000016, 0x00000143, 0x00000007, 0x0004003B, 0x0000000B, 0x00000144, 0x00000007, 0x0004003B, 
 	0x0000001B, 0x00000147, 0x00000007, 0x0004003B, 0x00000016, 0x00000148, 0x00000007, 0x0004003B, 0x00000061, 0x0000014B, 
@@ -223,15 +227,17 @@ std::array<uint32_t, 2320> MultitexturedFragmentLineWithUVBorderColor_frag_shade
 	0x00050041, 0x00000064, 0x000000ED, 0x000000E6, 0x00000041, 0x0004003D, 0x0000000C, 0x000000EE, 0x000000ED, 0x00050081, 
 	0x0000000C, 0x000000EF, 0x000000EC, 0x000000EE, 0x0003003E, 0x000000EA, 0x000000EF, 0x0004003D, 0x0000000C, 0x000000F0, 
 	0x000000EA, 0x000500BA, 0x0000009E, 0x000000F1, 0x000000F0, 0x0000009D, 0x000300F7, 0x000000F3, 0x00000000, 0x000400FA, 
-	0x000000F1, 0x000000F2, 0x000000F3, 0x000200F8, 0x000000F2, 0x0004003D, 0x000000F5, 0x000000F8, 0x000000F7, 0x0004003D, 
-	0x000000F9, 0x000000FC, 0x000000FB, 0x00050056, 0x000000FD, 0x000000FE, 0x000000F8, 0x000000FC, 0x0004003D, 0x0000000D, 
-	0x00000100, 0x000000FF, 0x0004003D, 0x00000006, 0x00000101, 0x000000C1, 0x00040070, 0x0000000C, 0x00000102, 0x00000101, 
-	0x00050051, 0x0000000C, 0x00000104, 0x00000100, 0x00000000, 0x00050051, 0x0000000C, 0x00000105, 0x00000100, 0x00000001, 
-	0x00060050, 0x00000103, 0x00000106, 0x00000104, 0x00000105, 0x00000102, 0x00050057, 0x0000000E, 0x00000107, 0x000000FE, 
-	0x00000106, 0x0003003E, 0x000000F4, 0x00000107, 0x0004003D, 0x0000000E, 0x00000108, 0x000000F4, 0x0004003D, 0x0000000C, 
-	0x00000109, 0x000000EA, 0x0005008E, 0x0000000E, 0x0000010A, 0x00000108, 0x00000109, 0x0004003D, 0x0000000E, 0x0000010B, 
-	0x000000BF, 0x00050081, 0x0000000E, 0x0000010C, 0x0000010B, 0x0000010A, 0x0003003E, 0x000000BF, 0x0000010C, 0x000200F9, 
-	0x000000F3, 0x000200F8, 0x000000F3, 0x000200F9, 0x000000C5, 0x000200F8, 0x000000C5, 0x0004003D, 0x00000006, 0x0000010D, 
-	0x000000C1, 0x00050080, 0x00000006, 0x0000010E, 0x0000010D, 0x00000030, 0x0003003E, 0x000000C1, 0x0000010E, 0x000200F9, 
-	0x000000C2, 0x000200F8, 0x000000C4, 0x0004003D, 0x0000000E, 0x0000010F, 0x000000BF, 0x000200FE, 0x0000010F, 0x00010038
+	0x000000F1, 0x000000F2, 0x000000F3, 0x000200F8, 0x000000F2, 0x00050041, 0x0000002C, 0x0000015C, 0x0000002A, 0x00000158, 
+	0x0004003D, 0x00000006, 0x0000015D, 0x0000015C, 0x00050041, 0x000000F6, 0x0000015E, 0x000000F7, 0x0000015D, 0x0004003D, 
+	0x000000F5, 0x000000F8, 0x0000015E, 0x0004003D, 0x000000F9, 0x000000FC, 0x000000FB, 0x00050056, 0x000000FD, 0x000000FE, 
+	0x000000F8, 0x000000FC, 0x0004003D, 0x0000000D, 0x00000100, 0x000000FF, 0x0004003D, 0x00000006, 0x00000101, 0x000000C1, 
+	0x00040070, 0x0000000C, 0x00000102, 0x00000101, 0x00050051, 0x0000000C, 0x00000104, 0x00000100, 0x00000000, 0x00050051, 
+	0x0000000C, 0x00000105, 0x00000100, 0x00000001, 0x00060050, 0x00000103, 0x00000106, 0x00000104, 0x00000105, 0x00000102, 
+	0x00050057, 0x0000000E, 0x00000107, 0x000000FE, 0x00000106, 0x0003003E, 0x000000F4, 0x00000107, 0x0004003D, 0x0000000E, 
+	0x00000108, 0x000000F4, 0x0004003D, 0x0000000C, 0x00000109, 0x000000EA, 0x0005008E, 0x0000000E, 0x0000010A, 0x00000108, 
+	0x00000109, 0x0004003D, 0x0000000E, 0x0000010B, 0x000000BF, 0x00050081, 0x0000000E, 0x0000010C, 0x0000010B, 0x0000010A, 
+	0x0003003E, 0x000000BF, 0x0000010C, 0x000200F9, 0x000000F3, 0x000200F8, 0x000000F3, 0x000200F9, 0x000000C5, 0x000200F8, 
+	0x000000C5, 0x0004003D, 0x00000006, 0x0000010D, 0x000000C1, 0x00050080, 0x00000006, 0x0000010E, 0x0000010D, 0x00000030, 
+	0x0003003E, 0x000000C1, 0x0000010E, 0x000200F9, 0x000000C2, 0x000200F8, 0x000000C4, 0x0004003D, 0x0000000E, 0x0000010F, 
+	0x000000BF, 0x000200FE, 0x0000010F, 0x00010038
 };
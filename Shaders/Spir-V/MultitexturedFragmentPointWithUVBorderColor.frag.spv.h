@@ -1,8 +1,8 @@
 #pragma once
 #include <array>
 #include <stdint.h>
-std::array<uint32_t, 1215> MultitexturedFragmentPointWithUVBorderColor_frag_shader_data {
-	0x07230203, 0x00010000, 0x00080008, 0x0000009E, 0x00000000, 0x00020011, 0x00000001, 0x0006000B, 0x00000001, 0x4C534C47, 
+std::array<uint32_t, 1269> MultitexturedFragmentPointWithUVBorderColor_frag_shader_data {
+	0x07230203, 0x00010000, 0x00080008, 0x000000A5, 0x00000000, 0x00020011, 0x00000001, 0x0006000B, 0x00000001, 0x4C534C47, 
 	0x6474732E, 0x3035342E, 0x00000000, 0x0003000E, 0x00000000, 0x00000001, 0x000A000F, 0x00000004, 0x00000004, 0x6E69616D, 
 	0x00000000, 0x0000002B, 0x00000046, 0x00000073, 0x00000091, 0x0000009D, 0x00030010, 0x00000004, 0x00000007, 0x00030003, 
 	0x00000002, 0x000001C2, 0x00040005, 0x00000004, 0x6E69616D, 0x00000000, 0x000B0005, 0x00000009, 0x636C6143, 0x74616C75, 
@@ -18,7 +18,7 @@ std::array<uint32_t, 1215> MultitexturedFragmentPointWithUVBorderColor_frag_shad
 	0x74786554, 0x43657275, 0x6E6E6168, 0x65576C65, 0x74686769, 0x00000073, 0x00050006, 0x00000026, 0x00000000, 0x6F627373, 
 	0x00000000, 0x00080005, 0x00000028, 0x74786574, 0x5F657275, 0x6E616863, 0x5F6C656E, 0x67696577, 0x00737468, 0x00090005, 
 	0x0000002B, 0x67617266, 0x746E656D, 0x706E695F, 0x765F7475, 0x65747265, 0x6E695F78, 0x00786564, 0x00030005, 0x00000039, 
-	0x00006374, 0x00060005, 0x0000003C, 0x706D6173, 0x5F64656C, 0x67616D69, 0x00000065, 0x00060005, 0x00000040, 0x67616D69, 
+	0x00006374, 0x00060005, 0x0000003C, 0x706D6173, 0x5F64656C, 0x67616D69, 0x00007365, 0x00060005, 0x00000040, 0x67616D69, 
 	0x61735F65, 0x656C706D, 0x00000072, 0x00070005, 0x00000046, 0x67617266, 0x746E656D, 0x706E695F, 0x555F7475, 0x00000056, 
 	0x00070005, 0x0000005B, 0x67616D69, 0x61735F65, 0x656C706D, 0x61645F72, 0x00006174, 0x00070006, 0x0000005B, 0x00000000, 
 	0x64726F62, 0x635F7265, 0x726F6C6F, 0x00000000, 0x00080006, 0x0000005B, 0x00000001, 0x64726F62, 0x635F7265, 0x726F6C6F, 
@@ -32,38 +32,40 @@ std::array<uint32_t, 1215> MultitexturedFragmentPointWithUVBorderColor_frag_shad
 	0x00090006, 0x00000098, 0x00000004, 0x676E6973, 0x745F656C, 0x75747865, 0x635F6572, 0x6E6E6168, 0x00006C65, 0x00060005, 
 	0x0000009A, 0x74726556, 0x75427865, 0x72656666, 0x00000000, 0x00050006, 0x0000009A, 0x00000000, 0x6F627373, 0x00000000, 
 	0x00060005, 0x0000009C, 0x74726576, 0x625F7865, 0x65666675, 0x00000072, 0x000A0005, 0x0000009D, 0x67617266, 0x746E656D, 
-	0x706E695F, 0x6F5F7475, 0x69676972, 0x5F6C616E, 0x726F6F63, 0x00007364, 0x00050048, 0x00000019, 0x00000000, 0x00000023, 
-	0x00000000, 0x00050048, 0x00000019, 0x00000001, 0x00000023, 0x00000004, 0x00050048, 0x00000019, 0x00000002, 0x00000023, 
-	0x00000008, 0x00050048, 0x00000019, 0x00000003, 0x00000023, 0x0000000C, 0x00050048, 0x00000019, 0x00000004, 0x00000023, 
-	0x00000010, 0x00050048, 0x00000019, 0x00000005, 0x00000023, 0x00000014, 0x00030047, 0x00000019, 0x00000002, 0x00040047, 
-	0x00000025, 0x00000006, 0x00000004, 0x00040048, 0x00000026, 0x00000000, 0x00000018, 0x00050048, 0x00000026, 0x00000000, 
-	0x00000023, 0x00000000, 0x00030047, 0x00000026, 0x00000003, 0x00040047, 0x00000028, 0x00000022, 0x00000006, 0x00040047, 
-	0x00000028, 0x00000021, 0x00000000, 0x00030047, 0x0000002B, 0x0000000E, 0x00040047, 0x0000002B, 0x0000001E, 0x00000003, 
-	0x00040047, 0x0000003C, 0x00000022, 0x00000005, 0x00040047, 0x0000003C, 0x00000021, 0x00000000, 0x00040047, 0x00000040, 
-	0x00000022, 0x00000004, 0x00040047, 0x00000040, 0x00000021, 0x00000000, 0x00040047, 0x00000046, 0x0000001E, 0x00000000, 
-	0x00050048, 0x0000005B, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x0000005B, 0x00000001, 0x00000023, 0x00000010, 
-	0x00030047, 0x0000005B, 0x00000002, 0x00040047, 0x0000005D, 0x00000022, 0x00000004, 0x00040047, 0x0000005D, 0x00000021, 
-	0x00000001, 0x00040047, 0x00000073, 0x0000001E, 0x00000000, 0x00040047, 0x00000091, 0x0000001E, 0x00000001, 0x00040047, 
-	0x00000094, 0x00000006, 0x00000004, 0x00040048, 0x00000095, 0x00000000, 0x00000018, 0x00050048, 0x00000095, 0x00000000, 
-	0x00000023, 0x00000000, 0x00030047, 0x00000095, 0x00000003, 0x00040047, 0x00000097, 0x00000022, 0x00000002, 0x00040047, 
-	0x00000097, 0x00000021, 0x00000000, 0x00050048, 0x00000098, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000098, 
-	0x00000001, 0x00000023, 0x00000008, 0x00050048, 0x00000098, 0x00000002, 0x00000023, 0x00000010, 0x00050048, 0x00000098, 
-	0x00000003, 0x00000023, 0x00000020, 0x00050048, 0x00000098, 0x00000004, 0x00000023, 0x00000024, 0x00040047, 0x00000099, 
-	0x00000006, 0x00000030, 0x00040048, 0x0000009A, 0x00000000, 0x00000018, 0x00050048, 0x0000009A, 0x00000000, 0x00000023, 
-	0x00000000, 0x00030047, 0x0000009A, 0x00000003, 0x00040047, 0x0000009C, 0x00000022, 0x00000003, 0x00040047, 0x0000009C, 
-	0x00000021, 0x00000000, 0x00040047, 0x0000009D, 0x0000001E, 0x00000002, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 
-	0x00000002, 0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000004, 0x00030021, 0x00000008, 
-	0x00000007, 0x00040020, 0x0000000B, 0x00000007, 0x00000007, 0x0004002B, 0x00000006, 0x0000000D, 0x00000000, 0x0007002C, 
-	0x00000007, 0x0000000E, 0x0000000D, 0x0000000D, 0x0000000D, 0x0000000D, 0x00040015, 0x0000000F, 0x00000020, 0x00000000, 
-	0x00040020, 0x00000010, 0x00000007, 0x0000000F, 0x0004002B, 0x0000000F, 0x00000012, 0x00000000, 0x0008001E, 0x00000019, 
-	0x0000000F, 0x0000000F, 0x0000000F, 0x0000000F, 0x0000000F, 0x0000000F, 0x00040020, 0x0000001A, 0x00000009, 0x00000019, 
-	0x0004003B, 0x0000001A, 0x0000001B, 0x00000009, 0x00040015, 0x0000001C, 0x00000020, 0x00000001, 0x0004002B, 0x0000001C, 
-	0x0000001D, 0x00000005, 0x00040020, 0x0000001E, 0x00000009, 0x0000000F, 0x00020014, 0x00000021, 0x00040020, 0x00000023, 
-	0x00000007, 0x00000006, 0x0003001D, 0x00000025, 0x00000006, 0x0003001E, 0x00000026, 0x00000025, 0x00040020, 0x00000027, 
-	0x00000002, 0x00000026, 0x0004003B, 0x00000027, 0x00000028, 0x00000002, 0x0004002B, 0x0000001C, 0x00000029, 0x00000000, 
-	0x00040020, 0x0000002A, 0x00000001, 0x0000000F, 0x0004003B, 0x0000002A, 0x0000002B, 0x00000001, 0x00040020, 0x00000032, 
-	0x00000002, 0x00000006, 0x00090019, 0x0000003A, 0x00000006, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00000001, 
-	0x00000000, 0x00040020, 0x0000003B, 0x00000000, 0x0000003A, 0x0004003B, 0x0000003B, 0x0000003C, 0x00000000, 0x0002001A, 
+	0x706E695F, 0x6F5F7475, 0x69676972, 0x5F6C616E, 0x726F6F63, 0x00007364, 0x00070006, 0x00000019, 0x00000006, 0x74786574, 
+	0x5F657275, 0x65646E69, 0x00000078, 0x00070005, 0x0000009F, 0x54584554, 0x5F455255, 0x41525241, 0x49535F59, 0x0000455A, 
+	0x00050048, 0x00000019, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000019, 0x00000001, 0x00000023, 0x00000004, 
+	0x00050048, 0x00000019, 0x00000002, 0x00000023, 0x00000008, 0x00050048, 0x00000019, 0x00000003, 0x00000023, 0x0000000C, 
+	0x00050048, 0x00000019, 0x00000004, 0x00000023, 0x00000010, 0x00050048, 0x00000019, 0x00000005, 0x00000023, 0x00000014, 
+	0x00050048, 0x00000019, 0x00000006, 0x00000023, 0x00000018, 0x00030047, 0x00000019, 0x00000002, 0x00040047, 0x00000025, 
+	0x00000006, 0x00000004, 0x00040048, 0x00000026, 0x00000000, 0x00000018, 0x00050048, 0x00000026, 0x00000000, 0x00000023, 
+	0x00000000, 0x00030047, 0x00000026, 0x00000003, 0x00040047, 0x00000028, 0x00000022, 0x00000006, 0x00040047, 0x00000028, 
+	0x00000021, 0x00000000, 0x00030047, 0x0000002B, 0x0000000E, 0x00040047, 0x0000002B, 0x0000001E, 0x00000003, 0x00040047, 
+	0x0000003C, 0x00000022, 0x00000005, 0x00040047, 0x0000003C, 0x00000021, 0x00000000, 0x00040047, 0x00000040, 0x00000022, 
+	0x00000004, 0x00040047, 0x00000040, 0x00000021, 0x00000000, 0x00040047, 0x00000046, 0x0000001E, 0x00000000, 0x00050048, 
+	0x0000005B, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x0000005B, 0x00000001, 0x00000023, 0x00000010, 0x00030047, 
+	0x0000005B, 0x00000002, 0x00040047, 0x0000005D, 0x00000022, 0x00000004, 0x00040047, 0x0000005D, 0x00000021, 0x00000001, 
+	0x00040047, 0x00000073, 0x0000001E, 0x00000000, 0x00040047, 0x00000091, 0x0000001E, 0x00000001, 0x00040047, 0x00000094, 
+	0x00000006, 0x00000004, 0x00040048, 0x00000095, 0x00000000, 0x00000018, 0x00050048, 0x00000095, 0x00000000, 0x00000023, 
+	0x00000000, 0x00030047, 0x00000095, 0x00000003, 0x00040047, 0x00000097, 0x00000022, 0x00000002, 0x00040047, 0x00000097, 
+	0x00000021, 0x00000000, 0x00050048, 0x00000098, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000098, 0x00000001, 
+	0x00000023, 0x00000008, 0x00050048, 0x00000098, 0x00000002, 0x00000023, 0x00000010, 0x00050048, 0x00000098, 0x00000003, 
+	0x00000023, 0x00000020, 0x00050048, 0x00000098, 0x00000004, 0x00000023, 0x00000024, 0x00040047, 0x00000099, 0x00000006, 
+	0x00000030, 0x00040048, 0x0000009A, 0x00000000, 0x00000018, 0x00050048, 0x0000009A, 0x00000000, 0x00000023, 0x00000000, 
+	0x00030047, 0x0000009A, 0x00000003, 0x00040047, 0x0000009C, 0x00000022, 0x00000003, 0x00040047, 0x0000009C, 0x00000021, 
+	0x00000000, 0x00040047, 0x0000009D, 0x0000001E, 0x00000002, 0x00040047, 0x0000009F, 0x00000001, 0x00000000, 0x00020013, 
+	0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 
+	0x00000004, 0x00030021, 0x00000008, 0x00000007, 0x00040020, 0x0000000B, 0x00000007, 0x00000007, 0x0004002B, 0x00000006, 
+	0x0000000D, 0x00000000, 0x0007002C, 0x00000007, 0x0000000E, 0x0000000D, 0x0000000D, 0x0000000D, 0x0000000D, 0x00040015, 
+	0x0000000F, 0x00000020, 0x00000000, 0x00040020, 0x00000010, 0x00000007, 0x0000000F, 0x0004002B, 0x0000000F, 0x00000012, 
+	0x00000000, 0x0009001E, 0x00000019, 0x0000000F, 0x0000000F, 0x0000000F, 0x0000000F, 0x0000000F, 0x0000000F, 0x0000000F, 
+	0x00040020, 0x0000001A, 0x00000009, 0x00000019, 0x0004003B, 0x0000001A, 0x0000001B, 0x00000009, 0x00040015, 0x0000001C, 
+	0x00000020, 0x00000001, 0x0004002B, 0x0000001C, 0x0000001D, 0x00000005, 0x00040020, 0x0000001E, 0x00000009, 0x0000000F, 
+	0x00020014, 0x00000021, 0x00040020, 0x00000023, 0x00000007, 0x00000006, 0x0003001D, 0x00000025, 0x00000006, 0x0003001E, 
+	0x00000026, 0x00000025, 0x00040020, 0x00000027, 0x00000002, 0x00000026, 0x0004003B, 0x00000027, 0x00000028, 0x00000002, 
+	0x0004002B, 0x0000001C, 0x00000029, 0x00000000, 0x00040020, 0x0000002A, 0x00000001, 0x0000000F, 0x0004003B, 0x0000002A, 
+	0x0000002B, 0x00000001, 0x00040020, 0x00000032, 0x00000002, 0x00000006, 0x00090019, 0x0000003A, 0x00000006, 0x00000001, 
+	0x00000000, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00040020, 0x0000003B, 0x00000000, 0x0000003A, 0x0002001A, 
 	0x0000003E, 0x00040020, 0x0000003F, 0x00000000, 0x0000003E, 0x0004003B, 0x0000003F, 0x00000040, 0x00000000, 0x0003001B, 
 	0x00000042, 0x0000003A, 0x00040017, 0x00000044, 0x00000006, 0x00000002, 0x00040020, 0x00000045, 0x00000001, 0x00000044, 
 	0x0004003B, 0x00000045, 0x00000046, 0x00000001, 0x00040017, 0x0000004A, 0x00000006, 0x00000003, 0x0004002B, 0x0000001C, 
@@ -76,7 +78,9 @@ std::array<uint32_t, 1215> MultitexturedFragmentPointWithUVBorderColor_frag_shad
 	0x00040020, 0x00000096, 0x00000002, 0x00000095, 0x0004003B, 0x00000096, 0x00000097, 0x00000002, 0x0007001E, 0x00000098, 
 	0x00000044, 0x00000044, 0x00000007, 0x00000006, 0x0000000F, 0x0003001D, 0x00000099, 0x00000098, 0x0003001E, 0x0000009A, 
 	0x00000099, 0x00040020, 0x0000009B, 0x00000002, 0x0000009A, 0x0004003B, 0x0000009B, 0x0000009C, 0x00000002, 0x0004003B, 
-	0x00000045, 0x0000009D, 0x00000001, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200F8, 0x00000005, 
+	0x00000045, 0x0000009D, 0x00000001, 0x0004002B, 0x0000001C, 0x0000009E, 0x00000006, 0x00040032, 0x0000000F, 0x0000009F, 
+	0x00000001, 0x0004001C, 0x000000A0, 0x0000003A, 0x0000009F, 0x00040020, 0x000000A1, 0x00000000, 0x000000A0, 0x0004003B, 
+	0x000000A1, 0x0000003C, 0x00000000, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200F8, 0x00000005, 
 	0x0004003B, 0x0000000B, 0x0000008D, 0x00000007, 0x00060041, 0x0000005E, 0x0000005F, 0x0000005D, 0x00000055, 0x00000012, 
 	0x0004003D, 0x0000000F, 0x00000060, 0x0000005F, 0x000500AC, 0x00000021, 0x00000061, 0x00000060, 0x00000012, 0x000300F7, 
 	0x00000063, 0x00000000, 0x000400FA, 0x00000061, 0x00000062, 0x00000063, 0x000200F8, 0x00000062, 0x00050041, 0x00000064, 
@@ -113,15 +117,16 @@ std::array<uint32_t, 1215> MultitexturedFragmentPointWithUVBorderColor_frag_shad
 	0x00000032, 0x00000033, 0x00000028, 0x00000029, 0x00000031, 0x0004003D, 0x00000006, 0x00000034, 0x00000033, 0x0003003E, 
 	0x00000024, 0x00000034, 0x0004003D, 0x00000006, 0x00000035, 0x00000024, 0x000500BA, 0x00000021, 0x00000036, 0x00000035, 
 	0x0000000D, 0x000300F7, 0x00000038, 0x00000000, 0x000400FA, 0x00000036, 0x00000037, 0x00000038, 0x000200F8, 0x00000037, 
-	0x0004003D, 0x0000003A, 0x0000003D, 0x0000003C, 0x0004003D, 0x0000003E, 0x00000041, 0x00000040, 0x00050056, 0x00000042, 
-	0x00000043, 0x0000003D, 0x00000041, 0x0004003D, 0x00000044, 0x00000047, 0x00000046, 0x0004003D, 0x0000000F, 0x00000048, 
-	0x00000011, 0x00040070, 0x00000006, 0x00000049, 0x00000048, 0x00050051, 0x00000006, 0x0000004B, 0x00000047, 0x00000000, 
-	0x00050051, 0x00000006, 0x0000004C, 0x00000047, 0x00000001, 0x00060050, 0x0000004A, 0x0000004D, 0x0000004B, 0x0000004C, 
-	0x00000049, 0x00050057, 0x00000007, 0x0000004E, 0x00000043, 0x0000004D, 0x0003003E, 0x00000039, 0x0000004E, 0x0004003D, 
-	0x00000007, 0x0000004F, 0x00000039, 0x0004003D, 0x00000006, 0x00000050, 0x00000024, 0x0005008E, 0x00000007, 0x00000051, 
-	0x0000004F, 0x00000050, 0x0004003D, 0x00000007, 0x00000052, 0x0000000C, 0x00050081, 0x00000007, 0x00000053, 0x00000052, 
-	0x00000051, 0x0003003E, 0x0000000C, 0x00000053, 0x000200F9, 0x00000038, 0x000200F8, 0x00000038, 0x000200F9, 0x00000016, 
-	0x000200F8, 0x00000016, 0x0004003D, 0x0000000F, 0x00000054, 0x00000011, 0x00050080, 0x0000000F, 0x00000056, 0x00000054, 
-	0x00000055, 0x0003003E, 0x00000011, 0x00000056, 0x000200F9, 0x00000013, 0x000200F8, 0x00000015, 0x0004003D, 0x00000007, 
-	0x00000057, 0x0000000C, 0x000200FE, 0x00000057, 0x00010038
+	0x00050041, 0x0000001E, 0x000000A2, 0x0000001B, 0x0000009E, 0x0004003D, 0x0000000F, 0x000000A3, 0x000000A2, 0x00050041, 
+	0x0000003B, 0x000000A4, 0x0000003C, 0x000000A3, 0x0004003D, 0x0000003A, 0x0000003D, 0x000000A4, 0x0004003D, 0x0000003E, 
+	0x00000041, 0x00000040, 0x00050056, 0x00000042, 0x00000043, 0x0000003D, 0x00000041, 0x0004003D, 0x00000044, 0x00000047, 
+	0x00000046, 0x0004003D, 0x0000000F, 0x00000048, 0x00000011, 0x00040070, 0x00000006, 0x00000049, 0x00000048, 0x00050051, 
+	0x00000006, 0x0000004B, 0x00000047, 0x00000000, 0x00050051, 0x00000006, 0x0000004C, 0x00000047, 0x00000001, 0x00060050, 
+	0x0000004A, 0x0000004D, 0x0000004B, 0x0000004C, 0x00000049, 0x00050057, 0x00000007, 0x0000004E, 0x00000043, 0x0000004D, 
+	0x0003003E, 0x00000039, 0x0000004E, 0x0004003D, 0x00000007, 0x0000004F, 0x00000039, 0x0004003D, 0x00000006, 0x00000050, 
+	0x00000024, 0x0005008E, 0x00000007, 0x00000051, 0x0000004F, 0x00000050, 0x0004003D, 0x00000007, 0x00000052, 0x0000000C, 
+	0x00050081, 0x00000007, 0x00000053, 0x00000052, 0x00000051, 0x0003003E, 0x0000000C, 0x00000053, 0x000200F9, 0x00000038, 
+	0x000200F8, 0x00000038, 0x000200F9, 0x00000016, 0x000200F8, 0x00000016, 0x0004003D, 0x0000000F, 0x00000054, 0x00000011, 
+	0x00050080, 0x0000000F, 0x00000056, 0x00000054, 0x00000055, 0x0003003E, 0x00000011, 0x00000056, 0x000200F9, 0x00000013, 
+	0x000200F8, 0x00000015, 0x0004003D, 0x00000007, 0x00000057, 0x0000000C, 0x000200FE, 0x00000057, 0x00010038
 };
@@ -1,8 +1,8 @@
 #pragma once
 #include <array>
 #include <stdint.h>
-std::array<uint32_t, 2753> MultitexturedFragmentTriangleWithUVBorderColor_frag_shader_data {
-	0x07230203, 0x00010000, 0x00080008, 0x000001A9, 0x00000000, 0x00020011, 0x00000001, 0x00020011, 0x00000002, 0x0006000B, 
+std::array<uint32_t, 2807> MultitexturedFragmentTriangleWithUVBorderColor_frag_shader_data {
+	0x07230203, 0x00010000, 0x00080008, 0x000001B0, 0x00000000, 0x00020011, 0x00000001, 0x00020011, 0x00000002, 0x0006000B, 
 	0x00000001, 0x4C534C47, 0x6474732E, 0x3035342E, 0x00000000, 0x0003000E, 0x00000000, 0x00000001, 0x000B000F, 0x00000004, 
 	0x00000004, 0x6E69616D, 0x00000000, 0x00000026, 0x000000A3, 0x00000150, 0x00000179, 0x000001A4, 0x000001A8, 0x00030010, 
 	0x00000004, 0x00000007, 0x00030003, 0x00000002, 0x000001C2, 0x00040005, 0x00000004, 0x6E69616D, 0x00000000, 0x00070005, 
@@ -41,7 +41,7 @@ std::array<uint32_t, 2753> MultitexturedFragmentTriangleWithUVBorderColor_frag_s
 	0x00000000, 0x6F627373, 0x00000000, 0x00080005, 0x00000114, 0x74786574, 0x5F657275, 0x6E616863, 0x5F6C656E, 0x67696577, 
 	0x00737468, 0x000A0005, 0x00000134, 0x74726576, 0x635F7865, 0x69626D6F, 0x5F64656E, 0x6E616863, 0x5F6C656E, 0x67696577, 
 	0x00737468, 0x00070005, 0x00000138, 0x61746F74, 0x69705F6C, 0x5F6C6578, 0x67696577, 0x00007468, 0x00030005, 0x00000145, 
-	0x00006374, 0x00060005, 0x00000148, 0x706D6173, 0x5F64656C, 0x67616D69, 0x00000065, 0x00060005, 0x0000014C, 0x67616D69, 
+	0x00006374, 0x00060005, 0x00000148, 0x706D6173, 0x5F64656C, 0x67616D69, 0x00007365, 0x00060005, 0x0000014C, 0x67616D69, 
 	0x61735F65, 0x656C706D, 0x00000072, 0x00070005, 0x00000150, 0x67617266, 0x746E656D, 0x706E695F, 0x555F7475, 0x00000056, 
 	0x00070005, 0x00000163, 0x67616D69, 0x61735F65, 0x656C706D, 0x61645F72, 0x00006174, 0x00070006, 0x00000163, 0x00000000, 
 	0x64726F62, 0x635F7265, 0x726F6C6F, 0x00000000, 0x00080006, 0x00000163, 0x00000001, 0x64726F62, 0x635F7265, 0x726F6C6F, 
@@ -52,60 +52,64 @@ std::array<uint32_t, 2753> MultitexturedFragmentTriangleWithUVBorderColor_frag_s
 	0x0000019C, 0x74786574, 0x5F657275, 0x6F6C6F63, 0x00000072, 0x00040005, 0x0000019D, 0x61726170, 0x0000006D, 0x00040005, 
 	0x0000019F, 0x61726170, 0x0000006D, 0x00080005, 0x000001A4, 0x67617266, 0x746E656D, 0x706E695F, 0x635F7475, 0x726F6C6F, 
 	0x00000000, 0x00090005, 0x000001A8, 0x67617266, 0x746E656D, 0x706E695F, 0x765F7475, 0x65747265, 0x6E695F78, 0x00786564, 
-	0x00030047, 0x00000026, 0x0000000E, 0x00040047, 0x00000026, 0x0000000B, 0x00000007, 0x00050048, 0x00000029, 0x00000000, 
-	0x00000023, 0x00000000, 0x00050048, 0x00000029, 0x00000001, 0x00000023, 0x00000004, 0x00050048, 0x00000029, 0x00000002, 
-	0x00000023, 0x00000008, 0x00050048, 0x00000029, 0x00000003, 0x00000023, 0x0000000C, 0x00050048, 0x00000029, 0x00000004, 
-	0x00000023, 0x00000010, 0x00050048, 0x00000029, 0x00000005, 0x00000023, 0x00000014, 0x00030047, 0x00000029, 0x00000002, 
-	0x00040047, 0x00000036, 0x00000006, 0x00000004, 0x00040048, 0x00000037, 0x00000000, 0x00000018, 0x00050048, 0x00000037, 
-	0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000037, 0x00000003, 0x00040047, 0x00000039, 0x00000022, 0x00000002, 
-	0x00040047, 0x00000039, 0x00000021, 0x00000000, 0x00050048, 0x00000054, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 
-	0x00000054, 0x00000001, 0x00000023, 0x00000008, 0x00050048, 0x00000054, 0x00000002, 0x00000023, 0x00000010, 0x00050048, 
-	0x00000054, 0x00000003, 0x00000023, 0x00000020, 0x00050048, 0x00000054, 0x00000004, 0x00000023, 0x00000024, 0x00040047, 
-	0x00000055, 0x00000006, 0x00000030, 0x00040048, 0x00000056, 0x00000000, 0x00000018, 0x00050048, 0x00000056, 0x00000000, 
-	0x00000023, 0x00000000, 0x00030047, 0x00000056, 0x00000003, 0x00040047, 0x00000058, 0x00000022, 0x00000003, 0x00040047, 
-	0x00000058, 0x00000021, 0x00000000, 0x00040047, 0x000000A3, 0x0000001E, 0x00000002, 0x00040047, 0x00000111, 0x00000006, 
-	0x00000004, 0x00040048, 0x00000112, 0x00000000, 0x00000018, 0x00050048, 0x00000112, 0x00000000, 0x00000023, 0x00000000, 
-	0x00030047, 0x00000112, 0x00000003, 0x00040047, 0x00000114, 0x00000022, 0x00000006, 0x00040047, 0x00000114, 0x00000021, 
-	0x00000000, 0x00040047, 0x00000148, 0x00000022, 0x00000005, 0x00040047, 0x00000148, 0x00000021, 0x00000000, 0x00040047, 
-	0x0000014C, 0x00000022, 0x00000004, 0x00040047, 0x0000014C, 0x00000021, 0x00000000, 0x00040047, 0x00000150, 0x0000001E, 
-	0x00000000, 0x00050048, 0x00000163, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000163, 0x00000001, 0x00000023, 
-	0x00000010, 0x00030047, 0x00000163, 0x00000002, 0x00040047, 0x00000165, 0x00000022, 0x00000004, 0x00040047, 0x00000165, 
-	0x00000021, 0x00000001, 0x00040047, 0x00000179, 0x0000001E, 0x00000000, 0x00040047, 0x000001A4, 0x0000001E, 0x00000001, 
-	0x00030047, 0x000001A8, 0x0000000E, 0x00040047, 0x000001A8, 0x0000001E, 0x00000003, 0x00020013, 0x00000002, 0x00030021, 
-	0x00000003, 0x00000002, 0x00040015, 0x00000006, 0x00000020, 0x00000000, 0x00040017, 0x00000007, 0x00000006, 0x00000003, 
-	0x00030021, 0x00000008, 0x00000007, 0x00040020, 0x0000000B, 0x00000007, 0x00000007, 0x00030016, 0x0000000C, 0x00000020, 
-	0x00040017, 0x0000000D, 0x0000000C, 0x00000002, 0x00040017, 0x0000000E, 0x0000000C, 0x00000004, 0x0007001E, 0x0000000F, 
-	0x0000000D, 0x0000000D, 0x0000000E, 0x0000000C, 0x00000006, 0x0004002B, 0x00000006, 0x00000010, 0x00000003, 0x0004001C, 
-	0x00000011, 0x0000000F, 0x00000010, 0x00040021, 0x00000012, 0x00000011, 0x0000000B, 0x00040020, 0x00000016, 0x00000007, 
-	0x00000011, 0x00040017, 0x00000017, 0x0000000C, 0x00000003, 0x00040021, 0x00000018, 0x00000017, 0x00000016, 0x00040020, 
-	0x0000001C, 0x00000007, 0x00000017, 0x00050021, 0x0000001D, 0x0000000E, 0x0000000B, 0x0000001C, 0x00040020, 0x00000022, 
-	0x00000007, 0x00000006, 0x00040015, 0x00000024, 0x00000020, 0x00000001, 0x00040020, 0x00000025, 0x00000001, 0x00000024, 
-	0x0004003B, 0x00000025, 0x00000026, 0x00000001, 0x0008001E, 0x00000029, 0x00000006, 0x00000006, 0x00000006, 0x00000006, 
-	0x00000006, 0x00000006, 0x00040020, 0x0000002A, 0x00000009, 0x00000029, 0x0004003B, 0x0000002A, 0x0000002B, 0x00000009, 
-	0x0004002B, 0x00000024, 0x0000002C, 0x00000002, 0x00040020, 0x0000002D, 0x00000009, 0x00000006, 0x0004002B, 0x00000024, 
-	0x00000031, 0x00000001, 0x0003001D, 0x00000036, 0x00000006, 0x0003001E, 0x00000037, 0x00000036, 0x00040020, 0x00000038, 
-	0x00000002, 0x00000037, 0x0004003B, 0x00000038, 0x00000039, 0x00000002, 0x0004002B, 0x00000024, 0x0000003A, 0x00000000, 
-	0x0004002B, 0x00000006, 0x0000003C, 0x00000000, 0x00040020, 0x0000003E, 0x00000002, 0x00000006, 0x0004002B, 0x00000006, 
-	0x00000042, 0x00000001, 0x0004002B, 0x00000006, 0x00000047, 0x00000002, 0x0004002B, 0x00000024, 0x00000050, 0x00000003, 
-	0x0007001E, 0x00000054, 0x0000000D, 0x0000000D, 0x0000000E, 0x0000000C, 0x00000006, 0x0003001D, 0x00000055, 0x00000054, 
-	0x0003001E, 0x00000056, 0x00000055, 0x00040020, 0x00000057, 0x00000002, 0x00000056, 0x0004003B, 0x00000057, 0x00000058, 
-	0x00000002, 0x00040020, 0x0000005D, 0x00000002, 0x00000054, 0x00040020, 0x00000060, 0x00000007, 0x0000000F, 0x00040020, 
-	0x00000063, 0x00000007, 0x0000000D, 0x00040020, 0x00000068, 0x00000007, 0x0000000E, 0x00040020, 0x0000006B, 0x00000007, 
-	0x0000000C, 0x0004002B, 0x00000024, 0x0000006E, 0x00000004, 0x0004001C, 0x00000095, 0x0000000D, 0x00000010, 0x00040020, 
-	0x00000096, 0x00000007, 0x00000095, 0x00040020, 0x000000A2, 0x00000001, 0x0000000D, 0x0004003B, 0x000000A2, 0x000000A3, 
-	0x00000001, 0x0004002B, 0x0000000C, 0x000000F6, 0x3F800000, 0x0004002B, 0x0000000C, 0x00000102, 0x00000000, 0x0007002C, 
-	0x0000000E, 0x00000103, 0x00000102, 0x00000102, 0x00000102, 0x00000102, 0x0004002B, 0x00000024, 0x0000010B, 0x00000005, 
-	0x00020014, 0x0000010E, 0x0003001D, 0x00000111, 0x0000000C, 0x0003001E, 0x00000112, 0x00000111, 0x00040020, 0x00000113, 
-	0x00000002, 0x00000112, 0x0004003B, 0x00000113, 0x00000114, 0x00000002, 0x00040020, 0x0000011C, 0x00000002, 0x0000000C, 
-	0x00090019, 0x00000146, 0x0000000C, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00040020, 
-	0x00000147, 0x00000000, 0x00000146, 0x0004003B, 0x00000147, 0x00000148, 0x00000000, 0x0002001A, 0x0000014A, 0x00040020, 
+	0x00070006, 0x00000029, 0x00000006, 0x74786574, 0x5F657275, 0x65646E69, 0x00000078, 0x00070005, 0x000001AA, 0x54584554, 
+	0x5F455255, 0x41525241, 0x49535F59, 0x0000455A, 0x00030047, 0x00000026, 0x0000000E, 0x00040047, 0x00000026, 0x0000000B, 
+	0x00000007, 0x00050048, 0x00000029, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000029, 0x00000001, 0x00000023, 
+	0x00000004, 0x00050048, 0x00000029, 0x00000002, 0x00000023, 0x00000008, 0x00050048, 0x00000029, 0x00000003, 0x00000023, 
+	0x0000000C, 0x00050048, 0x00000029, 0x00000004, 0x00000023, 0x00000010, 0x00050048, 0x00000029, 0x00000005, 0x00000023, 
+	0x00000014, 0x00050048, 0x00000029, 0x00000006, 0x00000023, 0x00000018, 0x00030047, 0x00000029, 0x00000002, 0x00040047, 
+	0x00000036, 0x00000006, 0x00000004, 0x00040048, 0x00000037, 0x00000000, 0x00000018, 0x00050048, 0x00000037, 0x00000000, 
+	0x00000023, 0x00000000, 0x00030047, 0x00000037, 0x00000003, 0x00040047, 0x00000039, 0x00000022, 0x00000002, 0x00040047, 
+	0x00000039, 0x00000021, 0x00000000, 0x00050048, 0x00000054, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000054, 
+	0x00000001, 0x00000023, 0x00000008, 0x00050048, 0x00000054, 0x00000002, 0x00000023, 0x00000010, 0x00050048, 0x00000054, 
+	0x00000003, 0x00000023, 0x00000020, 0x00050048, 0x00000054, 0x00000004, 0x00000023, 0x00000024, 0x00040047, 0x00000055, 
+	0x00000006, 0x00000030, 0x00040048, 0x00000056, 0x00000000, 0x00000018, 0x00050048, 0x00000056, 0x00000000, 0x00000023, 
+	0x00000000, 0x00030047, 0x00000056, 0x00000003, 0x00040047, 0x00000058, 0x00000022, 0x00000003, 0x00040047, 0x00000058, 
+	0x00000021, 0x00000000, 0x00040047, 0x000000A3, 0x0000001E, 0x00000002, 0x00040047, 0x00000111, 0x00000006, 0x00000004, 
+	0x00040048, 0x00000112, 0x00000000, 0x00000018, 0x00050048, 0x00000112, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 
+	0x00000112, 0x00000003, 0x00040047, 0x00000114, 0x00000022, 0x00000006, 0x00040047, 0x00000114, 0x00000021, 0x00000000, 
+	0x00040047, 0x00000148, 0x00000022, 0x00000005, 0x00040047, 0x00000148, 0x00000021, 0x00000000, 0x00040047, 0x0000014C, 
+	0x00000022, 0x00000004, 0x00040047, 0x0000014C, 0x00000021, 0x00000000, 0x00040047, 0x00000150, 0x0000001E, 0x00000000, 
+	0x00050048, 0x00000163, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000163, 0x00000001, 0x00000023, 0x00000010, 
+	0x00030047, 0x00000163, 0x00000002, 0x00040047, 0x00000165, 0x00000022, 0x00000004, 0x00040047, 0x00000165, 0x00000021, 
+	0x00000001, 0x00040047, 0x00000179, 0x0000001E, 0x00000000, 0x00040047, 0x000001A4, 0x0000001E, 0x00000001, 0x00030047, 
+	0x000001A8, 0x0000000E, 0x00040047, 0x000001A8, 0x0000001E, 0x00000003, 0x00040047, 0x000001AA, 0x00000001, 0x00000000, 
+	0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00040015, 0x00000006, 0x00000020, 0x00000000, 0x00040017, 
+	0x00000007, 0x00000006, 0x00000003, 0x00030021, 0x00000008, 0x00000007, 0x00040020, 0x0000000B, 0x00000007, 0x00000007, 
+	0x00030016, 0x0000000C, 0x00000020, 0x00040017, 0x0000000D, 0x0000000C, 0x00000002, 0x00040017, 0x0000000E, 0x0000000C, 
+	0x00000004, 0x0007001E, 0x0000000F, 0x0000000D, 0x0000000D, 0x0000000E, 0x0000000C, 0x00000006, 0x0004002B, 0x00000006, 
+	0x00000010, 0x00000003, 0x0004001C, 0x00000011, 0x0000000F, 0x00000010, 0x00040021, 0x00000012, 0x00000011, 0x0000000B, 
+	0x00040020, 0x00000016, 0x00000007, 0x00000011, 0x00040017, 0x00000017, 0x0000000C, 0x00000003, 0x00040021, 0x00000018, 
+	0x00000017, 0x00000016, 0x00040020, 0x0000001C, 0x00000007, 0x00000017, 0x00050021, 0x0000001D, 0x0000000E, 0x0000000B, 
+	0x0000001C, 0x00040020, 0x00000022, 0x00000007, 0x00000006, 0x00040015, 0x00000024, 0x00000020, 0x00000001, 0x00040020, 
+	0x00000025, 0x00000001, 0x00000024, 0x0004003B, 0x00000025, 0x00000026, 0x00000001, 0x0009001E, 0x00000029, 0x00000006, 
+	0x00000006, 0x00000006, 0x00000006, 0x00000006, 0x00000006, 0x00000006, 0x00040020, 0x0000002A, 0x00000009, 0x00000029, 
+	0x0004003B, 0x0000002A, 0x0000002B, 0x00000009, 0x0004002B, 0x00000024, 0x0000002C, 0x00000002, 0x00040020, 0x0000002D, 
+	0x00000009, 0x00000006, 0x0004002B, 0x00000024, 0x00000031, 0x00000001, 0x0003001D, 0x00000036, 0x00000006, 0x0003001E, 
+	0x00000037, 0x00000036, 0x00040020, 0x00000038, 0x00000002, 0x00000037, 0x0004003B, 0x00000038, 0x00000039, 0x00000002, 
+	0x0004002B, 0x00000024, 0x0000003A, 0x00000000, 0x0004002B, 0x00000006, 0x0000003C, 0x00000000, 0x00040020, 0x0000003E, 
+	0x00000002, 0x00000006, 0x0004002B, 0x00000006, 0x00000042, 0x00000001, 0x0004002B, 0x00000006, 0x00000047, 0x00000002, 
+	0x0004002B, 0x00000024, 0x00000050, 0x00000003, 0x0007001E, 0x00000054, 0x0000000D, 0x0000000D, 0x0000000E, 0x0000000C, 
+	0x00000006, 0x0003001D, 0x00000055, 0x00000054, 0x0003001E, 0x00000056, 0x00000055, 0x00040020, 0x00000057, 0x00000002, 
+	0x00000056, 0x0004003B, 0x00000057, 0x00000058, 0x00000002, 0x00040020, 0x0000005D, 0x00000002, 0x00000054, 0x00040020, 
+	0x00000060, 0x00000007, 0x0000000F, 0x00040020, 0x00000063, 0x00000007, 0x0000000D, 0x00040020, 0x00000068, 0x00000007, 
+	0x0000000E, 0x00040020, 0x0000006B, 0x00000007, 0x0000000C, 0x0004002B, 0x00000024, 0x0000006E, 0x00000004, 0x0004001C, 
+	0x00000095, 0x0000000D, 0x00000010, 0x00040020, 0x00000096, 0x00000007, 0x00000095, 0x00040020, 0x000000A2, 0x00000001, 
+	0x0000000D, 0x0004003B, 0x000000A2, 0x000000A3, 0x00000001, 0x0004002B, 0x0000000C, 0x000000F6, 0x3F800000, 0x0004002B, 
+	0x0000000C, 0x00000102, 0x00000000, 0x0007002C, 0x0000000E, 0x00000103, 0x00000102, 0x00000102, 0x00000102, 0x00000102, 
+	0x0004002B, 0x00000024, 0x0000010B, 0x00000005, 0x00020014, 0x0000010E, 0x0003001D, 0x00000111, 0x0000000C, 0x0003001E, 
+	0x00000112, 0x00000111, 0x00040020, 0x00000113, 0x00000002, 0x00000112, 0x0004003B, 0x00000113, 0x00000114, 0x00000002, 
+	0x00040020, 0x0000011C, 0x00000002, 0x0000000C, 0x00090019, 0x00000146, 0x0000000C, 0x00000001, 0x00000000, 0x00000001, 
+	0x00000000, 0x00000001, 0x00000000, 0x00040020, 0x00000147, 0x00000000, 0x00000146, 0x0002001A, 0x0000014A, 0x00040020, 
 	0x0000014B, 0x00000000, 0x0000014A, 0x0004003B, 0x0000014B, 0x0000014C, 0x00000000, 0x0003001B, 0x0000014E, 0x00000146, 
 	0x0004003B, 0x000000A2, 0x00000150, 0x00000001, 0x00040017, 0x00000162, 0x00000006, 0x00000002, 0x0004001E, 0x00000163, 
 	0x0000000E, 0x00000162, 0x00040020, 0x00000164, 0x00000002, 0x00000163, 0x0004003B, 0x00000164, 0x00000165, 0x00000002, 
 	0x00040020, 0x0000016B, 0x00000001, 0x0000000C, 0x00040020, 0x00000178, 0x00000003, 0x0000000E, 0x0004003B, 0x00000178, 
 	0x00000179, 0x00000003, 0x00040020, 0x0000017A, 0x00000002, 0x0000000E, 0x00040020, 0x000001A3, 0x00000001, 0x0000000E, 
 	0x0004003B, 0x000001A3, 0x000001A4, 0x00000001, 0x00040020, 0x000001A7, 0x00000001, 0x00000006, 0x0004003B, 0x000001A7, 
-	0x000001A8, 0x00000001, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200F8, 0x00000005, 0x0004003B, 
+	0x000001A8, 0x00000001, 0x0004002B, 0x00000024, 0x000001A9, 0x00000006, 0x00040032, 0x00000006, 0x000001AA, 0x00000001, 
+	0x0004001C, 0x000001AB, 0x00000146, 0x000001AA, 0x00040020, 0x000001AC, 0x00000000, 0x000001AB, 0x0004003B, 0x000001AC, 
+	0x00000148, 0x00000000, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200F8, 0x00000005, 0x0004003B, 
 	0x0000000B, 0x00000192, 0x00000007, 0x0004003B, 0x00000016, 0x00000194, 0x00000007, 0x0004003B, 0x0000000B, 0x00000195, 
 	0x00000007, 0x0004003B, 0x0000001C, 0x00000198, 0x00000007, 0x0004003B, 0x00000016, 0x00000199, 0x00000007, 0x0004003B, 
 	0x00000068, 0x0000019C, 0x00000007, 0x0004003B, 0x0000000B, 0x0000019D, 0x00000007, 0x0004003B, 0x0000001C, 0x0000019F, 
@@ -266,16 +270,17 @@ std::array<uint32_t, 2753> MultitexturedFragmentTriangleWithUVBorderColor_frag_s
 	0x0000013D, 0x0000013A, 0x0000013C, 0x00050041, 0x0000006B, 0x0000013E, 0x00000134, 0x00000047, 0x0004003D, 0x0000000C, 
 	0x0000013F, 0x0000013E, 0x00050081, 0x0000000C, 0x00000140, 0x0000013D, 0x0000013F, 0x0003003E, 0x00000138, 0x00000140, 
 	0x0004003D, 0x0000000C, 0x00000141, 0x00000138, 0x000500BA, 0x0000010E, 0x00000142, 0x00000141, 0x00000102, 0x000300F7, 
-	0x00000144, 0x00000000, 0x000400FA, 0x00000142, 0x00000143, 0x00000144, 0x000200F8, 0x00000143, 0x0004003D, 0x00000146, 
-	0x00000149, 0x00000148, 0x0004003D, 0x0000014A, 0x0000014D, 0x0000014C, 0x00050056, 0x0000014E, 0x0000014F, 0x00000149, 
-	0x0000014D, 0x0004003D, 0x0000000D, 0x00000151, 0x00000150, 0x0004003D, 0x00000006, 0x00000152, 0x00000104, 0x00040070, 
-	0x0000000C, 0x00000153, 0x00000152, 0x00050051, 0x0000000C, 0x00000154, 0x00000151, 0x00000000, 0x00050051, 0x0000000C, 
-	0x00000155, 0x00000151, 0x00000001, 0x00060050, 0x00000017, 0x00000156, 0x00000154, 0x00000155, 0x00000153, 0x00050057, 
-	0x0000000E, 0x00000157, 0x0000014F, 0x00000156, 0x0003003E, 0x00000145, 0x00000157, 0x0004003D, 0x0000000E, 0x00000158, 
-	0x00000145, 0x0004003D, 0x0000000C, 0x00000159, 0x00000138, 0x0005008E, 0x0000000E, 0x0000015A, 0x00000158, 0x00000159, 
-	0x0004003D, 0x0000000E, 0x0000015B, 0x00000101, 0x00050081, 0x0000000E, 0x0000015C, 0x0000015B, 0x0000015A, 0x0003003E, 
-	0x00000101, 0x0000015C, 0x000200F9, 0x00000144, 0x000200F8, 0x00000144, 0x000200F9, 0x00000108, 0x000200F8, 0x00000108, 
-	0x0004003D, 0x00000006, 0x0000015D, 0x00000104, 0x00050080, 0x00000006, 0x0000015E, 0x0000015D, 0x00000031, 0x0003003E, 
-	0x00000104, 0x0000015E, 0x000200F9, 0x00000105, 0x000200F8, 0x00000107, 0x0004003D, 0x0000000E, 0x0000015F, 0x00000101, 
-	0x000200FE, 0x0000015F, 0x00010038
+	0x00000144, 0x00000000, 0x000400FA, 0x00000142, 0x00000143, 0x00000144, 0x000200F8, 0x00000143, 0x00050041, 0x0000002D, 
+	0x000001AD, 0x0000002B, 0x000001A9, 0x0004003D, 0x00000006, 0x000001AE, 0x000001AD, 0x00050041, 0x00000147, 0x000001AF, 
+	0x00000148, 0x000001AE, 0x0004003D, 0x00000146, 0x00000149, 0x000001AF, 0x0004003D, 0x0000014A, 0x0000014D, 0x0000014C, 
+	0x00050056, 0x0000014E, 0x0000014F, 0x00000149, 0x0000014D, 0x0004003D, 0x0000000D, 0x00000151, 0x00000150, 0x0004003D, 
+	0x00000006, 0x00000152, 0x00000104, 0x00040070, 0x0000000C, 0x00000153, 0x00000152, 0x00050051, 0x0000000C, 0x00000154, 
+	0x00000151, 0x00000000, 0x00050051, 0x0000000C, 0x00000155, 0x00000151, 0x00000001, 0x00060050, 0x00000017, 0x00000156, 
+	0x00000154, 0x00000155, 0x00000153, 0x00050057, 0x0000000E, 0x00000157, 0x0000014F, 0x00000156, 0x0003003E, 0x00000145, 
+	0x00000157, 0x0004003D, 0x0000000E, 0x00000158, 0x00000145, 0x0004003D, 0x0000000C, 0x00000159, 0x00000138, 0x0005008E, 
+	0x0000000E, 0x0000015A, 0x00000158, 0x00000159, 0x0004003D, 0x0000000E, 0x0000015B, 0x00000101, 0x00050081, 0x0000000E, 
+	0x0000015C, 0x0000015B, 0x0000015A, 0x0003003E, 0x00000101, 0x0000015C, 0x000200F9, 0x00000144, 0x000200F8, 0x00000144, 
+	0x000200F9, 0x00000108, 0x000200F8, 0x00000108, 0x0004003D, 0x00000006, 0x0000015D, 0x00000104, 0x00050080, 0x00000006, 
+	0x0000015E, 0x0000015D, 0x00000031, 0x0003003E, 0x00000104, 0x0000015E, 0x000200F9, 0x00000105, 0x000200F8, 0x00000107, 
+	0x0004003D, 0x0000000E, 0x0000015F, 0x00000101, 0x000200FE, 0x0000015F, 0x00010038
 };
@@ -1,8 +1,8 @@
 #pragma once
 #include <array>
 #include <stdint.h>
-std::array<uint32_t, 716> SingleTexturedFragmentWithUVBorderColor_frag_shader_data {
-	0x07230203, 0x00010000, 0x00080008, 0x00000063, 0x00000000, 0x00020011, 0x00000001, 0x0006000B, 0x00000001, 0x4C534C47, 
+std::array<uint32_t, 774> SingleTexturedFragmentWithUVBorderColor_frag_shader_data {
+	0x07230203, 0x00010000, 0x00080008, 0x0000006B, 0x00000000, 0x00020011, 0x00000001, 0x0006000B, 0x00000001, 0x4C534C47, 
 	0x6474732E, 0x3035342E, 0x00000000, 0x0003000E, 0x00000000, 0x00000001, 0x0009000F, 0x00000004, 0x00000004, 0x6E69616D, 
 	0x00000000, 0x00000019, 0x0000002A, 0x00000053, 0x0000005D, 0x00030010, 0x00000004, 0x00000007, 0x00030003, 0x00000002, 
 	0x000001C2, 0x00040005, 0x00000004, 0x6E69616D, 0x00000000, 0x00070005, 0x0000000A, 0x67616D69, 0x61735F65, 0x656C706D, 
@@ -10,7 +10,7 @@ std::array<uint32_t, 716> SingleTexturedFragmentWithUVBorderColor_frag_shader_da
 	0x0000000A, 0x00000001, 0x64726F62, 0x635F7265, 0x726F6C6F, 0x616E655F, 0x00656C62, 0x00060005, 0x0000000C, 0x706D6173, 
 	0x5F72656C, 0x61746164, 0x00000000, 0x00070005, 0x00000019, 0x67617266, 0x746E656D, 0x706E695F, 0x555F7475, 0x00000056, 
 	0x00080005, 0x0000002A, 0x616E6966, 0x72665F6C, 0x656D6761, 0x635F746E, 0x726F6C6F, 0x00000000, 0x00060005, 0x00000046, 
-	0x74786574, 0x5F657275, 0x6F6C6F63, 0x00000072, 0x00060005, 0x00000049, 0x706D6173, 0x5F64656C, 0x67616D69, 0x00000065, 
+	0x74786574, 0x5F657275, 0x6F6C6F63, 0x00000072, 0x00060005, 0x00000049, 0x706D6173, 0x5F64656C, 0x67616D69, 0x00007365, 
 	0x00060005, 0x0000004D, 0x67616D69, 0x61735F65, 0x656C706D, 0x00000072, 0x000A0005, 0x00000053, 0x67617266, 0x746E656D, 
 	0x706E695F, 0x745F7475, 0x75747865, 0x635F6572, 0x6E6E6168, 0x00006C65, 0x00080005, 0x0000005D, 0x67617266, 0x746E656D, 
 	0x706E695F, 0x635F7475, 0x726F6C6F, 0x00000000, 0x00060005, 0x00000060, 0x68737550, 0x736E6F43, 0x746E6174, 0x00000073, 
@@ -19,59 +19,65 @@ std::array<uint32_t, 716> SingleTexturedFragmentWithUVBorderColor_frag_shader_da
 	0x6F635F78, 0x00746E75, 0x00070006, 0x00000060, 0x00000003, 0x74726576, 0x6F5F7865, 0x65736666, 0x00000074, 0x000B0006, 
 	0x00000060, 0x00000004, 0x74786574, 0x5F657275, 0x6E616863, 0x5F6C656E, 0x67696577, 0x6F5F7468, 0x65736666, 0x00000074, 
 	0x000B0006, 0x00000060, 0x00000005, 0x74786574, 0x5F657275, 0x6E616863, 0x5F6C656E, 0x67696577, 0x635F7468, 0x746E756F, 
-	0x00000000, 0x00060005, 0x00000062, 0x68737570, 0x6E6F635F, 0x6E617473, 0x00007374, 0x00050048, 0x0000000A, 0x00000000, 
-	0x00000023, 0x00000000, 0x00050048, 0x0000000A, 0x00000001, 0x00000023, 0x00000010, 0x00030047, 0x0000000A, 0x00000002, 
-	0x00040047, 0x0000000C, 0x00000022, 0x00000004, 0x00040047, 0x0000000C, 0x00000021, 0x00000001, 0x00040047, 0x00000019, 
-	0x0000001E, 0x00000000, 0x00040047, 0x0000002A, 0x0000001E, 0x00000000, 0x00040047, 0x00000049, 0x00000022, 0x00000005, 
-	0x00040047, 0x00000049, 0x00000021, 0x00000000, 0x00040047, 0x0000004D, 0x00000022, 0x00000004, 0x00040047, 0x0000004D, 
-	0x00000021, 0x00000000, 0x00030047, 0x00000053, 0x0000000E, 0x00040047, 0x00000053, 0x0000001E, 0x00000002, 0x00040047, 
-	0x0000005D, 0x0000001E, 0x00000001, 0x00050048, 0x00000060, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000060, 
-	0x00000001, 0x00000023, 0x00000004, 0x00050048, 0x00000060, 0x00000002, 0x00000023, 0x00000008, 0x00050048, 0x00000060, 
-	0x00000003, 0x00000023, 0x0000000C, 0x00050048, 0x00000060, 0x00000004, 0x00000023, 0x00000010, 0x00050048, 0x00000060, 
-	0x00000005, 0x00000023, 0x00000014, 0x00030047, 0x00000060, 0x00000002, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 
-	0x00000002, 0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000004, 0x00040015, 0x00000008, 
-	0x00000020, 0x00000000, 0x00040017, 0x00000009, 0x00000008, 0x00000002, 0x0004001E, 0x0000000A, 0x00000007, 0x00000009, 
-	0x00040020, 0x0000000B, 0x00000002, 0x0000000A, 0x0004003B, 0x0000000B, 0x0000000C, 0x00000002, 0x00040015, 0x0000000D, 
-	0x00000020, 0x00000001, 0x0004002B, 0x0000000D, 0x0000000E, 0x00000001, 0x0004002B, 0x00000008, 0x0000000F, 0x00000000, 
-	0x00040020, 0x00000010, 0x00000002, 0x00000008, 0x00020014, 0x00000013, 0x00040017, 0x00000017, 0x00000006, 0x00000002, 
-	0x00040020, 0x00000018, 0x00000001, 0x00000017, 0x0004003B, 0x00000018, 0x00000019, 0x00000001, 0x00040020, 0x0000001A, 
-	0x00000001, 0x00000006, 0x0004002B, 0x00000006, 0x0000001D, 0x00000000, 0x0004002B, 0x00000006, 0x00000024, 0x3F800000, 
-	0x00040020, 0x00000029, 0x00000003, 0x00000007, 0x0004003B, 0x00000029, 0x0000002A, 0x00000003, 0x0004002B, 0x0000000D, 
-	0x0000002B, 0x00000000, 0x00040020, 0x0000002C, 0x00000002, 0x00000007, 0x0004002B, 0x00000008, 0x00000030, 0x00000001, 
-	0x00040020, 0x00000045, 0x00000007, 0x00000007, 0x00090019, 0x00000047, 0x00000006, 0x00000001, 0x00000000, 0x00000001, 
-	0x00000000, 0x00000001, 0x00000000, 0x00040020, 0x00000048, 0x00000000, 0x00000047, 0x0004003B, 0x00000048, 0x00000049, 
-	0x00000000, 0x0002001A, 0x0000004B, 0x00040020, 0x0000004C, 0x00000000, 0x0000004B, 0x0004003B, 0x0000004C, 0x0000004D, 
-	0x00000000, 0x0003001B, 0x0000004F, 0x00000047, 0x00040020, 0x00000052, 0x00000001, 0x00000008, 0x0004003B, 0x00000052, 
-	0x00000053, 0x00000001, 0x00040017, 0x00000056, 0x00000006, 0x00000003, 0x00040020, 0x0000005C, 0x00000001, 0x00000007, 
-	0x0004003B, 0x0000005C, 0x0000005D, 0x00000001, 0x0008001E, 0x00000060, 0x00000008, 0x00000008, 0x00000008, 0x00000008, 
+	0x00000000, 0x00060005, 0x00000062, 0x68737570, 0x6E6F635F, 0x6E617473, 0x00007374, 0x00070006, 0x00000060, 0x00000006, 
+	0x74786574, 0x5F657275, 0x65646E69, 0x00000078, 0x00070005, 0x00000065, 0x54584554, 0x5F455255, 0x41525241, 0x49535F59, 
+	0x0000455A, 0x00050048, 0x0000000A, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x0000000A, 0x00000001, 0x00000023, 
+	0x00000010, 0x00030047, 0x0000000A, 0x00000002, 0x00040047, 0x0000000C, 0x00000022, 0x00000004, 0x00040047, 0x0000000C, 
+	0x00000021, 0x00000001, 0x00040047, 0x00000019, 0x0000001E, 0x00000000, 0x00040047, 0x0000002A, 0x0000001E, 0x00000000, 
+	0x00040047, 0x00000049, 0x00000022, 0x00000005, 0x00040047, 0x00000049, 0x00000021, 0x00000000, 0x00040047, 0x0000004D, 
+	0x00000022, 0x00000004, 0x00040047, 0x0000004D, 0x00000021, 0x00000000, 0x00030047, 0x00000053, 0x0000000E, 0x00040047, 
+	0x00000053, 0x0000001E, 0x00000002, 0x00040047, 0x0000005D, 0x0000001E, 0x00000001, 0x00050048, 0x00000060, 0x00000000, 
+	0x00000023, 0x00000000, 0x00050048, 0x00000060, 0x00000001, 0x00000023, 0x00000004, 0x00050048, 0x00000060, 0x00000002, 
+	0x00000023, 0x00000008, 0x00050048, 0x00000060, 0x00000003, 0x00000023, 0x0000000C, 0x00050048, 0x00000060, 0x00000004, 
+	0x00000023, 0x00000010, 0x00050048, 0x00000060, 0x00000005, 0x00000023, 0x00000014, 0x00050048, 0x00000060, 0x00000006, 
+	0x00000023, 0x00000018, 0x00030047, 0x00000060, 0x00000002, 0x00040047, 0x00000065, 0x00000001, 0x00000000, 0x00020013, 
+	0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 
+	0x00000004, 0x00040015, 0x00000008, 0x00000020, 0x00000000, 0x00040017, 0x00000009, 0x00000008, 0x00000002, 0x0004001E, 
+	0x0000000A, 0x00000007, 0x00000009, 0x00040020, 0x0000000B, 0x00000002, 0x0000000A, 0x0004003B, 0x0000000B, 0x0000000C, 
+	0x00000002, 0x00040015, 0x0000000D, 0x00000020, 0x00000001, 0x0004002B, 0x0000000D, 0x0000000E, 0x00000001, 0x0004002B, 
+	0x00000008, 0x0000000F, 0x00000000, 0x00040020, 0x00000010, 0x00000002, 0x00000008, 0x00020014, 0x00000013, 0x00040017, 
+	0x00000017, 0x00000006, 0x00000002, 0x00040020, 0x00000018, 0x00000001, 0x00000017, 0x0004003B, 0x00000018, 0x00000019, 
+	0x00000001, 0x00040020, 0x0000001A, 0x00000001, 0x00000006, 0x0004002B, 0x00000006, 0x0000001D, 0x00000000, 0x0004002B, 
+	0x00000006, 0x00000024, 0x3F800000, 0x00040020, 0x00000029, 0x00000003, 0x00000007, 0x0004003B, 0x00000029, 0x0000002A, 
+	0x00000003, 0x0004002B, 0x0000000D, 0x0000002B, 0x00000000, 0x00040020, 0x0000002C, 0x00000002, 0x00000007, 0x0004002B, 
+	0x00000008, 0x00000030, 0x00000001, 0x00040020, 0x00000045, 0x00000007, 0x00000007, 0x00090019, 0x00000047, 0x00000006, 
+	0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00040020, 0x00000048, 0x00000000, 0x00000047, 
+	0x0002001A, 0x0000004B, 0x00040020, 0x0000004C, 0x00000000, 0x0000004B, 0x0004003B, 0x0000004C, 0x0000004D, 0x00000000, 
+	0x0003001B, 0x0000004F, 0x00000047, 0x00040020, 0x00000052, 0x00000001, 0x00000008, 0x0004003B, 0x00000052, 0x00000053, 
+	0x00000001, 0x00040017, 0x00000056, 0x00000006, 0x00000003, 0x00040020, 0x0000005C, 0x00000001, 0x00000007, 0x0004003B, 
+	0x0000005C, 0x0000005D, 0x00000001, 0x0009001E, 0x00000060, 0x00000008, 0x00000008, 0x00000008, 0x00000008, 0x00000008, 
 	0x00000008, 0x00000008, 0x00040020, 0x00000061, 0x00000009, 0x00000060, 0x0004003B, 0x00000061, 0x00000062, 0x00000009, 
-	0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200F8, 0x00000005, 0x0004003B, 0x00000045, 0x00000046, 
-	0x00000007, 0x00060041, 0x00000010, 0x00000011, 0x0000000C, 0x0000000E, 0x0000000F, 0x0004003D, 0x00000008, 0x00000012, 
-	0x00000011, 0x000500AC, 0x00000013, 0x00000014, 0x00000012, 0x0000000F, 0x000300F7, 0x00000016, 0x00000000, 0x000400FA, 
-	0x00000014, 0x00000015, 0x00000016, 0x000200F8, 0x00000015, 0x00050041, 0x0000001A, 0x0000001B, 0x00000019, 0x0000000F, 
-	0x0004003D, 0x00000006, 0x0000001C, 0x0000001B, 0x000500B8, 0x00000013, 0x0000001E, 0x0000001C, 0x0000001D, 0x000400A8, 
-	0x00000013, 0x0000001F, 0x0000001E, 0x000300F7, 0x00000021, 0x00000000, 0x000400FA, 0x0000001F, 0x00000020, 0x00000021, 
-	0x000200F8, 0x00000020, 0x00050041, 0x0000001A, 0x00000022, 0x00000019, 0x0000000F, 0x0004003D, 0x00000006, 0x00000023, 
-	0x00000022, 0x000500BA, 0x00000013, 0x00000025, 0x00000023, 0x00000024, 0x000200F9, 0x00000021, 0x000200F8, 0x00000021, 
-	0x000700F5, 0x00000013, 0x00000026, 0x0000001E, 0x00000015, 0x00000025, 0x00000020, 0x000300F7, 0x00000028, 0x00000000, 
-	0x000400FA, 0x00000026, 0x00000027, 0x00000028, 0x000200F8, 0x00000027, 0x00050041, 0x0000002C, 0x0000002D, 0x0000000C, 
-	0x0000002B, 0x0004003D, 0x00000007, 0x0000002E, 0x0000002D, 0x0003003E, 0x0000002A, 0x0000002E, 0x000100FD, 0x000200F8, 
-	0x00000028, 0x000200F9, 0x00000016, 0x000200F8, 0x00000016, 0x00060041, 0x00000010, 0x00000031, 0x0000000C, 0x0000000E, 
-	0x00000030, 0x0004003D, 0x00000008, 0x00000032, 0x00000031, 0x000500AC, 0x00000013, 0x00000033, 0x00000032, 0x0000000F, 
-	0x000300F7, 0x00000035, 0x00000000, 0x000400FA, 0x00000033, 0x00000034, 0x00000035, 0x000200F8, 0x00000034, 0x00050041, 
-	0x0000001A, 0x00000036, 0x00000019, 0x00000030, 0x0004003D, 0x00000006, 0x00000037, 0x00000036, 0x000500B8, 0x00000013, 
-	0x00000038, 0x00000037, 0x0000001D, 0x000400A8, 0x00000013, 0x00000039, 0x00000038, 0x000300F7, 0x0000003B, 0x00000000, 
-	0x000400FA, 0x00000039, 0x0000003A, 0x0000003B, 0x000200F8, 0x0000003A, 0x00050041, 0x0000001A, 0x0000003C, 0x00000019, 
-	0x00000030, 0x0004003D, 0x00000006, 0x0000003D, 0x0000003C, 0x000500BA, 0x00000013, 0x0000003E, 0x0000003D, 0x00000024, 
-	0x000200F9, 0x0000003B, 0x000200F8, 0x0000003B, 0x000700F5, 0x00000013, 0x0000003F, 0x00000038, 0x00000034, 0x0000003E, 
-	0x0000003A, 0x000300F7, 0x00000041, 0x00000000, 0x000400FA, 0x0000003F, 0x00000040, 0x00000041, 0x000200F8, 0x00000040, 
-	0x00050041, 0x0000002C, 0x00000042, 0x0000000C, 0x0000002B, 0x0004003D, 0x00000007, 0x00000043, 0x00000042, 0x0003003E, 
-	0x0000002A, 0x00000043, 0x000100FD, 0x000200F8, 0x00000041, 0x000200F9, 0x00000035, 0x000200F8, 0x00000035, 0x0004003D, 
-	0x00000047, 0x0000004A, 0x00000049, 0x0004003D, 0x0000004B, 0x0000004E, 0x0000004D, 0x00050056, 0x0000004F, 0x00000050, 
-	0x0000004A, 0x0000004E, 0x0004003D, 0x00000017, 0x00000051, 0x00000019, 0x0004003D, 0x00000008, 0x00000054, 0x00000053, 
-	0x00040070, 0x00000006, 0x00000055, 0x00000054, 0x00050051, 0x00000006, 0x00000057, 0x00000051, 0x00000000, 0x00050051, 
-	0x00000006, 0x00000058, 0x00000051, 0x00000001, 0x00060050, 0x00000056, 0x00000059, 0x00000057, 0x00000058, 0x00000055, 
-	0x00050057, 0x00000007, 0x0000005A, 0x00000050, 0x00000059, 0x0003003E, 0x00000046, 0x0000005A, 0x0004003D, 0x00000007, 
-	0x0000005B, 0x00000046, 0x0004003D, 0x00000007, 0x0000005E, 0x0000005D, 0x00050085, 0x00000007, 0x0000005F, 0x0000005B, 
-	0x0000005E, 0x0003003E, 0x0000002A, 0x0000005F, 0x000100FD, 0x00010038
+	0x0004002B, 0x0000000D, 0x00000063, 0x00000006, 0x00040020, 0x00000064, 0x00000009, 0x00000008, 0x00040032, 0x00000008, 
+	0x00000065, 0x00000001, 0x0004001C, 0x00000066, 0x00000047, 0x00000065, 0x00040020, 0x00000067, 0x00000000, 0x00000066, 
+	0x0004003B, 0x00000067, 0x00000049, 0x00000000, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200F8, 
+	0x00000005, 0x0004003B, 0x00000045, 0x00000046, 0x00000007, 0x00060041, 0x00000010, 0x00000011, 0x0000000C, 0x0000000E, 
+	0x0000000F, 0x0004003D, 0x00000008, 0x00000012, 0x00000011, 0x000500AC, 0x00000013, 0x00000014, 0x00000012, 0x0000000F, 
+	0x000300F7, 0x00000016, 0x00000000, 0x000400FA, 0x00000014, 0x00000015, 0x00000016, 0x000200F8, 0x00000015, 0x00050041, 
+	0x0000001A, 0x0000001B, 0x00000019, 0x0000000F, 0x0004003D, 0x00000006, 0x0000001C, 0x0000001B, 0x000500B8, 0x00000013, 
+	0x0000001E, 0x0000001C, 0x0000001D, 0x000400A8, 0x00000013, 0x0000001F, 0x0000001E, 0x000300F7, 0x00000021, 0x00000000, 
+	0x000400FA, 0x0000001F, 0x00000020, 0x00000021, 0x000200F8, 0x00000020, 0x00050041, 0x0000001A, 0x00000022, 0x00000019, 
+	0x0000000F, 0x0004003D, 0x00000006, 0x00000023, 0x00000022, 0x000500BA, 0x00000013, 0x00000025, 0x00000023, 0x00000024, 
+	0x000200F9, 0x00000021, 0x000200F8, 0x00000021, 0x000700F5, 0x00000013, 0x00000026, 0x0000001E, 0x00000015, 0x00000025, 
+	0x00000020, 0x000300F7, 0x00000028, 0x00000000, 0x000400FA, 0x00000026, 0x00000027, 0x00000028, 0x000200F8, 0x00000027, 
+	0x00050041, 0x0000002C, 0x0000002D, 0x0000000C, 0x0000002B, 0x0004003D, 0x00000007, 0x0000002E, 0x0000002D, 0x0003003E, 
+	0x0000002A, 0x0000002E, 0x000100FD, 0x000200F8, 0x00000028, 0x000200F9, 0x00000016, 0x000200F8, 0x00000016, 0x00060041, 
+	0x00000010, 0x00000031, 0x0000000C, 0x0000000E, 0x00000030, 0x0004003D, 0x00000008, 0x00000032, 0x00000031, 0x000500AC, 
+	0x00000013, 0x00000033, 0x00000032, 0x0000000F, 0x000300F7, 0x00000035, 0x00000000, 0x000400FA, 0x00000033, 0x00000034, 
+	0x00000035, 0x000200F8, 0x00000034, 0x00050041, 0x0000001A, 0x00000036, 0x00000019, 0x00000030, 0x0004003D, 0x00000006, 
+	0x00000037, 0x00000036, 0x000500B8, 0x00000013, 0x00000038, 0x00000037, 0x0000001D, 0x000400A8, 0x00000013, 0x00000039, 
+	0x00000038, 0x000300F7, 0x0000003B, 0x00000000, 0x000400FA, 0x00000039, 0x0000003A, 0x0000003B, 0x000200F8, 0x0000003A, 
+	0x00050041, 0x0000001A, 0x0000003C, 0x00000019, 0x00000030, 0x0004003D, 0x00000006, 0x0000003D, 0x0000003C, 0x000500BA, 
+	0x00000013, 0x0000003E, 0x0000003D, 0x00000024, 0x000200F9, 0x0000003B, 0x000200F8, 0x0000003B, 0x000700F5, 0x00000013, 
+	0x0000003F, 0x00000038, 0x00000034, 0x0000003E, 0x0000003A, 0x000300F7, 0x00000041, 0x00000000, 0x000400FA, 0x0000003F, 
+	0x00000040, 0x00000041, 0x000200F8, 0x00000040, 0x00050041, 0x0000002C, 0x00000042, 0x0000000C, 0x0000002B, 0x0004003D, 
+	0x00000007, 0x00000043, 0x00000042, 0x0003003E, 0x0000002A, 0x00000043, 0x000100FD, 0x000200F8, 0x00000041, 0x000200F9, 
+	0x00000035, 0x000200F8, 0x00000035, 0x00050041, 0x00000064, 0x00000068, 0x00000062, 0x00000063, 0x0004003D, 0x00000008, 
+	0x00000069, 0x00000068, 0x00050041, 0x00000048, 0x0000006A, 0x00000049, 0x00000069, 0x0004003D, 0x00000047, 0x0000004A, 
+	0x0000006A, 0x0004003D, 0x0000004B, 0x0000004E, 0x0000004D, 0x00050056, 0x0000004F, 0x00000050, 0x0000004A, 0x0000004E, 
+	0x0004003D, 0x00000017, 0x00000051, 0x00000019, 0x0004003D, 0x00000008, 0x00000054, 0x00000053, 0x00040070, 0x00000006, 
+	0x00000055, 0x00000054, 0x00050051, 0x00000006, 0x00000057, 0x00000051, 0x00000000, 0x00050051, 0x00000006, 0x00000058, 
+	0x00000051, 0x00000001, 0x00060050, 0x00000056, 0x00000059, 0x00000057, 0x00000058, 0x00000055, 0x00050057, 0x00000007, 
+	0x0000005A, 0x00000050, 0x00000059, 0x0003003E, 0x00000046, 0x0000005A, 0x0004003D, 0x00000007, 0x0000005B, 0x00000046, 
+	0x0004003D, 0x00000007, 0x0000005E, 0x0000005D, 0x00050085, 0x00000007, 0x0000005F, 0x0000005B, 0x0000005E, 0x0003003E, 
+	0x0000002A, 0x0000005F, 0x000100FD, 0x00010038
 };
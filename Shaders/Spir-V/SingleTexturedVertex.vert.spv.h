@@ -1,7 +1,7 @@
 #pragma once
 #include <array>
 #include <stdint.h>
-std::array<uint32_t, 960> SingleTexturedVertex_vert_shader_data {
+std::array<uint32_t, 973> SingleTexturedVertex_vert_shader_data {
 	0x07230203, 0x00010000, 0x00080008, 0x00000069, 0x00000000, 0x00020011, 0x00000001, 0x0006000B, 0x00000001, 0x4C534C47, 
 	0x6474732E, 0x3035342E, 0x00000000, 0x0003000E, 0x00000000, 0x00000001, 0x000B000F, 0x00000000, 0x00000004, 0x6E69616D, 
 	0x00000000, 0x00000012, 0x00000028, 0x00000033, 0x00000039, 0x00000040, 0x0000005B, 0x00030003, 0x00000002, 0x000001C2, 
@@ -31,71 +31,73 @@ std::array<uint32_t, 960> SingleTexturedVertex_vert_shader_data {
 	0x7461645F, 0x00000061, 0x00060005, 0x00000059, 0x505F6C67, 0x65567265, 0x78657472, 0x00000000, 0x00060006, 0x00000059, 
 	0x00000000, 0x505F6C67, 0x7469736F, 0x006E6F69, 0x00070006, 0x00000059, 0x00000001, 0x505F6C67, 0x746E696F, 0x657A6953, 
 	0x00000000, 0x00070006, 0x00000059, 0x00000002, 0x435F6C67, 0x4470696C, 0x61747369, 0x0065636E, 0x00070006, 0x00000059, 
-	0x00000003, 0x435F6C67, 0x446C6C75, 0x61747369, 0x0065636E, 0x00030005, 0x0000005B, 0x00000000, 0x00040047, 0x0000000B, 
-	0x00000006, 0x00000040, 0x00040048, 0x0000000C, 0x00000000, 0x00000005, 0x00040048, 0x0000000C, 0x00000000, 0x00000018, 
-	0x00050048, 0x0000000C, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x0000000C, 0x00000000, 0x00000007, 0x00000010, 
-	0x00030047, 0x0000000C, 0x00000003, 0x00040047, 0x0000000E, 0x00000022, 0x00000001, 0x00040047, 0x0000000E, 0x00000021, 
-	0x00000000, 0x00040047, 0x00000012, 0x0000000B, 0x0000002B, 0x00050048, 0x00000016, 0x00000000, 0x00000023, 0x00000000, 
-	0x00050048, 0x00000016, 0x00000001, 0x00000023, 0x00000004, 0x00050048, 0x00000016, 0x00000002, 0x00000023, 0x00000008, 
-	0x00050048, 0x00000016, 0x00000003, 0x00000023, 0x0000000C, 0x00050048, 0x00000016, 0x00000004, 0x00000023, 0x00000010, 
-	0x00050048, 0x00000016, 0x00000005, 0x00000023, 0x00000014, 0x00030047, 0x00000016, 0x00000002, 0x00050048, 0x00000023, 
-	0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000023, 0x00000001, 0x00000023, 0x00000008, 0x00050048, 0x00000023, 
-	0x00000002, 0x00000023, 0x00000010, 0x00050048, 0x00000023, 0x00000003, 0x00000023, 0x00000020, 0x00050048, 0x00000023, 
-	0x00000004, 0x00000023, 0x00000024, 0x00040047, 0x00000024, 0x00000006, 0x00000030, 0x00040048, 0x00000025, 0x00000000, 
-	0x00000018, 0x00050048, 0x00000025, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000025, 0x00000003, 0x00040047, 
-	0x00000027, 0x00000022, 0x00000003, 0x00040047, 0x00000027, 0x00000021, 0x00000000, 0x00040047, 0x00000028, 0x0000000B, 
-	0x0000002A, 0x00040047, 0x00000033, 0x0000001E, 0x00000000, 0x00040047, 0x00000039, 0x0000001E, 0x00000001, 0x00030047, 
-	0x00000040, 0x0000000E, 0x00040047, 0x00000040, 0x0000001E, 0x00000002, 0x00050048, 0x0000004E, 0x00000000, 0x00000023, 
-	0x00000000, 0x00050048, 0x0000004E, 0x00000001, 0x00000023, 0x00000008, 0x00030047, 0x0000004E, 0x00000002, 0x00040047, 
-	0x00000050, 0x00000022, 0x00000000, 0x00040047, 0x00000050, 0x00000021, 0x00000000, 0x00050048, 0x00000059, 0x00000000, 
-	0x0000000B, 0x00000000, 0x00050048, 0x00000059, 0x00000001, 0x0000000B, 0x00000001, 0x00050048, 0x00000059, 0x00000002, 
-	0x0000000B, 0x00000003, 0x00050048, 0x00000059, 0x00000003, 0x0000000B, 0x00000004, 0x00030047, 0x00000059, 0x00000002, 
-	0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 
-	0x00000006, 0x00000004, 0x00040018, 0x00000008, 0x00000007, 0x00000004, 0x00040020, 0x00000009, 0x00000007, 0x00000008, 
-	0x0003001D, 0x0000000B, 0x00000008, 0x0003001E, 0x0000000C, 0x0000000B, 0x00040020, 0x0000000D, 0x00000002, 0x0000000C, 
-	0x0004003B, 0x0000000D, 0x0000000E, 0x00000002, 0x00040015, 0x0000000F, 0x00000020, 0x00000001, 0x0004002B, 0x0000000F, 
-	0x00000010, 0x00000000, 0x00040020, 0x00000011, 0x00000001, 0x0000000F, 0x0004003B, 0x00000011, 0x00000012, 0x00000001, 
-	0x00040015, 0x00000014, 0x00000020, 0x00000000, 0x0008001E, 0x00000016, 0x00000014, 0x00000014, 0x00000014, 0x00000014, 
-	0x00000014, 0x00000014, 0x00040020, 0x00000017, 0x00000009, 0x00000016, 0x0004003B, 0x00000017, 0x00000018, 0x00000009, 
-	0x00040020, 0x00000019, 0x00000009, 0x00000014, 0x00040020, 0x0000001D, 0x00000002, 0x00000008, 0x00040020, 0x00000020, 
-	0x00000007, 0x00000007, 0x00040017, 0x00000022, 0x00000006, 0x00000002, 0x0007001E, 0x00000023, 0x00000022, 0x00000022, 
-	0x00000007, 0x00000006, 0x00000014, 0x0003001D, 0x00000024, 0x00000023, 0x0003001E, 0x00000025, 0x00000024, 0x00040020, 
-	0x00000026, 0x00000002, 0x00000025, 0x0004003B, 0x00000026, 0x00000027, 0x00000002, 0x0004003B, 0x00000011, 0x00000028, 
-	0x00000001, 0x00040020, 0x0000002A, 0x00000002, 0x00000022, 0x0004002B, 0x00000006, 0x0000002D, 0x00000000, 0x0004002B, 
-	0x00000006, 0x0000002E, 0x3F800000, 0x00040020, 0x00000032, 0x00000003, 0x00000022, 0x0004003B, 0x00000032, 0x00000033, 
-	0x00000003, 0x0004002B, 0x0000000F, 0x00000035, 0x00000001, 0x00040020, 0x00000038, 0x00000003, 0x00000007, 0x0004003B, 
-	0x00000038, 0x00000039, 0x00000003, 0x0004002B, 0x0000000F, 0x0000003B, 0x00000002, 0x00040020, 0x0000003C, 0x00000002, 
-	0x00000007, 0x00040020, 0x0000003F, 0x00000003, 0x00000014, 0x0004003B, 0x0000003F, 0x00000040, 0x00000003, 0x0004002B, 
-	0x0000000F, 0x00000042, 0x00000004, 0x00040020, 0x00000043, 0x00000002, 0x00000014, 0x00040020, 0x00000046, 0x00000007, 
-	0x00000022, 0x0004001E, 0x0000004E, 0x00000022, 0x00000022, 0x00040020, 0x0000004F, 0x00000002, 0x0000004E, 0x0004003B, 
-	0x0000004F, 0x00000050, 0x00000002, 0x0004002B, 0x00000014, 0x00000057, 0x00000001, 0x0004001C, 0x00000058, 0x00000006, 
-	0x00000057, 0x0006001E, 0x00000059, 0x00000007, 0x00000006, 0x00000058, 0x00000058, 0x00040020, 0x0000005A, 0x00000003, 
-	0x00000059, 0x0004003B, 0x0000005A, 0x0000005B, 0x00000003, 0x0004002B, 0x00000006, 0x0000005D, 0x3F000000, 0x0004002B, 
-	0x0000000F, 0x00000063, 0x00000003, 0x00040020, 0x00000064, 0x00000002, 0x00000006, 0x00040020, 0x00000067, 0x00000003, 
-	0x00000006, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200F8, 0x00000005, 0x0004003B, 0x00000009, 
-	0x0000000A, 0x00000007, 0x0004003B, 0x00000020, 0x00000021, 0x00000007, 0x0004003B, 0x00000046, 0x00000047, 0x00000007, 
-	0x0004003B, 0x00000046, 0x0000004C, 0x00000007, 0x0004003D, 0x0000000F, 0x00000013, 0x00000012, 0x0004007C, 0x00000014, 
-	0x00000015, 0x00000013, 0x00050041, 0x00000019, 0x0000001A, 0x00000018, 0x00000010, 0x0004003D, 0x00000014, 0x0000001B, 
-	0x0000001A, 0x00050080, 0x00000014, 0x0000001C, 0x00000015, 0x0000001B, 0x00060041, 0x0000001D, 0x0000001E, 0x0000000E, 
-	0x00000010, 0x0000001C, 0x0004003D, 0x00000008, 0x0000001F, 0x0000001E, 0x0003003E, 0x0000000A, 0x0000001F, 0x0004003D, 
-	0x0000000F, 0x00000029, 0x00000028, 0x00070041, 0x0000002A, 0x0000002B, 0x00000027, 0x00000010, 0x00000029, 0x00000010, 
-	0x0004003D, 0x00000022, 0x0000002C, 0x0000002B, 0x00050051, 0x00000006, 0x0000002F, 0x0000002C, 0x00000000, 0x00050051, 
-	0x00000006, 0x00000030, 0x0000002C, 0x00000001, 0x00070050, 0x00000007, 0x00000031, 0x0000002F, 0x00000030, 0x0000002D, 
-	0x0000002E, 0x0003003E, 0x00000021, 0x00000031, 0x0004003D, 0x0000000F, 0x00000034, 0x00000028, 0x00070041, 0x0000002A, 
-	0x00000036, 0x00000027, 0x00000010, 0x00000034, 0x00000035, 0x0004003D, 0x00000022, 0x00000037, 0x00000036, 0x0003003E, 
-	0x00000033, 0x00000037, 0x0004003D, 0x0000000F, 0x0000003A, 0x00000028, 0x00070041, 0x0000003C, 0x0000003D, 0x00000027, 
-	0x00000010, 0x0000003A, 0x0000003B, 0x0004003D, 0x00000007, 0x0000003E, 0x0000003D, 0x0003003E, 0x00000039, 0x0000003E, 
-	0x0004003D, 0x0000000F, 0x00000041, 0x00000028, 0x00070041, 0x00000043, 0x00000044, 0x00000027, 0x00000010, 0x00000041, 
-	0x00000042, 0x0004003D, 0x00000014, 0x00000045, 0x00000044, 0x0003003E, 0x00000040, 0x00000045, 0x0004003D, 0x00000008, 
-	0x00000048, 0x0000000A, 0x0004003D, 0x00000007, 0x00000049, 0x00000021, 0x00050091, 0x00000007, 0x0000004A, 0x00000048, 
-	0x00000049, 0x0007004F, 0x00000022, 0x0000004B, 0x0000004A, 0x0000004A, 0x00000000, 0x00000001, 0x0003003E, 0x00000047, 
-	0x0000004B, 0x0004003D, 0x00000022, 0x0000004D, 0x00000047, 0x00050041, 0x0000002A, 0x00000051, 0x00000050, 0x00000010, 
-	0x0004003D, 0x00000022, 0x00000052, 0x00000051, 0x00050085, 0x00000022, 0x00000053, 0x0000004D, 0x00000052, 0x00050041, 
-	0x0000002A, 0x00000054, 0x00000050, 0x00000035, 0x0004003D, 0x00000022, 0x00000055, 0x00000054, 0x00050081, 0x00000022, 
-	0x00000056, 0x00000053, 0x00000055, 0x0003003E, 0x0000004C, 0x00000056, 0x0004003D, 0x00000022, 0x0000005C, 0x0000004C, 
-	0x00050051, 0x00000006, 0x0000005E, 0x0000005C, 0x00000000, 0x00050051, 0x00000006, 0x0000005F, 0x0000005C, 0x00000001, 
-	0x00070050, 0x00000007, 0x00000060, 0x0000005E, 0x0000005F, 0x0000005D, 0x0000002E, 0x00050041, 0x00000038, 0x00000061, 
-	0x0000005B, 0x00000010, 0x0003003E, 0x00000061, 0x00000060, 0x0004003D, 0x0000000F, 0x00000062, 0x00000028, 0x00070041, 
-	0x00000064, 0x00000065, 0x00000027, 0x00000010, 0x00000062, 0x00000063, 0x0004003D, 0x00000006, 0x00000066, 0x00000065, 
-	0x00050041, 0x00000067, 0x00000068, 0x0000005B, 0x00000035, 0x0003003E, 0x00000068, 0x00000066, 0x000100FD, 0x00010038
+	0x00000003, 0x435F6C67, 0x446C6C75, 0x61747369, 0x0065636E, 0x00030005, 0x0000005B, 0x00000000, 0x00070006, 0x00000016, 
+	0x00000006, 0x74786574, 0x5F657275, 0x65646E69, 0x00000078, 0x00040047, 0x0000000B, 0x00000006, 0x00000040, 0x00040048, 
+	0x0000000C, 0x00000000, 0x00000005, 0x00040048, 0x0000000C, 0x00000000, 0x00000018, 0x00050048, 0x0000000C, 0x00000000, 
+	0x00000023, 0x00000000, 0x00050048, 0x0000000C, 0x00000000, 0x00000007, 0x00000010, 0x00030047, 0x0000000C, 0x00000003, 
+	0x00040047, 0x0000000E, 0x00000022, 0x00000001, 0x00040047, 0x0000000E, 0x00000021, 0x00000000, 0x00040047, 0x00000012, 
+	0x0000000B, 0x0000002B, 0x00050048, 0x00000016, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000016, 0x00000001, 
+	0x00000023, 0x00000004, 0x00050048, 0x00000016, 0x00000002, 0x00000023, 0x00000008, 0x00050048, 0x00000016, 0x00000003, 
+	0x00000023, 0x0000000C, 0x00050048, 0x00000016, 0x00000004, 0x00000023, 0x00000010, 0x00050048, 0x00000016, 0x00000005, 
+	0x00000023, 0x00000014, 0x00050048, 0x00000016, 0x00000006, 0x00000023, 0x00000018, 0x00030047, 0x00000016, 0x00000002, 
+	0x00050048, 0x00000023, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000023, 0x00000001, 0x00000023, 0x00000008, 
+	0x00050048, 0x00000023, 0x00000002, 0x00000023, 0x00000010, 0x00050048, 0x00000023, 0x00000003, 0x00000023, 0x00000020, 
+	0x00050048, 0x00000023, 0x00000004, 0x00000023, 0x00000024, 0x00040047, 0x00000024, 0x00000006, 0x00000030, 0x00040048, 
+	0x00000025, 0x00000000, 0x00000018, 0x00050048, 0x00000025, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000025, 
+	0x00000003, 0x00040047, 0x00000027, 0x00000022, 0x00000003, 0x00040047, 0x00000027, 0x00000021, 0x00000000, 0x00040047, 
+	0x00000028, 0x0000000B, 0x0000002A, 0x00040047, 0x00000033, 0x0000001E, 0x00000000, 0x00040047, 0x00000039, 0x0000001E, 
+	0x00000001, 0x00030047, 0x00000040, 0x0000000E, 0x00040047, 0x00000040, 0x0000001E, 0x00000002, 0x00050048, 0x0000004E, 
+	0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x0000004E, 0x00000001, 0x00000023, 0x00000008, 0x00030047, 0x0000004E, 
+	0x00000002, 0x00040047, 0x00000050, 0x00000022, 0x00000000, 0x00040047, 0x00000050, 0x00000021, 0x00000000, 0x00050048, 
+	0x00000059, 0x00000000, 0x0000000B, 0x00000000, 0x00050048, 0x00000059, 0x00000001, 0x0000000B, 0x00000001, 0x00050048, 
+	0x00000059, 0x00000002, 0x0000000B, 0x00000003, 0x00050048, 0x00000059, 0x00000003, 0x0000000B, 0x00000004, 0x00030047, 
+	0x00000059, 0x00000002, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00030016, 0x00000006, 0x00000020, 
+	0x00040017, 0x00000007, 0x00000006, 0x00000004, 0x00040018, 0x00000008, 0x00000007, 0x00000004, 0x00040020, 0x00000009, 
+	0x00000007, 0x00000008, 0x0003001D, 0x0000000B, 0x00000008, 0x0003001E, 0x0000000C, 0x0000000B, 0x00040020, 0x0000000D, 
+	0x00000002, 0x0000000C, 0x0004003B, 0x0000000D, 0x0000000E, 0x00000002, 0x00040015, 0x0000000F, 0x00000020, 0x00000001, 
+	0x0004002B, 0x0000000F, 0x00000010, 0x00000000, 0x00040020, 0x00000011, 0x00000001, 0x0000000F, 0x0004003B, 0x00000011, 
+	0x00000012, 0x00000001, 0x00040015, 0x00000014, 0x00000020, 0x00000000, 0x0009001E, 0x00000016, 0x00000014, 0x00000014, 
+	0x00000014, 0x00000014, 0x00000014, 0x00000014, 0x00000014, 0x00040020, 0x00000017, 0x00000009, 0x00000016, 0x0004003B, 
+	0x00000017, 0x00000018, 0x00000009, 0x00040020, 0x00000019, 0x00000009, 0x00000014, 0x00040020, 0x0000001D, 0x00000002, 
+	0x00000008, 0x00040020, 0x00000020, 0x00000007, 0x00000007, 0x00040017, 0x00000022, 0x00000006, 0x00000002, 0x0007001E, 
+	0x00000023, 0x00000022, 0x00000022, 0x00000007, 0x00000006, 0x00000014, 0x0003001D, 0x00000024, 0x00000023, 0x0003001E, 
+	0x00000025, 0x00000024, 0x00040020, 0x00000026, 0x00000002, 0x00000025, 0x0004003B, 0x00000026, 0x00000027, 0x00000002, 
+	0x0004003B, 0x00000011, 0x00000028, 0x00000001, 0x00040020, 0x0000002A, 0x00000002, 0x00000022, 0x0004002B, 0x00000006, 
+	0x0000002D, 0x00000000, 0x0004002B, 0x00000006, 0x0000002E, 0x3F800000, 0x00040020, 0x00000032, 0x00000003, 0x00000022, 
+	0x0004003B, 0x00000032, 0x00000033, 0x00000003, 0x0004002B, 0x0000000F, 0x00000035, 0x00000001, 0x00040020, 0x00000038, 
+	0x00000003, 0x00000007, 0x0004003B, 0x00000038, 0x00000039, 0x00000003, 0x0004002B, 0x0000000F, 0x0000003B, 0x00000002, 
+	0x00040020, 0x0000003C, 0x00000002, 0x00000007, 0x00040020, 0x0000003F, 0x00000003, 0x00000014, 0x0004003B, 0x0000003F, 
+	0x00000040, 0x00000003, 0x0004002B, 0x0000000F, 0x00000042, 0x00000004, 0x00040020, 0x00000043, 0x00000002, 0x00000014, 
+	0x00040020, 0x00000046, 0x00000007, 0x00000022, 0x0004001E, 0x0000004E, 0x00000022, 0x00000022, 0x00040020, 0x0000004F, 
+	0x00000002, 0x0000004E, 0x0004003B, 0x0000004F, 0x00000050, 0x00000002, 0x0004002B, 0x00000014, 0x00000057, 0x00000001, 
+	0x0004001C, 0x00000058, 0x00000006, 0x00000057, 0x0006001E, 0x00000059, 0x00000007, 0x00000006, 0x00000058, 0x00000058, 
+	0x00040020, 0x0000005A, 0x00000003, 0x00000059, 0x0004003B, 0x0000005A, 0x0000005B, 0x00000003, 0x0004002B, 0x00000006, 
+	0x0000005D, 0x3F000000, 0x0004002B, 0x0000000F, 0x00000063, 0x00000003, 0x00040020, 0x00000064, 0x00000002, 0x00000006, 
+	0x00040020, 0x00000067, 0x00000003, 0x00000006, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200F8, 
+	0x00000005, 0x0004003B, 0x00000009, 0x0000000A, 0x00000007, 0x0004003B, 0x00000020, 0x00000021, 0x00000007, 0x0004003B, 
+	0x00000046, 0x00000047, 0x00000007, 0x0004003B, 0x00000046, 0x0000004C, 0x00000007, 0x0004003D, 0x0000000F, 0x00000013, 
+	0x00000012, 0x0004007C, 0x00000014, 0x00000015, 0x00000013, 0x00050041, 0x00000019, 0x0000001A, 0x00000018, 0x00000010, 
+	0x0004003D, 0x00000014, 0x0000001B, 0x0000001A, 0x00050080, 0x00000014, 0x0000001C, 0x00000015, 0x0000001B, 0x00060041, 
+	0x0000001D, 0x0000001E, 0x0000000E, 0x00000010, 0x0000001C, 0x0004003D, 0x00000008, 0x0000001F, 0x0000001E, 0x0003003E, 
+	0x0000000A, 0x0000001F, 0x0004003D, 0x0000000F, 0x00000029, 0x00000028, 0x00070041, 0x0000002A, 0x0000002B, 0x00000027, 
+	0x00000010, 0x00000029, 0x00000010, 0x0004003D, 0x00000022, 0x0000002C, 0x0000002B, 0x00050051, 0x00000006, 0x0000002F, 
+	0x0000002C, 0x00000000, 0x00050051, 0x00000006, 0x00000030, 0x0000002C, 0x00000001, 0x00070050, 0x00000007, 0x00000031, 
+	0x0000002F, 0x00000030, 0x0000002D, 0x0000002E, 0x0003003E, 0x00000021, 0x00000031, 0x0004003D, 0x0000000F, 0x00000034, 
+	0x00000028, 0x00070041, 0x0000002A, 0x00000036, 0x00000027, 0x00000010, 0x00000034, 0x00000035, 0x0004003D, 0x00000022, 
+	0x00000037, 0x00000036, 0x0003003E, 0x00000033, 0x00000037, 0x0004003D, 0x0000000F, 0x0000003A, 0x00000028, 0x00070041, 
+	0x0000003C, 0x0000003D, 0x00000027, 0x00000010, 0x0000003A, 0x0000003B, 0x0004003D, 0x00000007, 0x0000003E, 0x0000003D, 
+	0x0003003E, 0x00000039, 0x0000003E, 0x0004003D, 0x0000000F, 0x00000041, 0x00000028, 0x00070041, 0x00000043, 0x00000044, 
+	0x00000027, 0x00000010, 0x00000041, 0x00000042, 0x0004003D, 0x00000014, 0x00000045, 0x00000044, 0x0003003E, 0x00000040, 
+	0x00000045, 0x0004003D, 0x00000008, 0x00000048, 0x0000000A, 0x0004003D, 0x00000007, 0x00000049, 0x00000021, 0x00050091, 
+	0x00000007, 0x0000004A, 0x00000048, 0x00000049, 0x0007004F, 0x00000022, 0x0000004B, 0x0000004A, 0x0000004A, 0x00000000, 
+	0x00000001, 0x0003003E, 0x00000047, 0x0000004B, 0x0004003D, 0x00000022, 0x0000004D, 0x00000047, 0x00050041, 0x0000002A, 
+	0x00000051, 0x00000050, 0x00000010, 0x0004003D, 0x00000022, 0x00000052, 0x00000051, 0x00050085, 0x00000022, 0x00000053, 
+	0x0000004D, 0x00000052, 0x00050041, 0x0000002A, 0x00000054, 0x00000050, 0x00000035, 0x0004003D, 0x00000022, 0x00000055, 
+	0x00000054, 0x00050081, 0x00000022, 0x00000056, 0x00000053, 0x00000055, 0x0003003E, 0x0000004C, 0x00000056, 0x0004003D, 
+	0x00000022, 0x0000005C, 0x0000004C, 0x00050051, 0x00000006, 0x0000005E, 0x0000005C, 0x00000000, 0x00050051, 0x00000006, 
+	0x0000005F, 0x0000005C, 0x00000001, 0x00070050, 0x00000007, 0x00000060, 0x0000005E, 0x0000005F, 0x0000005D, 0x0000002E, 
+	0x00050041, 0x00000038, 0x00000061, 0x0000005B, 0x00000010, 0x0003003E, 0x00000061, 0x00000060, 0x0004003D, 0x0000000F, 
+	0x00000062, 0x00000028, 0x00070041, 0x00000064, 0x00000065, 0x00000027, 0x00000010, 0x00000062, 0x00000063, 0x0004003D, 
+	0x00000006, 0x00000066, 0x00000065, 0x00050041, 0x00000067, 0x00000068, 0x0000005B, 0x00000035, 0x0003003E, 0x00000068, 
+	0x00000066, 0x000100FD, 0x00010038
 };
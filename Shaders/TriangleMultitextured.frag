@@ -36,7 +36,9 @@ layout(std140, set=4, binding=1) uniform			image_sampler_data {
 } sampler_data;
 
 // Set 5: Texture
-layout(set=5, binding=0) uniform texture2DArray		sampled_image;
+// Texture array size is 1 unless bindless textures are used.
+layout(constant_id=0) const uint TEXTURE_ARRAY_SIZE = 1;
+layout(set=5, binding=0) uniform texture2DArray		sampled_images[ TEXTURE_ARRAY_SIZE ];
 
 // Set 6: Texture channel weights
 layout(std430, set=6, binding=0) readonly buffer	TextureChannelWeights {
@@ -51,6 +53,7 @@ layout(std140, push_constant) uniform PushConstants {
 	uint		vertex_offset;					// Offset to first vertex in vertex buffer.
 	uint		texture_channel_weight_offset;	// Location of the texture channels in the texture channel weights ssbo.
 	uint		texture_channel_weight_count;	// Just the amount of texture channels.
+	uint		texture_index;					// Index into the texture array, always 0 if not bindless.
 } push_constants;
 
 // From vertex shader.
@@ -189,7 +192,7 @@ vec4 CalculateTriangleWeightedTextureColor( uvec3 indices, vec3 vertex_weights )
 		float total_pixel_weight				= vertex_combined_channel_weights[ 0 ] + vertex_combined_channel_weights[ 1 ] + vertex_combined_channel_weights[ 2 ];
 
 		if( total_pixel_weight > 0.0 ) {
-			vec4 tc = texture( sampler2DArray( sampled_image, image_sampler ), vec3( fragment_input_UV, float( i ) ) );
+			vec4 tc = texture( sampler2DArray( sampled_images[ push_constants.texture_index ], image_sampler ), vec3( fragment_input_UV, float( i ) ) );
 			weighted_texture_color				+= tc * total_pixel_weight;
 		}
 	}
@@ -210,7 +213,7 @@ vec4 CalculateLineWeightedTextureColor( uvec2 indices, vec2 vertex_weights )
 		float total_pixel_weight				= vertex_combined_channel_weights[ 0 ] + vertex_combined_channel_weights[ 1 ];
 
 		if( total_pixel_weight > 0.0 ) {
-			vec4 tc = texture( sampler2DArray( sampled_image, image_sampler ), vec3( fragment_input_UV, float( i ) ) );
+			vec4 tc = texture( sampler2DArray( sampled_images[ push_constants.texture_index ], image_sampler ), vec3( fragment_input_UV, float( i ) ) );
 			weighted_texture_color				+= tc * total_pixel_weight;
 		}
 	}
@@ -226,7 +229,7 @@ vec4 CalculatePointWeightedTextureColor()
 		float total_pixel_weight		= texture_channel_weights.ssbo[ fragment_input_vertex_index * push_constants.texture_channel_weight_count + i ];
 
 		if( total_pixel_weight > 0.0 ) {
-			vec4 tc = texture( sampler2DArray( sampled_image, image_sampler ), vec3( fragment_input_UV, float( i ) ) );
+			vec4 tc = texture( sampler2DArray( sampled_images[ push_constants.texture_index ], image_sampler ), vec3( fragment_input_UV, float( i ) ) );
 			weighted_texture_color				+= tc * total_pixel_weight;
 		}
 	}
@@ -75,3 +75,68 @@
 #define VK2D_BUILD_OPTION_MESH_BUFFER_BLOCK_INDEX_SIZE					( 16	* 1024 * 1024 )
 #define VK2D_BUILD_OPTION_MESH_BUFFER_BLOCK_texture_channel_weight_SIZE	( 16	* 1024 * 1024 )
 #define VK2D_BUILD_OPTION_MESH_BUFFER_BLOCK_TRANSFORMATION_SIZE			( 16	* 1024 * 1024 )
+
+// Frame linear allocator hands out short lived host visible buffer ranges
+// that are valid for a single frame, eg. uniform data staging and screenshot
+// readback. Every frame in flight has its own set of pages which are reused
+// after the frame's fence has signaled. These define the initial page size
+// and the maximum size a page may grow to, allocations larger than the
+// maximum page size get a dedicated page that is released when the frame
+// is reset.
+// Initial page size is by default 256 Kb.
+// Maximum page size is by default 16 Mb.
+#define VK2D_BUILD_OPTION_FRAME_LINEAR_ALLOCATOR_PAGE_SIZE				( 256	* 1024 )
+#define VK2D_BUILD_OPTION_FRAME_LINEAR_ALLOCATOR_MAX_PAGE_SIZE			( 16	* 1024 * 1024 )
+
+// Buffer sub allocator hands out ranges from a few large shared buffers
+// instead of creating a VkBuffer for every staging, mesh or uniform buffer.
+// These define the size of a single shared buffer per usage class,
+// allocations larger than this get a dedicated buffer of their own.
+// Staging buffer is by default 32 Mb.
+// Mesh buffer is by default 128 Mb, fits all mesh buffer blocks of one render target.
+// Uniform buffer is by default 1 Mb.
+#define VK2D_BUILD_OPTION_BUFFER_SUB_ALLOCATOR_STAGING_PAGE_SIZE		( 32	* 1024 * 1024 )
+#define VK2D_BUILD_OPTION_BUFFER_SUB_ALLOCATOR_MESH_PAGE_SIZE			( 128	* 1024 * 1024 )
+#define VK2D_BUILD_OPTION_BUFFER_SUB_ALLOCATOR_UNIFORM_PAGE_SIZE		( 1		* 1024 * 1024 )
+
+// Images larger than a staging page don't get a dedicated staging buffer,
+// they're streamed to the GPU through a ring of staging chunks that every
+// loader thread keeps once it has streamed anything. The GPU copies out of
+// one chunk while the next one is filled. All chunks should fit in a single
+// staging page.
+// Chunk size is by default 8 Mb.
+// Chunk count is by default 3.
+#define VK2D_BUILD_OPTION_STAGING_STREAM_CHUNK_SIZE						( 8		* 1024 * 1024 )
+#define VK2D_BUILD_OPTION_STAGING_STREAM_CHUNK_COUNT					3
+
+// Render target texture readbacks copy into a ring of host cached staging
+// buffers that are reused between requests, this is the amount of readbacks
+// a render target texture can have in flight at once.
+// Ring size is by default 4.
+#define VK2D_BUILD_OPTION_RENDER_TARGET_READBACK_RING_SIZE				4
+
+// Memory defragmentation moves live textures out of the least used memory
+// chunk of a memory pool so that the chunk can be released. A chunk is only
+// considered for emptying if it's the least used chunk of its kind and less
+// than this percentage of it is in use, anything above that is not worth the
+// GPU copies.
+// Chunk usage threshold is by default 50 percent.
+#define VK2D_BUILD_OPTION_MEMORY_DEFRAGMENTATION_CHUNK_USAGE_THRESHOLD	50
+
+// Bindless textures keep every texture used by a render target in a single
+// large descriptor array and select the texture with an index in push
+// constants, texture changes no longer need a descriptor set bind. Requires
+// Vulkan 1.2 descriptor indexing, if the device doesn't support it we fall
+// back to binding a descriptor set per texture.
+// Capacity is the maximum amount of textures in the array per render target,
+// clamped to what the device supports.
+// Bindless textures are enabled by default.
+// Capacity is by default 4096 textures.
+#define VK2D_BUILD_OPTION_BINDLESS_TEXTURES								1
+#define VK2D_BUILD_OPTION_BINDLESS_TEXTURE_CAPACITY						4096
+
+// Texture and sampler descriptor sets are cached per render target. Entries
+// that haven't been used for this many frames are released, this is what
+// eventually frees descriptor sets of destroyed textures and samplers.
+// Eviction age is by default 120 frames.
+#define VK2D_BUILD_OPTION_DESCRIPTOR_SET_CACHE_EVICTION_AGE				120
@@ -23,9 +23,11 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <string>
 #include <cstring>
 #include <tuple>
+#include <functional>
 
 #include <thread>
 #include <mutex>
@@ -20,6 +20,9 @@
 #include "Interface/Window.h"
 #include "Interface/WindowImpl.h"
 
+#include "Interface/RenderTargetTexture.h"
+#include "Interface/RenderTargetTextureImpl.h"
+
 #include "Interface/Sampler.h"
 #include "Interface/SamplerImpl.h"
 
@@ -773,9 +776,33 @@ vk2d::_internal::PoolDescriptorSet vk2d::_internal::InstanceImpl::AllocateDescri
 	const vk2d::_internal::DescriptorSetLayout		&	for_descriptor_set_layout
 )
 {
-	std::lock_guard<std::mutex> lock_guard( descriptor_pool_mutex );
+	// Creator thread does nearly all allocations and has a pool of its own,
+	// other threads get their own pool the first time they allocate.
+	if( IsThisThreadCreatorThread() ) {
+		return descriptor_pool->AllocateDescriptorSet(
+			for_descriptor_set_layout
+		);
+	}
 
-	return descriptor_pool->AllocateDescriptorSet(
+	vk2d::_internal::DescriptorAutoPool * thread_descriptor_pool = nullptr;
+	{
+		std::lock_guard<std::mutex> lock_guard( descriptor_pool_mutex );
+
+		auto & pool = thread_descriptor_pools[ std::this_thread::get_id() ];
+		if( !pool ) {
+			pool = vk2d::_internal::CreateDescriptorAutoPool(
+				this,
+				vk_device
+			);
+		}
+		thread_descriptor_pool = pool.get();
+	}
+	if( !thread_descriptor_pool ) {
+		vk2d::_internal::PoolDescriptorSet failed {};
+		failed.result		= VK_ERROR_INITIALIZATION_FAILED;
+		return failed;
+	}
+	return thread_descriptor_pool->AllocateDescriptorSet(
 		for_descriptor_set_layout
 	);
 }
@@ -784,11 +811,21 @@ void vk2d::_internal::InstanceImpl::FreeDescriptorSet(
 	vk2d::_internal::PoolDescriptorSet & descriptor_set
 )
 {
-	std::lock_guard<std::mutex> lock_guard( descriptor_pool_mutex );
+	auto parent_pool = descriptor_set.GetParentAutoPool();
+	if( !parent_pool ) {
+		descriptor_set = {};
+		return;
+	}
 
-	descriptor_pool->FreeDescriptorSet(
-		descriptor_set
-	);
+	if( parent_pool->IsOwnerThread() ) {
+		parent_pool->FreeDescriptorSet(
+			descriptor_set
+		);
+	} else {
+		parent_pool->DeferredFreeDescriptorSet(
+			descriptor_set
+		);
+	}
 }
 
 
@@ -1012,6 +1049,11 @@ vk2d::ResourceManager * vk2d::_internal::InstanceImpl::GetResourceManager() cons
 	return resource_manager.get();
 }
 
+vk2d::_internal::ResourceManagerImpl * vk2d::_internal::InstanceImpl::GetResourceManagerImpl() const
+{
+	return resource_manager->impl.get();
+}
+
 VkInstance vk2d::_internal::InstanceImpl::GetVulkanInstance() const
 {
 	return vk_instance;
@@ -1175,6 +1217,20 @@ VkPipeline vk2d::_internal::InstanceImpl::CreateGraphicsPipeline(
 {
 	VK2D_ASSERT_MAIN_THREAD( this );
 
+	// Constant 0 is the texture array size, shaders that don't use it ignore it.
+	uint32_t texture_array_size		= GetGraphicsTextureArraySize();
+
+	VkSpecializationMapEntry fragment_specialization_map_entry {};
+	fragment_specialization_map_entry.constantID		= 0;
+	fragment_specialization_map_entry.offset			= 0;
+	fragment_specialization_map_entry.size				= sizeof( texture_array_size );
+
+	VkSpecializationInfo fragment_specialization_info {};
+	fragment_specialization_info.mapEntryCount			= 1;
+	fragment_specialization_info.pMapEntries			= &fragment_specialization_map_entry;
+	fragment_specialization_info.dataSize				= sizeof( texture_array_size );
+	fragment_specialization_info.pData					= &texture_array_size;
+
 	std::array<VkPipelineShaderStageCreateInfo, 2> shader_stage_create_infos {};
 	shader_stage_create_infos[ 0 ].sType				= VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 	shader_stage_create_infos[ 0 ].pNext				= nullptr;
@@ -1190,7 +1246,7 @@ VkPipeline vk2d::_internal::InstanceImpl::CreateGraphicsPipeline(
 	shader_stage_create_infos[ 1 ].stage				= VK_SHADER_STAGE_FRAGMENT_BIT;
 	shader_stage_create_infos[ 1 ].module				= settings.shader_programs.fragment;
 	shader_stage_create_infos[ 1 ].pName				= "main";
-	shader_stage_create_infos[ 1 ].pSpecializationInfo	= nullptr;
+	shader_stage_create_infos[ 1 ].pSpecializationInfo	= &fragment_specialization_info;
 
 	// Make sure this matches Vertex in RenderPrimitives.h
 	std::array<VkVertexInputBindingDescription, 0> vertex_input_binding_descriptions {};
@@ -1469,6 +1525,19 @@ const vk2d::_internal::DescriptorSetLayout & vk2d::_internal::InstanceImpl::GetG
 	return *graphics_texture_descriptor_set_layout;
 }
 
+bool vk2d::_internal::InstanceImpl::IsBindlessTexturesEnabled() const
+{
+	return bindless_textures_enabled;
+}
+
+uint32_t vk2d::_internal::InstanceImpl::GetGraphicsTextureArraySize() const
+{
+	if( bindless_textures_enabled ) {
+		return bindless_texture_capacity;
+	}
+	return 1;
+}
+
 const vk2d::_internal::DescriptorSetLayout & vk2d::_internal::InstanceImpl::GetGraphicsRenderTargetBlurTextureDescriptorSetLayout() const
 {
 	return *graphics_render_target_blur_texture_descriptor_set_layout;
@@ -1504,6 +1573,14 @@ vk2d::_internal::DeviceMemoryPool * vk2d::_internal::InstanceImpl::GetDeviceMemo
 	return device_memory_pool.get();
 }
 
+vk2d::_internal::BufferSubAllocator * vk2d::_internal::InstanceImpl::GetBufferSubAllocator(
+	vk2d::_internal::BufferUsageClass		usage_class
+) const
+{
+	assert( usage_class < vk2d::_internal::BufferUsageClass::COUNT );
+	return buffer_sub_allocators[ size_t( usage_class ) ].get();
+}
+
 std::thread::id vk2d::_internal::InstanceImpl::GetCreatorThreadID() const
 {
 	return creator_thread_id;
@@ -1514,6 +1591,31 @@ bool vk2d::_internal::InstanceImpl::IsThisThreadCreatorThread() const
 	return creator_thread_id == std::this_thread::get_id();
 }
 
+bool vk2d::_internal::InstanceImpl::IsRendering() const
+{
+	VK2D_ASSERT_MAIN_THREAD( this );
+
+	for( auto & w : windows ) {
+		if( w->impl->IsRendering() ) return true;
+	}
+	for( auto & r : render_target_textures ) {
+		if( r->impl->IsRendering() ) return true;
+	}
+	return false;
+}
+
+void vk2d::_internal::InstanceImpl::ProcessRenderTargetTextureReadbacks()
+{
+	VK2D_ASSERT_MAIN_THREAD( this );
+
+	// Render targets being recorded process their readbacks in BeginRender().
+	for( auto & r : render_target_textures ) {
+		if( !r->impl->IsRendering() ) {
+			r->impl->ProcessReadbacks();
+		}
+	}
+}
+
 void vk2d::_internal::InstanceImpl::VkFun_vkCmdPushDescriptorSetKHR(
 	VkCommandBuffer					commandBuffer,
 	VkPipelineBindPoint				pipelineBindPoint,
@@ -1834,6 +1936,7 @@ bool vk2d::_internal::InstanceImpl::CreateDeviceAndQueues()
 	features.fillModeNonSolid						= VK_TRUE;
 	features.wideLines								= VK_TRUE;
 	features.geometryShader							= VK_TRUE;
+	features.textureCompressionBC					= vk_physical_device_features.textureCompressionBC;	// KTX2 and DDS textures are decoded on the CPU without this.
 //	features.shaderStorageImageWriteWithoutFormat	= VK_TRUE;
 //	features.fragmentStoresAndAtomics				= VK_TRUE;
 
@@ -1843,6 +1946,64 @@ bool vk2d::_internal::InstanceImpl::CreateDeviceAndQueues()
 	features_1_2.samplerMirrorClampToEdge			= VK_TRUE;
 	features_1_2.timelineSemaphore					= VK_TRUE;
 
+#if VK2D_BUILD_OPTION_BINDLESS_TEXTURES
+	// Bindless textures need descriptor indexing, if not supported
+	// we fall back to binding a descriptor set per texture.
+	{
+		VkPhysicalDeviceVulkan12Features supported_features_1_2 {};
+		supported_features_1_2.sType				= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		supported_features_1_2.pNext				= nullptr;
+
+		VkPhysicalDeviceFeatures2 supported_features {};
+		supported_features.sType					= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		supported_features.pNext					= &supported_features_1_2;
+
+		vkGetPhysicalDeviceFeatures2(
+			vk_physical_device,
+			&supported_features
+		);
+
+		VkPhysicalDeviceVulkan12Properties properties_1_2 {};
+		properties_1_2.sType						= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+		properties_1_2.pNext						= nullptr;
+
+		VkPhysicalDeviceProperties2 properties {};
+		properties.sType							= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		properties.pNext							= &properties_1_2;
+
+		vkGetPhysicalDeviceProperties2(
+			vk_physical_device,
+			&properties
+		);
+
+		bindless_texture_capacity					= std::min( {
+			uint32_t( VK2D_BUILD_OPTION_BINDLESS_TEXTURE_CAPACITY ),
+			properties_1_2.maxPerStageDescriptorUpdateAfterBindSampledImages,
+			properties_1_2.maxDescriptorSetUpdateAfterBindSampledImages
+		} );
+
+		// Texture array index comes from push constants.
+		bindless_textures_enabled =
+			vk_physical_device_features.shaderSampledImageArrayDynamicIndexing &&
+			supported_features_1_2.descriptorBindingSampledImageUpdateAfterBind &&
+			supported_features_1_2.descriptorBindingPartiallyBound &&
+			supported_features_1_2.descriptorBindingUpdateUnusedWhilePending &&
+			supported_features_1_2.descriptorBindingVariableDescriptorCount &&
+			bindless_texture_capacity > 0;
+
+		if( bindless_textures_enabled ) {
+			features.shaderSampledImageArrayDynamicIndexing				= VK_TRUE;
+			features_1_2.descriptorBindingSampledImageUpdateAfterBind	= VK_TRUE;
+			features_1_2.descriptorBindingPartiallyBound				= VK_TRUE;
+			features_1_2.descriptorBindingUpdateUnusedWhilePending		= VK_TRUE;
+			features_1_2.descriptorBindingVariableDescriptorCount		= VK_TRUE;
+		} else {
+			bindless_texture_capacity				= 0;
+			Report( vk2d::ReportSeverity::INFO, "Bindless textures not supported by the device, using a descriptor set per texture." );
+		}
+	}
+#endif
+
 	VkDeviceCreateInfo device_create_info {};
 	device_create_info.sType						= VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 	device_create_info.pNext						= &features_1_2;
@@ -2276,7 +2437,7 @@ bool vk2d::_internal::InstanceImpl::CreateDescriptorSetLayouts()
 
 	// Graphics: Descriptor set layout for texture.
 	// Binding 0 = Sampled image
-	{
+	if( !bindless_textures_enabled ) {
 		graphics_texture_descriptor_set_layout = CreateLocalDescriptorSetLayout(
 			{
 				{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_SHADER_STAGE_FRAGMENT_BIT }
@@ -2287,6 +2448,47 @@ bool vk2d::_internal::InstanceImpl::CreateDescriptorSetLayouts()
 		}
 	}
 
+	// Graphics: Descriptor set layout for bindless textures, replaces the texture layout.
+	// Binding 0 = Sampled image array, only slots in use are written. Count is
+	// variable so descriptor sets of textures that didn't fit the table can hold just one.
+	if( bindless_textures_enabled ) {
+		VkDescriptorSetLayoutBinding set_binding {};
+		set_binding.binding				= 0;
+		set_binding.descriptorType		= VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		set_binding.descriptorCount		= bindless_texture_capacity;
+		set_binding.stageFlags			= VK_SHADER_STAGE_FRAGMENT_BIT;
+		set_binding.pImmutableSamplers	= nullptr;
+
+		VkDescriptorBindingFlags binding_flags =
+			VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+			VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+			VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+			VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_create_info {};
+		binding_flags_create_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		binding_flags_create_info.pNext			= nullptr;
+		binding_flags_create_info.bindingCount	= 1;
+		binding_flags_create_info.pBindingFlags	= &binding_flags;
+
+		VkDescriptorSetLayoutCreateInfo descriptor_set_layout_create_info {};
+		descriptor_set_layout_create_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptor_set_layout_create_info.pNext			= &binding_flags_create_info;
+		descriptor_set_layout_create_info.flags			= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		descriptor_set_layout_create_info.bindingCount	= 1;
+		descriptor_set_layout_create_info.pBindings		= &set_binding;
+
+		graphics_texture_descriptor_set_layout = vk2d::_internal::CreateDescriptorSetLayout(
+			this,
+			vk_device,
+			&descriptor_set_layout_create_info
+		);
+		if( !graphics_texture_descriptor_set_layout ) {
+			Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error: Cannot create bindless texture descriptor set layout!" );
+			return false;
+		}
+	}
+
 	// Graphics: Descriptor set layout for texture meant for render target texture blur shader.
 	// Binding 0 = Sampled image
 	{
@@ -2427,6 +2629,17 @@ bool vk2d::_internal::InstanceImpl::CreateDeviceMemoryPool()
 		Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error: Cannot create memory pool!" );
 		return false;
 	}
+
+	for( size_t i = 0; i < buffer_sub_allocators.size(); ++i ) {
+		buffer_sub_allocators[ i ]	= vk2d::_internal::CreateBufferSubAllocator(
+			device_memory_pool.get(),
+			vk2d::_internal::BufferUsageClass( i )
+		);
+		if( !buffer_sub_allocators[ i ] ) {
+			Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error: Cannot create buffer sub allocator!" );
+			return false;
+		}
+	}
 	return true;
 }
 
@@ -2540,6 +2753,7 @@ void vk2d::_internal::InstanceImpl::DestroyDevice()
 
 void vk2d::_internal::InstanceImpl::DestroyDescriptorPool()
 {
+	thread_descriptor_pools.clear();
 	descriptor_pool			= nullptr;
 }
 
@@ -2644,6 +2858,9 @@ void vk2d::_internal::InstanceImpl::DestroyPipelineLayouts()
 
 void vk2d::_internal::InstanceImpl::DestroyDeviceMemoryPool()
 {
+	for( auto & a : buffer_sub_allocators ) {
+		a					= {};
+	}
 	device_memory_pool		= {};
 }
 
@@ -8,6 +8,7 @@
 
 #include "System/QueueResolver.h"
 #include "System/DescriptorSet.h"
+#include "System/BufferSubAllocator.h"
 #include "System/ShaderInterface.h"
 
 #define GLFW_INCLUDE_NONE
@@ -30,6 +31,7 @@ namespace _internal {
 class ThreadPool;
 class DescriptorSetLayout;
 class WindowImpl;
+class ResourceManagerImpl;
 class DeviceMemoryPool;
 class MonitorImpl;
 
@@ -149,7 +151,8 @@ public:
 	/// 			Allocate descriptor set directly from instance.
 	/// 			Prefer to use per thread descriptor auto pool if possible.
 	///				Instance field DescriptorAutoPool is not directly exposed as
-	///				DescriptorAutoPool is single thread only.
+	///				DescriptorAutoPool is single thread only. Every thread
+	///				allocates from its own DescriptorAutoPool without locking.
 	///	@note		Multithreading: Any thread.
 	/// @param[in]	for_descriptor_set_layout
 	///				tells what type of a descriptor set we should allocate.
@@ -160,7 +163,9 @@ public:
 	///				Free descriptor set that was directly allocated from instance.
 	///				Prefer to use per thread descriptor auto pool if possible.
 	///				Instance field DescriptorAutoPool is not directly exposed as
-	///				DescriptorAutoPool is single thread only.
+	///				DescriptorAutoPool is single thread only. If the descriptor set
+	///				was allocated in another thread, it's handed back to that
+	///				thread's DescriptorAutoPool with a deferred free.
 	/// @note		Multithreading: Any thread.
 	/// @param[in]	descriptor_set
 	///				DescriptorSet that was previously allocated from the same instance.
@@ -222,6 +227,9 @@ public:
 	// Any thread.
 	vk2d::ResourceManager								*	GetResourceManager() const;
 
+	// Any thread.
+	vk2d::_internal::ResourceManagerImpl				*	GetResourceManagerImpl() const;
+
 	// Any thread.
 	VkInstance												GetVulkanInstance() const;
 
@@ -307,7 +315,16 @@ public:
 	const vk2d::_internal::DescriptorSetLayout			&	GetGraphicsSamplerDescriptorSetLayout() const;
 
 	// Any thread.
+	// In bindless mode this is the layout of the bindless texture array.
 	const vk2d::_internal::DescriptorSetLayout			&	GetGraphicsTextureDescriptorSetLayout() const;
+
+	// Any thread.
+	// Tells if render targets keep their textures in a bindless texture array.
+	bool													IsBindlessTexturesEnabled() const;
+
+	// Any thread.
+	// Size of the texture array in shaders, 1 if bindless textures are not enabled.
+	uint32_t												GetGraphicsTextureArraySize() const;
 	
 	// Any thread.
 	const vk2d::_internal::DescriptorSetLayout			&	GetGraphicsRenderTargetBlurTextureDescriptorSetLayout() const;
@@ -331,6 +348,10 @@ public:
 	// Any thread.
 	vk2d::_internal::DeviceMemoryPool					*	GetDeviceMemoryPool() const;
 
+	// Main thread only, same as the device memory pool these allocate from.
+	vk2d::_internal::BufferSubAllocator					*	GetBufferSubAllocator(
+		vk2d::_internal::BufferUsageClass					usage_class ) const;
+
 
 	// Any thread.
 	std::thread::id											GetCreatorThreadID() const;
@@ -340,6 +361,15 @@ public:
 	// Any thread.
 	bool													IsThisThreadCreatorThread() const;
 
+	// Returns true if any window or render target texture is
+	// between BeginRender() and EndRender().
+	// Main thread only.
+	bool													IsRendering() const;
+
+	// Hands finished render target texture readbacks to their callbacks.
+	// Main thread only.
+	void													ProcessRenderTargetTextureReadbacks();
+
 	void													VkFun_vkCmdPushDescriptorSetKHR(
 		VkCommandBuffer										commandBuffer,
 		VkPipelineBindPoint									pipelineBindPoint,
@@ -416,6 +446,9 @@ private:
 	VkPhysicalDeviceMemoryProperties						vk_physical_device_memory_properties	= {};
 	VkPhysicalDeviceFeatures								vk_physical_device_features				= {};
 
+	bool													bindless_textures_enabled				= {};
+	uint32_t												bindless_texture_capacity				= {};
+
 	std::vector<VkShaderModule>								vk_graphics_shader_modules;
 	std::vector<VkShaderModule>								vk_compute_shader_modules;
 
@@ -448,9 +481,13 @@ private:
 	vk2d::_internal::ResolvedQueue							primary_transfer_queue						= {};
 
 	std::unique_ptr<vk2d::_internal::DeviceMemoryPool>		device_memory_pool;
+	std::array<std::unique_ptr<vk2d::_internal::BufferSubAllocator>, size_t( vk2d::_internal::BufferUsageClass::COUNT )>
+															buffer_sub_allocators;
 
-	std::mutex												descriptor_pool_mutex;
-	std::unique_ptr<vk2d::_internal::DescriptorAutoPool>	descriptor_pool;
+	std::unique_ptr<vk2d::_internal::DescriptorAutoPool>	descriptor_pool;						// Creator thread only.
+	std::mutex												descriptor_pool_mutex;					// Guards thread_descriptor_pools.
+	std::map<std::thread::id, std::unique_ptr<vk2d::_internal::DescriptorAutoPool>>
+															thread_descriptor_pools;
 
 	std::unique_ptr<vk2d::Sampler>							default_sampler;
 	vk2d::TextureResource								*	default_texture								= {};
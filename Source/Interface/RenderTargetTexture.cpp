@@ -314,6 +314,18 @@ VK2D_API void VK2D_APIENTRY vk2d::RenderTargetTexture::DrawMesh(
 	);
 }
 
+VK2D_API bool VK2D_APIENTRY vk2d::RenderTargetTexture::RequestReadback(
+	std::function<void( const vk2d::ImageData & image_data, bool success )>		callback
+)
+{
+	return impl->RequestReadback( std::move( callback ) );
+}
+
+VK2D_API vk2d::DescriptorCacheStatistics VK2D_APIENTRY vk2d::RenderTargetTexture::GetDescriptorCacheStatistics() const
+{
+	return impl->GetDescriptorCacheStatistics();
+}
+
 VK2D_API bool VK2D_APIENTRY vk2d::RenderTargetTexture::IsGood() const
 {
 	return !!impl;
@@ -391,6 +403,17 @@ vk2d::_internal::RenderTargetTextureImpl::~RenderTargetTextureImpl()
 
 	WaitIdle();
 
+	// Everything submitted has finished by now, readbacks left over were never rendered.
+	ProcessReadbacks();
+	for( auto & r : readback_slots ) {
+		if( r.state != vk2d::_internal::RenderTargetTextureImpl::ReadbackState::IDLE ) {
+			FinishReadback( r, false );
+		}
+		if( r.staging_buffer.buffer ) {
+			instance->GetDeviceMemoryPool()->FreeCompleteResource( r.staging_buffer );
+		}
+	}
+
 	DestroySynchronizationPrimitives();
 	DestroyFramebuffers();
 	DestroyImages();
@@ -547,10 +570,25 @@ bool vk2d::_internal::RenderTargetTextureImpl::BeginRender()
 			return false;
 		}
 
+		// Copies recorded into a render of this swap buffer that was never
+		// submitted are recorded again into this render.
+		for( auto & r : readback_slots ) {
+			if( r.state == vk2d::_internal::RenderTargetTextureImpl::ReadbackState::RECORDED &&
+				r.swap_buffer_index == current_swap_buffer ) {
+				r.state = vk2d::_internal::RenderTargetTextureImpl::ReadbackState::REQUESTED;
+			}
+		}
+		ProcessReadbacks();
+
 		// We no longer contain sampled image that's ready to be used without synchronization.
 		swap.contains_non_pending_sampled_image = false;
 
 		ResetRenderTargetTextureRenderDependencies( current_swap_buffer );
+
+		frame_allocator->SetCurrentFrame( current_swap_buffer );
+		sampler_descriptor_set_cache->SetCurrentFrame( current_swap_buffer );
+		texture_descriptor_set_cache->SetCurrentFrame( current_swap_buffer );
+		if( bindless_texture_table ) bindless_texture_table->SetCurrentFrame( current_swap_buffer );
 	}
 
 	// Begin command buffer
@@ -615,6 +653,15 @@ bool vk2d::_internal::RenderTargetTextureImpl::BeginRender()
 				1, &frame_data_descriptor_set.descriptorSet,
 				0, nullptr
 			);
+
+			// Bindless textures, bound once for the whole frame.
+			if( bindless_texture_table ) {
+				bindless_texture_table->CmdBind(
+					command_buffer,
+					instance->GetGraphicsPrimaryRenderPipelineLayout(),
+					GRAPHICS_DESCRIPTOR_SET_ALLOCATION_TEXTURE
+				);
+			}
 		}
 
 		// Begin render pass
@@ -652,6 +699,7 @@ bool vk2d::_internal::RenderTargetTextureImpl::BeginRender()
 		}
 	}
 
+	is_rendering = true;
 	return true;
 }
 
@@ -662,6 +710,8 @@ bool vk2d::_internal::RenderTargetTextureImpl::EndRender(
 {
 	VK2D_ASSERT_MAIN_THREAD( instance );
 
+	is_rendering = false;
+
 	auto & swap									= swap_buffers[ current_swap_buffer ];
 	VkCommandBuffer		render_command_buffer	= swap.vk_render_command_buffer;
 	VkCommandBuffer		transfer_command_buffer	= swap.vk_transfer_command_buffer;
@@ -677,6 +727,7 @@ bool vk2d::_internal::RenderTargetTextureImpl::EndRender(
 		vkCmdEndRenderPass( render_command_buffer );
 	}
 	CmdFinalizeRender( swap, blur_type, blur_amount );
+	CmdRecordReadbacks( swap );
 
 	// End command buffer
 	vk2d::_internal::CmdInsertCommandBufferCheckpoint(
@@ -704,6 +755,11 @@ bool vk2d::_internal::RenderTargetTextureImpl::EndRender(
 	return true;
 }
 
+bool vk2d::_internal::RenderTargetTextureImpl::IsRendering() const
+{
+	return is_rendering;
+}
+
 bool vk2d::_internal::RenderTargetTextureImpl::SynchronizeFrame()
 {
 	VK2D_ASSERT_MAIN_THREAD( instance );
@@ -736,6 +792,13 @@ bool vk2d::_internal::RenderTargetTextureImpl::SynchronizeFrame()
 
 		swap.has_been_submitted = false;
 	}
+
+	// GPU is done with this swap buffer, transient allocations can be reused.
+	frame_allocator->ResetFrame( current_swap_buffer );
+	sampler_descriptor_set_cache->ResetFrame( current_swap_buffer );
+	texture_descriptor_set_cache->ResetFrame( current_swap_buffer );
+	if( bindless_texture_table ) bindless_texture_table->ResetFrame( current_swap_buffer );
+
 	return true;
 }
 
@@ -854,6 +917,13 @@ void vk2d::_internal::RenderTargetTextureImpl::ConfirmRenderTargetTextureRenderS
 	auto & swap = swap_buffers[ dependency_info.swap_buffer_index ];
 	swap.has_been_submitted = true;
 
+	for( auto & r : readback_slots ) {
+		if( r.state == vk2d::_internal::RenderTargetTextureImpl::ReadbackState::RECORDED &&
+			r.swap_buffer_index == dependency_info.swap_buffer_index ) {
+			r.state = vk2d::_internal::RenderTargetTextureImpl::ReadbackState::SUBMITTED;
+		}
+	}
+
 	for( auto & d : swap.render_target_texture_dependencies ) {
 		d.render_target->ConfirmRenderTargetTextureRenderSubmission( d );
 	}
@@ -1048,7 +1118,7 @@ void vk2d::_internal::RenderTargetTextureImpl::DrawTriangleList(
 		sampler,
 		instance->GetGraphicsPrimaryRenderPipelineLayout()
 	);
-	CmdBindTextureIfDifferent(
+	auto texture_index = CmdBindTextureIfDifferent(
 		command_buffer,
 		texture,
 		instance->GetGraphicsPrimaryRenderPipelineLayout()
@@ -1074,6 +1144,7 @@ void vk2d::_internal::RenderTargetTextureImpl::DrawTriangleList(
 			pc.vertex_offset			= push_result.location_info.vertex_offset;
 			pc.texture_channel_weight_offset	= push_result.location_info.texture_channel_weight_offset;
 			pc.texture_channel_weight_count	= texture->GetLayerCount();
+			pc.texture_index			= texture_index;
 
 			vkCmdPushConstants(
 				command_buffer,
@@ -1215,7 +1286,7 @@ void vk2d::_internal::RenderTargetTextureImpl::DrawLineList(
 		sampler,
 		instance->GetGraphicsPrimaryRenderPipelineLayout()
 	);
-	CmdBindTextureIfDifferent(
+	auto texture_index = CmdBindTextureIfDifferent(
 		command_buffer,
 		texture,
 		instance->GetGraphicsPrimaryRenderPipelineLayout()
@@ -1238,6 +1309,7 @@ void vk2d::_internal::RenderTargetTextureImpl::DrawLineList(
 			pc.vertex_offset			= push_result.location_info.vertex_offset;
 			pc.texture_channel_weight_offset	= push_result.location_info.texture_channel_weight_offset;
 			pc.texture_channel_weight_count	= texture->GetLayerCount();
+			pc.texture_index			= texture_index;
 
 			vkCmdPushConstants(
 				command_buffer,
@@ -1326,7 +1398,7 @@ void vk2d::_internal::RenderTargetTextureImpl::DrawPointList(
 		sampler,
 		instance->GetGraphicsPrimaryRenderPipelineLayout()
 	);
-	CmdBindTextureIfDifferent(
+	auto texture_index = CmdBindTextureIfDifferent(
 		command_buffer,
 		texture,
 		instance->GetGraphicsPrimaryRenderPipelineLayout()
@@ -1349,6 +1421,7 @@ void vk2d::_internal::RenderTargetTextureImpl::DrawPointList(
 			pc.vertex_offset			= push_result.location_info.vertex_offset;
 			pc.texture_channel_weight_offset	= push_result.location_info.texture_channel_weight_offset;
 			pc.texture_channel_weight_count	= texture->GetLayerCount();
+			pc.texture_index			= texture_index;
 
 			vkCmdPushConstants(
 				command_buffer,
@@ -1433,6 +1506,37 @@ void vk2d::_internal::RenderTargetTextureImpl::DrawMesh(
 	}
 }
 
+bool vk2d::_internal::RenderTargetTextureImpl::RequestReadback(
+	std::function<void( const vk2d::ImageData &, bool )>		callback
+)
+{
+	VK2D_ASSERT_MAIN_THREAD( instance );
+
+	if( !callback ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot request RenderTargetTexture readback, callback is empty!" );
+		return false;
+	}
+
+	// Slots are used in request order so callbacks are called in request order.
+	auto & slot = readback_slots[ next_readback_slot ];
+	if( slot.state != vk2d::_internal::RenderTargetTextureImpl::ReadbackState::IDLE ) {
+		return false;
+	}
+	next_readback_slot = ( next_readback_slot + 1 ) % uint32_t( std::size( readback_slots ) );
+
+	slot.callback		= std::move( callback );
+	slot.state			= vk2d::_internal::RenderTargetTextureImpl::ReadbackState::REQUESTED;
+	return true;
+}
+
+vk2d::DescriptorCacheStatistics vk2d::_internal::RenderTargetTextureImpl::GetDescriptorCacheStatistics() const
+{
+	return vk2d::_internal::CombineDescriptorCacheStatistics(
+		sampler_descriptor_set_cache.get(),
+		texture_descriptor_set_cache.get()
+	);
+}
+
 bool vk2d::_internal::RenderTargetTextureImpl::IsGood() const
 {
 	return is_good;
@@ -1544,38 +1648,39 @@ void vk2d::_internal::RenderTargetTextureImpl::DestroyCommandBuffers()
 
 bool vk2d::_internal::RenderTargetTextureImpl::CreateFrameDataBuffers()
 {
-	// Create staging and device buffers
+	// Create frame allocator and device buffer, FrameData staging is allocated per frame.
 	{
-		VkBufferCreateInfo staging_buffer_create_info {};
-		staging_buffer_create_info.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		staging_buffer_create_info.pNext					= nullptr;
-		staging_buffer_create_info.flags					= 0;
-		staging_buffer_create_info.size						= sizeof( vk2d::_internal::FrameData );
-		staging_buffer_create_info.usage					= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-		staging_buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
-		staging_buffer_create_info.queueFamilyIndexCount	= 0;
-		staging_buffer_create_info.pQueueFamilyIndices		= nullptr;
-		frame_data_staging_buffer = instance->GetDeviceMemoryPool()->CreateCompleteBufferResource(
-			&staging_buffer_create_info,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+		frame_allocator = std::make_unique<vk2d::_internal::FrameLinearAllocator>(
+			instance->GetDeviceMemoryPool(),
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT
 		);
-		if( frame_data_staging_buffer != VK_SUCCESS ) {
-			instance->Report( frame_data_staging_buffer.result, "Internal error. Cannot create staging buffer for FrameData!" );
+		if( !frame_allocator || !frame_allocator->IsGood() ) {
+			instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error. Cannot create frame allocator!" );
 			return false;
 		}
 
-		VkBufferCreateInfo device_buffer_create_info {};
-		device_buffer_create_info.sType						= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		device_buffer_create_info.pNext						= nullptr;
-		device_buffer_create_info.flags						= 0;
-		device_buffer_create_info.size						= sizeof( vk2d::_internal::FrameData );
-		device_buffer_create_info.usage						= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-		device_buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
-		device_buffer_create_info.queueFamilyIndexCount		= 0;
-		device_buffer_create_info.pQueueFamilyIndices		= nullptr;
-		frame_data_device_buffer = instance->GetDeviceMemoryPool()->CreateCompleteBufferResource(
-			&device_buffer_create_info,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+		sampler_descriptor_set_cache = std::make_unique<vk2d::_internal::DescriptorSetCache>(
+			instance,
+			instance->GetGraphicsSamplerDescriptorSetLayout()
+		);
+		texture_descriptor_set_cache = std::make_unique<vk2d::_internal::DescriptorSetCache>(
+			instance,
+			instance->GetGraphicsTextureDescriptorSetLayout()
+		);
+
+		if( instance->IsBindlessTexturesEnabled() ) {
+			bindless_texture_table = std::make_unique<vk2d::_internal::BindlessTextureTable>(
+				instance,
+				instance->GetGraphicsTextureArraySize()
+			);
+			if( !bindless_texture_table || !bindless_texture_table->IsGood() ) {
+				instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error. Cannot create bindless texture table!" );
+				return false;
+			}
+		}
+
+		frame_data_device_buffer = instance->GetBufferSubAllocator( vk2d::_internal::BufferUsageClass::DEVICE_UNIFORM )->Allocate(
+			sizeof( vk2d::_internal::FrameData )
 		);
 		if( frame_data_device_buffer != VK_SUCCESS ) {
 			instance->Report( frame_data_device_buffer.result, "Internal error. Cannot create device local buffer for FrameData!" );
@@ -1594,7 +1699,7 @@ bool vk2d::_internal::RenderTargetTextureImpl::CreateFrameDataBuffers()
 		}
 		VkDescriptorBufferInfo descriptor_write_buffer_info {};
 		descriptor_write_buffer_info.buffer	= frame_data_device_buffer.buffer;
-		descriptor_write_buffer_info.offset	= 0;
+		descriptor_write_buffer_info.offset	= frame_data_device_buffer.offset;
 		descriptor_write_buffer_info.range	= sizeof( vk2d::_internal::FrameData );
 		VkWriteDescriptorSet descriptor_write {};
 		descriptor_write.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -1619,15 +1724,17 @@ bool vk2d::_internal::RenderTargetTextureImpl::CreateFrameDataBuffers()
 
 void vk2d::_internal::RenderTargetTextureImpl::DestroyFrameDataBuffers()
 {
+	sampler_descriptor_set_cache	= nullptr;
+	texture_descriptor_set_cache	= nullptr;
+	bindless_texture_table			= nullptr;
+
 	instance->FreeDescriptorSet(
 		frame_data_descriptor_set
 	);
-	instance->GetDeviceMemoryPool()->FreeCompleteResource(
+	instance->GetBufferSubAllocator( vk2d::_internal::BufferUsageClass::DEVICE_UNIFORM )->Free(
 		frame_data_device_buffer
 	);
-	instance->GetDeviceMemoryPool()->FreeCompleteResource(
-		frame_data_staging_buffer
-	);
+	frame_allocator	= nullptr;
 }
 
 
@@ -2435,22 +2542,19 @@ bool vk2d::_internal::RenderTargetTextureImpl::UpdateSubmitInfos(
 	return true;
 }
 
-vk2d::_internal::TimedDescriptorPoolData & vk2d::_internal::RenderTargetTextureImpl::GetOrCreateDescriptorSetForSampler(
+VkDescriptorSet vk2d::_internal::RenderTargetTextureImpl::GetOrCreateDescriptorSetForSampler(
 	vk2d::Sampler	*	sampler
 )
 {
-	auto & set = sampler_descriptor_sets[ sampler ];
-
-	// If this descriptor set doesn't exist yet for this
-	// sampler texture combo, create one and update it.
-	if( set.descriptor_set.descriptorSet == VK_NULL_HANDLE ) {
-		set.descriptor_set = instance->AllocateDescriptorSet(
-			instance->GetGraphicsSamplerDescriptorSetLayout()
-		);
-		if( set.descriptor_set != VK_SUCCESS ) {
-			return set;
-		}
+	bool needs_write = false;
+	auto descriptor_set = sampler_descriptor_set_cache->Acquire(
+		sampler->impl->GetResourceID(),
+		0,
+		needs_write
+	);
 
+	// If this descriptor set didn't exist yet for this sampler, update it.
+	if( needs_write ) {
 		VkDescriptorImageInfo image_info {};
 		image_info.sampler						= sampler->impl->GetVulkanSampler();
 		image_info.imageView					= VK_NULL_HANDLE;
@@ -2464,7 +2568,7 @@ vk2d::_internal::TimedDescriptorPoolData & vk2d::_internal::RenderTargetTextureI
 		std::array<VkWriteDescriptorSet, 2> descriptor_write {};
 		descriptor_write[ 0 ].sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 		descriptor_write[ 0 ].pNext				= nullptr;
-		descriptor_write[ 0 ].dstSet			= set.descriptor_set.descriptorSet;
+		descriptor_write[ 0 ].dstSet			= descriptor_set;
 		descriptor_write[ 0 ].dstBinding		= 0;
 		descriptor_write[ 0 ].dstArrayElement	= 0;
 		descriptor_write[ 0 ].descriptorCount	= 1;
@@ -2475,7 +2579,7 @@ vk2d::_internal::TimedDescriptorPoolData & vk2d::_internal::RenderTargetTextureI
 
 		descriptor_write[ 1 ].sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 		descriptor_write[ 1 ].pNext				= nullptr;
-		descriptor_write[ 1 ].dstSet			= set.descriptor_set.descriptorSet;
+		descriptor_write[ 1 ].dstSet			= descriptor_set;
 		descriptor_write[ 1 ].dstBinding		= 1;
 		descriptor_write[ 1 ].dstArrayElement	= 0;
 		descriptor_write[ 1 ].descriptorCount	= 1;
@@ -2491,27 +2595,27 @@ vk2d::_internal::TimedDescriptorPoolData & vk2d::_internal::RenderTargetTextureI
 		);
 	}
 
-	return set;
+	return descriptor_set;
 }
 
-vk2d::_internal::TimedDescriptorPoolData & vk2d::_internal::RenderTargetTextureImpl::GetOrCreateDescriptorSetForTexture(
+VkDescriptorSet vk2d::_internal::RenderTargetTextureImpl::GetOrCreateDescriptorSetForTexture(
 	vk2d::Texture	*	texture
 )
 {
 	assert( texture );
 
-	auto & set = texture_descriptor_sets[ texture ];
-
-	// If this descriptor set doesn't exist yet for this
-	// sampler texture combo, create one and update it.
-	if( set.descriptor_set.descriptorSet == VK_NULL_HANDLE ) {
-		set.descriptor_set = instance->AllocateDescriptorSet(
-			instance->GetGraphicsTextureDescriptorSetLayout()
-		);
-		if( set.descriptor_set != VK_SUCCESS ) {
-			return set;
-		}
+	// Generation is read before the image view, if the texture image gets
+	// replaced in between we'll just write the descriptor set again next time.
+	// Cache replaces the descriptor set if the generation changed.
+	bool needs_write = false;
+	auto descriptor_set = texture_descriptor_set_cache->Acquire(
+		texture->texture_impl->GetResourceID(),
+		texture->texture_impl->GetGeneration(),
+		needs_write
+	);
 
+	// If this descriptor set didn't exist yet for this texture, update it.
+	if( needs_write ) {
 		VkDescriptorImageInfo image_info {};
 		image_info.sampler						= VK_NULL_HANDLE;
 		image_info.imageView					= texture->texture_impl->GetVulkanImageView();
@@ -2520,7 +2624,7 @@ vk2d::_internal::TimedDescriptorPoolData & vk2d::_internal::RenderTargetTextureI
 		std::array<VkWriteDescriptorSet, 1> descriptor_write {};
 		descriptor_write[ 0 ].sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 		descriptor_write[ 0 ].pNext				= nullptr;
-		descriptor_write[ 0 ].dstSet			= set.descriptor_set.descriptorSet;
+		descriptor_write[ 0 ].dstSet			= descriptor_set;
 		descriptor_write[ 0 ].dstBinding		= 0;
 		descriptor_write[ 0 ].dstArrayElement	= 0;
 		descriptor_write[ 0 ].descriptorCount	= 1;
@@ -2536,7 +2640,7 @@ vk2d::_internal::TimedDescriptorPoolData & vk2d::_internal::RenderTargetTextureI
 		);
 	}
 
-	return set;
+	return descriptor_set;
 }
 
 void vk2d::_internal::RenderTargetTextureImpl::CmdPushBlurTextureDescriptorWritesDirectly(
@@ -3340,15 +3444,18 @@ void vk2d::_internal::RenderTargetTextureImpl::CmdBindSamplerIfDifferent(
 
 	// if sampler or texture changed since previous call, bind a different descriptor set.
 	if( sampler != previous_sampler ) {
-		auto & set = GetOrCreateDescriptorSetForSampler( sampler );
-		set.previous_access_time = std::chrono::steady_clock::now();
+		auto descriptor_set = GetOrCreateDescriptorSetForSampler( sampler );
+		if( descriptor_set == VK_NULL_HANDLE ) {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot allocate descriptor set for sampler!" );
+			return;
+		}
 
 		vkCmdBindDescriptorSets(
 			command_buffer,
 			VK_PIPELINE_BIND_POINT_GRAPHICS,
 			use_pipeline_layout,
 			GRAPHICS_DESCRIPTOR_SET_ALLOCATION_SAMPLER_AND_SAMPLER_DATA,
-			1, &set.descriptor_set.descriptorSet,
+			1, &descriptor_set,
 			0, nullptr
 		);
 
@@ -3356,7 +3463,7 @@ void vk2d::_internal::RenderTargetTextureImpl::CmdBindSamplerIfDifferent(
 	}
 }
 
-void vk2d::_internal::RenderTargetTextureImpl::CmdBindTextureIfDifferent(
+uint32_t vk2d::_internal::RenderTargetTextureImpl::CmdBindTextureIfDifferent(
 	VkCommandBuffer			command_buffer,
 	vk2d::Texture		*	texture,
 	VkPipelineLayout		use_pipeline_layout
@@ -3364,22 +3471,67 @@ void vk2d::_internal::RenderTargetTextureImpl::CmdBindTextureIfDifferent(
 {
 	assert( texture );
 
+	texture->texture_impl->MarkUsed();
+
+	// Bindless table is bound once per frame, only the index changes.
+	// In bindless mode previous_texture is only set while the overflow
+	// descriptor set of a texture that didn't fit the table is bound.
+	if( bindless_texture_table ) {
+		uint32_t texture_index = 0;
+		if( bindless_texture_table->GetTextureIndex( texture, texture_index ) ) {
+			if( previous_texture ) {
+				bindless_texture_table->CmdBind(
+					command_buffer,
+					use_pipeline_layout,
+					GRAPHICS_DESCRIPTOR_SET_ALLOCATION_TEXTURE
+				);
+				previous_texture		= nullptr;
+			}
+			return texture_index;
+		}
+
+		// Table is full, fall back to a descriptor set holding only this texture.
+		if( texture != previous_texture ) {
+			auto descriptor_set = bindless_texture_table->GetOverflowDescriptorSet( texture );
+			if( descriptor_set == VK_NULL_HANDLE ) {
+				instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot allocate descriptor set for texture!" );
+				return 0;
+			}
+
+			vkCmdBindDescriptorSets(
+				command_buffer,
+				VK_PIPELINE_BIND_POINT_GRAPHICS,
+				use_pipeline_layout,
+				GRAPHICS_DESCRIPTOR_SET_ALLOCATION_TEXTURE,
+				1, &descriptor_set,
+				0, nullptr
+			);
+
+			previous_texture		= texture;
+		}
+		return 0;
+	}
+
 	// if sampler or texture changed since previous call, bind a different descriptor set.
 	if( texture != previous_texture ) {
-		auto & set = GetOrCreateDescriptorSetForTexture( texture );
-		set.previous_access_time = std::chrono::steady_clock::now();
+		auto descriptor_set = GetOrCreateDescriptorSetForTexture( texture );
+		if( descriptor_set == VK_NULL_HANDLE ) {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot allocate descriptor set for texture!" );
+			return 0;
+		}
 
 		vkCmdBindDescriptorSets(
 			command_buffer,
 			VK_PIPELINE_BIND_POINT_GRAPHICS,
 			use_pipeline_layout,
 			GRAPHICS_DESCRIPTOR_SET_ALLOCATION_TEXTURE,
-			1, &set.descriptor_set.descriptorSet,
+			1, &descriptor_set,
 			0, nullptr
 		);
 
 		previous_texture		= texture;
 	}
+	return 0;
 }
 
 // TODO: Render target texture line width never used anywhere, we should enable it.
@@ -3440,20 +3592,21 @@ bool vk2d::_internal::RenderTargetTextureImpl::CmdUpdateFrameData(
 	}
 
 	// Copy data to staging buffer.
+	auto frame_data_staging_buffer = frame_allocator->Allocate<vk2d::_internal::FrameData>( 1 );
 	{
-		auto frame_data = frame_data_staging_buffer.memory.Map<vk2d::_internal::FrameData>();
-		if( !frame_data ) {
-			instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error: Cannot map FrameData staging buffer memory!" );
+		if( frame_data_staging_buffer != VK_SUCCESS ) {
+			instance->Report( frame_data_staging_buffer.result, "Internal error: Cannot allocate FrameData staging buffer memory!" );
 			return false;
 		}
+		auto frame_data = frame_data_staging_buffer.Get<vk2d::_internal::FrameData>();
 		frame_data->coordinate_scaling		= window_coordinate_scaling;
-		frame_data_staging_buffer.memory.Unmap();
+		frame_data_staging_buffer.Flush();
 	}
 	// Record transfer commands from staging buffer to device local buffer.
 	{
 		VkBufferCopy copy_region {};
-		copy_region.srcOffset	= 0;
-		copy_region.dstOffset	= 0;
+		copy_region.srcOffset	= frame_data_staging_buffer.offset;
+		copy_region.dstOffset	= frame_data_device_buffer.offset;
 		copy_region.size		= sizeof( vk2d::_internal::FrameData );
 		vkCmdCopyBuffer(
 			command_buffer,
@@ -3465,3 +3618,208 @@ bool vk2d::_internal::RenderTargetTextureImpl::CmdUpdateFrameData(
 
 	return true;
 }
+
+void vk2d::_internal::RenderTargetTextureImpl::CmdRecordReadbacks(
+	vk2d::_internal::RenderTargetTextureImpl::SwapBuffer		&	swap
+)
+{
+	VK2D_ASSERT_MAIN_THREAD( instance );
+
+	VkCommandBuffer command_buffer		= swap.vk_render_command_buffer;
+	auto device_memory_pool				= instance->GetDeviceMemoryPool();
+	auto byte_size						= VkDeviceSize( size.x ) * VkDeviceSize( size.y ) * sizeof( vk2d::Color8 );
+
+	std::vector<vk2d::_internal::RenderTargetTextureImpl::ReadbackSlot*> slots;
+	for( auto & r : readback_slots ) {
+		if( r.state != vk2d::_internal::RenderTargetTextureImpl::ReadbackState::REQUESTED ) continue;
+
+		// Staging buffers are kept between requests and only grow, a requested
+		// slot is never in use by the GPU so its buffer can be replaced here.
+		if( r.staging_buffer_size < byte_size ) {
+			if( r.staging_buffer.buffer ) {
+				device_memory_pool->FreeCompleteResource( r.staging_buffer );
+			}
+			r.staging_buffer		= {};
+			r.staging_buffer_size	= 0;
+
+			VkBufferCreateInfo buffer_create_info {};
+			buffer_create_info.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			buffer_create_info.pNext					= nullptr;
+			buffer_create_info.flags					= 0;
+			buffer_create_info.size						= byte_size;
+			buffer_create_info.usage					= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
+			buffer_create_info.queueFamilyIndexCount	= 0;
+			buffer_create_info.pQueueFamilyIndices		= nullptr;
+
+			// Host cached memory is much faster to read from, not every device has it.
+			auto staging_buffer = device_memory_pool->CreateCompleteBufferResource(
+				&buffer_create_info,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT
+			);
+			if( staging_buffer != VK_SUCCESS ) {
+				staging_buffer = device_memory_pool->CreateCompleteBufferResource(
+					&buffer_create_info,
+					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+				);
+			}
+			if( staging_buffer != VK_SUCCESS ) {
+				instance->Report( staging_buffer.result, "Internal error: Cannot create RenderTargetTexture readback buffer!" );
+				r.state = vk2d::_internal::RenderTargetTextureImpl::ReadbackState::FAILED;
+				continue;
+			}
+			r.staging_buffer		= staging_buffer;
+			r.staging_buffer_size	= byte_size;
+		}
+		slots.push_back( &r );
+	}
+	if( slots.empty() ) return;
+
+	VkImageSubresourceRange subresource_range {};
+	subresource_range.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	subresource_range.baseMipLevel		= 0;
+	subresource_range.levelCount		= 1;
+	subresource_range.baseArrayLayer	= 0;
+	subresource_range.layerCount		= 1;
+
+	// Sampled image mip level 0 to transfer source.
+	{
+		VkImageMemoryBarrier image_memory_barrier {};
+		image_memory_barrier.sType					= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		image_memory_barrier.pNext					= nullptr;
+		image_memory_barrier.srcAccessMask			= vk_sampled_image_final_access_mask;
+		image_memory_barrier.dstAccessMask			= VK_ACCESS_TRANSFER_READ_BIT;
+		image_memory_barrier.oldLayout				= vk_sampled_image_final_layout;
+		image_memory_barrier.newLayout				= VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		image_memory_barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.image					= swap.sampled_image.image;
+		image_memory_barrier.subresourceRange		= subresource_range;
+
+		vkCmdPipelineBarrier(
+			command_buffer,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			1, &image_memory_barrier
+		);
+	}
+
+	std::vector<VkBufferMemoryBarrier> buffer_memory_barriers;
+	buffer_memory_barriers.reserve( std::size( slots ) );
+	for( auto r : slots ) {
+		VkBufferImageCopy copy_region {};
+		copy_region.bufferOffset					= 0;
+		copy_region.bufferRowLength					= 0;
+		copy_region.bufferImageHeight				= 0;
+		copy_region.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+		copy_region.imageSubresource.mipLevel		= 0;
+		copy_region.imageSubresource.baseArrayLayer	= 0;
+		copy_region.imageSubresource.layerCount		= 1;
+		copy_region.imageOffset						= { 0, 0, 0 };
+		copy_region.imageExtent						= { size.x, size.y, 1 };
+		vkCmdCopyImageToBuffer(
+			command_buffer,
+			swap.sampled_image.image,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			r->staging_buffer.buffer,
+			1, &copy_region
+		);
+
+		VkBufferMemoryBarrier buffer_memory_barrier {};
+		buffer_memory_barrier.sType					= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		buffer_memory_barrier.pNext					= nullptr;
+		buffer_memory_barrier.srcAccessMask			= VK_ACCESS_TRANSFER_WRITE_BIT;
+		buffer_memory_barrier.dstAccessMask			= VK_ACCESS_HOST_READ_BIT;
+		buffer_memory_barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		buffer_memory_barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		buffer_memory_barrier.buffer				= r->staging_buffer.buffer;
+		buffer_memory_barrier.offset				= 0;
+		buffer_memory_barrier.size					= byte_size;
+		buffer_memory_barriers.push_back( buffer_memory_barrier );
+
+		r->size					= size;
+		r->swap_buffer_index	= current_swap_buffer;
+		r->render_counter		= swap.render_counter + 1;	// Incremented when the render is recorded.
+		r->state				= vk2d::_internal::RenderTargetTextureImpl::ReadbackState::RECORDED;
+	}
+
+	// Sampled image back to final layout, copied texels to host.
+	{
+		VkImageMemoryBarrier image_memory_barrier {};
+		image_memory_barrier.sType					= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		image_memory_barrier.pNext					= nullptr;
+		image_memory_barrier.srcAccessMask			= VK_ACCESS_TRANSFER_READ_BIT;
+		image_memory_barrier.dstAccessMask			= vk_sampled_image_final_access_mask;
+		image_memory_barrier.oldLayout				= VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		image_memory_barrier.newLayout				= vk_sampled_image_final_layout;
+		image_memory_barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.image					= swap.sampled_image.image;
+		image_memory_barrier.subresourceRange		= subresource_range;
+
+		vkCmdPipelineBarrier(
+			command_buffer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+			0,
+			0, nullptr,
+			uint32_t( std::size( buffer_memory_barriers ) ), buffer_memory_barriers.data(),
+			1, &image_memory_barrier
+		);
+	}
+}
+
+void vk2d::_internal::RenderTargetTextureImpl::ProcessReadbacks()
+{
+	VK2D_ASSERT_MAIN_THREAD( instance );
+
+	std::array<uint64_t, std::tuple_size_v<decltype( swap_buffers )>> completed_render_counters {};
+	for( size_t i = 0; i < std::size( swap_buffers ); ++i ) {
+		auto result = vkGetSemaphoreCounterValue(
+			instance->GetVulkanDevice(),
+			swap_buffers[ i ].vk_render_complete_semaphore,
+			&completed_render_counters[ i ]
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot get RenderTargetTexture render complete semaphore value!" );
+			return;
+		}
+	}
+
+	for( auto & r : readback_slots ) {
+		if( r.state == vk2d::_internal::RenderTargetTextureImpl::ReadbackState::FAILED ) {
+			FinishReadback( r, false );
+			continue;
+		}
+		if( r.state != vk2d::_internal::RenderTargetTextureImpl::ReadbackState::SUBMITTED ) continue;
+		if( completed_render_counters[ r.swap_buffer_index ] < r.render_counter ) continue;
+
+		FinishReadback( r, true );
+	}
+}
+
+void vk2d::_internal::RenderTargetTextureImpl::FinishReadback(
+	vk2d::_internal::RenderTargetTextureImpl::ReadbackSlot		&	slot,
+	bool															success
+)
+{
+	VK2D_ASSERT_MAIN_THREAD( instance );
+
+	vk2d::ImageData image_data {};
+	if( success ) {
+		slot.staging_buffer.memory.Invalidate();
+		auto texels = slot.staging_buffer.memory.Map<vk2d::Color8>();
+		image_data.size		= slot.size;
+		image_data.data.assign( texels, texels + size_t( slot.size.x ) * size_t( slot.size.y ) );
+	}
+
+	// Slot is free before the callback so the callback can request another readback.
+	auto callback		= std::move( slot.callback );
+	slot.callback		= {};
+	slot.state			= vk2d::_internal::RenderTargetTextureImpl::ReadbackState::IDLE;
+
+	callback( image_data, success );
+}
@@ -12,6 +12,9 @@
 #include "System/RenderTargetTextureDependecyGraphInfo.hpp"
 #include "System/DescriptorSet.h"
 #include "System/VulkanMemoryManagement.h"
+#include "System/FrameLinearAllocator.h"
+#include "System/BindlessTextureTable.h"
+#include "System/DescriptorSetCache.h"
 
 #include "Interface/InstanceImpl.h"
 
@@ -116,6 +119,26 @@ private:
 		bool															contains_non_pending_sampled_image			= {};	// Sampled image ready to be used anywhere without checks or barriers.
 	};
 
+	enum class ReadbackState
+	{
+		IDLE,			// Free to be requested.
+		REQUESTED,		// Copy is recorded at the next EndRender().
+		RECORDED,		// Copy is recorded into a swap buffer render but not submitted yet.
+		SUBMITTED,		// Copy is submitted, waiting for the swap buffer render to finish.
+		FAILED,			// Copy could not be recorded, reported to the callback next.
+	};
+
+	struct ReadbackSlot
+	{
+		vk2d::_internal::RenderTargetTextureImpl::ReadbackState			state										= {};
+		std::function<void( const vk2d::ImageData &, bool )>			callback									= {};
+		vk2d::_internal::CompleteBufferResource							staging_buffer								= {};	// Host visible, kept between requests.
+		VkDeviceSize													staging_buffer_size							= {};
+		vk2d::Vector2u													size										= {};	// Image size when the copy was recorded.
+		uint32_t														swap_buffer_index							= {};
+		uint64_t														render_counter								= {};	// Render complete semaphore value after which the copy is done.
+	};
+
 public:
 	RenderTargetTextureImpl(
 		vk2d::RenderTargetTexture									*	my_interface,
@@ -154,6 +177,14 @@ public:
 		vk2d::BlurType													blur_type,
 		vk2d::Vector2f													blur_amount );
 
+	// True between BeginRender() and EndRender().
+	bool																IsRendering() const;
+
+	// Hands finished readbacks to their callbacks, never waits for the GPU.
+	// Called by BeginRender() and once per window frame so readbacks finish
+	// even when this render target isn't rendered again.
+	void																ProcessReadbacks();
+
 	bool																SynchronizeFrame();
 	bool																WaitIdle();
 
@@ -236,6 +267,11 @@ public:
 		const vk2d::Mesh											&	mesh,
 		const std::vector<vk2d::Matrix4f>							&	transformations );
 
+	bool																RequestReadback(
+		std::function<void( const vk2d::ImageData &, bool )>			callback );
+
+	vk2d::DescriptorCacheStatistics										GetDescriptorCacheStatistics() const;
+
 	bool																IsGood() const;
 
 private:
@@ -269,10 +305,12 @@ private:
 		const std::vector<uint64_t>									&	wait_for_semaphore_timeline_values,
 		const std::vector<VkPipelineStageFlags>						&	wait_for_semaphore_pipeline_stages );
 
-	vk2d::_internal::TimedDescriptorPoolData						&	GetOrCreateDescriptorSetForSampler(
+	// Returns VK_NULL_HANDLE if descriptor set could not be allocated.
+	VkDescriptorSet														GetOrCreateDescriptorSetForSampler(
 		vk2d::Sampler												*	sampler );
 
-	vk2d::_internal::TimedDescriptorPoolData						&	GetOrCreateDescriptorSetForTexture(
+	// Returns VK_NULL_HANDLE if descriptor set could not be allocated.
+	VkDescriptorSet														GetOrCreateDescriptorSetForTexture(
 		vk2d::Texture												*	texture );
 
 	void																CmdPushBlurTextureDescriptorWritesDirectly(
@@ -339,7 +377,8 @@ private:
 		vk2d::Sampler												*	sampler,
 		VkPipelineLayout												use_pipeline_layout );
 
-	void																CmdBindTextureIfDifferent(
+	// Returns texture index for push constants.
+	uint32_t															CmdBindTextureIfDifferent(
 		VkCommandBuffer													command_buffer,
 		vk2d::Texture												*	texture,
 		VkPipelineLayout												use_pipeline_layout );
@@ -351,6 +390,16 @@ private:
 	bool																CmdUpdateFrameData(
 		VkCommandBuffer													command_buffer );
 
+	// Records copies of the sampled image for requested readbacks into the render
+	// command buffer of a swap buffer, called after the render is finalized.
+	void																CmdRecordReadbacks(
+		vk2d::_internal::RenderTargetTextureImpl::SwapBuffer		&	swap );
+
+	// Calls the callback of a readback slot and frees the slot.
+	void																FinishReadback(
+		vk2d::_internal::RenderTargetTextureImpl::ReadbackSlot		&	slot,
+		bool															success );
+
 	vk2d::RenderTargetTexture										*	my_interface								= {};
 	vk2d::_internal::InstanceImpl									*	instance									= {};
 	vk2d::RenderTargetTextureCreateInfo									create_info_copy							= {};
@@ -363,8 +412,9 @@ private:
 	std::vector<VkExtent2D>												mipmap_levels								= {};
 	bool																granularity_aligned							= {};
 
-	vk2d::_internal::CompleteBufferResource								frame_data_staging_buffer					= {};
-	vk2d::_internal::CompleteBufferResource								frame_data_device_buffer					= {};
+	std::unique_ptr<vk2d::_internal::FrameLinearAllocator>				frame_allocator								= {};	// Per swap buffer transient host visible memory.
+	std::unique_ptr<vk2d::_internal::BindlessTextureTable>				bindless_texture_table						= {};	// Only if bindless textures are enabled.
+	vk2d::_internal::BufferSubAllocation								frame_data_device_buffer					= {};
 	vk2d::_internal::PoolDescriptorSet									frame_data_descriptor_set					= {};
 
 	VkCommandPool														vk_graphics_command_pool					= {};
@@ -388,11 +438,14 @@ private:
 	vk2d::Sampler													*	previous_sampler							= {};
 	float																previous_line_width							= {};
 
-	std::map<vk2d::Sampler*, vk2d::_internal::TimedDescriptorPoolData>	sampler_descriptor_sets						= {};
-	std::map<vk2d::Texture*, vk2d::_internal::TimedDescriptorPoolData>	texture_descriptor_sets						= {};
-	std::map<VkImageView, std::map<VkImageView, vk2d::_internal::TimedDescriptorPoolData>>
-																		image_descriptor_sets						= {};
+	std::unique_ptr<vk2d::_internal::DescriptorSetCache>				sampler_descriptor_set_cache				= {};
+	std::unique_ptr<vk2d::_internal::DescriptorSetCache>				texture_descriptor_set_cache				= {};
+
+	std::array<vk2d::_internal::RenderTargetTextureImpl::ReadbackSlot, VK2D_BUILD_OPTION_RENDER_TARGET_READBACK_RING_SIZE>
+																		readback_slots								= {};
+	uint32_t															next_readback_slot							= {};
 
+	bool																is_rendering								= {};
 	bool																is_good										= {};
 };
 
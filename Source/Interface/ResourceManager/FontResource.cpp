@@ -28,6 +28,317 @@ uint32_t RoundToCeilingPowerOfTwo(
 
 
 
+// Glyphs are handed out to threads in chunks of this many glyphs.
+constexpr uint32_t FONT_GLYPH_RASTERIZATION_CHUNK_SIZE = 64;
+
+// Atlas pages of fonts that load glyphs on demand fit about this many
+// glyphs per row, more pages are added when they fill up.
+constexpr uint32_t FONT_ON_DEMAND_ATLAS_GLYPHS_PER_ROW = 8;
+
+
+
+// Glyph measured and rendered by GlyphRasterizationJob, texels converted to RGBA.
+struct RasterizedGlyph {
+	std::vector<vk2d::Color8>				texels					= {};
+	FT_Glyph_Metrics						metrics					= {};
+	vk2d::Vector2u							bitmap_size				= {};	// Rendered bitmap size.
+	vk2d::Vector2u							loaded_bitmap_size		= {};	// Bitmap size before rendering, used to estimate atlas size.
+};
+
+// Returns error message or nullptr if glyph was rendered.
+const char * RasterizeGlyph(
+	FT_Face									face,
+	FT_UInt									glyph_index,
+	bool									use_alpha,
+	vk2d::_internal::RasterizedGlyph	&	out_glyph
+)
+{
+	{
+		auto ft_load_error = FT_Load_Glyph( face, glyph_index, FT_LOAD_DEFAULT );
+		if( ft_load_error ) {
+			return "Internal error: Cannot load font, cannot load glyph!";
+		}
+	}
+	out_glyph.loaded_bitmap_size	= { uint32_t( face->glyph->bitmap.width ), uint32_t( face->glyph->bitmap.rows ) };
+	{
+		auto ft_render_error = FT_Render_Glyph( face->glyph, use_alpha ? FT_RENDER_MODE_NORMAL : FT_RENDER_MODE_MONO );
+		if( ft_render_error ) {
+			return "Internal error: Cannot load font, cannot render glyph!";
+		}
+	}
+	auto	ft_glyph	= face->glyph;
+	auto &	ft_bitmap	= ft_glyph->bitmap;
+
+	out_glyph.metrics				= ft_glyph->metrics;
+	out_glyph.bitmap_size			= { uint32_t( ft_bitmap.width ), uint32_t( ft_bitmap.rows ) };
+
+	auto & final_glyph_pixels		= out_glyph.texels;
+	final_glyph_pixels.resize( size_t( ft_bitmap.rows ) * size_t( ft_bitmap.width ) );
+
+	switch( ft_bitmap.pixel_mode ) {
+		case FT_PIXEL_MODE_MONO:
+		{
+			for( uint32_t y = 0; y < ft_bitmap.rows; ++y ) {
+				for( uint32_t x = 0; x < ft_bitmap.width; ++x ) {
+					auto	texel_pos	= y * ft_bitmap.width + x;
+					auto &	dst			= final_glyph_pixels[ texel_pos ];
+					auto	src_bit		= 7 - x % 8;
+					auto	src_byte	= ft_bitmap.buffer[ ( y * ft_bitmap.pitch ) + ( x / 8 ) ];
+
+					dst.r				= ( ( src_byte >> src_bit ) & 1 ) * 255;
+					dst.g				= dst.r;
+					dst.b				= dst.r;
+					dst.a				= dst.r;
+				}
+			}
+		}
+		break;
+
+		case FT_PIXEL_MODE_GRAY:
+		{
+			for( uint32_t y = 0; y < ft_bitmap.rows; ++y ) {
+				for( uint32_t x = 0; x < ft_bitmap.width; ++x ) {
+					auto	texel_pos	= y * ft_bitmap.width + x;
+					auto &	dst			= final_glyph_pixels[ texel_pos ];
+					auto	src			= ft_bitmap.buffer[ texel_pos ];
+
+					dst.r				= src;
+					dst.g				= src;
+					dst.b				= src;
+					dst.a				= src;
+				}
+			}
+		}
+		break;
+
+		case FT_PIXEL_MODE_BGRA:
+		{
+			for( uint32_t y = 0; y < ft_bitmap.rows; ++y ) {
+				for( uint32_t x = 0; x < ft_bitmap.width; ++x ) {
+					auto	texel_pos	= y * ft_bitmap.width + x;
+					auto &	dst			= final_glyph_pixels[ texel_pos ];
+					auto	src			= &ft_bitmap.buffer[ texel_pos * 4 ];
+
+					dst.r				= src[ 2 ];
+					dst.g				= src[ 1 ];
+					dst.b				= src[ 0 ];
+					dst.a				= src[ 3 ];
+				}
+			}
+		}
+		break;
+
+		default:
+			// Unsupported
+			return "Internal error: Cannot load font, Unsupported pixel format!";
+	}
+	return nullptr;
+}
+
+
+
+// Renders every glyph of every face of a font. The loader thread renders
+// glyphs itself and general threads help out by running GlyphRasterizationTask,
+// each thread takes the next chunk of glyphs nobody has started yet. FreeType
+// faces cannot be shared between threads so every thread opens the faces it
+// needs with a FreeType library of its own. Results are stored by glyph so
+// atlas placement afterwards doesn't depend on which thread rendered what.
+// Shared with the tasks as they may run after the loader thread is done with
+// the job.
+class GlyphRasterizationJob {
+public:
+	struct Chunk {
+		uint32_t								face_index				= {};
+		uint32_t								first_glyph				= {};
+		uint32_t								glyph_count				= {};
+	};
+
+	// Font file in memory is owned by the caller, it must stay valid until Wait() returns.
+	GlyphRasterizationJob(
+		const std::string						&	file_path,
+		const void								*	file_data,
+		size_t										file_size,
+		const std::vector<uint32_t>				&	face_glyph_counts,
+		uint32_t									glyph_texel_size,
+		bool										use_alpha
+	) :
+		file_path( file_path ),
+		file_data( file_data ),
+		file_size( file_size ),
+		glyph_texel_size( glyph_texel_size ),
+		use_alpha( use_alpha )
+	{
+		glyphs.resize( face_glyph_counts.size() );
+		for( uint32_t f = 0; f < uint32_t( face_glyph_counts.size() ); ++f ) {
+			glyphs[ f ].resize( face_glyph_counts[ f ] );
+			for( uint32_t g = 0; g < face_glyph_counts[ f ]; g += FONT_GLYPH_RASTERIZATION_CHUNK_SIZE ) {
+				chunks.push_back( { f, g, std::min( FONT_GLYPH_RASTERIZATION_CHUNK_SIZE, face_glyph_counts[ f ] - g ) } );
+			}
+		}
+	}
+
+	// Renders glyphs until every chunk has been started.
+	void										Run()
+	{
+		auto			run_begin	= std::chrono::steady_clock::now();
+		FT_Library		library		= {};
+		std::vector<FT_Face>		faces( glyphs.size() );
+		bool			is_active	= false;
+
+		while( true ) {
+			auto index = next_chunk.fetch_add( 1 );
+			if( index >= chunks.size() ) break;
+
+			// Counted before touching the font so Wait() knows to wait for the faces to close.
+			if( !is_active ) {
+				std::lock_guard<std::mutex> lock( finished_mutex );
+				++active_count;
+				is_active = true;
+			}
+
+			// No point in rendering the rest if the font cannot be created anyways.
+			auto & chunk = chunks[ index ];
+			if( !error ) {
+				if( !faces[ chunk.face_index ] ) {
+					if( !library && FT_Init_FreeType( &library ) ) {
+						library = nullptr;
+						SetError( "Internal error: Cannot load font, cannot initialize FreeType!" );
+					} else if( !OpenFace( library, chunk.face_index, &faces[ chunk.face_index ] ) ) {
+						faces[ chunk.face_index ] = nullptr;
+						SetError( "Internal error: Cannot load font, cannot open font face for glyph rasterization!" );
+					}
+				}
+				for( uint32_t i = 0; i < chunk.glyph_count && !error && faces[ chunk.face_index ]; ++i ) {
+					auto glyph_index = chunk.first_glyph + i;
+					if( auto message = vk2d::_internal::RasterizeGlyph( faces[ chunk.face_index ], FT_UInt( glyph_index ), use_alpha, glyphs[ chunk.face_index ][ glyph_index ] ) ) {
+						SetError( message );
+					}
+				}
+			}
+
+			std::lock_guard<std::mutex> lock( finished_mutex );
+			++finished_count;
+		}
+
+		if( !is_active ) return;
+
+		for( auto f : faces ) {
+			if( f ) FT_Done_Face( f );
+		}
+		if( library ) FT_Done_FreeType( library );
+
+		std::lock_guard<std::mutex> lock( finished_mutex );
+		thread_time += std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - run_begin );
+		if( --active_count == 0 && finished_count == chunks.size() ) {
+			finished_condition.notify_all();
+		}
+	}
+
+	// Waits until every glyph has been rendered or rendering has failed and
+	// every thread that took part is done with the font.
+	void										Wait()
+	{
+		std::unique_lock<std::mutex> lock( finished_mutex );
+		finished_condition.wait( lock, [ this ]() { return finished_count == chunks.size() && active_count == 0; } );
+	}
+
+	// Only access after Wait(). Returns nullptr if every glyph was rendered.
+	const char								*	GetError() const
+	{
+		return error;
+	}
+
+	// Only access after Wait().
+	std::vector<std::vector<vk2d::_internal::RasterizedGlyph>>	&	GetGlyphs()
+	{
+		return glyphs;
+	}
+
+	// Time spent by every thread that took part, about what a single thread would take.
+	// Only access after Wait().
+	std::chrono::nanoseconds					GetThreadTime() const
+	{
+		return thread_time;
+	}
+
+private:
+	bool										OpenFace(
+		FT_Library									library,
+		uint32_t									face_index,
+		FT_Face									*	face )
+	{
+		FT_Error ft_error = {};
+		if( file_data ) {
+			ft_error = FT_New_Memory_Face(
+				library,
+				reinterpret_cast<const FT_Byte*>( file_data ),
+				FT_Long( file_size ),
+				FT_Long( face_index ),
+				face
+			);
+		} else {
+			ft_error = FT_New_Face(
+				library,
+				file_path.c_str(),
+				FT_Long( face_index ),
+				face
+			);
+		}
+		if( ft_error ) return false;
+		if( FT_Set_Pixel_Sizes( *face, 0, glyph_texel_size ) ) {
+			FT_Done_Face( *face );
+			return false;
+		}
+		return true;
+	}
+
+	// Keeps the first error.
+	void										SetError(
+		const char								*	message )
+	{
+		const char * expected = nullptr;
+		error.compare_exchange_strong( expected, message );
+	}
+
+	std::string											file_path;
+	const void										*	file_data				= {};
+	size_t												file_size				= {};
+	uint32_t											glyph_texel_size		= {};
+	bool												use_alpha				= {};
+
+	std::vector<Chunk>									chunks;
+	std::vector<std::vector<vk2d::_internal::RasterizedGlyph>>	glyphs;
+	std::atomic<size_t>									next_chunk				= {};
+	std::atomic<const char*>							error					= {};
+
+	std::mutex											finished_mutex;
+	std::condition_variable								finished_condition;
+	size_t												finished_count			= {};
+	uint32_t											active_count			= {};
+	std::chrono::nanoseconds							thread_time				= {};
+};
+
+class GlyphRasterizationTask : public vk2d::_internal::Task
+{
+public:
+	GlyphRasterizationTask(
+		std::shared_ptr<vk2d::_internal::GlyphRasterizationJob>		rasterization_job
+	) :
+		rasterization_job( std::move( rasterization_job ) )
+	{}
+
+	void											operator()(
+		[[maybe_unused]] vk2d::_internal::ThreadPrivateResource	*	thread_resource )
+	{
+		rasterization_job->Run();
+	}
+
+private:
+	std::shared_ptr<vk2d::_internal::GlyphRasterizationJob>			rasterization_job;
+};
+
+
+
 }
 }
 
@@ -59,7 +370,9 @@ VK2D_API vk2d::FontResource::FontResource(
 	uint32_t									glyph_texel_size,
 	bool										use_alpha,
 	uint32_t									fallback_character,
-	uint32_t									glyph_atlas_padding
+	uint32_t									glyph_atlas_padding,
+	bool										load_glyphs_on_demand,
+	std::string_view							preload_characters
 )
 {
 	impl = std::make_unique<vk2d::_internal::FontResourceImpl>(
@@ -71,7 +384,46 @@ VK2D_API vk2d::FontResource::FontResource(
 		glyph_texel_size,
 		use_alpha,
 		fallback_character,
-		glyph_atlas_padding
+		glyph_atlas_padding,
+		load_glyphs_on_demand,
+		preload_characters
+	);
+	if( !impl || !impl->IsGood() ) {
+		impl		= nullptr;
+		resource_manager->GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create font resource implementation!" );
+		return;
+	}
+
+	resource_impl = impl.get();
+}
+
+VK2D_API vk2d::FontResource::FontResource(
+	vk2d::_internal::ResourceManagerImpl	*	resource_manager,
+	uint32_t									loader_thread_index,
+	vk2d::Resource							*	parent_resource,
+	const void								*	font_file_data,
+	size_t										font_file_size,
+	uint32_t									glyph_texel_size,
+	bool										use_alpha,
+	uint32_t									fallback_character,
+	uint32_t									glyph_atlas_padding,
+	bool										load_glyphs_on_demand,
+	std::string_view							preload_characters
+)
+{
+	impl = std::make_unique<vk2d::_internal::FontResourceImpl>(
+		this,
+		resource_manager,
+		loader_thread_index,
+		parent_resource,
+		font_file_data,
+		font_file_size,
+		glyph_texel_size,
+		use_alpha,
+		fallback_character,
+		glyph_atlas_padding,
+		load_glyphs_on_demand,
+		preload_characters
 	);
 	if( !impl || !impl->IsGood() ) {
 		impl		= nullptr;
@@ -157,7 +509,9 @@ vk2d::_internal::FontResourceImpl::FontResourceImpl(
 	uint32_t									glyph_texel_size,
 	bool										use_alpha,
 	uint32_t									fallback_character,
-	uint32_t									glyph_atlas_padding
+	uint32_t									glyph_atlas_padding,
+	bool										load_glyphs_on_demand,
+	std::string_view							preload_characters
 ) :
 	vk2d::_internal::ResourceImpl(
 		my_interface,
@@ -177,6 +531,47 @@ vk2d::_internal::FontResourceImpl::FontResourceImpl(
 	this->glyph_atlas_padding			= glyph_atlas_padding;
 	this->fallback_character			= fallback_character;
 	this->use_alpha						= use_alpha;
+	this->load_glyphs_on_demand			= load_glyphs_on_demand;
+	this->preload_characters			= load_glyphs_on_demand ? std::string( preload_characters ) : std::string();
+
+	is_good		= true;
+}
+
+vk2d::_internal::FontResourceImpl::FontResourceImpl(
+	vk2d::FontResource						*	my_interface,
+	vk2d::_internal::ResourceManagerImpl	*	resource_manager,
+	uint32_t									loader_thread_index,
+	vk2d::Resource							*	parent_resource,
+	const void								*	font_file_data,
+	size_t										font_file_size,
+	uint32_t									glyph_texel_size,
+	bool										use_alpha,
+	uint32_t									fallback_character,
+	uint32_t									glyph_atlas_padding,
+	bool										load_glyphs_on_demand,
+	std::string_view							preload_characters
+) :
+	vk2d::_internal::ResourceImpl(
+		my_interface,
+		loader_thread_index,
+		resource_manager,
+		parent_resource,
+		font_file_data,
+		font_file_size
+	)
+{
+	assert( my_interface );
+	assert( resource_manager );
+
+	this->my_interface					= my_interface;
+	this->resource_manager		= resource_manager;
+
+	this->glyph_texel_size				= glyph_texel_size;
+	this->glyph_atlas_padding			= glyph_atlas_padding;
+	this->fallback_character			= fallback_character;
+	this->use_alpha						= use_alpha;
+	this->load_glyphs_on_demand			= load_glyphs_on_demand;
+	this->preload_characters			= load_glyphs_on_demand ? std::string( preload_characters ) : std::string();
 
 	is_good		= true;
 }
@@ -196,6 +591,9 @@ vk2d::ResourceStatus vk2d::_internal::FontResourceImpl::GetStatus()
 			// "texture_resource" is set by the MTLoad() function so we can access it
 			// without further mutex locking. ( "load_function_run_fence" is set )
 			status = local_status = texture_resource->GetStatus();
+			if( local_status != vk2d::ResourceStatus::UNDETERMINED ) {
+				FinishLoadTiming();
+			}
 		}
 	}
 
@@ -227,6 +625,9 @@ vk2d::ResourceStatus vk2d::_internal::FontResourceImpl::WaitUntilLoaded(
 
 		if( load_function_run_fence.Wait( timeout ) ) {
 			status = local_status = texture_resource->WaitUntilLoaded( timeout );
+			if( local_status != vk2d::ResourceStatus::UNDETERMINED ) {
+				FinishLoadTiming();
+			}
 		}
 
 	}
@@ -238,15 +639,12 @@ bool vk2d::_internal::FontResourceImpl::MTLoad(
 	vk2d::_internal::ThreadPrivateResource		*	thread_resource
 )
 {
-	// TODO: additional parameters:
-	// From raw file.
-
 	assert( thread_resource );
-	assert( my_interface->impl->GetFilePaths().size() );
+	assert( my_interface->impl->GetFilePaths().size() || my_interface->impl->IsFromMemory() );
 
 	auto loader_thread_resource		= static_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
 	auto instance					= loader_thread_resource->GetInstance();
-	auto path_str					= my_interface->impl->GetFilePaths()[ 0 ].string();
+	auto path_str					= my_interface->impl->IsFromFile() ? my_interface->impl->GetFilePaths()[ 0 ].string() : std::string( "<memory>" );
 	auto max_texture_size			= instance->GetVulkanPhysicalDeviceProperties().limits.maxImageDimension2D;
 	auto min_texture_size			= std::min( uint32_t( 128 ), max_texture_size );
 
@@ -260,19 +658,71 @@ bool vk2d::_internal::FontResourceImpl::MTLoad(
 	auto maximum_glyph_bitmap_occupancy_size	= vk2d::Vector2d( 0.0, 0.0 );
 	auto average_glyph_bitmap_occupancy_size	= vk2d::Vector2d( 0.0, 0.0 );
 
-	if( my_interface->impl->IsFromFile() ) {
-		// Try to load from file.
+	// FreeType reads the font file as it goes, opening faces is counted as
+	// decoding. Glyphs are measured while they're rendered.
+	auto decode_begin							= std::chrono::steady_clock::now();
+	if( IsFromMemory() ) {
+		AddLoadBytes( &vk2d::ResourceLoadTiming::source_bytes, uint64_t( GetMemorySize() ) );
+	} else if( IsFromFile() ) {
+		std::error_code error;
+		auto file_size = std::filesystem::file_size( GetFilePaths()[ 0 ], error );
+		if( !error ) {
+			AddLoadBytes( &vk2d::ResourceLoadTiming::source_bytes, uint64_t( file_size ) );
+		}
+	}
+
+	// Faces of fonts that load glyphs on demand outlive this function and are
+	// used from other threads, they can't use the loader thread's FreeType
+	// library. Caller owned memory may be released after loading so it's copied.
+	auto free_type_library						= loader_thread_resource->GetFreeTypeInstance();
+	auto font_file_data							= IsFromMemory() ? GetMemoryData() : nullptr;
+	if( load_glyphs_on_demand ) {
+		if( FT_Init_FreeType( &on_demand_library ) ) {
+			on_demand_library = nullptr;
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot load font, cannot initialize FreeType!" );
+			return false;
+		}
+		free_type_library						= on_demand_library;
+		if( IsFromMemory() ) {
+			auto memory_begin					= reinterpret_cast<const uint8_t*>( GetMemoryData() );
+			on_demand_font_file.assign( memory_begin, memory_begin + GetMemorySize() );
+			font_file_data						= on_demand_font_file.data();
+		}
+	}
+
+	// Opens a face from the file or from memory. FreeType reads memory faces in
+	// place, the memory is only needed until faces are closed.
+	auto OpenFace = [ this, free_type_library, font_file_data, &path_str ](
+		FT_Long		face_index,
+		FT_Face	*	face
+		) -> FT_Error
+	{
+		if( IsFromMemory() ) {
+			if( GetMemorySize() > size_t( std::numeric_limits<FT_Long>::max() ) ) return FT_Err_Invalid_Stream_Operation;
+			return FT_New_Memory_Face(
+				free_type_library,
+				reinterpret_cast<const FT_Byte*>( font_file_data ),
+				FT_Long( GetMemorySize() ),
+				face_index,
+				face
+			);
+		}
+		return FT_New_Face(
+			free_type_library,
+			path_str.c_str(),
+			face_index,
+			face
+		);
+	};
+
+	if( my_interface->impl->IsFromFile() || my_interface->impl->IsFromMemory() ) {
+		// Try to load from file or from a font file in memory.
 
 		// Get amount of faces in the file
 		uint32_t face_count = 0;
 		{
 			FT_Face face {};
-			auto ft_error = FT_New_Face(
-				loader_thread_resource->GetFreeTypeInstance(),
-				path_str.c_str(),
-				-1,
-				&face
-			);
+			auto ft_error = OpenFace( -1, &face );
 
 			switch( ft_error ) {
 				case FT_Err_Ok:
@@ -310,12 +760,7 @@ bool vk2d::_internal::FontResourceImpl::MTLoad(
 		for( uint32_t i = 0; i < face_count; ++i ) {
 			FT_Face face {};
 			{
-				auto ft_error = FT_New_Face(
-					loader_thread_resource->GetFreeTypeInstance(),
-					path_str.c_str(),
-					i,
-					&face
-				);
+				auto ft_error = OpenFace( FT_Long( i ), &face );
 				if( ft_error ) {
 					instance->Report(
 						vk2d::ReportSeverity::NON_CRITICAL_ERROR,
@@ -339,58 +784,141 @@ bool vk2d::_internal::FontResourceImpl::MTLoad(
 				}
 			}
 
-			// Get glyph sizes
+			// Glyphs are measured when they're rendered.
 			total_glyph_count			+= uint64_t( face->num_glyphs ) + 1;
-			for( decltype( face->num_glyphs ) i = 0; i < face->num_glyphs; ++i ) {
 
-				auto ft_load_error = FT_Load_Glyph( face, FT_UInt( i ), FT_LOAD_DEFAULT );
-				if( ft_load_error ) {
-					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot load font, cannot load glyph for bitmap metrics!" );
-					return false;
-				}
+			face_infos[ i ].face	= face;
+		}
 
-				auto glyph_size =
-					vk2d::Vector2d(
-						double( face->glyph->metrics.width ),
-						double( face->glyph->metrics.height )
-					);
+	} else {
+		// Try to load from data.
 
-				auto glyph_bitmap_size =
-					vk2d::Vector2d(
-						double( face->glyph->bitmap.width ),
-						double( face->glyph->bitmap.rows )
-					);
+		assert( 0 && "Not implemented yet!" );
+	}
 
-				auto glyph_bitmap_space_occupancy =
-					vk2d::Vector2d(
-						double( face->glyph->bitmap.width + glyph_atlas_padding ),
-						double( face->glyph->bitmap.rows + glyph_atlas_padding )
-					);
+	if( !total_glyph_count ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot load font: Font contains no glyphs!" );
+		return false;
+	}
+
+	// Stop if we don't have any font's to work with.
+	if( !face_infos.size() ) {
+		instance->Report(
+			vk2d::ReportSeverity::NON_CRITICAL_ERROR,
+			std::string( "Internal error: Cannot load font: " ) + path_str
+		);
+		return false;
+	}
 
-				maximum_glyph_size.x					= std::max( maximum_glyph_size.x, glyph_size.x );
-				maximum_glyph_size.y					= std::max( maximum_glyph_size.y, glyph_size.y );
+	AddLoadTime( &vk2d::ResourceLoadTiming::decode, decode_begin );
+	auto glyph_rasterization_begin				= std::chrono::steady_clock::now();
 
-				maximum_glyph_bitmap_size.x				= std::max( maximum_glyph_bitmap_size.x, glyph_bitmap_size.x );
-				maximum_glyph_bitmap_size.y				= std::max( maximum_glyph_bitmap_size.y, glyph_bitmap_size.y );
+	if( load_glyphs_on_demand ) {
+		// Only the fallback glyphs and preloaded characters are rendered now.
+		// Pages are sized for a few dozen glyphs each, more pages are added as
+		// they fill up. Faces stay open for rendering the rest. Rounded down,
+		// rounding up could make a page hold up to four times as many glyphs.
+		atlas_size			= RoundToCeilingPowerOfTwo( ( glyph_texel_size + glyph_atlas_padding * 2 ) * vk2d::_internal::FONT_ON_DEMAND_ATLAS_GLYPHS_PER_ROW + 1 ) / 2;
+		if( atlas_size > max_texture_size ) atlas_size = max_texture_size;
+		if( atlas_size < min_texture_size ) atlas_size = min_texture_size;
 
-				maximum_glyph_bitmap_occupancy_size.x	= std::max( maximum_glyph_bitmap_occupancy_size.x, glyph_bitmap_space_occupancy.x );
-				maximum_glyph_bitmap_occupancy_size.y	= std::max( maximum_glyph_bitmap_occupancy_size.y, glyph_bitmap_space_occupancy.y );
+		current_atlas_texture						= CreateNewAtlasTexture();
 
-				average_glyph_bitmap_occupancy_size		+= glyph_bitmap_space_occupancy;
+		for( uint32_t face_index = 0; face_index < uint32_t( face_infos.size() ); ++face_index ) {
+			auto & face = face_infos[ face_index ];
+			face.glyph_infos.resize( face.face->num_glyphs );
+			face.loaded_glyphs.resize( face.face->num_glyphs );
+			CreateCharmap( face );
+			if( !LoadGlyphOnDemand( face_index, face.fallback_glyph_index ) ) return false;
+		}
+		for( uint32_t face_index = 0; face_index < uint32_t( face_infos.size() ); ++face_index ) {
+			for( auto c : preload_characters ) {
+				GetGlyphInfo( face_index, c );
 			}
+		}
+		AddLoadTime( &vk2d::ResourceLoadTiming::glyph_rasterization, glyph_rasterization_begin );
 
-			face_infos[ i ].face	= face;
+		texture_resource = CreateAtlasTextureResource();
+		if( !texture_resource ) {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create font, cannot create texture resource for font!" );
+			return false;
 		}
+		texture_resource_layer_count = uint32_t( atlas_textures.size() );
+		return true;
+	}
 
-	} else {
-		// Try to load from data.
+	// Render every glyph of every face in parallel.
+	std::shared_ptr<vk2d::_internal::GlyphRasterizationJob> rasterization_job;
+	{
+		std::vector<uint32_t> face_glyph_counts( face_infos.size() );
+		for( size_t i = 0; i < face_infos.size(); ++i ) {
+			face_glyph_counts[ i ] = uint32_t( face_infos[ i ].face->num_glyphs );
+		}
+		rasterization_job = std::make_shared<vk2d::_internal::GlyphRasterizationJob>(
+			path_str,
+			IsFromMemory() ? GetMemoryData() : nullptr,
+			IsFromMemory() ? GetMemorySize() : size_t( 0 ),
+			face_glyph_counts,
+			glyph_texel_size,
+			use_alpha
+		);
 
-		assert( 0 && "Not implemented yet!" );
+		auto thread_pool		= resource_manager->GetThreadPool();
+		auto & general_threads	= resource_manager->GetGeneralThreads();
+		auto chunk_count		= size_t( 0 );
+		for( auto c : face_glyph_counts ) {
+			chunk_count			+= ( size_t( c ) + vk2d::_internal::FONT_GLYPH_RASTERIZATION_CHUNK_SIZE - 1 ) / vk2d::_internal::FONT_GLYPH_RASTERIZATION_CHUNK_SIZE;
+		}
+		auto helper_count		= chunk_count > 1 ? std::min( chunk_count - 1, general_threads.size() ) : size_t( 0 );
+		for( size_t i = 0; i < helper_count; ++i ) {
+			thread_pool->ScheduleTask(
+				std::make_unique<vk2d::_internal::GlyphRasterizationTask>( rasterization_job ),
+				general_threads
+			);
+		}
+		rasterization_job->Run();
+		rasterization_job->Wait();
+
+		if( auto message = rasterization_job->GetError() ) {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, message );
+			return false;
+		}
+		AddLoadTime( &vk2d::ResourceLoadTiming::glyph_rasterization_thread_total, rasterization_job->GetThreadTime() );
 	}
+	auto & rasterized_glyphs = rasterization_job->GetGlyphs();
+
+	// Get glyph sizes, in glyph order so the atlas is the same no matter which thread rendered what.
+	for( auto & face_glyphs : rasterized_glyphs ) {
+		for( auto & g : face_glyphs ) {
+			auto glyph_size =
+				vk2d::Vector2d(
+					double( g.metrics.width ),
+					double( g.metrics.height )
+				);
 
-	if( !total_glyph_count ) {
-		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot load font: Font contains no glyphs!" );
-		return false;
+			auto glyph_bitmap_size =
+				vk2d::Vector2d(
+					double( g.loaded_bitmap_size.x ),
+					double( g.loaded_bitmap_size.y )
+				);
+
+			auto glyph_bitmap_space_occupancy =
+				vk2d::Vector2d(
+					double( g.loaded_bitmap_size.x + glyph_atlas_padding ),
+					double( g.loaded_bitmap_size.y + glyph_atlas_padding )
+				);
+
+			maximum_glyph_size.x					= std::max( maximum_glyph_size.x, glyph_size.x );
+			maximum_glyph_size.y					= std::max( maximum_glyph_size.y, glyph_size.y );
+
+			maximum_glyph_bitmap_size.x				= std::max( maximum_glyph_bitmap_size.x, glyph_bitmap_size.x );
+			maximum_glyph_bitmap_size.y				= std::max( maximum_glyph_bitmap_size.y, glyph_bitmap_size.y );
+
+			maximum_glyph_bitmap_occupancy_size.x	= std::max( maximum_glyph_bitmap_occupancy_size.x, glyph_bitmap_space_occupancy.x );
+			maximum_glyph_bitmap_occupancy_size.y	= std::max( maximum_glyph_bitmap_occupancy_size.y, glyph_bitmap_space_occupancy.y );
+
+			average_glyph_bitmap_occupancy_size		+= glyph_bitmap_space_occupancy;
+		}
 	}
 
 	// Estimate appropriate atlas size.
@@ -417,110 +945,24 @@ bool vk2d::_internal::FontResourceImpl::MTLoad(
 		if( atlas_size < min_texture_size ) atlas_size = min_texture_size;
 	}
 
-	// Stop if we don't have any font's to work with.
-	if( !face_infos.size() ) {
-		instance->Report(
-			vk2d::ReportSeverity::NON_CRITICAL_ERROR,
-			std::string( "Internal error: Cannot load font: " ) + path_str
-		);
-		return false;
-	}
-
 	current_atlas_texture						= CreateNewAtlasTexture();
 
 	auto glyph_size_bitmap_size_ratio_vector	= maximum_glyph_bitmap_size / maximum_glyph_size;
 	auto glyph_size_bitmap_size_ratio			= std::max( glyph_size_bitmap_size_ratio_vector.x, glyph_size_bitmap_size_ratio_vector.y );
 
-	// Process all glyphs from all font faces
+	// Place all glyphs from all font faces
 	for( size_t face_index = 0; face_index < face_infos.size(); ++face_index ) {
 		auto & face = face_infos[ face_index ];
 		face.glyph_infos.resize( face.face->num_glyphs );
 
 		for( auto glyph_index = 0; glyph_index < face.face->num_glyphs; ++glyph_index ) {
-			{
-				auto ft_load_error = FT_Load_Glyph( face.face, glyph_index, FT_LOAD_DEFAULT );
-				if( ft_load_error ) {
-					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot load font, cannot load glyph!" );
-					return false;
-				}
-			}
-			{
-				auto ft_render_error = FT_Render_Glyph( face.face->glyph, use_alpha ? FT_RENDER_MODE_NORMAL : FT_RENDER_MODE_MONO );
-				if( ft_render_error ) {
-					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot load font, cannot render glyph!" );
-					return false;
-				}
-			}
-			auto	ft_glyph	= face.face->glyph;
-			auto &	ft_bitmap	= ft_glyph->bitmap;
-
-			std::vector<vk2d::Color8> final_glyph_pixels( size_t( ft_bitmap.rows ) * size_t( ft_bitmap.width ) );
-
-			switch( ft_bitmap.pixel_mode ) {
-				case FT_PIXEL_MODE_MONO:
-				{
-					for( uint32_t y = 0; y < ft_bitmap.rows; ++y ) {
-						for( uint32_t x = 0; x < ft_bitmap.width; ++x ) {
-							auto	texel_pos	= y * ft_bitmap.width + x;
-							auto &	dst			= final_glyph_pixels[ texel_pos ];
-							auto	src_bit		= 7 - x % 8;
-							auto	src_byte	= ft_bitmap.buffer[ ( y * ft_bitmap.pitch ) + ( x / 8 ) ];
-
-							dst.r				= ( ( src_byte >> src_bit ) & 1 ) * 255;
-							dst.g				= dst.r;
-							dst.b				= dst.r;
-							dst.a				= dst.r;
-						}
-					}
-				}
-				break;
-
-				case FT_PIXEL_MODE_GRAY:
-				{
-					for( uint32_t y = 0; y < ft_bitmap.rows; ++y ) {
-						for( uint32_t x = 0; x < ft_bitmap.width; ++x ) {
-							auto	texel_pos	= y * ft_bitmap.width + x;
-							auto &	dst			= final_glyph_pixels[ texel_pos ];
-							auto	src			= ft_bitmap.buffer[ texel_pos ];
-
-							dst.r				= src;
-							dst.g				= src;
-							dst.b				= src;
-							dst.a				= src;
-						}
-					}
-				}
-				break;
-
-				case FT_PIXEL_MODE_BGRA:
-				{
-					for( uint32_t y = 0; y < ft_bitmap.rows; ++y ) {
-						for( uint32_t x = 0; x < ft_bitmap.width; ++x ) {
-							auto	texel_pos	= y * ft_bitmap.width + x;
-							auto &	dst			= final_glyph_pixels[ texel_pos ];
-							auto	src			= &ft_bitmap.buffer[ texel_pos * 4 ];
-
-							dst.r				= src[ 2 ];
-							dst.g				= src[ 1 ];
-							dst.b				= src[ 0 ];
-							dst.a				= src[ 3 ];
-						}
-					}
-				}
-				break;
-
-				default:
-					// Unsupported
-					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot load font, Unsupported pixel format!" );
-					return false;
-					break;
-			}
+			auto & rasterized_glyph		= rasterized_glyphs[ face_index ][ glyph_index ];
 
 			// Attach rendered glyph to final texture atlas.
 			auto atlas_location			= AttachGlyphToAtlas(
-				face.face->glyph,
+				rasterized_glyph.bitmap_size,
 				glyph_atlas_padding,
-				final_glyph_pixels
+				rasterized_glyph.texels
 			);
 			if( !atlas_location.atlas_ptr ) {
 				instance->Report(
@@ -529,60 +971,17 @@ bool vk2d::_internal::FontResourceImpl::MTLoad(
 				);
 				return false;
 			}
+			std::vector<vk2d::Color8>().swap( rasterized_glyph.texels );
 
-			// Create glyph info structure for the glyph
-			{
-				vk2d::Rect2f uv_coords		= {
-					float( atlas_location.location.top_left.x ) / float( atlas_size ),
-					float( atlas_location.location.top_left.y ) / float( atlas_size ),
-					float( atlas_location.location.bottom_right.x ) / float( atlas_size ),
-					float( atlas_location.location.bottom_right.y ) / float( atlas_size )
-				};
-
-				auto & metrics								= face.face->glyph->metrics;
-				auto glyph_size								= vk2d::Vector2d( metrics.width, metrics.height ) * glyph_size_bitmap_size_ratio;
-				auto glyph_hori_top_left					= vk2d::Vector2d( metrics.horiBearingX, -metrics.horiBearingY ) * glyph_size_bitmap_size_ratio;
-				auto glyph_hori_bottom_right				= glyph_hori_top_left + glyph_size;
-				auto glyph_vert_top_left					= vk2d::Vector2d( metrics.vertBearingX, metrics.vertBearingY ) * glyph_size_bitmap_size_ratio;
-				auto glyph_vert_bottom_right				= glyph_vert_top_left + glyph_size;
-				auto hori_advance							= metrics.horiAdvance * glyph_size_bitmap_size_ratio;
-				auto vert_advance							= metrics.vertAdvance * glyph_size_bitmap_size_ratio;
-
-				vk2d::_internal::GlyphInfo glyph_info {};
-				glyph_info.face_index						= uint32_t( face_index );
-				glyph_info.atlas_index						= atlas_location.atlas_index;
-				glyph_info.uv_coords						= uv_coords;
-				glyph_info.horisontal_coords.top_left		= vk2d::Vector2f( float( glyph_hori_top_left.x ), float( glyph_hori_top_left.y ) );
-				glyph_info.horisontal_coords.bottom_right	= vk2d::Vector2f( float( glyph_hori_bottom_right.x ), float( glyph_hori_bottom_right.y ) );
-				glyph_info.vertical_coords.top_left			= vk2d::Vector2f( float( glyph_vert_top_left.x ), float( glyph_vert_top_left.y ) );
-				glyph_info.vertical_coords.bottom_right		= vk2d::Vector2f( float( glyph_vert_bottom_right.x ), float( glyph_vert_bottom_right.y ) );
-				glyph_info.horisontal_advance				= float( hori_advance );
-				glyph_info.vertical_advance					= float( vert_advance );
-
-				face.glyph_infos[ glyph_index ]				= glyph_info;
-			}
+			face.glyph_infos[ glyph_index ]		= CreateGlyphInfo(
+				uint32_t( face_index ),
+				atlas_location,
+				rasterized_glyph.metrics,
+				glyph_size_bitmap_size_ratio
+			);
 		}
 
-		// Create character map and get fallback character
-		{
-			FT_ULong		charcode				= {};
-			FT_UInt			gindex					= {};
-			FT_ULong		fallback_glyph_index	= {};
-
-			charcode				= FT_Get_First_Char( face.face, &gindex );
-			fallback_glyph_index	= gindex;
-			while( gindex != 0 ) {
-				face.charmap[ uint32_t( charcode ) ] = uint32_t( gindex );
-
-				charcode = FT_Get_Next_Char( face.face, charcode, &gindex );
-			}
-
-			if( auto f = FT_Get_Char_Index( face.face, FT_ULong( fallback_character ) ) ) {
-				fallback_glyph_index	= f;
-			}
-
-			face.fallback_glyph_index	= fallback_glyph_index;
-		}
+		CreateCharmap( face );
 	}
 
 	// Destroy font faces, we don't need them anymore.
@@ -590,23 +989,13 @@ bool vk2d::_internal::FontResourceImpl::MTLoad(
 		FT_Done_Face( f.face );
 		f.face		= nullptr;
 	}
+	AddLoadTime( &vk2d::ResourceLoadTiming::glyph_rasterization, glyph_rasterization_begin );
 
 	// Everything is baked into the atlas, create texture resource to store it.
-	{
-		std::vector<const std::vector<vk2d::Color8>*>		texture_data_array( atlas_textures.size() );
-		for( size_t i = 0; i < atlas_textures.size(); ++i ) {
-			texture_data_array[ i ]		= &atlas_textures[ i ]->data;
-		}
-
-		texture_resource = resource_manager->CreateArrayTextureResource(
-			vk2d::Vector2u( atlas_size, atlas_size ),
-			texture_data_array,
-			my_interface
-		);
-		if( !texture_resource ) {
-			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create font, cannot create texture resource for font!" );
-			return false;
-		}
+	texture_resource = CreateAtlasTextureResource();
+	if( !texture_resource ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create font, cannot create texture resource for font!" );
+		return false;
 	}
 
 	return true;
@@ -617,11 +1006,16 @@ void vk2d::_internal::FontResourceImpl::MTUnload(
 )
 {
 	// Make sure font faces are destroyed.
-	for( auto f : face_infos ) {
-		FT_Done_Face( f.face );
+	std::lock_guard<std::mutex> lock( on_demand_mutex );
+	for( auto & f : face_infos ) {
+		if( f.face ) FT_Done_Face( f.face );
 	}
 	face_infos.clear();
 
+	if( on_demand_library ) {
+		FT_Done_FreeType( on_demand_library );
+		on_demand_library	= nullptr;
+	}
 }
 
 vk2d::Rect2f vk2d::_internal::FontResourceImpl::CalculateRenderedSize(
@@ -707,16 +1101,22 @@ bool vk2d::_internal::FontResourceImpl::FaceExists(
 
 vk2d::TextureResource * vk2d::_internal::FontResourceImpl::GetTextureResource()
 {
-	if( GetStatus() == vk2d::ResourceStatus::LOADED ) {
-		return texture_resource;
+	if( GetStatus() != vk2d::ResourceStatus::LOADED ) return {};
+	if( !load_glyphs_on_demand ) return texture_resource;
+
+	// Texture updates can only be recorded on the main thread.
+	std::lock_guard<std::mutex> lock( on_demand_mutex );
+	UpdateAtlasTextureResource();
+	if( resource_manager->GetInstance()->IsThisThreadCreatorThread() ) {
+		UploadDirtyAtlasAreas();
 	}
-	return {};
+	return texture_resource;
 }
 
 const vk2d::_internal::GlyphInfo * vk2d::_internal::FontResourceImpl::GetGlyphInfo(
 	uint32_t		font_face,
 	uint32_t		character
-) const
+)
 {
 	auto & face_info	= face_infos[ font_face ];
 	auto & charmap		= face_info.charmap;
@@ -727,6 +1127,13 @@ const vk2d::_internal::GlyphInfo * vk2d::_internal::FontResourceImpl::GetGlyphIn
 	} else {
 		glyph_index		= face_info.fallback_glyph_index;
 	}
+	if( !load_glyphs_on_demand ) return &face_info.glyph_infos[ glyph_index ];
+
+	// Fallback glyphs are loaded with the font.
+	std::lock_guard<std::mutex> lock( on_demand_mutex );
+	if( !face_info.loaded_glyphs[ glyph_index ] && !LoadGlyphOnDemand( font_face, glyph_index ) ) {
+		glyph_index		= face_info.fallback_glyph_index;
+	}
 	return &face_info.glyph_infos[ glyph_index ];
 }
 
@@ -749,7 +1156,7 @@ vk2d::_internal::FontResourceImpl::AtlasTexture * vk2d::_internal::FontResourceI
 }
 
 vk2d::_internal::FontResourceImpl::AtlasLocation vk2d::_internal::FontResourceImpl::ReserveSpaceForGlyphFromAtlasTextures(
-	FT_GlyphSlot		glyph,
+	vk2d::Vector2u		glyph_size,
 	uint32_t			glyph_atlas_padding
 )
 {
@@ -757,13 +1164,13 @@ vk2d::_internal::FontResourceImpl::AtlasLocation vk2d::_internal::FontResourceIm
 
 	auto FindLocationInAtlasTexture =[](
 		vk2d::_internal::FontResourceImpl::AtlasTexture		*	atlas_texture,
-		FT_GlyphSlot											glyph,
+		vk2d::Vector2u											glyph_size,
 		uint32_t												atlas_size,
 		uint32_t												glyph_atlas_padding
 		) -> vk2d::_internal::FontResourceImpl::AtlasLocation
 	{
-		uint32_t glyph_width		= uint32_t( glyph->bitmap.width )	+ glyph_atlas_padding;
-		uint32_t glyph_height		= uint32_t( glyph->bitmap.rows )	+ glyph_atlas_padding;
+		uint32_t glyph_width		= glyph_size.x	+ glyph_atlas_padding;
+		uint32_t glyph_height		= glyph_size.y	+ glyph_atlas_padding;
 
 		// Find space in the current atlas texture.
 		if( atlas_texture->previous_row_height + glyph_height + glyph_atlas_padding < atlas_size ) {
@@ -781,7 +1188,7 @@ vk2d::_internal::FontResourceImpl::AtlasLocation vk2d::_internal::FontResourceIm
 				};
 				new_glyph_location.location.bottom_right	=
 					new_glyph_location.location.top_left	+
-					vk2d::Vector2u( uint32_t( glyph->bitmap.width ), uint32_t( glyph->bitmap.rows ) );
+					glyph_size;
 
 				// update current row height and write locations before returning the result.
 				atlas_texture->current_row_height			= std::max( atlas_texture->current_row_height, glyph_height );
@@ -811,7 +1218,7 @@ vk2d::_internal::FontResourceImpl::AtlasLocation vk2d::_internal::FontResourceIm
 					};
 					new_glyph_location.location.bottom_right	=
 						new_glyph_location.location.top_left	+
-						vk2d::Vector2u( uint32_t( glyph->bitmap.width ), uint32_t( glyph->bitmap.rows ) );
+						glyph_size;
 
 					// update current row height and write locations before returning the result.
 					atlas_texture->current_row_height		= std::max( atlas_texture->current_row_height, glyph_height );
@@ -836,7 +1243,7 @@ vk2d::_internal::FontResourceImpl::AtlasLocation vk2d::_internal::FontResourceIm
 
 	auto new_location = FindLocationInAtlasTexture(
 		current_atlas_texture,
-		glyph,
+		glyph_size,
 		atlas_size,
 		glyph_atlas_padding
 	);
@@ -853,7 +1260,7 @@ vk2d::_internal::FontResourceImpl::AtlasLocation vk2d::_internal::FontResourceIm
 		// Got new atlas texture, retry finding space in it.
 		new_location	= FindLocationInAtlasTexture(
 			current_atlas_texture,
-			glyph,
+			glyph_size,
 			atlas_size,
 			glyph_atlas_padding
 		);
@@ -889,12 +1296,12 @@ void vk2d::_internal::FontResourceImpl::CopyGlyphTextureToAtlasLocation(
 }
 
 vk2d::_internal::FontResourceImpl::AtlasLocation vk2d::_internal::FontResourceImpl::AttachGlyphToAtlas(
-	FT_GlyphSlot							glyph,
+	vk2d::Vector2u							glyph_size,
 	uint32_t								glyph_atlas_padding,
 	const std::vector<vk2d::Color8>		&	converted_texture_data )
 {
 	auto atlas_location = ReserveSpaceForGlyphFromAtlasTextures(
-		glyph,
+		glyph_size,
 		glyph_atlas_padding
 	);
 	if( atlas_location.atlas_ptr ) {
@@ -909,6 +1316,227 @@ vk2d::_internal::FontResourceImpl::AtlasLocation vk2d::_internal::FontResourceIm
 	}
 }
 
+vk2d::_internal::GlyphInfo vk2d::_internal::FontResourceImpl::CreateGlyphInfo(
+	uint32_t								face_index,
+	AtlasLocation							atlas_location,
+	const FT_Glyph_Metrics				&	metrics,
+	double									glyph_size_bitmap_size_ratio
+) const
+{
+	vk2d::Rect2f uv_coords		= {
+		float( atlas_location.location.top_left.x ) / float( atlas_size ),
+		float( atlas_location.location.top_left.y ) / float( atlas_size ),
+		float( atlas_location.location.bottom_right.x ) / float( atlas_size ),
+		float( atlas_location.location.bottom_right.y ) / float( atlas_size )
+	};
+
+	auto glyph_size								= vk2d::Vector2d( metrics.width, metrics.height ) * glyph_size_bitmap_size_ratio;
+	auto glyph_hori_top_left					= vk2d::Vector2d( metrics.horiBearingX, -metrics.horiBearingY ) * glyph_size_bitmap_size_ratio;
+	auto glyph_hori_bottom_right				= glyph_hori_top_left + glyph_size;
+	auto glyph_vert_top_left					= vk2d::Vector2d( metrics.vertBearingX, metrics.vertBearingY ) * glyph_size_bitmap_size_ratio;
+	auto glyph_vert_bottom_right				= glyph_vert_top_left + glyph_size;
+	auto hori_advance							= metrics.horiAdvance * glyph_size_bitmap_size_ratio;
+	auto vert_advance							= metrics.vertAdvance * glyph_size_bitmap_size_ratio;
+
+	vk2d::_internal::GlyphInfo glyph_info {};
+	glyph_info.face_index						= face_index;
+	glyph_info.atlas_index						= atlas_location.atlas_index;
+	glyph_info.uv_coords						= uv_coords;
+	glyph_info.horisontal_coords.top_left		= vk2d::Vector2f( float( glyph_hori_top_left.x ), float( glyph_hori_top_left.y ) );
+	glyph_info.horisontal_coords.bottom_right	= vk2d::Vector2f( float( glyph_hori_bottom_right.x ), float( glyph_hori_bottom_right.y ) );
+	glyph_info.vertical_coords.top_left			= vk2d::Vector2f( float( glyph_vert_top_left.x ), float( glyph_vert_top_left.y ) );
+	glyph_info.vertical_coords.bottom_right		= vk2d::Vector2f( float( glyph_vert_bottom_right.x ), float( glyph_vert_bottom_right.y ) );
+	glyph_info.horisontal_advance				= float( hori_advance );
+	glyph_info.vertical_advance					= float( vert_advance );
+	return glyph_info;
+}
+
+void vk2d::_internal::FontResourceImpl::CreateCharmap(
+	FaceInfo							&	face_info
+)
+{
+	FT_ULong		charcode				= {};
+	FT_UInt			gindex					= {};
+	FT_ULong		fallback_glyph_index	= {};
+
+	charcode				= FT_Get_First_Char( face_info.face, &gindex );
+	fallback_glyph_index	= gindex;
+	while( gindex != 0 ) {
+		face_info.charmap[ uint32_t( charcode ) ] = uint32_t( gindex );
+
+		charcode = FT_Get_Next_Char( face_info.face, charcode, &gindex );
+	}
+
+	if( auto f = FT_Get_Char_Index( face_info.face, FT_ULong( fallback_character ) ) ) {
+		fallback_glyph_index	= f;
+	}
+
+	face_info.fallback_glyph_index	= uint32_t( fallback_glyph_index );
+}
+
+vk2d::TextureResource * vk2d::_internal::FontResourceImpl::CreateAtlasTextureResource()
+{
+	std::vector<const std::vector<vk2d::Color8>*>		texture_data_array( atlas_textures.size() );
+	for( size_t i = 0; i < atlas_textures.size(); ++i ) {
+		texture_data_array[ i ]		= &atlas_textures[ i ]->data;
+	}
+
+	auto new_texture_resource = resource_manager->CreateArrayTextureResource(
+		vk2d::Vector2u( atlas_size, atlas_size ),
+		texture_data_array,
+		my_interface
+	);
+	if( !new_texture_resource ) return nullptr;
+
+	// New texture contains everything rendered so far.
+	for( auto & a : atlas_textures ) {
+		a->is_dirty					= false;
+	}
+	return new_texture_resource;
+}
+
+bool vk2d::_internal::FontResourceImpl::LoadGlyphOnDemand(
+	uint32_t								face_index,
+	uint32_t								glyph_index
+)
+{
+	auto instance		= resource_manager->GetInstance();
+	auto & face_info	= face_infos[ face_index ];
+
+	vk2d::_internal::RasterizedGlyph rasterized_glyph {};
+	if( auto message = vk2d::_internal::RasterizeGlyph( face_info.face, FT_UInt( glyph_index ), use_alpha, rasterized_glyph ) ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, message );
+		return false;
+	}
+
+	auto atlas_location = AttachGlyphToAtlas(
+		rasterized_glyph.bitmap_size,
+		glyph_atlas_padding,
+		rasterized_glyph.texels
+	);
+	if( !atlas_location.atlas_ptr ) return false;
+
+	// Empty glyphs, like space, have nothing to upload.
+	auto & atlas		= *atlas_location.atlas_ptr;
+	auto & location		= atlas_location.location;
+	if( rasterized_glyph.bitmap_size.x && rasterized_glyph.bitmap_size.y ) {
+		if( atlas.is_dirty ) {
+			atlas.dirty_area.top_left.x		= std::min( atlas.dirty_area.top_left.x, location.top_left.x );
+			atlas.dirty_area.top_left.y		= std::min( atlas.dirty_area.top_left.y, location.top_left.y );
+			atlas.dirty_area.bottom_right.x	= std::max( atlas.dirty_area.bottom_right.x, location.bottom_right.x );
+			atlas.dirty_area.bottom_right.y	= std::max( atlas.dirty_area.bottom_right.y, location.bottom_right.y );
+		} else {
+			atlas.dirty_area				= location;
+			atlas.is_dirty					= true;
+		}
+	}
+
+	// Glyph metrics are in 26.6 fixed point, rendered bitmaps are in whole texels.
+	face_info.glyph_infos[ glyph_index ]	= CreateGlyphInfo(
+		face_index,
+		atlas_location,
+		rasterized_glyph.metrics,
+		1.0 / 64.0
+	);
+	face_info.loaded_glyphs[ glyph_index ]	= true;
+
+	// Glyph may have gone to a page the texture doesn't have yet.
+	// Not while loading, the texture is created after preloading.
+	if( texture_resource ) {
+		UpdateAtlasTextureResource();
+	}
+	return true;
+}
+
+void vk2d::_internal::FontResourceImpl::UpdateAtlasTextureResource()
+{
+	auto instance = resource_manager->GetInstance();
+
+	// Text keeps using the current texture until the larger one is loaded,
+	// glyphs added in the meantime stay dirty and UploadDirtyAtlasAreas()
+	// uploads them to the larger one after that.
+	if( pending_texture_resource ) {
+		auto pending_status = pending_texture_resource->GetStatus();
+		if( pending_status == vk2d::ResourceStatus::UNDETERMINED ) return;
+
+		if( pending_status == vk2d::ResourceStatus::LOADED ) {
+			RetiredTextureResource retired {};
+			retired.texture_resource		= texture_resource;
+			retired.retired_epoch			= resource_manager->GetRetiredImageEpoch();
+			retired_texture_resources.push_back( retired );
+			resource_manager->RequestRetiredImageEpoch();
+
+			texture_resource				= pending_texture_resource;
+			texture_resource_layer_count	= pending_texture_resource_layer_count;
+		} else {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot add glyphs to font, cannot create larger texture resource for font!" );
+			DestroySubresource( pending_texture_resource );
+
+			// Glyphs only the failed texture got are uploaded to the current one instead.
+			for( auto & a : atlas_textures ) {
+				if( a->index >= texture_resource_layer_count ) continue;
+				a->dirty_area	= vk2d::Rect2u( 0, 0, atlas_size, atlas_size );
+				a->is_dirty		= true;
+			}
+		}
+		pending_texture_resource				= nullptr;
+		pending_texture_resource_layer_count	= 0;
+	}
+
+	// Frames submitted before the epoch a texture was retired in may still use it.
+	if( !retired_texture_resources.empty() ) {
+		auto completed_epoch = resource_manager->GetCompletedRetiredImageEpoch();
+		auto it = std::remove_if(
+			retired_texture_resources.begin(),
+			retired_texture_resources.end(),
+			[ this, completed_epoch ]( const RetiredTextureResource & r )
+			{
+				if( r.retired_epoch >= completed_epoch ) return false;
+				DestroySubresource( r.texture_resource );
+				return true;
+			}
+		);
+		retired_texture_resources.erase( it, retired_texture_resources.end() );
+	}
+
+	// Glyphs went to a page the texture doesn't have yet.
+	if( texture_resource_layer_count < uint32_t( atlas_textures.size() ) ) {
+		pending_texture_resource = CreateAtlasTextureResource();
+		if( !pending_texture_resource ) {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot add glyphs to font, cannot create larger texture resource for font!" );
+			return;
+		}
+		pending_texture_resource_layer_count	= uint32_t( atlas_textures.size() );
+	}
+}
+
+void vk2d::_internal::FontResourceImpl::UploadDirtyAtlasAreas()
+{
+	// The larger texture copied the atlas when it was created, anything
+	// uploaded to the current texture now would be missing from it.
+	if( pending_texture_resource ) return;
+
+	for( auto & a : atlas_textures ) {
+		if( !a->is_dirty ) continue;
+		if( a->index >= texture_resource_layer_count ) continue;
+
+		auto area_size		= a->dirty_area.bottom_right - a->dirty_area.top_left;
+		std::vector<vk2d::Color8> texels( size_t( area_size.x ) * size_t( area_size.y ) );
+		for( uint32_t y = 0; y < area_size.y; ++y ) {
+			std::memcpy(
+				texels.data() + size_t( y ) * area_size.x,
+				a->data.data() + size_t( a->dirty_area.top_left.y + y ) * atlas_size + a->dirty_area.top_left.x,
+				size_t( area_size.x ) * sizeof( vk2d::Color8 )
+			);
+		}
+
+		// Stays dirty if the update failed, tried again next time.
+		if( texture_resource->UpdateRegion( a->dirty_area, a->index, texels ) ) {
+			a->is_dirty		= false;
+		}
+	}
+}
+
 
 
 
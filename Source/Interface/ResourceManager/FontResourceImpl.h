@@ -47,7 +47,24 @@ public:
 		uint32_t										glyph_texel_size,
 		bool											use_alpha,
 		uint32_t										fallback_character,
-		uint32_t										glyph_atlas_padding );
+		uint32_t										glyph_atlas_padding,
+		bool											load_glyphs_on_demand,
+		std::string_view								preload_characters );
+
+	// Font file in memory is owned by the caller and must stay valid until loaded.
+	FontResourceImpl(
+		vk2d::FontResource							*	my_interface,
+		vk2d::_internal::ResourceManagerImpl		*	resource_manager,
+		uint32_t										loader_thread,
+		vk2d::Resource								*	parent_resource,
+		const void									*	font_file_data,
+		size_t											font_file_size,
+		uint32_t										glyph_texel_size,
+		bool											use_alpha,
+		uint32_t										fallback_character,
+		uint32_t										glyph_atlas_padding,
+		bool											load_glyphs_on_demand,
+		std::string_view								preload_characters );
 
 	~FontResourceImpl();
 
@@ -76,11 +93,15 @@ public:
 	bool																					FaceExists(
 		uint32_t										font_face ) const;
 
+	// If glyphs are loaded on demand and this is the main thread, uploads
+	// glyphs added since the last call before returning the texture.
 	vk2d::TextureResource							*										GetTextureResource();
 
+	// If glyphs are loaded on demand, renders the glyph into the atlas if it
+	// isn't there yet. Returned pointer stays valid until the font is destroyed.
 	const vk2d::_internal::GlyphInfo				*										GetGlyphInfo(
 		uint32_t										font_face,
-		uint32_t										character ) const;
+		uint32_t										character );
 
 	bool																					IsGood() const;
 
@@ -91,6 +112,8 @@ private:
 		uint32_t										previous_row_height					= {};
 		uint32_t										current_row_height					= {};
 		uint32_t										current_write_location				= {};
+		vk2d::Rect2u									dirty_area							= {};	// Area not uploaded yet, glyphs loaded on demand only.
+		bool											is_dirty							= {};
 	};
 	struct AtlasLocation {
 		AtlasTexture								*	atlas_ptr							= {};
@@ -102,12 +125,17 @@ private:
 		std::vector<vk2d::_internal::GlyphInfo>			glyph_infos							= {};
 		std::map<int32_t, int32_t>						charmap								= {};	// link character to a GlyphInfo vector
 		uint32_t										fallback_glyph_index				= {};
+		std::vector<bool>								loaded_glyphs						= {};	// Glyphs in the atlas, glyphs loaded on demand only.
+	};
+	struct RetiredTextureResource {
+		vk2d::TextureResource						*	texture_resource					= {};
+		uint64_t										retired_epoch						= {};	// See ResourceManagerImpl::GetRetiredImageEpoch().
 	};
 
 	AtlasTexture									*										CreateNewAtlasTexture();
 
 	AtlasLocation																			ReserveSpaceForGlyphFromAtlasTextures(
-		FT_GlyphSlot									glyph,
+		vk2d::Vector2u									glyph_size,
 		uint32_t										glyph_atlas_padding );
 
 	void																					CopyGlyphTextureToAtlasLocation(
@@ -116,10 +144,36 @@ private:
 
 	// Does everything.
 	AtlasLocation																			AttachGlyphToAtlas(
-		FT_GlyphSlot									glyph,
+		vk2d::Vector2u									glyph_size,
 		uint32_t										glyph_atlas_padding,
 		const std::vector<vk2d::Color8>				&	converted_texture_data );
 
+	vk2d::_internal::GlyphInfo																CreateGlyphInfo(
+		uint32_t										face_index,
+		AtlasLocation									atlas_location,
+		const FT_Glyph_Metrics						&	metrics,
+		double											glyph_size_bitmap_size_ratio ) const;
+
+	void																					CreateCharmap(
+		FaceInfo									&	face_info );
+
+	vk2d::TextureResource							*										CreateAtlasTextureResource();
+
+	// Glyphs loaded on demand only, on_demand_mutex must be locked after loading.
+	bool																					LoadGlyphOnDemand(
+		uint32_t										face_index,
+		uint32_t										glyph_index );
+
+	// Glyphs loaded on demand only, on_demand_mutex must be locked after loading.
+	// Starts loading a larger texture if the atlas has pages the texture doesn't
+	// have, switches to it once it's loaded and destroys replaced textures once
+	// frames that could use them are done. Never waits.
+	void																					UpdateAtlasTextureResource();
+
+	// Glyphs loaded on demand only, on_demand_mutex must be locked. Does
+	// nothing while a larger texture is loading, pages stay dirty until then.
+	void																					UploadDirtyAtlasAreas();
+
 	vk2d::FontResource								*	my_interface						= {};
 	vk2d::_internal::ResourceManagerImpl			*	resource_manager					= {};
 
@@ -127,6 +181,8 @@ private:
 	uint32_t											glyph_texel_size					= {};
 	uint32_t											glyph_atlas_padding					= {};
 	uint32_t											fallback_character					= {};
+	bool												load_glyphs_on_demand				= {};
+	std::string											preload_characters					= {};
 
 	uint32_t											atlas_size							= {};
 
@@ -136,6 +192,19 @@ private:
 
 	vk2d::TextureResource							*	texture_resource					= {};
 
+	// Glyphs loaded on demand keep the faces open with a FreeType library of
+	// their own, glyphs can be requested from any thread. Faces, atlas textures,
+	// glyph infos and texture resources are guarded by on_demand_mutex after
+	// loading. When the atlas grows the current texture is used until the larger
+	// one is loaded, replaced textures are retired like replaced texture images.
+	FT_Library											on_demand_library					= {};
+	std::vector<uint8_t>								on_demand_font_file					= {};	// Copy of a font file in memory.
+	uint32_t											texture_resource_layer_count		= {};
+	vk2d::TextureResource							*	pending_texture_resource			= {};
+	uint32_t											pending_texture_resource_layer_count	= {};
+	std::vector<RetiredTextureResource>					retired_texture_resources			= {};
+	std::mutex											on_demand_mutex;
+
 	bool												is_good								= {};
 };
 
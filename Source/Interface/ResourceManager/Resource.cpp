@@ -68,6 +68,12 @@ VK2D_API const std::vector<std::filesystem::path>&VK2D_APIENTRY vk2d::Resource::
 	return resource_impl->GetFilePaths();
 }
 
+VK2D_API vk2d::ResourceLoadTiming VK2D_APIENTRY vk2d::Resource::GetLoadTiming() const
+{
+	assert( resource_impl );
+	return resource_impl->GetLoadTiming();
+}
+
 VK2D_API bool VK2D_APIENTRY vk2d::Resource::IsGood() const
 {
 	if( !resource_impl ) return false;
@@ -133,6 +139,30 @@ vk2d::_internal::ResourceImpl::ResourceImpl(
 	}
 }
 
+vk2d::_internal::ResourceImpl::ResourceImpl(
+	vk2d::Resource								*	my_interface,
+	uint32_t										loader_thread,
+	vk2d::_internal::ResourceManagerImpl		*	resource_manager,
+	vk2d::Resource								*	parent_resource,
+	const void									*	memory_data,
+	size_t											memory_size
+)
+{
+	this->my_interface		= my_interface;
+	this->loader_thread		= loader_thread;
+	this->resource_manager	= resource_manager;
+	this->parent_resource	= parent_resource;
+	this->file_paths		= {};
+	this->is_from_file		= false;
+	this->is_from_memory	= true;
+	this->memory_data		= memory_data;
+	this->memory_size		= memory_size;
+
+	if( this->parent_resource ) {
+		this->parent_resource->resource_impl->AddSubresource( my_interface );
+	}
+}
+
 void vk2d::_internal::ResourceImpl::DestroySubresources()
 {
 	std::lock_guard<std::mutex> lock_guard( subresources_mutex );
@@ -153,6 +183,21 @@ void vk2d::_internal::ResourceImpl::AddSubresource(
 	subresources.push_back( subresource );
 }
 
+void vk2d::_internal::ResourceImpl::DestroySubresource(
+	vk2d::Resource			*	subresource
+)
+{
+	{
+		std::lock_guard<std::mutex> lock_guard( subresources_mutex );
+
+		auto it = std::find( subresources.begin(), subresources.end(), subresource );
+		if( it == subresources.end() ) return;
+		subresources.erase( it );
+	}
+	subresource->resource_impl->DestroySubresources();
+	resource_manager->DestroyResource( subresource );
+}
+
 vk2d::Resource * VK2D_APIENTRY vk2d::_internal::ResourceImpl::GetParentResource()
 {
 	return parent_resource;
@@ -173,6 +218,103 @@ const std::vector<std::filesystem::path> & vk2d::_internal::ResourceImpl::GetFil
 	return file_paths;
 }
 
+bool vk2d::_internal::ResourceImpl::IsFromMemory() const
+{
+	return is_from_memory;
+}
+
+const void * vk2d::_internal::ResourceImpl::GetMemoryData() const
+{
+	return memory_data;
+}
+
+size_t vk2d::_internal::ResourceImpl::GetMemorySize() const
+{
+	return memory_size;
+}
+
+vk2d::ResourceLoadTiming vk2d::_internal::ResourceImpl::GetLoadTiming() const
+{
+	std::lock_guard<std::mutex> load_timing_lock( load_timing_mutex );
+	return load_timing;
+}
+
+bool vk2d::_internal::ResourceImpl::GetLoadTimeRange(
+	std::chrono::steady_clock::time_point		&	out_begin,
+	std::chrono::steady_clock::time_point		&	out_end
+) const
+{
+	std::lock_guard<std::mutex> load_timing_lock( load_timing_mutex );
+	if( !is_load_timing_finished ) return false;
+	out_begin	= load_scheduled_time;
+	out_end		= load_finished_time;
+	return true;
+}
+
+void vk2d::_internal::ResourceImpl::MarkLoadScheduled()
+{
+	std::lock_guard<std::mutex> load_timing_lock( load_timing_mutex );
+	load_scheduled_time		= std::chrono::steady_clock::now();
+}
+
+void vk2d::_internal::ResourceImpl::MarkLoadStarted()
+{
+	auto now = std::chrono::steady_clock::now();
+
+	std::lock_guard<std::mutex> load_timing_lock( load_timing_mutex );
+	load_timing.queue_wait	= std::chrono::duration_cast<std::chrono::nanoseconds>( now - load_scheduled_time );
+}
+
+void vk2d::_internal::ResourceImpl::AddLoadTime(
+	std::chrono::nanoseconds vk2d::ResourceLoadTiming::	*	phase,
+	std::chrono::steady_clock::time_point					phase_begin
+)
+{
+	AddLoadTime( phase, std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - phase_begin ) );
+}
+
+void vk2d::_internal::ResourceImpl::AddLoadTime(
+	std::chrono::nanoseconds vk2d::ResourceLoadTiming::	*	phase,
+	std::chrono::nanoseconds								duration
+)
+{
+	std::lock_guard<std::mutex> load_timing_lock( load_timing_mutex );
+	if( is_load_timing_finished ) return;
+	load_timing.*phase += duration;
+}
+
+void vk2d::_internal::ResourceImpl::AddLoadBytes(
+	uint64_t vk2d::ResourceLoadTiming::					*	counter,
+	uint64_t												bytes
+)
+{
+	std::lock_guard<std::mutex> load_timing_lock( load_timing_mutex );
+	if( is_load_timing_finished ) return;
+	load_timing.*counter += bytes;
+}
+
+void vk2d::_internal::ResourceImpl::MarkLoadSubmitted()
+{
+	std::lock_guard<std::mutex> load_timing_lock( load_timing_mutex );
+	if( is_load_timing_finished ) return;
+	load_submitted_time		= std::chrono::steady_clock::now();
+	is_load_submitted		= true;
+}
+
+void vk2d::_internal::ResourceImpl::FinishLoadTiming()
+{
+	auto now = std::chrono::steady_clock::now();
+
+	std::lock_guard<std::mutex> load_timing_lock( load_timing_mutex );
+	if( is_load_timing_finished ) return;
+	is_load_timing_finished		= true;
+	load_finished_time			= now;
+	if( is_load_submitted ) {
+		load_timing.gpu_upload	= std::chrono::duration_cast<std::chrono::nanoseconds>( now - load_submitted_time );
+	}
+	load_timing.total			= std::chrono::duration_cast<std::chrono::nanoseconds>( now - load_scheduled_time );
+}
+
 bool vk2d::_internal::ResourceImpl::IsSubResource() const
 {
 	return !!parent_resource;
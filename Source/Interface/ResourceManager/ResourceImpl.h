@@ -6,6 +6,8 @@
 
 #include "Types/Synchronization.hpp"
 
+#include "System/SlotMap.hpp"
+
 
 
 namespace vk2d {
@@ -45,6 +47,15 @@ public:
 		vk2d::Resource									*	parent_resource,
 		const std::vector<std::filesystem::path>		&	paths );
 
+	// Memory is owned by the caller, it's not copied.
+															ResourceImpl(
+		vk2d::Resource									*	my_interface,
+		uint32_t											loader_thread,
+		vk2d::_internal::ResourceManagerImpl			*	resource_manager,
+		vk2d::Resource									*	parent_resource,
+		const void										*	memory_data,
+		size_t												memory_size );
+
 	virtual													~ResourceImpl()					= default;
 
 	// Checks the status of the resource.
@@ -71,6 +82,13 @@ protected:
 	virtual void											MTUnload(
 		vk2d::_internal::ThreadPrivateResource			*	thread_resource )				= 0;
 
+	// Return false if MTUnload() can run in any loader thread, resources that give thread
+	// owned objects back with deferred frees do not need to unload in their loader thread.
+	virtual bool											IsUnloadLockedToLoaderThread() const
+	{
+		return true;
+	}
+
 private:
 	// Internal use only.
 	// If the resource creates any subresources, they must NOT be manually destroyed.
@@ -98,6 +116,48 @@ public:
 	// if the was not loaded from a file, returns "".
 	const std::vector<std::filesystem::path>			&	GetFilePaths() const;
 
+	// Checks if the resource is loaded from caller owned memory, for example
+	// an encoded image or font file that is already in memory.
+	bool													IsFromMemory() const;
+
+	// Returns the memory the resource is loaded from, nullptr and 0 if the
+	// resource is not loaded from memory.
+	const void											*	GetMemoryData() const;
+	size_t													GetMemorySize() const;
+
+	// Load timing, see vk2d::Resource::GetLoadTiming(). Timing is recorded
+	// until FinishLoadTiming() is called, later calls are ignored.
+	vk2d::ResourceLoadTiming								GetLoadTiming() const;
+
+	// Gets when the load was scheduled and when it finished, returns false
+	// if the resource hasn't finished loading yet.
+	bool													GetLoadTimeRange(
+		std::chrono::steady_clock::time_point			&	out_begin,
+		std::chrono::steady_clock::time_point			&	out_end ) const;
+
+	void													MarkLoadScheduled();
+	void													MarkLoadStarted();
+
+	// Adds time since phase_begin to a phase.
+	void													AddLoadTime(
+		std::chrono::nanoseconds vk2d::ResourceLoadTiming::	*	phase,
+		std::chrono::steady_clock::time_point				phase_begin );
+
+	// Adds a duration measured elsewhere to a phase, eg. in another thread.
+	void													AddLoadTime(
+		std::chrono::nanoseconds vk2d::ResourceLoadTiming::	*	phase,
+		std::chrono::nanoseconds							duration );
+
+	void													AddLoadBytes(
+		uint64_t vk2d::ResourceLoadTiming::				*	counter,
+		uint64_t											bytes );
+
+	// GPU work of the load was submitted, time until FinishLoadTiming() is GPU upload time.
+	void													MarkLoadSubmitted();
+
+	// Call when the resource status is determined.
+	void													FinishLoadTiming();
+
 	virtual bool											IsGood() const						= 0;
 
 protected:
@@ -106,6 +166,11 @@ protected:
 	// true then resource manager should not delete this resource directly.
 	bool													IsSubResource() const;
 
+	// Destroys one of our subresources before we're destroyed, eg. one that was
+	// replaced by a newer one. Subresource must not be used after this.
+	void													DestroySubresource(
+		vk2d::Resource									*	subresource );
+
 	vk2d::_internal::Fence									load_function_run_fence;
 	std::atomic<vk2d::ResourceStatus>						status								= {};
 	vk2d::Resource										*	my_interface						= {};
@@ -113,11 +178,25 @@ protected:
 private:
 	vk2d::_internal::ResourceManagerImpl				*	resource_manager					= {};
 	uint32_t												loader_thread						= {};
+	uint64_t												load_cost							= {};	// Estimated, see ResourceManagerImpl::SelectLoaderThread().
 	std::vector<std::filesystem::path>						file_paths							= {};
 	std::mutex												subresources_mutex;
 	std::vector<vk2d::Resource*>							subresources						= {};
 	vk2d::Resource										*	parent_resource						= {};
 	bool													is_from_file						= {};
+	bool													is_from_memory						= {};
+	const void											*	memory_data							= {};	// Caller owned, valid only until loaded.
+	size_t													memory_size							= {};
+	vk2d::_internal::SlotMapHandle							resource_handle						= {};	// Handle in resource manager, set when attached.
+	std::string												cache_key							= {};	// Empty if resource is not shared through the resource cache.
+
+	mutable std::mutex										load_timing_mutex;
+	vk2d::ResourceLoadTiming								load_timing							= {};
+	std::chrono::steady_clock::time_point					load_scheduled_time					= {};
+	std::chrono::steady_clock::time_point					load_submitted_time					= {};
+	std::chrono::steady_clock::time_point					load_finished_time					= {};
+	bool													is_load_submitted					= {};
+	bool													is_load_timing_finished				= {};
 };
 
 
@@ -2,6 +2,9 @@
 #include "Core/SourceCommon.h"
 
 #include "System/ThreadPool.h"
+#include "System/ThreadPrivateResources.h"
+#include "System/CommonTools.h"
+#include "System/TextureUploadBatch.h"
 
 #include "Interface/InstanceImpl.h"
 
@@ -12,9 +15,12 @@
 #include "Interface/ResourceManager/ResourceImpl.h"
 
 #include "Interface/ResourceManager/TextureResource.h"
+#include "Interface/ResourceManager/TextureResourceImpl.h"
 
 #include "Interface/ResourceManager/FontResource.h"
 
+#include <iomanip>
+
 
 
 
@@ -75,6 +81,29 @@ VK2D_API vk2d::TextureResource * VK2D_APIENTRY vk2d::ResourceManager::LoadTextur
 	);
 }
 
+VK2D_API vk2d::TextureResource * VK2D_APIENTRY vk2d::ResourceManager::LoadTextureResourceFromMemory(
+	const void						*	encoded_image_data,
+	size_t								encoded_image_size
+)
+{
+	return impl->LoadTextureResourceFromMemory(
+		encoded_image_data,
+		encoded_image_size,
+		nullptr
+	);
+}
+
+VK2D_API std::vector<vk2d::TextureResource*> VK2D_APIENTRY vk2d::ResourceManager::LoadTextureResources(
+	const std::vector<std::filesystem::path>						&	file_paths,
+	std::function<void( const vk2d::TextureBatchLoadProgress & )>		progress_callback
+)
+{
+	return impl->LoadTextureResources(
+		file_paths,
+		std::move( progress_callback )
+	);
+}
+
 VK2D_API vk2d::TextureResource * VK2D_APIENTRY vk2d::ResourceManager::CreateArrayTextureResource(
 	vk2d::Vector2u											size,
 	const std::vector<const std::vector<vk2d::Color8>*>	&	texels_listing
@@ -102,7 +131,9 @@ VK2D_API vk2d::FontResource * VK2D_APIENTRY vk2d::ResourceManager::LoadFontResou
 	uint32_t							glyph_texel_size,
 	bool								use_alpha,
 	uint32_t							fallback_character,
-	uint32_t							glyph_atlas_padding
+	uint32_t							glyph_atlas_padding,
+	bool								load_glyphs_on_demand,
+	std::string_view					preload_characters
 )
 {
 	return impl->LoadFontResource(
@@ -111,7 +142,42 @@ VK2D_API vk2d::FontResource * VK2D_APIENTRY vk2d::ResourceManager::LoadFontResou
 		glyph_texel_size,
 		use_alpha,
 		fallback_character,
-		glyph_atlas_padding
+		glyph_atlas_padding,
+		load_glyphs_on_demand,
+		preload_characters
+	);
+}
+
+VK2D_API vk2d::FontResource * VK2D_APIENTRY vk2d::ResourceManager::LoadFontResourceFromMemory(
+	const void						*	font_file_data,
+	size_t								font_file_size,
+	uint32_t							glyph_texel_size,
+	bool								use_alpha,
+	uint32_t							fallback_character,
+	uint32_t							glyph_atlas_padding,
+	bool								load_glyphs_on_demand,
+	std::string_view					preload_characters
+)
+{
+	return impl->LoadFontResourceFromMemory(
+		font_file_data,
+		font_file_size,
+		nullptr,
+		glyph_texel_size,
+		use_alpha,
+		fallback_character,
+		glyph_atlas_padding,
+		load_glyphs_on_demand,
+		preload_characters
+	);
+}
+
+VK2D_API bool VK2D_APIENTRY vk2d::ResourceManager::MountAssetPack(
+	const std::filesystem::path		&	pack_path
+)
+{
+	return impl->MountAssetPack(
+		pack_path
 	);
 }
 
@@ -122,6 +188,60 @@ VK2D_API void VK2D_APIENTRY vk2d::ResourceManager::DestroyResource(
 	impl->DestroyResource( resource );
 }
 
+VK2D_API void VK2D_APIENTRY vk2d::ResourceManager::DefragmentMemory(
+	uint64_t			byte_budget
+)
+{
+	impl->DefragmentMemory( byte_budget );
+}
+
+VK2D_API vk2d::MemoryDefragmentationReport VK2D_APIENTRY vk2d::ResourceManager::GetMemoryDefragmentationReport() const
+{
+	return impl->GetMemoryDefragmentationReport();
+}
+
+VK2D_API void VK2D_APIENTRY vk2d::ResourceManager::SetTextureResidencyBudget(
+	uint64_t			byte_budget,
+	uint32_t			placeholder_size
+)
+{
+	impl->SetTextureResidencyBudget( byte_budget, placeholder_size );
+}
+
+VK2D_API void VK2D_APIENTRY vk2d::ResourceManager::UpdateTextureResidency()
+{
+	impl->UpdateTextureResidency();
+}
+
+VK2D_API vk2d::TextureResidencyReport VK2D_APIENTRY vk2d::ResourceManager::GetTextureResidencyReport() const
+{
+	return impl->GetTextureResidencyReport();
+}
+
+VK2D_API void VK2D_APIENTRY vk2d::ResourceManager::SetTextureMipGeneration(
+	const vk2d::TextureMipGenerationSettings	&	settings
+)
+{
+	impl->SetTextureMipGeneration( settings );
+}
+
+VK2D_API vk2d::TextureMipGenerationSettings VK2D_APIENTRY vk2d::ResourceManager::GetTextureMipGeneration() const
+{
+	return impl->GetTextureMipGeneration();
+}
+
+VK2D_API std::string VK2D_APIENTRY vk2d::ResourceManager::GetLoadTimingReport(
+	vk2d::LoadTimingReportFormat		format
+) const
+{
+	return impl->GetLoadTimingReport( format );
+}
+
+VK2D_API vk2d::ResourceCacheStatistics VK2D_APIENTRY vk2d::ResourceManager::GetResourceCacheStatistics() const
+{
+	return impl->GetResourceCacheStatistics();
+}
+
 VK2D_API bool VK2D_APIENTRY vk2d::ResourceManager::IsGood() const
 {
 	return !!impl;
@@ -147,6 +267,114 @@ VK2D_API bool VK2D_APIENTRY vk2d::ResourceManager::IsGood() const
 
 
 
+namespace vk2d {
+namespace _internal {
+
+// Canonical path so that different spellings of the same file share a cache entry.
+std::string GetResourceCachePath(
+	const std::filesystem::path		&	path
+)
+{
+	std::error_code error;
+	auto canonical_path = std::filesystem::weakly_canonical( path, error );
+	if( error ) {
+		return path.lexically_normal().string();
+	}
+	return canonical_path.string();
+}
+
+// Load cost is used to balance work between loader threads, unit is roughly
+// bytes processed. Base cost covers per resource overhead so that a pile of
+// tiny files still spreads out.
+constexpr uint64_t RESOURCE_LOAD_BASE_COST		= 64 * 1024;
+
+// File size is only an estimate of decoding work, compression ratios vary,
+// but it's available without opening the file and good enough to tell a
+// huge texture from an icon.
+uint64_t EstimateFileLoadCost(
+	const std::vector<std::filesystem::path>		&	file_paths
+)
+{
+	uint64_t cost = vk2d::_internal::RESOURCE_LOAD_BASE_COST;
+	for( auto & p : file_paths ) {
+		std::error_code error;
+		auto file_size = std::filesystem::file_size( p, error );
+		if( !error ) {
+			cost += uint64_t( file_size );
+		}
+	}
+	return cost;
+}
+
+std::string EscapeJSONString(
+	const std::string				&	text
+)
+{
+	std::ostringstream escaped;
+	for( auto c : text ) {
+		switch( c ) {
+			case '"':	escaped << "\\\"";	break;
+			case '\\':	escaped << "\\\\";	break;
+			case '\n':	escaped << "\\n";		break;
+			case '\r':	escaped << "\\r";		break;
+			case '\t':	escaped << "\\t";		break;
+			default:
+				if( uint8_t( c ) < 0x20 ) {
+					escaped << "\\u" << std::hex << std::setw( 4 ) << std::setfill( '0' ) << uint32_t( uint8_t( c ) ) << std::dec;
+				} else {
+					escaped << c;
+				}
+		}
+	}
+	return escaped.str();
+}
+
+std::string EscapeCSVField(
+	const std::string				&	text
+)
+{
+	if( text.find_first_of( ",\"\n\r" ) == std::string::npos ) return text;
+
+	std::string escaped = "\"";
+	for( auto c : text ) {
+		if( c == '"' ) escaped += '"';
+		escaped += c;
+	}
+	escaped += '"';
+	return escaped;
+}
+
+// Describes where a resource was loaded from for load timing reports.
+std::string GetLoadTimingSourceName(
+	vk2d::_internal::ResourceImpl	*	resource_impl
+)
+{
+	if( resource_impl->IsFromFile() ) {
+		std::string name;
+		for( auto & p : resource_impl->GetFilePaths() ) {
+			if( !name.empty() ) name += ";";
+			name += p.generic_string();
+		}
+		return name;
+	}
+	if( resource_impl->IsFromMemory() ) return "<memory>";
+	return "<data>";
+}
+
+uint64_t EstimateTextureDataLoadCost(
+	vk2d::Vector2u										size,
+	size_t												layer_count
+)
+{
+	return vk2d::_internal::RESOURCE_LOAD_BASE_COST +
+		uint64_t( size.x ) * uint64_t( size.y ) * uint64_t( layer_count ) * sizeof( vk2d::Color8 );
+}
+
+} // _internal
+} // vk2d
+
+
+
 vk2d::_internal::ResourceThreadLoadTask::ResourceThreadLoadTask(
 	vk2d::_internal::ResourceManagerImpl	*	resource_manager,
 	vk2d::Resource							*	resource
@@ -163,10 +391,20 @@ void vk2d::_internal::ResourceThreadLoadTask::operator()(
 	// is not set to "LOADED" here, it'll be determined by the resource itself.
 	// However we can set resource status to "FAILED_TO_LOAD" at any time.
 
+	// Take back whatever other threads have released to this loader thread.
+	auto loader_thread_resource = dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
+	if( loader_thread_resource ) {
+		loader_thread_resource->ProcessDeferredFrees();
+	}
+
+	resource->resource_impl->MarkLoadStarted();
 	if( !resource->resource_impl->MTLoad( thread_resource ) ) {
 		resource->resource_impl->status = vk2d::ResourceStatus::FAILED_TO_LOAD;
+		resource->resource_impl->FinishLoadTiming();
 		resource_manager->GetInstance()->Report( vk2d::ReportSeverity::WARNING, "Resource loading failed!" );
 	}
+	// Released before the fence, resource may be destroyed right after it's set.
+	resource_manager->ReleaseLoaderThreadLoad( resource->resource_impl->loader_thread, resource->resource_impl->load_cost );
 	resource->resource_impl->load_function_run_fence.Set();
 }
 
@@ -189,6 +427,46 @@ void vk2d::_internal::ResourceThreadUnloadTask::operator()(
 
 
 
+vk2d::_internal::ResourceThreadDefragmentTask::ResourceThreadDefragmentTask(
+	vk2d::_internal::ResourceManagerImpl	*	resource_manager,
+	uint64_t									byte_budget,
+	uint64_t									release_epoch
+) :
+	resource_manager( resource_manager ),
+	byte_budget( byte_budget ),
+	release_epoch( release_epoch )
+{};
+
+void vk2d::_internal::ResourceThreadDefragmentTask::operator()(
+	vk2d::_internal::ThreadPrivateResource	*	thread_resource
+	)
+{
+	resource_manager->MTDefragmentMemory( thread_resource, byte_budget, release_epoch );
+	--resource_manager->defragmentation_tasks_in_flight;
+}
+
+
+
+vk2d::_internal::ResourceThreadTextureResidencyTask::ResourceThreadTextureResidencyTask(
+	vk2d::_internal::ResourceManagerImpl	*	resource_manager,
+	uint64_t									release_epoch,
+	uint32_t									placeholder_size
+) :
+	resource_manager( resource_manager ),
+	release_epoch( release_epoch ),
+	placeholder_size( placeholder_size )
+{};
+
+void vk2d::_internal::ResourceThreadTextureResidencyTask::operator()(
+	vk2d::_internal::ThreadPrivateResource	*	thread_resource
+	)
+{
+	resource_manager->MTUpdateTextureResidency( thread_resource, release_epoch, placeholder_size );
+	--resource_manager->texture_residency_tasks_in_flight;
+}
+
+
+
 vk2d::_internal::ResourceManagerImpl::ResourceManagerImpl(
 	vk2d::ResourceManager			*	my_interface,
 	vk2d::_internal::InstanceImpl	*	parent_instance
@@ -206,6 +484,32 @@ vk2d::_internal::ResourceManagerImpl::ResourceManagerImpl(
 	assert( this->thread_pool );
 	assert( std::size( this->loader_threads ) );
 
+	this->loader_thread_balancer	= std::make_unique<vk2d::_internal::LoadBalancer>( std::size( this->loader_threads ) );
+
+	VkSemaphoreTypeCreateInfo timeline_semaphore_type_create_info {};
+	timeline_semaphore_type_create_info.sType			= VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+	timeline_semaphore_type_create_info.pNext			= nullptr;
+	timeline_semaphore_type_create_info.semaphoreType	= VK_SEMAPHORE_TYPE_TIMELINE;
+	timeline_semaphore_type_create_info.initialValue	= 0;
+
+	VkSemaphoreCreateInfo timeline_semaphore_create_info {};
+	timeline_semaphore_create_info.sType		= VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	timeline_semaphore_create_info.pNext		= &timeline_semaphore_type_create_info;
+	timeline_semaphore_create_info.flags		= 0;
+
+	for( auto & s : vk_retired_image_epoch_semaphores ) {
+		auto result = vkCreateSemaphore(
+			vk_device,
+			&timeline_semaphore_create_info,
+			nullptr,
+			&s
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot create ResourceManager, cannot create synchronization primitives!" );
+			return;
+		}
+	}
+
 	is_good		= true;
 }
 
@@ -214,41 +518,44 @@ vk2d::_internal::ResourceManagerImpl::~ResourceManagerImpl()
 	// Wait for all resources to finish loading, giving time to finish.
 	while( true ) {
 		bool all_resources_status_determined = true;
-		{
-			std::unique_lock<std::recursive_mutex> unique_lock( resources_mutex );
-
-			auto it = resources.begin();
-			while( it != resources.end() ) {
-				if( ( *it )->GetStatus() == vk2d::ResourceStatus::UNDETERMINED ) {
+		resources.ForEach( [ &all_resources_status_determined ]( vk2d::Resource * resource )
+			{
+				if( resource->GetStatus() == vk2d::ResourceStatus::UNDETERMINED ) {
 					// Resource status is still undetermined
 					all_resources_status_determined = false;
 				}
-				// Okay to continue
-				++it;
-			}
-			if( all_resources_status_determined ) break;
-		}
+			} );
+		if( all_resources_status_determined ) break;
 		std::this_thread::sleep_for( std::chrono::microseconds( 10 ) );
 	}
 
 	// Everythign should be up to date now and we can start scheduling resource unloading.
 	{
-		std::unique_lock<std::recursive_mutex> unique_lock( resources_mutex );
+		resource_cache.clear();
 
-		auto it = resources.begin();
-		while( it != resources.end() ) {
-			( *it )->resource_impl->WaitUntilLoaded();
+		auto all_resources = resources.RemoveAll();
+		for( auto & r : all_resources ) {
+			r->resource_impl->WaitUntilLoaded();
+			auto loader_thread = r->resource_impl->GetLoaderThread();
 			thread_pool->ScheduleTask(
 				std::make_unique<vk2d::_internal::ResourceThreadUnloadTask>(
-					this, std::move( *it )
+					this, std::move( r )
 					),
-				{ ( *it )->resource_impl->GetLoaderThread() }
+				{ loader_thread }
 			);
-			it = resources.erase( it );
 		}
 	}
 
 	thread_pool->WaitIdle();
+
+	// Instance waited for the device to go idle before destroying us.
+	for( auto s : vk_retired_image_epoch_semaphores ) {
+		vkDestroySemaphore(
+			vk_device,
+			s,
+			nullptr
+		);
+	}
 }
 
 
@@ -257,22 +564,95 @@ vk2d::TextureResource * vk2d::_internal::ResourceManagerImpl::LoadTextureResourc
 	const std::filesystem::path			&	file_path,
 	vk2d::Resource						*	parent_resource )
 {
-	std::lock_guard<std::recursive_mutex>		resources_lock( resources_mutex );
+	// Subresources belong to their parent and are never shared.
+	std::string cache_key;
+	if( !parent_resource ) {
+		cache_key = "texture|" + vk2d::_internal::GetResourceCachePath( file_path );
+	}
 
-	auto resource		= std::unique_ptr<vk2d::TextureResource>(
-		new vk2d::TextureResource(
-			this,
-			SelectLoaderThread(),
-			parent_resource,
-			{ file_path } )
-		);
-	if( !resource || !resource->IsGood() ) {
-		// Could not create resource.
-		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource handle!" );
+	return AttachCachedResource<vk2d::TextureResource>( cache_key, [ & ]()
+		{
+			return CreateFileTextureResource( file_path, parent_resource );
+		} );
+}
+
+vk2d::TextureResource * vk2d::_internal::ResourceManagerImpl::LoadTextureResourceFromMemory(
+	const void							*	encoded_image_data,
+	size_t									encoded_image_size,
+	vk2d::Resource						*	parent_resource )
+{
+	if( !encoded_image_data || !encoded_image_size ) {
+		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create texture: Image data is empty!" );
 		return nullptr;
 	}
 
-	return AttachResource( std::move( resource ) );
+	// Memory contents may change after loading so memory resources are never shared.
+	return AttachCachedResource<vk2d::TextureResource>( {}, [ & ]() -> std::unique_ptr<vk2d::TextureResource>
+		{
+			auto load_cost		= vk2d::_internal::RESOURCE_LOAD_BASE_COST + uint64_t( encoded_image_size );
+			auto loader_thread	= SelectLoaderThread( load_cost );
+			auto resource		= std::unique_ptr<vk2d::TextureResource>(
+				new vk2d::TextureResource(
+					this,
+					loader_thread,
+					parent_resource,
+					encoded_image_data,
+					encoded_image_size )
+				);
+			if( !resource || !resource->IsGood() ) {
+				// Could not create resource.
+				ReleaseLoaderThreadLoad( loader_thread, load_cost );
+				GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource handle!" );
+				return nullptr;
+			}
+			resource->resource_impl->load_cost	= load_cost;
+			return resource;
+		} );
+}
+
+std::vector<vk2d::TextureResource*> vk2d::_internal::ResourceManagerImpl::LoadTextureResources(
+	const std::vector<std::filesystem::path>						&	file_paths,
+	std::function<void( const vk2d::TextureBatchLoadProgress & )>		progress_callback )
+{
+	std::vector<vk2d::TextureResource*> textures( file_paths.size() );
+	std::vector<vk2d::TextureResource*> new_textures;
+	new_textures.reserve( file_paths.size() );
+
+	auto upload_batch = std::make_shared<vk2d::_internal::TextureUploadBatch>( instance, std::move( progress_callback ) );
+
+	// Every texture is added to the batch before any of them is scheduled,
+	// otherwise the batch could submit before it's complete. Cache is locked
+	// for the duration like in AttachCachedResource().
+	{
+		std::lock_guard<std::mutex> cache_lock( resource_cache_mutex );
+
+		for( size_t i = 0; i < file_paths.size(); ++i ) {
+			auto cache_key	= "texture|" + vk2d::_internal::GetResourceCachePath( file_paths[ i ] );
+			auto cached		= AcquireCachedResource( cache_key );
+			if( cached ) {
+				textures[ i ] = static_cast<vk2d::TextureResource*>( cached );
+				continue;
+			}
+
+			auto resource = CreateFileTextureResource( file_paths[ i ], nullptr );
+			if( !resource ) continue;
+			auto loader_thread				= resource->resource_impl->GetLoaderThread();
+			resource->impl->upload_batch	= upload_batch;
+
+			auto resource_ptr = resource.get();
+			if( !InsertResource( std::move( resource ) ) ) continue;
+
+			upload_batch->AddTexture( loader_thread );
+			RegisterCachedResource( cache_key, resource_ptr );
+			textures[ i ] = resource_ptr;
+			new_textures.push_back( resource_ptr );
+		}
+	}
+
+	for( auto t : new_textures ) {
+		ScheduleResourceLoad( t );
+	}
+	return textures;
 }
 
 vk2d::TextureResource * vk2d::_internal::ResourceManagerImpl::CreateTextureResource(
@@ -280,46 +660,64 @@ vk2d::TextureResource * vk2d::_internal::ResourceManagerImpl::CreateTextureResou
 	const std::vector<vk2d::Color8>		&	texture_data,
 	vk2d::Resource						*	parent_resource )
 {
-	std::lock_guard<std::recursive_mutex>		resources_lock( resources_mutex );
-
-	auto resource		= std::unique_ptr<vk2d::TextureResource>(
-		new vk2d::TextureResource(
-			this,
-			SelectLoaderThread(),
-			parent_resource,
-			size,
-			{ &texture_data }
-		)
-		);
-	if( !resource || !resource->IsGood() ) {
-		// Could not create resource.
-		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource handle!" );
-		return nullptr;
-	}
-
-	return AttachResource( std::move( resource ) );
+	// Texel data creates are never shared, identical texels don't make
+	// identical textures once one of them is updated with UpdateRegion().
+	return AttachCachedResource<vk2d::TextureResource>( {}, [ & ]() -> std::unique_ptr<vk2d::TextureResource>
+		{
+			auto load_cost		= vk2d::_internal::EstimateTextureDataLoadCost( size, 1 );
+			auto loader_thread	= SelectLoaderThread( load_cost );
+			auto resource		= std::unique_ptr<vk2d::TextureResource>(
+				new vk2d::TextureResource(
+					this,
+					loader_thread,
+					parent_resource,
+					size,
+					{ &texture_data }
+				)
+				);
+			if( !resource || !resource->IsGood() ) {
+				// Could not create resource.
+				ReleaseLoaderThreadLoad( loader_thread, load_cost );
+				GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource handle!" );
+				return nullptr;
+			}
+			resource->resource_impl->load_cost	= load_cost;
+			return resource;
+		} );
 }
 
 vk2d::TextureResource * vk2d::_internal::ResourceManagerImpl::LoadArrayTextureResource(
 	const std::vector<std::filesystem::path>		&	file_path_listing,
 	vk2d::Resource									*	parent_resource )
 {
-	std::lock_guard<std::recursive_mutex>		resources_lock( resources_mutex );
-
-	auto resource		= std::unique_ptr<vk2d::TextureResource>(
-		new vk2d::TextureResource(
-			this,
-			SelectLoaderThread(),
-			parent_resource,
-			file_path_listing )
-		);
-	if( !resource || !resource->IsGood() ) {
-		// Could not create resource.
-		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource handle!" );
-		return nullptr;
+	std::string cache_key;
+	if( !parent_resource ) {
+		cache_key = "array_texture";
+		for( auto & p : file_path_listing ) {
+			cache_key += "|" + vk2d::_internal::GetResourceCachePath( p );
+		}
 	}
 
-	return AttachResource( std::move( resource ) );
+	return AttachCachedResource<vk2d::TextureResource>( cache_key, [ & ]() -> std::unique_ptr<vk2d::TextureResource>
+		{
+			auto load_cost		= vk2d::_internal::EstimateFileLoadCost( file_path_listing );
+			auto loader_thread	= SelectLoaderThread( load_cost );
+			auto resource		= std::unique_ptr<vk2d::TextureResource>(
+				new vk2d::TextureResource(
+					this,
+					loader_thread,
+					parent_resource,
+					file_path_listing )
+				);
+			if( !resource || !resource->IsGood() ) {
+				// Could not create resource.
+				ReleaseLoaderThreadLoad( loader_thread, load_cost );
+				GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource handle!" );
+				return nullptr;
+			}
+			resource->resource_impl->load_cost	= load_cost;
+			return resource;
+		} );
 }
 
 vk2d::TextureResource * vk2d::_internal::ResourceManagerImpl::CreateArrayTextureResource(
@@ -327,25 +725,31 @@ vk2d::TextureResource * vk2d::_internal::ResourceManagerImpl::CreateArrayTexture
 	const std::vector<const std::vector<vk2d::Color8>*>	&	texture_data_listings,
 	vk2d::Resource										*	parent_resource )
 {
-	std::lock_guard<std::recursive_mutex>		resources_lock( resources_mutex );
-
-	auto resource		=
-		std::unique_ptr<vk2d::TextureResource>(
-			new vk2d::TextureResource(
-				this,
-				SelectLoaderThread(),
-				parent_resource,
-				size,
-				texture_data_listings
-			)
-			);
-	if( !resource || !resource->IsGood() ) {
-		// Could not create resource.
-		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource handle!" );
-		return nullptr;
-	}
-
-	return AttachResource( std::move( resource ) );
+	// Texel data creates are never shared, identical texels don't make
+	// identical textures once one of them is updated with UpdateRegion().
+	return AttachCachedResource<vk2d::TextureResource>( {}, [ & ]() -> std::unique_ptr<vk2d::TextureResource>
+		{
+			auto load_cost		= vk2d::_internal::EstimateTextureDataLoadCost( size, texture_data_listings.size() );
+			auto loader_thread	= SelectLoaderThread( load_cost );
+			auto resource		=
+				std::unique_ptr<vk2d::TextureResource>(
+					new vk2d::TextureResource(
+						this,
+						loader_thread,
+						parent_resource,
+						size,
+						texture_data_listings
+					)
+					);
+			if( !resource || !resource->IsGood() ) {
+				// Could not create resource.
+				ReleaseLoaderThreadLoad( loader_thread, load_cost );
+				GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource handle!" );
+				return nullptr;
+			}
+			resource->resource_impl->load_cost	= load_cost;
+			return resource;
+		} );
 }
 
 vk2d::FontResource * vk2d::_internal::ResourceManagerImpl::LoadFontResource(
@@ -354,31 +758,136 @@ vk2d::FontResource * vk2d::_internal::ResourceManagerImpl::LoadFontResource(
 	uint32_t								glyph_texel_size,
 	bool									use_alpha,
 	uint32_t								fallback_character,
-	uint32_t								glyph_atlas_padding
+	uint32_t								glyph_atlas_padding,
+	bool									load_glyphs_on_demand,
+	std::string_view						preload_characters
 )
 {
-	std::lock_guard<std::recursive_mutex>		resources_lock( resources_mutex );
+	std::string cache_key;
+	if( !parent_resource ) {
+		cache_key = "font|" + vk2d::_internal::GetResourceCachePath( file_path ) +
+			"|" + std::to_string( glyph_texel_size ) +
+			"|" + std::to_string( use_alpha ) +
+			"|" + std::to_string( fallback_character ) +
+			"|" + std::to_string( glyph_atlas_padding ) +
+			"|" + std::to_string( load_glyphs_on_demand ) +
+			"|" + std::string( load_glyphs_on_demand ? preload_characters : std::string_view() );
+	}
 
-	auto resource		=
-		std::unique_ptr<vk2d::FontResource>(
-			new vk2d::FontResource(
-				this,
-				SelectLoaderThread(),
-				parent_resource,
-				file_path,
-				glyph_texel_size,
-				use_alpha,
-				fallback_character,
-				glyph_atlas_padding
-			)
-			);
-	if( !resource || !resource->IsGood() ) {
-		// Could not create resource.
-		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create font resource handle!" );
+	return AttachCachedResource<vk2d::FontResource>( cache_key, [ & ]() -> std::unique_ptr<vk2d::FontResource>
+		{
+			vk2d::_internal::AssetPackItem pack_item {};
+			auto is_in_pack		= FindAssetPackItem( file_path, pack_item );
+			auto load_cost		= is_in_pack ?
+				vk2d::_internal::RESOURCE_LOAD_BASE_COST + uint64_t( pack_item.size ) :
+				vk2d::_internal::EstimateFileLoadCost( { file_path } );
+			auto loader_thread	= SelectLoaderThread( load_cost );
+			auto resource		= std::unique_ptr<vk2d::FontResource>();
+			if( is_in_pack ) {
+				resource = std::unique_ptr<vk2d::FontResource>(
+					new vk2d::FontResource(
+						this,
+						loader_thread,
+						parent_resource,
+						pack_item.data,
+						pack_item.size,
+						glyph_texel_size,
+						use_alpha,
+						fallback_character,
+						glyph_atlas_padding,
+						load_glyphs_on_demand,
+						preload_characters
+					)
+					);
+			} else {
+				resource = std::unique_ptr<vk2d::FontResource>(
+					new vk2d::FontResource(
+						this,
+						loader_thread,
+						parent_resource,
+						file_path,
+						glyph_texel_size,
+						use_alpha,
+						fallback_character,
+						glyph_atlas_padding,
+						load_glyphs_on_demand,
+						preload_characters
+					)
+					);
+			}
+			if( !resource || !resource->IsGood() ) {
+				// Could not create resource.
+				ReleaseLoaderThreadLoad( loader_thread, load_cost );
+				GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create font resource handle!" );
+				return nullptr;
+			}
+			resource->resource_impl->load_cost	= load_cost;
+			return resource;
+		} );
+}
+
+vk2d::FontResource * vk2d::_internal::ResourceManagerImpl::LoadFontResourceFromMemory(
+	const void							*	font_file_data,
+	size_t									font_file_size,
+	vk2d::Resource						*	parent_resource,
+	uint32_t								glyph_texel_size,
+	bool									use_alpha,
+	uint32_t								fallback_character,
+	uint32_t								glyph_atlas_padding,
+	bool									load_glyphs_on_demand,
+	std::string_view						preload_characters
+)
+{
+	if( !font_file_data || !font_file_size ) {
+		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot load font: Font data is empty!" );
 		return nullptr;
 	}
 
-	return AttachResource( std::move( resource ) );
+	// Memory contents may change after loading so memory resources are never shared.
+	return AttachCachedResource<vk2d::FontResource>( {}, [ & ]() -> std::unique_ptr<vk2d::FontResource>
+		{
+			auto load_cost		= vk2d::_internal::RESOURCE_LOAD_BASE_COST + uint64_t( font_file_size );
+			auto loader_thread	= SelectLoaderThread( load_cost );
+			auto resource		=
+				std::unique_ptr<vk2d::FontResource>(
+					new vk2d::FontResource(
+						this,
+						loader_thread,
+						parent_resource,
+						font_file_data,
+						font_file_size,
+						glyph_texel_size,
+						use_alpha,
+						fallback_character,
+						glyph_atlas_padding,
+						load_glyphs_on_demand,
+						preload_characters
+					)
+					);
+			if( !resource || !resource->IsGood() ) {
+				// Could not create resource.
+				ReleaseLoaderThreadLoad( loader_thread, load_cost );
+				GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create font resource handle!" );
+				return nullptr;
+			}
+			resource->resource_impl->load_cost	= load_cost;
+			return resource;
+		} );
+}
+
+bool vk2d::_internal::ResourceManagerImpl::MountAssetPack(
+	const std::filesystem::path			&	pack_path
+)
+{
+	auto asset_pack = std::make_unique<vk2d::_internal::AssetPack>( pack_path );
+	if( !asset_pack->IsGood() ) {
+		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot mount asset pack: Cannot open or invalid asset pack: " + pack_path.string() );
+		return false;
+	}
+
+	std::lock_guard<std::mutex> asset_packs_lock( asset_packs_mutex );
+	asset_packs.push_back( std::move( asset_pack ) );
+	return true;
 }
 
 void vk2d::_internal::ResourceManagerImpl::DestroyResource(
@@ -387,24 +896,377 @@ void vk2d::_internal::ResourceManagerImpl::DestroyResource(
 {
 	if( !resource ) return;
 
+	// Shared resources are destroyed with the last reference.
+	if( !ReleaseCachedResource( resource ) ) return;
+
 	// We'll have to wait until the resource is definitely loaded, or encountered an error.
 	resource->resource_impl->WaitUntilLoaded();
 	resource->resource_impl->DestroySubresources();
 
-	std::lock_guard<std::recursive_mutex> lock_guard( resources_mutex );
+	// Stale handle means the resource was already destroyed.
+	auto owned_resource = resources.Remove( resource->resource_impl->resource_handle );
+	if( !owned_resource ) return;
 
-	// find resource if it exists
-	auto it = resources.begin();
-	while( it != resources.end() ) {
-		if( it->get() == resource ) {
-			// Found resource in the resources list
-			thread_pool->ScheduleTask( std::make_unique<vk2d::_internal::ResourceThreadUnloadTask>( this, std::move( *it ) ), { resource->resource_impl->GetLoaderThread() } );
-			it = resources.erase( it );
-			return;
-		} else {
-			++it;
+	// Unload in the loader thread if needed, otherwise
+	// in whichever loader thread gets to it first.
+	auto unload_threads = loader_threads;
+	if( owned_resource->resource_impl->IsUnloadLockedToLoaderThread() ) {
+		unload_threads = { owned_resource->resource_impl->GetLoaderThread() };
+	}
+	thread_pool->ScheduleTask( std::make_unique<vk2d::_internal::ResourceThreadUnloadTask>( this, std::move( owned_resource ) ), unload_threads );
+}
+
+void vk2d::_internal::ResourceManagerImpl::DefragmentMemory(
+	uint64_t		byte_budget
+)
+{
+	VK2D_ASSERT_MAIN_THREAD( instance );
+
+	// Every round must finish before the next one starts, images moved in the
+	// previous round are only released once the render queues have signaled
+	// the epoch of a later round. Because this is called from the main thread
+	// outside of rendering, any frame that could still refer to an image
+	// retired before the new epoch has been submitted by then.
+	if( defragmentation_tasks_in_flight ) return;
+	if( instance->IsRendering() ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "'ResourceManager::DefragmentMemory()' Called between 'BeginRender()' and 'EndRender()'!" );
+		return;
+	}
+
+	auto release_epoch		= BeginRetiredImageEpoch();
+	auto per_thread_budget	= std::max( byte_budget / uint64_t( loader_threads.size() ), uint64_t( 1 ) );
+	defragmentation_tasks_in_flight = uint32_t( loader_threads.size() );
+	for( auto t : loader_threads ) {
+		thread_pool->ScheduleTask(
+			std::make_unique<vk2d::_internal::ResourceThreadDefragmentTask>(
+				this,
+				per_thread_budget,
+				release_epoch
+			),
+			{ t }
+		);
+	}
+}
+
+vk2d::MemoryDefragmentationReport vk2d::_internal::ResourceManagerImpl::GetMemoryDefragmentationReport() const
+{
+	vk2d::MemoryDefragmentationReport report {};
+	report.moved_bytes				= defragmentation_moved_bytes;
+	report.moved_resource_count		= defragmentation_moved_resource_count;
+	report.reclaimed_bytes			= defragmentation_reclaimed_bytes;
+	report.released_chunk_count		= defragmentation_released_chunk_count;
+	return report;
+}
+
+void vk2d::_internal::ResourceManagerImpl::SetTextureResidencyBudget(
+	uint64_t		byte_budget,
+	uint32_t		placeholder_size
+)
+{
+	texture_residency_budget			= byte_budget;
+	texture_residency_placeholder_size	= std::max( placeholder_size, uint32_t( 1 ) );
+}
+
+void vk2d::_internal::ResourceManagerImpl::UpdateTextureResidency()
+{
+	VK2D_ASSERT_MAIN_THREAD( instance );
+
+	// Same rules as DefragmentMemory(), images replaced in the previous round
+	// are released at the start of the next round.
+	if( texture_residency_tasks_in_flight ) return;
+	if( instance->IsRendering() ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "'ResourceManager::UpdateTextureResidency()' Called between 'BeginRender()' and 'EndRender()'!" );
+		return;
+	}
+
+	auto byte_budget = texture_residency_budget.load();
+	if( !byte_budget && !texture_residency_evicted_count ) return;
+
+	auto release_epoch		= BeginRetiredImageEpoch();
+	auto tick				= ++texture_residency_tick;
+
+	struct EvictionCandidate {
+		uint64_t												resource_id							= {};
+		uint64_t												last_used_tick						= {};
+		VkDeviceSize											size								= {};
+		size_t													loader_thread_index					= {};
+	};
+	std::vector<EvictionCandidate>	eviction_candidates;
+	std::vector<bool>				loader_thread_has_work( loader_threads.size() );
+	uint64_t						resident_bytes		= 0;
+	uint64_t						evicted_count		= 0;
+
+	auto GetLoaderThreadIndex = [ this ]( uint32_t loader_thread )
+	{
+		return size_t( std::find( loader_threads.begin(), loader_threads.end(), loader_thread ) - loader_threads.begin() );
+	};
+
+	// Textures drawn since the previous round are marked used in this tick.
+	// Evicted textures that were drawn are loaded again.
+	resources.ForEach( [ & ]( vk2d::Resource * r )
+		{
+			auto texture_resource = dynamic_cast<vk2d::TextureResource*>( r );
+			if( !texture_resource ) return;
+
+			auto t = texture_resource->impl.get();
+			if( t->is_used.exchange( false ) ) {
+				t->last_used_tick = tick;
+			}
+			if( t->status != vk2d::ResourceStatus::LOADED ) return;
+
+			auto loader_thread_index	= GetLoaderThreadIndex( t->GetLoaderThread() );
+			auto size					= t->GetResidentSize();
+			resident_bytes				+= size;
+			if( t->HasRetiredImages( release_epoch ) ) {
+				loader_thread_has_work[ loader_thread_index ] = true;
+			}
+
+			if( t->is_evicted ) {
+				++evicted_count;
+				if( ( t->last_used_tick == tick || !byte_budget ) && !t->is_reload_failed ) {
+					t->residency_action							= vk2d::_internal::TextureResidencyAction::RELOAD;
+					loader_thread_has_work[ loader_thread_index ]	= true;
+					resident_bytes								+= t->full_image_size - std::min( VkDeviceSize( t->full_image_size ), size );
+				}
+			} else if( byte_budget && t->last_used_tick != tick && t->IsEvictable() ) {
+				EvictionCandidate candidate {};
+				candidate.resource_id			= t->GetResourceID();
+				candidate.last_used_tick		= t->last_used_tick;
+				candidate.size					= size;
+				candidate.loader_thread_index	= loader_thread_index;
+				eviction_candidates.push_back( candidate );
+			}
+		} );
+
+	texture_residency_resident_bytes	= resident_bytes;
+	texture_residency_evicted_count		= evicted_count;
+
+	// Evict least recently used textures until we're within budget. Textures
+	// may be destroyed at any time so they're found again by their ID.
+	if( byte_budget && resident_bytes > byte_budget ) {
+		std::sort(
+			eviction_candidates.begin(),
+			eviction_candidates.end(),
+			[]( const EvictionCandidate & a, const EvictionCandidate & b ) { return a.last_used_tick < b.last_used_tick; }
+		);
+
+		std::set<uint64_t> evicted_ids;
+		for( auto & c : eviction_candidates ) {
+			if( resident_bytes <= byte_budget ) break;
+			resident_bytes -= std::min( resident_bytes, uint64_t( c.size ) );
+			evicted_ids.insert( c.resource_id );
+			loader_thread_has_work[ c.loader_thread_index ] = true;
+		}
+
+		if( !evicted_ids.empty() ) {
+			resources.ForEach( [ &evicted_ids ]( vk2d::Resource * r )
+				{
+					auto texture_resource = dynamic_cast<vk2d::TextureResource*>( r );
+					if( !texture_resource ) return;
+					if( evicted_ids.count( texture_resource->impl->GetResourceID() ) ) {
+						texture_resource->impl->residency_action = vk2d::_internal::TextureResidencyAction::EVICT;
+					}
+				} );
+		}
+	}
+
+	auto placeholder_size = texture_residency_placeholder_size.load();
+	texture_residency_tasks_in_flight = uint32_t( std::count( loader_thread_has_work.begin(), loader_thread_has_work.end(), true ) );
+	for( size_t i = 0; i < loader_threads.size(); ++i ) {
+		if( !loader_thread_has_work[ i ] ) continue;
+		thread_pool->ScheduleTask(
+			std::make_unique<vk2d::_internal::ResourceThreadTextureResidencyTask>(
+				this,
+				release_epoch,
+				placeholder_size
+			),
+			{ loader_threads[ i ] }
+		);
+	}
+}
+
+vk2d::TextureResidencyReport vk2d::_internal::ResourceManagerImpl::GetTextureResidencyReport() const
+{
+	vk2d::TextureResidencyReport report {};
+	report.budget					= texture_residency_budget;
+	report.resident_bytes			= texture_residency_resident_bytes;
+	report.evicted_texture_count	= texture_residency_evicted_count;
+	report.eviction_count			= texture_eviction_count;
+	report.reload_count				= texture_reload_count;
+	return report;
+}
+
+void vk2d::_internal::ResourceManagerImpl::SetTextureMipGeneration(
+	const vk2d::TextureMipGenerationSettings	&	settings
+)
+{
+	std::lock_guard<std::mutex> lock( texture_mip_generation_mutex );
+	texture_mip_generation_settings		= settings;
+}
+
+vk2d::TextureMipGenerationSettings vk2d::_internal::ResourceManagerImpl::GetTextureMipGeneration() const
+{
+	std::lock_guard<std::mutex> lock( texture_mip_generation_mutex );
+	return texture_mip_generation_settings;
+}
+
+std::string vk2d::_internal::ResourceManagerImpl::GetLoadTimingReport(
+	vk2d::LoadTimingReportFormat		format
+)
+{
+	struct ReportRow {
+		std::string												type								= {};
+		std::string												source								= {};
+		vk2d::ResourceStatus									status								= {};
+		vk2d::ResourceLoadTiming								timing								= {};
+	};
+	std::vector<ReportRow>					rows;
+	vk2d::ResourceLoadTiming				totals {};
+	uint64_t								loaded_texture_count	= 0;
+	uint64_t								failed_count			= 0;
+	auto									first_scheduled			= std::chrono::steady_clock::time_point::max();
+	auto									last_finished			= std::chrono::steady_clock::time_point::min();
+
+	resources.ForEach( [ & ]( vk2d::Resource * r )
+		{
+			std::chrono::steady_clock::time_point scheduled {};
+			std::chrono::steady_clock::time_point finished {};
+			if( !r->resource_impl->GetLoadTimeRange( scheduled, finished ) ) return;
+
+			ReportRow row {};
+			row.type		= dynamic_cast<vk2d::TextureResource*>( r ) ? "texture" : ( dynamic_cast<vk2d::FontResource*>( r ) ? "font" : "resource" );
+			row.source		= vk2d::_internal::GetLoadTimingSourceName( r->resource_impl );
+			row.status		= r->resource_impl->status;
+			row.timing		= r->resource_impl->GetLoadTiming();
+
+			first_scheduled	= std::min( first_scheduled, scheduled );
+			last_finished	= std::max( last_finished, finished );
+			if( row.status == vk2d::ResourceStatus::LOADED ) {
+				if( row.type == "texture" ) ++loaded_texture_count;
+			} else {
+				++failed_count;
+			}
+			rows.push_back( std::move( row ) );
+		} );
+
+	for( auto & r : rows ) {
+		totals.queue_wait			+= r.timing.queue_wait;
+		totals.file_read			+= r.timing.file_read;
+		totals.decode				+= r.timing.decode;
+		totals.mip_generation		+= r.timing.mip_generation;
+		totals.staging_copy			+= r.timing.staging_copy;
+		totals.upload_record		+= r.timing.upload_record;
+		totals.gpu_upload			+= r.timing.gpu_upload;
+		totals.glyph_rasterization	+= r.timing.glyph_rasterization;
+		totals.glyph_rasterization_thread_total	+= r.timing.glyph_rasterization_thread_total;
+		totals.source_bytes			+= r.timing.source_bytes;
+		totals.uploaded_bytes		+= r.timing.uploaded_bytes;
+	}
+	if( !rows.empty() ) {
+		totals.total				= std::chrono::duration_cast<std::chrono::nanoseconds>( last_finished - first_scheduled );
+	}
+
+	auto ToMilliseconds = []( std::chrono::nanoseconds duration )
+	{
+		return std::chrono::duration<double, std::milli>( duration ).count();
+	};
+	auto MegabytesPerSecond = []( uint64_t bytes, std::chrono::nanoseconds duration )
+	{
+		auto seconds = std::chrono::duration<double>( duration ).count();
+		return seconds > 0.0 ? double( bytes ) / ( 1024.0 * 1024.0 ) / seconds : 0.0;
+	};
+	auto wall_seconds			= std::chrono::duration<double>( totals.total ).count();
+	auto textures_per_second	= wall_seconds > 0.0 ? double( loaded_texture_count ) / wall_seconds : 0.0;
+
+	struct Column {
+		const char											*	name								= {};
+		std::chrono::nanoseconds vk2d::ResourceLoadTiming::	*	phase								= {};
+	};
+	std::array<Column, 10> phase_columns { {
+		{ "queue_wait_ms",			&vk2d::ResourceLoadTiming::queue_wait },
+		{ "file_read_ms",			&vk2d::ResourceLoadTiming::file_read },
+		{ "decode_ms",				&vk2d::ResourceLoadTiming::decode },
+		{ "mip_generation_ms",		&vk2d::ResourceLoadTiming::mip_generation },
+		{ "staging_copy_ms",		&vk2d::ResourceLoadTiming::staging_copy },
+		{ "upload_record_ms",		&vk2d::ResourceLoadTiming::upload_record },
+		{ "gpu_upload_ms",			&vk2d::ResourceLoadTiming::gpu_upload },
+		{ "glyph_rasterization_ms",	&vk2d::ResourceLoadTiming::glyph_rasterization },
+		{ "glyph_rasterization_thread_total_ms",	&vk2d::ResourceLoadTiming::glyph_rasterization_thread_total },
+		{ "total_ms",				&vk2d::ResourceLoadTiming::total },
+	} };
+
+	std::ostringstream report;
+	report << std::fixed << std::setprecision( 3 );
+
+	if( format == vk2d::LoadTimingReportFormat::CSV ) {
+		report << "type,source,status";
+		for( auto & c : phase_columns ) report << "," << c.name;
+		report << ",source_bytes,uploaded_bytes,megabytes_per_second,textures_per_second\n";
+
+		for( auto & r : rows ) {
+			report << r.type << "," << vk2d::_internal::EscapeCSVField( r.source ) << ","
+				<< ( r.status == vk2d::ResourceStatus::LOADED ? "loaded" : "failed" );
+			for( auto & c : phase_columns ) report << "," << ToMilliseconds( r.timing.*c.phase );
+			report << "," << r.timing.source_bytes << "," << r.timing.uploaded_bytes
+				<< "," << MegabytesPerSecond( r.timing.source_bytes, r.timing.total ) << ",\n";
 		}
+
+		// Phases are summed over every resource, total is wall clock time.
+		report << "total,," << rows.size() - failed_count << " loaded " << failed_count << " failed";
+		for( auto & c : phase_columns ) report << "," << ToMilliseconds( totals.*c.phase );
+		report << "," << totals.source_bytes << "," << totals.uploaded_bytes
+			<< "," << MegabytesPerSecond( totals.source_bytes, totals.total ) << "," << textures_per_second << "\n";
+		return report.str();
+	}
+
+	report << "{\n";
+	report << "\t\"summary\": {\n";
+	report << "\t\t\"resource_count\": " << rows.size() << ",\n";
+	report << "\t\t\"failed_count\": " << failed_count << ",\n";
+	report << "\t\t\"loaded_texture_count\": " << loaded_texture_count << ",\n";
+	report << "\t\t\"wall_time_ms\": " << ToMilliseconds( totals.total ) << ",\n";
+	report << "\t\t\"source_bytes\": " << totals.source_bytes << ",\n";
+	report << "\t\t\"uploaded_bytes\": " << totals.uploaded_bytes << ",\n";
+	report << "\t\t\"megabytes_per_second\": " << MegabytesPerSecond( totals.source_bytes, totals.total ) << ",\n";
+	report << "\t\t\"textures_per_second\": " << textures_per_second << ",\n";
+	report << "\t\t\"phase_totals\": {";
+	for( size_t i = 0; i < phase_columns.size() - 1; ++i ) {
+		report << ( i ? ", " : " " ) << "\"" << phase_columns[ i ].name << "\": " << ToMilliseconds( totals.*phase_columns[ i ].phase );
+	}
+	report << " }\n";
+	report << "\t},\n";
+	report << "\t\"resources\": [";
+	for( size_t i = 0; i < rows.size(); ++i ) {
+		auto & r = rows[ i ];
+		report << ( i ? ",\n" : "\n" ) << "\t\t{ "
+			<< "\"type\": \"" << r.type << "\", "
+			<< "\"source\": \"" << vk2d::_internal::EscapeJSONString( r.source ) << "\", "
+			<< "\"status\": \"" << ( r.status == vk2d::ResourceStatus::LOADED ? "loaded" : "failed" ) << "\"";
+		for( auto & c : phase_columns ) report << ", \"" << c.name << "\": " << ToMilliseconds( r.timing.*c.phase );
+		report << ", \"source_bytes\": " << r.timing.source_bytes
+			<< ", \"uploaded_bytes\": " << r.timing.uploaded_bytes
+			<< ", \"megabytes_per_second\": " << MegabytesPerSecond( r.timing.source_bytes, r.timing.total ) << " }";
+	}
+	report << ( rows.empty() ? "]\n" : "\n\t]\n" );
+	report << "}\n";
+	return report.str();
+}
+
+uint64_t vk2d::_internal::ResourceManagerImpl::GetRetiredImageEpoch() const
+{
+	return retired_image_epoch;
+}
+
+vk2d::ResourceCacheStatistics vk2d::_internal::ResourceManagerImpl::GetResourceCacheStatistics() const
+{
+	vk2d::ResourceCacheStatistics statistics {};
+	statistics.lookup_count				= resource_cache_lookup_count;
+	statistics.hit_count				= resource_cache_hit_count;
+	{
+		std::lock_guard<std::mutex> cache_lock( resource_cache_mutex );
+		statistics.cached_resource_count	= resource_cache.size();
 	}
+	return statistics;
 }
 
 vk2d::_internal::InstanceImpl * vk2d::_internal::ResourceManagerImpl::GetInstance() const
@@ -439,6 +1301,7 @@ bool vk2d::_internal::ResourceManagerImpl::IsGood() const
 
 void vk2d::_internal::ResourceManagerImpl::ScheduleResourceLoad( vk2d::Resource * resource_ptr )
 {
+	resource_ptr->resource_impl->MarkLoadScheduled();
 	thread_pool->ScheduleTask(
 		std::make_unique<vk2d::_internal::ResourceThreadLoadTask>(
 			this,
@@ -448,10 +1311,361 @@ void vk2d::_internal::ResourceManagerImpl::ScheduleResourceLoad( vk2d::Resource
 	);
 }
 
-uint32_t vk2d::_internal::ResourceManagerImpl::SelectLoaderThread()
+bool vk2d::_internal::ResourceManagerImpl::InsertResource(
+	std::unique_ptr<vk2d::Resource>		resource
+)
+{
+	auto resource_ptr	= resource.get();
+
+	// Handle is written before the resource is shared with anyone, no need to synchronize.
+	auto handle			= resources.Insert( std::move( resource ) );
+	if( !handle ) {
+		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot attach resource, too many resources!" );
+		ReleaseLoaderThreadLoad( resource_ptr->resource_impl->loader_thread, resource_ptr->resource_impl->load_cost );
+		return false;
+	}
+	resource_ptr->resource_impl->resource_handle	= handle;
+	return true;
+}
+
+vk2d::Resource * vk2d::_internal::ResourceManagerImpl::AcquireCachedResource(
+	const std::string		&	cache_key
+)
+{
+	++resource_cache_lookup_count;
+
+	auto cached = resource_cache.find( cache_key );
+	if( cached == resource_cache.end() ) return nullptr;
+
+	++cached->second.reference_count;
+	++resource_cache_hit_count;
+	return cached->second.resource;
+}
+
+void vk2d::_internal::ResourceManagerImpl::RegisterCachedResource(
+	const std::string		&	cache_key,
+	vk2d::Resource			*	resource
+)
+{
+	ResourceCacheEntry entry {};
+	entry.resource			= resource;
+	entry.reference_count	= 1;
+	resource_cache.emplace( cache_key, entry );
+	resource->resource_impl->cache_key	= cache_key;
+}
+
+bool vk2d::_internal::ResourceManagerImpl::ReleaseCachedResource(
+	vk2d::Resource			*	resource
+)
+{
+	std::lock_guard<std::mutex> cache_lock( resource_cache_mutex );
+
+	auto & cache_key = resource->resource_impl->cache_key;
+	if( cache_key.empty() ) return true;
+
+	auto cached = resource_cache.find( cache_key );
+	if( cached == resource_cache.end() || cached->second.resource != resource ) return true;
+
+	if( --cached->second.reference_count ) return false;
+
+	resource_cache.erase( cached );
+	return true;
+}
+
+bool vk2d::_internal::ResourceManagerImpl::DetachCachedResource(
+	vk2d::Resource			*	resource
+)
+{
+	std::lock_guard<std::mutex> cache_lock( resource_cache_mutex );
+
+	auto & cache_key = resource->resource_impl->cache_key;
+	if( cache_key.empty() ) return true;
+
+	auto cached = resource_cache.find( cache_key );
+	if( cached != resource_cache.end() && cached->second.resource == resource ) {
+		if( cached->second.reference_count > 1 ) return false;
+		resource_cache.erase( cached );
+	}
+	cache_key.clear();
+	return true;
+}
+
+bool vk2d::_internal::ResourceManagerImpl::FindAssetPackItem(
+	const std::filesystem::path			&	path,
+	vk2d::_internal::AssetPackItem		&	out_item
+) const
+{
+	std::lock_guard<std::mutex> asset_packs_lock( asset_packs_mutex );
+	for( auto it = asset_packs.rbegin(); it != asset_packs.rend(); ++it ) {
+		if( ( *it )->Find( path, out_item ) ) return true;
+	}
+	return false;
+}
+
+std::unique_ptr<vk2d::TextureResource> vk2d::_internal::ResourceManagerImpl::CreateFileTextureResource(
+	const std::filesystem::path			&	file_path,
+	vk2d::Resource						*	parent_resource
+)
+{
+	// Files in asset packs load from the pack mapping, which stays valid for
+	// the lifetime of the resource manager.
+	vk2d::_internal::AssetPackItem pack_item {};
+	auto is_in_pack		= FindAssetPackItem( file_path, pack_item );
+	auto load_cost		= is_in_pack ?
+		vk2d::_internal::RESOURCE_LOAD_BASE_COST + uint64_t( pack_item.size ) :
+		vk2d::_internal::EstimateFileLoadCost( { file_path } );
+	auto loader_thread	= SelectLoaderThread( load_cost );
+	auto resource		= std::unique_ptr<vk2d::TextureResource>();
+	if( is_in_pack ) {
+		resource = std::unique_ptr<vk2d::TextureResource>(
+			new vk2d::TextureResource(
+				this,
+				loader_thread,
+				parent_resource,
+				pack_item.data,
+				pack_item.size )
+			);
+	} else {
+		resource = std::unique_ptr<vk2d::TextureResource>(
+			new vk2d::TextureResource(
+				this,
+				loader_thread,
+				parent_resource,
+				{ file_path } )
+			);
+	}
+	if( !resource || !resource->IsGood() ) {
+		// Could not create resource.
+		ReleaseLoaderThreadLoad( loader_thread, load_cost );
+		GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource handle!" );
+		return nullptr;
+	}
+	if( is_in_pack ) {
+		resource->impl->is_memory_persistent	= true;
+	}
+	if( is_in_pack && pack_item.payload == vk2d::_internal::AssetPackPayload::RAW_RGBA8 ) {
+		resource->impl->raw_memory_extent		= { pack_item.width, pack_item.height };
+	}
+	resource->resource_impl->load_cost	= load_cost;
+	return resource;
+}
+
+uint32_t vk2d::_internal::ResourceManagerImpl::SelectLoaderThread(
+	uint64_t		load_cost
+)
+{
+	return loader_threads[ loader_thread_balancer->Acquire( load_cost ) ];
+}
+
+void vk2d::_internal::ResourceManagerImpl::ReleaseLoaderThreadLoad(
+	uint32_t		loader_thread,
+	uint64_t		load_cost
+)
+{
+	auto it = std::find( loader_threads.begin(), loader_threads.end(), loader_thread );
+	if( it == loader_threads.end() ) return;
+
+	loader_thread_balancer->Release( size_t( it - loader_threads.begin() ), load_cost );
+}
+
+void vk2d::_internal::ResourceManagerImpl::MTDefragmentMemory(
+	vk2d::_internal::ThreadPrivateResource		*	thread_resource,
+	uint64_t										byte_budget,
+	uint64_t										release_epoch
+)
+{
+	auto loader_thread_resource	= dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
+	assert( loader_thread_resource );
+	if( !loader_thread_resource ) return;
+
+	auto memory_pool			= loader_thread_resource->GetDeviceMemoryPool();
+
+	loader_thread_resource->ProcessDeferredFrees();
+
+	auto textures = MTPinTextures( thread_resource );
+
+	// Release images moved in the previous round.
+	auto statistics_before = memory_pool->GetStatistics();
+	if( MTReleaseRetiredImages( thread_resource, textures, release_epoch ) ) {
+		auto statistics_after = memory_pool->GetStatistics();
+
+		// Unrelated allocations may have grown the pool in between, don't underflow.
+		if( statistics_before.reserved_size > statistics_after.reserved_size ) {
+			defragmentation_reclaimed_bytes			+= statistics_before.reserved_size - statistics_after.reserved_size;
+			defragmentation_released_chunk_count	+= statistics_before.chunk_count - statistics_after.chunk_count;
+		}
+	}
+
+	// Move textures out of chunks the memory pool wants emptied.
+	uint64_t moved_bytes = 0;
+	for( auto t : textures ) {
+		if( moved_bytes >= byte_budget ) break;
+
+		auto moved = t->MTRelocate( thread_resource );
+		if( moved ) {
+			moved_bytes		+= moved;
+			++defragmentation_moved_resource_count;
+		}
+	}
+	defragmentation_moved_bytes		+= moved_bytes;
+
+	UnpinTextures( textures );
+}
+
+void vk2d::_internal::ResourceManagerImpl::MTUpdateTextureResidency(
+	vk2d::_internal::ThreadPrivateResource		*	thread_resource,
+	uint64_t										release_epoch,
+	uint32_t										placeholder_size
+)
+{
+	auto loader_thread_resource	= dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
+	assert( loader_thread_resource );
+	if( !loader_thread_resource ) return;
+
+	loader_thread_resource->ProcessDeferredFrees();
+
+	auto textures = MTPinTextures( thread_resource );
+
+	// Release images replaced in the previous round first, that's what
+	// actually gives the memory of evicted textures back.
+	MTReleaseRetiredImages( thread_resource, textures, release_epoch );
+
+	for( auto t : textures ) {
+		auto action = t->residency_action.exchange( vk2d::_internal::TextureResidencyAction::NONE );
+		if( action == vk2d::_internal::TextureResidencyAction::EVICT ) {
+			if( t->MTEvict( thread_resource, placeholder_size ) ) {
+				++texture_eviction_count;
+			}
+		} else if( action == vk2d::_internal::TextureResidencyAction::RELOAD ) {
+			if( t->MTReload( thread_resource ) ) {
+				++texture_reload_count;
+			}
+		}
+	}
+
+	UnpinTextures( textures );
+}
+
+std::vector<vk2d::_internal::TextureResourceImpl*> vk2d::_internal::ResourceManagerImpl::MTPinTextures(
+	vk2d::_internal::ThreadPrivateResource		*	thread_resource
+)
+{
+	// Textures can be unloaded in any loader thread, pin the textures collected here
+	// while they're still in the resources list, unloading waits until they're unpinned.
+	auto thread_index = thread_resource->GetThreadIndex();
+	std::vector<vk2d::_internal::TextureResourceImpl*> textures;
+	resources.ForEach( [ thread_index, &textures ]( vk2d::Resource * r )
+		{
+			if( r->resource_impl->GetLoaderThread() != thread_index ) return;
+			auto texture_resource = dynamic_cast<vk2d::TextureResource*>( r );
+			if( texture_resource ) {
+				texture_resource->impl->PinRelocation();
+				textures.push_back( texture_resource->impl.get() );
+			}
+		} );
+	return textures;
+}
+
+void vk2d::_internal::ResourceManagerImpl::UnpinTextures(
+	const std::vector<vk2d::_internal::TextureResourceImpl*>	&	textures
+)
+{
+	for( auto t : textures ) {
+		t->UnpinRelocation();
+	}
+}
+
+bool vk2d::_internal::ResourceManagerImpl::MTReleaseRetiredImages(
+	vk2d::_internal::ThreadPrivateResource						*	thread_resource,
+	const std::vector<vk2d::_internal::TextureResourceImpl*>	&	textures,
+	uint64_t														release_epoch
+)
+{
+	// Frames that used images retired before an epoch were submitted before
+	// the render queues signal it. Anything newer waits for a later round.
+	release_epoch = std::min( release_epoch, GetCompletedRetiredImageEpoch() );
+
+	bool has_retired_images = std::any_of(
+		textures.begin(),
+		textures.end(),
+		[ release_epoch ]( vk2d::_internal::TextureResourceImpl * t ) { return t->HasRetiredImages( release_epoch ); }
+	);
+	if( !has_retired_images ) return false;
+
+	for( auto t : textures ) {
+		t->MTReleaseRetiredImages( thread_resource, release_epoch );
+	}
+	return true;
+}
+
+uint64_t vk2d::_internal::ResourceManagerImpl::BeginRetiredImageEpoch()
 {
-	auto load_thread = loader_threads[ current_loader_thread_index++ ];
-	if( current_loader_thread_index >= uint32_t( loader_threads.size() ) ) current_loader_thread_index = 0;
+	VK2D_ASSERT_MAIN_THREAD( instance );
+
+	retired_image_epoch_requested	= false;
+	uint64_t epoch					= ++retired_image_epoch;
+
+	std::array<vk2d::_internal::ResolvedQueue, 2> render_queues {
+		instance->GetPrimaryRenderQueue(),
+		instance->GetSecondaryRenderQueue()
+	};
+	for( size_t i = 0; i < std::size( render_queues ); ++i ) {
+		VkTimelineSemaphoreSubmitInfo timeline_submit_info {};
+		timeline_submit_info.sType						= VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		timeline_submit_info.pNext						= nullptr;
+		timeline_submit_info.waitSemaphoreValueCount	= 0;
+		timeline_submit_info.pWaitSemaphoreValues		= nullptr;
+		timeline_submit_info.signalSemaphoreValueCount	= 1;
+		timeline_submit_info.pSignalSemaphoreValues		= &epoch;
+
+		// Empty batch, signals once everything submitted to the queue before it has completed.
+		VkSubmitInfo submit_info {};
+		submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext					= &timeline_submit_info;
+		submit_info.waitSemaphoreCount		= 0;
+		submit_info.pWaitSemaphores			= nullptr;
+		submit_info.pWaitDstStageMask		= nullptr;
+		submit_info.commandBufferCount		= 0;
+		submit_info.pCommandBuffers			= nullptr;
+		submit_info.signalSemaphoreCount	= 1;
+		submit_info.pSignalSemaphores		= &vk_retired_image_epoch_semaphores[ i ];
+
+		// On failure retired images are kept until a later epoch is signaled.
+		auto result = render_queues[ i ].Submit( submit_info );
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot submit retired image epoch to render queue!" );
+		}
+	}
+	return epoch;
+}
 
-	return load_thread;
+void vk2d::_internal::ResourceManagerImpl::RequestRetiredImageEpoch()
+{
+	retired_image_epoch_requested	= true;
+}
+
+void vk2d::_internal::ResourceManagerImpl::BeginRequestedRetiredImageEpoch()
+{
+	if( retired_image_epoch_requested ) {
+		BeginRetiredImageEpoch();
+	}
+}
+
+uint64_t vk2d::_internal::ResourceManagerImpl::GetCompletedRetiredImageEpoch() const
+{
+	uint64_t completed_epoch = UINT64_MAX;
+	for( auto s : vk_retired_image_epoch_semaphores ) {
+		uint64_t value = 0;
+		auto result = vkGetSemaphoreCounterValue(
+			vk_device,
+			s,
+			&value
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot get retired image epoch semaphore value!" );
+			return 0;
+		}
+		completed_epoch = std::min( completed_epoch, value );
+	}
+	return completed_epoch;
 }
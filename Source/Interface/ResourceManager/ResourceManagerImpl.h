@@ -3,10 +3,15 @@
 #include "Core/SourceCommon.h"
 
 #include "System/ThreadPool.h"
+#include "System/SlotMap.hpp"
+#include "System/LoadBalancer.hpp"
+#include "System/AssetPack.hpp"
 
 #include "Types/Vector2.hpp"
 #include "Types/Color.hpp"
 
+#include "Interface/ResourceManager/ResourceManager.h"
+
 namespace vk2d {
 
 class ResourceManager;
@@ -20,6 +25,7 @@ class InstanceImpl;
 class ResourceManagerImpl;
 class ThreadPool;
 class ResourceImpl;
+class TextureResourceImpl;
 
 
 
@@ -55,7 +61,49 @@ private:
 
 
 
+// Moves textures of a single loader thread out of memory chunks that can be released.
+class ResourceThreadDefragmentTask : public vk2d::_internal::Task
+{
+public:
+	ResourceThreadDefragmentTask(
+		vk2d::_internal::ResourceManagerImpl	*	resource_manager,
+		uint64_t									byte_budget,
+		uint64_t									release_epoch );
+
+	void operator()( vk2d::_internal::ThreadPrivateResource * thread_resource );
+
+private:
+	vk2d::_internal::ResourceManagerImpl	*	resource_manager		= {};
+	uint64_t									byte_budget				= {};
+	uint64_t									release_epoch			= {};
+};
+
+
+
+// Evicts and reloads textures of a single loader thread as decided by
+// ResourceManagerImpl::UpdateTextureResidency().
+class ResourceThreadTextureResidencyTask : public vk2d::_internal::Task
+{
+public:
+	ResourceThreadTextureResidencyTask(
+		vk2d::_internal::ResourceManagerImpl	*	resource_manager,
+		uint64_t									release_epoch,
+		uint32_t									placeholder_size );
+
+	void operator()( vk2d::_internal::ThreadPrivateResource * thread_resource );
+
+private:
+	vk2d::_internal::ResourceManagerImpl	*	resource_manager		= {};
+	uint64_t									release_epoch			= {};
+	uint32_t									placeholder_size		= {};
+};
+
+
+
 class ResourceManagerImpl {
+	friend class vk2d::_internal::ResourceThreadDefragmentTask;
+	friend class vk2d::_internal::ResourceThreadTextureResidencyTask;
+
 public:
 	ResourceManagerImpl(
 		vk2d::ResourceManager								*	my_interface,
@@ -67,6 +115,15 @@ public:
 		const std::filesystem::path							&	file_path,
 		vk2d::Resource										*	parent_resource );
 
+	vk2d::TextureResource									*	LoadTextureResourceFromMemory(
+		const void											*	encoded_image_data,
+		size_t													encoded_image_size,
+		vk2d::Resource										*	parent_resource );
+
+	std::vector<vk2d::TextureResource*>							LoadTextureResources(
+		const std::vector<std::filesystem::path>				&	file_paths,
+		std::function<void( const vk2d::TextureBatchLoadProgress & )>	progress_callback );
+
 	vk2d::TextureResource									*	CreateTextureResource(
 		vk2d::Vector2u											size,
 		const std::vector<vk2d::Color8>						&	texture_data,
@@ -87,11 +144,78 @@ public:
 		uint32_t												glyph_texel_size,
 		bool													use_alpha,
 		uint32_t												fallback_character,
-		uint32_t												glyph_atlas_padding );
+		uint32_t												glyph_atlas_padding,
+		bool													load_glyphs_on_demand,
+		std::string_view										preload_characters );
+
+	vk2d::FontResource										*	LoadFontResourceFromMemory(
+		const void											*	font_file_data,
+		size_t													font_file_size,
+		vk2d::Resource										*	parent_resource,
+		uint32_t												glyph_texel_size,
+		bool													use_alpha,
+		uint32_t												fallback_character,
+		uint32_t												glyph_atlas_padding,
+		bool													load_glyphs_on_demand,
+		std::string_view										preload_characters );
+
+	bool														MountAssetPack(
+		const std::filesystem::path							&	pack_path );
 
 	void														DestroyResource(
 		vk2d::Resource										*	resource );
 
+	void														DefragmentMemory(
+		uint64_t												byte_budget );
+
+	vk2d::MemoryDefragmentationReport							GetMemoryDefragmentationReport() const;
+
+	void														SetTextureResidencyBudget(
+		uint64_t												byte_budget,
+		uint32_t												placeholder_size );
+
+	void														UpdateTextureResidency();
+
+	vk2d::TextureResidencyReport								GetTextureResidencyReport() const;
+
+	void														SetTextureMipGeneration(
+		const vk2d::TextureMipGenerationSettings			&	settings );
+
+	vk2d::TextureMipGenerationSettings							GetTextureMipGeneration() const;
+
+	// Textures stamp images they replace with this, only the main thread
+	// increments it and only outside rendering. Every frame that could use an
+	// image retired before epoch N has been submitted when epoch N begins.
+	uint64_t													GetRetiredImageEpoch() const;
+
+	// Something was retired that should be released without waiting for the
+	// next defragmentation or residency round. Any thread.
+	void														RequestRetiredImageEpoch();
+
+	// Main thread only, outside rendering. Begins a new retired image epoch
+	// if one was requested since the previous one began.
+	void														BeginRequestedRetiredImageEpoch();
+
+	// Newest epoch every render queue has signaled, doesn't wait.
+	uint64_t													GetCompletedRetiredImageEpoch() const;
+
+	vk2d::ResourceCacheStatistics								GetResourceCacheStatistics() const;
+
+	// Takes a resource out of the cache before its contents are changed so that
+	// later loads don't get the changed resource. Returns false if the resource
+	// is shared by more than one reference, it must not be changed then.
+	bool														DetachCachedResource(
+		vk2d::Resource										*	resource );
+
+	std::string													GetLoadTimingReport(
+		vk2d::LoadTimingReportFormat							format );
+
+	// Called when a resource has been loaded, or failed to load,
+	// see SelectLoaderThread().
+	void														ReleaseLoaderThreadLoad(
+		uint32_t												loader_thread,
+		uint64_t												load_cost );
+
 	vk2d::_internal::InstanceImpl							*	GetInstance() const;
 	vk2d::_internal::ThreadPool								*	GetThreadPool() const;
 	const std::vector<uint32_t>								&	GetLoaderThreads() const;
@@ -101,17 +225,119 @@ public:
 	bool														IsGood() const;
 
 private:
-	// CALL ONLY FROM "AttachResource()".
+	// CALL ONLY FROM "AttachResource()" or "LoadTextureResources()".
 	// Schedules the resource to be loaded after it's attached.
 	void														ScheduleResourceLoad(
 		vk2d::Resource										*	resource_ptr );
 
-	// Some resources will need to use the same thread where they were
-	// originally created, for example if a resource uses a memory pool
-	// from a thread, memory should be freed to the same thread memory
-	// pool, idea of per thread resource scheme is to reduce mutex usage.
+	// CALL ONLY FROM "AttachResource()" or "LoadTextureResources()".
+	// Takes ownership of the resource, returns false if the resource could not be stored.
+	bool														InsertResource(
+		std::unique_ptr<vk2d::Resource>							resource );
+
+	// Resources are loaded in the selected thread and use its memory pool and
+	// command pools, idea of per thread resource scheme is to reduce mutex usage.
+	// Other threads give memory back to the owning thread through deferred
+	// frees, so only resources that hold other thread bound objects, for
+	// example FreeType faces, need to unload in the same thread.
 	// This is just to select a loader thread prior to resource loading.
-	uint32_t													SelectLoaderThread();
+	// Picks the loader thread with the least load queued, load cost must be
+	// given back with ReleaseLoaderThreadLoad() once the load is done.
+	uint32_t													SelectLoaderThread(
+		uint64_t												load_cost );
+
+	// Looks up a path from mounted asset packs, most recently mounted first.
+	bool														FindAssetPackItem(
+		const std::filesystem::path							&	path,
+		vk2d::_internal::AssetPackItem						&	out_item ) const;
+
+	// Creates a single layer texture resource for a file, from a mounted asset
+	// pack if the file is in one. Selects the loader thread and sets the load cost.
+	std::unique_ptr<vk2d::TextureResource>						CreateFileTextureResource(
+		const std::filesystem::path							&	file_path,
+		vk2d::Resource										*	parent_resource );
+
+	// Runs in a loader thread, see ResourceThreadDefragmentTask.
+	void														MTDefragmentMemory(
+		vk2d::_internal::ThreadPrivateResource				*	thread_resource,
+		uint64_t												byte_budget,
+		uint64_t												release_epoch );
+
+	// Runs in a loader thread, see ResourceThreadTextureResidencyTask.
+	void														MTUpdateTextureResidency(
+		vk2d::_internal::ThreadPrivateResource				*	thread_resource,
+		uint64_t												release_epoch,
+		uint32_t												placeholder_size );
+
+	// Runs in a loader thread. Pins every texture loaded in the loader thread,
+	// unloading waits until they're unpinned with UnpinTextures().
+	std::vector<vk2d::_internal::TextureResourceImpl*>			MTPinTextures(
+		vk2d::_internal::ThreadPrivateResource				*	thread_resource );
+
+	void														UnpinTextures(
+		const std::vector<vk2d::_internal::TextureResourceImpl*>	&	textures );
+
+	// Main thread only, outside rendering. Begins a new retired image epoch and
+	// queues a signal of it on the retired image epoch semaphore of each render
+	// queue, after every frame submitted so far. Returns the new epoch.
+	uint64_t													BeginRetiredImageEpoch();
+
+	// Runs in a loader thread. Destroys images the textures retired before
+	// release_epoch, or before the newest epoch the render queues have finished
+	// if that's older. Never waits for the render queues, images still in use
+	// are released in a later round. Returns false if nothing was released.
+	bool														MTReleaseRetiredImages(
+		vk2d::_internal::ThreadPrivateResource				*	thread_resource,
+		const std::vector<vk2d::_internal::TextureResourceImpl*>	&	textures,
+		uint64_t												release_epoch );
+
+	// CALL ONLY while holding resource_cache_mutex.
+	// Returns an existing resource and adds a reference to it, nullptr if not cached.
+	vk2d::Resource											*	AcquireCachedResource(
+		const std::string									&	cache_key );
+
+	// CALL ONLY while holding resource_cache_mutex.
+	void														RegisterCachedResource(
+		const std::string									&	cache_key,
+		vk2d::Resource										*	resource );
+
+	// Removes a reference from a shared resource. Returns true if the resource
+	// should be destroyed, false if it's still in use elsewhere.
+	bool														ReleaseCachedResource(
+		vk2d::Resource										*	resource );
+
+	// Returns an existing resource with the same cache key and adds a reference
+	// to it, or creates a new resource with create_function and attaches it.
+	// Empty cache key skips the cache, create_function returns std::unique_ptr<T>.
+	template<typename T, typename CreateFunctionT>
+	T														*	AttachCachedResource(
+		const std::string									&	cache_key,
+		CreateFunctionT										&&	create_function )
+	{
+		if( cache_key.empty() ) {
+			auto resource = create_function();
+			if( !resource ) return nullptr;
+			return AttachResource( std::move( resource ) );
+		}
+
+		// Lock is held while creating so two threads loading the same
+		// file at once can't both miss, creation itself is cheap as the
+		// actual loading happens later in a loader thread.
+		std::lock_guard<std::mutex> cache_lock( resource_cache_mutex );
+
+		auto cached = AcquireCachedResource( cache_key );
+		if( cached ) {
+			return static_cast<T*>( cached );
+		}
+
+		auto resource = create_function();
+		if( !resource ) return nullptr;
+		auto resource_ptr = AttachResource( std::move( resource ) );
+		if( resource_ptr ) {
+			RegisterCachedResource( cache_key, resource_ptr );
+		}
+		return resource_ptr;
+	}
 
 	// Take ownership of the resource and put it into a load queue.
 	// Returns raw pointer to the resource after it's been attached.
@@ -120,8 +346,7 @@ private:
 		std::unique_ptr<T>										resource )
 	{
 		auto resource_ptr = resource.get();
-		std::lock_guard<std::recursive_mutex>		resources_lock( resources_mutex );
-		resources.push_back( std::move( resource ) );
+		if( !InsertResource( std::move( resource ) ) ) return nullptr;
 		ScheduleResourceLoad( resource_ptr );
 		return resource_ptr;
 	}
@@ -134,12 +359,51 @@ private:
 	std::vector<uint32_t>										loader_threads						= {};
 	std::vector<uint32_t>										general_threads						= {};
 
-	// TODO: This only cycles through loader threads for every new load operation,
-	// a more advanced load balancer could be more appropriate, for now it's no big deal.
-	uint32_t													current_loader_thread_index			= {};
-
-	std::recursive_mutex										resources_mutex						= {};
-	std::list<std::unique_ptr<vk2d::Resource>>					resources							= {};
+	// Workers map to loader_threads by index. Load is the estimated cost of
+	// resources queued to the thread but not yet loaded.
+	std::unique_ptr<vk2d::_internal::LoadBalancer>				loader_thread_balancer				= {};
+
+	// Packs stay mapped until the resource manager is destroyed, resources
+	// loaded from them refer to the mapping directly. Never removed so
+	// pointers stay valid without holding the lock.
+	mutable std::mutex											asset_packs_mutex;
+	std::vector<std::unique_ptr<vk2d::_internal::AssetPack>>	asset_packs							= {};
+
+	// Resources are created and destroyed from any thread, slot map keeps
+	// that O(1) and the lock short regardless of how many resources exist.
+	vk2d::_internal::SlotMap<vk2d::Resource>					resources;
+
+	// Resources that can be shared, keyed by what they were loaded from.
+	struct ResourceCacheEntry {
+		vk2d::Resource										*	resource							= {};
+		uint32_t												reference_count						= {};
+	};
+	mutable std::mutex											resource_cache_mutex;
+	std::unordered_map<std::string, ResourceCacheEntry>			resource_cache						= {};
+	std::atomic<uint64_t>										resource_cache_lookup_count			= {};
+	std::atomic<uint64_t>										resource_cache_hit_count			= {};
+
+	std::atomic<uint32_t>										defragmentation_tasks_in_flight		= {};
+	std::atomic<uint64_t>										defragmentation_moved_bytes			= {};
+	std::atomic<uint64_t>										defragmentation_moved_resource_count	= {};
+	std::atomic<uint64_t>										defragmentation_reclaimed_bytes		= {};
+	std::atomic<uint64_t>										defragmentation_released_chunk_count	= {};
+
+	std::atomic<uint64_t>										retired_image_epoch					= {};
+	std::array<VkSemaphore, 2>									vk_retired_image_epoch_semaphores	= {};	// Timeline, primary and secondary render queue.
+	std::atomic<bool>											retired_image_epoch_requested		= {};
+
+	std::atomic<uint64_t>										texture_residency_budget			= {};
+	std::atomic<uint32_t>										texture_residency_placeholder_size	= {};
+	uint64_t													texture_residency_tick				= {};	// Main thread only.
+	std::atomic<uint32_t>										texture_residency_tasks_in_flight	= {};
+	std::atomic<uint64_t>										texture_residency_resident_bytes	= {};
+	std::atomic<uint64_t>										texture_residency_evicted_count		= {};
+	std::atomic<uint64_t>										texture_eviction_count				= {};
+	std::atomic<uint64_t>										texture_reload_count				= {};
+
+	mutable std::mutex											texture_mip_generation_mutex;
+	vk2d::TextureMipGenerationSettings							texture_mip_generation_settings		= {};
 
 	bool														is_good								= {};
 };
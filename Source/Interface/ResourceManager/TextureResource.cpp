@@ -1,10 +1,15 @@
 
 #include "Core/SourceCommon.h"
 
+#include "System/ThreadPool.h"
 #include "System/ThreadPrivateResources.h"
 #include "System/DescriptorSet.h"
 #include "System/CommonTools.h"
 #include "System/ImageFormatConverter.hpp"
+#include "System/TextureUploadBatch.h"
+#include "System/TextureContainer.hpp"
+#include "System/QOI.hpp"
+#include "System/MipGenerator.hpp"
 
 #include "Interface/Instance.h"
 #include "Interface/InstanceImpl.h"
@@ -17,6 +22,363 @@
 
 #include <stb_image.h>
 
+#include <fstream>
+
+
+
+namespace vk2d {
+namespace _internal {
+
+// Records a layout transition of a range of mip levels of every layer of a texture image.
+void CmdTransitionTextureImageLayout(
+	VkCommandBuffer						command_buffer,
+	VkImage								image,
+	VkImageLayout						old_layout,
+	VkImageLayout						new_layout,
+	uint32_t							base_mip_level,
+	uint32_t							mip_level_count,
+	uint32_t							layer_count
+)
+{
+	VkImageMemoryBarrier image_memory_barrier {};
+	image_memory_barrier.sType								= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	image_memory_barrier.pNext								= nullptr;
+	image_memory_barrier.srcAccessMask						= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+	image_memory_barrier.dstAccessMask						= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+	image_memory_barrier.oldLayout							= old_layout;
+	image_memory_barrier.newLayout							= new_layout;
+	image_memory_barrier.srcQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
+	image_memory_barrier.dstQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
+	image_memory_barrier.image								= image;
+	image_memory_barrier.subresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	image_memory_barrier.subresourceRange.baseMipLevel		= base_mip_level;
+	image_memory_barrier.subresourceRange.levelCount		= mip_level_count;
+	image_memory_barrier.subresourceRange.baseArrayLayer	= 0;
+	image_memory_barrier.subresourceRange.layerCount		= layer_count;
+	vkCmdPipelineBarrier(
+		command_buffer,
+		VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+		VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+		0,
+		0, nullptr,
+		0, nullptr,
+		1, &image_memory_barrier
+	);
+}
+
+// Records a barrier of a range of mip levels of a single layer of a texture image.
+// Queue family indices are VK_QUEUE_FAMILY_IGNORED unless ownership is transferred.
+void CmdTextureLayerBarrier(
+	VkCommandBuffer						command_buffer,
+	VkImage								image,
+	uint32_t							layer,
+	uint32_t							base_mip_level,
+	uint32_t							mip_level_count,
+	VkPipelineStageFlags				src_stage,
+	VkPipelineStageFlags				dst_stage,
+	VkAccessFlags						src_access,
+	VkAccessFlags						dst_access,
+	VkImageLayout						old_layout,
+	VkImageLayout						new_layout,
+	uint32_t							src_queue_family_index		= VK_QUEUE_FAMILY_IGNORED,
+	uint32_t							dst_queue_family_index		= VK_QUEUE_FAMILY_IGNORED
+)
+{
+	VkImageMemoryBarrier image_memory_barrier {};
+	image_memory_barrier.sType								= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	image_memory_barrier.pNext								= nullptr;
+	image_memory_barrier.srcAccessMask						= src_access;
+	image_memory_barrier.dstAccessMask						= dst_access;
+	image_memory_barrier.oldLayout							= old_layout;
+	image_memory_barrier.newLayout							= new_layout;
+	image_memory_barrier.srcQueueFamilyIndex				= src_queue_family_index;
+	image_memory_barrier.dstQueueFamilyIndex				= dst_queue_family_index;
+	image_memory_barrier.image								= image;
+	image_memory_barrier.subresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	image_memory_barrier.subresourceRange.baseMipLevel		= base_mip_level;
+	image_memory_barrier.subresourceRange.levelCount		= mip_level_count;
+	image_memory_barrier.subresourceRange.baseArrayLayer	= layer;
+	image_memory_barrier.subresourceRange.layerCount		= 1;
+	vkCmdPipelineBarrier(
+		command_buffer,
+		src_stage,
+		dst_stage,
+		0,
+		0, nullptr,
+		0, nullptr,
+		1, &image_memory_barrier
+	);
+}
+
+// Extent of every mip level, unlike GenerateMipSizes() this works for any mip level count.
+std::vector<VkExtent2D> GetMipLevelExtents(
+	VkExtent2D							extent,
+	uint32_t							mip_level_count
+)
+{
+	std::vector<VkExtent2D> mip_level_extents( mip_level_count );
+	for( uint32_t i = 0; i < mip_level_count; ++i ) {
+		mip_level_extents[ i ] = { std::max( extent.width >> i, 1U ), std::max( extent.height >> i, 1U ) };
+	}
+	return mip_level_extents;
+}
+
+VkFormat GetTextureContainerVulkanFormat(
+	vk2d::_internal::TextureContainerFormat		format
+)
+{
+	switch( format ) {
+		case vk2d::_internal::TextureContainerFormat::R8G8B8A8_UNORM:
+			return VK_FORMAT_R8G8B8A8_UNORM;
+		case vk2d::_internal::TextureContainerFormat::B8G8R8A8_UNORM:
+			return VK_FORMAT_B8G8R8A8_UNORM;
+		case vk2d::_internal::TextureContainerFormat::BC1_RGB_UNORM:
+			return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+		case vk2d::_internal::TextureContainerFormat::BC1_RGBA_UNORM:
+			return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+		case vk2d::_internal::TextureContainerFormat::BC2_UNORM:
+			return VK_FORMAT_BC2_UNORM_BLOCK;
+		case vk2d::_internal::TextureContainerFormat::BC3_UNORM:
+			return VK_FORMAT_BC3_UNORM_BLOCK;
+		case vk2d::_internal::TextureContainerFormat::BC4_UNORM:
+			return VK_FORMAT_BC4_UNORM_BLOCK;
+		case vk2d::_internal::TextureContainerFormat::BC5_UNORM:
+			return VK_FORMAT_BC5_UNORM_BLOCK;
+		case vk2d::_internal::TextureContainerFormat::BC6H_UFLOAT:
+			return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+		case vk2d::_internal::TextureContainerFormat::BC6H_SFLOAT:
+			return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+		case vk2d::_internal::TextureContainerFormat::BC7_UNORM:
+			return VK_FORMAT_BC7_UNORM_BLOCK;
+		default:
+			return VK_FORMAT_UNDEFINED;
+	}
+}
+
+// True if textures can be sampled from images of this format, and mip levels
+// blitted if generate_mip_levels is set.
+bool IsTextureFormatUsable(
+	vk2d::_internal::InstanceImpl		*	instance,
+	VkFormat								format,
+	bool									generate_mip_levels
+)
+{
+	if( format == VK_FORMAT_UNDEFINED ) return false;
+
+	VkFormatProperties format_properties {};
+	vkGetPhysicalDeviceFormatProperties(
+		instance->GetVulkanPhysicalDevice(),
+		format,
+		&format_properties
+	);
+	VkFormatFeatureFlags required_features =
+		VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+		VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT |
+		VK_FORMAT_FEATURE_TRANSFER_SRC_BIT |
+		VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+	if( generate_mip_levels ) {
+		required_features |= VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+	}
+	return ( format_properties.optimalTilingFeatures & required_features ) == required_features;
+}
+
+
+
+// Image file read and decoded to RGBA texels, see ArrayLayerDecodeJob.
+// KTX2 and DDS containers are not decoded here, their file contents are
+// kept as is in container_data, see TextureResourceImpl::MTStageTextureContainer().
+struct DecodedImageLayer {
+	stbi_uc								*	texels					= {};
+	std::vector<uint8_t>					qoi_texels				= {};	// Used instead of texels for QOI images.
+	std::vector<uint8_t>					container_data			= {};
+	std::vector<std::vector<uint8_t>>		mip_levels				= {};	// Levels 1 and up if made on the CPU.
+	int										size_x					= {};
+	int										size_y					= {};
+	uint64_t								file_size				= {};
+	std::chrono::nanoseconds				file_read_time			= {};
+	std::chrono::nanoseconds				decode_time				= {};
+	std::chrono::nanoseconds				mip_generation_time		= {};
+	bool									is_attempted			= {};	// False if skipped because another layer failed.
+	bool									is_decoded				= {};
+};
+
+void DecodeImageFile(
+	const std::filesystem::path					&	path,
+	const vk2d::TextureMipGenerationSettings	&	mip_generation_settings,
+	vk2d::_internal::DecodedImageLayer			&	out_layer
+)
+{
+	// File is read separately from decoding so load timing can tell them apart.
+	auto file_read_begin = std::chrono::steady_clock::now();
+	std::vector<uint8_t> file_data;
+	{
+		std::ifstream file( path, std::ios::binary | std::ios::ate );
+		if( file ) {
+			file_data.resize( size_t( file.tellg() ) );
+			file.seekg( 0 );
+			file.read( reinterpret_cast<char*>( file_data.data() ), std::streamsize( file_data.size() ) );
+		}
+		if( !file ) file_data.clear();
+	}
+	auto decode_begin = std::chrono::steady_clock::now();
+	out_layer.file_read_time	= decode_begin - file_read_begin;
+	out_layer.file_size			= uint64_t( file_data.size() );
+
+	if( vk2d::_internal::IsTextureContainer( file_data.data(), file_data.size() ) ) {
+		out_layer.container_data	= std::move( file_data );
+		out_layer.is_attempted		= true;
+		out_layer.is_decoded		= true;
+		return;
+	}
+
+	int channels = 0;
+	if( vk2d::_internal::IsQOIImage( file_data.data(), file_data.size() ) ) {
+		uint32_t size_x = 0;
+		uint32_t size_y = 0;
+		if( vk2d::_internal::DecodeQOI( file_data.data(), file_data.size(), out_layer.qoi_texels, size_x, size_y ) ) {
+			out_layer.size_x	= int( size_x );
+			out_layer.size_y	= int( size_y );
+		}
+	} else if( !file_data.empty() && file_data.size() <= size_t( std::numeric_limits<int>::max() ) ) {
+		out_layer.texels = stbi_load_from_memory(
+			file_data.data(),
+			int( file_data.size() ),
+			&out_layer.size_x,
+			&out_layer.size_y,
+			&channels,
+			4 );
+	}
+	auto mip_generation_begin	= std::chrono::steady_clock::now();
+	out_layer.decode_time		= mip_generation_begin - decode_begin;
+	out_layer.is_attempted		= true;
+	out_layer.is_decoded		= out_layer.texels || !out_layer.qoi_texels.empty();
+
+	// Mip levels are made here so array texture layers make theirs in parallel.
+	if( out_layer.is_decoded && mip_generation_settings.filter != vk2d::TextureMipFilter::GPU_LINEAR ) {
+		auto texels = out_layer.texels ? static_cast<const uint8_t*>( out_layer.texels ) : out_layer.qoi_texels.data();
+
+		vk2d::_internal::MipCacheKey cache_key {};
+		std::filesystem::path cache_path;
+		if( mip_generation_settings.use_cache ) {
+			cache_key.source_hash	= vk2d::_internal::HashBytes( file_data.data(), file_data.size() );
+			cache_key.source_size	= uint64_t( file_data.size() );
+			cache_key.width			= uint32_t( out_layer.size_x );
+			cache_key.height		= uint32_t( out_layer.size_y );
+			cache_key.filter		= mip_generation_settings.filter;
+			cache_key.gamma_correct	= mip_generation_settings.gamma_correct;
+			cache_path				= vk2d::_internal::GetMipCachePath( path, mip_generation_settings.cache_directory, cache_key.source_hash );
+		}
+		if( !mip_generation_settings.use_cache || !vk2d::_internal::ReadMipCacheFile( cache_path, cache_key, out_layer.mip_levels ) ) {
+			vk2d::_internal::GenerateMipLevels(
+				texels,
+				uint32_t( out_layer.size_x ),
+				uint32_t( out_layer.size_y ),
+				mip_generation_settings.filter,
+				mip_generation_settings.gamma_correct,
+				out_layer.mip_levels
+			);
+			// Cache is best effort, a read only directory just means no cache.
+			if( mip_generation_settings.use_cache ) {
+				vk2d::_internal::WriteMipCacheFile( cache_path, cache_key, out_layer.mip_levels );
+			}
+		}
+		out_layer.mip_generation_time = std::chrono::steady_clock::now() - mip_generation_begin;
+	}
+}
+
+
+
+// Decodes every layer of an array texture. The loader thread decodes layers
+// itself and general threads help out by running ArrayLayerDecodeTask, each
+// thread takes the next layer nobody has started yet. The loader thread never
+// waits for a layer that has not been started, so busy general threads only
+// make the load slower, never stall it. Shared with the tasks as they may run
+// after the loader thread is done with the job.
+class ArrayLayerDecodeJob {
+public:
+	ArrayLayerDecodeJob(
+		const std::vector<std::filesystem::path>	&	file_paths,
+		const vk2d::TextureMipGenerationSettings	&	mip_generation_settings
+	) :
+		file_paths( file_paths ),
+		mip_generation_settings( mip_generation_settings ),
+		layers( file_paths.size() )
+	{}
+
+	~ArrayLayerDecodeJob()
+	{
+		for( auto & l : layers ) {
+			stbi_image_free( l.texels );
+		}
+	}
+
+	// Decodes layers until every layer has been started.
+	void										Run()
+	{
+		while( true ) {
+			auto index = next_layer.fetch_add( 1 );
+			if( index >= layers.size() ) return;
+
+			// No point in decoding the rest if the texture cannot be created anyways.
+			if( !is_failed ) {
+				vk2d::_internal::DecodeImageFile( file_paths[ index ], mip_generation_settings, layers[ index ] );
+				if( !layers[ index ].is_decoded ) is_failed = true;
+			}
+
+			std::lock_guard<std::mutex> lock( finished_mutex );
+			if( ++finished_count == layers.size() ) {
+				finished_condition.notify_all();
+			}
+		}
+	}
+
+	// Waits until every layer has been decoded or has failed.
+	void										Wait()
+	{
+		std::unique_lock<std::mutex> lock( finished_mutex );
+		finished_condition.wait( lock, [ this ]() { return finished_count == layers.size(); } );
+	}
+
+	// Only access after Wait().
+	std::vector<vk2d::_internal::DecodedImageLayer>	&	GetLayers()
+	{
+		return layers;
+	}
+
+private:
+	std::vector<std::filesystem::path>					file_paths;
+	vk2d::TextureMipGenerationSettings					mip_generation_settings;
+	std::vector<vk2d::_internal::DecodedImageLayer>		layers;
+	std::atomic<size_t>									next_layer				= {};
+	std::atomic_bool									is_failed				= {};
+
+	std::mutex											finished_mutex;
+	std::condition_variable								finished_condition;
+	size_t												finished_count			= {};
+};
+
+class ArrayLayerDecodeTask : public vk2d::_internal::Task
+{
+public:
+	ArrayLayerDecodeTask(
+		std::shared_ptr<vk2d::_internal::ArrayLayerDecodeJob>		decode_job
+	) :
+		decode_job( std::move( decode_job ) )
+	{}
+
+	void											operator()(
+		[[maybe_unused]] vk2d::_internal::ThreadPrivateResource	*	thread_resource )
+	{
+		decode_job->Run();
+	}
+
+private:
+	std::shared_ptr<vk2d::_internal::ArrayLayerDecodeJob>			decode_job;
+};
+
+} // _internal
+} // vk2d
+
 
 
 
@@ -87,6 +449,32 @@ VK2D_API vk2d::TextureResource::TextureResource(
 	texture_impl	= impl.get();
 }
 
+VK2D_API vk2d::TextureResource::TextureResource(
+	vk2d::_internal::ResourceManagerImpl		*	resource_manager,
+	uint32_t										loader_thread,
+	vk2d::Resource								*	parent_resource,
+	const void									*	encoded_image_data,
+	size_t											encoded_image_size
+)
+{
+	impl = std::make_unique<vk2d::_internal::TextureResourceImpl>(
+		this,
+		resource_manager,
+		loader_thread,
+		parent_resource,
+		encoded_image_data,
+		encoded_image_size
+	);
+	if( !impl || !impl->IsGood() ) {
+		impl	= nullptr;
+		resource_manager->GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource implementation!" );
+		return;
+	}
+
+	resource_impl	= impl.get();
+	texture_impl	= impl.get();
+}
+
 VK2D_API vk2d::TextureResource::~TextureResource()
 {}
 
@@ -119,6 +507,16 @@ VK2D_API uint32_t VK2D_APIENTRY vk2d::TextureResource::GetLayerCount() const
 	return impl->GetLayerCount();
 }
 
+VK2D_API bool VK2D_APIENTRY vk2d::TextureResource::UpdateRegion(
+	vk2d::Rect2u							area,
+	uint32_t								layer,
+	const std::vector<vk2d::Color8>		&	texels,
+	bool									update_mip_levels
+)
+{
+	return impl->UpdateRegion( area, layer, texels, update_mip_levels );
+}
+
 VK2D_API bool VK2D_APIENTRY vk2d::TextureResource::IsGood() const
 {
 	return !!impl;
@@ -198,9 +596,48 @@ vk2d::_internal::TextureResourceImpl::TextureResourceImpl(
 	is_good						= true;
 }
 
+vk2d::_internal::TextureResourceImpl::TextureResourceImpl(
+	vk2d::TextureResource						*	my_interface,
+	vk2d::_internal::ResourceManagerImpl		*	resource_manager,
+	uint32_t										loader_thread,
+	vk2d::Resource								*	parent_resource,
+	const void									*	encoded_image_data,
+	size_t											encoded_image_size
+) :
+	vk2d::_internal::ResourceImpl(
+		my_interface,
+		loader_thread,
+		resource_manager,
+		parent_resource,
+		encoded_image_data,
+		encoded_image_size
+	)
+{
+	assert( my_interface );
+	assert( resource_manager );
+
+	this->my_interface			= my_interface;
+	this->resource_manager		= resource_manager;
+
+	is_good						= true;
+}
+
 bool vk2d::_internal::TextureResourceImpl::MTLoad(
 	vk2d::_internal::ThreadPrivateResource	*	thread_resource
 )
+{
+	auto success = MTLoadTexture( thread_resource );
+
+	// Batch waits for every texture before submitting, including those that failed.
+	if( upload_batch ) {
+		upload_batch->MTFinishTexture( GetLoaderThread(), success );
+	}
+	return success;
+}
+
+bool vk2d::_internal::TextureResourceImpl::MTLoadTexture(
+	vk2d::_internal::ThreadPrivateResource	*	thread_resource
+)
 {
 	auto result = VK_SUCCESS;
 
@@ -215,11 +652,12 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 	// 9. Allocate descriptor set that points to the image.
 
 	loader_thread_resource	= dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
-	auto memory_pool		= loader_thread_resource->GetDeviceMemoryPool();
 
 	assert( loader_thread_resource );
 	if( !loader_thread_resource ) return false;
 
+	auto memory_pool		= loader_thread_resource->GetDeviceMemoryPool();
+
 	// Get data into a staging buffer, and create staging buffer
 	struct
 	{
@@ -234,110 +672,59 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 	auto secondary_render_queue_family_index	= instance->GetSecondaryRenderQueue().GetQueueFamilyIndex();
 	auto primary_transfer_queue_family_index	= instance->GetPrimaryTransferQueue().GetQueueFamilyIndex();
 
-	bool is_primary_render_needed				= secondary_render_queue_family_index != primary_render_queue_family_index;
-
-	if( IsFromFile() ) {
-		// 1. Load and process images from files.
-
-		for( auto & path : GetFilePaths() ) {
-			// Create texture from a file
-			int image_size_x				= 0;
-			int image_size_y				= 0;
-			int stbi_image_channel_count	= 0;
-			uint32_t image_channel_count	= 4;
-
-			auto stbi_image_data = stbi_load(
-				path.string().c_str(),
-				&image_size_x,
-				&image_size_y,
-				&stbi_image_channel_count,
-				4 );
-			if( !stbi_image_data ) {
-				instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create texture: Cannot load image file: " + path.string() );
-				return false;
-			}
-
-			// Check that file images have the same dimensions if we're creating array textures.
-			if( image_info.x == UINT32_MAX ) {
-				// First image
-				image_info.x		= uint32_t( image_size_x );
-				image_info.y		= uint32_t( image_size_y );
-			} else {
-				if( image_info.x != image_size_x ||
-					image_info.y != image_size_y ) {
-					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create array texture: File images are different dimensions!" );
-					stbi_image_free( stbi_image_data );
-					return false;
-				}
-			}
-
-			// 2. Create staging buffer, we'll also need memory pool for this.
-
-			auto staging_buffer = memory_pool->CreateCompleteHostBufferResourceWithData(
-				stbi_image_data,
-				VkDeviceSize( image_size_x ) * VkDeviceSize( image_size_y ) * VkDeviceSize( image_channel_count ),
-				VK_BUFFER_USAGE_TRANSFER_SRC_BIT
-			);
-
-			stbi_image_free( stbi_image_data );
-
-			if( staging_buffer != VK_SUCCESS ) {
-				instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource staging buffer!" );
-				return false;
-			}
-			staging_buffers.push_back( std::move( staging_buffer ) );
+	// 1. and 2.
+	mip_generation_settings = resource_manager->GetTextureMipGeneration();
+	vk2d::_internal::TextureStagingInfo staging_info {};
+	if( !MTDecodeToStagingBuffers( loader_thread_resource, staging_buffers, staging_info ) ) {
+		return false;
+	}
+	extent				= staging_info.extent;
+	image_info.x		= extent.width;
+	image_info.y		= extent.height;
+	image_info.channels	= 4;
 
-			// Set image extent so we'll know it later
-			extent				= { uint32_t( image_size_x ), uint32_t( image_size_y ) };
+	image_layer_count		= staging_info.layer_count;
+	if( !image_layer_count ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot load texture, nothing to do!" );
+		return false;
+	}
 
-			image_info.x		= uint32_t( image_size_x );
-			image_info.y		= uint32_t( image_size_y );
-			image_info.channels	= uint32_t( image_channel_count );
+	auto upload_record_begin = std::chrono::steady_clock::now();
+	{
+		uint64_t uploaded_bytes = 0;
+		for( auto & sb : staging_buffers ) {
+			uploaded_bytes += uint64_t( sb.size );
 		}
-	} else {
-		for( size_t i = 0; i < texture_data.size(); ++i ) {
-			// Create texture from data
-
-			// Image extent already set by resource manager, we can just use it.
-			image_info.x		= extent.width;
-			image_info.y		= extent.height;
-			image_info.channels	= 4;
-
-			if( texture_data[ i ].size() < size_t( image_info.x ) * size_t( image_info.y ) ) {
-				instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create texture: Texture data too small for texture" );
-				return false;
-			}
-
-			auto staging_buffer = memory_pool->CreateCompleteHostBufferResourceWithData(
-				texture_data[ i ],
-				VK_BUFFER_USAGE_TRANSFER_SRC_BIT
-			);
-
-			if( staging_buffer != VK_SUCCESS ) {
-				instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource staging buffer!" );
-				return false;
-			}
-			staging_buffers.push_back( std::move( staging_buffer ) );
+		for( auto & streamed_image : staging_info.streamed_images ) {
+			uploaded_bytes += uint64_t( streamed_image.texels.size() );
 		}
+		AddLoadBytes( &vk2d::ResourceLoadTiming::uploaded_bytes, uploaded_bytes );
 	}
 
-	image_layer_count		= uint32_t( staging_buffers.size() );
-	if( !image_layer_count ) {
-		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot load texture, nothing to do!" );
-		return false;
+	if( upload_batch ) {
+		upload_batch->MTTextureDecoded();
 	}
 
 	// 3. Create image and image view Vulkan objects.
-	auto mipmap_levels = vk2d::_internal::GenerateMipSizes(
-		vk2d::Vector2u( image_info.x, image_info.y )
-	);
+	// Mip levels stored in a texture container are uploaded as is, nothing is blitted.
+	auto mipmap_levels = staging_info.generate_mip_levels ?
+		vk2d::_internal::GenerateMipSizes( vk2d::Vector2u( image_info.x, image_info.y ) ) :
+		vk2d::_internal::GetMipLevelExtents( extent, staging_info.mip_level_count );
+	auto blitted_mip_level_count = staging_info.generate_mip_levels ? uint32_t( mipmap_levels.size() ) : 1;
+
+	// Textures that need no blits never touch the secondary render queue. They're
+	// uploaded and made shader readable on the transfer queue and handed over to
+	// the primary render queue from there, so rendering doesn't wait behind them.
+	bool is_blit_needed							= blitted_mip_level_count > 1;
+	auto handover_queue_family_index			= is_blit_needed ? secondary_render_queue_family_index : primary_transfer_queue_family_index;
+	bool is_primary_render_needed				= handover_queue_family_index != primary_render_queue_family_index;
 	{
 		VkImageCreateInfo image_create_info {};
 		image_create_info.sType						= VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 		image_create_info.pNext						= nullptr;
 		image_create_info.flags						= 0;
 		image_create_info.imageType					= VK_IMAGE_TYPE_2D;
-		image_create_info.format					= VK_FORMAT_R8G8B8A8_UNORM;
+		image_create_info.format					= staging_info.format;
 		image_create_info.extent					= { image_info.x, image_info.y, 1 };
 		image_create_info.mipLevels					= uint32_t( mipmap_levels.size() );
 		image_create_info.arrayLayers				= image_layer_count;
@@ -355,7 +742,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 		image_view_create_info.flags				= 0;
 		image_view_create_info.image				= VK_NULL_HANDLE;	// CreateCompleteImageResource() will replace this with proper image handle
 		image_view_create_info.viewType				= VK_IMAGE_VIEW_TYPE_2D_ARRAY;
-		image_view_create_info.format				= VK_FORMAT_R8G8B8A8_UNORM;
+		image_view_create_info.format				= staging_info.format;
 		image_view_create_info.components			= {
 			VK_COMPONENT_SWIZZLE_IDENTITY,
 			VK_COMPONENT_SWIZZLE_IDENTITY,
@@ -368,6 +755,10 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 		image_view_create_info.subresourceRange.baseArrayLayer	= 0;
 		image_view_create_info.subresourceRange.layerCount		= image_layer_count;
 
+		// Kept for relocation, see MTRelocate().
+		vk_image_create_info		= image_create_info;
+		vk_image_view_create_info	= image_view_create_info;
+
 		image = memory_pool->CreateCompleteImageResource(
 			&image_create_info,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
@@ -379,8 +770,38 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 		}
 	}
 
+	// Images too large for staging buffers are streamed in on the transfer queue
+	// right away, the upload recorded below continues from transfer dst layout.
+	bool is_streamed = !staging_info.streamed_images.empty();
+	if( is_streamed ) {
+		if( !MTStreamStagingImages(
+			loader_thread_resource,
+			instance->GetPrimaryTransferQueue(),
+			loader_thread_resource->GetPrimaryTransferCommandPool(),
+			image.image,
+			mipmap_levels,
+			staging_info
+		) ) {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot stream texture data to the GPU!" );
+			return false;
+		}
+	}
+
 	// 4. Allocate a command buffer from thread resources
-	{
+	// Textures loaded in a batch record into command buffers shared by the batch.
+	VkCommandBuffer primary_render_command_buffer		= VK_NULL_HANDLE;
+	VkCommandBuffer secondary_render_command_buffer		= VK_NULL_HANDLE;
+	VkCommandBuffer primary_transfer_command_buffer		= VK_NULL_HANDLE;
+	if( upload_batch ) {
+		vk2d::_internal::TextureUploadCommandBuffers batch_command_buffers {};
+		if( !upload_batch->MTBeginTextureUpload( GetLoaderThread(), loader_thread_resource, is_blit_needed, batch_command_buffers ) ) {
+			return false;
+		}
+		assert( !is_primary_render_needed || batch_command_buffers.primary_render );
+		primary_render_command_buffer		= batch_command_buffers.primary_render;
+		secondary_render_command_buffer		= batch_command_buffers.secondary_render;
+		primary_transfer_command_buffer		= batch_command_buffers.primary_transfer;
+	} else {
 		// Allocate render command buffer if needed.
 		if( is_primary_render_needed ) {
 			VkCommandBufferAllocateInfo command_buffer_allocate_info {};
@@ -416,8 +837,8 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 			vk_primary_render_command_buffer	= VK_NULL_HANDLE;
 		}
 
-		// Allocate blit command buffer.
-		{
+		// Allocate blit command buffer if needed.
+		if( is_blit_needed ) {
 			VkCommandBufferAllocateInfo command_buffer_allocate_info {};
 			command_buffer_allocate_info.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 			command_buffer_allocate_info.pNext					= nullptr;
@@ -481,6 +902,10 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				return false;
 			}
 		}
+
+		primary_render_command_buffer		= vk_primary_render_command_buffer;
+		secondary_render_command_buffer		= vk_secondary_render_command_buffer;
+		primary_transfer_command_buffer		= vk_primary_transfer_command_buffer;
 	}
 
 	// 5. Record commands to upload image into the GPU.
@@ -496,7 +921,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				image_memory_barrier.pNext								= nullptr;
 				image_memory_barrier.srcAccessMask						= 0;
 				image_memory_barrier.dstAccessMask						= VK_ACCESS_MEMORY_WRITE_BIT;
-				image_memory_barrier.oldLayout							= VK_IMAGE_LAYOUT_UNDEFINED;
+				image_memory_barrier.oldLayout							= is_streamed ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
 				image_memory_barrier.newLayout							= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 				image_memory_barrier.srcQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
 				image_memory_barrier.dstQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
@@ -507,7 +932,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				image_memory_barrier.subresourceRange.baseArrayLayer	= 0;
 				image_memory_barrier.subresourceRange.layerCount		= image_layer_count;
 				vkCmdPipelineBarrier(
-					vk_primary_transfer_command_buffer,
+					primary_transfer_command_buffer,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					0,
@@ -517,20 +942,23 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				);
 			}
 
-			// Copy to mip level 0, all layers
-			for( uint32_t i = 0; i < image_layer_count; ++i ) {
+			// Copy to mip level 0, all layers, or every staged mip level.
+			for( uint32_t i = 0; i < uint32_t( staging_buffers.size() ); ++i ) {
+				if( !staging_buffers[ i ].buffer ) continue;	// Streamed.
+
+				auto mip_level = i / image_layer_count;
 				VkBufferImageCopy copy_region {};
-				copy_region.bufferOffset					= 0;
+				copy_region.bufferOffset					= staging_buffers[ i ].offset;
 				copy_region.bufferRowLength					= 0;
 				copy_region.bufferImageHeight				= 0;
 				copy_region.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
-				copy_region.imageSubresource.mipLevel		= 0;
-				copy_region.imageSubresource.baseArrayLayer	= i;
+				copy_region.imageSubresource.mipLevel		= mip_level;
+				copy_region.imageSubresource.baseArrayLayer	= i % image_layer_count;
 				copy_region.imageSubresource.layerCount		= 1;
 				copy_region.imageOffset						= { 0, 0, 0 };
-				copy_region.imageExtent						= { image_info.x, image_info.y, 1 };
+				copy_region.imageExtent						= { mipmap_levels[ mip_level ].width, mipmap_levels[ mip_level ].height, 1 };
 				vkCmdCopyBufferToImage(
-					vk_primary_transfer_command_buffer,
+					primary_transfer_command_buffer,
 					staging_buffers[ i ].buffer,
 					image.image,
 					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -541,7 +969,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 		}
 
 		// We might need to change image queue family ownership
-		if( primary_transfer_queue_family_index != secondary_render_queue_family_index ) {
+		if( is_blit_needed && primary_transfer_queue_family_index != secondary_render_queue_family_index ) {
 			// Ownership is transferred by writing the same pipeline barrier twice to
 			// two different command buffers from two different families and setting
 			// srcQueueFamilyIndex dstQueueFamilyIndex members to appropriate families.
@@ -562,7 +990,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				image_memory_barrier.subresourceRange.baseArrayLayer	= 0;
 				image_memory_barrier.subresourceRange.layerCount		= image_layer_count;
 				vkCmdPipelineBarrier(
-					vk_primary_transfer_command_buffer,
+					primary_transfer_command_buffer,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					0,
@@ -588,7 +1016,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				image_memory_barrier.subresourceRange.baseArrayLayer	= 0;
 				image_memory_barrier.subresourceRange.layerCount		= image_layer_count;
 				vkCmdPipelineBarrier(
-					vk_secondary_render_command_buffer,
+					secondary_render_command_buffer,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					0,
@@ -601,7 +1029,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 
 		// 6. Record commands to make mipmaps of the image in the GPU.
 		{
-			for( uint32_t current_mip_level = 1; current_mip_level < uint32_t( mipmap_levels.size() ); ++current_mip_level ) {
+			for( uint32_t current_mip_level = 1; current_mip_level < blitted_mip_level_count; ++current_mip_level ) {
 				auto src_mip_level							= current_mip_level - 1;
 				auto dst_mip_level							= current_mip_level;
 				auto src_mipmap_extent						= mipmap_levels[ src_mip_level ];
@@ -625,7 +1053,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 					image_memory_barrier.subresourceRange.baseArrayLayer	= 0;
 					image_memory_barrier.subresourceRange.layerCount		= image_layer_count;
 					vkCmdPipelineBarrier(
-						vk_secondary_render_command_buffer,
+						secondary_render_command_buffer,
 						VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 						VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 						0,
@@ -652,7 +1080,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 					blit_region.dstOffsets[ 1 ]					= { int32_t( dst_mipmap_extent.width ), int32_t( dst_mipmap_extent.height ), 1 };
 
 					vkCmdBlitImage(
-						vk_secondary_render_command_buffer,
+						secondary_render_command_buffer,
 						image.image,
 						VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
 						image.image,
@@ -681,7 +1109,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 					image_memory_barrier.subresourceRange.baseArrayLayer	= 0;
 					image_memory_barrier.subresourceRange.layerCount		= image_layer_count;
 					vkCmdPipelineBarrier(
-						vk_secondary_render_command_buffer,
+						secondary_render_command_buffer,
 						VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 						VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 						0,
@@ -692,12 +1120,13 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				}
 			}
 
-			// Lastly we'll transition current image layout for last mipmap level from transfer src optimal to shader read only optimal
+			// Lastly we'll transition current image layout for last mipmap level from transfer dst optimal to shader read only optimal,
+			// or every mip level if they were all uploaded, in which case this is done on the transfer queue.
 			{
 				VkImageMemoryBarrier image_memory_barrier {};
 				image_memory_barrier.sType								= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 				image_memory_barrier.pNext								= nullptr;
-				image_memory_barrier.srcAccessMask						= VK_ACCESS_MEMORY_READ_BIT;
+				image_memory_barrier.srcAccessMask						= VK_ACCESS_MEMORY_WRITE_BIT;
 				image_memory_barrier.dstAccessMask						= VK_ACCESS_MEMORY_READ_BIT;
 				image_memory_barrier.oldLayout							= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 				image_memory_barrier.newLayout							= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
@@ -705,12 +1134,12 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				image_memory_barrier.dstQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
 				image_memory_barrier.image								= image.image;
 				image_memory_barrier.subresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
-				image_memory_barrier.subresourceRange.baseMipLevel		= uint32_t( mipmap_levels.size() - 1 );
-				image_memory_barrier.subresourceRange.levelCount		= 1;
+				image_memory_barrier.subresourceRange.baseMipLevel		= blitted_mip_level_count - 1;
+				image_memory_barrier.subresourceRange.levelCount		= uint32_t( mipmap_levels.size() ) - ( blitted_mip_level_count - 1 );
 				image_memory_barrier.subresourceRange.baseArrayLayer	= 0;
 				image_memory_barrier.subresourceRange.layerCount		= image_layer_count;
 				vkCmdPipelineBarrier(
-					vk_secondary_render_command_buffer,
+					is_blit_needed ? secondary_render_command_buffer : primary_transfer_command_buffer,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					0,
@@ -722,7 +1151,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 		}
 
 		// We might need to change image queue family ownership
-		if( secondary_render_queue_family_index != primary_render_queue_family_index ) {
+		if( is_primary_render_needed ) {
 			// Ownership is transferred by writing the same pipeline barrier twice to
 			// two different command buffers from two different families and setting
 			// srcQueueFamilyIndex dstQueueFamilyIndex members to appropriate families.
@@ -730,12 +1159,12 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				VkImageMemoryBarrier image_memory_barrier {};
 				image_memory_barrier.sType								= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 				image_memory_barrier.pNext								= nullptr;
-				image_memory_barrier.srcAccessMask						= VK_ACCESS_MEMORY_READ_BIT;
-				image_memory_barrier.dstAccessMask						= VK_ACCESS_MEMORY_READ_BIT;
+				image_memory_barrier.srcAccessMask						= VK_ACCESS_MEMORY_WRITE_BIT;
+				image_memory_barrier.dstAccessMask						= 0;
 				image_memory_barrier.oldLayout							= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 				image_memory_barrier.newLayout							= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-				image_memory_barrier.srcQueueFamilyIndex				= primary_transfer_queue_family_index;
-				image_memory_barrier.dstQueueFamilyIndex				= secondary_render_queue_family_index;
+				image_memory_barrier.srcQueueFamilyIndex				= handover_queue_family_index;
+				image_memory_barrier.dstQueueFamilyIndex				= primary_render_queue_family_index;
 				image_memory_barrier.image								= image.image;
 				image_memory_barrier.subresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
 				image_memory_barrier.subresourceRange.baseMipLevel		= 0;
@@ -743,7 +1172,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				image_memory_barrier.subresourceRange.baseArrayLayer	= 0;
 				image_memory_barrier.subresourceRange.layerCount		= image_layer_count;
 				vkCmdPipelineBarrier(
-					vk_secondary_render_command_buffer,
+					is_blit_needed ? secondary_render_command_buffer : primary_transfer_command_buffer,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					0,
@@ -756,12 +1185,12 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				VkImageMemoryBarrier image_memory_barrier {};
 				image_memory_barrier.sType								= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 				image_memory_barrier.pNext								= nullptr;
-				image_memory_barrier.srcAccessMask						= VK_ACCESS_MEMORY_READ_BIT;
+				image_memory_barrier.srcAccessMask						= 0;
 				image_memory_barrier.dstAccessMask						= VK_ACCESS_MEMORY_READ_BIT;
-				image_memory_barrier.oldLayout							= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-				image_memory_barrier.newLayout							= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-				image_memory_barrier.srcQueueFamilyIndex				= primary_transfer_queue_family_index;
-				image_memory_barrier.dstQueueFamilyIndex				= secondary_render_queue_family_index;
+				image_memory_barrier.oldLayout							= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				image_memory_barrier.newLayout							= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				image_memory_barrier.srcQueueFamilyIndex				= handover_queue_family_index;
+				image_memory_barrier.dstQueueFamilyIndex				= primary_render_queue_family_index;
 				image_memory_barrier.image								= image.image;
 				image_memory_barrier.subresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
 				image_memory_barrier.subresourceRange.baseMipLevel		= 0;
@@ -769,7 +1198,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				image_memory_barrier.subresourceRange.baseArrayLayer	= 0;
 				image_memory_barrier.subresourceRange.layerCount		= image_layer_count;
 				vkCmdPipelineBarrier(
-					vk_primary_render_command_buffer,
+					primary_render_command_buffer,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
 					0,
@@ -781,6 +1210,15 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 		}
 	}
 
+	// Batch submits once every texture of the batch has been recorded, time
+	// spent waiting for the rest of the batch is counted as GPU upload time.
+	if( upload_batch ) {
+		AddLoadTime( &vk2d::ResourceLoadTiming::upload_record, upload_record_begin );
+		MarkLoadSubmitted();
+		vk_image_layout		= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		return true;
+	}
+
 	// Create synchronization primitives
 	{
 		VkSemaphoreCreateInfo semaphore_create_info {};
@@ -793,23 +1231,12 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 		fence_create_info.pNext			= nullptr;
 		fence_create_info.flags			= 0;
 
-		result = vkCreateSemaphore(
-			loader_thread_resource->GetVulkanDevice(),
-			&semaphore_create_info,
-			nullptr,
-			&vk_transfer_semaphore
-		);
-		if( result != VK_SUCCESS ) {
-			instance->Report( result, "Internal error: Cannot create semaphore for texture data upload synchronization!" );
-			return false;
-		}
-
-		if( is_primary_render_needed ) {
+		if( is_blit_needed || is_primary_render_needed ) {
 			auto result = vkCreateSemaphore(
 				loader_thread_resource->GetVulkanDevice(),
 				&semaphore_create_info,
 				nullptr,
-				&vk_blit_semaphore
+				&vk_transfer_semaphore
 			);
 			if( result != VK_SUCCESS ) {
 				instance->Report( result, "Internal error: Cannot create semaphore for texture data upload synchronization!" );
@@ -817,11 +1244,24 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 			}
 		}
 
-		result = vkCreateFence(
-			loader_thread_resource->GetVulkanDevice(),
-			&fence_create_info,
-			nullptr,
-			&vk_texture_complete_fence
+		if( is_blit_needed && is_primary_render_needed ) {
+			auto result = vkCreateSemaphore(
+				loader_thread_resource->GetVulkanDevice(),
+				&semaphore_create_info,
+				nullptr,
+				&vk_blit_semaphore
+			);
+			if( result != VK_SUCCESS ) {
+				instance->Report( result, "Internal error: Cannot create semaphore for texture data upload synchronization!" );
+				return false;
+			}
+		}
+
+		result = vkCreateFence(
+			loader_thread_resource->GetVulkanDevice(),
+			&fence_create_info,
+			nullptr,
+			&vk_texture_complete_fence
 		);
 		if( result != VK_SUCCESS ) {
 			instance->Report( result, "Internal error: Cannot create fence for texture data upload synchronization!" );
@@ -838,12 +1278,14 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 			instance->Report( result, "Internal error: Cannot compile transfer command buffer for texture data upload!" );
 			return false;
 		}
-		result = vkEndCommandBuffer(
-			vk_secondary_render_command_buffer
-		);
-		if( result != VK_SUCCESS ) {
-			instance->Report( result, "Internal error: Cannot compile secondary render queue command buffer for texture mipmap creation!" );
-			return false;
+		if( is_blit_needed ) {
+			auto result = vkEndCommandBuffer(
+				vk_secondary_render_command_buffer
+			);
+			if( result != VK_SUCCESS ) {
+				instance->Report( result, "Internal error: Cannot compile secondary render queue command buffer for texture mipmap creation!" );
+				return false;
+			}
 		}
 		if( is_primary_render_needed ) {
 			auto result = vkEndCommandBuffer(
@@ -854,8 +1296,10 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 				return false;
 			}
 		}
+		AddLoadTime( &vk2d::ResourceLoadTiming::upload_record, upload_record_begin );
 
-		// Submit transfer command buffer
+		// Submit transfer command buffer, the texture is complete after this if
+		// it needs no blits and no queue family handover.
 		{
 			VkSubmitInfo submit_info {};
 			submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -865,12 +1309,13 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 			submit_info.pWaitDstStageMask		= nullptr;
 			submit_info.commandBufferCount		= 1;
 			submit_info.pCommandBuffers			= &vk_primary_transfer_command_buffer;
-			submit_info.signalSemaphoreCount	= 1;
-			submit_info.pSignalSemaphores		= &vk_transfer_semaphore;
+			bool is_last_submit					= !is_blit_needed && !is_primary_render_needed;
+			submit_info.signalSemaphoreCount	= is_last_submit ? 0 : 1;
+			submit_info.pSignalSemaphores		= is_last_submit ? nullptr : &vk_transfer_semaphore;
 
 			auto result = resource_manager->GetInstance()->GetPrimaryTransferQueue().Submit(
 				submit_info,
-				VK_NULL_HANDLE
+				is_last_submit ? vk_texture_complete_fence : VK_NULL_HANDLE
 			);
 			if( result != VK_SUCCESS ) {
 				instance->Report( result, "Internal error: Cannot submit texture upload command buffer!" );
@@ -879,7 +1324,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 		}
 
 		// Submit blit command buffer
-		{
+		if( is_blit_needed ) {
 			VkPipelineStageFlags wait_semaphore_dst	= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 			VkSubmitInfo submit_info {};
 			submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -908,7 +1353,7 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 			submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
 			submit_info.pNext					= nullptr;
 			submit_info.waitSemaphoreCount		= 1;
-			submit_info.pWaitSemaphores			= &vk_blit_semaphore;
+			submit_info.pWaitSemaphores			= is_blit_needed ? &vk_blit_semaphore : &vk_transfer_semaphore;
 			submit_info.pWaitDstStageMask		= &wait_semaphore_dst;
 			submit_info.commandBufferCount		= 1;
 			submit_info.pCommandBuffers			= &vk_primary_render_command_buffer;
@@ -924,66 +1369,481 @@ bool vk2d::_internal::TextureResourceImpl::MTLoad(
 			}
 		}
 	}
+	MarkLoadSubmitted();
 
 	vk_image_layout		= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
 	return true;
 }
 
+bool vk2d::_internal::TextureResourceImpl::MTDecodeToStagingBuffers(
+	vk2d::_internal::ThreadLoaderResource					*	loader_thread_resource,
+	std::vector<vk2d::_internal::BufferSubAllocation>		&	out_staging_buffers,
+	vk2d::_internal::TextureStagingInfo						&	out_staging_info
+)
+{
+	auto instance			= resource_manager->GetInstance();
+
+	struct
+	{
+		uint32_t	x			= UINT32_MAX;
+		uint32_t	y			= UINT32_MAX;
+		uint32_t	channels	= 0;
+	} image_info;
+
+	// Mip levels 1 and up of every layer if made on the CPU, staged after level 0 of every layer.
+	bool is_mip_generated_on_cpu = mip_generation_settings.filter != vk2d::TextureMipFilter::GPU_LINEAR;
+	std::vector<std::vector<std::vector<uint8_t>>> layer_mip_levels;
+	auto GenerateLayerMipLevels = [ & ]( const void * texels, uint32_t width, uint32_t height )
+	{
+		auto mip_generation_begin = std::chrono::steady_clock::now();
+		layer_mip_levels.emplace_back();
+		vk2d::_internal::GenerateMipLevels(
+			static_cast<const uint8_t*>( texels ),
+			width,
+			height,
+			mip_generation_settings.filter,
+			mip_generation_settings.gamma_correct,
+			layer_mip_levels.back()
+		);
+		AddLoadTime( &vk2d::ResourceLoadTiming::mip_generation, mip_generation_begin );
+	};
+
+	if( IsFromFile() || IsFromMemory() ) {
+		// 1. Load and process images from files or memory.
+
+		// Array texture layers are decoded in parallel before anything is copied to staging memory.
+		std::shared_ptr<vk2d::_internal::ArrayLayerDecodeJob> decode_job;
+		if( IsFromFile() ) {
+			decode_job = std::make_shared<vk2d::_internal::ArrayLayerDecodeJob>( GetFilePaths(), mip_generation_settings );
+
+			auto thread_pool		= resource_manager->GetThreadPool();
+			auto & general_threads	= resource_manager->GetGeneralThreads();
+			auto helper_count		= GetFilePaths().size() > 1 ? std::min( GetFilePaths().size() - 1, general_threads.size() ) : size_t( 0 );
+			for( size_t i = 0; i < helper_count; ++i ) {
+				thread_pool->ScheduleTask(
+					std::make_unique<vk2d::_internal::ArrayLayerDecodeTask>( decode_job ),
+					general_threads
+				);
+			}
+			decode_job->Run();
+			decode_job->Wait();
+
+			// Report every layer that failed, not just the first one.
+			bool is_any_layer_failed = false;
+			for( size_t i = 0; i < decode_job->GetLayers().size(); ++i ) {
+				auto & layer = decode_job->GetLayers()[ i ];
+				AddLoadTime( &vk2d::ResourceLoadTiming::file_read, layer.file_read_time );
+				AddLoadTime( &vk2d::ResourceLoadTiming::decode, layer.decode_time );
+				AddLoadTime( &vk2d::ResourceLoadTiming::mip_generation, layer.mip_generation_time );
+				AddLoadBytes( &vk2d::ResourceLoadTiming::source_bytes, layer.file_size );
+				if( layer.is_attempted && !layer.is_decoded ) {
+					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create texture: Cannot load image file: " + GetFilePaths()[ i ].string() );
+					is_any_layer_failed = true;
+				}
+			}
+			if( is_any_layer_failed ) {
+				return false;
+			}
+
+			// Containers hold every layer and mip level themselves.
+			for( size_t i = 0; i < decode_job->GetLayers().size(); ++i ) {
+				auto & container_data = decode_job->GetLayers()[ i ].container_data;
+				if( container_data.empty() ) continue;
+
+				if( decode_job->GetLayers().size() > 1 ) {
+					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create array texture: KTX2 and DDS files contain their own layers and must be loaded alone: " + GetFilePaths()[ i ].string() );
+					return false;
+				}
+				return MTStageTextureContainer(
+					loader_thread_resource,
+					container_data.data(),
+					container_data.size(),
+					GetFilePaths()[ i ].string(),
+					out_staging_buffers,
+					out_staging_info
+				);
+			}
+		} else if( !raw_memory_extent.width && vk2d::_internal::IsTextureContainer( GetMemoryData(), GetMemorySize() ) ) {
+			AddLoadBytes( &vk2d::ResourceLoadTiming::source_bytes, uint64_t( GetMemorySize() ) );
+			return MTStageTextureContainer(
+				loader_thread_resource,
+				GetMemoryData(),
+				GetMemorySize(),
+				"Image in memory",
+				out_staging_buffers,
+				out_staging_info
+			);
+		}
+
+		auto encoded_image_count = IsFromFile() ? GetFilePaths().size() : size_t( 1 );
+		for( size_t encoded_image_index = 0; encoded_image_index < encoded_image_count; ++encoded_image_index ) {
+			// Create texture from a file or encoded image in memory
+			int image_size_x				= 0;
+			int image_size_y				= 0;
+			int stbi_image_channel_count	= 0;
+			uint32_t image_channel_count	= 4;
+
+			stbi_uc * stbi_image_data		= nullptr;
+			std::vector<uint8_t> qoi_texels;
+			const void * image_texels		= nullptr;
+			if( IsFromFile() ) {
+				// Ownership of the texels moves here from the decode job.
+				auto & layer		= decode_job->GetLayers()[ encoded_image_index ];
+				stbi_image_data		= layer.texels;
+				layer.texels		= nullptr;
+				qoi_texels			= std::move( layer.qoi_texels );
+				if( is_mip_generated_on_cpu ) {
+					layer_mip_levels.push_back( std::move( layer.mip_levels ) );
+				}
+				image_size_x		= layer.size_x;
+				image_size_y		= layer.size_y;
+				image_texels		= stbi_image_data ? static_cast<const void*>( stbi_image_data ) : qoi_texels.data();
+			} else if( raw_memory_extent.width && raw_memory_extent.height ) {
+				// Texels are already decoded, they're copied from memory straight to the staging buffer.
+				if( GetMemorySize() != size_t( raw_memory_extent.width ) * size_t( raw_memory_extent.height ) * image_channel_count ) {
+					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create texture: Raw texel data size does not match texture size!" );
+					return false;
+				}
+				image_size_x	= int( raw_memory_extent.width );
+				image_size_y	= int( raw_memory_extent.height );
+				image_texels	= GetMemoryData();
+				AddLoadBytes( &vk2d::ResourceLoadTiming::source_bytes, uint64_t( GetMemorySize() ) );
+			} else {
+				// Memory is owned by the caller and only read here, see vk2d::ResourceManager::LoadTextureResourceFromMemory().
+				AddLoadBytes( &vk2d::ResourceLoadTiming::source_bytes, uint64_t( GetMemorySize() ) );
+				auto decode_begin = std::chrono::steady_clock::now();
+				if( vk2d::_internal::IsQOIImage( GetMemoryData(), GetMemorySize() ) ) {
+					uint32_t qoi_size_x = 0;
+					uint32_t qoi_size_y = 0;
+					if( vk2d::_internal::DecodeQOI( GetMemoryData(), GetMemorySize(), qoi_texels, qoi_size_x, qoi_size_y ) ) {
+						image_size_x	= int( qoi_size_x );
+						image_size_y	= int( qoi_size_y );
+					}
+				} else if( GetMemorySize() <= size_t( std::numeric_limits<int>::max() ) ) {
+					stbi_image_data = stbi_load_from_memory(
+						reinterpret_cast<const stbi_uc*>( GetMemoryData() ),
+						int( GetMemorySize() ),
+						&image_size_x,
+						&image_size_y,
+						&stbi_image_channel_count,
+						4 );
+				}
+				AddLoadTime( &vk2d::ResourceLoadTiming::decode, decode_begin );
+				if( !stbi_image_data && qoi_texels.empty() ) {
+					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create texture: Cannot decode image from memory!" );
+					return false;
+				}
+				image_texels = stbi_image_data ? static_cast<const void*>( stbi_image_data ) : qoi_texels.data();
+			}
+
+			// Check that file images have the same dimensions if we're creating array textures.
+			if( image_info.x == UINT32_MAX ) {
+				// First image
+				image_info.x		= uint32_t( image_size_x );
+				image_info.y		= uint32_t( image_size_y );
+			} else {
+				if( image_info.x != image_size_x ||
+					image_info.y != image_size_y ) {
+					instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create array texture: File images are different dimensions!" );
+					stbi_image_free( stbi_image_data );
+					return false;
+				}
+			}
+
+			// Files made their mip levels while decoding, memory loads are not cached.
+			if( is_mip_generated_on_cpu && !IsFromFile() ) {
+				GenerateLayerMipLevels( image_texels, uint32_t( image_size_x ), uint32_t( image_size_y ) );
+			}
+
+			// 2. Create staging buffer, we'll also need memory pool for this.
+
+			auto staging_copy_begin = std::chrono::steady_clock::now();
+			auto image_byte_size = VkDeviceSize( image_size_x ) * VkDeviceSize( image_size_y ) * VkDeviceSize( image_channel_count );
+			auto staging_data = MTAllocateStagingImage(
+				loader_thread_resource,
+				image_byte_size,
+				1,
+				out_staging_buffers,
+				out_staging_info
+			);
+			if( !staging_data ) {
+				stbi_image_free( stbi_image_data );
+				return false;
+			}
+			std::memcpy( staging_data, image_texels, size_t( image_byte_size ) );
+			AddLoadTime( &vk2d::ResourceLoadTiming::staging_copy, staging_copy_begin );
+
+			stbi_image_free( stbi_image_data );
+
+			// Set image extent so we'll know it later
+			out_staging_info.extent	= { uint32_t( image_size_x ), uint32_t( image_size_y ) };
+
+			image_info.x		= uint32_t( image_size_x );
+			image_info.y		= uint32_t( image_size_y );
+			image_info.channels	= uint32_t( image_channel_count );
+		}
+	} else {
+		for( size_t i = 0; i < texture_data.size(); ++i ) {
+			// Create texture from data
+
+			// Image extent already set by resource manager, we can just use it.
+			image_info.x		= extent.width;
+			image_info.y		= extent.height;
+			image_info.channels	= 4;
+			out_staging_info.extent	= extent;
+
+			if( texture_data[ i ].size() < size_t( image_info.x ) * size_t( image_info.y ) ) {
+				instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create texture: Texture data too small for texture" );
+				return false;
+			}
+
+			if( is_mip_generated_on_cpu ) {
+				GenerateLayerMipLevels( texture_data[ i ].data(), image_info.x, image_info.y );
+			}
+
+			auto staging_copy_begin = std::chrono::steady_clock::now();
+			auto staging_data = MTAllocateStagingImage(
+				loader_thread_resource,
+				VkDeviceSize( texture_data[ i ].size() * sizeof( vk2d::Color8 ) ),
+				1,
+				out_staging_buffers,
+				out_staging_info
+			);
+			if( !staging_data ) {
+				return false;
+			}
+			std::memcpy( staging_data, texture_data[ i ].data(), texture_data[ i ].size() * sizeof( vk2d::Color8 ) );
+			AddLoadTime( &vk2d::ResourceLoadTiming::staging_copy, staging_copy_begin );
+			AddLoadBytes( &vk2d::ResourceLoadTiming::source_bytes, uint64_t( texture_data[ i ].size() * sizeof( vk2d::Color8 ) ) );
+		}
+	}
+
+	auto layer_count			= uint32_t( out_staging_buffers.size() );
+	uint32_t mip_level_count	= 1;
+	if( is_mip_generated_on_cpu && !layer_mip_levels.empty() ) {
+		// Layers are the same size so they have the same amount of mip levels.
+		mip_level_count = uint32_t( layer_mip_levels.front().size() ) + 1;
+		auto staging_copy_begin = std::chrono::steady_clock::now();
+		for( uint32_t mip_level = 1; mip_level < mip_level_count; ++mip_level ) {
+			for( auto & mip_levels : layer_mip_levels ) {
+				auto & texels = mip_levels[ mip_level - 1 ];
+				auto staging_data = MTAllocateStagingImage(
+					loader_thread_resource,
+					VkDeviceSize( texels.size() ),
+					1,
+					out_staging_buffers,
+					out_staging_info
+				);
+				if( !staging_data ) {
+					return false;
+				}
+				std::memcpy( staging_data, texels.data(), texels.size() );
+			}
+		}
+		AddLoadTime( &vk2d::ResourceLoadTiming::staging_copy, staging_copy_begin );
+	}
+
+	out_staging_info.format					= VK_FORMAT_R8G8B8A8_UNORM;
+	out_staging_info.layer_count			= layer_count;
+	out_staging_info.mip_level_count		= mip_level_count;
+	out_staging_info.generate_mip_levels	= !is_mip_generated_on_cpu;
+	return true;
+}
+
+bool vk2d::_internal::TextureResourceImpl::MTStageTextureContainer(
+	vk2d::_internal::ThreadLoaderResource					*	loader_thread_resource,
+	const void												*	container_data,
+	size_t														container_size,
+	const std::string										&	source_name,
+	std::vector<vk2d::_internal::BufferSubAllocation>		&	out_staging_buffers,
+	vk2d::_internal::TextureStagingInfo						&	out_staging_info
+)
+{
+	auto instance			= resource_manager->GetInstance();
+
+	vk2d::_internal::TextureContainer container {};
+	std::string error;
+	if( !vk2d::_internal::ParseTextureContainer( container_data, container_size, container, error ) ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create texture: " + source_name + ": " + error );
+		return false;
+	}
+
+	// Mip levels can't be blitted to block compressed images, those are
+	// used without mip levels if the container does not have them.
+	auto format					= vk2d::_internal::GetTextureContainerVulkanFormat( container.format );
+	bool is_block_compressed	= vk2d::_internal::GetTextureContainerBlockSize( container.format ) != 0;
+	bool generate_mip_levels	= container.mip_level_count == 1 && !is_block_compressed;
+	bool is_decoded_on_cpu		=
+		( is_block_compressed && !instance->GetVulkanPhysicalDeviceFeatures().textureCompressionBC ) ||
+		!vk2d::_internal::IsTextureFormatUsable( instance, format, generate_mip_levels );
+	if( is_decoded_on_cpu ) {
+		format					= VK_FORMAT_R8G8B8A8_UNORM;
+		generate_mip_levels		= container.mip_level_count == 1;
+	}
+
+	// Images are in the same order as staging buffers, by mip level then by layer.
+	for( auto & container_image : container.images ) {
+		auto image_byte_size = is_decoded_on_cpu ?
+			VkDeviceSize( container_image.width ) * VkDeviceSize( container_image.height ) * 4 :
+			VkDeviceSize( container_image.size );
+		auto staging_data = MTAllocateStagingImage(
+			loader_thread_resource,
+			image_byte_size,
+			is_block_compressed && !is_decoded_on_cpu ? 4 : 1,
+			out_staging_buffers,
+			out_staging_info
+		);
+		if( !staging_data ) {
+			return false;
+		}
+
+		if( is_decoded_on_cpu ) {
+			// Decoded straight into the staging buffer.
+			auto decode_begin = std::chrono::steady_clock::now();
+			auto success = vk2d::_internal::DecodeTextureContainerImage( container.format, container_image, staging_data );
+			AddLoadTime( &vk2d::ResourceLoadTiming::decode, decode_begin );
+			if( !success ) {
+				instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot create texture: " + source_name + ": Cannot decode image." );
+				return false;
+			}
+		} else {
+			auto staging_copy_begin = std::chrono::steady_clock::now();
+			std::memcpy( staging_data, container_image.data, size_t( image_byte_size ) );
+			AddLoadTime( &vk2d::ResourceLoadTiming::staging_copy, staging_copy_begin );
+		}
+	}
+
+	out_staging_info.extent					= { container.width, container.height };
+	out_staging_info.format					= format;
+	out_staging_info.layer_count			= container.layer_count;
+	out_staging_info.mip_level_count		= container.mip_level_count;
+	out_staging_info.generate_mip_levels	= generate_mip_levels;
+	return true;
+}
+
+uint8_t * vk2d::_internal::TextureResourceImpl::MTAllocateStagingImage(
+	vk2d::_internal::ThreadLoaderResource					*	loader_thread_resource,
+	VkDeviceSize												byte_size,
+	uint32_t													block_height,
+	std::vector<vk2d::_internal::BufferSubAllocation>		&	out_staging_buffers,
+	vk2d::_internal::TextureStagingInfo						&	out_staging_info
+)
+{
+	// Anything larger would get a dedicated staging page that is freed again
+	// right after the upload, streaming reuses the same staging memory instead.
+	if( byte_size > VK2D_BUILD_OPTION_BUFFER_SUB_ALLOCATOR_STAGING_PAGE_SIZE ) {
+		vk2d::_internal::TextureStreamedImage streamed_image {};
+		streamed_image.staging_index	= uint32_t( out_staging_buffers.size() );
+		streamed_image.block_height		= block_height;
+		streamed_image.texels.resize( size_t( byte_size ) );
+		out_staging_info.streamed_images.push_back( std::move( streamed_image ) );
+		out_staging_buffers.emplace_back();
+		return out_staging_info.streamed_images.back().texels.data();
+	}
+
+	auto staging_buffer = loader_thread_resource->GetStagingBufferSubAllocator()->Allocate(
+		byte_size
+	);
+	if( staging_buffer != VK_SUCCESS ) {
+		resource_manager->GetInstance()->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot create texture resource staging buffer!" );
+		return nullptr;
+	}
+	out_staging_buffers.push_back( std::move( staging_buffer ) );
+	return out_staging_buffers.back().Get<uint8_t>();
+}
+
+bool vk2d::_internal::TextureResourceImpl::MTStreamStagingImages(
+	vk2d::_internal::ThreadLoaderResource					*	loader_thread_resource,
+	vk2d::_internal::ResolvedQueue								queue,
+	VkCommandPool												command_pool,
+	VkImage														destination,
+	const std::vector<VkExtent2D>							&	mip_level_extents,
+	vk2d::_internal::TextureStagingInfo						&	staging_info
+)
+{
+	auto staging_stream = loader_thread_resource->GetStagingStream();
+
+	VkImageSubresourceRange range {};
+	range.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	range.baseMipLevel		= 0;
+	range.levelCount		= uint32_t( mip_level_extents.size() );
+	range.baseArrayLayer	= 0;
+	range.layerCount		= staging_info.layer_count;
+	if( !staging_stream->Begin( queue, command_pool, destination, range ) ) {
+		staging_stream->End();
+		return false;
+	}
+
+	// Streaming waits for the GPU between chunks, that's counted as staging copy time too.
+	auto staging_copy_begin = std::chrono::steady_clock::now();
+	for( auto & streamed_image : staging_info.streamed_images ) {
+		auto mip_level = streamed_image.staging_index / staging_info.layer_count;
+		if( !staging_stream->Upload(
+			mip_level,
+			streamed_image.staging_index % staging_info.layer_count,
+			mip_level_extents[ mip_level ],
+			streamed_image.block_height,
+			streamed_image.texels.data(),
+			VkDeviceSize( streamed_image.texels.size() )
+		) ) {
+			break;
+		}
+		// Host copy is not needed once it's in staging memory.
+		streamed_image.texels			= {};
+	}
+	auto success = staging_stream->End();
+	AddLoadTime( &vk2d::ResourceLoadTiming::staging_copy, staging_copy_begin );
+	return success;
+}
+
 void vk2d::_internal::TextureResourceImpl::MTUnload(
 	vk2d::_internal::ThreadPrivateResource	*	thread_resource
 )
 {
-	loader_thread_resource	= dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
+	// Textures can be unloaded in any loader thread, everything that belongs to the
+	// loader thread that loaded this texture is handed back to it with deferred frees.
+	assert( dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource ) );
+
+	// Check if loaded successfully, it's either loaded or failed to load but it'll
+	// definitely be either or. MTUnload() does not ever get called before MTLoad().
+	WaitUntilLoaded( std::chrono::nanoseconds::max() );
+
+	// Defragmentation or residency may be replacing the image in the loader thread, wait for it.
+	{
+		std::unique_lock<std::mutex> pin_lock( relocation_pin_mutex );
+		relocation_pin_condition.wait( pin_lock, [ this ]() { return relocation_pin_count == 0; } );
+	}
 
-	assert( loader_thread_resource );
 	if( !loader_thread_resource ) return;
 
 	auto memory_pool		= loader_thread_resource->GetDeviceMemoryPool();
 
-	// Check if loaded successfully, no need to check for failure as this thread was
-	// responsible for loading it, it's either loaded or failed to load but it'll
-	// definitely be either or. MTUnload() does not ever get called before MTLoad().
-	WaitUntilLoaded( std::chrono::nanoseconds::max() );
+	DestroyTextureLoadResources();
+	DestroyRegionUpdateResources();
 
 	vkDestroyFence(
 		loader_thread_resource->GetVulkanDevice(),
 		vk_texture_complete_fence,
 		nullptr
 	);
+	vk_texture_complete_fence		= VK_NULL_HANDLE;
 
-	vkDestroySemaphore(
-		loader_thread_resource->GetVulkanDevice(),
-		vk_transfer_semaphore,
-		nullptr
-	);
-	vkDestroySemaphore(
-		loader_thread_resource->GetVulkanDevice(),
-		vk_blit_semaphore,
-		nullptr
-	);
-
-	vkFreeCommandBuffers(
-		loader_thread_resource->GetVulkanDevice(),
-		loader_thread_resource->GetPrimaryRenderCommandPool(),
-		1, &vk_primary_render_command_buffer
-	);
-	vkFreeCommandBuffers(
-		loader_thread_resource->GetVulkanDevice(),
-		loader_thread_resource->GetSecondaryRenderCommandPool(),
-		1, &vk_secondary_render_command_buffer
-	);
-	vkFreeCommandBuffers(
-		loader_thread_resource->GetVulkanDevice(),
-		loader_thread_resource->GetPrimaryTransferCommandPool(),
-		1, &vk_primary_transfer_command_buffer
-	);
+	memory_pool->DeferredFreeCompleteResource( image );
+	for( auto & r : retired_images ) {
+		memory_pool->DeferredFreeCompleteResource( r.image );
+	}
+	retired_images.clear();
 
-	memory_pool->FreeCompleteResource( image );
-	for( auto & sb : staging_buffers ) {
-		memory_pool->FreeCompleteResource( sb );
+	// Running in the loader thread already, no need to wait for the next allocation.
+	if( thread_resource == loader_thread_resource ) {
+		loader_thread_resource->ProcessDeferredFrees();
 	}
-	staging_buffers.clear();
+}
+
+bool vk2d::_internal::TextureResourceImpl::IsUnloadLockedToLoaderThread() const
+{
+	return false;
 }
 
 vk2d::ResourceStatus vk2d::_internal::TextureResourceImpl::GetStatus()
@@ -997,21 +1857,26 @@ vk2d::ResourceStatus vk2d::_internal::TextureResourceImpl::GetStatus()
 
 			// We can check the status of the fence in any thread,
 			// it will not be removed until the resource is removed.
-			assert( vk_texture_complete_fence );
-
-			auto result = vkGetFenceStatus(
-				resource_manager->GetVulkanDevice(),
-				vk_texture_complete_fence
-			);
+			VkResult result = VK_SUCCESS;
+			if( upload_batch ) {
+				result = upload_batch->GetUploadStatus();
+			} else {
+				assert( vk_texture_complete_fence );
+				result = vkGetFenceStatus(
+					resource_manager->GetVulkanDevice(),
+					vk_texture_complete_fence
+				);
+			}
 			if( result == VK_SUCCESS ) {
 				// Loaded, free some resources used to load
 				status = local_status = vk2d::ResourceStatus::LOADED;
-				ScheduleTextureLoadResourceDestruction();
+				DestroyTextureLoadResources();
 			} else if( result == VK_NOT_READY ) {
 				return local_status;
 			} else {
 				status = local_status = vk2d::ResourceStatus::FAILED_TO_LOAD;
 			}
+			FinishLoadTiming();
 		}
 	}
 
@@ -1050,22 +1915,28 @@ vk2d::ResourceStatus vk2d::_internal::TextureResourceImpl::WaitUntilLoaded(
 				UINT64_MAX :
 				uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( timeout - std::chrono::steady_clock::now() ).count() );
 
-			assert( vk_texture_complete_fence );
-			auto result = vkWaitForFences(
-				resource_manager->GetVulkanDevice(),
-				1, &vk_texture_complete_fence,
-				VK_TRUE,
-				timeout_for_fences
-			);
+			VkResult result = VK_SUCCESS;
+			if( upload_batch ) {
+				result = upload_batch->WaitForUpload( timeout );
+			} else {
+				assert( vk_texture_complete_fence );
+				result = vkWaitForFences(
+					resource_manager->GetVulkanDevice(),
+					1, &vk_texture_complete_fence,
+					VK_TRUE,
+					timeout_for_fences
+				);
+			}
 			if( result == VK_SUCCESS ) {
 				status = local_status = vk2d::ResourceStatus::LOADED;
-				ScheduleTextureLoadResourceDestruction();
+				DestroyTextureLoadResources();
 			} else if( result == VK_TIMEOUT ) {
 				return local_status;
 			} else {
 				status = local_status = vk2d::ResourceStatus::FAILED_TO_LOAD;
-				ScheduleTextureLoadResourceDestruction();
+				DestroyTextureLoadResources();
 			}
+			FinishLoadTiming();
 		} // Else timeout and return local_status.
 	}
 
@@ -1074,11 +1945,13 @@ vk2d::ResourceStatus vk2d::_internal::TextureResourceImpl::WaitUntilLoaded(
 
 VkImage vk2d::_internal::TextureResourceImpl::GetVulkanImage() const
 {
+	std::lock_guard<std::mutex> image_lock( image_mutex );
 	return image.image;
 }
 
 VkImageView vk2d::_internal::TextureResourceImpl::GetVulkanImageView() const
 {
+	std::lock_guard<std::mutex> image_lock( image_mutex );
 	return image.view;
 }
 
@@ -1102,90 +1975,1311 @@ bool vk2d::_internal::TextureResourceImpl::IsTextureDataReady()
 	return GetStatus() == vk2d::ResourceStatus::LOADED;
 }
 
-bool vk2d::_internal::TextureResourceImpl::IsGood() const
+uint64_t vk2d::_internal::TextureResourceImpl::GetGeneration() const
 {
-	return is_good;
+	return generation;
 }
 
+bool vk2d::_internal::TextureResourceImpl::UpdateRegion(
+	vk2d::Rect2u							area,
+	uint32_t								layer,
+	const std::vector<vk2d::Color8>		&	texels,
+	bool									update_mip_levels
+)
+{
+	auto instance			= resource_manager->GetInstance();
+	auto device				= instance->GetVulkanDevice();
 
+	VK2D_ASSERT_MAIN_THREAD( instance );
 
-namespace vk2d {
-namespace _internal {
-
-// Handles the texture destruction
-class DestroyTextureLoadResources :
-	public vk2d::_internal::Task
-{
-public:
-	DestroyTextureLoadResources(
-		vk2d::_internal::TextureResourceImpl * texture
-	) :
-		texture( texture )
-	{};
+	if( GetStatus() != vk2d::ResourceStatus::LOADED ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot update texture: Texture is not loaded!" );
+		return false;
+	}
+	if( vk_image_create_info.format != VK_FORMAT_R8G8B8A8_UNORM ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot update texture: Only RGBA textures with 8 bits per channel can be updated!" );
+		return false;
+	}
+	if( area.top_left.x >= area.bottom_right.x || area.bottom_right.x > extent.width ||
+		area.top_left.y >= area.bottom_right.y || area.bottom_right.y > extent.height ||
+		layer >= image_layer_count ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot update texture: Area or layer is outside of the texture!" );
+		return false;
+	}
+	auto area_size			= area.bottom_right - area.top_left;
+	auto area_texel_count	= size_t( area_size.x ) * size_t( area_size.y );
+	if( texels.size() < area_texel_count ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot update texture: Not enough texels for the area!" );
+		return false;
+	}
 
-	void operator()(
-		vk2d::_internal::ThreadPrivateResource * thread_resource )
-	{
+	// Every holder of a shared texture would see the new texels, and later
+	// loads of the same file must not get the updated texture either.
+	if( !resource_manager->DetachCachedResource( my_interface ) ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot update texture: Texture is shared, it was loaded more than once from the same file!" );
+		return false;
+	}
 
-		vkDestroyFence(
-			texture->resource_manager->GetVulkanDevice(),
-			texture->vk_texture_complete_fence,
-			nullptr
-		);
+	// Checked again once locked, relocation and eviction may be replacing the image.
+	if( is_evicted ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot update texture: Texture is evicted!" );
+		return false;
+	}
+	std::lock_guard<std::mutex> region_update_lock( region_update_mutex );
+	if( is_evicted ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot update texture: Texture is evicted!" );
+		return false;
+	}
+	is_region_updated		= true;
 
-		vkDestroySemaphore(
-			texture->resource_manager->GetVulkanDevice(),
-			texture->vk_transfer_semaphore,
-			nullptr
-		);
-		vkDestroySemaphore(
-			texture->resource_manager->GetVulkanDevice(),
-			texture->vk_blit_semaphore,
-			nullptr
+	auto CreateCommandPool = [ instance, device ](
+		vk2d::_internal::ResolvedQueue		queue,
+		VkCommandPool					&	out_command_pool ) -> bool
+	{
+		if( out_command_pool ) return true;
+
+		VkCommandPoolCreateInfo command_pool_create_info {};
+		command_pool_create_info.sType				= VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		command_pool_create_info.pNext				= nullptr;
+		command_pool_create_info.flags				= VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		command_pool_create_info.queueFamilyIndex	= queue.GetQueueFamilyIndex();
+		auto result = vkCreateCommandPool(
+			device,
+			&command_pool_create_info,
+			nullptr,
+			&out_command_pool
 		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot create command pool for texture update!" );
+			out_command_pool	= VK_NULL_HANDLE;
+			return false;
+		}
+		return true;
+	};
+	if( !CreateCommandPool( instance->GetPrimaryRenderQueue(), vk_region_update_command_pool ) ||
+		!CreateCommandPool( instance->GetPrimaryTransferQueue(), vk_region_update_transfer_command_pool ) ) {
+		return false;
+	}
 
-		vkFreeCommandBuffers(
-			texture->resource_manager->GetVulkanDevice(),
-			texture->loader_thread_resource->GetPrimaryRenderCommandPool(),
-			1, &texture->vk_primary_render_command_buffer
-		);
-		vkFreeCommandBuffers(
-			texture->resource_manager->GetVulkanDevice(),
-			texture->loader_thread_resource->GetSecondaryRenderCommandPool(),
-			1, &texture->vk_secondary_render_command_buffer
+	// Wait until the GPU is done with the slot from two updates ago.
+	auto & slot = region_update_slots[ next_region_update_slot ];
+	if( !slot.fence ) {
+		auto AllocateCommandBuffer = [ instance, device ](
+			VkCommandPool					command_pool,
+			VkCommandBuffer				&	out_command_buffer ) -> bool
+		{
+			VkCommandBufferAllocateInfo command_buffer_allocate_info {};
+			command_buffer_allocate_info.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			command_buffer_allocate_info.pNext					= nullptr;
+			command_buffer_allocate_info.commandPool			= command_pool;
+			command_buffer_allocate_info.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			command_buffer_allocate_info.commandBufferCount		= 1;
+			auto result = vkAllocateCommandBuffers(
+				device,
+				&command_buffer_allocate_info,
+				&out_command_buffer
+			);
+			if( result != VK_SUCCESS ) {
+				instance->Report( result, "Internal error: Cannot allocate command buffer for texture update!" );
+				out_command_buffer	= VK_NULL_HANDLE;
+				return false;
+			}
+			return true;
+		};
+		auto CreateSemaphore = [ instance, device ](
+			VkSemaphore					&	out_semaphore ) -> bool
+		{
+			VkSemaphoreCreateInfo semaphore_create_info {};
+			semaphore_create_info.sType		= VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+			semaphore_create_info.pNext		= nullptr;
+			semaphore_create_info.flags		= 0;
+			auto result = vkCreateSemaphore(
+				device,
+				&semaphore_create_info,
+				nullptr,
+				&out_semaphore
+			);
+			if( result != VK_SUCCESS ) {
+				instance->Report( result, "Internal error: Cannot create semaphore for texture update!" );
+				out_semaphore	= VK_NULL_HANDLE;
+				return false;
+			}
+			return true;
+		};
+
+		if( ( !slot.render_release_command_buffer && !AllocateCommandBuffer( vk_region_update_command_pool, slot.render_release_command_buffer ) ) ||
+			( !slot.transfer_command_buffer && !AllocateCommandBuffer( vk_region_update_transfer_command_pool, slot.transfer_command_buffer ) ) ||
+			( !slot.render_acquire_command_buffer && !AllocateCommandBuffer( vk_region_update_command_pool, slot.render_acquire_command_buffer ) ) ||
+			( !slot.render_release_semaphore && !CreateSemaphore( slot.render_release_semaphore ) ) ||
+			( !slot.transfer_semaphore && !CreateSemaphore( slot.transfer_semaphore ) ) ) {
+			return false;
+		}
+
+		VkFenceCreateInfo fence_create_info {};
+		fence_create_info.sType			= VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fence_create_info.pNext			= nullptr;
+		fence_create_info.flags			= VK_FENCE_CREATE_SIGNALED_BIT;
+		auto result = vkCreateFence(
+			device,
+			&fence_create_info,
+			nullptr,
+			&slot.fence
 		);
-		vkFreeCommandBuffers(
-			texture->resource_manager->GetVulkanDevice(),
-			texture->loader_thread_resource->GetPrimaryTransferCommandPool(),
-			1, &texture->vk_primary_transfer_command_buffer
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot create fence for texture update!" );
+			slot.fence			= VK_NULL_HANDLE;
+			return false;
+		}
+	}
+	{
+		auto result = vkWaitForFences(
+			device,
+			1, &slot.fence,
+			VK_TRUE,
+			UINT64_MAX
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot wait for previous texture update!" );
+			return false;
+		}
+	}
+
+	// Staging buffer only grows, updates of the same texture tend to be the same size.
+	auto memory_pool		= instance->GetDeviceMemoryPool();
+	auto staging_size		= VkDeviceSize( area_texel_count * sizeof( vk2d::Color8 ) );
+	if( slot.staging_buffer.memory.GetSize() < staging_size ) {
+		if( slot.staging_buffer.buffer ) {
+			memory_pool->FreeCompleteResource( slot.staging_buffer );
+		}
+		slot.staging_buffer	= memory_pool->CreateCompleteHostBufferResourceWithData(
+			texels.data(),
+			VkDeviceSize( area_texel_count ),
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+		);
+		if( slot.staging_buffer != VK_SUCCESS ) {
+			instance->Report( slot.staging_buffer.result, "Internal error: Cannot create staging buffer for texture update!" );
+			slot.staging_buffer	= {};
+			return false;
+		}
+	} else {
+		auto result = slot.staging_buffer.memory.DataCopy( texels.data(), VkDeviceSize( area_texel_count ) );
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot copy texels for texture update!" );
+			return false;
+		}
+	}
+
+	// Texels are copied on the transfer queue. Render queue hands the image over
+	// once frames submitted before this are done reading the old texels, and
+	// takes it back to blit the mip levels before frames submitted after this.
+	auto mip_level_count		= update_mip_levels ? vk_image_create_info.mipLevels : 1;
+	bool is_ownership_transferred	=
+		instance->GetPrimaryRenderQueue().GetQueueFamilyIndex() != instance->GetPrimaryTransferQueue().GetQueueFamilyIndex();
+
+	auto RecordCommandBuffer = [ instance ](
+		VkCommandBuffer					command_buffer,
+		const std::function<void()>	&	record_function ) -> bool
+	{
+		VkCommandBufferBeginInfo command_buffer_begin_info {};
+		command_buffer_begin_info.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		command_buffer_begin_info.pNext				= nullptr;
+		command_buffer_begin_info.flags				= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		command_buffer_begin_info.pInheritanceInfo	= nullptr;
+		auto result = vkBeginCommandBuffer(
+			command_buffer,
+			&command_buffer_begin_info
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot record command buffer for texture update!" );
+			return false;
+		}
+
+		record_function();
+
+		result = vkEndCommandBuffer(
+			command_buffer
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot compile command buffer for texture update!" );
+			return false;
+		}
+		return true;
+	};
+	if( ( is_ownership_transferred && !RecordCommandBuffer( slot.render_release_command_buffer, [ & ]()
+			{
+				CmdUpdateRegionRelease( slot.render_release_command_buffer, layer, mip_level_count );
+			} ) ) ||
+		!RecordCommandBuffer( slot.transfer_command_buffer, [ & ]()
+			{
+				CmdUpdateRegionCopy( slot.transfer_command_buffer, slot.staging_buffer.buffer, area, layer, mip_level_count );
+			} ) ||
+		!RecordCommandBuffer( slot.render_acquire_command_buffer, [ & ]()
+			{
+				CmdUpdateRegionMipLevels( slot.render_acquire_command_buffer, area, layer, mip_level_count );
+			} ) ) {
+		return false;
+	}
+
+	{
+		auto result = vkResetFences(
+			device,
+			1, &slot.fence
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot reset fence for texture update!" );
+			return false;
+		}
+	}
+
+	auto SubmitFailed = [ this, instance, &slot ](
+		VkResult		result )
+	{
+		instance->Report( result, "Internal error: Cannot submit texture update command buffers!" );
+		// Fence and semaphores may never be signaled, start over with new ones.
+		DestroyRegionUpdateSlot( slot );
+	};
+
+	// Render queue signals once frames submitted before this are done with the image.
+	{
+		VkSubmitInfo submit_info {};
+		submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext					= nullptr;
+		submit_info.waitSemaphoreCount		= 0;
+		submit_info.pWaitSemaphores			= nullptr;
+		submit_info.pWaitDstStageMask		= nullptr;
+		submit_info.commandBufferCount		= is_ownership_transferred ? 1 : 0;
+		submit_info.pCommandBuffers			= is_ownership_transferred ? &slot.render_release_command_buffer : nullptr;
+		submit_info.signalSemaphoreCount	= 1;
+		submit_info.pSignalSemaphores		= &slot.render_release_semaphore;
+		auto result = instance->GetPrimaryRenderQueue().Submit(
+			submit_info
 		);
+		if( result != VK_SUCCESS ) {
+			SubmitFailed( result );
+			return false;
+		}
+	}
+
+	{
+		VkPipelineStageFlags wait_semaphore_dst	= VK_PIPELINE_STAGE_TRANSFER_BIT;
+		VkSubmitInfo submit_info {};
+		submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext					= nullptr;
+		submit_info.waitSemaphoreCount		= 1;
+		submit_info.pWaitSemaphores			= &slot.render_release_semaphore;
+		submit_info.pWaitDstStageMask		= &wait_semaphore_dst;
+		submit_info.commandBufferCount		= 1;
+		submit_info.pCommandBuffers			= &slot.transfer_command_buffer;
+		submit_info.signalSemaphoreCount	= 1;
+		submit_info.pSignalSemaphores		= &slot.transfer_semaphore;
+		auto result = instance->GetPrimaryTransferQueue().Submit(
+			submit_info
+		);
+		if( result != VK_SUCCESS ) {
+			SubmitFailed( result );
+			return false;
+		}
+	}
+
+	{
+		VkPipelineStageFlags wait_semaphore_dst	= VK_PIPELINE_STAGE_TRANSFER_BIT;
+		VkSubmitInfo submit_info {};
+		submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext					= nullptr;
+		submit_info.waitSemaphoreCount		= 1;
+		submit_info.pWaitSemaphores			= &slot.transfer_semaphore;
+		submit_info.pWaitDstStageMask		= &wait_semaphore_dst;
+		submit_info.commandBufferCount		= 1;
+		submit_info.pCommandBuffers			= &slot.render_acquire_command_buffer;
+		submit_info.signalSemaphoreCount	= 0;
+		submit_info.pSignalSemaphores		= nullptr;
+		auto result = instance->GetPrimaryRenderQueue().Submit(
+			submit_info,
+			slot.fence
+		);
+		if( result != VK_SUCCESS ) {
+			SubmitFailed( result );
+			return false;
+		}
+	}
 
-		for( auto & sb : texture->staging_buffers ) {
-			texture->resource_manager->GetInstance()->GetDeviceMemoryPool()->FreeCompleteResource(
-				sb
+	next_region_update_slot	= ( next_region_update_slot + 1 ) % uint32_t( region_update_slots.size() );
+	return true;
+}
+
+void vk2d::_internal::TextureResourceImpl::PinRelocation()
+{
+	std::lock_guard<std::mutex> pin_lock( relocation_pin_mutex );
+	++relocation_pin_count;
+}
+
+void vk2d::_internal::TextureResourceImpl::UnpinRelocation()
+{
+	std::lock_guard<std::mutex> pin_lock( relocation_pin_mutex );
+	assert( relocation_pin_count );
+	if( --relocation_pin_count == 0 ) {
+		relocation_pin_condition.notify_all();
+	}
+}
+
+VkDeviceSize vk2d::_internal::TextureResourceImpl::MTRelocate(
+	vk2d::_internal::ThreadPrivateResource	*	thread_resource
+)
+{
+	auto loader_thread_resource	= dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
+	assert( loader_thread_resource );
+	assert( loader_thread_resource == this->loader_thread_resource );
+	if( !loader_thread_resource ) return 0;
+
+	// Only one relocation at a time, previous old image must be released first.
+	if( HasRetiredImages( UINT64_MAX ) ) return 0;
+	if( is_evicted ) return 0;
+	if( GetStatus() != vk2d::ResourceStatus::LOADED ) return 0;
+
+	auto memory_pool		= loader_thread_resource->GetDeviceMemoryPool();
+
+	if( !memory_pool->IsDefragmentationCandidate( image.memory ) ) return 0;
+
+	// Region updates would be written to the old image after it's copied.
+	std::lock_guard<std::mutex> region_update_lock( region_update_mutex );
+
+	auto new_image = memory_pool->CreateCompleteImageResourceForRelocation(
+		image.memory,
+		&vk_image_create_info,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		&vk_image_view_create_info
+	);
+	if( new_image != VK_SUCCESS ) {
+		// Other chunks are too fragmented to take this image, not an error.
+		return 0;
+	}
+
+	// Image ownership was handed over to the primary render queue family when it
+	// was loaded, copy on the same queue the windows render with so that this is
+	// ordered after any frame that is still using the old image.
+	auto success = MTSubmitAndWait(
+		loader_thread_resource,
+		"relocation",
+		[ this, &new_image ]( VkCommandBuffer command_buffer )
+		{
+			CmdCopyImageToImage(
+				command_buffer,
+				new_image.image,
+				0
 			);
 		}
+	);
+	if( !success ) {
+		memory_pool->FreeCompleteResource( new_image );
+		return 0;
+	}
+
+	VkDeviceSize moved_size = image.memory.GetSize();
+	ReplaceImage( new_image );
+	return moved_size;
+}
 
-		texture->vk_texture_complete_fence			= VK_NULL_HANDLE;
-		texture->vk_transfer_semaphore				= VK_NULL_HANDLE;
-		texture->vk_blit_semaphore					= VK_NULL_HANDLE;
-		texture->vk_primary_render_command_buffer	= VK_NULL_HANDLE;
-		texture->vk_secondary_render_command_buffer	= VK_NULL_HANDLE;
-		texture->vk_primary_transfer_command_buffer	= VK_NULL_HANDLE;
-		texture->staging_buffers.clear();
+bool vk2d::_internal::TextureResourceImpl::MTEvict(
+	vk2d::_internal::ThreadPrivateResource	*	thread_resource,
+	uint32_t									placeholder_size
+)
+{
+	auto loader_thread_resource	= dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
+	assert( loader_thread_resource );
+	assert( loader_thread_resource == this->loader_thread_resource );
+	if( !loader_thread_resource ) return false;
+
+	std::lock_guard<std::mutex> region_update_lock( region_update_mutex );
+	if( is_evicted || !IsEvictable() ) return false;
+	if( GetStatus() != vk2d::ResourceStatus::LOADED ) return false;
+
+	auto instance			= resource_manager->GetInstance();
+	auto memory_pool		= loader_thread_resource->GetDeviceMemoryPool();
+
+	// Placeholder is the tail of the mip chain, sampling it looks the same as
+	// sampling the full image from far away.
+	auto mipmap_levels = vk2d::_internal::GetMipLevelExtents(
+		extent,
+		vk_image_create_info.mipLevels
+	);
+	uint32_t first_mip_level = 0;
+	while( first_mip_level + 1 < uint32_t( mipmap_levels.size() ) &&
+		std::max( mipmap_levels[ first_mip_level ].width, mipmap_levels[ first_mip_level ].height ) > placeholder_size ) {
+		++first_mip_level;
 	}
+	// Already as small as the placeholder would be.
+	if( first_mip_level == 0 ) return false;
 
-private:
-	vk2d::_internal::TextureResourceImpl		*	texture;
-};
+	auto placeholder_image_create_info				= vk_image_create_info;
+	placeholder_image_create_info.extent			= { mipmap_levels[ first_mip_level ].width, mipmap_levels[ first_mip_level ].height, 1 };
+	placeholder_image_create_info.mipLevels			= vk_image_create_info.mipLevels - first_mip_level;
 
-} // _internal
-} // vk2d
+	auto placeholder_image_view_create_info			= vk_image_view_create_info;
+	placeholder_image_view_create_info.subresourceRange.levelCount	= placeholder_image_create_info.mipLevels;
+
+	auto placeholder = memory_pool->CreateCompleteImageResource(
+		&placeholder_image_create_info,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		&placeholder_image_view_create_info
+	);
+	if( placeholder != VK_SUCCESS ) {
+		instance->Report( placeholder.result, "Internal error: Cannot create texture placeholder image!" );
+		return false;
+	}
+
+	auto success = MTSubmitAndWait(
+		loader_thread_resource,
+		"eviction",
+		[ this, &placeholder, first_mip_level ]( VkCommandBuffer command_buffer )
+		{
+			CmdCopyImageToImage(
+				command_buffer,
+				placeholder.image,
+				first_mip_level
+			);
+		}
+	);
+	if( !success ) {
+		memory_pool->FreeCompleteResource( placeholder );
+		return false;
+	}
+
+	full_image_size		= image.memory.GetSize();
+	ReplaceImage( placeholder );
+	is_evicted			= true;
+	return true;
+}
+
+bool vk2d::_internal::TextureResourceImpl::MTReload(
+	vk2d::_internal::ThreadPrivateResource	*	thread_resource
+)
+{
+	auto loader_thread_resource	= dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
+	assert( loader_thread_resource );
+	assert( loader_thread_resource == this->loader_thread_resource );
+	if( !loader_thread_resource ) return false;
+
+	if( !is_evicted ) return false;
+
+	auto instance			= resource_manager->GetInstance();
+	auto memory_pool		= loader_thread_resource->GetDeviceMemoryPool();
+	auto staging_allocator	= loader_thread_resource->GetStagingBufferSubAllocator();
+
+	std::vector<vk2d::_internal::BufferSubAllocation> reload_staging_buffers;
+	auto FreeStagingBuffers = [ & ]()
+	{
+		for( auto & sb : reload_staging_buffers ) {
+			staging_allocator->Free( sb );
+		}
+		reload_staging_buffers.clear();
+	};
+
+	// Source is loaded exactly like the first time, if it can't be loaded
+	// anymore the placeholder stays and we don't try again.
+	vk2d::_internal::TextureStagingInfo reload_staging_info {};
+	if( !MTDecodeToStagingBuffers( loader_thread_resource, reload_staging_buffers, reload_staging_info ) ) {
+		FreeStagingBuffers();
+		is_reload_failed	= true;
+		return false;
+	}
+	if( reload_staging_info.extent.width != extent.width ||
+		reload_staging_info.extent.height != extent.height ||
+		reload_staging_info.layer_count != image_layer_count ||
+		reload_staging_info.format != vk_image_create_info.format ||
+		( !reload_staging_info.generate_mip_levels && reload_staging_info.mip_level_count != vk_image_create_info.mipLevels ) ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Cannot reload texture: Image is not the same size it was when first loaded!" );
+		FreeStagingBuffers();
+		is_reload_failed	= true;
+		return false;
+	}
+
+	auto new_image = memory_pool->CreateCompleteImageResource(
+		&vk_image_create_info,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		&vk_image_view_create_info
+	);
+	if( new_image != VK_SUCCESS ) {
+		instance->Report( new_image.result, "Internal error: Cannot create texture resource image!" );
+		FreeStagingBuffers();
+		return false;
+	}
+
+	// Streamed on the render queue so the image doesn't change queue family.
+	bool is_streamed = !reload_staging_info.streamed_images.empty();
+	if( is_streamed ) {
+		if( !MTStreamStagingImages(
+			loader_thread_resource,
+			instance->GetPrimaryRenderQueue(),
+			loader_thread_resource->GetPrimaryRenderCommandPool(),
+			new_image.image,
+			vk2d::_internal::GetMipLevelExtents( extent, vk_image_create_info.mipLevels ),
+			reload_staging_info
+		) ) {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot stream texture data to the GPU!" );
+			FreeStagingBuffers();
+			memory_pool->FreeCompleteResource( new_image );
+			return false;
+		}
+	}
+
+	// Upload and mip map generation on a single render queue command buffer,
+	// reload is rare enough that the transfer queue handover is not worth it.
+	auto success = MTSubmitAndWait(
+		loader_thread_resource,
+		"reload",
+		[ this, &new_image, &reload_staging_buffers, &reload_staging_info, is_streamed ]( VkCommandBuffer command_buffer )
+		{
+			auto mipmap_levels = vk2d::_internal::GetMipLevelExtents(
+				extent,
+				vk_image_create_info.mipLevels
+			);
+			auto mip_level_count			= uint32_t( mipmap_levels.size() );
+			auto blitted_mip_level_count	= reload_staging_info.generate_mip_levels ? mip_level_count : 1;
+
+			vk2d::_internal::CmdTransitionTextureImageLayout(
+				command_buffer,
+				new_image.image,
+				is_streamed ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				0, mip_level_count,
+				image_layer_count
+			);
+
+			for( uint32_t i = 0; i < uint32_t( reload_staging_buffers.size() ); ++i ) {
+				if( !reload_staging_buffers[ i ].buffer ) continue;	// Streamed.
+
+				auto mip_level = i / image_layer_count;
+				VkBufferImageCopy copy_region {};
+				copy_region.bufferOffset					= reload_staging_buffers[ i ].offset;
+				copy_region.bufferRowLength					= 0;
+				copy_region.bufferImageHeight				= 0;
+				copy_region.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+				copy_region.imageSubresource.mipLevel		= mip_level;
+				copy_region.imageSubresource.baseArrayLayer	= i % image_layer_count;
+				copy_region.imageSubresource.layerCount		= 1;
+				copy_region.imageOffset						= { 0, 0, 0 };
+				copy_region.imageExtent						= { mipmap_levels[ mip_level ].width, mipmap_levels[ mip_level ].height, 1 };
+				vkCmdCopyBufferToImage(
+					command_buffer,
+					reload_staging_buffers[ i ].buffer,
+					new_image.image,
+					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+					1,
+					&copy_region
+				);
+			}
+
+			for( uint32_t dst_mip_level = 1; dst_mip_level < blitted_mip_level_count; ++dst_mip_level ) {
+				auto src_mip_level = dst_mip_level - 1;
+
+				vk2d::_internal::CmdTransitionTextureImageLayout(
+					command_buffer,
+					new_image.image,
+					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+					VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+					src_mip_level, 1,
+					image_layer_count
+				);
+
+				VkImageBlit blit_region {};
+				blit_region.srcSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+				blit_region.srcSubresource.mipLevel			= src_mip_level;
+				blit_region.srcSubresource.baseArrayLayer	= 0;
+				blit_region.srcSubresource.layerCount		= image_layer_count;
+				blit_region.srcOffsets[ 0 ]					= { 0, 0, 0 };
+				blit_region.srcOffsets[ 1 ]					= { int32_t( mipmap_levels[ src_mip_level ].width ), int32_t( mipmap_levels[ src_mip_level ].height ), 1 };
+				blit_region.dstSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+				blit_region.dstSubresource.mipLevel			= dst_mip_level;
+				blit_region.dstSubresource.baseArrayLayer	= 0;
+				blit_region.dstSubresource.layerCount		= image_layer_count;
+				blit_region.dstOffsets[ 0 ]					= { 0, 0, 0 };
+				blit_region.dstOffsets[ 1 ]					= { int32_t( mipmap_levels[ dst_mip_level ].width ), int32_t( mipmap_levels[ dst_mip_level ].height ), 1 };
+				vkCmdBlitImage(
+					command_buffer,
+					new_image.image,
+					VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+					new_image.image,
+					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+					1, &blit_region,
+					VK_FILTER_LINEAR
+				);
+
+				vk2d::_internal::CmdTransitionTextureImageLayout(
+					command_buffer,
+					new_image.image,
+					VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+					vk_image_layout,
+					src_mip_level, 1,
+					image_layer_count
+				);
+			}
+
+			vk2d::_internal::CmdTransitionTextureImageLayout(
+				command_buffer,
+				new_image.image,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				vk_image_layout,
+				blitted_mip_level_count - 1, mip_level_count - ( blitted_mip_level_count - 1 ),
+				image_layer_count
+			);
+		}
+	);
+	FreeStagingBuffers();
+	if( !success ) {
+		memory_pool->FreeCompleteResource( new_image );
+		return false;
+	}
+
+	ReplaceImage( new_image );
+	is_evicted			= false;
+	return true;
+}
+
+void vk2d::_internal::TextureResourceImpl::MTReleaseRetiredImages(
+	vk2d::_internal::ThreadPrivateResource	*	thread_resource,
+	uint64_t									release_epoch
+)
+{
+	auto loader_thread_resource	= dynamic_cast<vk2d::_internal::ThreadLoaderResource*>( thread_resource );
+	assert( loader_thread_resource );
+	if( !loader_thread_resource ) return;
+
+	std::vector<vk2d::_internal::CompleteImageResource> released_images;
+	{
+		std::lock_guard<std::mutex> image_lock( image_mutex );
+		auto it = std::remove_if(
+			retired_images.begin(),
+			retired_images.end(),
+			[ release_epoch, &released_images ]( RetiredImage & r )
+			{
+				if( r.retired_epoch >= release_epoch ) return false;
+				released_images.push_back( r.image );
+				return true;
+			}
+		);
+		retired_images.erase( it, retired_images.end() );
+	}
+	for( auto & r : released_images ) {
+		loader_thread_resource->GetDeviceMemoryPool()->FreeCompleteResource( r );
+	}
+}
 
-void vk2d::_internal::TextureResourceImpl::ScheduleTextureLoadResourceDestruction()
+bool vk2d::_internal::TextureResourceImpl::HasRetiredImages(
+	uint64_t									release_epoch
+) const
 {
-	resource_manager->GetThreadPool()->ScheduleTask(
-		std::make_unique<vk2d::_internal::DestroyTextureLoadResources>( this ),
-		{ GetLoaderThread() }
+	std::lock_guard<std::mutex> image_lock( image_mutex );
+	return std::any_of(
+		retired_images.begin(),
+		retired_images.end(),
+		[ release_epoch ]( const RetiredImage & r ) { return r.retired_epoch < release_epoch; }
 	);
 }
+
+VkDeviceSize vk2d::_internal::TextureResourceImpl::GetResidentSize() const
+{
+	std::lock_guard<std::mutex> image_lock( image_mutex );
+	return image.memory.GetSize();
+}
+
+bool vk2d::_internal::TextureResourceImpl::IsEvictable() const
+{
+	if( is_reload_failed ) return false;
+	if( is_region_updated ) return false;
+	if( IsFromFile() ) return true;
+	if( IsFromMemory() ) return is_memory_persistent;
+	return !texture_data.empty();
+}
+
+void vk2d::_internal::TextureResourceImpl::MarkUsed()
+{
+	// Checked first so that drawing the same texture many times per frame
+	// doesn't keep writing to memory shared with the main thread.
+	if( !is_used.load( std::memory_order_relaxed ) ) {
+		is_used.store( true, std::memory_order_relaxed );
+	}
+}
+
+bool vk2d::_internal::TextureResourceImpl::IsGood() const
+{
+	return is_good;
+}
+
+bool vk2d::_internal::TextureResourceImpl::MTSubmitAndWait(
+	vk2d::_internal::ThreadLoaderResource					*	loader_thread_resource,
+	const std::string										&	operation_name,
+	const std::function<void( VkCommandBuffer )>			&	record_function
+)
+{
+	auto instance			= resource_manager->GetInstance();
+	auto device				= loader_thread_resource->GetVulkanDevice();
+
+	VkCommandBuffer	command_buffer	= VK_NULL_HANDLE;
+	VkFence			fence			= VK_NULL_HANDLE;
+	auto Cleanup = [ & ]()
+	{
+		vkDestroyFence(
+			device,
+			fence,
+			nullptr
+		);
+		if( command_buffer ) {
+			vkFreeCommandBuffers(
+				device,
+				loader_thread_resource->GetPrimaryRenderCommandPool(),
+				1, &command_buffer
+			);
+		}
+	};
+
+	{
+		VkCommandBufferAllocateInfo command_buffer_allocate_info {};
+		command_buffer_allocate_info.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		command_buffer_allocate_info.pNext					= nullptr;
+		command_buffer_allocate_info.commandPool			= loader_thread_resource->GetPrimaryRenderCommandPool();
+		command_buffer_allocate_info.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		command_buffer_allocate_info.commandBufferCount		= 1;
+		auto result = vkAllocateCommandBuffers(
+			device,
+			&command_buffer_allocate_info,
+			&command_buffer
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot allocate command buffer for texture " + operation_name + "!" );
+			command_buffer = VK_NULL_HANDLE;
+			Cleanup();
+			return false;
+		}
+
+		VkFenceCreateInfo fence_create_info {};
+		fence_create_info.sType			= VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fence_create_info.pNext			= nullptr;
+		fence_create_info.flags			= 0;
+		result = vkCreateFence(
+			device,
+			&fence_create_info,
+			nullptr,
+			&fence
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot create fence for texture " + operation_name + "!" );
+			Cleanup();
+			return false;
+		}
+	}
+
+	{
+		VkCommandBufferBeginInfo command_buffer_begin_info {};
+		command_buffer_begin_info.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		command_buffer_begin_info.pNext				= nullptr;
+		command_buffer_begin_info.flags				= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		command_buffer_begin_info.pInheritanceInfo	= nullptr;
+		vkBeginCommandBuffer(
+			command_buffer,
+			&command_buffer_begin_info
+		);
+
+		record_function( command_buffer );
+
+		auto result = vkEndCommandBuffer(
+			command_buffer
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot compile command buffer for texture " + operation_name + "!" );
+			Cleanup();
+			return false;
+		}
+	}
+
+	// Submit and wait, this runs in a loader thread so blocking here is fine.
+	{
+		VkSubmitInfo submit_info {};
+		submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext					= nullptr;
+		submit_info.waitSemaphoreCount		= 0;
+		submit_info.pWaitSemaphores			= nullptr;
+		submit_info.pWaitDstStageMask		= nullptr;
+		submit_info.commandBufferCount		= 1;
+		submit_info.pCommandBuffers			= &command_buffer;
+		submit_info.signalSemaphoreCount	= 0;
+		submit_info.pSignalSemaphores		= nullptr;
+		auto result = instance->GetPrimaryRenderQueue().Submit(
+			submit_info,
+			fence
+		);
+		if( result == VK_SUCCESS ) {
+			result = vkWaitForFences(
+				device,
+				1, &fence,
+				VK_TRUE,
+				UINT64_MAX
+			);
+		}
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot submit texture " + operation_name + " command buffer!" );
+			Cleanup();
+			return false;
+		}
+	}
+	Cleanup();
+	return true;
+}
+
+void vk2d::_internal::TextureResourceImpl::CmdCopyImageToImage(
+	VkCommandBuffer								command_buffer,
+	VkImage										destination,
+	uint32_t									first_mip_level
+)
+{
+	auto mip_level_count = vk_image_create_info.mipLevels - first_mip_level;
+
+	VkImageSubresourceRange source_subresource_range {};
+	source_subresource_range.aspectMask			= VK_IMAGE_ASPECT_COLOR_BIT;
+	source_subresource_range.baseMipLevel		= first_mip_level;
+	source_subresource_range.levelCount			= mip_level_count;
+	source_subresource_range.baseArrayLayer		= 0;
+	source_subresource_range.layerCount			= image_layer_count;
+
+	VkImageSubresourceRange destination_subresource_range = source_subresource_range;
+	destination_subresource_range.baseMipLevel	= 0;
+
+	std::array<VkImageMemoryBarrier, 2> pre_copy_barriers {};
+	pre_copy_barriers[ 0 ].sType				= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	pre_copy_barriers[ 0 ].pNext				= nullptr;
+	pre_copy_barriers[ 0 ].srcAccessMask		= VK_ACCESS_SHADER_READ_BIT;
+	pre_copy_barriers[ 0 ].dstAccessMask		= VK_ACCESS_TRANSFER_READ_BIT;
+	pre_copy_barriers[ 0 ].oldLayout			= vk_image_layout;
+	pre_copy_barriers[ 0 ].newLayout			= VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	pre_copy_barriers[ 0 ].srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	pre_copy_barriers[ 0 ].dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	pre_copy_barriers[ 0 ].image				= image.image;
+	pre_copy_barriers[ 0 ].subresourceRange		= source_subresource_range;
+	pre_copy_barriers[ 1 ].sType				= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	pre_copy_barriers[ 1 ].pNext				= nullptr;
+	pre_copy_barriers[ 1 ].srcAccessMask		= 0;
+	pre_copy_barriers[ 1 ].dstAccessMask		= VK_ACCESS_TRANSFER_WRITE_BIT;
+	pre_copy_barriers[ 1 ].oldLayout			= VK_IMAGE_LAYOUT_UNDEFINED;
+	pre_copy_barriers[ 1 ].newLayout			= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	pre_copy_barriers[ 1 ].srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	pre_copy_barriers[ 1 ].dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	pre_copy_barriers[ 1 ].image				= destination;
+	pre_copy_barriers[ 1 ].subresourceRange		= destination_subresource_range;
+	vkCmdPipelineBarrier(
+		command_buffer,
+		VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0,
+		0, nullptr,
+		0, nullptr,
+		uint32_t( pre_copy_barriers.size() ), pre_copy_barriers.data()
+	);
+
+	auto mipmap_levels = vk2d::_internal::GetMipLevelExtents(
+		extent,
+		vk_image_create_info.mipLevels
+	);
+	std::vector<VkImageCopy> copy_regions( mip_level_count );
+	for( uint32_t i = 0; i < mip_level_count; ++i ) {
+		auto & r = copy_regions[ i ];
+		r.srcSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+		r.srcSubresource.mipLevel		= first_mip_level + i;
+		r.srcSubresource.baseArrayLayer	= 0;
+		r.srcSubresource.layerCount		= image_layer_count;
+		r.srcOffset						= { 0, 0, 0 };
+		r.dstSubresource				= r.srcSubresource;
+		r.dstSubresource.mipLevel		= i;
+		r.dstOffset						= { 0, 0, 0 };
+		r.extent						= { mipmap_levels[ first_mip_level + i ].width, mipmap_levels[ first_mip_level + i ].height, 1 };
+	}
+	vkCmdCopyImage(
+		command_buffer,
+		image.image,
+		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		destination,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		uint32_t( copy_regions.size() ), copy_regions.data()
+	);
+
+	// Old image goes back to shader readable as frames recorded before
+	// the swap may still be submitted after this.
+	std::array<VkImageMemoryBarrier, 2> post_copy_barriers {};
+	post_copy_barriers[ 0 ].sType					= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	post_copy_barriers[ 0 ].pNext					= nullptr;
+	post_copy_barriers[ 0 ].srcAccessMask			= VK_ACCESS_TRANSFER_READ_BIT;
+	post_copy_barriers[ 0 ].dstAccessMask			= VK_ACCESS_SHADER_READ_BIT;
+	post_copy_barriers[ 0 ].oldLayout				= VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	post_copy_barriers[ 0 ].newLayout				= vk_image_layout;
+	post_copy_barriers[ 0 ].srcQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+	post_copy_barriers[ 0 ].dstQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+	post_copy_barriers[ 0 ].image					= image.image;
+	post_copy_barriers[ 0 ].subresourceRange		= source_subresource_range;
+	post_copy_barriers[ 1 ].sType					= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	post_copy_barriers[ 1 ].pNext					= nullptr;
+	post_copy_barriers[ 1 ].srcAccessMask			= VK_ACCESS_TRANSFER_WRITE_BIT;
+	post_copy_barriers[ 1 ].dstAccessMask			= VK_ACCESS_SHADER_READ_BIT;
+	post_copy_barriers[ 1 ].oldLayout				= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	post_copy_barriers[ 1 ].newLayout				= vk_image_layout;
+	post_copy_barriers[ 1 ].srcQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+	post_copy_barriers[ 1 ].dstQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+	post_copy_barriers[ 1 ].image					= destination;
+	post_copy_barriers[ 1 ].subresourceRange		= destination_subresource_range;
+	vkCmdPipelineBarrier(
+		command_buffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+		0,
+		0, nullptr,
+		0, nullptr,
+		uint32_t( post_copy_barriers.size() ), post_copy_barriers.data()
+	);
+}
+
+void vk2d::_internal::TextureResourceImpl::CmdUpdateRegionRelease(
+	VkCommandBuffer								command_buffer,
+	uint32_t									layer,
+	uint32_t									mip_level_count
+)
+{
+	auto instance = resource_manager->GetInstance();
+
+	// Only the updated layer is handed over, other layers can be sampled meanwhile.
+	vk2d::_internal::CmdTextureLayerBarrier(
+		command_buffer,
+		image.image,
+		layer,
+		0, mip_level_count,
+		VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+		VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		0,
+		0,
+		vk_image_layout,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		instance->GetPrimaryRenderQueue().GetQueueFamilyIndex(),
+		instance->GetPrimaryTransferQueue().GetQueueFamilyIndex()
+	);
+}
+
+void vk2d::_internal::TextureResourceImpl::CmdUpdateRegionCopy(
+	VkCommandBuffer								command_buffer,
+	VkBuffer									staging_buffer,
+	vk2d::Rect2u								area,
+	uint32_t									layer,
+	uint32_t									mip_level_count
+)
+{
+	auto instance							= resource_manager->GetInstance();
+	auto render_queue_family_index			= instance->GetPrimaryRenderQueue().GetQueueFamilyIndex();
+	auto transfer_queue_family_index		= instance->GetPrimaryTransferQueue().GetQueueFamilyIndex();
+	bool is_ownership_transferred			= render_queue_family_index != transfer_queue_family_index;
+	auto src_queue_family_index				= is_ownership_transferred ? render_queue_family_index : VK_QUEUE_FAMILY_IGNORED;
+	auto dst_queue_family_index				= is_ownership_transferred ? transfer_queue_family_index : VK_QUEUE_FAMILY_IGNORED;
+
+	// Mip levels that are blitted after the copy stay in transfer layout.
+	auto handover_layout					= mip_level_count > 1 ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : vk_image_layout;
+
+	vk2d::_internal::CmdTextureLayerBarrier(
+		command_buffer,
+		image.image,
+		layer,
+		0, mip_level_count,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0,
+		VK_ACCESS_TRANSFER_WRITE_BIT,
+		vk_image_layout,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		src_queue_family_index,
+		dst_queue_family_index
+	);
+
+	VkBufferImageCopy copy_region {};
+	copy_region.bufferOffset					= 0;
+	copy_region.bufferRowLength					= 0;
+	copy_region.bufferImageHeight				= 0;
+	copy_region.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	copy_region.imageSubresource.mipLevel		= 0;
+	copy_region.imageSubresource.baseArrayLayer	= layer;
+	copy_region.imageSubresource.layerCount		= 1;
+	copy_region.imageOffset						= { int32_t( area.top_left.x ), int32_t( area.top_left.y ), 0 };
+	copy_region.imageExtent						= { area.bottom_right.x - area.top_left.x, area.bottom_right.y - area.top_left.y, 1 };
+	vkCmdCopyBufferToImage(
+		command_buffer,
+		staging_buffer,
+		image.image,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		1,
+		&copy_region
+	);
+
+	vk2d::_internal::CmdTextureLayerBarrier(
+		command_buffer,
+		image.image,
+		layer,
+		0, mip_level_count,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		VK_ACCESS_TRANSFER_WRITE_BIT,
+		0,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		handover_layout,
+		dst_queue_family_index,
+		src_queue_family_index
+	);
+}
+
+void vk2d::_internal::TextureResourceImpl::CmdUpdateRegionMipLevels(
+	VkCommandBuffer								command_buffer,
+	vk2d::Rect2u								area,
+	uint32_t									layer,
+	uint32_t									mip_level_count
+)
+{
+	auto instance							= resource_manager->GetInstance();
+	auto render_queue_family_index			= instance->GetPrimaryRenderQueue().GetQueueFamilyIndex();
+	auto transfer_queue_family_index		= instance->GetPrimaryTransferQueue().GetQueueFamilyIndex();
+	bool is_ownership_transferred			= render_queue_family_index != transfer_queue_family_index;
+	auto handover_layout					= mip_level_count > 1 ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : vk_image_layout;
+
+	// Acquire is also the dependency that keeps frames submitted after
+	// this from sampling the layer before the new texels are in.
+	vk2d::_internal::CmdTextureLayerBarrier(
+		command_buffer,
+		image.image,
+		layer,
+		0, mip_level_count,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		mip_level_count > 1 ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+		VK_ACCESS_TRANSFER_WRITE_BIT,
+		mip_level_count > 1 ? VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT : VK_ACCESS_SHADER_READ_BIT,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		handover_layout,
+		is_ownership_transferred ? transfer_queue_family_index : VK_QUEUE_FAMILY_IGNORED,
+		is_ownership_transferred ? render_queue_family_index : VK_QUEUE_FAMILY_IGNORED
+	);
+	if( mip_level_count <= 1 ) return;
+
+	auto mipmap_levels		= vk2d::_internal::GetMipLevelExtents( extent, mip_level_count );
+
+	// Each mip level is blitted from whole 2 * 2 texel blocks of the previous
+	// level that cover the changed area, at the far edges from the rest of
+	// the previous level, so the result matches blitting the whole level.
+	auto changed_top_left		= area.top_left;
+	auto changed_bottom_right	= area.bottom_right;
+	for( uint32_t dst_mip_level = 1; dst_mip_level < mip_level_count; ++dst_mip_level ) {
+		auto src_mip_level		= dst_mip_level - 1;
+		auto src_extent			= mipmap_levels[ src_mip_level ];
+		auto dst_extent			= mipmap_levels[ dst_mip_level ];
+
+		vk2d::Vector2u dst_top_left			= { changed_top_left.x / 2, changed_top_left.y / 2 };
+		vk2d::Vector2u dst_bottom_right		= {
+			std::min( ( changed_bottom_right.x + 1 ) / 2, dst_extent.width ),
+			std::min( ( changed_bottom_right.y + 1 ) / 2, dst_extent.height )
+		};
+		vk2d::Vector2u src_top_left			= { dst_top_left.x * 2, dst_top_left.y * 2 };
+		vk2d::Vector2u src_bottom_right		= {
+			dst_bottom_right.x == dst_extent.width ? src_extent.width : std::min( dst_bottom_right.x * 2, src_extent.width ),
+			dst_bottom_right.y == dst_extent.height ? src_extent.height : std::min( dst_bottom_right.y * 2, src_extent.height )
+		};
+
+		vk2d::_internal::CmdTextureLayerBarrier(
+			command_buffer,
+			image.image,
+			layer,
+			src_mip_level, 1,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_ACCESS_TRANSFER_WRITE_BIT,
+			VK_ACCESS_TRANSFER_READ_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+		);
+
+		VkImageBlit blit_region {};
+		blit_region.srcSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+		blit_region.srcSubresource.mipLevel			= src_mip_level;
+		blit_region.srcSubresource.baseArrayLayer	= layer;
+		blit_region.srcSubresource.layerCount		= 1;
+		blit_region.srcOffsets[ 0 ]					= { int32_t( src_top_left.x ), int32_t( src_top_left.y ), 0 };
+		blit_region.srcOffsets[ 1 ]					= { int32_t( src_bottom_right.x ), int32_t( src_bottom_right.y ), 1 };
+		blit_region.dstSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+		blit_region.dstSubresource.mipLevel			= dst_mip_level;
+		blit_region.dstSubresource.baseArrayLayer	= layer;
+		blit_region.dstSubresource.layerCount		= 1;
+		blit_region.dstOffsets[ 0 ]					= { int32_t( dst_top_left.x ), int32_t( dst_top_left.y ), 0 };
+		blit_region.dstOffsets[ 1 ]					= { int32_t( dst_bottom_right.x ), int32_t( dst_bottom_right.y ), 1 };
+		vkCmdBlitImage(
+			command_buffer,
+			image.image,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			image.image,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			1, &blit_region,
+			VK_FILTER_LINEAR
+		);
+
+		vk2d::_internal::CmdTextureLayerBarrier(
+			command_buffer,
+			image.image,
+			layer,
+			src_mip_level, 1,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			0,
+			VK_ACCESS_SHADER_READ_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			vk_image_layout
+		);
+
+		changed_top_left		= dst_top_left;
+		changed_bottom_right	= dst_bottom_right;
+	}
+
+	vk2d::_internal::CmdTextureLayerBarrier(
+		command_buffer,
+		image.image,
+		layer,
+		mip_level_count - 1, 1,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+		VK_ACCESS_TRANSFER_WRITE_BIT,
+		VK_ACCESS_SHADER_READ_BIT,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		vk_image_layout
+	);
+}
+
+void vk2d::_internal::TextureResourceImpl::DestroyRegionUpdateSlot(
+	RegionUpdateSlot						&	slot
+)
+{
+	auto device = resource_manager->GetVulkanDevice();
+
+	vkDestroyFence(
+		device,
+		slot.fence,
+		nullptr
+	);
+	vkDestroySemaphore(
+		device,
+		slot.render_release_semaphore,
+		nullptr
+	);
+	vkDestroySemaphore(
+		device,
+		slot.transfer_semaphore,
+		nullptr
+	);
+	std::array<VkCommandBuffer, 2> render_command_buffers { slot.render_release_command_buffer, slot.render_acquire_command_buffer };
+	for( auto c : render_command_buffers ) {
+		if( c ) {
+			vkFreeCommandBuffers(
+				device,
+				vk_region_update_command_pool,
+				1, &c
+			);
+		}
+	}
+	if( slot.transfer_command_buffer ) {
+		vkFreeCommandBuffers(
+			device,
+			vk_region_update_transfer_command_pool,
+			1, &slot.transfer_command_buffer
+		);
+	}
+	slot.fence							= VK_NULL_HANDLE;
+	slot.render_release_semaphore		= VK_NULL_HANDLE;
+	slot.transfer_semaphore				= VK_NULL_HANDLE;
+	slot.render_release_command_buffer	= VK_NULL_HANDLE;
+	slot.transfer_command_buffer		= VK_NULL_HANDLE;
+	slot.render_acquire_command_buffer	= VK_NULL_HANDLE;
+}
+
+void vk2d::_internal::TextureResourceImpl::DestroyRegionUpdateResources()
+{
+	auto device = resource_manager->GetVulkanDevice();
+
+	for( auto & slot : region_update_slots ) {
+		if( slot.fence ) {
+			vkWaitForFences(
+				device,
+				1, &slot.fence,
+				VK_TRUE,
+				UINT64_MAX
+			);
+		}
+		DestroyRegionUpdateSlot( slot );
+
+		// Staging buffers belong to the main thread memory pool.
+		if( slot.staging_buffer.buffer ) {
+			resource_manager->GetInstance()->GetDeviceMemoryPool()->DeferredFreeCompleteResource( slot.staging_buffer );
+		}
+		slot = {};
+	}
+	for( auto command_pool : { vk_region_update_command_pool, vk_region_update_transfer_command_pool } ) {
+		vkDestroyCommandPool(
+			device,
+			command_pool,
+			nullptr
+		);
+	}
+	vk_region_update_command_pool				= VK_NULL_HANDLE;
+	vk_region_update_transfer_command_pool		= VK_NULL_HANDLE;
+}
+
+void vk2d::_internal::TextureResourceImpl::ReplaceImage(
+	const vk2d::_internal::CompleteImageResource		&	new_image
+)
+{
+	// Frames recorded before this may still use the old image, it's released
+	// once every frame submitted before the current epoch has finished.
+	std::lock_guard<std::mutex> image_lock( image_mutex );
+	RetiredImage retired {};
+	retired.image			= image;
+	retired.retired_epoch	= resource_manager->GetRetiredImageEpoch();
+	retired_images.push_back( retired );
+	image					= new_image;
+	++generation;
+}
+
+void vk2d::_internal::TextureResourceImpl::DestroyTextureLoadResources()
+{
+	// GetStatus(), WaitUntilLoaded() and MTUnload() may all get here, only do this once.
+	if( load_resources_destroyed.exchange( true ) ) return;
+	if( !loader_thread_resource ) return;
+
+	// Completion fence is kept until unload, other threads may still be checking it.
+	vkDestroySemaphore(
+		resource_manager->GetVulkanDevice(),
+		vk_transfer_semaphore,
+		nullptr
+	);
+	vkDestroySemaphore(
+		resource_manager->GetVulkanDevice(),
+		vk_blit_semaphore,
+		nullptr
+	);
+
+	// Command pools and staging buffers belong to the loader thread, hand them back to it.
+	loader_thread_resource->DeferredFreeCommandBuffer(
+		loader_thread_resource->GetPrimaryRenderCommandPool(),
+		vk_primary_render_command_buffer
+	);
+	loader_thread_resource->DeferredFreeCommandBuffer(
+		loader_thread_resource->GetSecondaryRenderCommandPool(),
+		vk_secondary_render_command_buffer
+	);
+	loader_thread_resource->DeferredFreeCommandBuffer(
+		loader_thread_resource->GetPrimaryTransferCommandPool(),
+		vk_primary_transfer_command_buffer
+	);
+	for( auto & sb : staging_buffers ) {
+		loader_thread_resource->GetStagingBufferSubAllocator()->DeferredFree( sb );
+	}
+
+	vk_transfer_semaphore				= VK_NULL_HANDLE;
+	vk_blit_semaphore					= VK_NULL_HANDLE;
+	vk_primary_render_command_buffer	= VK_NULL_HANDLE;
+	vk_secondary_render_command_buffer	= VK_NULL_HANDLE;
+	vk_primary_transfer_command_buffer	= VK_NULL_HANDLE;
+	staging_buffers.clear();
+}
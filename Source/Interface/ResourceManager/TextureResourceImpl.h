@@ -3,10 +3,14 @@
 #include "Core/SourceCommon.h"
 
 #include "Types/Vector2.hpp"
+#include "Types/Rect2.hpp"
 #include "Types/Color.hpp"
 
 #include "System/VulkanMemoryManagement.h"
+#include "System/BufferSubAllocator.h"
+#include "System/QueueResolver.h"
 
+#include "Interface/ResourceManager/ResourceManager.h"
 #include "Interface/ResourceManager/ResourceImpl.h"
 #include "Interface/TextureImpl.h"
 
@@ -18,9 +22,44 @@ class TextureResource;
 namespace _internal {
 
 class ResourceManagerImpl;
-class DestroyTextureLoadResources;
 class ThreadLoaderResource;
 class ThreadPrivateResource;
+class TextureUploadBatch;
+
+
+
+// What the next texture residency round should do with a texture, see
+// vk2d::_internal::ResourceManagerImpl::UpdateTextureResidency().
+enum class TextureResidencyAction : uint32_t {
+	NONE,
+	EVICT,
+	RELOAD,
+};
+
+
+
+// Image too large for a staging buffer page, its staging buffer is left empty
+// and texels are kept in host memory until the image exists. They're streamed
+// into the image with the loader thread vk2d::_internal::StagingStream.
+struct TextureStreamedImage {
+	uint32_t													staging_index								= {};	// Index of the empty staging buffer.
+	uint32_t													block_height								= 1;	// Texel rows per row of data, 4 with block compressed formats.
+	std::vector<uint8_t>										texels										= {};
+};
+
+
+
+// Describes what vk2d::_internal::TextureResourceImpl::MTDecodeToStagingBuffers()
+// put into the staging buffers. Staging buffers are ordered by mip level, then
+// by layer, staging_buffers[ mip_level * layer_count + layer ].
+struct TextureStagingInfo {
+	VkExtent2D													extent										= {};
+	VkFormat													format										= VK_FORMAT_R8G8B8A8_UNORM;
+	uint32_t													layer_count									= {};
+	uint32_t													mip_level_count								= 1;	// Mip levels in staging buffers.
+	bool														generate_mip_levels							= true;	// Rest of the mip levels are blitted from level 0.
+	std::vector<vk2d::_internal::TextureStreamedImage>			streamed_images								= {};
+};
 
 
 
@@ -30,7 +69,6 @@ class TextureResourceImpl :
 {
 	friend class vk2d::TextureResource;
 	friend class vk2d::_internal::ResourceManagerImpl;
-	friend class vk2d::_internal::DestroyTextureLoadResources;
 
 public:
 																TextureResourceImpl(
@@ -48,12 +86,23 @@ public:
 		vk2d::Vector2u											size,
 		const std::vector<const std::vector<vk2d::Color8>*>	&	texels );
 
+	// Encoded image is owned by the caller and must stay valid until loaded.
+																TextureResourceImpl(
+		vk2d::TextureResource								*	my_interface,
+		vk2d::_internal::ResourceManagerImpl				*	resource_manager,
+		uint32_t												loader_thread,
+		vk2d::Resource										*	parent_resource,
+		const void											*	encoded_image_data,
+		size_t													encoded_image_size );
+
 	bool														MTLoad(
 		vk2d::_internal::ThreadPrivateResource				*	thread_resource );
 
 	void														MTUnload(
 		vk2d::_internal::ThreadPrivateResource				*	thread_resource );
 
+	bool														IsUnloadLockedToLoaderThread() const;
+
 	vk2d::ResourceStatus										GetStatus();
 
 	vk2d::ResourceStatus										WaitUntilLoaded(
@@ -71,18 +120,181 @@ public:
 
 	bool														IsTextureDataReady();
 
+	uint64_t													GetGeneration() const;
+
+	// See vk2d::TextureResource::UpdateRegion().
+	bool														UpdateRegion(
+		vk2d::Rect2u											area,
+		uint32_t												layer,
+		const std::vector<vk2d::Color8>						&	texels,
+		bool													update_mip_levels );
+
+	void														MarkUsed();
+
+	// Defragmentation and residency pin the textures they work on,
+	// MTUnload() waits until every pin is released. Any thread.
+	void														PinRelocation();
+	void														UnpinRelocation();
+
+	// Moves the image to another memory chunk if the loader thread memory pool
+	// wants to empty the chunk this image is in. Contents are copied on the GPU
+	// and this waits until the copy is done. Old image is kept alive until
+	// MTReleaseRetiredImages() is called as frames may still be using it.
+	// Returns the amount of bytes moved, 0 if nothing was moved.
+	VkDeviceSize												MTRelocate(
+		vk2d::_internal::ThreadPrivateResource				*	thread_resource );
+
+	// Replaces the image with its own smallest mip levels, the first one that
+	// fits within placeholder_size texels on both sides. Texture keeps its size
+	// and stays usable, it's just blurry until MTReload() is called.
+	// Returns false if the texture was not evicted.
+	bool														MTEvict(
+		vk2d::_internal::ThreadPrivateResource				*	thread_resource,
+		uint32_t												placeholder_size );
+
+	// Loads the full image again from where it was originally loaded from.
+	bool														MTReload(
+		vk2d::_internal::ThreadPrivateResource				*	thread_resource );
+
+	// Destroys images replaced before release_epoch, see
+	// vk2d::_internal::ResourceManagerImpl::GetRetiredImageEpoch().
+	// GPU must not be using them anymore.
+	void														MTReleaseRetiredImages(
+		vk2d::_internal::ThreadPrivateResource				*	thread_resource,
+		uint64_t												release_epoch );
+
+	bool														HasRetiredImages(
+		uint64_t												release_epoch ) const;
+
+	// Device memory currently used by the image.
+	VkDeviceSize												GetResidentSize() const;
+
+	// True if the image can be evicted and loaded again later. Textures loaded
+	// from memory owned by the application can't be, the memory may be gone.
+	bool														IsEvictable() const;
+
 	bool														IsGood() const;
 
 private:
-	void														ScheduleTextureLoadResourceDestruction();
+	// Loads the texture, MTLoad() wraps this to let the upload batch know when it's done.
+	bool														MTLoadTexture(
+		vk2d::_internal::ThreadPrivateResource				*	thread_resource );
+
+	// 1. and 2. of MTLoadTexture(), decodes or copies every layer into staging
+	// buffers and gets the image extent. Also used to reload evicted textures.
+	bool														MTDecodeToStagingBuffers(
+		vk2d::_internal::ThreadLoaderResource				*	loader_thread_resource,
+		std::vector<vk2d::_internal::BufferSubAllocation>	&	out_staging_buffers,
+		vk2d::_internal::TextureStagingInfo					&	out_staging_info );
+
+	// Copies every layer and mip level of a KTX2 or DDS container into staging
+	// buffers. Block compressed images are decoded to RGBA8 if the device can't
+	// sample the format. source_name is used in error messages.
+	bool														MTStageTextureContainer(
+		vk2d::_internal::ThreadLoaderResource				*	loader_thread_resource,
+		const void											*	container_data,
+		size_t													container_size,
+		const std::string									&	source_name,
+		std::vector<vk2d::_internal::BufferSubAllocation>	&	out_staging_buffers,
+		vk2d::_internal::TextureStagingInfo					&	out_staging_info );
+
+	// Adds a staging buffer for an image of byte_size and returns where its data
+	// goes. Images larger than a staging page are added as streamed images and
+	// get host memory instead. Returns nullptr if memory could not be allocated.
+	uint8_t													*	MTAllocateStagingImage(
+		vk2d::_internal::ThreadLoaderResource				*	loader_thread_resource,
+		VkDeviceSize											byte_size,
+		uint32_t												block_height,
+		std::vector<vk2d::_internal::BufferSubAllocation>	&	out_staging_buffers,
+		vk2d::_internal::TextureStagingInfo					&	out_staging_info );
+
+	// Streams every streamed image of staging info into an image and leaves
+	// every mip level and layer of it in transfer destination layout. Waits
+	// until the GPU is done, queue and command pool must be of the queue family
+	// that uses the image next.
+	bool														MTStreamStagingImages(
+		vk2d::_internal::ThreadLoaderResource				*	loader_thread_resource,
+		vk2d::_internal::ResolvedQueue							queue,
+		VkCommandPool											command_pool,
+		VkImage													destination,
+		const std::vector<VkExtent2D>						&	mip_level_extents,
+		vk2d::_internal::TextureStagingInfo					&	staging_info );
+
+	// Records commands with record_function into a primary render queue command
+	// buffer, submits it and waits until it's done. Render queue is used so that
+	// the commands are ordered after any frame that is still using the image.
+	bool														MTSubmitAndWait(
+		vk2d::_internal::ThreadLoaderResource				*	loader_thread_resource,
+		const std::string									&	operation_name,
+		const std::function<void( VkCommandBuffer )>		&	record_function );
+
+	// Records copy of every layer of mip levels from first_mip_level onwards
+	// of the current image, into mip levels from 0 onwards of destination.
+	void														CmdCopyImageToImage(
+		VkCommandBuffer											command_buffer,
+		VkImage													destination,
+		uint32_t												first_mip_level );
+
+	// Region update, primary render queue. Releases mip levels up to
+	// mip_level_count of a layer to the primary transfer queue family.
+	void														CmdUpdateRegionRelease(
+		VkCommandBuffer											command_buffer,
+		uint32_t												layer,
+		uint32_t												mip_level_count );
+
+	// Region update, primary transfer queue. Acquires the layer, copies area from
+	// a staging buffer into mip level 0 and releases the layer back.
+	void														CmdUpdateRegionCopy(
+		VkCommandBuffer											command_buffer,
+		VkBuffer												staging_buffer,
+		vk2d::Rect2u											area,
+		uint32_t												layer,
+		uint32_t												mip_level_count );
+
+	// Region update, primary render queue. Acquires the layer, then blits the
+	// parts of mip levels 1 to mip_level_count that the area affects.
+	void														CmdUpdateRegionMipLevels(
+		VkCommandBuffer											command_buffer,
+		vk2d::Rect2u											area,
+		uint32_t												layer,
+		uint32_t												mip_level_count );
+
+	struct RegionUpdateSlot;
+
+	// Frees the command buffers and synchronization primitives of a slot, staging buffer is kept.
+	void														DestroyRegionUpdateSlot(
+		RegionUpdateSlot									&	slot );
+
+	// Waits for region updates to finish on the GPU and frees everything used by them.
+	void														DestroyRegionUpdateResources();
+
+	// Makes new_image the current image, old image is retired.
+	void														ReplaceImage(
+		const vk2d::_internal::CompleteImageResource		&	new_image );
+
+	// Frees semaphores, command buffers and staging buffers used to load the texture.
+	void														DestroyTextureLoadResources();
 
 	vk2d::TextureResource									*	my_interface								= {};
 	vk2d::_internal::ResourceManagerImpl					*	resource_manager							= {};
 	vk2d::_internal::ThreadLoaderResource					*	loader_thread_resource						= {};
 
-	std::vector<vk2d::_internal::CompleteBufferResource>		staging_buffers								= {};
+	std::vector<vk2d::_internal::BufferSubAllocation>			staging_buffers								= {};
 	vk2d::_internal::CompleteImageResource						image										= {};
+	struct RetiredImage {
+		vk2d::_internal::CompleteImageResource					image										= {};
+		uint64_t												retired_epoch								= {};
+	};
+	std::vector<RetiredImage>									retired_images								= {};	// Protected by image_mutex.
+	VkImageCreateInfo											vk_image_create_info						= {};
+	VkImageViewCreateInfo										vk_image_view_create_info					= {};
 	VkImageLayout												vk_image_layout								= {};
+	mutable std::mutex											image_mutex;								// Image may be swapped by relocation or residency.
+	std::atomic<uint64_t>										generation									= {};
+	std::mutex													relocation_pin_mutex;
+	std::condition_variable										relocation_pin_condition;
+	uint32_t													relocation_pin_count						= {};	// Non-zero while defragmentation or residency holds this texture.
+	std::atomic_bool											load_resources_destroyed					= {};
 
 	uint32_t													image_layer_count							= {};
 	VkExtent2D													extent										= {};
@@ -96,6 +308,51 @@ private:
 	VkSemaphore													vk_blit_semaphore							= {};
 	VkFence														vk_texture_complete_fence					= {};
 
+	// Set if loaded with vk2d::ResourceManager::LoadTextureResources(), uploads
+	// are then submitted and waited on with the batch and the members above are unused.
+	std::shared_ptr<vk2d::_internal::TextureUploadBatch>		upload_batch								= {};
+
+	// Set by the resource manager if memory contains raw RGBA texels from an
+	// asset pack instead of an encoded image.
+	VkExtent2D													raw_memory_extent							= {};
+
+	// Set by the resource manager if memory stays valid for the lifetime of the
+	// resource manager, eg. asset packs, so the texture can be loaded again.
+	bool														is_memory_persistent						= {};
+
+	// Taken from the resource manager when first loaded so the texture is made
+	// the same way when loaded again, see vk2d::ResourceManager::SetTextureMipGeneration().
+	vk2d::TextureMipGenerationSettings							mip_generation_settings						= {};
+
+	// Region updates, see vk2d::TextureResource::UpdateRegion(). Slots are used in
+	// turn so the CPU fills one staging buffer while the GPU copies from the other.
+	// Staging buffers come from the instance memory pool, updates are main thread only.
+	// Texels are copied on the primary transfer queue, the primary render queue
+	// hands the layer over and takes it back for mip level blits.
+	struct RegionUpdateSlot {
+		vk2d::_internal::CompleteBufferResource					staging_buffer								= {};
+		VkCommandBuffer											render_release_command_buffer				= {};	// Only used if queue families differ.
+		VkCommandBuffer											transfer_command_buffer						= {};
+		VkCommandBuffer											render_acquire_command_buffer				= {};
+		VkSemaphore												render_release_semaphore					= {};
+		VkSemaphore												transfer_semaphore							= {};
+		VkFence													fence										= {};	// Signaled while the slot is free.
+	};
+	std::array<RegionUpdateSlot, 2>								region_update_slots							= {};
+	uint32_t													next_region_update_slot						= {};
+	VkCommandPool												vk_region_update_command_pool				= {};	// Primary render queue family.
+	VkCommandPool												vk_region_update_transfer_command_pool		= {};	// Primary transfer queue family.
+	std::mutex													region_update_mutex;						// Relocation and residency hold this while replacing the image.
+	std::atomic_bool											is_region_updated							= {};
+
+	// Texture residency, see vk2d::ResourceManager::SetTextureResidencyBudget().
+	std::atomic_bool											is_used										= {};	// Set when bound, cleared by every residency round.
+	uint64_t													last_used_tick								= {};	// Main thread only.
+	std::atomic<vk2d::_internal::TextureResidencyAction>		residency_action							= {};
+	std::atomic_bool											is_evicted									= {};
+	std::atomic_bool											is_reload_failed							= {};
+	std::atomic<VkDeviceSize>									full_image_size								= {};	// Size of the image before it was evicted.
+
 	bool														is_good										= {};
 };
 
@@ -6,6 +6,8 @@
 #include "Interface/Sampler.h"
 #include "Interface/SamplerImpl.h"
 
+#include "System/CommonTools.h"
+
 
 
 
@@ -84,6 +86,8 @@ vk2d::_internal::SamplerImpl::SamplerImpl(
 	assert( this->my_interface );
 	assert( this->instance );
 
+	resource_id					= vk2d::_internal::GenerateResourceID();
+
 	vk_device					= instance->GetVulkanDevice();
 	assert( vk_device );
 
@@ -331,6 +335,11 @@ bool vk2d::_internal::SamplerImpl::IsAnyBorderColorEnabled() const
 	return bool( border_color_enable.x || border_color_enable.y );
 }
 
+uint64_t vk2d::_internal::SamplerImpl::GetResourceID() const
+{
+	return resource_id;
+}
+
 bool vk2d::_internal::SamplerImpl::IsGood() const
 {
 	return is_good;
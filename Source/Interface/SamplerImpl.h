@@ -25,6 +25,9 @@ public:
 	vk2d::Vector2u								GetBorderColorEnable() const;
 	bool										IsAnyBorderColorEnabled() const;
 
+	// Unique for the lifetime of the process, see vk2d::_internal::GenerateResourceID().
+	uint64_t									GetResourceID() const;
+
 	bool										IsGood() const;
 
 
@@ -44,6 +47,8 @@ private:
 
 	vk2d::Vector2u								border_color_enable	= {};
 
+	uint64_t									resource_id			= {};
+
 	bool										is_good				= {};
 };
 
@@ -3,6 +3,8 @@
 #include "Core/SourceCommon.h"
 #include "Types/Vector2.hpp"
 
+#include "System/CommonTools.h"
+
 
 
 namespace vk2d {
@@ -25,9 +27,31 @@ public:
 
 	virtual bool									IsTextureDataReady()			= 0;
 
+	// Incremented whenever the image or image view handles change, eg. when the
+	// image was moved to another memory location. Descriptor sets written with
+	// an older generation refer to an image that is about to be destroyed.
+	virtual uint64_t								GetGeneration() const
+	{
+		return 0;
+	}
+
+	// Called whenever the texture is bound for drawing, lets textures that can
+	// be evicted know they're in use. Must be cheap, called for every draw.
+	virtual void									MarkUsed()
+	{
+	}
+
+	// Unique for the lifetime of the process, unlike the texture address this
+	// is never reused by another texture after this one is destroyed.
+	uint64_t										GetResourceID() const
+	{
+		return resource_id;
+	}
+
 	virtual bool									IsGood() const					= 0;
 
 private:
+	const uint64_t									resource_id						= vk2d::_internal::GenerateResourceID();
 };
 
 
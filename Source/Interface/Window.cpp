@@ -9,6 +9,7 @@
 
 #include "System/MeshBuffer.h"
 #include "System/ThreadPool.h"
+#include "System/QOI.hpp"
 
 #include "Interface/Window.h"
 #include "Interface/WindowImpl.h"
@@ -16,6 +17,7 @@
 #include "Interface/Instance.h"
 #include "Interface/InstanceImpl.h"
 
+#include "Interface/ResourceManager/ResourceManagerImpl.h"
 #include "Interface/ResourceManager/TextureResource.h"
 #include "Interface/ResourceManager/TextureResourceImpl.h"
 
@@ -30,6 +32,8 @@
 #include <stb_image.h>
 #include <stb_image_write.h>
 
+#include <fstream>
+
 
 
 
@@ -492,6 +496,11 @@ VK2D_API void VK2D_APIENTRY vk2d::Window::DrawMesh(
 	);
 }
 
+VK2D_API vk2d::DescriptorCacheStatistics VK2D_APIENTRY vk2d::Window::GetDescriptorCacheStatistics() const
+{
+	return impl->GetDescriptorCacheStatistics();
+}
+
 VK2D_API bool VK2D_APIENTRY vk2d::Window::IsGood() const
 {
 	if( !impl ) return false;
@@ -1074,13 +1083,16 @@ vk2d::_internal::WindowImpl::~WindowImpl()
 	}
 
 	instance->GetDeviceMemoryPool()->FreeCompleteResource( screenshot_image );
-	instance->GetDeviceMemoryPool()->FreeCompleteResource( screenshot_buffer );
 
 	mesh_buffer		= nullptr;
 
+	sampler_descriptor_set_cache	= nullptr;
+	texture_descriptor_set_cache	= nullptr;
+	bindless_texture_table			= nullptr;
+
 	instance->FreeDescriptorSet( frame_data_descriptor_set );
-	instance->GetDeviceMemoryPool()->FreeCompleteResource( frame_data_device_buffer );
-	instance->GetDeviceMemoryPool()->FreeCompleteResource( frame_data_staging_buffer );
+	instance->GetBufferSubAllocator( vk2d::_internal::BufferUsageClass::DEVICE_UNIFORM )->Free( frame_data_device_buffer );
+	frame_allocator	= nullptr;
 
 	for( auto f : vk_gpu_to_cpu_frame_fences ) {
 		vkDestroyFence(
@@ -1179,6 +1191,11 @@ bool vk2d::_internal::WindowImpl::ShouldClose()
 	return should_close;
 }
 
+bool vk2d::_internal::WindowImpl::IsRendering() const
+{
+	return next_render_call_function == vk2d::_internal::NextRenderCallFunction::END;
+}
+
 
 bool vk2d::_internal::AcquireImage(
 	vk2d::_internal::WindowImpl		*	impl,
@@ -1332,6 +1349,13 @@ bool vk2d::_internal::WindowImpl::BeginRender()
 		}
 	}
 
+	// Everything that's allocated from the frame allocator from here on
+	// lives until this swapchain image's frame fence has signaled.
+	frame_allocator->SetCurrentFrame( next_image );
+	sampler_descriptor_set_cache->SetCurrentFrame( next_image );
+	texture_descriptor_set_cache->SetCurrentFrame( next_image );
+	if( bindless_texture_table ) bindless_texture_table->SetCurrentFrame( next_image );
+
 	// Begin command buffer
 	{
 		VkCommandBuffer		command_buffer			= vk_render_command_buffers[ next_image ];
@@ -1393,6 +1417,15 @@ bool vk2d::_internal::WindowImpl::BeginRender()
 				1, &frame_data_descriptor_set.descriptorSet,
 				0, nullptr
 			);
+
+			// Bindless textures, bound once for the whole frame.
+			if( bindless_texture_table ) {
+				bindless_texture_table->CmdBind(
+					command_buffer,
+					instance->GetGraphicsPrimaryRenderPipelineLayout(),
+					GRAPHICS_DESCRIPTOR_SET_ALLOCATION_TEXTURE
+				);
+			}
 		}
 
 		// Begin render pass
@@ -1465,6 +1498,18 @@ bool vk2d::_internal::WindowImpl::EndRender()
 
 	// Save screenshot if it was requested
 	{
+		if( screenshot_state == vk2d::_internal::WindowImpl::ScreenshotState::REQUESTED ) {
+			screenshot_buffer = frame_allocator->Allocate(
+				VkDeviceSize( extent.width ) * VkDeviceSize( extent.height ) * sizeof( vk2d::Color8 ),
+				alignof( vk2d::Color8 )
+			);
+			if( screenshot_buffer != VK_SUCCESS ) {
+				instance->Report( screenshot_buffer.result, "Internal error: Cannot allocate screenshot buffer!" );
+				screenshot_event_error		= true;
+				screenshot_event_message	= "Internal error: Cannot allocate screenshot buffer.";
+				screenshot_state			= vk2d::_internal::WindowImpl::ScreenshotState::WAITING_EVENT_REPORT;
+			}
+		}
 		if( screenshot_state == vk2d::_internal::WindowImpl::ScreenshotState::REQUESTED ) {
 
 			VkImageSubresourceRange subresource_range {};
@@ -1571,7 +1616,7 @@ bool vk2d::_internal::WindowImpl::EndRender()
 			{
 				// Copy to host visible buffer
 				VkBufferImageCopy bufferImageCopyRegion {};
-				bufferImageCopyRegion.bufferOffset						= 0;
+				bufferImageCopyRegion.bufferOffset						= screenshot_buffer.offset;
 				bufferImageCopyRegion.bufferRowLength					= 0;
 				bufferImageCopyRegion.bufferImageHeight					= 0;
 				bufferImageCopyRegion.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
@@ -1596,8 +1641,8 @@ bool vk2d::_internal::WindowImpl::EndRender()
 				bufferMemoryBarriers[ 0 ].srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
 				bufferMemoryBarriers[ 0 ].dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
 				bufferMemoryBarriers[ 0 ].buffer				= screenshot_buffer.buffer;
-				bufferMemoryBarriers[ 0 ].offset				= 0;
-				bufferMemoryBarriers[ 0 ].size					= VK_WHOLE_SIZE;
+				bufferMemoryBarriers[ 0 ].offset				= screenshot_buffer.offset;
+				bufferMemoryBarriers[ 0 ].size					= screenshot_buffer.size;
 				vkCmdPipelineBarrier( render_command_buffer,
 					VK_PIPELINE_STAGE_TRANSFER_BIT,
 					VK_PIPELINE_STAGE_HOST_BIT,
@@ -1782,6 +1827,16 @@ bool vk2d::_internal::WindowImpl::EndRender()
 
 		// Notify render targets about successful command buffer submission.
 		ConfirmRenderTargetTextureRenderSubmission();
+
+		// Resources retired while this frame was recorded can be
+		// released once the render queues get past this point.
+		if( !instance->IsRendering() ) {
+			instance->GetResourceManagerImpl()->BeginRequestedRetiredImageEpoch();
+		}
+
+		// Render targets that are not rendered every frame still need their
+		// readbacks handed out.
+		instance->ProcessRenderTargetTextureReadbacks();
 	}
 
 	// Present swapchain image
@@ -2252,7 +2307,7 @@ void vk2d::_internal::WindowImpl::DrawTriangleList(
 		command_buffer,
 		sampler
 	);
-	CmdBindTextureIfDifferent(
+	auto texture_index = CmdBindTextureIfDifferent(
 		command_buffer,
 		texture
 	);
@@ -2274,6 +2329,7 @@ void vk2d::_internal::WindowImpl::DrawTriangleList(
 			pc.vertex_offset			= push_result.location_info.vertex_offset;
 			pc.texture_channel_weight_offset	= push_result.location_info.texture_channel_weight_offset;
 			pc.texture_channel_weight_count	= texture->GetLayerCount();
+			pc.texture_index			= texture_index;
 
 			vkCmdPushConstants(
 				command_buffer,
@@ -2413,7 +2469,7 @@ void vk2d::_internal::WindowImpl::DrawLineList(
 		command_buffer,
 		sampler
 	);
-	CmdBindTextureIfDifferent(
+	auto texture_index = CmdBindTextureIfDifferent(
 		command_buffer,
 		texture
 	);
@@ -2435,6 +2491,7 @@ void vk2d::_internal::WindowImpl::DrawLineList(
 			pc.vertex_offset			= push_result.location_info.vertex_offset;
 			pc.texture_channel_weight_offset	= push_result.location_info.texture_channel_weight_offset;
 			pc.texture_channel_weight_count	= texture->GetLayerCount();
+			pc.texture_index			= texture_index;
 
 			vkCmdPushConstants(
 				command_buffer,
@@ -2521,7 +2578,7 @@ void vk2d::_internal::WindowImpl::DrawPointList(
 		command_buffer,
 		sampler
 	);
-	CmdBindTextureIfDifferent(
+	auto texture_index = CmdBindTextureIfDifferent(
 		command_buffer,
 		texture
 	);
@@ -2543,6 +2600,7 @@ void vk2d::_internal::WindowImpl::DrawPointList(
 			pc.vertex_offset			= push_result.location_info.vertex_offset;
 			pc.texture_channel_weight_offset	= push_result.location_info.texture_channel_weight_offset;
 			pc.texture_channel_weight_count	= texture->GetLayerCount();
+			pc.texture_index			= texture_index;
 
 			vkCmdPushConstants(
 				command_buffer,
@@ -2715,6 +2773,14 @@ public:
 				screenshot_data,
 				90
 			);
+		} else if( extension == ".qoi" ) {
+			// Lossless like PNG but many times faster to encode.
+			std::vector<uint8_t> qoi_data;
+			if( vk2d::_internal::EncodeQOI( screenshot_data, extent.x, extent.y, uint32_t( pixel_channels ), qoi_data ) ) {
+				std::ofstream file( path, std::ios::binary );
+				file.write( reinterpret_cast<const char*>( qoi_data.data() ), std::streamsize( qoi_data.size() ) );
+				stbi_write_success = file.good() ? 1 : 0;
+			}
 		} else {
 			window->instance->Report( vk2d::ReportSeverity::INFO, "Screenshot extension was not known, saving screenshot as .png" );
 			path += ".png";
@@ -2792,10 +2858,15 @@ bool vk2d::_internal::WindowImpl::SynchronizeFrame()
 				{
 					screenshot_save_data.size = { extent.width, extent.height };
 					screenshot_save_data.data.resize( extent.width * extent.height );
-					auto mapped_data = screenshot_buffer.memory.Map<vk2d::Color8>();
+					auto mapped_data = screenshot_buffer.Get<vk2d::Color8>();
 					if( mapped_data ) {
-						std::memcpy( screenshot_save_data.data.data(), mapped_data, screenshot_save_data.data.size() * sizeof( vk2d::Color8 ) );
-						screenshot_buffer.memory.Unmap();
+						screenshot_buffer.Invalidate();
+						std::memcpy(
+							screenshot_save_data.data.data(),
+							mapped_data,
+							size_t( std::min( VkDeviceSize( screenshot_save_data.data.size() * sizeof( vk2d::Color8 ) ), screenshot_buffer.size ) )
+						);
+						screenshot_buffer	= {};
 
 						if( screenshot_save_path.empty() ) {
 							screenshot_state		= vk2d::_internal::WindowImpl::ScreenshotState::WAITING_EVENT_REPORT;
@@ -2819,6 +2890,12 @@ bool vk2d::_internal::WindowImpl::SynchronizeFrame()
 			}
 		}
 
+		// GPU is done with the previous frame, transient allocations can be reused.
+		frame_allocator->ResetFrame( previous_image );
+		sampler_descriptor_set_cache->ResetFrame( previous_image );
+		texture_descriptor_set_cache->ResetFrame( previous_image );
+		if( bindless_texture_table ) bindless_texture_table->ResetFrame( previous_image );
+
 		// And we also don't need to synchronize later.
 		previous_frame_need_synchronization	= false;
 	}
@@ -2826,6 +2903,14 @@ bool vk2d::_internal::WindowImpl::SynchronizeFrame()
 	return true;
 }
 
+vk2d::DescriptorCacheStatistics vk2d::_internal::WindowImpl::GetDescriptorCacheStatistics() const
+{
+	return vk2d::_internal::CombineDescriptorCacheStatistics(
+		sampler_descriptor_set_cache.get(),
+		texture_descriptor_set_cache.get()
+	);
+}
+
 bool vk2d::_internal::WindowImpl::IsGood()
 {
 	return is_good;
@@ -3484,7 +3569,6 @@ bool vk2d::_internal::WindowImpl::ReCreateScreenshotResources()
 	auto memory_pool	= instance->GetDeviceMemoryPool();
 	assert( memory_pool );
 
-	memory_pool->FreeCompleteResource( screenshot_buffer );
 	memory_pool->FreeCompleteResource( screenshot_image );
 
 	VkImageCreateInfo image_create_info {};
@@ -3513,25 +3597,6 @@ bool vk2d::_internal::WindowImpl::ReCreateScreenshotResources()
 		return false;
 	}
 
-	VkBufferCreateInfo buffer_create_info {};
-	buffer_create_info.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-	buffer_create_info.pNext					= nullptr;
-	buffer_create_info.flags					= 0;
-	buffer_create_info.size						= VkDeviceSize( extent.width ) * VkDeviceSize( extent.height ) * 4;
-	buffer_create_info.usage					= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-	buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
-	buffer_create_info.queueFamilyIndexCount	= 0;
-	buffer_create_info.pQueueFamilyIndices		= nullptr;
-	screenshot_buffer = instance->GetDeviceMemoryPool()->CreateCompleteBufferResource(
-		&buffer_create_info,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-	);
-	if( screenshot_buffer != VK_SUCCESS ) {
-		instance->Report( screenshot_buffer.result, "Internal error: Cannot create internal screenshot buffer, screenshots disabled!" );
-		screenshot_state	= vk2d::_internal::WindowImpl::ScreenshotState::IDLE_ERROR;
-		return false;
-	}
-
 	return true;
 }
 
@@ -3735,38 +3800,39 @@ bool vk2d::_internal::WindowImpl::CreateFrameSynchronizationPrimitives()
 
 bool vk2d::_internal::WindowImpl::CreateWindowFrameDataBuffer()
 {
-	// Create staging and device buffers
+	// Create frame allocator and device buffer, FrameData staging is allocated per frame.
 	{
-		VkBufferCreateInfo staging_buffer_create_info {};
-		staging_buffer_create_info.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		staging_buffer_create_info.pNext					= nullptr;
-		staging_buffer_create_info.flags					= 0;
-		staging_buffer_create_info.size						= sizeof( vk2d::_internal::FrameData );
-		staging_buffer_create_info.usage					= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-		staging_buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
-		staging_buffer_create_info.queueFamilyIndexCount	= 0;
-		staging_buffer_create_info.pQueueFamilyIndices		= nullptr;
-		frame_data_staging_buffer = instance->GetDeviceMemoryPool()->CreateCompleteBufferResource(
-			&staging_buffer_create_info,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+		frame_allocator = std::make_unique<vk2d::_internal::FrameLinearAllocator>(
+			instance->GetDeviceMemoryPool(),
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT
 		);
-		if( frame_data_staging_buffer != VK_SUCCESS ) {
-			instance->Report( frame_data_staging_buffer.result, "Internal error. Cannot create staging buffer for FrameData!" );
+		if( !frame_allocator || !frame_allocator->IsGood() ) {
+			instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error. Cannot create frame allocator!" );
 			return false;
 		}
 
-		VkBufferCreateInfo device_buffer_create_info {};
-		device_buffer_create_info.sType						= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		device_buffer_create_info.pNext						= nullptr;
-		device_buffer_create_info.flags						= 0;
-		device_buffer_create_info.size						= sizeof( vk2d::_internal::FrameData );
-		device_buffer_create_info.usage						= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-		device_buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
-		device_buffer_create_info.queueFamilyIndexCount		= 0;
-		device_buffer_create_info.pQueueFamilyIndices		= nullptr;
-		frame_data_device_buffer = instance->GetDeviceMemoryPool()->CreateCompleteBufferResource(
-			&device_buffer_create_info,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+		sampler_descriptor_set_cache = std::make_unique<vk2d::_internal::DescriptorSetCache>(
+			instance,
+			instance->GetGraphicsSamplerDescriptorSetLayout()
+		);
+		texture_descriptor_set_cache = std::make_unique<vk2d::_internal::DescriptorSetCache>(
+			instance,
+			instance->GetGraphicsTextureDescriptorSetLayout()
+		);
+
+		if( instance->IsBindlessTexturesEnabled() ) {
+			bindless_texture_table = std::make_unique<vk2d::_internal::BindlessTextureTable>(
+				instance,
+				instance->GetGraphicsTextureArraySize()
+			);
+			if( !bindless_texture_table || !bindless_texture_table->IsGood() ) {
+				instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error. Cannot create bindless texture table!" );
+				return false;
+			}
+		}
+
+		frame_data_device_buffer = instance->GetBufferSubAllocator( vk2d::_internal::BufferUsageClass::DEVICE_UNIFORM )->Allocate(
+			sizeof( vk2d::_internal::FrameData )
 		);
 		if( frame_data_device_buffer != VK_SUCCESS ) {
 			instance->Report( frame_data_device_buffer.result, "Internal error. Cannot create device local buffer for FrameData!" );
@@ -3785,7 +3851,7 @@ bool vk2d::_internal::WindowImpl::CreateWindowFrameDataBuffer()
 		}
 		VkDescriptorBufferInfo descriptor_write_buffer_info {};
 		descriptor_write_buffer_info.buffer	= frame_data_device_buffer.buffer;
-		descriptor_write_buffer_info.offset	= 0;
+		descriptor_write_buffer_info.offset	= frame_data_device_buffer.offset;
 		descriptor_write_buffer_info.range	= sizeof( vk2d::_internal::FrameData );
 		VkWriteDescriptorSet descriptor_write {};
 		descriptor_write.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -3928,15 +3994,19 @@ void vk2d::_internal::WindowImpl::CmdBindSamplerIfDifferent(
 
 	// if sampler or texture changed since previous call, bind a different descriptor set.
 	if( sampler != previous_sampler ) {
-		auto & set = sampler_descriptor_sets[ sampler ];
-
-		// If this descriptor set doesn't exist yet for this
-		// sampler texture combo, create one and update it.
-		if( set.descriptor_set.descriptorSet == VK_NULL_HANDLE ) {
-			set.descriptor_set = instance->AllocateDescriptorSet(
-				instance->GetGraphicsSamplerDescriptorSetLayout()
-			);
+		bool needs_write = false;
+		auto descriptor_set = sampler_descriptor_set_cache->Acquire(
+			sampler->impl->GetResourceID(),
+			0,
+			needs_write
+		);
+		if( descriptor_set == VK_NULL_HANDLE ) {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot allocate descriptor set for sampler!" );
+			return;
+		}
 
+		// If this descriptor set didn't exist yet for this sampler, update it.
+		if( needs_write ) {
 			VkDescriptorImageInfo image_info {};
 			image_info.sampler						= sampler->impl->GetVulkanSampler();
 			image_info.imageView					= VK_NULL_HANDLE;
@@ -3950,7 +4020,7 @@ void vk2d::_internal::WindowImpl::CmdBindSamplerIfDifferent(
 			std::array<VkWriteDescriptorSet, 2> descriptor_write {};
 			descriptor_write[ 0 ].sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 			descriptor_write[ 0 ].pNext				= nullptr;
-			descriptor_write[ 0 ].dstSet			= set.descriptor_set.descriptorSet;
+			descriptor_write[ 0 ].dstSet			= descriptor_set;
 			descriptor_write[ 0 ].dstBinding		= 0;
 			descriptor_write[ 0 ].dstArrayElement	= 0;
 			descriptor_write[ 0 ].descriptorCount	= 1;
@@ -3961,7 +4031,7 @@ void vk2d::_internal::WindowImpl::CmdBindSamplerIfDifferent(
 
 			descriptor_write[ 1 ].sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 			descriptor_write[ 1 ].pNext				= nullptr;
-			descriptor_write[ 1 ].dstSet			= set.descriptor_set.descriptorSet;
+			descriptor_write[ 1 ].dstSet			= descriptor_set;
 			descriptor_write[ 1 ].dstBinding		= 1;
 			descriptor_write[ 1 ].dstArrayElement	= 0;
 			descriptor_write[ 1 ].descriptorCount	= 1;
@@ -3976,14 +4046,13 @@ void vk2d::_internal::WindowImpl::CmdBindSamplerIfDifferent(
 				0, nullptr
 			);
 		}
-		set.previous_access_time = std::chrono::steady_clock::now();
 
 		vkCmdBindDescriptorSets(
 			command_buffer,
 			VK_PIPELINE_BIND_POINT_GRAPHICS,
 			instance->GetGraphicsPrimaryRenderPipelineLayout(),
 			GRAPHICS_DESCRIPTOR_SET_ALLOCATION_SAMPLER_AND_SAMPLER_DATA,
-			1, &set.descriptor_set.descriptorSet,
+			1, &descriptor_set,
 			0, nullptr
 		);
 
@@ -3991,24 +4060,72 @@ void vk2d::_internal::WindowImpl::CmdBindSamplerIfDifferent(
 	}
 }
 
-void vk2d::_internal::WindowImpl::CmdBindTextureIfDifferent(
+uint32_t vk2d::_internal::WindowImpl::CmdBindTextureIfDifferent(
 	VkCommandBuffer			command_buffer,
 	vk2d::Texture		*	texture
 )
 {
 	assert( texture );
 
-	// if sampler or texture changed since previous call, bind a different descriptor set.
-	if( texture != previous_texture ) {
-		auto & set = texture_descriptor_sets[ texture ];
+	texture->texture_impl->MarkUsed();
+
+	// Bindless table is bound once per frame, only the index changes.
+	// In bindless mode previous_texture is only set while the overflow
+	// descriptor set of a texture that didn't fit the table is bound.
+	if( bindless_texture_table ) {
+		uint32_t texture_index = 0;
+		if( bindless_texture_table->GetTextureIndex( texture, texture_index ) ) {
+			if( previous_texture ) {
+				bindless_texture_table->CmdBind(
+					command_buffer,
+					instance->GetGraphicsPrimaryRenderPipelineLayout(),
+					GRAPHICS_DESCRIPTOR_SET_ALLOCATION_TEXTURE
+				);
+				previous_texture		= nullptr;
+			}
+			return texture_index;
+		}
 
-		// If this descriptor set doesn't exist yet for this
-		// sampler texture combo, create one and update it.
-		if( set.descriptor_set.descriptorSet == VK_NULL_HANDLE ) {
-			set.descriptor_set = instance->AllocateDescriptorSet(
-				instance->GetGraphicsTextureDescriptorSetLayout()
+		// Table is full, fall back to a descriptor set holding only this texture.
+		if( texture != previous_texture ) {
+			auto descriptor_set = bindless_texture_table->GetOverflowDescriptorSet( texture );
+			if( descriptor_set == VK_NULL_HANDLE ) {
+				instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot allocate descriptor set for texture!" );
+				return 0;
+			}
+
+			vkCmdBindDescriptorSets(
+				command_buffer,
+				VK_PIPELINE_BIND_POINT_GRAPHICS,
+				instance->GetGraphicsPrimaryRenderPipelineLayout(),
+				GRAPHICS_DESCRIPTOR_SET_ALLOCATION_TEXTURE,
+				1, &descriptor_set,
+				0, nullptr
 			);
 
+			previous_texture		= texture;
+		}
+		return 0;
+	}
+
+	// if sampler or texture changed since previous call, bind a different descriptor set.
+	if( texture != previous_texture ) {
+		// Generation is read before the image view, if the texture image gets
+		// replaced in between we'll just write the descriptor set again next time.
+		// Cache replaces the descriptor set if the generation changed.
+		bool needs_write = false;
+		auto descriptor_set = texture_descriptor_set_cache->Acquire(
+			texture->texture_impl->GetResourceID(),
+			texture->texture_impl->GetGeneration(),
+			needs_write
+		);
+		if( descriptor_set == VK_NULL_HANDLE ) {
+			instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot allocate descriptor set for texture!" );
+			return 0;
+		}
+
+		// If this descriptor set didn't exist yet for this texture, update it.
+		if( needs_write ) {
 			VkDescriptorImageInfo image_info {};
 			image_info.sampler						= VK_NULL_HANDLE;
 			image_info.imageView					= texture->texture_impl->GetVulkanImageView();
@@ -4017,7 +4134,7 @@ void vk2d::_internal::WindowImpl::CmdBindTextureIfDifferent(
 			std::array<VkWriteDescriptorSet, 1> descriptor_write {};
 			descriptor_write[ 0 ].sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 			descriptor_write[ 0 ].pNext				= nullptr;
-			descriptor_write[ 0 ].dstSet			= set.descriptor_set.descriptorSet;
+			descriptor_write[ 0 ].dstSet			= descriptor_set;
 			descriptor_write[ 0 ].dstBinding		= 0;
 			descriptor_write[ 0 ].dstArrayElement	= 0;
 			descriptor_write[ 0 ].descriptorCount	= 1;
@@ -4032,19 +4149,19 @@ void vk2d::_internal::WindowImpl::CmdBindTextureIfDifferent(
 				0, nullptr
 			);
 		}
-		set.previous_access_time = std::chrono::steady_clock::now();
 
 		vkCmdBindDescriptorSets(
 			command_buffer,
 			VK_PIPELINE_BIND_POINT_GRAPHICS,
 			instance->GetGraphicsPrimaryRenderPipelineLayout(),
 			GRAPHICS_DESCRIPTOR_SET_ALLOCATION_TEXTURE,
-			1, &set.descriptor_set.descriptorSet,
+			1, &descriptor_set,
 			0, nullptr
 		);
 
 		previous_texture		= texture;
 	}
+	return 0;
 }
 
 void vk2d::_internal::WindowImpl::CmdSetLineWidthIfDifferent(
@@ -4104,20 +4221,21 @@ bool vk2d::_internal::WindowImpl::CmdUpdateFrameData(
 	}
 
 	// Copy data to staging buffer.
+	auto frame_data_staging_buffer = frame_allocator->Allocate<vk2d::_internal::FrameData>( 1 );
 	{
-		auto frame_data = frame_data_staging_buffer.memory.Map<vk2d::_internal::FrameData>();
-		if( !frame_data ) {
-			instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error: Cannot map FrameData staging buffer memory!" );
+		if( frame_data_staging_buffer != VK_SUCCESS ) {
+			instance->Report( frame_data_staging_buffer.result, "Internal error: Cannot allocate FrameData staging buffer memory!" );
 			return false;
 		}
+		auto frame_data = frame_data_staging_buffer.Get<vk2d::_internal::FrameData>();
 		frame_data->coordinate_scaling		= window_coordinate_scaling;
-		frame_data_staging_buffer.memory.Unmap();
+		frame_data_staging_buffer.Flush();
 	}
 	// Record transfer commands from staging buffer to device local buffer.
 	{
 		VkBufferCopy copy_region {};
-		copy_region.srcOffset	= 0;
-		copy_region.dstOffset	= 0;
+		copy_region.srcOffset	= frame_data_staging_buffer.offset;
+		copy_region.dstOffset	= frame_data_device_buffer.offset;
 		copy_region.size		= sizeof( vk2d::_internal::FrameData );
 		vkCmdCopyBuffer(
 			command_buffer,
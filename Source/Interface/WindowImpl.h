@@ -7,6 +7,9 @@
 #include "System/MeshBuffer.h"
 #include "System/QueueResolver.h"
 #include "System/VulkanMemoryManagement.h"
+#include "System/FrameLinearAllocator.h"
+#include "System/BindlessTextureTable.h"
+#include "System/DescriptorSetCache.h"
 #include "System/DescriptorSet.h"
 #include "System/ShaderInterface.h"
 #include "System/RenderTargetTextureDependecyGraphInfo.hpp"
@@ -90,6 +93,9 @@ public:
 	bool														BeginRender();
 	bool														EndRender();
 
+	// True between BeginRender() and EndRender().
+	bool														IsRendering() const;
+
 	void														TakeScreenshotToFile(
 		const std::filesystem::path							&	save_path,
 		bool													include_alpha );
@@ -215,6 +221,8 @@ public:
 
 	bool														SynchronizeFrame();
 
+	vk2d::DescriptorCacheStatistics								GetDescriptorCacheStatistics() const;
+
 	bool														IsGood();
 
 public:
@@ -262,7 +270,8 @@ public:
 		VkCommandBuffer											command_buffer,
 		vk2d::Sampler										*	sampler );
 
-	void														CmdBindTextureIfDifferent(
+	// Returns texture index for push constants.
+	uint32_t													CmdBindTextureIfDifferent(
 		VkCommandBuffer											command_buffer,
 		vk2d::Texture										*	texture );
 
@@ -329,8 +338,9 @@ public:
 	std::vector<VkFence>										vk_gpu_to_cpu_frame_fences					= {};
 	bool														previous_frame_need_synchronization			= {};
 
-	vk2d::_internal::CompleteBufferResource						frame_data_staging_buffer					= {};
-	vk2d::_internal::CompleteBufferResource						frame_data_device_buffer					= {};
+	std::unique_ptr<vk2d::_internal::FrameLinearAllocator>		frame_allocator								= {};	// Per swapchain image transient host visible memory.
+	std::unique_ptr<vk2d::_internal::BindlessTextureTable>		bindless_texture_table						= {};	// Only if bindless textures are enabled.
+	vk2d::_internal::BufferSubAllocation						frame_data_device_buffer					= {};
 	vk2d::_internal::PoolDescriptorSet							frame_data_descriptor_set					= {};
 
 	vk2d::_internal::NextRenderCallFunction						next_render_call_function					= vk2d::_internal::NextRenderCallFunction::BEGIN;
@@ -342,11 +352,8 @@ public:
 	vk2d::Sampler											*	previous_sampler							= {};
 	float														previous_line_width							= {};
 
-	std::map<vk2d::Sampler*, vk2d::_internal::TimedDescriptorPoolData>
-																sampler_descriptor_sets						= {};
-
-	std::map<vk2d::Texture*, vk2d::_internal::TimedDescriptorPoolData>
-																texture_descriptor_sets						= {};
+	std::unique_ptr<vk2d::_internal::DescriptorSetCache>		sampler_descriptor_set_cache				= {};
+	std::unique_ptr<vk2d::_internal::DescriptorSetCache>		texture_descriptor_set_cache				= {};
 
 	std::unique_ptr<vk2d::_internal::MeshBuffer>				mesh_buffer									= {};
 
@@ -367,7 +374,7 @@ public:
 	vk2d::ImageData												screenshot_save_data						= {};
 	bool														screenshot_alpha							= {};
 	vk2d::_internal::CompleteImageResource						screenshot_image							= {};
-	vk2d::_internal::CompleteBufferResource						screenshot_buffer							= {};
+	vk2d::_internal::FrameLinearAllocation						screenshot_buffer							= {};	// Allocated from frame_allocator when screenshot is requested.
 	uint32_t													screenshot_swapchain_id						= {};
 	bool														screenshot_event_error						= {};
 	std::string													screenshot_event_message					= {};
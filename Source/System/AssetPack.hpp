@@ -0,0 +1,337 @@
+#pragma once
+
+// Only depends on the standard library so the PackAssets tool can use this too.
+#include "Core/Common.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if !defined( VK2D_PLATFORM_WINDOWS )
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+
+namespace vk2d {
+namespace _internal {
+
+
+
+// Asset pack is a single file containing many assets so they can be loaded
+// without opening every file separately. The pack is memory mapped and assets
+// are found by path from a sorted index, asset data is used directly from the
+// mapping. Layout, all values little endian:
+//
+//	AssetPackHeader
+//	AssetPackEntry[ entry_count ]		Sorted by path.
+//	Path table							Paths of all entries, not null terminated.
+//	Asset data							Each aligned to ASSET_PACK_DATA_ALIGNMENT.
+//
+// Packs are built with the PackAssets tool.
+
+constexpr char			ASSET_PACK_MAGIC[ 8 ]			= { 'V', 'K', '2', 'D', 'P', 'A', 'C', 'K' };
+constexpr uint32_t		ASSET_PACK_VERSION				= 1;
+constexpr uint64_t		ASSET_PACK_DATA_ALIGNMENT		= 16;
+
+enum class AssetPackPayload : uint32_t {
+	ENCODED				= 0,	// File as is, image or font file.
+	RAW_RGBA8			= 1,	// Decoded texels, 4 bytes per texel, width * height texels.
+};
+
+struct AssetPackHeader {
+	char											magic[ 8 ]				= {};
+	uint32_t										version					= {};
+	uint32_t										entry_count				= {};
+	uint64_t										entries_offset			= {};
+	uint64_t										path_table_offset		= {};
+	uint64_t										path_table_size			= {};
+};
+static_assert( sizeof( AssetPackHeader ) == 40, "AssetPackHeader must be tightly packed." );
+
+struct AssetPackEntry {
+	uint64_t										path_offset				= {};	// From the beginning of the path table.
+	uint32_t										path_size				= {};
+	vk2d::_internal::AssetPackPayload				payload					= {};
+	uint64_t										data_offset				= {};	// From the beginning of the file.
+	uint64_t										data_size				= {};
+	uint32_t										width					= {};	// RAW_RGBA8 only.
+	uint32_t										height					= {};	// RAW_RGBA8 only.
+};
+static_assert( sizeof( AssetPackEntry ) == 40, "AssetPackEntry must be tightly packed." );
+
+// Paths are stored and looked up in this form, eg. "./Data/../Data/a.png"
+// becomes "Data/a.png".
+inline std::string GetAssetPackPath(
+	const std::filesystem::path						&	path )
+{
+	return path.lexically_normal().generic_string();
+}
+
+
+
+// Asset found from an asset pack, data points into the pack mapping.
+struct AssetPackItem {
+	vk2d::_internal::AssetPackPayload				payload					= {};
+	const void									*	data					= {};
+	size_t											size					= {};
+	uint32_t										width					= {};
+	uint32_t										height					= {};
+};
+
+
+
+// Asset given to WriteAssetPack().
+struct AssetPackSourceEntry {
+	std::string										path					= {};
+	vk2d::_internal::AssetPackPayload				payload					= {};
+	std::vector<uint8_t>							data					= {};
+	uint32_t										width					= {};
+	uint32_t										height					= {};
+};
+
+// Writes a new asset pack, returns false if the file could not be written or
+// if the same path was given more than once.
+inline bool WriteAssetPack(
+	const std::filesystem::path						&	pack_path,
+	std::vector<vk2d::_internal::AssetPackSourceEntry>	source_entries )
+{
+	for( auto & s : source_entries ) {
+		s.path = vk2d::_internal::GetAssetPackPath( s.path );
+	}
+	std::sort( source_entries.begin(), source_entries.end(), []( auto & a, auto & b ) { return a.path < b.path; } );
+	for( size_t i = 1; i < source_entries.size(); ++i ) {
+		if( source_entries[ i - 1 ].path == source_entries[ i ].path ) return false;
+	}
+
+	auto AlignUp = []( uint64_t value ) -> uint64_t
+	{
+		return ( value + vk2d::_internal::ASSET_PACK_DATA_ALIGNMENT - 1 ) / vk2d::_internal::ASSET_PACK_DATA_ALIGNMENT * vk2d::_internal::ASSET_PACK_DATA_ALIGNMENT;
+	};
+
+	vk2d::_internal::AssetPackHeader header {};
+	std::memcpy( header.magic, vk2d::_internal::ASSET_PACK_MAGIC, sizeof( header.magic ) );
+	header.version				= vk2d::_internal::ASSET_PACK_VERSION;
+	header.entry_count			= uint32_t( source_entries.size() );
+	header.entries_offset		= sizeof( vk2d::_internal::AssetPackHeader );
+	header.path_table_offset	= header.entries_offset + sizeof( vk2d::_internal::AssetPackEntry ) * source_entries.size();
+
+	std::vector<vk2d::_internal::AssetPackEntry> entries( source_entries.size() );
+	std::string path_table;
+	for( size_t i = 0; i < source_entries.size(); ++i ) {
+		entries[ i ].path_offset	= uint64_t( path_table.size() );
+		entries[ i ].path_size		= uint32_t( source_entries[ i ].path.size() );
+		path_table					+= source_entries[ i ].path;
+	}
+	header.path_table_size		= uint64_t( path_table.size() );
+
+	auto data_offset = AlignUp( header.path_table_offset + header.path_table_size );
+	for( size_t i = 0; i < source_entries.size(); ++i ) {
+		entries[ i ].payload		= source_entries[ i ].payload;
+		entries[ i ].data_offset	= data_offset;
+		entries[ i ].data_size		= uint64_t( source_entries[ i ].data.size() );
+		entries[ i ].width			= source_entries[ i ].width;
+		entries[ i ].height			= source_entries[ i ].height;
+		data_offset					= AlignUp( data_offset + entries[ i ].data_size );
+	}
+
+	std::ofstream file( pack_path, std::ios::binary | std::ios::trunc );
+	if( !file ) return false;
+
+	auto WriteAt = [ &file ]( uint64_t offset, const void * data, size_t size )
+	{
+		auto position = uint64_t( file.tellp() );
+		static const char padding[ vk2d::_internal::ASSET_PACK_DATA_ALIGNMENT ] = {};
+		while( position < offset ) {
+			auto count = std::min( offset - position, uint64_t( sizeof( padding ) ) );
+			file.write( padding, std::streamsize( count ) );
+			position += count;
+		}
+		file.write( reinterpret_cast<const char*>( data ), std::streamsize( size ) );
+	};
+
+	WriteAt( 0, &header, sizeof( header ) );
+	WriteAt( header.entries_offset, entries.data(), entries.size() * sizeof( vk2d::_internal::AssetPackEntry ) );
+	WriteAt( header.path_table_offset, path_table.data(), path_table.size() );
+	for( size_t i = 0; i < source_entries.size(); ++i ) {
+		WriteAt( entries[ i ].data_offset, source_entries[ i ].data.data(), source_entries[ i ].data.size() );
+	}
+	return bool( file );
+}
+
+
+
+// Read only view to an asset pack file. The file is memory mapped for the
+// lifetime of this object so data returned by Find() stays valid until then.
+// Pages are loaded by the operating system on first access, opening a pack
+// only reads and validates the index. Thread safe after construction.
+class AssetPack {
+public:
+	explicit											AssetPack(
+		const std::filesystem::path					&	pack_path )
+	{
+		if( !Map( pack_path ) ) return;
+		if( !Validate() ) {
+			Unmap();
+			return;
+		}
+		is_good		= true;
+	}
+
+														AssetPack(
+		const vk2d::_internal::AssetPack			&	other )				= delete;
+
+	vk2d::_internal::AssetPack						&	operator=(
+		const vk2d::_internal::AssetPack			&	other )				= delete;
+
+														~AssetPack()
+	{
+		Unmap();
+	}
+
+	// Returns false if path is not in the pack.
+	bool												Find(
+		const std::filesystem::path					&	path,
+		vk2d::_internal::AssetPackItem				&	out_item ) const
+	{
+		if( !is_good ) return false;
+
+		auto pack_path	= vk2d::_internal::GetAssetPackPath( path );
+		auto end		= entries + header->entry_count;
+		auto it = std::lower_bound( entries, end, std::string_view( pack_path ), [ this ]( const vk2d::_internal::AssetPackEntry & entry, std::string_view p )
+			{
+				return GetEntryPath( entry ) < p;
+			} );
+		if( it == end || GetEntryPath( *it ) != pack_path ) return false;
+
+		out_item.payload	= it->payload;
+		out_item.data		= mapping + it->data_offset;
+		out_item.size		= size_t( it->data_size );
+		out_item.width		= it->width;
+		out_item.height		= it->height;
+		return true;
+	}
+
+	size_t												GetEntryCount() const
+	{
+		return is_good ? size_t( header->entry_count ) : 0;
+	}
+
+	bool												IsGood() const
+	{
+		return is_good;
+	}
+
+private:
+	std::string_view									GetEntryPath(
+		const vk2d::_internal::AssetPackEntry		&	entry ) const
+	{
+		return std::string_view( path_table + entry.path_offset, entry.path_size );
+	}
+
+	bool												Map(
+		const std::filesystem::path					&	pack_path )
+	{
+#if defined( VK2D_PLATFORM_WINDOWS )
+		auto file = CreateFileW( pack_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+		if( file == INVALID_HANDLE_VALUE ) return false;
+
+		LARGE_INTEGER file_size {};
+		if( !GetFileSizeEx( file, &file_size ) || !file_size.QuadPart ) {
+			CloseHandle( file );
+			return false;
+		}
+		// View stays valid after the handles are closed.
+		auto file_mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+		CloseHandle( file );
+		if( !file_mapping ) return false;
+		auto view = MapViewOfFile( file_mapping, FILE_MAP_READ, 0, 0, 0 );
+		CloseHandle( file_mapping );
+		if( !view ) return false;
+
+		mapping			= reinterpret_cast<const uint8_t*>( view );
+		mapping_size	= size_t( file_size.QuadPart );
+#else
+		auto file = open( pack_path.c_str(), O_RDONLY );
+		if( file < 0 ) return false;
+
+		struct stat file_stat {};
+		if( fstat( file, &file_stat ) != 0 || file_stat.st_size <= 0 ) {
+			close( file );
+			return false;
+		}
+		// Mapping stays valid after the file is closed.
+		auto view = mmap( nullptr, size_t( file_stat.st_size ), PROT_READ, MAP_PRIVATE, file, 0 );
+		close( file );
+		if( view == MAP_FAILED ) return false;
+
+		mapping			= reinterpret_cast<const uint8_t*>( view );
+		mapping_size	= size_t( file_stat.st_size );
+#endif
+		return true;
+	}
+
+	void												Unmap()
+	{
+		if( !mapping ) return;
+#if defined( VK2D_PLATFORM_WINDOWS )
+		UnmapViewOfFile( mapping );
+#else
+		munmap( const_cast<uint8_t*>( mapping ), mapping_size );
+#endif
+		mapping			= nullptr;
+		mapping_size	= 0;
+	}
+
+	// Checks that everything the index refers to is inside the file and that
+	// paths are sorted, after this Find() does not need to check anything.
+	bool												Validate()
+	{
+		if( mapping_size < sizeof( vk2d::_internal::AssetPackHeader ) ) return false;
+		header = reinterpret_cast<const vk2d::_internal::AssetPackHeader*>( mapping );
+		if( std::memcmp( header->magic, vk2d::_internal::ASSET_PACK_MAGIC, sizeof( header->magic ) ) != 0 ) return false;
+		if( header->version != vk2d::_internal::ASSET_PACK_VERSION ) return false;
+
+		auto InFile = [ this ]( uint64_t offset, uint64_t size )
+		{
+			return offset <= mapping_size && size <= mapping_size - offset;
+		};
+		if( header->entries_offset % alignof( vk2d::_internal::AssetPackEntry ) ) return false;
+		if( !InFile( header->entries_offset, uint64_t( header->entry_count ) * sizeof( vk2d::_internal::AssetPackEntry ) ) ) return false;
+		if( !InFile( header->path_table_offset, header->path_table_size ) ) return false;
+
+		entries		= reinterpret_cast<const vk2d::_internal::AssetPackEntry*>( mapping + header->entries_offset );
+		path_table	= reinterpret_cast<const char*>( mapping + header->path_table_offset );
+
+		for( uint32_t i = 0; i < header->entry_count; ++i ) {
+			auto & e = entries[ i ];
+			if( e.path_offset > header->path_table_size ||
+				e.path_size > header->path_table_size - e.path_offset ) return false;
+			if( !InFile( e.data_offset, e.data_size ) ) return false;
+			if( e.payload == vk2d::_internal::AssetPackPayload::RAW_RGBA8 &&
+				uint64_t( e.width ) * uint64_t( e.height ) * 4 != e.data_size ) return false;
+			if( i && !( GetEntryPath( entries[ i - 1 ] ) < GetEntryPath( e ) ) ) return false;
+		}
+		return true;
+	}
+
+	const uint8_t									*	mapping					= {};
+	size_t												mapping_size			= {};
+	const vk2d::_internal::AssetPackHeader			*	header					= {};
+	const vk2d::_internal::AssetPackEntry			*	entries					= {};
+	const char										*	path_table				= {};
+	bool												is_good					= {};
+};
+
+
+
+} // _internal
+} // vk2d
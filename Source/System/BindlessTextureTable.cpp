@@ -0,0 +1,398 @@
+
+#include "Core/SourceCommon.h"
+
+#include "System/BindlessTextureTable.h"
+#include "System/DescriptorSet.h"
+
+#include "Interface/InstanceImpl.h"
+#include "Interface/TextureImpl.h"
+
+#include "Interface/Texture.h"
+
+
+
+namespace vk2d {
+namespace _internal {
+
+// Textures not drawn for this many frames are evicted when the table runs out of slots.
+constexpr uint64_t BINDLESS_TEXTURE_TABLE_EVICTION_AGE		= 8;
+
+// Overflow descriptor sets allocated from a single pool.
+constexpr uint32_t BINDLESS_TEXTURE_TABLE_OVERFLOW_BATCH_SIZE	= 64;
+
+} // _internal
+} // vk2d
+
+
+
+vk2d::_internal::BindlessTextureTable::BindlessTextureTable(
+	vk2d::_internal::InstanceImpl		*	instance,
+	uint32_t								capacity
+)
+{
+	assert( instance );
+	assert( capacity );
+
+	this->instance		= instance;
+	this->vk_device		= instance->GetVulkanDevice();
+	this->capacity		= capacity;
+
+	VkDescriptorPoolSize pool_size {};
+	pool_size.type								= VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	pool_size.descriptorCount					= capacity;
+
+	VkDescriptorPoolCreateInfo descriptor_pool_create_info {};
+	descriptor_pool_create_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptor_pool_create_info.pNext			= nullptr;
+	descriptor_pool_create_info.flags			= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+	descriptor_pool_create_info.maxSets			= 1;
+	descriptor_pool_create_info.poolSizeCount	= 1;
+	descriptor_pool_create_info.pPoolSizes		= &pool_size;
+
+	auto result = vkCreateDescriptorPool(
+		vk_device,
+		&descriptor_pool_create_info,
+		nullptr,
+		&vk_descriptor_pool
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot create descriptor pool for bindless texture table!" );
+		return;
+	}
+
+	auto vk_descriptor_set_layout = instance->GetGraphicsTextureDescriptorSetLayout().GetVulkanDescriptorSetLayout();
+
+	// Array binding has a variable descriptor count so that overflow
+	// descriptor sets don't need to reserve the whole array.
+	VkDescriptorSetVariableDescriptorCountAllocateInfo variable_count_allocate_info {};
+	variable_count_allocate_info.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+	variable_count_allocate_info.pNext					= nullptr;
+	variable_count_allocate_info.descriptorSetCount		= 1;
+	variable_count_allocate_info.pDescriptorCounts		= &capacity;
+
+	VkDescriptorSetAllocateInfo descriptor_set_allocate_info {};
+	descriptor_set_allocate_info.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptor_set_allocate_info.pNext				= &variable_count_allocate_info;
+	descriptor_set_allocate_info.descriptorPool		= vk_descriptor_pool;
+	descriptor_set_allocate_info.descriptorSetCount	= 1;
+	descriptor_set_allocate_info.pSetLayouts		= &vk_descriptor_set_layout;
+
+	result = vkAllocateDescriptorSets(
+		vk_device,
+		&descriptor_set_allocate_info,
+		&vk_descriptor_set
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot allocate descriptor set for bindless texture table!" );
+		return;
+	}
+
+	// Hand out low indices first.
+	free_indices.resize( capacity );
+	for( uint32_t i = 0; i < capacity; ++i ) {
+		free_indices[ i ] = capacity - 1 - i;
+	}
+
+	is_good				= true;
+}
+
+vk2d::_internal::BindlessTextureTable::~BindlessTextureTable()
+{
+	for( auto & f : overflow_frames ) {
+		for( auto p : f.pools ) {
+			vkDestroyDescriptorPool(
+				vk_device,
+				p,
+				nullptr
+			);
+		}
+	}
+
+	// Descriptor set is freed with the pool.
+	vkDestroyDescriptorPool(
+		vk_device,
+		vk_descriptor_pool,
+		nullptr
+	);
+}
+
+void vk2d::_internal::BindlessTextureTable::SetCurrentFrame(
+	uint32_t		frame_index
+)
+{
+	current_frame		= frame_index;
+	++tick;
+}
+
+void vk2d::_internal::BindlessTextureTable::ResetFrame(
+	uint32_t		frame_index
+)
+{
+	if( frame_index < uint32_t( retired_indices.size() ) ) {
+		auto & retired = retired_indices[ frame_index ];
+		free_indices.insert( free_indices.end(), retired.begin(), retired.end() );
+		retired.clear();
+	}
+
+	if( frame_index < uint32_t( overflow_frames.size() ) ) {
+		auto & overflow_frame = overflow_frames[ frame_index ];
+
+		// Only pools that were used need resetting.
+		size_t used_pool_count = std::min( overflow_frame.current_pool + 1, overflow_frame.pools.size() );
+		for( size_t i = 0; i < used_pool_count; ++i ) {
+			vkResetDescriptorPool(
+				vk_device,
+				overflow_frame.pools[ i ],
+				0
+			);
+		}
+		overflow_frame.current_pool				= 0;
+		overflow_frame.used_in_current_pool		= 0;
+		overflow_frame.descriptor_sets.clear();
+	}
+}
+
+bool vk2d::_internal::BindlessTextureTable::GetTextureIndex(
+	vk2d::Texture		*	texture,
+	uint32_t			&	out_index
+)
+{
+	assert( texture );
+
+	auto resource_id		= texture->texture_impl->GetResourceID();
+	auto & entry			= entries[ resource_id ];
+	entry.last_used_tick	= tick;
+
+	// Generation is read before the image view, if the texture image gets
+	// replaced in between we'll just write the descriptor again next time.
+	auto texture_generation = texture->texture_impl->GetGeneration();
+
+	if( entry.index != NO_INDEX ) {
+		if( entry.texture_generation == texture_generation ) {
+			out_index	= entry.index;
+			return true;
+		}
+
+		// Texture image was replaced, the old slot may still be in use
+		// by a frame in flight so we can't rewrite it, use a new slot.
+		RetireSlot( entry.index );
+		entry.index		= NO_INDEX;
+	}
+
+	uint32_t index = NO_INDEX;
+	if( !AcquireSlot( index ) ) {
+		entries.erase( resource_id );
+		if( !full_reported ) {
+			instance->Report( vk2d::ReportSeverity::WARNING, "Bindless texture table is full, binding a descriptor set per texture until slots free up. Increase VK2D_BUILD_OPTION_BINDLESS_TEXTURE_CAPACITY." );
+			full_reported	= true;
+		}
+		return false;
+	}
+	entry.index					= index;
+	entry.texture_generation	= texture_generation;
+
+	VkDescriptorImageInfo image_info {};
+	image_info.sampler						= VK_NULL_HANDLE;
+	image_info.imageView					= texture->texture_impl->GetVulkanImageView();
+	image_info.imageLayout					= texture->texture_impl->GetVulkanImageLayout();
+
+	VkWriteDescriptorSet descriptor_write {};
+	descriptor_write.sType					= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptor_write.pNext					= nullptr;
+	descriptor_write.dstSet					= vk_descriptor_set;
+	descriptor_write.dstBinding				= 0;
+	descriptor_write.dstArrayElement		= index;
+	descriptor_write.descriptorCount		= 1;
+	descriptor_write.descriptorType			= VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	descriptor_write.pImageInfo				= &image_info;
+	descriptor_write.pBufferInfo			= nullptr;
+	descriptor_write.pTexelBufferView		= nullptr;
+
+	vkUpdateDescriptorSets(
+		vk_device,
+		1, &descriptor_write,
+		0, nullptr
+	);
+
+	out_index	= index;
+	return true;
+}
+
+VkDescriptorSet vk2d::_internal::BindlessTextureTable::GetOverflowDescriptorSet(
+	vk2d::Texture		*	texture
+)
+{
+	assert( texture );
+
+	if( current_frame >= uint32_t( overflow_frames.size() ) ) {
+		overflow_frames.resize( size_t( current_frame ) + 1 );
+	}
+	auto & overflow_frame = overflow_frames[ current_frame ];
+
+	auto texture_generation	= texture->texture_impl->GetGeneration();
+	auto & overflow_entry	= overflow_frame.descriptor_sets[ texture->texture_impl->GetResourceID() ];
+
+	// Descriptor set of an older generation may still be used by earlier draws
+	// of this frame, it's released with the frame and a new one is allocated.
+	if( overflow_entry.descriptor_set != VK_NULL_HANDLE && overflow_entry.texture_generation == texture_generation ) {
+		return overflow_entry.descriptor_set;
+	}
+
+	if( overflow_frame.used_in_current_pool >= vk2d::_internal::BINDLESS_TEXTURE_TABLE_OVERFLOW_BATCH_SIZE ) {
+		++overflow_frame.current_pool;
+		overflow_frame.used_in_current_pool		= 0;
+	}
+	if( overflow_frame.current_pool >= overflow_frame.pools.size() ) {
+		VkDescriptorPoolSize pool_size {};
+		pool_size.type								= VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		pool_size.descriptorCount					= vk2d::_internal::BINDLESS_TEXTURE_TABLE_OVERFLOW_BATCH_SIZE;
+
+		VkDescriptorPoolCreateInfo descriptor_pool_create_info {};
+		descriptor_pool_create_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptor_pool_create_info.pNext			= nullptr;
+		descriptor_pool_create_info.flags			= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+		descriptor_pool_create_info.maxSets			= vk2d::_internal::BINDLESS_TEXTURE_TABLE_OVERFLOW_BATCH_SIZE;
+		descriptor_pool_create_info.poolSizeCount	= 1;
+		descriptor_pool_create_info.pPoolSizes		= &pool_size;
+
+		VkDescriptorPool pool = VK_NULL_HANDLE;
+		auto result = vkCreateDescriptorPool(
+			vk_device,
+			&descriptor_pool_create_info,
+			nullptr,
+			&pool
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot create overflow descriptor pool for bindless texture table!" );
+			return VK_NULL_HANDLE;
+		}
+		overflow_frame.pools.push_back( pool );
+		overflow_frame.current_pool				= overflow_frame.pools.size() - 1;
+		overflow_frame.used_in_current_pool		= 0;
+	}
+
+	uint32_t descriptor_count = 1;
+
+	VkDescriptorSetVariableDescriptorCountAllocateInfo variable_count_allocate_info {};
+	variable_count_allocate_info.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+	variable_count_allocate_info.pNext					= nullptr;
+	variable_count_allocate_info.descriptorSetCount		= 1;
+	variable_count_allocate_info.pDescriptorCounts		= &descriptor_count;
+
+	auto vk_descriptor_set_layout = instance->GetGraphicsTextureDescriptorSetLayout().GetVulkanDescriptorSetLayout();
+
+	VkDescriptorSetAllocateInfo descriptor_set_allocate_info {};
+	descriptor_set_allocate_info.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptor_set_allocate_info.pNext				= &variable_count_allocate_info;
+	descriptor_set_allocate_info.descriptorPool		= overflow_frame.pools[ overflow_frame.current_pool ];
+	descriptor_set_allocate_info.descriptorSetCount	= 1;
+	descriptor_set_allocate_info.pSetLayouts		= &vk_descriptor_set_layout;
+
+	VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+	auto result = vkAllocateDescriptorSets(
+		vk_device,
+		&descriptor_set_allocate_info,
+		&descriptor_set
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot allocate overflow descriptor set for bindless texture table!" );
+		return VK_NULL_HANDLE;
+	}
+	++overflow_frame.used_in_current_pool;
+
+	VkDescriptorImageInfo image_info {};
+	image_info.sampler						= VK_NULL_HANDLE;
+	image_info.imageView					= texture->texture_impl->GetVulkanImageView();
+	image_info.imageLayout					= texture->texture_impl->GetVulkanImageLayout();
+
+	VkWriteDescriptorSet descriptor_write {};
+	descriptor_write.sType					= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptor_write.pNext					= nullptr;
+	descriptor_write.dstSet					= descriptor_set;
+	descriptor_write.dstBinding				= 0;
+	descriptor_write.dstArrayElement		= 0;
+	descriptor_write.descriptorCount		= 1;
+	descriptor_write.descriptorType			= VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	descriptor_write.pImageInfo				= &image_info;
+	descriptor_write.pBufferInfo			= nullptr;
+	descriptor_write.pTexelBufferView		= nullptr;
+
+	vkUpdateDescriptorSets(
+		vk_device,
+		1, &descriptor_write,
+		0, nullptr
+	);
+
+	overflow_entry.texture_generation	= texture_generation;
+	overflow_entry.descriptor_set		= descriptor_set;
+	return descriptor_set;
+}
+
+void vk2d::_internal::BindlessTextureTable::CmdBind(
+	VkCommandBuffer		command_buffer,
+	VkPipelineLayout	pipeline_layout,
+	uint32_t			set_index
+)
+{
+	vkCmdBindDescriptorSets(
+		command_buffer,
+		VK_PIPELINE_BIND_POINT_GRAPHICS,
+		pipeline_layout,
+		set_index,
+		1, &vk_descriptor_set,
+		0, nullptr
+	);
+}
+
+uint32_t vk2d::_internal::BindlessTextureTable::GetCapacity() const
+{
+	return capacity;
+}
+
+uint32_t vk2d::_internal::BindlessTextureTable::GetUsedCount() const
+{
+	return uint32_t( entries.size() );
+}
+
+bool vk2d::_internal::BindlessTextureTable::IsGood() const
+{
+	return is_good;
+}
+
+bool vk2d::_internal::BindlessTextureTable::AcquireSlot(
+	uint32_t		&	out_index
+)
+{
+	if( free_indices.empty() ) {
+		// Evicted slots only become available once the current frame is done,
+		// this draw has to do without but following frames will have room.
+		EvictUnusedEntries();
+		return false;
+	}
+
+	out_index		= free_indices.back();
+	free_indices.pop_back();
+	return true;
+}
+
+void vk2d::_internal::BindlessTextureTable::RetireSlot(
+	uint32_t		index
+)
+{
+	if( current_frame >= uint32_t( retired_indices.size() ) ) {
+		retired_indices.resize( size_t( current_frame ) + 1 );
+	}
+	retired_indices[ current_frame ].push_back( index );
+}
+
+void vk2d::_internal::BindlessTextureTable::EvictUnusedEntries()
+{
+	for( auto e = entries.begin(); e != entries.end(); ) {
+		if( e->second.index != NO_INDEX && e->second.last_used_tick + vk2d::_internal::BINDLESS_TEXTURE_TABLE_EVICTION_AGE < tick ) {
+			RetireSlot( e->second.index );
+			e = entries.erase( e );
+		} else {
+			++e;
+		}
+	}
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Core/SourceCommon.h"
+
+
+
+namespace vk2d {
+
+class Texture;
+
+namespace _internal {
+
+class InstanceImpl;
+
+
+
+// Keeps textures used by a single render target in one large descriptor
+// array so that changing textures between draws only changes an index in
+// push constants instead of binding another descriptor set.
+// Descriptors are written with update after bind, a slot is never rewritten
+// while a frame in flight may still use it. Slots of replaced or evicted
+// textures are retired with the frame and reused once that frame is done.
+// When the table is full, textures that don't fit are drawn with a
+// descriptor set of their own until slots free up, see GetOverflowDescriptorSet().
+// Not thread safe, table belongs to a single render target.
+class BindlessTextureTable {
+public:
+																BindlessTextureTable(
+		vk2d::_internal::InstanceImpl						*	instance,
+		uint32_t												capacity );
+
+																~BindlessTextureTable();
+
+	// Selects which frame following slot retirements belong to. Frame index
+	// is usually the swapchain image index or the swap buffer index.
+	void														SetCurrentFrame(
+		uint32_t												frame_index );
+
+	// Returns slots retired during a frame back to use and releases overflow
+	// descriptor sets of the frame. Only call this once the GPU has finished
+	// using the frame, eg. after the frame fence signaled.
+	void														ResetFrame(
+		uint32_t												frame_index );
+
+	// Gets the array index of a texture, writes the texture into the array if
+	// it's not there yet or if the texture image was replaced since.
+	// Returns false if the table is full, the texture must then be drawn
+	// with the descriptor set from GetOverflowDescriptorSet() instead.
+	bool														GetTextureIndex(
+		vk2d::Texture										*	texture,
+		uint32_t											&	out_index );
+
+	// Gets a descriptor set of the table layout holding only this texture at
+	// array index 0. Descriptor set lives until the current frame is reset.
+	// Returns VK_NULL_HANDLE if descriptor set could not be allocated.
+	VkDescriptorSet												GetOverflowDescriptorSet(
+		vk2d::Texture										*	texture );
+
+	void														CmdBind(
+		VkCommandBuffer											command_buffer,
+		VkPipelineLayout										pipeline_layout,
+		uint32_t												set_index );
+
+	uint32_t													GetCapacity() const;
+
+	// Amount of slots currently holding a texture.
+	uint32_t													GetUsedCount() const;
+
+	bool														IsGood() const;
+
+private:
+	static constexpr uint32_t									NO_INDEX					= UINT32_MAX;
+
+	// Entries are keyed by resource ID, see vk2d::_internal::GenerateResourceID(),
+	// a texture destroyed and another created at the same address never match.
+	struct Entry {
+		uint32_t												index						= NO_INDEX;
+		uint64_t												texture_generation			= {};
+		uint64_t												last_used_tick				= {};
+	};
+
+	struct OverflowEntry {
+		uint64_t												texture_generation			= {};
+		VkDescriptorSet											descriptor_set				= {};
+	};
+
+	// Overflow descriptor sets of a single frame, pools are reset with the frame.
+	// Every pool holds the same amount of sets so we know when one is full without asking Vulkan.
+	struct OverflowFrame {
+		std::vector<VkDescriptorPool>							pools						= {};
+		size_t													current_pool				= {};
+		uint32_t												used_in_current_pool		= {};
+		std::unordered_map<uint64_t, OverflowEntry>				descriptor_sets				= {};	// By resource ID.
+	};
+
+	bool														AcquireSlot(
+		uint32_t											&	out_index );
+
+	void														RetireSlot(
+		uint32_t												index );
+
+	// Retires slots of textures that haven't been used for a while, these
+	// are most likely destroyed textures or textures no longer drawn.
+	void														EvictUnusedEntries();
+
+	vk2d::_internal::InstanceImpl							*	instance					= {};
+	VkDevice													vk_device					= {};
+	VkDescriptorPool											vk_descriptor_pool			= {};
+	VkDescriptorSet												vk_descriptor_set			= {};
+	uint32_t													capacity					= {};
+
+	std::unordered_map<uint64_t, Entry>							entries						= {};
+	std::vector<uint32_t>										free_indices				= {};
+	std::vector<std::vector<uint32_t>>							retired_indices				= {};	// Per frame.
+	std::vector<OverflowFrame>									overflow_frames				= {};
+	uint32_t													current_frame				= {};
+	uint64_t													tick						= {};
+	bool														full_reported				= {};
+
+	bool														is_good						= {};
+};
+
+
+
+} // _internal
+
+} // vk2d
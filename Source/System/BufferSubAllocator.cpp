@@ -0,0 +1,298 @@
+
+#include "Core/SourceCommon.h"
+
+#include "System/VulkanMemoryManagement.h"
+#include "System/BufferSubAllocator.h"
+
+
+
+vk2d::_internal::BufferSubAllocator::BufferSubAllocator(
+	vk2d::_internal::DeviceMemoryPool		*	device_memory_pool,
+	VkBufferUsageFlags							buffer_usage,
+	VkMemoryPropertyFlags						memory_properties,
+	VkDeviceSize								page_size
+)
+{
+	assert( device_memory_pool );
+	assert( buffer_usage );
+	assert( page_size );
+
+	this->device_memory_pool		= device_memory_pool;
+	this->buffer_usage				= buffer_usage;
+	this->memory_properties			= memory_properties;
+	this->page_size					= page_size;
+
+	// Every range can be used as uniform or storage buffer range, index
+	// buffer offset or buffer to image copy source without further alignment.
+	auto & limits					= device_memory_pool->GetPhysicalDeviceProperties().limits;
+	this->minimum_alignment			= std::max( limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment );
+	this->minimum_alignment			= std::max( this->minimum_alignment, VkDeviceSize( 16 ) );
+
+	is_good							= true;
+}
+
+vk2d::_internal::BufferSubAllocator::~BufferSubAllocator()
+{
+	for( auto & p : pages ) {
+		device_memory_pool->FreeCompleteResource( p->buffer );
+	}
+	pages.clear();
+}
+
+vk2d::_internal::BufferSubAllocation vk2d::_internal::BufferSubAllocator::Allocate(
+	VkDeviceSize		byte_size,
+	VkDeviceSize		alignment
+)
+{
+	assert( byte_size );
+	assert( ( alignment & ( alignment - 1 ) ) == 0 );
+
+	alignment		= std::max( alignment, minimum_alignment );
+
+	ProcessDeferredFrees();
+
+	for( auto & p : pages ) {
+		if( p->is_dedicated ) continue;
+		if( p->capacity - p->used_size < byte_size ) continue;
+
+		auto allocation = AllocateFromPage( p.get(), byte_size, alignment );
+		if( allocation == VK_SUCCESS ) return allocation;
+	}
+
+	auto page = AllocatePage( std::max( byte_size, page_size ), byte_size > page_size );
+	if( !page ) {
+		vk2d::_internal::BufferSubAllocation failed {};
+		failed.result		= VK_ERROR_OUT_OF_DEVICE_MEMORY;
+		return failed;
+	}
+	return AllocateFromPage( page, byte_size, alignment );
+}
+
+void vk2d::_internal::BufferSubAllocator::Free(
+	vk2d::_internal::BufferSubAllocation		&	allocation
+)
+{
+	auto page = allocation.page;
+	if( !page ) return;
+
+	auto & free_ranges		= page->free_ranges;
+	VkDeviceSize offset		= allocation.offset;
+	VkDeviceSize size		= allocation.size;
+
+	// Merge with the free range after this one.
+	auto next = free_ranges.find( offset + size );
+	if( next != free_ranges.end() ) {
+		size				+= next->second;
+		free_ranges.erase( next );
+	}
+
+	// Merge with the free range before this one.
+	auto inserted = free_ranges.emplace( offset, size ).first;
+	if( inserted != free_ranges.begin() ) {
+		auto previous = std::prev( inserted );
+		if( previous->first + previous->second == offset ) {
+			previous->second	+= size;
+			free_ranges.erase( inserted );
+		}
+	}
+
+	page->used_size			-= allocation.size;
+	allocation				= {};
+
+	if( page->used_size != 0 ) return;
+
+	// Dedicated pages are never reused. Keep one regular page around so that
+	// allocating and freeing a single buffer repeatedly doesn't create a new
+	// page every time.
+	if( page->is_dedicated ) {
+		FreePage( page );
+		return;
+	}
+	auto regular_page_count = std::count_if( pages.begin(), pages.end(), []( auto & p )
+		{
+			return !p->is_dedicated;
+		} );
+	if( regular_page_count > 1 ) {
+		FreePage( page );
+	}
+}
+
+void vk2d::_internal::BufferSubAllocator::DeferredFree(
+	vk2d::_internal::BufferSubAllocation		&	allocation
+)
+{
+	if( allocation.page ) {
+		deferred_frees.Push( allocation );
+	}
+	allocation				= {};
+}
+
+void vk2d::_internal::BufferSubAllocator::ProcessDeferredFrees()
+{
+	deferred_frees.Drain( [ this ]( vk2d::_internal::BufferSubAllocation & allocation )
+		{
+			Free( allocation );
+		} );
+}
+
+VkBufferUsageFlags vk2d::_internal::BufferSubAllocator::GetBufferUsage() const
+{
+	return buffer_usage;
+}
+
+VkDeviceSize vk2d::_internal::BufferSubAllocator::GetTotalSize() const
+{
+	VkDeviceSize total = 0;
+	for( auto & p : pages ) {
+		total		+= p->capacity;
+	}
+	return total;
+}
+
+VkDeviceSize vk2d::_internal::BufferSubAllocator::GetUsedSize() const
+{
+	VkDeviceSize used = 0;
+	for( auto & p : pages ) {
+		used		+= p->used_size;
+	}
+	return used;
+}
+
+uint32_t vk2d::_internal::BufferSubAllocator::GetPageCount() const
+{
+	return uint32_t( pages.size() );
+}
+
+bool vk2d::_internal::BufferSubAllocator::IsGood() const
+{
+	return is_good;
+}
+
+vk2d::_internal::BufferSubAllocatorPage * vk2d::_internal::BufferSubAllocator::AllocatePage(
+	VkDeviceSize		capacity,
+	bool				is_dedicated
+)
+{
+	VkBufferCreateInfo buffer_create_info {};
+	buffer_create_info.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	buffer_create_info.pNext					= nullptr;
+	buffer_create_info.flags					= 0;
+	buffer_create_info.size						= capacity;
+	buffer_create_info.usage					= buffer_usage;
+	buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
+	buffer_create_info.queueFamilyIndexCount	= 0;
+	buffer_create_info.pQueueFamilyIndices		= nullptr;
+
+	auto page = std::make_unique<vk2d::_internal::BufferSubAllocatorPage>();
+	page->buffer = device_memory_pool->CreateCompleteBufferResource(
+		&buffer_create_info,
+		memory_properties
+	);
+	if( page->buffer != VK_SUCCESS ) {
+		return nullptr;
+	}
+	page->capacity		= capacity;
+	page->used_size		= 0;
+	page->is_dedicated	= is_dedicated;
+	page->free_ranges.emplace( VkDeviceSize( 0 ), capacity );
+
+	pages.push_back( std::move( page ) );
+	return pages.back().get();
+}
+
+void vk2d::_internal::BufferSubAllocator::FreePage(
+	vk2d::_internal::BufferSubAllocatorPage		*	page
+)
+{
+	for( auto p = pages.begin(); p != pages.end(); ++p ) {
+		if( p->get() == page ) {
+			device_memory_pool->FreeCompleteResource( page->buffer );
+			pages.erase( p );
+			return;
+		}
+	}
+}
+
+vk2d::_internal::BufferSubAllocation vk2d::_internal::BufferSubAllocator::AllocateFromPage(
+	vk2d::_internal::BufferSubAllocatorPage		*	page,
+	VkDeviceSize									byte_size,
+	VkDeviceSize									alignment
+)
+{
+	auto & free_ranges = page->free_ranges;
+
+	// First fit.
+	for( auto r = free_ranges.begin(); r != free_ranges.end(); ++r ) {
+		VkDeviceSize range_begin		= r->first;
+		VkDeviceSize range_end			= r->first + r->second;
+		VkDeviceSize aligned_begin		= ( range_begin + alignment - 1 ) & ~( alignment - 1 );
+		if( aligned_begin + byte_size > range_end ) continue;
+
+		// Split the range, alignment padding in front and leftover at the back stay free.
+		free_ranges.erase( r );
+		if( aligned_begin > range_begin ) {
+			free_ranges.emplace( range_begin, aligned_begin - range_begin );
+		}
+		if( aligned_begin + byte_size < range_end ) {
+			free_ranges.emplace( aligned_begin + byte_size, range_end - ( aligned_begin + byte_size ) );
+		}
+		page->used_size					+= byte_size;
+
+		vk2d::_internal::BufferSubAllocation allocation {};
+		allocation.result				= VK_SUCCESS;
+		allocation.buffer				= page->buffer.buffer;
+		allocation.offset				= aligned_begin;
+		allocation.size					= byte_size;
+		allocation.page					= page;
+		if( auto mapped = page->buffer.memory.Map<uint8_t>() ) {
+			allocation.mapped_data		= mapped + aligned_begin;
+		}
+		return allocation;
+	}
+	return {};
+}
+
+
+
+std::unique_ptr<vk2d::_internal::BufferSubAllocator> vk2d::_internal::CreateBufferSubAllocator(
+	vk2d::_internal::DeviceMemoryPool		*	device_memory_pool,
+	vk2d::_internal::BufferUsageClass			usage_class
+)
+{
+	VkBufferUsageFlags		buffer_usage		= {};
+	VkMemoryPropertyFlags	memory_properties	= {};
+	VkDeviceSize			page_size			= {};
+
+	switch( usage_class ) {
+	case vk2d::_internal::BufferUsageClass::STAGING:
+		buffer_usage		= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		memory_properties	= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		page_size			= VK2D_BUILD_OPTION_BUFFER_SUB_ALLOCATOR_STAGING_PAGE_SIZE;
+		break;
+	case vk2d::_internal::BufferUsageClass::DEVICE_MESH:
+		buffer_usage		= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		memory_properties	= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		page_size			= VK2D_BUILD_OPTION_BUFFER_SUB_ALLOCATOR_MESH_PAGE_SIZE;
+		break;
+	case vk2d::_internal::BufferUsageClass::DEVICE_UNIFORM:
+		buffer_usage		= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		memory_properties	= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		page_size			= VK2D_BUILD_OPTION_BUFFER_SUB_ALLOCATOR_UNIFORM_PAGE_SIZE;
+		break;
+	default:
+		assert( 0 && "Unknown buffer usage class" );
+		return {};
+	}
+
+	auto buffer_sub_allocator = std::unique_ptr<vk2d::_internal::BufferSubAllocator>(
+		new vk2d::_internal::BufferSubAllocator(
+			device_memory_pool,
+			buffer_usage,
+			memory_properties,
+			page_size
+		) );
+	if( buffer_sub_allocator->is_good ) {
+		return buffer_sub_allocator;
+	}
+	return {};
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Core/SourceCommon.h"
+
+#include "System/VulkanMemoryManagement.h"
+
+
+
+namespace vk2d {
+
+namespace _internal {
+
+class DeviceMemoryPool;
+class BufferSubAllocator;
+struct BufferSubAllocatorPage;
+
+
+
+// Usage classes, each usage class has its own set of shared buffers.
+enum class BufferUsageClass : uint32_t {
+	STAGING,			// Host visible, transfer source and destination.
+	DEVICE_MESH,		// Device local, index, vertex, storage and uniform buffers.
+	DEVICE_UNIFORM,		// Device local, uniform buffers.
+	COUNT,
+};
+
+
+
+// Range inside a shared VkBuffer. Use offset whenever referencing this in
+// descriptor writes, copy regions or buffer binds, buffer is shared with
+// other allocations.
+class BufferSubAllocation {
+	friend class vk2d::_internal::BufferSubAllocator;
+
+public:
+	VkResult										result								= VK_RESULT_MAX_ENUM;
+	VkBuffer										buffer								= {};
+	VkDeviceSize									offset								= {};
+	VkDeviceSize									size								= {};
+	void										*	mapped_data							= {};	// Only if host visible.
+
+	template<typename T>
+	inline T									*	Get()
+	{
+		return reinterpret_cast<T*>( mapped_data );
+	}
+
+	inline											operator VkResult()
+	{
+		return result;
+	}
+
+private:
+	vk2d::_internal::BufferSubAllocatorPage		*	page								= {};
+};
+
+
+
+// Page is a single VkBuffer with its own memory, allocations are ranges inside it.
+struct BufferSubAllocatorPage {
+	vk2d::_internal::CompleteBufferResource							buffer								= {};
+	VkDeviceSize													capacity							= {};
+	VkDeviceSize													used_size							= {};
+	std::map<VkDeviceSize, VkDeviceSize>							free_ranges							= {};	// offset, size.
+	bool															is_dedicated						= {};	// Holds a single allocation larger than the page size.
+};
+
+
+
+// Hands out ranges from a few large buffers instead of creating a new
+// VkBuffer for every small buffer, this keeps Vulkan object count and
+// amount of buffer binds down. Allocations larger than the page size
+// get a dedicated page which is released as soon as the allocation is
+// freed. Not thread safe except for DeferredFree(), same
+// rules apply as with the DeviceMemoryPool this allocates from.
+class BufferSubAllocator {
+	friend std::unique_ptr<vk2d::_internal::BufferSubAllocator>		CreateBufferSubAllocator(
+		vk2d::_internal::DeviceMemoryPool						*	device_memory_pool,
+		vk2d::_internal::BufferUsageClass							usage_class );
+
+private:
+	// Only accessible through CreateBufferSubAllocator
+																	BufferSubAllocator(
+		vk2d::_internal::DeviceMemoryPool						*	device_memory_pool,
+		VkBufferUsageFlags											buffer_usage,
+		VkMemoryPropertyFlags										memory_properties,
+		VkDeviceSize												page_size );
+
+public:
+																	~BufferSubAllocator();
+
+	// Alignment must be a power of two, allocations are always aligned
+	// so they can be used as uniform or storage buffer ranges directly.
+	vk2d::_internal::BufferSubAllocation							Allocate(
+		VkDeviceSize												byte_size,
+		VkDeviceSize												alignment							= 1 );
+
+	void															Free(
+		vk2d::_internal::BufferSubAllocation					&	allocation );
+
+	// Same as Free() but can be called from any thread, range is returned
+	// the next time the owning thread allocates or calls ProcessDeferredFrees().
+	void															DeferredFree(
+		vk2d::_internal::BufferSubAllocation					&	allocation );
+
+	// Returns ranges freed by other threads. Only call from the owning thread.
+	void															ProcessDeferredFrees();
+
+	VkBufferUsageFlags												GetBufferUsage() const;
+
+	// Total bytes of all pages.
+	VkDeviceSize													GetTotalSize() const;
+
+	// Total bytes in use by allocations.
+	VkDeviceSize													GetUsedSize() const;
+
+	uint32_t														GetPageCount() const;
+
+	bool															IsGood() const;
+
+private:
+	vk2d::_internal::BufferSubAllocatorPage						*	AllocatePage(
+		VkDeviceSize												capacity,
+		bool														is_dedicated );
+
+	void															FreePage(
+		vk2d::_internal::BufferSubAllocatorPage					*	page );
+
+	vk2d::_internal::BufferSubAllocation							AllocateFromPage(
+		vk2d::_internal::BufferSubAllocatorPage					*	page,
+		VkDeviceSize												byte_size,
+		VkDeviceSize												alignment );
+
+	vk2d::_internal::DeviceMemoryPool							*	device_memory_pool					= {};
+	VkBufferUsageFlags												buffer_usage						= {};
+	VkMemoryPropertyFlags											memory_properties					= {};
+	VkDeviceSize													page_size							= {};
+	VkDeviceSize													minimum_alignment					= {};
+
+	std::vector<std::unique_ptr<vk2d::_internal::BufferSubAllocatorPage>>
+																	pages								= {};
+
+	vk2d::_internal::DeferredFreeQueue<vk2d::_internal::BufferSubAllocation>
+																	deferred_frees;
+
+	bool															is_good								= {};
+};
+
+
+
+std::unique_ptr<vk2d::_internal::BufferSubAllocator>				CreateBufferSubAllocator(
+	vk2d::_internal::DeviceMemoryPool							*	device_memory_pool,
+	vk2d::_internal::BufferUsageClass								usage_class );
+
+
+
+} // _internal
+
+} // vk2d
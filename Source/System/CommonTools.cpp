@@ -25,3 +25,24 @@ std::vector<VkExtent2D> vk2d::_internal::GenerateMipSizes(
 
 	return mipmap_levels;
 }
+
+uint64_t vk2d::_internal::GenerateResourceID()
+{
+	static std::atomic<uint64_t> next_resource_id = 1;
+	return next_resource_id.fetch_add( 1, std::memory_order_relaxed );
+}
+
+uint64_t vk2d::_internal::HashBytes(
+	const void		*	data,
+	size_t				byte_size,
+	uint64_t			seed
+)
+{
+	auto bytes		= reinterpret_cast<const uint8_t*>( data );
+	uint64_t hash	= seed;
+	for( size_t i = 0; i < byte_size; ++i ) {
+		hash		^= bytes[ i ];
+		hash		*= 0x100000001B3ull;
+	}
+	return hash;
+}
@@ -13,6 +13,17 @@ namespace _internal {
 std::vector<VkExtent2D>				GenerateMipSizes(
 	vk2d::Vector2u					full_size );
 
+// Returns a new process wide unique ID, never 0. Unlike object addresses
+// these are never reused so they are safe to use as cache keys.
+uint64_t							GenerateResourceID();
+
+// 64 bit FNV-1a hash, chain calls by passing the previous result as seed.
+// Fine for content addressing, not for anything security related.
+uint64_t							HashBytes(
+	const void					*	data,
+	size_t							byte_size,
+	uint64_t						seed						= 0xCBF29CE484222325ull );
+
 
 
 } // _internal
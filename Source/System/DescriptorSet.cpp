@@ -8,46 +8,12 @@
 namespace vk2d {
 namespace _internal {
 
-constexpr float			DESCRIPTOR_AUTO_POOL_CATEGORY_MINIMUM_COMPATIBILITY		= 0.75;
 constexpr uint32_t		DESCRIPTOR_AUTO_POOL_ALLOCATION_BATCH_SIZE				= 256;
 
 } // _internal
 } // vk2d
 
 
-double vk2d::_internal::DescriptorPoolRequirements::CheckCompatibilityWith(
-	const vk2d::_internal::DescriptorPoolRequirements		&	other ) const
-{
-	double compatibility	= 0.0;
-
-	if( ( typeBits & other.typeBits ) == typeBits ) {
-		// we know that at this point the two will be at least somewhat compatible.
-		uint32_t bindingAmountsCounted	= 0;
-
-		for( size_t i=0; i < bindingAmounts.size(); ++i ) {
-			if( bindingAmounts[ i ] ) {
-				double a = double( std::min( bindingAmounts[ i ], other.bindingAmounts[ i ] ) );
-				double b = double( std::max( bindingAmounts[ i ], other.bindingAmounts[ i ] ) );
-				assert( a );	// Neither a or b should ever be 0.
-				assert( b );	// typeBits was set up wrong.
-				compatibility += a / b;
-				bindingAmountsCounted++;
-			}
-		}
-
-		auto ac = std::bitset<sizeof( typeBits ) * 8>( typeBits ).count();
-		auto bc = std::bitset<sizeof( other.typeBits ) * 8>( other.typeBits ).count();
-		if( ac > bc ) std::swap( ac, bc );
-
-		compatibility /= double( bindingAmountsCounted );
-		compatibility *= double( ac ) / double( bc );
-	}
-
-	assert( compatibility <= 1.0 );
-	assert( compatibility >= 0.0 );
-	return compatibility;
-}
-
 vk2d::_internal::DescriptorSetLayout::DescriptorSetLayout(
 	vk2d::_internal::InstanceImpl			*	instance,
 	VkDevice									device,
@@ -78,8 +44,7 @@ vk2d::_internal::DescriptorSetLayout::DescriptorSetLayout(
 		for( size_t i=0; i < createInfo.bindingCount; ++i ) {
 			auto descriptorType		= createInfo.pBindings[ i ].descriptorType;
 
-			descriptorPoolRequirements.typeBits		|= uint64_t( 1 ) << uint64_t( descriptorType );
-			++descriptorPoolRequirements.bindingAmounts[ descriptorType ];
+			descriptorPoolRequirements.bindingAmounts[ descriptorType ]	+= std::max( createInfo.pBindings[ i ].descriptorCount, 1U );
 		}
 	}
 
@@ -147,21 +112,25 @@ vk2d::_internal::DescriptorAutoPool::DescriptorAutoPool(
 {
 	assert( instance );
 	assert( device );
-	instance			= instance;
-	refDevice				= device;
+	this->instance			= instance;
+	this->refDevice			= device;
+	this->ownerThread		= std::this_thread::get_id();
 
 	is_good		= true;
 }
 
 vk2d::_internal::DescriptorAutoPool::~DescriptorAutoPool()
 {
-	for( auto & c : poolCategories ) {
-		vkDestroyDescriptorPool(
-			refDevice,
-			c.pool,
-			nullptr );
+	// Destroying the pools frees every descriptor set allocated from them.
+	for( auto & c : layoutCategories ) {
+		for( auto p : c.second.pools ) {
+			vkDestroyDescriptorPool(
+				refDevice,
+				p,
+				nullptr );
+		}
 	}
-	poolCategories.clear();
+	layoutCategories.clear();
 }
 
 
@@ -169,144 +138,61 @@ vk2d::_internal::PoolDescriptorSet vk2d::_internal::DescriptorAutoPool::Allocate
 	const DescriptorSetLayout		&	rForDescriptorSetLayout )
 {
 	VK2D_ASSERT_SINGLE_THREAD_ACCESS_SCOPE();
+	assert( IsOwnerThread() );
 
-	// FIXME: multiple thread access conflict.
-	// This function will be called from multiple threads, possibly often.
-	// Need a mutex or per thread descriptor auto pool.
-	// Alternatively force access to single thread only
-	// and require descriptor set allocation via instance.
+	ProcessDeferredFrees();
 
-	const auto & setPoolRequirements	= rForDescriptorSetLayout.GetDescriptorPoolRequirements();
 	PoolDescriptorSet ret				= {};
-
-	// Organize pool categories from best suitable to worst suitable,
-	// and try each one until we find one that will work, if none
-	// work, create a new internal Vulkan descriptor pool using the
-	// DescriptorPoolRequirements from the descriptor set.
-	std::vector<std::pair<double, PoolCategory*>> sortedCategories;
-	{
-		for( auto & c : poolCategories ) {
-			if( !c.isFull ) {
-				auto setCompatibilityWithCurrentCategory	= setPoolRequirements.CheckCompatibilityWith( c.originalPoolRequirements );
-				if( setCompatibilityWithCurrentCategory > 0.0 &&
-					setCompatibilityWithCurrentCategory >= DESCRIPTOR_AUTO_POOL_CATEGORY_MINIMUM_COMPATIBILITY ) {
-					// We only consider categories with at least a certain compatibility.
-					sortedCategories.push_back( { setCompatibilityWithCurrentCategory, &c } );
-				}
-			}
-		}
-		std::sort( sortedCategories.begin(), sortedCategories.end(),
-			[]( const std::pair<double, PoolCategory*> & a, const std::pair<double, PoolCategory*> & b )
-			{
-				return a.first > b.first;
-			} );
-	}
-
-	// Try allocating from each pool in the sorted categories, until we
-	// find one that works or until we run out of sorted categories.
-	{
-		VkDescriptorSetLayout	setLayout				= rForDescriptorSetLayout;
-		VkDescriptorSet			set						= VK_NULL_HANDLE;
-
-		for( auto & sc : sortedCategories ) {
-			VkDescriptorSetAllocateInfo descriptorSetAllocateInfo {};
-			descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			descriptorSetAllocateInfo.pNext					= nullptr;
-			descriptorSetAllocateInfo.descriptorPool		= sc.second->pool;
-			descriptorSetAllocateInfo.descriptorSetCount	= 1;
-			descriptorSetAllocateInfo.pSetLayouts			= &setLayout;
-			auto result										= vkAllocateDescriptorSets( refDevice, &descriptorSetAllocateInfo, &set );
-			switch( result ) {
-			case VK_SUCCESS:
-				++sc.second->counter;
-				ret.descriptorSet	= set;
-				ret.parentPool		= sc.second->pool;
-				ret.result			= result;
-				ret.allocated		= true;
-				return ret;
-			case VK_ERROR_FRAGMENTED_POOL:
-			case VK_ERROR_OUT_OF_POOL_MEMORY:		// 1.1 ( After VK_KHR_maintenance1 )
-//			case VK_ERROR_OUT_OF_DEVICE_MEMORY:		// 1.0 ( Before VK_KHR_maintenance1 )
-				// Mark as full, try next pool
-				sc.second->isFull	= true;
-				break;
-			default:
-				instance->Report( result, "Internal error: Cannot allocate Vulkan descriptor sets!" );
-				ret.result			= result;
-				return ret;
-			}
-		}
-	}
-
-	// Didn't find anything yet, so we'll create
-	// a new internal Vulkan descriptor pool.
-	{
-		PoolCategory newCategory {};
-
-		std::vector<VkDescriptorPoolSize> poolSizes {};
-		auto & amounts = setPoolRequirements.GetBindingAmounts();
-		for( size_t i = 0; i < amounts.size(); ++i ) {
-			auto amount = amounts[ i ];
-			if( amount ) {
-				VkDescriptorPoolSize poolSize {};
-				poolSize.type				= VkDescriptorType( i );
-				poolSize.descriptorCount	= amount * DESCRIPTOR_AUTO_POOL_ALLOCATION_BATCH_SIZE;
-				poolSizes.push_back( poolSize );
-			}
+	VkDescriptorSetLayout setLayout		= rForDescriptorSetLayout;
+	auto & category						= layoutCategories[ setLayout ];
+
+	// Free list is empty, allocate a whole batch of sets at once from a new pool.
+	if( category.freeSets.empty() ) {
+		auto pool = CreateDescriptorPoolForLayout(
+			rForDescriptorSetLayout,
+			DESCRIPTOR_AUTO_POOL_ALLOCATION_BATCH_SIZE
+		);
+		if( !pool ) {
+			ret.result		= VK_ERROR_OUT_OF_POOL_MEMORY;
+			return ret;
 		}
 
-		newCategory.originalPoolRequirements			= setPoolRequirements;
+		std::vector<VkDescriptorSetLayout> setLayouts( DESCRIPTOR_AUTO_POOL_ALLOCATION_BATCH_SIZE, setLayout );
+		std::vector<VkDescriptorSet> sets( DESCRIPTOR_AUTO_POOL_ALLOCATION_BATCH_SIZE );
 
-		{
-			VkDescriptorPoolCreateInfo descriptorPoolCreateInfo {};
-			descriptorPoolCreateInfo.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-			descriptorPoolCreateInfo.pNext				= nullptr;
-			descriptorPoolCreateInfo.flags				= VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-			descriptorPoolCreateInfo.maxSets			= DESCRIPTOR_AUTO_POOL_ALLOCATION_BATCH_SIZE;
-			descriptorPoolCreateInfo.poolSizeCount		= uint32_t( poolSizes.size() );
-			descriptorPoolCreateInfo.pPoolSizes			= poolSizes.data();
-			auto result = vkCreateDescriptorPool(
-				refDevice,
-				&descriptorPoolCreateInfo,
-				nullptr,
-				&newCategory.pool
-			);
-			if( result != VK_SUCCESS ) {
-				instance->Report( result, "Internal error: Cannot create Vulkan descriptor pool!" );
-				ret.result	= result;
-				return ret;
-			}
-		}
-		{
-			VkDescriptorSetLayout	setLayout				= rForDescriptorSetLayout;
-			VkDescriptorSet			set						= VK_NULL_HANDLE;
-			VkDescriptorSetAllocateInfo descriptorSetAllocateInfo {};
-			descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			descriptorSetAllocateInfo.pNext					= nullptr;
-			descriptorSetAllocateInfo.descriptorPool		= newCategory.pool;
-			descriptorSetAllocateInfo.descriptorSetCount	= 1;
-			descriptorSetAllocateInfo.pSetLayouts			= &setLayout;
-			auto result = vkAllocateDescriptorSets(
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo {};
+		descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext					= nullptr;
+		descriptorSetAllocateInfo.descriptorPool		= pool;
+		descriptorSetAllocateInfo.descriptorSetCount	= uint32_t( setLayouts.size() );
+		descriptorSetAllocateInfo.pSetLayouts			= setLayouts.data();
+		auto result = vkAllocateDescriptorSets(
+			refDevice,
+			&descriptorSetAllocateInfo,
+			sets.data()
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot allocate Vulkan descriptor sets!" );
+			vkDestroyDescriptorPool(
 				refDevice,
-				&descriptorSetAllocateInfo,
-				&set
+				pool,
+				nullptr
 			);
-			if( result != VK_SUCCESS ) {
-				instance->Report( result, "Internal error: Cannot allocate Vulkan descriptor sets!" );
-				ret.result	= result;
-				return ret;
-			}
-
-			++newCategory.counter;
-
-			ret.descriptorSet	= set;
-			ret.parentPool		= newCategory.pool;
-			ret.result			= result;
-			ret.allocated		= true;
+			ret.result		= result;
+			return ret;
 		}
 
-		poolCategories.push_back( newCategory );
+		category.pools.push_back( pool );
+		category.freeSets.insert( category.freeSets.end(), sets.rbegin(), sets.rend() );
 	}
+
+	ret.descriptorSet		= category.freeSets.back();
+	ret.result				= VK_SUCCESS;
+	ret.parentAutoPool		= this;
+	ret.parentLayout		= setLayout;
+	ret.allocated			= true;
+	category.freeSets.pop_back();
+	++category.allocatedCount;
 	return ret;
 }
 
@@ -315,37 +201,98 @@ void vk2d::_internal::DescriptorAutoPool::FreeDescriptorSet(
 )
 {
 	VK2D_ASSERT_SINGLE_THREAD_ACCESS_SCOPE();
+	assert( IsOwnerThread() );
 
 	if( rDescriptorSet.allocated ) {
-		assert( rDescriptorSet.parentPool );
-		auto it = poolCategories.begin();
-		while( it != poolCategories.end() ) {
-			if( it->pool == rDescriptorSet.parentPool ) {
-				// found the right pool.
-				vkFreeDescriptorSets(
-					refDevice,
-					rDescriptorSet.parentPool,
-					1, &rDescriptorSet.descriptorSet
-				);
-				--it->counter;
-				it->isFull		= false;
-				if( it->counter == 0 ) {
+		assert( rDescriptorSet.parentAutoPool == this );
+
+		auto it = layoutCategories.find( rDescriptorSet.parentLayout );
+		assert( it != layoutCategories.end() );
+		if( it != layoutCategories.end() ) {
+			auto & category = it->second;
+			category.freeSets.push_back( rDescriptorSet.descriptorSet );
+			--category.allocatedCount;
+
+			// Everything of this layout was returned, if it ever needed more than one
+			// batch, let go of all of them so peak usage doesn't stay allocated forever.
+			if( category.allocatedCount == 0 && category.pools.size() > 1 ) {
+				for( auto p : category.pools ) {
 					vkDestroyDescriptorPool(
 						refDevice,
-						it->pool,
+						p,
 						nullptr
 					);
-					it = poolCategories.erase( it );
-				} else {
-					++it;
 				}
-				break;
-			} else {
-				++it;
+				layoutCategories.erase( it );
 			}
 		}
-		rDescriptorSet			= {};
 	}
+	rDescriptorSet			= {};
+}
+
+void vk2d::_internal::DescriptorAutoPool::DeferredFreeDescriptorSet(
+	vk2d::_internal::PoolDescriptorSet		&	rDescriptorSet
+)
+{
+	if( rDescriptorSet.allocated ) {
+		assert( rDescriptorSet.parentAutoPool == this );
+		deferredFrees.Push( rDescriptorSet );
+	}
+	rDescriptorSet			= {};
+}
+
+void vk2d::_internal::DescriptorAutoPool::ProcessDeferredFrees()
+{
+	deferredFrees.Drain( [ this ]( vk2d::_internal::PoolDescriptorSet & descriptorSet )
+		{
+			FreeDescriptorSet( descriptorSet );
+		} );
+}
+
+bool vk2d::_internal::DescriptorAutoPool::IsOwnerThread() const
+{
+	return ownerThread == std::this_thread::get_id();
+}
+
+VkDescriptorPool vk2d::_internal::DescriptorAutoPool::CreateDescriptorPoolForLayout(
+	const vk2d::_internal::DescriptorSetLayout		&	rForDescriptorSetLayout,
+	uint32_t											setCount
+)
+{
+	std::vector<VkDescriptorPoolSize> poolSizes {};
+	auto & amounts = rForDescriptorSetLayout.GetDescriptorPoolRequirements().GetBindingAmounts();
+	for( size_t i = 0; i < amounts.size(); ++i ) {
+		auto amount = amounts[ i ];
+		if( amount ) {
+			VkDescriptorPoolSize poolSize {};
+			poolSize.type				= VkDescriptorType( i );
+			poolSize.descriptorCount	= amount * setCount;
+			poolSizes.push_back( poolSize );
+		}
+	}
+
+	// Sets are never freed individually so the pool doesn't need
+	// VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT and can't fragment.
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo {};
+	descriptorPoolCreateInfo.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.pNext				= nullptr;
+	descriptorPoolCreateInfo.flags				= 0;
+	descriptorPoolCreateInfo.maxSets			= setCount;
+	descriptorPoolCreateInfo.poolSizeCount		= uint32_t( poolSizes.size() );
+	descriptorPoolCreateInfo.pPoolSizes			= poolSizes.data();
+
+	VkDescriptorPool pool = VK_NULL_HANDLE;
+	auto result = vkCreateDescriptorPool(
+		refDevice,
+		&descriptorPoolCreateInfo,
+		nullptr,
+		&pool
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot create Vulkan descriptor pool!" );
+		return VK_NULL_HANDLE;
+	}
+	return pool;
 }
 
 
@@ -2,6 +2,8 @@
 
 #include "Core/SourceCommon.h"
 
+#include "Types/Synchronization.hpp"
+
 namespace vk2d {
 
 namespace _internal {
@@ -14,22 +16,10 @@ class DescriptorSetLayout;
 class DescriptorAutoPool;
 struct PoolDescriptorSet;
 
-/// @brief		Descriptor pool requirements is a way of detecting compatible descriptor pools for different descriptor set layouts.
-/// 
-///				When we're allocating a descriptor set from the DescriptorAutoPool, it needs to create the Vulkan descriptor pools
-///				internally for different descriptor sets with different VkDescriptorType's.
-///				In short, we need to have information about what descriptor types are needed and how many bindings are needed in order
-///				to try and guess the best possible internal Vulkan descriptor pool to allocate from.
-///				In detail, if your first descriptor set layout uses VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-///				DescriptorAutoPool internally creates a vulkan descriptor pool that only has VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
-///				available, this is to save on resources, the next descriptor set allocation might want
-///				both VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER and VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER types, the Vulkan descriptor pool
-///				created internally by the DescriptorAutoPool cannot provide this descriptor set, so the DescriptorAutoPool will
-///				have to create another internal Vulkan descriptor pool that has both descriptor types.
-///				After this if we want to allocate another descriptor set with only VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER type
-///				we could allocate this from either internal Vulkan descriptor pool, but we should try to allocate it from the one
-///				that would waste the least amount of resources, this problem becomes more severe when considering different amounts
-///				of different descriptor types, we need some heuristics for this and 100% resource utilization will be near impossible.
+/// @brief		Descriptor pool requirements tell how many descriptors of each VkDescriptorType a descriptor set layout needs.
+///
+///				DescriptorAutoPool creates internal Vulkan descriptor pools per descriptor set layout, pool sizes
+///				are the binding amounts of the layout multiplied by the amount of sets the pool should hold.
 class DescriptorPoolRequirements {
 	friend class vk2d::_internal::DescriptorSetLayout;
 
@@ -40,20 +30,17 @@ public:
 		return bindingAmounts;
 	};
 
-	// Heuristic function, 0 = will not work, 1 = 100% compatible, 0-1 = will work but there might be a better option.
-	 double															CheckCompatibilityWith(
-		const DescriptorPoolRequirements						&	other ) const;
-
 private:
 	std::array<uint32_t, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT + 1>	bindingAmounts					= {};
-	uint64_t														typeBits						= {};
 };
 
-struct PoolCategory {
-	DescriptorPoolRequirements		originalPoolRequirements		= {};
-	VkDescriptorPool				pool							= {};
-	bool							isFull							= {};
-	uint64_t						counter							= {};
+// Descriptor sets of a single descriptor set layout. Sets are allocated from Vulkan
+// in batches into a free list and recycled from there, they're never freed back to
+// the Vulkan descriptor pool individually, this makes allocating and freeing O(1).
+struct DescriptorLayoutCategory {
+	std::vector<VkDescriptorPool>	pools							= {};
+	std::vector<VkDescriptorSet>	freeSets						= {};
+	uint64_t						allocatedCount					= {};
 };
 
 class DescriptorSetLayout {
@@ -74,8 +61,8 @@ public:
 	 VkDescriptorSetLayout											GetVulkanDescriptorSetLayout() const;
 	 const VkDescriptorSetLayoutCreateInfo						&	GetDescriptorSetLayoutCreateInfo() const;
 
-	// Somewhat specialized and mostly used only by the VKRende lirar,
-	// Read more above in the DescriptorPoolCategory struct defniton.
+	// Somewhat specialized and mostly used only by the DescriptorAutoPool,
+	// Read more above in the DescriptorPoolRequirements class definition.
 	 const vk2d::_internal::DescriptorPoolRequirements			&	GetDescriptorPoolRequirements() const;
 
 																	operator VkDescriptorSetLayout() const;
@@ -106,10 +93,16 @@ struct PoolDescriptorSet {
 
 	operator VkResult() const;
 
+	inline vk2d::_internal::DescriptorAutoPool					*	GetParentAutoPool() const
+	{
+		return parentAutoPool;
+	}
+
 	VkDescriptorSet													descriptorSet							= {};
 	VkResult														result									= {};
 private:
-	VkDescriptorPool												parentPool								= {};
+	vk2d::_internal::DescriptorAutoPool							*	parentAutoPool							= {};
+	VkDescriptorSetLayout											parentLayout							= {};
 	bool															allocated								= {};
 };
 
@@ -128,14 +121,34 @@ public:
 	vk2d::_internal::PoolDescriptorSet								AllocateDescriptorSet(
 		const vk2d::_internal::DescriptorSetLayout				&	rForDescriptorSetLayout );
 
+	// Only call from the thread that owns this pool, use DeferredFreeDescriptorSet() otherwise.
 	 void															FreeDescriptorSet(
 		 vk2d::_internal::PoolDescriptorSet						&	pDescriptorSet );
 
+	// Can be called from any thread, descriptor set is returned to the free list
+	// the next time the owning thread allocates or calls ProcessDeferredFrees().
+	void															DeferredFreeDescriptorSet(
+		vk2d::_internal::PoolDescriptorSet						&	rDescriptorSet );
+
+	void															ProcessDeferredFrees();
+
+	// Pools are owned by the thread that created them.
+	bool															IsOwnerThread() const;
+
 private:
-	vk2d::_internal::InstanceImpl								*	instance			= {};
+	VkDescriptorPool												CreateDescriptorPoolForLayout(
+		const vk2d::_internal::DescriptorSetLayout				&	rForDescriptorSetLayout,
+		uint32_t													setCount );
+
+	vk2d::_internal::InstanceImpl								*	instance				= {};
 
 	VkDevice														refDevice				= {};
-	std::vector<vk2d::_internal::PoolCategory>						poolCategories			= {};
+	std::thread::id													ownerThread				= {};
+	std::unordered_map<VkDescriptorSetLayout, vk2d::_internal::DescriptorLayoutCategory>
+																	layoutCategories		= {};
+
+	vk2d::_internal::DeferredFreeQueue<vk2d::_internal::PoolDescriptorSet>
+																	deferredFrees;
 
 	bool															is_good					= {};
 };
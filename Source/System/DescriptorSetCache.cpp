@@ -0,0 +1,217 @@
+
+#include "Core/SourceCommon.h"
+
+#include "System/DescriptorSetCache.h"
+
+#include "Interface/InstanceImpl.h"
+
+
+
+namespace vk2d {
+namespace _internal {
+
+constexpr size_t DESCRIPTOR_SET_CACHE_MINIMUM_SIZE				= 64;
+
+// Eviction scan is spread out, an entry lives at most this much longer than the eviction age.
+constexpr uint64_t DESCRIPTOR_SET_CACHE_EVICTION_SCAN_INTERVAL	= std::max( uint64_t( VK2D_BUILD_OPTION_DESCRIPTOR_SET_CACHE_EVICTION_AGE / 4 ), uint64_t( 1 ) );
+
+} // _internal
+} // vk2d
+
+
+
+vk2d::_internal::DescriptorSetCache::DescriptorSetCache(
+	vk2d::_internal::InstanceImpl					*	instance,
+	const vk2d::_internal::DescriptorSetLayout		&	descriptor_set_layout
+)
+{
+	assert( instance );
+
+	this->instance					= instance;
+	this->descriptor_set_layout		= &descriptor_set_layout;
+}
+
+vk2d::_internal::DescriptorSetCache::~DescriptorSetCache()
+{
+	for( auto & r : retired_descriptor_sets ) {
+		for( auto & d : r ) {
+			instance->FreeDescriptorSet( d );
+		}
+	}
+	for( auto & e : entries ) {
+		if( e.resource_id && e.descriptor_set.descriptorSet != VK_NULL_HANDLE ) {
+			instance->FreeDescriptorSet( e.descriptor_set );
+		}
+	}
+}
+
+void vk2d::_internal::DescriptorSetCache::SetCurrentFrame(
+	uint32_t		frame_index
+)
+{
+	current_frame		= frame_index;
+	++frame_counter;
+
+	if( frame_counter - last_eviction_frame >= vk2d::_internal::DESCRIPTOR_SET_CACHE_EVICTION_SCAN_INTERVAL ) {
+		last_eviction_frame		= frame_counter;
+		EvictUnusedEntries();
+	}
+}
+
+void vk2d::_internal::DescriptorSetCache::ResetFrame(
+	uint32_t		frame_index
+)
+{
+	if( frame_index >= uint32_t( retired_descriptor_sets.size() ) ) return;
+
+	auto & retired = retired_descriptor_sets[ frame_index ];
+	for( auto & d : retired ) {
+		instance->FreeDescriptorSet( d );
+	}
+	retired.clear();
+}
+
+VkDescriptorSet vk2d::_internal::DescriptorSetCache::Acquire(
+	uint64_t		resource_id,
+	uint64_t		generation,
+	bool		&	out_needs_write
+)
+{
+	assert( resource_id );
+
+	out_needs_write		= false;
+
+	// Keep load factor under 70% so probe sequences stay short.
+	if( ( entry_count + 1 ) * 10 > entries.size() * 7 ) {
+		Grow();
+	}
+
+	auto & entry = entries[ FindSlot( resource_id ) ];
+	if( entry.resource_id == resource_id ) {
+		entry.last_used_frame		= frame_counter;
+		if( entry.generation == generation &&
+			entry.descriptor_set.descriptorSet != VK_NULL_HANDLE ) {
+			++hit_count;
+			return entry.descriptor_set.descriptorSet;
+		}
+
+		// Resource was replaced, descriptor set may still be in use
+		// by a frame in flight so we can't update it, replace it instead.
+		Retire( entry.descriptor_set );
+	} else {
+		entry.resource_id			= resource_id;
+		++entry_count;
+	}
+	++miss_count;
+
+	entry.generation				= generation;
+	entry.last_used_frame			= frame_counter;
+	entry.descriptor_set			= instance->AllocateDescriptorSet( *descriptor_set_layout );
+	if( entry.descriptor_set != VK_SUCCESS ) {
+		// Entry is kept, allocation is tried again next time.
+		entry.descriptor_set		= {};
+		return VK_NULL_HANDLE;
+	}
+
+	out_needs_write					= true;
+	return entry.descriptor_set.descriptorSet;
+}
+
+vk2d::DescriptorCacheStatistics vk2d::_internal::DescriptorSetCache::GetStatistics() const
+{
+	vk2d::DescriptorCacheStatistics statistics {};
+	statistics.hit_count			= hit_count;
+	statistics.miss_count			= miss_count;
+	statistics.eviction_count		= eviction_count;
+	statistics.entry_count			= entry_count;
+	return statistics;
+}
+
+size_t vk2d::_internal::DescriptorSetCache::FindSlot(
+	uint64_t		resource_id
+) const
+{
+	assert( !entries.empty() );
+
+	// Resource IDs are sequential, multiplying with an odd constant
+	// spreads them over the table. Linear probing, table always has
+	// empty slots so this terminates.
+	size_t mask		= entries.size() - 1;
+	size_t slot		= size_t( resource_id * 0x9E3779B97F4A7C15ull ) & mask;
+	while( entries[ slot ].resource_id != 0 &&
+		entries[ slot ].resource_id != resource_id ) {
+		slot		= ( slot + 1 ) & mask;
+	}
+	return slot;
+}
+
+void vk2d::_internal::DescriptorSetCache::Grow()
+{
+	auto old_entries		= std::move( entries );
+	entries					= std::vector<Entry>( std::max( old_entries.size() * 2, vk2d::_internal::DESCRIPTOR_SET_CACHE_MINIMUM_SIZE ) );
+
+	for( auto & e : old_entries ) {
+		if( e.resource_id ) {
+			entries[ FindSlot( e.resource_id ) ] = e;
+		}
+	}
+}
+
+void vk2d::_internal::DescriptorSetCache::EvictUnusedEntries()
+{
+	if( !entry_count ) return;
+
+	// Evicted entries are removed by rebuilding the table, this is rare
+	// enough that backward shift deletion isn't worth the complexity.
+	std::vector<Entry> survivors;
+	survivors.reserve( entry_count );
+	for( auto & e : entries ) {
+		if( !e.resource_id ) continue;
+
+		if( e.last_used_frame + VK2D_BUILD_OPTION_DESCRIPTOR_SET_CACHE_EVICTION_AGE < frame_counter ) {
+			Retire( e.descriptor_set );
+			++eviction_count;
+		} else {
+			survivors.push_back( e );
+		}
+	}
+	if( survivors.size() == entry_count ) return;
+
+	std::fill( entries.begin(), entries.end(), Entry {} );
+	for( auto & e : survivors ) {
+		entries[ FindSlot( e.resource_id ) ] = e;
+	}
+	entry_count		= survivors.size();
+}
+
+void vk2d::_internal::DescriptorSetCache::Retire(
+	vk2d::_internal::PoolDescriptorSet		&	descriptor_set
+)
+{
+	if( descriptor_set.descriptorSet == VK_NULL_HANDLE ) return;
+
+	if( current_frame >= uint32_t( retired_descriptor_sets.size() ) ) {
+		retired_descriptor_sets.resize( size_t( current_frame ) + 1 );
+	}
+	retired_descriptor_sets[ current_frame ].push_back( descriptor_set );
+	descriptor_set		= {};
+}
+
+
+
+vk2d::DescriptorCacheStatistics vk2d::_internal::CombineDescriptorCacheStatistics(
+	const vk2d::_internal::DescriptorSetCache		*	cache_1,
+	const vk2d::_internal::DescriptorSetCache		*	cache_2
+)
+{
+	vk2d::DescriptorCacheStatistics combined {};
+	for( auto c : { cache_1, cache_2 } ) {
+		if( !c ) continue;
+		auto statistics = c->GetStatistics();
+		combined.hit_count			+= statistics.hit_count;
+		combined.miss_count			+= statistics.miss_count;
+		combined.eviction_count		+= statistics.eviction_count;
+		combined.entry_count		+= statistics.entry_count;
+	}
+	return combined;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Core/SourceCommon.h"
+
+#include "Types/DescriptorCacheStatistics.h"
+
+#include "System/DescriptorSet.h"
+
+
+
+namespace vk2d {
+
+namespace _internal {
+
+class InstanceImpl;
+
+
+
+// Caches descriptor sets of a single descriptor set layout keyed by resource
+// ID and generation, see vk2d::_internal::GenerateResourceID(). Entries live
+// in a flat open addressing table so a lookup is a hash and usually a single
+// compare. Entries not used for VK2D_BUILD_OPTION_DESCRIPTOR_SET_CACHE_EVICTION_AGE
+// frames are evicted. Replaced and evicted sets are retired with the frame and
+// freed once that frame is done on the GPU. Not thread safe, cache belongs to
+// a single render target.
+class DescriptorSetCache {
+public:
+																	DescriptorSetCache(
+		vk2d::_internal::InstanceImpl							*	instance,
+		const vk2d::_internal::DescriptorSetLayout				&	descriptor_set_layout );
+
+																	~DescriptorSetCache();
+
+	// Selects which frame following retirements belong to and evicts entries
+	// not used for a while. Frame index is usually the swapchain image index
+	// or the swap buffer index.
+	void															SetCurrentFrame(
+		uint32_t													frame_index );
+
+	// Frees descriptor sets retired during a frame. Only call this once the
+	// GPU has finished using the frame, eg. after the frame fence signaled.
+	void															ResetFrame(
+		uint32_t													frame_index );
+
+	// Gets the descriptor set of a resource. If the resource isn't cached yet
+	// or generation changed a new descriptor set is allocated and out_needs_write
+	// is set, caller must then write the descriptors before using it.
+	// Returns VK_NULL_HANDLE if descriptor set could not be allocated.
+	VkDescriptorSet													Acquire(
+		uint64_t													resource_id,
+		uint64_t													generation,
+		bool													&	out_needs_write );
+
+	vk2d::DescriptorCacheStatistics									GetStatistics() const;
+
+private:
+	struct Entry {
+		uint64_t													resource_id					= {};	// 0 if empty.
+		uint64_t													generation					= {};
+		uint64_t													last_used_frame				= {};
+		vk2d::_internal::PoolDescriptorSet							descriptor_set				= {};
+	};
+
+	size_t															FindSlot(
+		uint64_t													resource_id ) const;
+
+	void															Grow();
+
+	void															EvictUnusedEntries();
+
+	void															Retire(
+		vk2d::_internal::PoolDescriptorSet						&	descriptor_set );
+
+	vk2d::_internal::InstanceImpl								*	instance					= {};
+	const vk2d::_internal::DescriptorSetLayout					*	descriptor_set_layout		= {};
+
+	std::vector<Entry>												entries						= {};	// Size is always a power of two.
+	size_t															entry_count					= {};
+
+	std::vector<std::vector<vk2d::_internal::PoolDescriptorSet>>	retired_descriptor_sets		= {};	// Per frame.
+	uint32_t														current_frame				= {};
+	uint64_t														frame_counter				= {};
+	uint64_t														last_eviction_frame			= {};
+
+	uint64_t														hit_count					= {};
+	uint64_t														miss_count					= {};
+	uint64_t														eviction_count				= {};
+};
+
+
+
+// Sums statistics of several caches, null caches are skipped.
+vk2d::DescriptorCacheStatistics										CombineDescriptorCacheStatistics(
+	const vk2d::_internal::DescriptorSetCache					*	cache_1,
+	const vk2d::_internal::DescriptorSetCache					*	cache_2 );
+
+
+
+} // _internal
+
+} // vk2d
@@ -0,0 +1,219 @@
+
+#include "Core/SourceCommon.h"
+
+#include "System/VulkanMemoryManagement.h"
+#include "System/FrameLinearAllocator.h"
+
+
+
+vk2d::_internal::FrameLinearAllocator::FrameLinearAllocator(
+	vk2d::_internal::DeviceMemoryPool		*	device_memory_pool,
+	VkBufferUsageFlags							buffer_usage,
+	VkDeviceSize								page_size,
+	VkDeviceSize								max_page_size
+)
+{
+	assert( device_memory_pool );
+	assert( page_size );
+	assert( max_page_size >= page_size );
+
+	this->device_memory_pool		= device_memory_pool;
+	this->buffer_usage				= buffer_usage;
+	this->page_size					= page_size;
+	this->max_page_size				= max_page_size;
+
+	// Every allocation is aligned so that it can be used as a uniform or storage
+	// buffer range directly, 16 bytes also covers buffer to image copy offsets.
+	auto & limits					= device_memory_pool->GetPhysicalDeviceProperties().limits;
+	this->minimum_alignment			= std::max( limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment );
+	this->minimum_alignment			= std::max( this->minimum_alignment, VkDeviceSize( 16 ) );
+
+	// First frame gets its page right away, this also tells if usable
+	// memory exists at all before anyone starts relying on the allocator.
+	if( !AllocatePage( GetFrame( 0 ), page_size ) ) {
+		return;
+	}
+
+	is_good							= true;
+}
+
+vk2d::_internal::FrameLinearAllocator::~FrameLinearAllocator()
+{
+	for( auto & f : frames ) {
+		for( auto & p : f.pages ) {
+			FreePage( p );
+		}
+	}
+}
+
+void vk2d::_internal::FrameLinearAllocator::SetCurrentFrame(
+	uint32_t		frame_index
+)
+{
+	GetFrame( frame_index );
+	current_frame		= frame_index;
+}
+
+void vk2d::_internal::FrameLinearAllocator::ResetFrame(
+	uint32_t		frame_index
+)
+{
+	auto & frame = GetFrame( frame_index );
+
+	// Dedicated pages are only kept for the frame that needed them.
+	VkDeviceSize	regular_used_size		= 0;
+	uint32_t		regular_page_count		= 0;
+	for( auto p = frame.pages.begin(); p != frame.pages.end(); ) {
+		if( p->capacity > max_page_size ) {
+			FreePage( *p );
+			p = frame.pages.erase( p );
+		} else {
+			regular_used_size		+= p->used;
+			++regular_page_count;
+			++p;
+		}
+	}
+
+	// If the frame overflowed into multiple pages, replace them with a single
+	// page that can hold the whole frame so we don't overflow next time.
+	if( regular_page_count > 1 ) {
+		for( auto & p : frame.pages ) {
+			FreePage( p );
+		}
+		frame.pages.clear();
+		AllocatePage(
+			frame,
+			std::min( std::max( regular_used_size, page_size ), max_page_size )
+		);
+	}
+
+	for( auto & p : frame.pages ) {
+		p.used			= 0;
+	}
+	frame.used_size		= 0;
+}
+
+vk2d::_internal::FrameLinearAllocation vk2d::_internal::FrameLinearAllocator::Allocate(
+	VkDeviceSize		byte_size,
+	VkDeviceSize		alignment
+)
+{
+	assert( byte_size );
+	assert( ( alignment & ( alignment - 1 ) ) == 0 );
+
+	auto & frame		= GetFrame( current_frame );
+	alignment			= std::max( alignment, minimum_alignment );
+
+	auto TryAllocateFromPage = [ this, &frame, byte_size, alignment ](
+		vk2d::_internal::FrameLinearAllocator::Page		&	page
+		) -> vk2d::_internal::FrameLinearAllocation
+	{
+		VkDeviceSize aligned_offset		= ( page.used + alignment - 1 ) & ~( alignment - 1 );
+		if( aligned_offset + byte_size > page.capacity ) return {};
+
+		frame.used_size					+= ( aligned_offset - page.used ) + byte_size;
+		page.used						= aligned_offset + byte_size;
+		peak_used_size					= std::max( peak_used_size, frame.used_size );
+
+		vk2d::_internal::FrameLinearAllocation allocation {};
+		allocation.result				= VK_SUCCESS;
+		allocation.buffer				= page.buffer.buffer;
+		allocation.offset				= aligned_offset;
+		allocation.size					= byte_size;
+		allocation.mapped_data			= page.buffer.memory.Map<uint8_t>() + aligned_offset;
+		allocation.memory				= page.buffer.memory;
+		return allocation;
+	};
+
+	// Frames only have a couple of pages at most, just check them all.
+	for( auto & p : frame.pages ) {
+		auto allocation = TryAllocateFromPage( p );
+		if( allocation == VK_SUCCESS ) return allocation;
+	}
+
+	// Out of space, grow by doubling the previous page until the maximum page size,
+	// anything that doesn't fit a maximum size page gets a dedicated page.
+	VkDeviceSize new_page_capacity		= page_size;
+	if( frame.pages.size() ) {
+		new_page_capacity				= std::min( frame.pages.back().capacity * 2, max_page_size );
+	}
+	new_page_capacity					= std::max( new_page_capacity, byte_size );
+
+	if( !AllocatePage( frame, new_page_capacity ) ) {
+		return { VK_ERROR_OUT_OF_DEVICE_MEMORY };
+	}
+	return TryAllocateFromPage( frame.pages.back() );
+}
+
+VkDeviceSize vk2d::_internal::FrameLinearAllocator::GetFrameUsedSize(
+	uint32_t		frame_index
+) const
+{
+	if( frame_index < uint32_t( frames.size() ) ) {
+		return frames[ frame_index ].used_size;
+	}
+	return 0;
+}
+
+VkDeviceSize vk2d::_internal::FrameLinearAllocator::GetPeakUsedSize() const
+{
+	return peak_used_size;
+}
+
+bool vk2d::_internal::FrameLinearAllocator::IsGood() const
+{
+	return is_good;
+}
+
+bool vk2d::_internal::FrameLinearAllocator::AllocatePage(
+	vk2d::_internal::FrameLinearAllocator::Frame		&	frame,
+	VkDeviceSize											capacity
+)
+{
+	VkBufferCreateInfo buffer_create_info {};
+	buffer_create_info.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	buffer_create_info.pNext					= nullptr;
+	buffer_create_info.flags					= 0;
+	buffer_create_info.size						= capacity;
+	buffer_create_info.usage					= buffer_usage;
+	buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
+	buffer_create_info.queueFamilyIndexCount	= 0;
+	buffer_create_info.pQueueFamilyIndices		= nullptr;
+
+	vk2d::_internal::FrameLinearAllocator::Page page {};
+	page.buffer = device_memory_pool->CreateCompleteBufferResource(
+		&buffer_create_info,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+	);
+	if( page.buffer != VK_SUCCESS ) {
+		return false;
+	}
+	if( !page.buffer.memory.Map<uint8_t>() ) {
+		device_memory_pool->FreeCompleteResource( page.buffer );
+		return false;
+	}
+	page.capacity		= capacity;
+	page.used			= 0;
+
+	frame.pages.push_back( page );
+	return true;
+}
+
+void vk2d::_internal::FrameLinearAllocator::FreePage(
+	vk2d::_internal::FrameLinearAllocator::Page		&	page
+)
+{
+	device_memory_pool->FreeCompleteResource( page.buffer );
+	page				= {};
+}
+
+vk2d::_internal::FrameLinearAllocator::Frame & vk2d::_internal::FrameLinearAllocator::GetFrame(
+	uint32_t		frame_index
+)
+{
+	// Frame count may change, eg. when swapchain is re-created.
+	if( frame_index >= uint32_t( frames.size() ) ) {
+		frames.resize( size_t( frame_index ) + 1 );
+	}
+	return frames[ frame_index ];
+}
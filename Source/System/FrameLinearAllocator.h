@@ -0,0 +1,143 @@
+#pragma once
+
+#include "Core/SourceCommon.h"
+
+#include "System/VulkanMemoryManagement.h"
+
+
+
+namespace vk2d {
+
+namespace _internal {
+
+class DeviceMemoryPool;
+
+
+
+// Single allocation from the FrameLinearAllocator. Valid only until the
+// frame it was allocated for is reset, there is no need to free it.
+class FrameLinearAllocation {
+public:
+	VkResult										result								= VK_RESULT_MAX_ENUM;
+	VkBuffer										buffer								= {};
+	VkDeviceSize									offset								= {};
+	VkDeviceSize									size								= {};
+	void										*	mapped_data							= {};
+	vk2d::_internal::PoolMemory						memory								= {};	// Memory of the whole page.
+
+	template<typename T>
+	inline T									*	Get()
+	{
+		return reinterpret_cast<T*>( mapped_data );
+	}
+
+	// Makes host writes to this allocation visible to the device, flushes
+	// only this allocation's range and nothing if the page is host coherent.
+	inline void										Flush()
+	{
+		memory.Flush( offset, size );
+	}
+
+	// Makes device writes to this allocation visible to the host, call before
+	// reading what the device wrote.
+	inline void										Invalidate()
+	{
+		memory.Invalidate( offset, size );
+	}
+
+	inline											operator VkResult()
+	{
+		return result;
+	}
+};
+
+
+
+// Bump allocator for transient host visible buffer memory, used for data that
+// only needs to live for a single frame, eg. uniform staging and readbacks.
+// Every frame in flight has its own set of pages, allocations are just an
+// offset increment into the current page. Frame is reset all at once after
+// the frame's fence has signaled, no per allocation bookkeeping is done.
+// Pages are persistently mapped, memory is host visible and host coherent.
+// Not thread safe, allocator belongs to a single render target.
+class FrameLinearAllocator {
+public:
+																FrameLinearAllocator(
+		vk2d::_internal::DeviceMemoryPool					*	device_memory_pool,
+		VkBufferUsageFlags										buffer_usage,
+		VkDeviceSize											page_size					= VK2D_BUILD_OPTION_FRAME_LINEAR_ALLOCATOR_PAGE_SIZE,
+		VkDeviceSize											max_page_size				= VK2D_BUILD_OPTION_FRAME_LINEAR_ALLOCATOR_MAX_PAGE_SIZE );
+
+																~FrameLinearAllocator();
+
+	// Selects which frame following allocations are made from. Frame index
+	// is usually the swapchain image index or the swap buffer index.
+	void														SetCurrentFrame(
+		uint32_t												frame_index );
+
+	// Releases everything allocated for a frame. Only call this once the
+	// GPU has finished using the frame, eg. after the frame fence signaled.
+	void														ResetFrame(
+		uint32_t												frame_index );
+
+	// Allocates space from the current frame. Alignment must be a power of two.
+	vk2d::_internal::FrameLinearAllocation						Allocate(
+		VkDeviceSize											byte_size,
+		VkDeviceSize											alignment );
+
+	template<typename T>
+	vk2d::_internal::FrameLinearAllocation						Allocate(
+		VkDeviceSize											count )
+	{
+		return Allocate( sizeof( T ) * count, alignof( T ) );
+	}
+
+	// Bytes in use by a frame since it was previously reset.
+	VkDeviceSize												GetFrameUsedSize(
+		uint32_t												frame_index ) const;
+
+	// Highest amount of bytes used by a single frame.
+	VkDeviceSize												GetPeakUsedSize() const;
+
+	bool														IsGood() const;
+
+private:
+	struct Page {
+		vk2d::_internal::CompleteBufferResource					buffer						= {};
+		VkDeviceSize											capacity					= {};
+		VkDeviceSize											used						= {};
+	};
+
+	struct Frame {
+		std::vector<vk2d::_internal::FrameLinearAllocator::Page>	pages					= {};
+		VkDeviceSize											used_size					= {};
+	};
+
+	bool														AllocatePage(
+		vk2d::_internal::FrameLinearAllocator::Frame		&	frame,
+		VkDeviceSize											capacity );
+
+	void														FreePage(
+		vk2d::_internal::FrameLinearAllocator::Page			&	page );
+
+	vk2d::_internal::FrameLinearAllocator::Frame			&	GetFrame(
+		uint32_t												frame_index );
+
+	vk2d::_internal::DeviceMemoryPool						*	device_memory_pool			= {};
+	VkBufferUsageFlags											buffer_usage				= {};
+	VkDeviceSize												page_size					= {};
+	VkDeviceSize												max_page_size				= {};
+	VkDeviceSize												minimum_alignment			= {};
+
+	std::vector<vk2d::_internal::FrameLinearAllocator::Frame>	frames						= {};
+	uint32_t													current_frame				= {};
+	VkDeviceSize												peak_used_size				= {};
+
+	bool														is_good						= {};
+};
+
+
+
+} // _internal
+
+} // vk2d
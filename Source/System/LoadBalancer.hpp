@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Core/SourceCommon.h"
+
+
+
+namespace vk2d {
+namespace _internal {
+
+
+
+// Distributes work between a fixed set of workers by estimated cost. Every
+// worker has a running total of the cost of work queued to it, new work goes
+// to the worker with the smallest total and the cost is released when the
+// work is done. Costs are in arbitrary units, only relative size matters.
+// Thread safe, totals are read without locking so two simultaneous
+// acquires may both pick the same worker, this only affects balance.
+class LoadBalancer {
+public:
+	explicit											LoadBalancer(
+		size_t											worker_count ) :
+		queued_costs( new std::atomic<uint64_t>[ worker_count ] ),
+		worker_count( worker_count )
+	{
+		assert( worker_count );
+		for( size_t i = 0; i < worker_count; ++i ) {
+			queued_costs[ i ] = 0;
+		}
+	}
+
+	// Picks the least loaded worker and adds cost to it, returns worker index.
+	size_t												Acquire(
+		uint64_t										cost )
+	{
+		// Search starts from a different worker every time so equally
+		// loaded workers, for example when idle, are picked round robin.
+		size_t start		= next_start.fetch_add( 1, std::memory_order_relaxed ) % worker_count;
+		size_t best			= start;
+		uint64_t best_cost	= queued_costs[ start ].load( std::memory_order_relaxed );
+		for( size_t i = 1; i < worker_count && best_cost; ++i ) {
+			size_t w		= ( start + i ) % worker_count;
+			uint64_t c		= queued_costs[ w ].load( std::memory_order_relaxed );
+			if( c < best_cost ) {
+				best		= w;
+				best_cost	= c;
+			}
+		}
+		queued_costs[ best ].fetch_add( cost, std::memory_order_relaxed );
+		return best;
+	}
+
+	// Call when the work given with Acquire() is done.
+	void												Release(
+		size_t											worker,
+		uint64_t										cost )
+	{
+		assert( worker < worker_count );
+		queued_costs[ worker ].fetch_sub( cost, std::memory_order_relaxed );
+	}
+
+	uint64_t											GetQueuedCost(
+		size_t											worker ) const
+	{
+		assert( worker < worker_count );
+		return queued_costs[ worker ].load( std::memory_order_relaxed );
+	}
+
+	size_t												GetWorkerCount() const
+	{
+		return worker_count;
+	}
+
+private:
+	std::unique_ptr<std::atomic<uint64_t>[]>			queued_costs;
+	size_t												worker_count				= {};
+	std::atomic<size_t>									next_start					= {};
+};
+
+
+
+} // _internal
+} // vk2d
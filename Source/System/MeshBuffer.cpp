@@ -64,7 +64,7 @@ vk2d::_internal::MeshBuffer::PushResult vk2d::_internal::MeshBuffer::CmdPushMesh
 		vkCmdBindIndexBuffer(
 			command_buffer,
 			reserve_result.index_block->device_buffer.buffer,
-			0,
+			reserve_result.index_block->device_buffer.offset,
 			VK_INDEX_TYPE_UINT32
 		);
 		vkCmdBindDescriptorSets(
@@ -175,8 +175,8 @@ bool vk2d::_internal::MeshBuffer::CmdUploadMeshDataToGPU(
 			bb->CopyVectorsToStagingBuffers();
 
 			std::array<VkBufferCopy, 1> copy_regions {};
-			copy_regions[ 0 ].srcOffset		= 0;
-			copy_regions[ 0 ].dstOffset		= 0;
+			copy_regions[ 0 ].srcOffset		= bb->staging_buffer.offset;
+			copy_regions[ 0 ].dstOffset		= bb->device_buffer.offset;
 			copy_regions[ 0 ].size			= bb->used_byte_size;
 			vkCmdCopyBuffer(
 				command_buffer,
@@ -196,8 +196,8 @@ bool vk2d::_internal::MeshBuffer::CmdUploadMeshDataToGPU(
 			bb->CopyVectorsToStagingBuffers();
 
 			std::array<VkBufferCopy, 1> copy_regions {};
-			copy_regions[ 0 ].srcOffset		= 0;
-			copy_regions[ 0 ].dstOffset		= 0;
+			copy_regions[ 0 ].srcOffset		= bb->staging_buffer.offset;
+			copy_regions[ 0 ].dstOffset		= bb->device_buffer.offset;
 			copy_regions[ 0 ].size			= bb->used_byte_size;
 			vkCmdCopyBuffer(
 				command_buffer,
@@ -217,8 +217,8 @@ bool vk2d::_internal::MeshBuffer::CmdUploadMeshDataToGPU(
 			bb->CopyVectorsToStagingBuffers();
 
 			std::array<VkBufferCopy, 1> copy_regions {};
-			copy_regions[ 0 ].srcOffset		= 0;
-			copy_regions[ 0 ].dstOffset		= 0;
+			copy_regions[ 0 ].srcOffset		= bb->staging_buffer.offset;
+			copy_regions[ 0 ].dstOffset		= bb->device_buffer.offset;
 			copy_regions[ 0 ].size			= bb->used_byte_size;
 			vkCmdCopyBuffer(
 				command_buffer,
@@ -238,8 +238,8 @@ bool vk2d::_internal::MeshBuffer::CmdUploadMeshDataToGPU(
 			bb->CopyVectorsToStagingBuffers();
 
 			std::array<VkBufferCopy, 1> copy_regions {};
-			copy_regions[ 0 ].srcOffset		= 0;
-			copy_regions[ 0 ].dstOffset		= 0;
+			copy_regions[ 0 ].srcOffset		= bb->staging_buffer.offset;
+			copy_regions[ 0 ].dstOffset		= bb->device_buffer.offset;
 			copy_regions[ 0 ].size			= bb->used_byte_size;
 			vkCmdCopyBuffer(
 				command_buffer,
@@ -6,6 +6,7 @@
 #include "Types/MeshPrimitives.hpp"
 
 #include "System/VulkanMemoryManagement.h"
+#include "System/BufferSubAllocator.h"
 #include "System/DescriptorSet.h"
 
 #include "Interface/WindowImpl.h"
@@ -233,7 +234,9 @@ public:
 
 		mesh_buffer_parent			= mesh_buffer;
 		auto instance				= mesh_buffer_parent->instance;
-		auto memory_pool			= instance->GetDeviceMemoryPool();
+		auto staging_allocator		= instance->GetBufferSubAllocator( vk2d::_internal::BufferUsageClass::STAGING );
+		auto device_allocator		= instance->GetBufferSubAllocator( vk2d::_internal::BufferUsageClass::DEVICE_MESH );
+		assert( ( buffer_usage_flags & ~device_allocator->GetBufferUsage() ) == 0 );
 
 		total_byte_size				= vk2d::_internal::CalculateAlignmentForBuffer(
 			buffer_byte_size,
@@ -242,42 +245,15 @@ public:
 
 		host_data.reserve( total_byte_size / sizeof( T ) + 1 );
 
-		// Create staging buffer
+		// Staging and device buffers are ranges in buffers shared with other mesh buffer blocks.
 		{
-			VkBufferCreateInfo buffer_create_info {};
-			buffer_create_info.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-			buffer_create_info.pNext					= nullptr;
-			buffer_create_info.flags					= 0;
-			buffer_create_info.size						= total_byte_size;
-			buffer_create_info.usage					= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-			buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
-			buffer_create_info.queueFamilyIndexCount	= 0;
-			buffer_create_info.pQueueFamilyIndices		= nullptr;
-			staging_buffer			= memory_pool->CreateCompleteBufferResource(
-				&buffer_create_info,
-				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-			);
+			staging_buffer			= staging_allocator->Allocate( total_byte_size, alignof( T ) );
 			if( staging_buffer != VK_SUCCESS ) {
 				instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error: Cannot create MeshBufferBlock, cannot create staging buffer!" );
 				return;
 			}
-		}
 
-		// Create device buffer
-		{
-			VkBufferCreateInfo buffer_create_info {};
-			buffer_create_info.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-			buffer_create_info.pNext					= nullptr;
-			buffer_create_info.flags					= 0;
-			buffer_create_info.size						= total_byte_size;
-			buffer_create_info.usage					= VK_BUFFER_USAGE_TRANSFER_DST_BIT | buffer_usage_flags;
-			buffer_create_info.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
-			buffer_create_info.queueFamilyIndexCount	= 0;
-			buffer_create_info.pQueueFamilyIndices		= nullptr;
-			device_buffer			= memory_pool->CreateCompleteBufferResource(
-				&buffer_create_info,
-				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-			);
+			device_buffer			= device_allocator->Allocate( total_byte_size, alignof( T ) );
 			if( device_buffer != VK_SUCCESS ) {
 				instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error: Cannot create MeshBufferBlock, cannot create device buffer!" );
 				return;
@@ -296,8 +272,8 @@ public:
 
 				VkDescriptorBufferInfo descriptor_write_buffer_info {};
 				descriptor_write_buffer_info.buffer		= device_buffer.buffer;
-				descriptor_write_buffer_info.offset		= 0;
-				descriptor_write_buffer_info.range		= device_buffer.memory.GetSize();
+				descriptor_write_buffer_info.offset		= device_buffer.offset;
+				descriptor_write_buffer_info.range		= device_buffer.size;
 				std::array<VkWriteDescriptorSet, 1> descriptor_write {};
 				descriptor_write[ 0 ].sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 				descriptor_write[ 0 ].pNext				= nullptr;
@@ -323,8 +299,8 @@ public:
 
 				VkDescriptorBufferInfo descriptor_write_buffer_info {};
 				descriptor_write_buffer_info.buffer		= device_buffer.buffer;
-				descriptor_write_buffer_info.offset		= 0;
-				descriptor_write_buffer_info.range		= device_buffer.memory.GetSize();
+				descriptor_write_buffer_info.offset		= device_buffer.offset;
+				descriptor_write_buffer_info.range		= device_buffer.size;
 				std::array<VkWriteDescriptorSet, 1> descriptor_write {};
 				descriptor_write[ 0 ].sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 				descriptor_write[ 0 ].pNext				= nullptr;
@@ -353,23 +329,22 @@ public:
 
 	~MeshBufferBlock()
 	{
-		auto memory_pool		= mesh_buffer_parent->instance->GetDeviceMemoryPool();
+		auto instance			= mesh_buffer_parent->instance;
 
 		// WARNING: MeshBufferBlock::descriptor_set allocation and freeing needs to be thread specific if we ever start doing multithreaded rendering.
-		mesh_buffer_parent->instance->FreeDescriptorSet( descriptor_set );
-		memory_pool->FreeCompleteResource( device_buffer );
-		memory_pool->FreeCompleteResource( staging_buffer );
+		instance->FreeDescriptorSet( descriptor_set );
+		instance->GetBufferSubAllocator( vk2d::_internal::BufferUsageClass::DEVICE_MESH )->Free( device_buffer );
+		instance->GetBufferSubAllocator( vk2d::_internal::BufferUsageClass::STAGING )->Free( staging_buffer );
 	}
 
 	bool													CopyVectorsToStagingBuffers()
 	{
-		auto mapped_memory	= staging_buffer.memory.Map<T>();
+		auto mapped_memory	= staging_buffer.Get<T>();
 		if( !mapped_memory ) {
 			mesh_buffer_parent->instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, "Internal error: Cannot copy mesh buffer block to  map staging buffer memory" );
 			return false;
 		} else {
 			std::memcpy( mapped_memory, host_data.data(), used_byte_size );
-			staging_buffer.memory.Unmap();
 
 			host_data.clear();
 
@@ -424,8 +399,8 @@ private:
 	VkDeviceSize											total_byte_size				= {};	// Total size of buffer in bytes.
 	VkDeviceSize											used_byte_size				= {};	// Used size of uint data in bytes.
 
-	vk2d::_internal::CompleteBufferResource					staging_buffer				= {};
-	vk2d::_internal::CompleteBufferResource					device_buffer				= {};
+	vk2d::_internal::BufferSubAllocation					staging_buffer				= {};
+	vk2d::_internal::BufferSubAllocation					device_buffer				= {};
 	vk2d::_internal::PoolDescriptorSet						descriptor_set				= {};
 
 	bool													is_good						= {};
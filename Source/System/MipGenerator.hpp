@@ -0,0 +1,565 @@
+#pragma once
+
+// Only depends on the standard library so tests and tools can use this too.
+#include "Core/Common.h"
+
+#include "Interface/ResourceManager/ResourceManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define VK2D_MIP_GENERATOR_SSE2 1
+#include <emmintrin.h>
+#endif
+
+
+
+namespace vk2d {
+namespace _internal {
+
+
+
+// CPU mip level generation for vk2d::ResourceManager::SetTextureMipGeneration().
+//
+// Every mip level is resampled from the previous one with a separable filter,
+// first along rows and then along columns. Colors are filtered in linear
+// light with premultiplied alpha so that transparent texels do not bleed into
+// their neighbors. Previous level is kept in floats so rounding errors don't
+// add up over the chain. Texel channels are filtered together, 4 floats at a
+// time with SSE2 where available. Image edges are clamped.
+//
+// Mip chain is always complete, down to 1 * 1 texels.
+
+constexpr uint8_t		MIP_CACHE_MAGIC[ 8 ]			= { 'V', 'K', '2', 'D', 'M', 'I', 'P', 'S' };
+constexpr uint32_t		MIP_CACHE_VERSION				= 1;
+constexpr size_t		MIP_CACHE_HEADER_SIZE			= 48;
+constexpr uint32_t		MIP_SRGB_ENCODE_TABLE_SIZE		= 16384;
+
+// Identifies the mip levels stored in a mip cache file, file is only used
+// if everything matches.
+struct MipCacheKey {
+	uint64_t										source_hash				= {};	// Hash of the encoded image file.
+	uint64_t										source_size				= {};	// Size of the encoded image file.
+	uint32_t										width					= {};
+	uint32_t										height					= {};
+	vk2d::TextureMipFilter							filter					= {};
+	bool											gamma_correct			= {};
+};
+
+
+
+namespace mip {
+
+// Tap weights of every destination texel along one axis. Every destination
+// texel has tap_count taps starting at first[ destination ].
+struct FilterTaps {
+	uint32_t										tap_count				= {};
+	std::vector<uint32_t>							first					= {};
+	std::vector<float>								weights					= {};	// weights[ destination * tap_count + tap ]
+};
+
+struct ColorTables {
+	float											decode[ 256 ]							= {};
+	uint8_t											encode[ MIP_SRGB_ENCODE_TABLE_SIZE ]	= {};
+};
+
+#if VK2D_MIP_GENERATOR_SSE2
+using Float4 = __m128;
+
+inline Float4 Load( const float * data )					{ return _mm_loadu_ps( data ); }
+inline void Store( float * data, Float4 value )				{ _mm_storeu_ps( data, value ); }
+inline Float4 Splat( float value )							{ return _mm_set1_ps( value ); }
+inline Float4 MultiplyAdd( Float4 sum, Float4 a, Float4 b )	{ return _mm_add_ps( sum, _mm_mul_ps( a, b ) ); }
+
+// Clamps alpha to [0, 1] and premultiplied colors to [0, alpha].
+inline Float4 ClampPremultiplied( Float4 texel )
+{
+	auto alpha = _mm_min_ps( _mm_max_ps( _mm_shuffle_ps( texel, texel, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _mm_setzero_ps() ), _mm_set1_ps( 1.0f ) );
+	return _mm_min_ps( _mm_max_ps( texel, _mm_setzero_ps() ), alpha );
+}
+#else
+struct Float4 {
+	float											v[ 4 ]					= {};
+};
+
+inline Float4 Load( const float * data )					{ Float4 r; std::memcpy( r.v, data, sizeof( r.v ) ); return r; }
+inline void Store( float * data, Float4 value )				{ std::memcpy( data, value.v, sizeof( value.v ) ); }
+inline Float4 Splat( float value )							{ return Float4 { { value, value, value, value } }; }
+inline Float4 MultiplyAdd( Float4 sum, Float4 a, Float4 b )
+{
+	for( int i = 0; i < 4; ++i ) sum.v[ i ] += a.v[ i ] * b.v[ i ];
+	return sum;
+}
+
+inline Float4 ClampPremultiplied( Float4 texel )
+{
+	auto alpha = std::min( std::max( texel.v[ 3 ], 0.0f ), 1.0f );
+	for( int i = 0; i < 4; ++i ) texel.v[ i ] = std::min( std::max( texel.v[ i ], 0.0f ), alpha );
+	return texel;
+}
+#endif
+
+inline float Sinc(
+	float											x )
+{
+	if( std::abs( x ) < 1e-6f ) return 1.0f;
+	auto px = float( vk2d::PI ) * x;
+	return std::sin( px ) / px;
+}
+
+// Modified Bessel function of the first kind, order 0.
+inline float BesselI0(
+	float											x )
+{
+	float sum	= 1.0f;
+	float term	= 1.0f;
+	float q		= x * x * 0.25f;
+	for( int k = 1; k < 32; ++k ) {
+		term	*= q / float( k * k );
+		sum		+= term;
+		if( term < sum * 1e-8f ) break;
+	}
+	return sum;
+}
+
+// Radius of the filter in destination texels.
+inline float GetFilterRadius(
+	vk2d::TextureMipFilter							filter )
+{
+	switch( filter ) {
+		case vk2d::TextureMipFilter::KAISER:
+		case vk2d::TextureMipFilter::LANCZOS:
+			return 3.0f;
+		default:
+			return 0.5f;
+	}
+}
+
+inline float EvaluateFilter(
+	vk2d::TextureMipFilter							filter,
+	float											x )
+{
+	x = std::abs( x );
+	switch( filter ) {
+		case vk2d::TextureMipFilter::KAISER:
+		{
+			// Kaiser windowed sinc, alpha 4.
+			constexpr float alpha = 4.0f;
+			if( x >= 3.0f ) return 0.0f;
+			auto t = x / 3.0f;
+			return vk2d::_internal::mip::Sinc( x ) * vk2d::_internal::mip::BesselI0( alpha * std::sqrt( 1.0f - t * t ) ) / vk2d::_internal::mip::BesselI0( alpha );
+		}
+		case vk2d::TextureMipFilter::LANCZOS:
+			if( x >= 3.0f ) return 0.0f;
+			return vk2d::_internal::mip::Sinc( x ) * vk2d::_internal::mip::Sinc( x / 3.0f );
+		default:
+			return x <= 0.5f ? 1.0f : 0.0f;
+	}
+}
+
+// Taps for resampling source_size texels to destination_size texels.
+inline vk2d::_internal::mip::FilterTaps ComputeFilterTaps(
+	vk2d::TextureMipFilter							filter,
+	uint32_t										source_size,
+	uint32_t										destination_size )
+{
+	vk2d::_internal::mip::FilterTaps taps {};
+	auto scale		= float( source_size ) / float( destination_size );
+	auto radius		= vk2d::_internal::mip::GetFilterRadius( filter ) * std::max( scale, 1.0f );
+
+	std::vector<int64_t> raw_first( destination_size );
+	std::vector<int64_t> raw_last( destination_size );
+	for( uint32_t d = 0; d < destination_size; ++d ) {
+		auto center		= ( float( d ) + 0.5f ) * scale;
+		raw_first[ d ]	= int64_t( std::floor( center - radius ) );
+		raw_last[ d ]	= int64_t( std::ceil( center + radius ) );
+		taps.tap_count	= std::max( taps.tap_count, uint32_t( raw_last[ d ] - raw_first[ d ] + 1 ) );
+	}
+	taps.tap_count	= std::min( taps.tap_count, source_size );
+	taps.first.resize( destination_size );
+	taps.weights.resize( size_t( destination_size ) * taps.tap_count );
+
+	// Taps outside the image are folded onto the edge texel. Folded taps always
+	// fit in the tap window since it is moved to stay inside the image.
+	for( uint32_t d = 0; d < destination_size; ++d ) {
+		auto center		= ( float( d ) + 0.5f ) * scale;
+		auto first		= std::min( std::max( raw_first[ d ], int64_t( 0 ) ), int64_t( source_size - taps.tap_count ) );
+		auto weights	= taps.weights.data() + size_t( d ) * taps.tap_count;
+		taps.first[ d ]	= uint32_t( first );
+
+		float sum = 0.0f;
+		for( auto s = raw_first[ d ]; s <= raw_last[ d ]; ++s ) {
+			auto w = vk2d::_internal::mip::EvaluateFilter( filter, ( float( s ) + 0.5f - center ) / std::max( scale, 1.0f ) );
+			if( w == 0.0f ) continue;
+			auto clamped = std::min( std::max( s, int64_t( 0 ) ), int64_t( source_size ) - 1 );
+			weights[ clamped - first ]	+= w;
+			sum							+= w;
+		}
+		if( sum != 0.0f ) {
+			for( uint32_t t = 0; t < taps.tap_count; ++t ) weights[ t ] /= sum;
+		} else {
+			auto nearest = std::min( int64_t( center ), int64_t( source_size ) - 1 );
+			weights[ nearest - first ] = 1.0f;
+		}
+	}
+	return taps;
+}
+
+inline const vk2d::_internal::mip::ColorTables & GetColorTables(
+	bool											gamma_correct )
+{
+	static const auto tables = []()
+	{
+		std::vector<vk2d::_internal::mip::ColorTables> t( 2 );
+		for( uint32_t i = 0; i < 256; ++i ) {
+			auto c = float( i ) / 255.0f;
+			t[ 0 ].decode[ i ] = c;
+			t[ 1 ].decode[ i ] = c <= 0.04045f ? c / 12.92f : std::pow( ( c + 0.055f ) / 1.055f, 2.4f );
+		}
+		for( uint32_t i = 0; i < MIP_SRGB_ENCODE_TABLE_SIZE; ++i ) {
+			auto l = float( i ) / float( MIP_SRGB_ENCODE_TABLE_SIZE - 1 );
+			auto s = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow( l, 1.0f / 2.4f ) - 0.055f;
+			t[ 0 ].encode[ i ] = uint8_t( l * 255.0f + 0.5f );
+			t[ 1 ].encode[ i ] = uint8_t( std::min( std::max( s, 0.0f ), 1.0f ) * 255.0f + 0.5f );
+		}
+		return t;
+	}();
+	return tables[ gamma_correct ? 1 : 0 ];
+}
+
+// RGBA8 row to premultiplied linear floats.
+inline void DecodeRow(
+	const uint8_t								*	texels,
+	uint32_t										width,
+	const vk2d::_internal::mip::ColorTables		&	tables,
+	float										*	out_row )
+{
+	for( uint32_t x = 0; x < width; ++x ) {
+		auto alpha			= float( texels[ x * 4 + 3 ] ) * ( 1.0f / 255.0f );
+		out_row[ x * 4 + 0 ]	= tables.decode[ texels[ x * 4 + 0 ] ] * alpha;
+		out_row[ x * 4 + 1 ]	= tables.decode[ texels[ x * 4 + 1 ] ] * alpha;
+		out_row[ x * 4 + 2 ]	= tables.decode[ texels[ x * 4 + 2 ] ] * alpha;
+		out_row[ x * 4 + 3 ]	= alpha;
+	}
+}
+
+// Premultiplied linear floats, already clamped, to RGBA8.
+inline void EncodeTexels(
+	const float									*	texels,
+	size_t											texel_count,
+	const vk2d::_internal::mip::ColorTables		&	tables,
+	uint8_t										*	out_texels )
+{
+	constexpr float table_scale = float( MIP_SRGB_ENCODE_TABLE_SIZE - 1 );
+	for( size_t i = 0; i < texel_count; ++i ) {
+		auto texel			= texels + i * 4;
+		auto alpha			= texel[ 3 ];
+		auto unpremultiply	= alpha > 0.0f ? table_scale / alpha : 0.0f;
+		for( int c = 0; c < 3; ++c ) {
+			auto index = uint32_t( std::min( texel[ c ] * unpremultiply + 0.5f, table_scale ) );
+			out_texels[ i * 4 + c ] = tables.encode[ index ];
+		}
+		out_texels[ i * 4 + 3 ] = uint8_t( alpha * 255.0f + 0.5f );
+	}
+}
+
+inline void ResampleRow(
+	const float									*	source_row,
+	const vk2d::_internal::mip::FilterTaps		&	taps,
+	uint32_t										destination_width,
+	float										*	out_row )
+{
+	for( uint32_t d = 0; d < destination_width; ++d ) {
+		auto source		= source_row + size_t( taps.first[ d ] ) * 4;
+		auto weights	= taps.weights.data() + size_t( d ) * taps.tap_count;
+		auto sum		= vk2d::_internal::mip::Splat( 0.0f );
+		for( uint32_t t = 0; t < taps.tap_count; ++t ) {
+			sum = vk2d::_internal::mip::MultiplyAdd( sum, vk2d::_internal::mip::Load( source + t * 4 ), vk2d::_internal::mip::Splat( weights[ t ] ) );
+		}
+		vk2d::_internal::mip::Store( out_row + size_t( d ) * 4, sum );
+	}
+}
+
+// Resamples source_width * source_height premultiplied float texels to
+// destination_width * destination_height, clamped. GetSourceRow( y ) returns
+// a pointer to source row y, rows are requested in increasing order.
+template<typename GetSourceRowFunction>
+void ResampleImage(
+	vk2d::TextureMipFilter							filter,
+	uint32_t										source_width,
+	uint32_t										source_height,
+	uint32_t										destination_width,
+	uint32_t										destination_height,
+	GetSourceRowFunction							GetSourceRow,
+	std::vector<float>							&	out_texels )
+{
+	auto row_taps		= vk2d::_internal::mip::ComputeFilterTaps( filter, source_width, destination_width );
+	auto column_taps	= vk2d::_internal::mip::ComputeFilterTaps( filter, source_height, destination_height );
+	auto row_size		= size_t( destination_width ) * 4;
+
+	// Rows resampled horizontally so far, source row y is in slot y % tap_count.
+	// Column tap windows only move down so every row is resampled once.
+	std::vector<float> ring( row_size * column_taps.tap_count );
+	std::vector<int64_t> ring_rows( column_taps.tap_count, -1 );
+
+	out_texels.resize( row_size * destination_height );
+	for( uint32_t y = 0; y < destination_height; ++y ) {
+		auto weights = column_taps.weights.data() + size_t( y ) * column_taps.tap_count;
+		auto out_row = out_texels.data() + row_size * y;
+		std::fill( out_row, out_row + row_size, 0.0f );
+
+		for( uint32_t t = 0; t < column_taps.tap_count; ++t ) {
+			auto source_y	= column_taps.first[ y ] + t;
+			auto slot		= source_y % column_taps.tap_count;
+			auto ring_row	= ring.data() + row_size * slot;
+			if( ring_rows[ slot ] != int64_t( source_y ) ) {
+				vk2d::_internal::mip::ResampleRow( GetSourceRow( source_y ), row_taps, destination_width, ring_row );
+				ring_rows[ slot ] = source_y;
+			}
+			if( weights[ t ] == 0.0f ) continue;
+
+			auto weight = vk2d::_internal::mip::Splat( weights[ t ] );
+			for( size_t x = 0; x < row_size; x += 4 ) {
+				vk2d::_internal::mip::Store( out_row + x, vk2d::_internal::mip::MultiplyAdd(
+					vk2d::_internal::mip::Load( out_row + x ), vk2d::_internal::mip::Load( ring_row + x ), weight ) );
+			}
+		}
+		for( size_t x = 0; x < row_size; x += 4 ) {
+			vk2d::_internal::mip::Store( out_row + x, vk2d::_internal::mip::ClampPremultiplied( vk2d::_internal::mip::Load( out_row + x ) ) );
+		}
+	}
+}
+
+inline void WriteLittleEndian(
+	std::vector<uint8_t>						&	data,
+	uint64_t										value,
+	size_t											byte_count )
+{
+	for( size_t i = 0; i < byte_count; ++i ) data.push_back( uint8_t( value >> ( i * 8 ) ) );
+}
+
+inline uint64_t ReadLittleEndian(
+	const uint8_t								*	data,
+	size_t											byte_count )
+{
+	uint64_t value = 0;
+	for( size_t i = 0; i < byte_count; ++i ) value |= uint64_t( data[ i ] ) << ( i * 8 );
+	return value;
+}
+
+} // mip
+
+
+
+// Mip level count of a complete mip chain, including level 0.
+inline uint32_t GetCompleteMipLevelCount(
+	uint32_t										width,
+	uint32_t										height )
+{
+	uint32_t count = 1;
+	for( auto size = std::max( width, height ); size > 1; size >>= 1 ) ++count;
+	return count;
+}
+
+// Makes mip levels 1 and up from tightly packed RGBA8 texels of level 0,
+// level i is max( width >> i, 1 ) * max( height >> i, 1 ) texels. Returns
+// false if there is nothing to filter with or the image is empty.
+inline bool GenerateMipLevels(
+	const uint8_t								*	texels,
+	uint32_t										width,
+	uint32_t										height,
+	vk2d::TextureMipFilter							filter,
+	bool											gamma_correct,
+	std::vector<std::vector<uint8_t>>			&	out_mip_levels )
+{
+	out_mip_levels.clear();
+	if( !texels || !width || !height || filter == vk2d::TextureMipFilter::GPU_LINEAR ) return false;
+
+	auto & tables		= vk2d::_internal::mip::GetColorTables( gamma_correct );
+	auto level_count	= vk2d::_internal::GetCompleteMipLevelCount( width, height );
+	out_mip_levels.resize( level_count - 1 );
+
+	// Level 0 is converted to floats a row at a time as the resampler asks for it.
+	std::vector<float> decoded_row( size_t( width ) * 4 );
+	auto GetLevel0Row = [ & ]( uint32_t y ) -> const float*
+	{
+		vk2d::_internal::mip::DecodeRow( texels + size_t( y ) * width * 4, width, tables, decoded_row.data() );
+		return decoded_row.data();
+	};
+
+	std::vector<float> previous_level;
+	std::vector<float> current_level;
+	uint32_t previous_width		= width;
+	uint32_t previous_height	= height;
+	for( uint32_t level = 1; level < level_count; ++level ) {
+		auto level_width	= std::max( width >> level, 1U );
+		auto level_height	= std::max( height >> level, 1U );
+		if( level == 1 ) {
+			vk2d::_internal::mip::ResampleImage( filter, width, height, level_width, level_height, GetLevel0Row, current_level );
+		} else {
+			auto GetPreviousLevelRow = [ & ]( uint32_t y ) -> const float*
+			{
+				return previous_level.data() + size_t( y ) * previous_width * 4;
+			};
+			vk2d::_internal::mip::ResampleImage( filter, previous_width, previous_height, level_width, level_height, GetPreviousLevelRow, current_level );
+		}
+
+		auto & mip_level = out_mip_levels[ level - 1 ];
+		mip_level.resize( size_t( level_width ) * level_height * 4 );
+		vk2d::_internal::mip::EncodeTexels( current_level.data(), size_t( level_width ) * level_height, tables, mip_level.data() );
+
+		std::swap( previous_level, current_level );
+		previous_width	= level_width;
+		previous_height	= level_height;
+	}
+	return true;
+}
+
+// Where the mip levels of an image file are cached. Without a cache directory
+// the cache file is next to the image, in a cache directory it is named by
+// the image contents so images with the same name do not collide.
+inline std::filesystem::path GetMipCachePath(
+	const std::filesystem::path					&	source_path,
+	const std::filesystem::path					&	cache_directory,
+	uint64_t										source_hash )
+{
+	if( cache_directory.empty() ) {
+		auto path = source_path;
+		path += ".vk2dmips";
+		return path;
+	}
+	char name[ 32 ] {};
+	std::snprintf( name, sizeof( name ), "%016llx.vk2dmips", static_cast<unsigned long long>( source_hash ) );
+	return cache_directory / name;
+}
+
+// Serializes mip levels 1 and up, see GenerateMipLevels().
+//
+// Layout, little endian:
+// 0   8 bytes magic "VK2DMIPS"
+// 8   uint32_t version
+// 12  uint32_t filter, vk2d::TextureMipFilter
+// 16  uint32_t flags, bit 0 gamma correct
+// 20  uint32_t width of level 0
+// 24  uint32_t height of level 0
+// 28  uint32_t stored mip level count, level 0 is not stored
+// 32  uint64_t encoded image file size
+// 40  uint64_t encoded image file hash
+// 48  RGBA8 texels of level 1, then level 2 and so on
+inline std::vector<uint8_t> EncodeMipCache(
+	const vk2d::_internal::MipCacheKey			&	key,
+	const std::vector<std::vector<uint8_t>>		&	mip_levels )
+{
+	std::vector<uint8_t> data( std::begin( MIP_CACHE_MAGIC ), std::end( MIP_CACHE_MAGIC ) );
+	vk2d::_internal::mip::WriteLittleEndian( data, MIP_CACHE_VERSION, 4 );
+	vk2d::_internal::mip::WriteLittleEndian( data, uint32_t( key.filter ), 4 );
+	vk2d::_internal::mip::WriteLittleEndian( data, key.gamma_correct ? 1 : 0, 4 );
+	vk2d::_internal::mip::WriteLittleEndian( data, key.width, 4 );
+	vk2d::_internal::mip::WriteLittleEndian( data, key.height, 4 );
+	vk2d::_internal::mip::WriteLittleEndian( data, mip_levels.size(), 4 );
+	vk2d::_internal::mip::WriteLittleEndian( data, key.source_size, 8 );
+	vk2d::_internal::mip::WriteLittleEndian( data, key.source_hash, 8 );
+	for( auto & l : mip_levels ) {
+		data.insert( data.end(), l.begin(), l.end() );
+	}
+	return data;
+}
+
+// Returns false if the data is not a mip cache made with the same key.
+inline bool DecodeMipCache(
+	const void									*	data,
+	size_t											size,
+	const vk2d::_internal::MipCacheKey			&	key,
+	std::vector<std::vector<uint8_t>>			&	out_mip_levels )
+{
+	out_mip_levels.clear();
+	auto bytes = static_cast<const uint8_t*>( data );
+	if( !bytes || size < MIP_CACHE_HEADER_SIZE ) return false;
+	if( std::memcmp( bytes, MIP_CACHE_MAGIC, sizeof( MIP_CACHE_MAGIC ) ) != 0 ) return false;
+
+	auto level_count = vk2d::_internal::GetCompleteMipLevelCount( key.width, key.height );
+	if( vk2d::_internal::mip::ReadLittleEndian( bytes + 8, 4 ) != MIP_CACHE_VERSION ||
+		vk2d::_internal::mip::ReadLittleEndian( bytes + 12, 4 ) != uint32_t( key.filter ) ||
+		vk2d::_internal::mip::ReadLittleEndian( bytes + 16, 4 ) != ( key.gamma_correct ? 1u : 0u ) ||
+		vk2d::_internal::mip::ReadLittleEndian( bytes + 20, 4 ) != key.width ||
+		vk2d::_internal::mip::ReadLittleEndian( bytes + 24, 4 ) != key.height ||
+		vk2d::_internal::mip::ReadLittleEndian( bytes + 28, 4 ) != level_count - 1 ||
+		vk2d::_internal::mip::ReadLittleEndian( bytes + 32, 8 ) != key.source_size ||
+		vk2d::_internal::mip::ReadLittleEndian( bytes + 40, 8 ) != key.source_hash ) {
+		return false;
+	}
+
+	size_t expected_size = MIP_CACHE_HEADER_SIZE;
+	for( uint32_t level = 1; level < level_count; ++level ) {
+		expected_size += size_t( std::max( key.width >> level, 1U ) ) * std::max( key.height >> level, 1U ) * 4;
+	}
+	if( size != expected_size ) return false;
+
+	out_mip_levels.resize( level_count - 1 );
+	auto level_data = bytes + MIP_CACHE_HEADER_SIZE;
+	for( uint32_t level = 1; level < level_count; ++level ) {
+		auto level_size = size_t( std::max( key.width >> level, 1U ) ) * std::max( key.height >> level, 1U ) * 4;
+		out_mip_levels[ level - 1 ].assign( level_data, level_data + level_size );
+		level_data += level_size;
+	}
+	return true;
+}
+
+inline bool ReadMipCacheFile(
+	const std::filesystem::path					&	path,
+	const vk2d::_internal::MipCacheKey			&	key,
+	std::vector<std::vector<uint8_t>>			&	out_mip_levels )
+{
+	std::ifstream file( path, std::ios::binary | std::ios::ate );
+	if( !file ) return false;
+	std::vector<uint8_t> data( size_t( file.tellg() ) );
+	file.seekg( 0 );
+	if( !file.read( reinterpret_cast<char*>( data.data() ), std::streamsize( data.size() ) ) ) return false;
+	return vk2d::_internal::DecodeMipCache( data.data(), data.size(), key, out_mip_levels );
+}
+
+// File is written under a temporary name first so other loads never see it
+// half written. Returns false if the file could not be written.
+inline bool WriteMipCacheFile(
+	const std::filesystem::path					&	path,
+	const vk2d::_internal::MipCacheKey			&	key,
+	const std::vector<std::vector<uint8_t>>		&	mip_levels )
+{
+	std::error_code error;
+	if( path.has_parent_path() ) {
+		std::filesystem::create_directories( path.parent_path(), error );
+	}
+
+	auto temporary_path = path;
+	temporary_path += "." + std::to_string( std::hash<std::thread::id>()( std::this_thread::get_id() ) ) + ".tmp";
+	{
+		auto data = vk2d::_internal::EncodeMipCache( key, mip_levels );
+		std::ofstream file( temporary_path, std::ios::binary | std::ios::trunc );
+		if( !file ) return false;
+		file.write( reinterpret_cast<const char*>( data.data() ), std::streamsize( data.size() ) );
+		if( !file ) {
+			file.close();
+			std::filesystem::remove( temporary_path, error );
+			return false;
+		}
+	}
+	std::filesystem::rename( temporary_path, path, error );
+	if( error ) {
+		std::filesystem::remove( temporary_path, error );
+		return false;
+	}
+	return true;
+}
+
+
+
+} // _internal
+} // vk2d
@@ -0,0 +1,323 @@
+#pragma once
+
+// Only depends on the standard library so tests and tools can use this too.
+#include "Core/Common.h"
+
+#include <cstring>
+#include <vector>
+
+
+
+namespace vk2d {
+namespace _internal {
+
+
+
+// QOI, "Quite OK Image format", lossless RGB and RGBA images that decode and
+// encode many times faster than PNG while compressing nearly as well. See
+// https://qoiformat.org/qoi-specification.pdf for the format.
+//
+// Images are always decoded to RGBA8 texels. Colorspace is stored but
+// ignored like with every other image format in VK2D.
+
+constexpr uint8_t		QOI_MAGIC[ 4 ]					= { 'q', 'o', 'i', 'f' };
+constexpr uint8_t		QOI_END_MARKER[ 8 ]				= { 0, 0, 0, 0, 0, 0, 0, 1 };
+constexpr size_t		QOI_HEADER_SIZE					= 14;
+constexpr uint64_t		QOI_MAX_TEXEL_COUNT				= 400'000'000;	// Same limit as the reference implementation.
+
+struct QOIHeader {
+	uint32_t										width					= {};
+	uint32_t										height					= {};
+	uint8_t											channels				= {};	// 3 or 4.
+	uint8_t											colorspace				= {};	// 0 sRGB with linear alpha, 1 all linear.
+};
+
+
+
+namespace qoi {
+
+constexpr uint8_t		OP_INDEX			= 0x00;
+constexpr uint8_t		OP_DIFF				= 0x40;
+constexpr uint8_t		OP_LUMA				= 0x80;
+constexpr uint8_t		OP_RUN				= 0xC0;
+constexpr uint8_t		OP_RGB				= 0xFE;
+constexpr uint8_t		OP_RGBA				= 0xFF;
+constexpr uint8_t		OP_MASK				= 0xC0;
+constexpr uint32_t		MAX_RUN				= 62;
+
+struct Texel {
+	uint8_t											r						= {};
+	uint8_t											g						= {};
+	uint8_t											b						= {};
+	uint8_t											a						= {};
+};
+static_assert( sizeof( Texel ) == 4, "QOI texel must be tightly packed." );
+
+inline uint32_t GetHashIndex(
+	vk2d::_internal::qoi::Texel					texel )
+{
+	return ( uint32_t( texel.r ) * 3 + uint32_t( texel.g ) * 5 + uint32_t( texel.b ) * 7 + uint32_t( texel.a ) * 11 ) % 64;
+}
+
+// Texels compared as a single value.
+inline bool IsEqual(
+	vk2d::_internal::qoi::Texel					a,
+	vk2d::_internal::qoi::Texel					b )
+{
+	uint32_t av;
+	uint32_t bv;
+	std::memcpy( &av, &a, sizeof( av ) );
+	std::memcpy( &bv, &b, sizeof( bv ) );
+	return av == bv;
+}
+
+inline uint32_t ReadBigEndian32(
+	const uint8_t								*	data )
+{
+	return uint32_t( data[ 0 ] ) << 24 | uint32_t( data[ 1 ] ) << 16 | uint32_t( data[ 2 ] ) << 8 | uint32_t( data[ 3 ] );
+}
+
+inline uint8_t * WriteBigEndian32(
+	uint8_t										*	data,
+	uint32_t										value )
+{
+	data[ 0 ]	= uint8_t( value >> 24 );
+	data[ 1 ]	= uint8_t( value >> 16 );
+	data[ 2 ]	= uint8_t( value >> 8 );
+	data[ 3 ]	= uint8_t( value );
+	return data + 4;
+}
+
+} // qoi
+
+
+
+inline bool IsQOIImage(
+	const void									*	data,
+	size_t											size )
+{
+	return data && size >= sizeof( vk2d::_internal::QOI_MAGIC ) &&
+		std::memcmp( data, vk2d::_internal::QOI_MAGIC, sizeof( vk2d::_internal::QOI_MAGIC ) ) == 0;
+}
+
+// Returns false if the header is invalid or the image is too large.
+inline bool ReadQOIHeader(
+	const void									*	data,
+	size_t											size,
+	vk2d::_internal::QOIHeader					&	out_header )
+{
+	if( !vk2d::_internal::IsQOIImage( data, size ) ) return false;
+	if( size < vk2d::_internal::QOI_HEADER_SIZE + sizeof( vk2d::_internal::QOI_END_MARKER ) ) return false;
+
+	auto bytes				= static_cast<const uint8_t*>( data );
+	out_header.width		= vk2d::_internal::qoi::ReadBigEndian32( bytes + 4 );
+	out_header.height		= vk2d::_internal::qoi::ReadBigEndian32( bytes + 8 );
+	out_header.channels		= bytes[ 12 ];
+	out_header.colorspace	= bytes[ 13 ];
+
+	if( !out_header.width || !out_header.height ) return false;
+	if( out_header.channels != 3 && out_header.channels != 4 ) return false;
+	if( out_header.colorspace > 1 ) return false;
+	if( uint64_t( out_header.width ) * uint64_t( out_header.height ) > vk2d::_internal::QOI_MAX_TEXEL_COUNT ) return false;
+	return true;
+}
+
+// Decodes to tightly packed RGBA8 texels, out_texels must have room for
+// width * height * 4 bytes, see ReadQOIHeader(). Returns false if the image
+// is invalid or ends before every texel has been decoded.
+inline bool DecodeQOI(
+	const void									*	data,
+	size_t											size,
+	uint8_t										*	out_texels,
+	size_t											out_texels_size )
+{
+	vk2d::_internal::QOIHeader header {};
+	if( !vk2d::_internal::ReadQOIHeader( data, size, header ) ) return false;
+
+	auto texel_count = size_t( header.width ) * size_t( header.height );
+	if( out_texels_size < texel_count * 4 ) return false;
+
+	// Chunks are at most 5 bytes and the end marker is 8, any chunk that starts
+	// before the end marker can be read without checking the size again.
+	auto bytes			= static_cast<const uint8_t*>( data );
+	auto chunk			= bytes + vk2d::_internal::QOI_HEADER_SIZE;
+	auto chunks_end		= bytes + size - sizeof( vk2d::_internal::QOI_END_MARKER );
+	auto out			= out_texels;
+	auto out_end		= out_texels + texel_count * 4;
+
+	vk2d::_internal::qoi::Texel index[ 64 ] {};
+	vk2d::_internal::qoi::Texel texel { 0, 0, 0, 255 };
+
+	while( out < out_end ) {
+		if( chunk >= chunks_end ) return false;
+
+		auto b1 = *chunk++;
+		if( b1 == vk2d::_internal::qoi::OP_RGB ) {
+			texel.r		= chunk[ 0 ];
+			texel.g		= chunk[ 1 ];
+			texel.b		= chunk[ 2 ];
+			chunk		+= 3;
+		} else if( b1 == vk2d::_internal::qoi::OP_RGBA ) {
+			texel.r		= chunk[ 0 ];
+			texel.g		= chunk[ 1 ];
+			texel.b		= chunk[ 2 ];
+			texel.a		= chunk[ 3 ];
+			chunk		+= 4;
+		} else {
+			switch( b1 & vk2d::_internal::qoi::OP_MASK ) {
+				case vk2d::_internal::qoi::OP_INDEX:
+					texel		= index[ b1 ];
+					break;
+				case vk2d::_internal::qoi::OP_DIFF:
+					texel.r		+= uint8_t( ( ( b1 >> 4 ) & 0x03 ) - 2 );
+					texel.g		+= uint8_t( ( ( b1 >> 2 ) & 0x03 ) - 2 );
+					texel.b		+= uint8_t( ( b1 & 0x03 ) - 2 );
+					break;
+				case vk2d::_internal::qoi::OP_LUMA:
+				{
+					auto b2		= *chunk++;
+					auto vg		= int( b1 & 0x3F ) - 32;
+					texel.r		+= uint8_t( vg - 8 + ( ( b2 >> 4 ) & 0x0F ) );
+					texel.g		+= uint8_t( vg );
+					texel.b		+= uint8_t( vg - 8 + ( b2 & 0x0F ) );
+					break;
+				}
+				default:
+				{
+					// Run of the previous texel, which is already in the index
+					// except for a run at the very beginning of the image.
+					auto run = size_t( b1 & 0x3F ) + 1;
+					if( run > size_t( out_end - out ) / 4 ) return false;
+					index[ vk2d::_internal::qoi::GetHashIndex( texel ) ] = texel;
+					for( size_t i = 0; i < run; ++i ) {
+						std::memcpy( out, &texel, 4 );
+						out		+= 4;
+					}
+					continue;
+				}
+			}
+		}
+		index[ vk2d::_internal::qoi::GetHashIndex( texel ) ] = texel;
+		std::memcpy( out, &texel, 4 );
+		out		+= 4;
+	}
+	return true;
+}
+
+inline bool DecodeQOI(
+	const void									*	data,
+	size_t											size,
+	std::vector<uint8_t>						&	out_texels,
+	uint32_t									&	out_width,
+	uint32_t									&	out_height )
+{
+	vk2d::_internal::QOIHeader header {};
+	if( !vk2d::_internal::ReadQOIHeader( data, size, header ) ) return false;
+
+	out_texels.resize( size_t( header.width ) * size_t( header.height ) * 4 );
+	if( !vk2d::_internal::DecodeQOI( data, size, out_texels.data(), out_texels.size() ) ) {
+		out_texels.clear();
+		return false;
+	}
+	out_width		= header.width;
+	out_height		= header.height;
+	return true;
+}
+
+// Encodes tightly packed RGB8 or RGBA8 texels, channels is 3 or 4.
+inline bool EncodeQOI(
+	const uint8_t								*	texels,
+	uint32_t										width,
+	uint32_t										height,
+	uint32_t										channels,
+	std::vector<uint8_t>						&	out_data )
+{
+	if( !texels || !width || !height ) return false;
+	if( channels != 3 && channels != 4 ) return false;
+	auto texel_count = uint64_t( width ) * uint64_t( height );
+	if( texel_count > vk2d::_internal::QOI_MAX_TEXEL_COUNT ) return false;
+
+	// Worst case every texel is a full RGBA or RGB chunk, output is written
+	// through a pointer and trimmed at the end.
+	out_data.resize( vk2d::_internal::QOI_HEADER_SIZE + size_t( texel_count ) * ( channels + 1 ) + sizeof( vk2d::_internal::QOI_END_MARKER ) );
+	auto out = out_data.data();
+
+	std::memcpy( out, vk2d::_internal::QOI_MAGIC, sizeof( vk2d::_internal::QOI_MAGIC ) );
+	out		= vk2d::_internal::qoi::WriteBigEndian32( out + 4, width );
+	out		= vk2d::_internal::qoi::WriteBigEndian32( out, height );
+	*out++	= uint8_t( channels );
+	*out++	= 0;
+
+	vk2d::_internal::qoi::Texel index[ 64 ] {};
+	vk2d::_internal::qoi::Texel previous { 0, 0, 0, 255 };
+	vk2d::_internal::qoi::Texel texel = previous;
+	uint32_t run = 0;
+
+	auto in			= texels;
+	auto in_end		= texels + size_t( texel_count ) * channels;
+	while( in < in_end ) {
+		texel.r		= in[ 0 ];
+		texel.g		= in[ 1 ];
+		texel.b		= in[ 2 ];
+		if( channels == 4 ) texel.a = in[ 3 ];
+		in			+= channels;
+
+		if( vk2d::_internal::qoi::IsEqual( texel, previous ) ) {
+			++run;
+			if( run == vk2d::_internal::qoi::MAX_RUN || in == in_end ) {
+				*out++	= uint8_t( vk2d::_internal::qoi::OP_RUN | ( run - 1 ) );
+				run		= 0;
+			}
+			continue;
+		}
+
+		if( run ) {
+			*out++	= uint8_t( vk2d::_internal::qoi::OP_RUN | ( run - 1 ) );
+			run		= 0;
+		}
+
+		auto hash_index = vk2d::_internal::qoi::GetHashIndex( texel );
+		if( vk2d::_internal::qoi::IsEqual( index[ hash_index ], texel ) ) {
+			*out++	= uint8_t( vk2d::_internal::qoi::OP_INDEX | hash_index );
+		} else {
+			index[ hash_index ] = texel;
+
+			if( texel.a == previous.a ) {
+				auto vr		= int8_t( texel.r - previous.r );
+				auto vg		= int8_t( texel.g - previous.g );
+				auto vb		= int8_t( texel.b - previous.b );
+				auto vg_r	= vr - vg;
+				auto vg_b	= vb - vg;
+
+				if( vr >= -2 && vr <= 1 && vg >= -2 && vg <= 1 && vb >= -2 && vb <= 1 ) {
+					*out++	= uint8_t( vk2d::_internal::qoi::OP_DIFF | ( vr + 2 ) << 4 | ( vg + 2 ) << 2 | ( vb + 2 ) );
+				} else if( vg_r >= -8 && vg_r <= 7 && vg >= -32 && vg <= 31 && vg_b >= -8 && vg_b <= 7 ) {
+					*out++	= uint8_t( vk2d::_internal::qoi::OP_LUMA | ( vg + 32 ) );
+					*out++	= uint8_t( ( vg_r + 8 ) << 4 | ( vg_b + 8 ) );
+				} else {
+					*out++	= vk2d::_internal::qoi::OP_RGB;
+					*out++	= texel.r;
+					*out++	= texel.g;
+					*out++	= texel.b;
+				}
+			} else {
+				*out++	= vk2d::_internal::qoi::OP_RGBA;
+				*out++	= texel.r;
+				*out++	= texel.g;
+				*out++	= texel.b;
+				*out++	= texel.a;
+			}
+		}
+		previous = texel;
+	}
+
+	std::memcpy( out, vk2d::_internal::QOI_END_MARKER, sizeof( vk2d::_internal::QOI_END_MARKER ) );
+	out		+= sizeof( vk2d::_internal::QOI_END_MARKER );
+	out_data.resize( size_t( out - out_data.data() ) );
+	return true;
+}
+
+
+
+} // _internal
+} // vk2d
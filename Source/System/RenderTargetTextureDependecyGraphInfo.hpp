@@ -19,14 +19,6 @@ class RenderTargetTextureImpl;
 
 
 
-struct TimedDescriptorPoolData
-{
-	vk2d::_internal::PoolDescriptorSet						descriptor_set								= {};
-	std::chrono::time_point<std::chrono::steady_clock>		previous_access_time						= {};	// For cleanup
-};
-
-
-
 struct RenderTargetTextureDependencyInfo
 {
 	vk2d::_internal::RenderTargetTextureImpl			*	render_target								= {};
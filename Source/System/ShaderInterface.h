@@ -37,6 +37,7 @@ struct GraphicsPrimaryRenderPushConstants {
 	alignas( 4 )	uint32_t					vertex_offset			= {};	// Offset to first vertex in vertex buffer.
 	alignas( 4 )	uint32_t					texture_channel_weight_offset	= {};	// Location of the texture channels in the texture channel weights ssbo.
 	alignas( 4 )	uint32_t					texture_channel_weight_count	= {};	// Just the amount of texture channels.
+	alignas( 4 )	uint32_t					texture_index			= {};	// Index into the texture array, always 0 if not bindless.
 };
 
 struct GraphicsBlurPushConstants
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "Core/SourceCommon.h"
+
+
+
+namespace vk2d {
+namespace _internal {
+
+
+
+// Handle to a slot map entry. Generation tells apart entries that occupied
+// the same slot at different times, a handle of a removed entry never finds
+// the entry that later reuses the slot.
+struct SlotMapHandle {
+	uint32_t											index						= UINT32_MAX;
+	uint32_t											generation					= {};
+
+	inline explicit										operator bool() const
+	{
+		return index != UINT32_MAX;
+	}
+};
+
+
+
+// Owns objects in fixed size pages of slots, objects never move and pages are
+// never released while the slot map exists. Insert and remove take a short lock
+// to pop or push the free list, both are O(1). Get() is lock free and O(1),
+// it's safe to call from any thread at any time, though the object itself
+// naturally is only safe to use as long as nobody removes it.
+template<typename T, uint32_t PageSize = 1024, uint32_t MaxPageCount = 4096>
+class SlotMap {
+	static_assert( PageSize && ( PageSize & ( PageSize - 1 ) ) == 0, "PageSize must be a power of two" );
+
+public:
+														SlotMap()						= default;
+														SlotMap( const SlotMap & )		= delete;
+	SlotMap											&	operator=( const SlotMap & )	= delete;
+
+														~SlotMap()
+	{
+		for( auto & p : owned_pages ) {
+			for( auto & s : p->slots ) {
+				delete s.value.load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	// Takes ownership of the object. Returns an invalid handle and leaves
+	// object untouched if the slot map is full.
+	vk2d::_internal::SlotMapHandle						Insert(
+		std::unique_ptr<T>							&&	object )
+	{
+		assert( object );
+
+		std::lock_guard<std::mutex> lock( mutex );
+
+		uint32_t index = free_head;
+		if( index == UINT32_MAX ) {
+			if( slot_count == PageSize * MaxPageCount ) return {};
+
+			if( slot_count % PageSize == 0 ) {
+				owned_pages.push_back( std::make_unique<Page>() );
+				pages[ slot_count / PageSize ].store( owned_pages.back().get(), std::memory_order_release );
+			}
+			index		= slot_count++;
+		} else {
+			free_head	= GetSlot( index ).next_free;
+		}
+
+		auto & slot = GetSlot( index );
+		slot.value.store( object.release(), std::memory_order_release );
+		++live_count;
+
+		vk2d::_internal::SlotMapHandle handle {};
+		handle.index			= index;
+		handle.generation		= slot.generation.load( std::memory_order_relaxed );
+		return handle;
+	}
+
+	// Gives ownership back to the caller. Returns nullptr if the handle is stale.
+	std::unique_ptr<T>									Remove(
+		vk2d::_internal::SlotMapHandle					handle )
+	{
+		if( !handle ) return {};
+
+		std::lock_guard<std::mutex> lock( mutex );
+
+		if( handle.index >= slot_count ) return {};
+
+		auto & slot = GetSlot( handle.index );
+		if( slot.generation.load( std::memory_order_relaxed ) != handle.generation ) return {};
+
+		auto object = slot.value.exchange( nullptr, std::memory_order_acq_rel );
+		if( !object ) return {};
+
+		// Generation changes before the slot is reused, stale handles stop matching here.
+		slot.generation.fetch_add( 1, std::memory_order_release );
+		slot.next_free		= free_head;
+		free_head			= handle.index;
+		--live_count;
+
+		return std::unique_ptr<T>( object );
+	}
+
+	// Lock free. Returns nullptr if the handle is stale.
+	T												*	Get(
+		vk2d::_internal::SlotMapHandle					handle ) const
+	{
+		if( !handle || handle.index / PageSize >= MaxPageCount ) return nullptr;
+
+		auto page = pages[ handle.index / PageSize ].load( std::memory_order_acquire );
+		if( !page ) return nullptr;
+
+		auto & slot = page->slots[ handle.index % PageSize ];
+
+		// Generation is checked on both sides of the read, if the slot was
+		// removed and reused in between we don't hand out the new object.
+		if( slot.generation.load( std::memory_order_acquire ) != handle.generation ) return nullptr;
+		auto object = slot.value.load( std::memory_order_acquire );
+		if( slot.generation.load( std::memory_order_acquire ) != handle.generation ) return nullptr;
+		return object;
+	}
+
+	// Calls function for every object, slot map is locked for the duration,
+	// function must not insert or remove.
+	template<typename FunctionT>
+	void												ForEach(
+		FunctionT									&&	function )
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+
+		for( uint32_t i = 0; i < slot_count; ++i ) {
+			auto object = GetSlot( i ).value.load( std::memory_order_relaxed );
+			if( object ) function( object );
+		}
+	}
+
+	// Removes every object and gives ownership back to the caller.
+	std::vector<std::unique_ptr<T>>						RemoveAll()
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+
+		std::vector<std::unique_ptr<T>> objects;
+		objects.reserve( live_count );
+		for( uint32_t i = 0; i < slot_count; ++i ) {
+			auto & slot = GetSlot( i );
+			auto object = slot.value.exchange( nullptr, std::memory_order_acq_rel );
+			if( !object ) continue;
+
+			slot.generation.fetch_add( 1, std::memory_order_release );
+			slot.next_free		= free_head;
+			free_head			= i;
+			objects.emplace_back( object );
+		}
+		live_count		= 0;
+		return objects;
+	}
+
+	size_t												Size() const
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		return live_count;
+	}
+
+private:
+	struct Slot {
+		std::atomic<uint32_t>							generation					= {};
+		std::atomic<T*>									value						= {};
+		uint32_t										next_free					= UINT32_MAX;	// Only valid while free, protected by mutex.
+	};
+
+	struct Page {
+		std::array<Slot, PageSize>						slots						= {};
+	};
+
+	Slot											&	GetSlot(
+		uint32_t										index )
+	{
+		return pages[ index / PageSize ].load( std::memory_order_relaxed )->slots[ index % PageSize ];
+	}
+
+	std::array<std::atomic<Page*>, MaxPageCount>		pages						= {};
+
+	mutable std::mutex									mutex;
+	std::vector<std::unique_ptr<Page>>					owned_pages					= {};
+	uint32_t											free_head					= UINT32_MAX;
+	uint32_t											slot_count					= {};
+	size_t												live_count					= {};
+};
+
+
+
+} // _internal
+} // vk2d
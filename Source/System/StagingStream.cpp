@@ -0,0 +1,349 @@
+
+#include "Core/SourceCommon.h"
+
+#include "System/StagingStream.h"
+
+#include "Interface/InstanceImpl.h"
+
+
+
+vk2d::_internal::StagingStream::StagingStream(
+	vk2d::_internal::InstanceImpl			*	instance,
+	vk2d::_internal::BufferSubAllocator		*	staging_allocator
+)
+{
+	assert( instance );
+	assert( staging_allocator );
+
+	this->instance				= instance;
+	this->device				= instance->GetVulkanDevice();
+	this->staging_allocator		= staging_allocator;
+
+	// Created signaled so every chunk can be waited the same way.
+	VkFenceCreateInfo fence_create_info {};
+	fence_create_info.sType		= VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+	fence_create_info.pNext		= nullptr;
+	fence_create_info.flags		= VK_FENCE_CREATE_SIGNALED_BIT;
+	for( auto & c : chunks ) {
+		auto result = vkCreateFence(
+			device,
+			&fence_create_info,
+			nullptr,
+			&c.fence
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot create staging stream fence!" );
+			return;
+		}
+	}
+
+	is_good						= true;
+}
+
+vk2d::_internal::StagingStream::~StagingStream()
+{
+	for( auto & c : chunks ) {
+		WaitChunk( c );
+		if( c.command_buffer ) {
+			vkFreeCommandBuffers(
+				device,
+				c.command_pool,
+				1, &c.command_buffer
+			);
+		}
+		staging_allocator->Free( c.staging_buffer );
+		vkDestroyFence(
+			device,
+			c.fence,
+			nullptr
+		);
+	}
+}
+
+bool vk2d::_internal::StagingStream::Begin(
+	vk2d::_internal::ResolvedQueue				queue,
+	VkCommandPool								command_pool,
+	VkImage										image,
+	const VkImageSubresourceRange			&	range
+)
+{
+	assert( !this->image );
+
+	this->queue						= queue;
+	this->command_pool				= command_pool;
+	this->image						= image;
+	this->range						= range;
+	is_range_transitioned			= false;
+	is_failed						= !is_good;
+	return !is_failed;
+}
+
+bool vk2d::_internal::StagingStream::Upload(
+	uint32_t									mip_level,
+	uint32_t									layer,
+	VkExtent2D									extent,
+	uint32_t									block_height,
+	const uint8_t							*	data,
+	VkDeviceSize								byte_size
+)
+{
+	assert( image );
+	assert( block_height );
+	if( is_failed ) return false;
+
+	auto row_count		= ( extent.height + block_height - 1 ) / block_height;
+	auto row_byte_size	= byte_size / row_count;
+	if( row_byte_size * row_count != byte_size || row_byte_size > VK2D_BUILD_OPTION_STAGING_STREAM_CHUNK_SIZE ) {
+		instance->Report( vk2d::ReportSeverity::NON_CRITICAL_ERROR, "Internal error: Cannot stream image, rows don't fit in staging stream chunks!" );
+		is_failed = true;
+		return false;
+	}
+
+	uint32_t row = 0;
+	while( row < row_count ) {
+		auto & chunk = chunks[ current_chunk ];
+		if( !chunk.is_recording ) {
+			if( !BeginChunk( chunk ) ) {
+				is_failed = true;
+				return false;
+			}
+		}
+
+		// Copy sources must be aligned to texel blocks, 16 fits every format we upload.
+		auto offset				= ( chunk.used_size + 15 ) & ~VkDeviceSize( 15 );
+		auto chunk_row_count	= uint32_t( std::min(
+			VkDeviceSize( row_count - row ),
+			( chunk.staging_buffer.size - std::min( offset, chunk.staging_buffer.size ) ) / row_byte_size
+		) );
+		if( !chunk_row_count ) {
+			if( !SubmitChunk( chunk ) ) {
+				is_failed = true;
+				return false;
+			}
+			current_chunk = ( current_chunk + 1 ) % uint32_t( chunks.size() );
+			continue;
+		}
+
+		std::memcpy(
+			chunk.staging_buffer.Get<uint8_t>() + offset,
+			data + VkDeviceSize( row ) * row_byte_size,
+			size_t( VkDeviceSize( chunk_row_count ) * row_byte_size )
+		);
+
+		auto image_y = row * block_height;
+		VkBufferImageCopy copy_region {};
+		copy_region.bufferOffset					= chunk.staging_buffer.offset + offset;
+		copy_region.bufferRowLength					= 0;
+		copy_region.bufferImageHeight				= 0;
+		copy_region.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+		copy_region.imageSubresource.mipLevel		= mip_level;
+		copy_region.imageSubresource.baseArrayLayer	= layer;
+		copy_region.imageSubresource.layerCount		= 1;
+		copy_region.imageOffset						= { 0, int32_t( image_y ), 0 };
+		copy_region.imageExtent						= { extent.width, std::min( chunk_row_count * block_height, extent.height - image_y ), 1 };
+		vkCmdCopyBufferToImage(
+			chunk.command_buffer,
+			chunk.staging_buffer.buffer,
+			image,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			1,
+			&copy_region
+		);
+
+		chunk.used_size		= offset + VkDeviceSize( chunk_row_count ) * row_byte_size;
+		row					+= chunk_row_count;
+	}
+	return true;
+}
+
+bool vk2d::_internal::StagingStream::End()
+{
+	assert( image );
+
+	// Image is in transfer destination layout afterwards even if nothing was uploaded.
+	if( !is_failed && !is_range_transitioned ) {
+		is_failed = !BeginChunk( chunks[ current_chunk ] );
+	}
+
+	auto & chunk = chunks[ current_chunk ];
+	if( chunk.is_recording ) {
+		if( is_failed ) {
+			vkEndCommandBuffer( chunk.command_buffer );
+			chunk.is_recording = false;
+		} else {
+			is_failed = !SubmitChunk( chunk );
+		}
+	}
+	current_chunk = ( current_chunk + 1 ) % uint32_t( chunks.size() );
+
+	for( auto & c : chunks ) {
+		if( !WaitChunk( c ) ) is_failed = true;
+	}
+
+	image		= VK_NULL_HANDLE;
+	return !is_failed;
+}
+
+bool vk2d::_internal::StagingStream::IsGood() const
+{
+	return is_good;
+}
+
+bool vk2d::_internal::StagingStream::BeginChunk(
+	Chunk									&	chunk
+)
+{
+	if( !WaitChunk( chunk ) ) return false;
+
+	if( !chunk.staging_buffer.buffer ) {
+		chunk.staging_buffer = staging_allocator->Allocate(
+			VK2D_BUILD_OPTION_STAGING_STREAM_CHUNK_SIZE
+		);
+		if( chunk.staging_buffer != VK_SUCCESS ) {
+			instance->Report( chunk.staging_buffer.result, "Internal error: Cannot create staging stream buffer!" );
+			chunk.staging_buffer = {};
+			return false;
+		}
+	}
+
+	// Command buffers are not reset in place, loader thread command pools don't allow it.
+	if( chunk.command_buffer ) {
+		vkFreeCommandBuffers(
+			device,
+			chunk.command_pool,
+			1, &chunk.command_buffer
+		);
+		chunk.command_buffer = VK_NULL_HANDLE;
+	}
+
+	VkCommandBufferAllocateInfo command_buffer_allocate_info {};
+	command_buffer_allocate_info.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	command_buffer_allocate_info.pNext					= nullptr;
+	command_buffer_allocate_info.commandPool			= command_pool;
+	command_buffer_allocate_info.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	command_buffer_allocate_info.commandBufferCount		= 1;
+	auto result = vkAllocateCommandBuffers(
+		device,
+		&command_buffer_allocate_info,
+		&chunk.command_buffer
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot allocate staging stream command buffer!" );
+		chunk.command_buffer = VK_NULL_HANDLE;
+		return false;
+	}
+	chunk.command_pool	= command_pool;
+	chunk.used_size		= 0;
+
+	VkCommandBufferBeginInfo command_buffer_begin_info {};
+	command_buffer_begin_info.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	command_buffer_begin_info.pNext				= nullptr;
+	command_buffer_begin_info.flags				= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	command_buffer_begin_info.pInheritanceInfo	= nullptr;
+	result = vkBeginCommandBuffer(
+		chunk.command_buffer,
+		&command_buffer_begin_info
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot begin staging stream command buffer!" );
+		return false;
+	}
+	chunk.is_recording	= true;
+
+	// Later chunks are submitted to the same queue, this barrier orders their copies too.
+	if( !is_range_transitioned ) {
+		VkImageMemoryBarrier image_memory_barrier {};
+		image_memory_barrier.sType						= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		image_memory_barrier.pNext						= nullptr;
+		image_memory_barrier.srcAccessMask				= 0;
+		image_memory_barrier.dstAccessMask				= VK_ACCESS_TRANSFER_WRITE_BIT;
+		image_memory_barrier.oldLayout					= VK_IMAGE_LAYOUT_UNDEFINED;
+		image_memory_barrier.newLayout					= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		image_memory_barrier.srcQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.dstQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.image						= image;
+		image_memory_barrier.subresourceRange			= range;
+		vkCmdPipelineBarrier(
+			chunk.command_buffer,
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			1, &image_memory_barrier
+		);
+		is_range_transitioned = true;
+	}
+	return true;
+}
+
+bool vk2d::_internal::StagingStream::SubmitChunk(
+	Chunk									&	chunk
+)
+{
+	assert( chunk.is_recording );
+
+	chunk.is_recording = false;
+	auto result = vkEndCommandBuffer( chunk.command_buffer );
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot record staging stream command buffer!" );
+		return false;
+	}
+
+	result = vkResetFences(
+		device,
+		1, &chunk.fence
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot reset staging stream fence!" );
+		return false;
+	}
+
+	VkSubmitInfo submit_info {};
+	submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submit_info.pNext					= nullptr;
+	submit_info.waitSemaphoreCount		= 0;
+	submit_info.pWaitSemaphores			= nullptr;
+	submit_info.pWaitDstStageMask		= nullptr;
+	submit_info.commandBufferCount		= 1;
+	submit_info.pCommandBuffers			= &chunk.command_buffer;
+	submit_info.signalSemaphoreCount	= 0;
+	submit_info.pSignalSemaphores		= nullptr;
+	result = queue.Submit(
+		submit_info,
+		chunk.fence
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot submit staging stream command buffer!" );
+		return false;
+	}
+	chunk.is_submitted = true;
+	return true;
+}
+
+bool vk2d::_internal::StagingStream::WaitChunk(
+	Chunk									&	chunk
+)
+{
+	if( !chunk.is_submitted ) return true;
+
+	auto result = vkWaitForFences(
+		device,
+		1, &chunk.fence,
+		VK_TRUE,
+		UINT64_MAX
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot wait for staging stream fence!" );
+		return false;
+	}
+	chunk.is_submitted = false;
+
+	vkFreeCommandBuffers(
+		device,
+		chunk.command_pool,
+		1, &chunk.command_buffer
+	);
+	chunk.command_buffer = VK_NULL_HANDLE;
+	return true;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Core/SourceCommon.h"
+
+#include "System/BufferSubAllocator.h"
+#include "System/QueueResolver.h"
+
+
+
+namespace vk2d {
+
+namespace _internal {
+
+class InstanceImpl;
+
+
+
+// Streams images that are too large for a staging buffer page into the GPU.
+// Staging memory is a small ring of chunks taken from the loader thread staging
+// sub allocator the first time anything is streamed and kept for as long as the
+// loader thread lives, so large images don't allocate staging memory of their
+// own. Rows of an image are copied to the current chunk, full chunks are
+// submitted with a fence of their own and refilled once the GPU has copied out
+// of them. Owned by a loader thread, only use from that thread.
+class StagingStream {
+public:
+																	StagingStream(
+		vk2d::_internal::InstanceImpl							*	instance,
+		vk2d::_internal::BufferSubAllocator						*	staging_allocator );
+
+																	~StagingStream();
+
+	// Starts streaming into an image. The first submission transitions every
+	// subresource in range from undefined to transfer destination layout.
+	// Command pool must belong to the queue family of queue, which should be
+	// the queue family that uses the image next.
+	bool															Begin(
+		vk2d::_internal::ResolvedQueue								queue,
+		VkCommandPool												command_pool,
+		VkImage														image,
+		const VkImageSubresourceRange							&	range );
+
+	// Copies texels of a single subresource, rows must be tightly packed.
+	// Block height is the amount of texel rows in a row of data, eg. 4 with
+	// block compressed formats and 1 with everything else.
+	bool															Upload(
+		uint32_t													mip_level,
+		uint32_t													layer,
+		VkExtent2D													extent,
+		uint32_t													block_height,
+		const uint8_t											*	data,
+		VkDeviceSize												byte_size );
+
+	// Submits what's left and waits until the GPU has copied everything. Image is
+	// left in transfer destination layout. Returns false if anything since
+	// Begin() failed, the image contents are undefined then.
+	bool															End();
+
+	bool															IsGood() const;
+
+private:
+	struct Chunk {
+		vk2d::_internal::BufferSubAllocation						staging_buffer						= {};
+		VkDeviceSize												used_size							= {};
+		VkCommandPool												command_pool						= {};
+		VkCommandBuffer												command_buffer						= {};
+		VkFence														fence								= {};
+		bool														is_recording						= {};
+		bool														is_submitted						= {};
+	};
+
+	// Waits until the GPU is done with a chunk and begins recording into it.
+	bool															BeginChunk(
+		Chunk													&	chunk );
+
+	bool															SubmitChunk(
+		Chunk													&	chunk );
+
+	// Waits for a submitted chunk and frees its command buffer.
+	bool															WaitChunk(
+		Chunk													&	chunk );
+
+	vk2d::_internal::InstanceImpl								*	instance							= {};
+	VkDevice														device								= {};
+	vk2d::_internal::BufferSubAllocator							*	staging_allocator					= {};
+
+	std::array<Chunk, VK2D_BUILD_OPTION_STAGING_STREAM_CHUNK_COUNT>	chunks								= {};
+	uint32_t														current_chunk						= {};
+
+	vk2d::_internal::ResolvedQueue									queue								= {};
+	VkCommandPool													command_pool						= {};
+	VkImage															image								= {};
+	VkImageSubresourceRange											range								= {};
+	bool															is_range_transitioned				= {};
+	bool															is_failed							= {};
+
+	bool															is_good								= {};
+};
+
+
+
+} // _internal
+
+} // vk2d
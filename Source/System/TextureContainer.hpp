@@ -0,0 +1,1039 @@
+#pragma once
+
+// Only depends on the standard library so tests can use this without a GPU.
+#include "Core/Common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+
+namespace vk2d {
+namespace _internal {
+
+
+
+// KTX2 and DDS texture containers. Containers store texels in the format they
+// are uploaded in, optionally block compressed, and may contain every mip
+// level and array layer of the texture so nothing has to be generated at load
+// time. Parsing does not copy anything, images point to the container data.
+//
+// Supported are 2D textures and 2D array textures in RGBA8, BGRA8 and BC1 to
+// BC7 formats. Cube maps, volume textures and supercompressed KTX2 files are
+// not. sRGB formats are treated as their UNORM counterparts like every other
+// texture in VK2D.
+//
+// Block compressed images can be decoded to RGBA8 on the CPU for devices
+// that can't sample block compressed formats, see DecodeTextureContainerImage().
+// Single and two channel formats decode the way the GPU samples them, BC4
+// into red and BC5 into red and green, HDR BC6H is clamped to 0 - 1.
+
+enum class TextureContainerFormat : uint32_t {
+	UNDEFINED			= 0,
+	R8G8B8A8_UNORM,
+	B8G8R8A8_UNORM,
+	BC1_RGB_UNORM,
+	BC1_RGBA_UNORM,
+	BC2_UNORM,
+	BC3_UNORM,
+	BC4_UNORM,
+	BC5_UNORM,
+	BC6H_UFLOAT,
+	BC6H_SFLOAT,
+	BC7_UNORM,
+};
+
+// One mip level of one array layer.
+struct TextureContainerImage {
+	const uint8_t								*	data					= {};
+	size_t											size					= {};
+	uint32_t										width					= {};
+	uint32_t										height					= {};
+};
+
+struct TextureContainer {
+	vk2d::_internal::TextureContainerFormat			format					= {};
+	uint32_t										width					= {};
+	uint32_t										height					= {};
+	uint32_t										layer_count				= {};
+	uint32_t										mip_level_count			= {};	// Mip levels stored in the container, at least 1.
+
+	// Level major, images[ mip_level * layer_count + layer ].
+	std::vector<vk2d::_internal::TextureContainerImage>		images			= {};
+};
+
+constexpr uint8_t		KTX2_IDENTIFIER[ 12 ]			= { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+constexpr uint8_t		DDS_MAGIC[ 4 ]					= { 'D', 'D', 'S', ' ' };
+
+
+
+// Bytes per 4 * 4 texel block, 0 if the format is not block compressed.
+inline uint32_t GetTextureContainerBlockSize(
+	vk2d::_internal::TextureContainerFormat			format )
+{
+	switch( format ) {
+		case vk2d::_internal::TextureContainerFormat::BC1_RGB_UNORM:
+		case vk2d::_internal::TextureContainerFormat::BC1_RGBA_UNORM:
+		case vk2d::_internal::TextureContainerFormat::BC4_UNORM:
+			return 8;
+		case vk2d::_internal::TextureContainerFormat::BC2_UNORM:
+		case vk2d::_internal::TextureContainerFormat::BC3_UNORM:
+		case vk2d::_internal::TextureContainerFormat::BC5_UNORM:
+		case vk2d::_internal::TextureContainerFormat::BC6H_UFLOAT:
+		case vk2d::_internal::TextureContainerFormat::BC6H_SFLOAT:
+		case vk2d::_internal::TextureContainerFormat::BC7_UNORM:
+			return 16;
+		default:
+			return 0;
+	}
+}
+
+// Size of one image in bytes, 0 if the format is unknown.
+inline uint64_t GetTextureContainerImageSize(
+	vk2d::_internal::TextureContainerFormat			format,
+	uint32_t										width,
+	uint32_t										height )
+{
+	if( format == vk2d::_internal::TextureContainerFormat::UNDEFINED ) return 0;
+
+	auto block_size = vk2d::_internal::GetTextureContainerBlockSize( format );
+	if( block_size ) {
+		return uint64_t( ( width + 3 ) / 4 ) * uint64_t( ( height + 3 ) / 4 ) * block_size;
+	}
+	return uint64_t( width ) * uint64_t( height ) * 4;
+}
+
+// Returns true if data starts like a KTX2 or DDS file, does not validate anything else.
+inline bool IsTextureContainer(
+	const void									*	data,
+	size_t											size )
+{
+	if( size >= sizeof( vk2d::_internal::KTX2_IDENTIFIER ) &&
+		!std::memcmp( data, vk2d::_internal::KTX2_IDENTIFIER, sizeof( vk2d::_internal::KTX2_IDENTIFIER ) ) ) {
+		return true;
+	}
+	if( size >= sizeof( vk2d::_internal::DDS_MAGIC ) &&
+		!std::memcmp( data, vk2d::_internal::DDS_MAGIC, sizeof( vk2d::_internal::DDS_MAGIC ) ) ) {
+		return true;
+	}
+	return false;
+}
+
+
+
+namespace texture_container {
+
+template<typename T>
+T ReadLittleEndian(
+	const uint8_t								*	data )
+{
+	T value {};
+	for( size_t i = 0; i < sizeof( T ); ++i ) {
+		value |= T( data[ i ] ) << ( i * 8 );
+	}
+	return value;
+}
+
+inline uint32_t GetMaxMipLevelCount(
+	uint32_t										width,
+	uint32_t										height )
+{
+	uint32_t count = 1;
+	for( auto size = std::max( width, height ); size > 1; size >>= 1 ) ++count;
+	return count;
+}
+
+// Fills images once format, size, layer and mip level counts are known.
+// get_image_offset( mip_level, layer ) returns where the image starts.
+template<typename GetImageOffsetFunction>
+bool SetContainerImages(
+	vk2d::_internal::TextureContainer			&	container,
+	const uint8_t								*	data,
+	size_t											size,
+	GetImageOffsetFunction							get_image_offset,
+	std::string									&	out_error )
+{
+	container.images.resize( size_t( container.mip_level_count ) * container.layer_count );
+	for( uint32_t m = 0; m < container.mip_level_count; ++m ) {
+		auto width			= std::max( container.width >> m, 1U );
+		auto height			= std::max( container.height >> m, 1U );
+		auto image_size		= vk2d::_internal::GetTextureContainerImageSize( container.format, width, height );
+		for( uint32_t l = 0; l < container.layer_count; ++l ) {
+			uint64_t offset = get_image_offset( m, l );
+			if( offset > size || image_size > size - offset ) {
+				out_error = "Image data is outside of the file.";
+				return false;
+			}
+			auto & image	= container.images[ size_t( m ) * container.layer_count + l ];
+			image.data		= data + offset;
+			image.size		= size_t( image_size );
+			image.width		= width;
+			image.height	= height;
+		}
+	}
+	return true;
+}
+
+inline bool ParseKTX2(
+	const uint8_t								*	data,
+	size_t											size,
+	vk2d::_internal::TextureContainer			&	out_container,
+	std::string									&	out_error )
+{
+	constexpr size_t LEVEL_INDEX_OFFSET	= 80;
+	constexpr size_t LEVEL_INDEX_SIZE	= 24;
+
+	if( size < LEVEL_INDEX_OFFSET ) {
+		out_error = "File is too small to be a KTX2 file.";
+		return false;
+	}
+	auto vk_format					= ReadLittleEndian<uint32_t>( data + 12 );
+	auto pixel_width				= ReadLittleEndian<uint32_t>( data + 20 );
+	auto pixel_height				= ReadLittleEndian<uint32_t>( data + 24 );
+	auto pixel_depth				= ReadLittleEndian<uint32_t>( data + 28 );
+	auto layer_count				= ReadLittleEndian<uint32_t>( data + 32 );
+	auto face_count					= ReadLittleEndian<uint32_t>( data + 36 );
+	auto level_count				= ReadLittleEndian<uint32_t>( data + 40 );
+	auto supercompression_scheme	= ReadLittleEndian<uint32_t>( data + 44 );
+
+	// Values of VkFormat.
+	switch( vk_format ) {
+		case 37:	case 43:	out_container.format = vk2d::_internal::TextureContainerFormat::R8G8B8A8_UNORM;		break;
+		case 44:	case 50:	out_container.format = vk2d::_internal::TextureContainerFormat::B8G8R8A8_UNORM;		break;
+		case 131:	case 132:	out_container.format = vk2d::_internal::TextureContainerFormat::BC1_RGB_UNORM;		break;
+		case 133:	case 134:	out_container.format = vk2d::_internal::TextureContainerFormat::BC1_RGBA_UNORM;		break;
+		case 135:	case 136:	out_container.format = vk2d::_internal::TextureContainerFormat::BC2_UNORM;			break;
+		case 137:	case 138:	out_container.format = vk2d::_internal::TextureContainerFormat::BC3_UNORM;			break;
+		case 139:				out_container.format = vk2d::_internal::TextureContainerFormat::BC4_UNORM;			break;
+		case 141:				out_container.format = vk2d::_internal::TextureContainerFormat::BC5_UNORM;			break;
+		case 143:				out_container.format = vk2d::_internal::TextureContainerFormat::BC6H_UFLOAT;		break;
+		case 144:				out_container.format = vk2d::_internal::TextureContainerFormat::BC6H_SFLOAT;		break;
+		case 145:	case 146:	out_container.format = vk2d::_internal::TextureContainerFormat::BC7_UNORM;			break;
+		default:
+			out_error = "Unsupported KTX2 texel format " + std::to_string( vk_format ) + ".";
+			return false;
+	}
+	if( supercompression_scheme != 0 ) {
+		out_error = "Supercompressed KTX2 files are not supported.";
+		return false;
+	}
+	if( pixel_width == 0 || pixel_height == 0 || pixel_depth != 0 ) {
+		out_error = "Only 2D KTX2 textures are supported.";
+		return false;
+	}
+	if( face_count != 1 ) {
+		out_error = "KTX2 cube maps are not supported.";
+		return false;
+	}
+
+	// Level count 0 asks the loader to generate mip maps.
+	out_container.width				= pixel_width;
+	out_container.height			= pixel_height;
+	out_container.layer_count		= std::max( layer_count, 1U );
+	out_container.mip_level_count	= std::max( level_count, 1U );
+	if( out_container.mip_level_count > GetMaxMipLevelCount( pixel_width, pixel_height ) ) {
+		out_error = "KTX2 file has more mip levels than the texture size allows.";
+		return false;
+	}
+	if( LEVEL_INDEX_OFFSET + LEVEL_INDEX_SIZE * size_t( out_container.mip_level_count ) > size ) {
+		out_error = "KTX2 level index is outside of the file.";
+		return false;
+	}
+
+	// Every layer of a mip level is stored one after another.
+	return SetContainerImages( out_container, data, size, [ & ]( uint32_t mip_level, uint32_t layer ) -> uint64_t
+		{
+			auto level_index	= data + LEVEL_INDEX_OFFSET + LEVEL_INDEX_SIZE * mip_level;
+			auto byte_offset	= ReadLittleEndian<uint64_t>( level_index );
+			auto image_size		= vk2d::_internal::GetTextureContainerImageSize(
+				out_container.format,
+				std::max( out_container.width >> mip_level, 1U ),
+				std::max( out_container.height >> mip_level, 1U )
+			);
+			if( ReadLittleEndian<uint64_t>( level_index + 8 ) < image_size * out_container.layer_count ) return UINT64_MAX;
+			return byte_offset + image_size * layer;
+		},
+		out_error
+	);
+}
+
+inline bool ParseDDS(
+	const uint8_t								*	data,
+	size_t											size,
+	vk2d::_internal::TextureContainer			&	out_container,
+	std::string									&	out_error )
+{
+	constexpr size_t HEADER_OFFSET			= 4;
+	constexpr size_t HEADER_SIZE			= 124;
+	constexpr size_t DX10_HEADER_SIZE		= 20;
+	constexpr uint32_t DDSD_MIPMAPCOUNT		= 0x20000;
+	constexpr uint32_t DDPF_ALPHAPIXELS		= 0x1;
+	constexpr uint32_t DDPF_FOURCC			= 0x4;
+	constexpr uint32_t DDPF_RGB				= 0x40;
+	constexpr uint32_t DDSCAPS2_CUBEMAP		= 0x200;
+	constexpr uint32_t DDSCAPS2_VOLUME		= 0x200000;
+
+	auto FourCC = []( const char * code ) -> uint32_t
+	{
+		return uint32_t( uint8_t( code[ 0 ] ) ) | uint32_t( uint8_t( code[ 1 ] ) ) << 8 | uint32_t( uint8_t( code[ 2 ] ) ) << 16 | uint32_t( uint8_t( code[ 3 ] ) ) << 24;
+	};
+
+	if( size < HEADER_OFFSET + HEADER_SIZE ) {
+		out_error = "File is too small to be a DDS file.";
+		return false;
+	}
+	auto header				= data + HEADER_OFFSET;
+	auto header_size		= ReadLittleEndian<uint32_t>( header + 0 );
+	auto flags				= ReadLittleEndian<uint32_t>( header + 4 );
+	auto height				= ReadLittleEndian<uint32_t>( header + 8 );
+	auto width				= ReadLittleEndian<uint32_t>( header + 12 );
+	auto mip_map_count		= ReadLittleEndian<uint32_t>( header + 24 );
+	auto pixel_flags		= ReadLittleEndian<uint32_t>( header + 76 );
+	auto four_cc			= ReadLittleEndian<uint32_t>( header + 80 );
+	auto rgb_bit_count		= ReadLittleEndian<uint32_t>( header + 84 );
+	auto red_mask			= ReadLittleEndian<uint32_t>( header + 88 );
+	auto green_mask			= ReadLittleEndian<uint32_t>( header + 92 );
+	auto blue_mask			= ReadLittleEndian<uint32_t>( header + 96 );
+	auto alpha_mask			= ReadLittleEndian<uint32_t>( header + 100 );
+	auto caps2				= ReadLittleEndian<uint32_t>( header + 108 );
+
+	if( header_size != HEADER_SIZE ) {
+		out_error = "DDS header is invalid.";
+		return false;
+	}
+	if( width == 0 || height == 0 || ( caps2 & ( DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME ) ) ) {
+		out_error = "Only 2D DDS textures are supported.";
+		return false;
+	}
+
+	size_t data_offset		= HEADER_OFFSET + HEADER_SIZE;
+	uint32_t array_size		= 1;
+	out_container.format	= vk2d::_internal::TextureContainerFormat::UNDEFINED;
+	if( ( pixel_flags & DDPF_FOURCC ) && four_cc == FourCC( "DX10" ) ) {
+		if( size < data_offset + DX10_HEADER_SIZE ) {
+			out_error = "File is too small to be a DDS file.";
+			return false;
+		}
+		auto dx10_header			= data + data_offset;
+		auto dxgi_format			= ReadLittleEndian<uint32_t>( dx10_header + 0 );
+		auto resource_dimension		= ReadLittleEndian<uint32_t>( dx10_header + 4 );
+		auto misc_flag				= ReadLittleEndian<uint32_t>( dx10_header + 8 );
+		array_size					= ReadLittleEndian<uint32_t>( dx10_header + 12 );
+		data_offset					+= DX10_HEADER_SIZE;
+
+		// Values of DXGI_FORMAT.
+		switch( dxgi_format ) {
+			case 28:	case 29:	out_container.format = vk2d::_internal::TextureContainerFormat::R8G8B8A8_UNORM;		break;
+			case 87:	case 91:	out_container.format = vk2d::_internal::TextureContainerFormat::B8G8R8A8_UNORM;		break;
+			case 71:	case 72:	out_container.format = vk2d::_internal::TextureContainerFormat::BC1_RGBA_UNORM;		break;
+			case 74:	case 75:	out_container.format = vk2d::_internal::TextureContainerFormat::BC2_UNORM;			break;
+			case 77:	case 78:	out_container.format = vk2d::_internal::TextureContainerFormat::BC3_UNORM;			break;
+			case 80:				out_container.format = vk2d::_internal::TextureContainerFormat::BC4_UNORM;			break;
+			case 83:				out_container.format = vk2d::_internal::TextureContainerFormat::BC5_UNORM;			break;
+			case 95:				out_container.format = vk2d::_internal::TextureContainerFormat::BC6H_UFLOAT;		break;
+			case 96:				out_container.format = vk2d::_internal::TextureContainerFormat::BC6H_SFLOAT;		break;
+			case 98:	case 99:	out_container.format = vk2d::_internal::TextureContainerFormat::BC7_UNORM;			break;
+			default:
+				out_error = "Unsupported DDS texel format " + std::to_string( dxgi_format ) + ".";
+				return false;
+		}
+		// 3 is D3D10_RESOURCE_DIMENSION_TEXTURE2D, 0x4 is D3D10_RESOURCE_MISC_TEXTURECUBE.
+		if( resource_dimension != 3 || ( misc_flag & 0x4 ) ) {
+			out_error = "Only 2D DDS textures are supported.";
+			return false;
+		}
+	} else if( pixel_flags & DDPF_FOURCC ) {
+		if( four_cc == FourCC( "DXT1" ) )											out_container.format = vk2d::_internal::TextureContainerFormat::BC1_RGBA_UNORM;
+		else if( four_cc == FourCC( "DXT3" ) )										out_container.format = vk2d::_internal::TextureContainerFormat::BC2_UNORM;
+		else if( four_cc == FourCC( "DXT5" ) )										out_container.format = vk2d::_internal::TextureContainerFormat::BC3_UNORM;
+		else if( four_cc == FourCC( "ATI1" ) || four_cc == FourCC( "BC4U" ) )		out_container.format = vk2d::_internal::TextureContainerFormat::BC4_UNORM;
+		else if( four_cc == FourCC( "ATI2" ) || four_cc == FourCC( "BC5U" ) )		out_container.format = vk2d::_internal::TextureContainerFormat::BC5_UNORM;
+	} else if( ( pixel_flags & DDPF_RGB ) && ( pixel_flags & DDPF_ALPHAPIXELS ) && rgb_bit_count == 32 && alpha_mask == 0xFF000000 ) {
+		if( red_mask == 0x000000FF && green_mask == 0x0000FF00 && blue_mask == 0x00FF0000 ) {
+			out_container.format = vk2d::_internal::TextureContainerFormat::R8G8B8A8_UNORM;
+		} else if( red_mask == 0x00FF0000 && green_mask == 0x0000FF00 && blue_mask == 0x000000FF ) {
+			out_container.format = vk2d::_internal::TextureContainerFormat::B8G8R8A8_UNORM;
+		}
+	}
+	if( out_container.format == vk2d::_internal::TextureContainerFormat::UNDEFINED ) {
+		out_error = "Unsupported DDS texel format.";
+		return false;
+	}
+
+	out_container.width				= width;
+	out_container.height			= height;
+	out_container.layer_count		= std::max( array_size, 1U );
+	out_container.mip_level_count	= ( flags & DDSD_MIPMAPCOUNT ) ? std::max( mip_map_count, 1U ) : 1;
+	if( out_container.mip_level_count > GetMaxMipLevelCount( width, height ) ) {
+		out_error = "DDS file has more mip levels than the texture size allows.";
+		return false;
+	}
+
+	// Every mip level of a layer is stored one after another.
+	uint64_t layer_size = 0;
+	for( uint32_t m = 0; m < out_container.mip_level_count; ++m ) {
+		layer_size += vk2d::_internal::GetTextureContainerImageSize(
+			out_container.format,
+			std::max( width >> m, 1U ),
+			std::max( height >> m, 1U )
+		);
+	}
+	return SetContainerImages( out_container, data, size, [ & ]( uint32_t mip_level, uint32_t layer ) -> uint64_t
+		{
+			uint64_t offset = data_offset + layer_size * layer;
+			for( uint32_t m = 0; m < mip_level; ++m ) {
+				offset += vk2d::_internal::GetTextureContainerImageSize(
+					out_container.format,
+					std::max( width >> m, 1U ),
+					std::max( height >> m, 1U )
+				);
+			}
+			return offset;
+		},
+		out_error
+	);
+}
+
+} // texture_container
+
+
+
+// Parses a KTX2 or DDS file, images of out_container point into data.
+// Returns false with a reason in out_error if the file is not supported.
+inline bool ParseTextureContainer(
+	const void									*	data,
+	size_t											size,
+	vk2d::_internal::TextureContainer			&	out_container,
+	std::string									&	out_error )
+{
+	out_container = {};
+	auto bytes = reinterpret_cast<const uint8_t*>( data );
+	if( size >= sizeof( vk2d::_internal::KTX2_IDENTIFIER ) &&
+		!std::memcmp( bytes, vk2d::_internal::KTX2_IDENTIFIER, sizeof( vk2d::_internal::KTX2_IDENTIFIER ) ) ) {
+		return vk2d::_internal::texture_container::ParseKTX2( bytes, size, out_container, out_error );
+	}
+	if( size >= sizeof( vk2d::_internal::DDS_MAGIC ) &&
+		!std::memcmp( bytes, vk2d::_internal::DDS_MAGIC, sizeof( vk2d::_internal::DDS_MAGIC ) ) ) {
+		return vk2d::_internal::texture_container::ParseDDS( bytes, size, out_container, out_error );
+	}
+	out_error = "Not a KTX2 or DDS file.";
+	return false;
+}
+
+
+
+// Block decoders, each writes 4 * 4 RGBA8 texels, 64 bytes, row by row.
+namespace texture_container {
+
+// Reads bits of a 128 bit block from the lowest bit up.
+class BlockBitReader {
+public:
+	explicit										BlockBitReader(
+		const uint8_t							*	block )
+	{
+		low		= ReadLittleEndian<uint64_t>( block );
+		high	= ReadLittleEndian<uint64_t>( block + 8 );
+	}
+
+	uint32_t										Read(
+		uint32_t									count )
+	{
+		if( !count ) return 0;
+		uint64_t value = 0;
+		if( position >= 64 )					value = high >> ( position - 64 );
+		else if( position + count <= 64 )		value = low >> position;
+		else									value = ( low >> position ) | ( high << ( 64 - position ) );
+		position += count;
+		return uint32_t( value & ( ( uint64_t( 1 ) << count ) - 1 ) );
+	}
+
+	uint32_t										GetPosition() const
+	{
+		return position;
+	}
+
+private:
+	uint64_t										low						= {};
+	uint64_t										high					= {};
+	uint32_t										position				= {};
+};
+
+// BC2, BC3, BC6H and BC7 2 and 3 subset partitions. 2 subset partitions have a
+// bit per texel, 3 subset partitions two bits per texel, lowest bits first.
+constexpr uint16_t BC_PARTITIONS_2[ 64 ] = {
+	0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+	0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+	0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+	0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+	0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+	0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+	0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+	0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+constexpr uint32_t BC_PARTITIONS_3[ 64 ] = {
+	0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+	0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+	0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+	0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+	0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+	0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+	0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+	0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+};
+
+// Texel of the second subset that stores its index with one bit less.
+constexpr uint8_t BC_ANCHORS_2[ 64 ] = {
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+	15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+	 6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+// Texels of the second and third subsets of 3 subset partitions.
+constexpr uint8_t BC_ANCHORS_3_SECOND[ 64 ] = {
+	 3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+	 3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+	 8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+	 3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+};
+
+constexpr uint8_t BC_ANCHORS_3_THIRD[ 64 ] = {
+	15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+	15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+	15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+	15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+};
+
+// Interpolation weights out of 64 for 2, 3 and 4 bit indices.
+constexpr uint8_t BC_WEIGHTS_2[ 4 ]		= { 0, 21, 43, 64 };
+constexpr uint8_t BC_WEIGHTS_3[ 8 ]		= { 0, 9, 18, 27, 37, 46, 55, 64 };
+constexpr uint8_t BC_WEIGHTS_4[ 16 ]	= { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+inline const uint8_t * GetBCWeights(
+	uint32_t										index_bits )
+{
+	return index_bits == 2 ? BC_WEIGHTS_2 : ( index_bits == 3 ? BC_WEIGHTS_3 : BC_WEIGHTS_4 );
+}
+
+inline uint32_t GetBCSubset(
+	uint32_t										subset_count,
+	uint32_t										partition,
+	uint32_t										texel )
+{
+	if( subset_count == 2 ) return ( BC_PARTITIONS_2[ partition ] >> texel ) & 1;
+	if( subset_count == 3 ) return ( BC_PARTITIONS_3[ partition ] >> ( texel * 2 ) ) & 3;
+	return 0;
+}
+
+inline bool IsBCAnchor(
+	uint32_t										subset_count,
+	uint32_t										partition,
+	uint32_t										texel )
+{
+	if( texel == 0 ) return true;
+	if( subset_count == 2 ) return texel == BC_ANCHORS_2[ partition ];
+	if( subset_count == 3 ) return texel == BC_ANCHORS_3_SECOND[ partition ] || texel == BC_ANCHORS_3_THIRD[ partition ];
+	return false;
+}
+
+// Color part of BC1, BC2 and BC3 blocks. BC2 and BC3 always use 4 colors.
+inline void DecodeBC1Colors(
+	const uint8_t								*	block,
+	uint8_t										*	out_texels,
+	bool											is_four_color_only,
+	bool											has_alpha )
+{
+	auto color_0	= ReadLittleEndian<uint16_t>( block );
+	auto color_1	= ReadLittleEndian<uint16_t>( block + 2 );
+	auto indices	= ReadLittleEndian<uint32_t>( block + 4 );
+
+	uint8_t palette[ 4 ][ 4 ] {};
+	auto Expand565 = []( uint16_t color, uint8_t * out_color )
+	{
+		uint32_t r = ( color >> 11 ) & 0x1F;
+		uint32_t g = ( color >> 5 ) & 0x3F;
+		uint32_t b = color & 0x1F;
+		out_color[ 0 ] = uint8_t( ( r << 3 ) | ( r >> 2 ) );
+		out_color[ 1 ] = uint8_t( ( g << 2 ) | ( g >> 4 ) );
+		out_color[ 2 ] = uint8_t( ( b << 3 ) | ( b >> 2 ) );
+		out_color[ 3 ] = 255;
+	};
+	Expand565( color_0, palette[ 0 ] );
+	Expand565( color_1, palette[ 1 ] );
+	if( is_four_color_only || color_0 > color_1 ) {
+		for( size_t c = 0; c < 3; ++c ) {
+			palette[ 2 ][ c ] = uint8_t( ( 2 * palette[ 0 ][ c ] + palette[ 1 ][ c ] ) / 3 );
+			palette[ 3 ][ c ] = uint8_t( ( palette[ 0 ][ c ] + 2 * palette[ 1 ][ c ] ) / 3 );
+		}
+		palette[ 2 ][ 3 ] = 255;
+		palette[ 3 ][ 3 ] = 255;
+	} else {
+		for( size_t c = 0; c < 3; ++c ) {
+			palette[ 2 ][ c ] = uint8_t( ( palette[ 0 ][ c ] + palette[ 1 ][ c ] ) / 2 );
+		}
+		palette[ 2 ][ 3 ] = 255;
+		palette[ 3 ][ 3 ] = has_alpha ? 0 : 255;
+	}
+	for( uint32_t i = 0; i < 16; ++i ) {
+		std::memcpy( out_texels + i * 4, palette[ ( indices >> ( i * 2 ) ) & 3 ], 4 );
+	}
+}
+
+// BC3 alpha, BC4 and BC5 channel block, writes every 4th byte of out_values.
+inline void DecodeBCChannel(
+	const uint8_t								*	block,
+	uint8_t										*	out_values )
+{
+	uint32_t value_0	= block[ 0 ];
+	uint32_t value_1	= block[ 1 ];
+	auto indices		= ReadLittleEndian<uint64_t>( block ) >> 16;
+
+	uint8_t palette[ 8 ] { uint8_t( value_0 ), uint8_t( value_1 ) };
+	if( value_0 > value_1 ) {
+		for( uint32_t i = 1; i < 7; ++i ) {
+			palette[ i + 1 ] = uint8_t( ( ( 7 - i ) * value_0 + i * value_1 ) / 7 );
+		}
+	} else {
+		for( uint32_t i = 1; i < 5; ++i ) {
+			palette[ i + 1 ] = uint8_t( ( ( 5 - i ) * value_0 + i * value_1 ) / 5 );
+		}
+		palette[ 6 ] = 0;
+		palette[ 7 ] = 255;
+	}
+	for( uint32_t i = 0; i < 16; ++i ) {
+		out_values[ i * 4 ] = palette[ ( indices >> ( i * 3 ) ) & 7 ];
+	}
+}
+
+inline void DecodeBC7Block(
+	const uint8_t								*	block,
+	uint8_t										*	out_texels )
+{
+	struct ModeInfo {
+		uint8_t										subset_count;
+		uint8_t										partition_bits;
+		uint8_t										rotation_bits;
+		uint8_t										index_selection_bits;
+		uint8_t										color_bits;
+		uint8_t										alpha_bits;
+		uint8_t										endpoint_p_bits;		// One per endpoint.
+		uint8_t										shared_p_bits;			// One per subset.
+		uint8_t										index_bits;
+		uint8_t										secondary_index_bits;
+	};
+	constexpr ModeInfo MODES[ 8 ] = {
+		{ 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+		{ 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+		{ 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+		{ 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+		{ 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+		{ 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+		{ 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+		{ 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+	};
+
+	// Mode is the lowest set bit, reserved mode 8 decodes to transparent black.
+	uint32_t mode = 0;
+	while( mode < 8 && !( block[ 0 ] & ( 1 << mode ) ) ) ++mode;
+	if( mode == 8 ) {
+		std::memset( out_texels, 0, 64 );
+		return;
+	}
+	auto & info = MODES[ mode ];
+
+	BlockBitReader reader( block );
+	reader.Read( mode + 1 );
+	auto partition			= reader.Read( info.partition_bits );
+	auto rotation			= reader.Read( info.rotation_bits );
+	auto index_selection	= reader.Read( info.index_selection_bits );
+
+	uint32_t endpoints[ 3 ][ 2 ][ 4 ] {};
+	for( uint32_t c = 0; c < 3; ++c ) {
+		for( uint32_t s = 0; s < info.subset_count; ++s ) {
+			for( uint32_t e = 0; e < 2; ++e ) {
+				endpoints[ s ][ e ][ c ] = reader.Read( info.color_bits );
+			}
+		}
+	}
+	for( uint32_t s = 0; s < info.subset_count && info.alpha_bits; ++s ) {
+		for( uint32_t e = 0; e < 2; ++e ) {
+			endpoints[ s ][ e ][ 3 ] = reader.Read( info.alpha_bits );
+		}
+	}
+
+	uint32_t color_bits		= info.color_bits;
+	uint32_t alpha_bits		= info.alpha_bits;
+	if( info.endpoint_p_bits || info.shared_p_bits ) {
+		for( uint32_t s = 0; s < info.subset_count; ++s ) {
+			uint32_t p_bits[ 2 ] {};
+			if( info.endpoint_p_bits ) {
+				p_bits[ 0 ] = reader.Read( 1 );
+				p_bits[ 1 ] = reader.Read( 1 );
+			} else {
+				p_bits[ 0 ] = p_bits[ 1 ] = reader.Read( 1 );
+			}
+			for( uint32_t e = 0; e < 2; ++e ) {
+				for( uint32_t c = 0; c < 4; ++c ) {
+					endpoints[ s ][ e ][ c ] = ( endpoints[ s ][ e ][ c ] << 1 ) | p_bits[ e ];
+				}
+			}
+		}
+		++color_bits;
+		if( alpha_bits ) ++alpha_bits;
+	}
+	for( uint32_t s = 0; s < info.subset_count; ++s ) {
+		for( uint32_t e = 0; e < 2; ++e ) {
+			auto & endpoint = endpoints[ s ][ e ];
+			for( uint32_t c = 0; c < 3; ++c ) {
+				endpoint[ c ] = ( endpoint[ c ] << ( 8 - color_bits ) ) | ( endpoint[ c ] >> ( 2 * color_bits - 8 ) );
+			}
+			endpoint[ 3 ] = alpha_bits ? ( ( endpoint[ 3 ] << ( 8 - alpha_bits ) ) | ( endpoint[ 3 ] >> ( 2 * alpha_bits - 8 ) ) ) : 255;
+		}
+	}
+
+	uint32_t indices[ 16 ] {};
+	uint32_t secondary_indices[ 16 ] {};
+	for( uint32_t i = 0; i < 16; ++i ) {
+		indices[ i ] = reader.Read( info.index_bits - ( IsBCAnchor( info.subset_count, partition, i ) ? 1 : 0 ) );
+	}
+	for( uint32_t i = 0; i < 16 && info.secondary_index_bits; ++i ) {
+		secondary_indices[ i ] = reader.Read( info.secondary_index_bits - ( i == 0 ? 1 : 0 ) );
+	}
+
+	auto primary_weights	= GetBCWeights( info.index_bits );
+	auto secondary_weights	= GetBCWeights( info.secondary_index_bits );
+	for( uint32_t i = 0; i < 16; ++i ) {
+		auto & endpoint		= endpoints[ GetBCSubset( info.subset_count, partition, i ) ];
+		auto color_weight	= primary_weights[ indices[ i ] ];
+		auto alpha_weight	= color_weight;
+		if( info.secondary_index_bits ) {
+			alpha_weight	= secondary_weights[ secondary_indices[ i ] ];
+			if( index_selection ) std::swap( color_weight, alpha_weight );
+		}
+
+		auto texel = out_texels + i * 4;
+		for( uint32_t c = 0; c < 4; ++c ) {
+			uint32_t weight = c < 3 ? color_weight : alpha_weight;
+			texel[ c ] = uint8_t( ( ( 64 - weight ) * endpoint[ 0 ][ c ] + weight * endpoint[ 1 ][ c ] + 32 ) >> 6 );
+		}
+		if( rotation ) std::swap( texel[ 3 ], texel[ rotation - 1 ] );
+	}
+}
+
+inline float HalfToFloat(
+	uint32_t										half )
+{
+	uint32_t sign		= ( half >> 15 ) & 1;
+	uint32_t exponent	= ( half >> 10 ) & 0x1F;
+	uint32_t mantissa	= half & 0x3FF;
+	float value = 0.0f;
+	if( exponent == 0 )				value = std::ldexp( float( mantissa ), -24 );
+	else if( exponent == 31 )		value = mantissa ? 0.0f : 65504.0f;		// Infinity clamps, NaN is zero.
+	else							value = std::ldexp( float( mantissa | 0x400 ), int( exponent ) - 25 );
+	return sign ? -value : value;
+}
+
+inline void DecodeBC6HBlock(
+	const uint8_t								*	block,
+	uint8_t										*	out_texels,
+	bool											is_signed )
+{
+	// Endpoint fields, endpoints 0 and 1 belong to the first subset, 2 and 3 to the second.
+	enum Field : uint8_t { R0, G0, B0, R1, G1, B1, R2, G2, B2, R3, G3, B3, D, END };
+
+	// Bits of a field read from the block, from first_bit towards last_bit.
+	struct Segment {
+		uint8_t										field;
+		uint8_t										last_bit;
+		uint8_t										first_bit;
+	};
+	struct ModeInfo {
+		uint8_t										mode_bits;
+		uint8_t										mode_value;
+		bool										is_transformed;
+		uint8_t										subset_count;
+		uint8_t										endpoint_bits;
+		uint8_t										delta_bits[ 3 ];
+		Segment										layout[ 32 ];
+	};
+	static constexpr ModeInfo MODES[ 14 ] = {
+		{ 2, 0x00, true, 2, 10, { 5, 5, 5 }, {
+			{ G2, 4, 4 }, { B2, 4, 4 }, { B3, 4, 4 }, { R0, 9, 0 }, { G0, 9, 0 }, { B0, 9, 0 }, { R1, 4, 0 }, { G3, 4, 4 },
+			{ G2, 3, 0 }, { G1, 4, 0 }, { B3, 0, 0 }, { G3, 3, 0 }, { B1, 4, 0 }, { B3, 1, 1 }, { B2, 3, 0 }, { R2, 4, 0 },
+			{ B3, 2, 2 }, { R3, 4, 0 }, { B3, 3, 3 }, { D, 4, 0 }, { END, 0, 0 } } },
+		{ 2, 0x01, true, 2, 7, { 6, 6, 6 }, {
+			{ G2, 5, 5 }, { G3, 4, 4 }, { G3, 5, 5 }, { R0, 6, 0 }, { B3, 0, 0 }, { B3, 1, 1 }, { B2, 4, 4 }, { G0, 6, 0 },
+			{ B2, 5, 5 }, { B3, 2, 2 }, { G2, 4, 4 }, { B0, 6, 0 }, { B3, 3, 3 }, { B3, 5, 5 }, { B3, 4, 4 }, { R1, 5, 0 },
+			{ G2, 3, 0 }, { G1, 5, 0 }, { G3, 3, 0 }, { B1, 5, 0 }, { B2, 3, 0 }, { R2, 5, 0 }, { R3, 5, 0 }, { D, 4, 0 },
+			{ END, 0, 0 } } },
+		{ 5, 0x02, true, 2, 11, { 5, 4, 4 }, {
+			{ R0, 9, 0 }, { G0, 9, 0 }, { B0, 9, 0 }, { R1, 4, 0 }, { R0, 10, 10 }, { G2, 3, 0 }, { G1, 3, 0 }, { G0, 10, 10 },
+			{ B3, 0, 0 }, { G3, 3, 0 }, { B1, 3, 0 }, { B0, 10, 10 }, { B3, 1, 1 }, { B2, 3, 0 }, { R2, 4, 0 }, { B3, 2, 2 },
+			{ R3, 4, 0 }, { B3, 3, 3 }, { D, 4, 0 }, { END, 0, 0 } } },
+		{ 5, 0x06, true, 2, 11, { 4, 5, 4 }, {
+			{ R0, 9, 0 }, { G0, 9, 0 }, { B0, 9, 0 }, { R1, 3, 0 }, { R0, 10, 10 }, { G3, 4, 4 }, { G2, 3, 0 }, { G1, 4, 0 },
+			{ G0, 10, 10 }, { G3, 3, 0 }, { B1, 3, 0 }, { B0, 10, 10 }, { B3, 1, 1 }, { B2, 3, 0 }, { R2, 3, 0 }, { B3, 0, 0 },
+			{ B3, 2, 2 }, { R3, 3, 0 }, { G2, 4, 4 }, { B3, 3, 3 }, { D, 4, 0 }, { END, 0, 0 } } },
+		{ 5, 0x0A, true, 2, 11, { 4, 4, 5 }, {
+			{ R0, 9, 0 }, { G0, 9, 0 }, { B0, 9, 0 }, { R1, 3, 0 }, { R0, 10, 10 }, { B2, 4, 4 }, { G2, 3, 0 }, { G1, 3, 0 },
+			{ G0, 10, 10 }, { B3, 0, 0 }, { G3, 3, 0 }, { B1, 4, 0 }, { B0, 10, 10 }, { B2, 3, 0 }, { R2, 3, 0 }, { B3, 1, 1 },
+			{ B3, 2, 2 }, { R3, 3, 0 }, { B3, 4, 4 }, { B3, 3, 3 }, { D, 4, 0 }, { END, 0, 0 } } },
+		{ 5, 0x0E, true, 2, 9, { 5, 5, 5 }, {
+			{ R0, 8, 0 }, { B2, 4, 4 }, { G0, 8, 0 }, { G2, 4, 4 }, { B0, 8, 0 }, { B3, 4, 4 }, { R1, 4, 0 }, { G3, 4, 4 },
+			{ G2, 3, 0 }, { G1, 4, 0 }, { B3, 0, 0 }, { G3, 3, 0 }, { B1, 4, 0 }, { B3, 1, 1 }, { B2, 3, 0 }, { R2, 4, 0 },
+			{ B3, 2, 2 }, { R3, 4, 0 }, { B3, 3, 3 }, { D, 4, 0 }, { END, 0, 0 } } },
+		{ 5, 0x12, true, 2, 8, { 6, 5, 5 }, {
+			{ R0, 7, 0 }, { G3, 4, 4 }, { B2, 4, 4 }, { G0, 7, 0 }, { B3, 2, 2 }, { G2, 4, 4 }, { B0, 7, 0 }, { B3, 3, 3 },
+			{ B3, 4, 4 }, { R1, 5, 0 }, { G2, 3, 0 }, { G1, 4, 0 }, { B3, 0, 0 }, { G3, 3, 0 }, { B1, 4, 0 }, { B3, 1, 1 },
+			{ B2, 3, 0 }, { R2, 5, 0 }, { R3, 5, 0 }, { D, 4, 0 }, { END, 0, 0 } } },
+		{ 5, 0x16, true, 2, 8, { 5, 6, 5 }, {
+			{ R0, 7, 0 }, { B3, 0, 0 }, { B2, 4, 4 }, { G0, 7, 0 }, { G2, 5, 5 }, { G2, 4, 4 }, { B0, 7, 0 }, { G3, 5, 5 },
+			{ B3, 4, 4 }, { R1, 4, 0 }, { G3, 4, 4 }, { G2, 3, 0 }, { G1, 5, 0 }, { G3, 3, 0 }, { B1, 4, 0 }, { B3, 1, 1 },
+			{ B2, 3, 0 }, { R2, 4, 0 }, { B3, 2, 2 }, { R3, 4, 0 }, { B3, 3, 3 }, { D, 4, 0 }, { END, 0, 0 } } },
+		{ 5, 0x1A, true, 2, 8, { 5, 5, 6 }, {
+			{ R0, 7, 0 }, { B3, 1, 1 }, { B2, 4, 4 }, { G0, 7, 0 }, { B2, 5, 5 }, { G2, 4, 4 }, { B0, 7, 0 }, { B3, 5, 5 },
+			{ B3, 4, 4 }, { R1, 4, 0 }, { G3, 4, 4 }, { G2, 3, 0 }, { G1, 4, 0 }, { B3, 0, 0 }, { G3, 3, 0 }, { B1, 5, 0 },
+			{ B2, 3, 0 }, { R2, 4, 0 }, { B3, 2, 2 }, { R3, 4, 0 }, { B3, 3, 3 }, { D, 4, 0 }, { END, 0, 0 } } },
+		{ 5, 0x1E, false, 2, 6, { 6, 6, 6 }, {
+			{ R0, 5, 0 }, { G3, 4, 4 }, { B3, 0, 0 }, { B3, 1, 1 }, { B2, 4, 4 }, { G0, 5, 0 }, { G2, 5, 5 }, { B2, 5, 5 },
+			{ B3, 2, 2 }, { G2, 4, 4 }, { B0, 5, 0 }, { G3, 5, 5 }, { B3, 3, 3 }, { B3, 5, 5 }, { B3, 4, 4 }, { R1, 5, 0 },
+			{ G2, 3, 0 }, { G1, 5, 0 }, { G3, 3, 0 }, { B1, 5, 0 }, { B2, 3, 0 }, { R2, 5, 0 }, { R3, 5, 0 }, { D, 4, 0 },
+			{ END, 0, 0 } } },
+		{ 5, 0x03, false, 1, 10, { 10, 10, 10 }, {
+			{ R0, 9, 0 }, { G0, 9, 0 }, { B0, 9, 0 }, { R1, 9, 0 }, { G1, 9, 0 }, { B1, 9, 0 }, { END, 0, 0 } } },
+		{ 5, 0x07, true, 1, 11, { 9, 9, 9 }, {
+			{ R0, 9, 0 }, { G0, 9, 0 }, { B0, 9, 0 }, { R1, 8, 0 }, { R0, 10, 10 }, { G1, 8, 0 }, { G0, 10, 10 }, { B1, 8, 0 },
+			{ B0, 10, 10 }, { END, 0, 0 } } },
+		{ 5, 0x0B, true, 1, 12, { 8, 8, 8 }, {
+			{ R0, 9, 0 }, { G0, 9, 0 }, { B0, 9, 0 }, { R1, 7, 0 }, { R0, 10, 11 }, { G1, 7, 0 }, { G0, 10, 11 }, { B1, 7, 0 },
+			{ B0, 10, 11 }, { END, 0, 0 } } },
+		{ 5, 0x0F, true, 1, 16, { 4, 4, 4 }, {
+			{ R0, 9, 0 }, { G0, 9, 0 }, { B0, 9, 0 }, { R1, 3, 0 }, { R0, 10, 15 }, { G1, 3, 0 }, { G0, 10, 15 }, { B1, 3, 0 },
+			{ B0, 10, 15 }, { END, 0, 0 } } },
+	};
+
+	BlockBitReader reader( block );
+	auto mode_value = reader.Read( 2 );
+	if( mode_value > 1 ) mode_value |= reader.Read( 3 ) << 2;
+
+	const ModeInfo * info = nullptr;
+	for( auto & m : MODES ) {
+		if( m.mode_value == mode_value ) info = &m;
+	}
+	// Reserved modes decode to black.
+	if( !info ) {
+		for( uint32_t i = 0; i < 16; ++i ) {
+			out_texels[ i * 4 + 0 ] = 0;
+			out_texels[ i * 4 + 1 ] = 0;
+			out_texels[ i * 4 + 2 ] = 0;
+			out_texels[ i * 4 + 3 ] = 255;
+		}
+		return;
+	}
+
+	int32_t fields[ END ] {};
+	for( auto segment = info->layout; segment->field != END; ++segment ) {
+		int32_t step = segment->last_bit >= segment->first_bit ? 1 : -1;
+		for( int32_t bit = segment->first_bit; ; bit += step ) {
+			fields[ segment->field ] |= int32_t( reader.Read( 1 ) ) << bit;
+			if( bit == segment->last_bit ) break;
+		}
+	}
+	auto partition = uint32_t( fields[ D ] );
+
+	auto SignExtend = []( int32_t value, uint32_t bits ) -> int32_t
+	{
+		auto shift = 32 - bits;
+		return int32_t( uint32_t( value ) << shift ) >> shift;
+	};
+
+	// endpoints[ endpoint ][ channel ]
+	int32_t endpoints[ 4 ][ 3 ] {};
+	uint32_t endpoint_count = info->subset_count * 2;
+	for( uint32_t e = 0; e < endpoint_count; ++e ) {
+		for( uint32_t c = 0; c < 3; ++c ) {
+			endpoints[ e ][ c ] = fields[ e * 3 + c ];
+		}
+	}
+	for( uint32_t c = 0; c < 3; ++c ) {
+		uint32_t endpoint_mask = ( 1U << info->endpoint_bits ) - 1;
+		if( is_signed ) endpoints[ 0 ][ c ] = SignExtend( endpoints[ 0 ][ c ], info->endpoint_bits );
+		for( uint32_t e = 1; e < endpoint_count; ++e ) {
+			if( is_signed || info->is_transformed ) {
+				endpoints[ e ][ c ] = SignExtend( endpoints[ e ][ c ], info->delta_bits[ c ] );
+			}
+			// Other endpoints are stored as differences to the first one.
+			if( info->is_transformed ) {
+				endpoints[ e ][ c ] = ( endpoints[ 0 ][ c ] + endpoints[ e ][ c ] ) & endpoint_mask;
+				if( is_signed ) endpoints[ e ][ c ] = SignExtend( endpoints[ e ][ c ], info->endpoint_bits );
+			}
+		}
+	}
+
+	auto Unquantize = [ info, is_signed ]( int32_t value ) -> int32_t
+	{
+		int32_t bits = info->endpoint_bits;
+		if( !is_signed ) {
+			if( bits >= 15 ) return value;
+			if( value == 0 ) return 0;
+			if( value == ( 1 << bits ) - 1 ) return 0xFFFF;
+			return ( ( value << 16 ) + 0x8000 ) >> bits;
+		}
+		if( bits >= 16 ) return value;
+		bool is_negative = value < 0;
+		if( is_negative ) value = -value;
+		int32_t result = 0;
+		if( value == 0 )							result = 0;
+		else if( value >= ( 1 << ( bits - 1 ) ) - 1 )	result = 0x7FFF;
+		else										result = ( ( value << 15 ) + 0x4000 ) >> ( bits - 1 );
+		return is_negative ? -result : result;
+	};
+	for( uint32_t e = 0; e < endpoint_count; ++e ) {
+		for( uint32_t c = 0; c < 3; ++c ) {
+			endpoints[ e ][ c ] = Unquantize( endpoints[ e ][ c ] );
+		}
+	}
+
+	uint32_t index_bits = info->subset_count == 1 ? 4 : 3;
+	auto weights = GetBCWeights( index_bits );
+	for( uint32_t i = 0; i < 16; ++i ) {
+		auto subset		= GetBCSubset( info->subset_count, partition, i );
+		auto index		= reader.Read( index_bits - ( IsBCAnchor( info->subset_count, partition, i ) ? 1 : 0 ) );
+		int32_t weight	= weights[ index ];
+		auto texel		= out_texels + i * 4;
+		for( uint32_t c = 0; c < 3; ++c ) {
+			int32_t value = ( ( 64 - weight ) * endpoints[ subset * 2 ][ c ] + weight * endpoints[ subset * 2 + 1 ][ c ] + 32 ) >> 6;
+
+			// Scale to half float bits.
+			uint32_t half = 0;
+			if( !is_signed ) {
+				half = uint32_t( ( value * 31 ) >> 6 );
+			} else if( value < 0 ) {
+				half = 0x8000 | uint32_t( ( -value * 31 ) >> 5 );
+			} else {
+				half = uint32_t( ( value * 31 ) >> 5 );
+			}
+			auto f = std::min( std::max( HalfToFloat( half ), 0.0f ), 1.0f );
+			texel[ c ] = uint8_t( f * 255.0f + 0.5f );
+		}
+		texel[ 3 ] = 255;
+	}
+}
+
+inline void DecodeBlock(
+	vk2d::_internal::TextureContainerFormat			format,
+	const uint8_t								*	block,
+	uint8_t										*	out_texels )
+{
+	switch( format ) {
+		case vk2d::_internal::TextureContainerFormat::BC1_RGB_UNORM:
+			DecodeBC1Colors( block, out_texels, false, false );
+			break;
+		case vk2d::_internal::TextureContainerFormat::BC1_RGBA_UNORM:
+			DecodeBC1Colors( block, out_texels, false, true );
+			break;
+		case vk2d::_internal::TextureContainerFormat::BC2_UNORM:
+			DecodeBC1Colors( block + 8, out_texels, true, false );
+			for( uint32_t i = 0; i < 16; ++i ) {
+				out_texels[ i * 4 + 3 ] = uint8_t( ( ( block[ i / 2 ] >> ( ( i % 2 ) * 4 ) ) & 0xF ) * 17 );
+			}
+			break;
+		case vk2d::_internal::TextureContainerFormat::BC3_UNORM:
+			DecodeBC1Colors( block + 8, out_texels, true, false );
+			DecodeBCChannel( block, out_texels + 3 );
+			break;
+		case vk2d::_internal::TextureContainerFormat::BC4_UNORM:
+			for( uint32_t i = 0; i < 16; ++i ) {
+				out_texels[ i * 4 + 1 ] = 0;
+				out_texels[ i * 4 + 2 ] = 0;
+				out_texels[ i * 4 + 3 ] = 255;
+			}
+			DecodeBCChannel( block, out_texels );
+			break;
+		case vk2d::_internal::TextureContainerFormat::BC5_UNORM:
+			for( uint32_t i = 0; i < 16; ++i ) {
+				out_texels[ i * 4 + 2 ] = 0;
+				out_texels[ i * 4 + 3 ] = 255;
+			}
+			DecodeBCChannel( block, out_texels );
+			DecodeBCChannel( block + 8, out_texels + 1 );
+			break;
+		case vk2d::_internal::TextureContainerFormat::BC6H_UFLOAT:
+			DecodeBC6HBlock( block, out_texels, false );
+			break;
+		case vk2d::_internal::TextureContainerFormat::BC6H_SFLOAT:
+			DecodeBC6HBlock( block, out_texels, true );
+			break;
+		case vk2d::_internal::TextureContainerFormat::BC7_UNORM:
+			DecodeBC7Block( block, out_texels );
+			break;
+		default:
+			std::memset( out_texels, 0, 64 );
+			break;
+	}
+}
+
+} // texture_container
+
+
+
+// Decodes an image of any supported format to tightly packed RGBA8 texels,
+// out_texels must have room for width * height * 4 bytes. Returns false if
+// the format is unknown or image is smaller than the format requires.
+inline bool DecodeTextureContainerImage(
+	vk2d::_internal::TextureContainerFormat			format,
+	const vk2d::_internal::TextureContainerImage	&	image,
+	uint8_t										*	out_texels )
+{
+	auto required_size = vk2d::_internal::GetTextureContainerImageSize( format, image.width, image.height );
+	if( !required_size || image.size < required_size ) return false;
+
+	if( format == vk2d::_internal::TextureContainerFormat::R8G8B8A8_UNORM ) {
+		std::memcpy( out_texels, image.data, size_t( required_size ) );
+		return true;
+	}
+	if( format == vk2d::_internal::TextureContainerFormat::B8G8R8A8_UNORM ) {
+		for( size_t i = 0; i < size_t( image.width ) * image.height; ++i ) {
+			out_texels[ i * 4 + 0 ] = image.data[ i * 4 + 2 ];
+			out_texels[ i * 4 + 1 ] = image.data[ i * 4 + 1 ];
+			out_texels[ i * 4 + 2 ] = image.data[ i * 4 + 0 ];
+			out_texels[ i * 4 + 3 ] = image.data[ i * 4 + 3 ];
+		}
+		return true;
+	}
+
+	auto block_size		= vk2d::_internal::GetTextureContainerBlockSize( format );
+	auto blocks_x		= ( image.width + 3 ) / 4;
+	auto blocks_y		= ( image.height + 3 ) / 4;
+	uint8_t block_texels[ 64 ];
+	for( uint32_t by = 0; by < blocks_y; ++by ) {
+		for( uint32_t bx = 0; bx < blocks_x; ++bx ) {
+			vk2d::_internal::texture_container::DecodeBlock(
+				format,
+				image.data + ( size_t( by ) * blocks_x + bx ) * block_size,
+				block_texels
+			);
+
+			// Blocks at the right and bottom edges may be partially outside of the image.
+			auto copy_width		= std::min( 4U, image.width - bx * 4 );
+			auto copy_height	= std::min( 4U, image.height - by * 4 );
+			for( uint32_t y = 0; y < copy_height; ++y ) {
+				std::memcpy(
+					out_texels + ( ( size_t( by ) * 4 + y ) * image.width + bx * 4 ) * 4,
+					block_texels + y * 16,
+					copy_width * 4
+				);
+			}
+		}
+	}
+	return true;
+}
+
+
+
+} // _internal
+} // vk2d
@@ -0,0 +1,467 @@
+
+#include "Core/SourceCommon.h"
+
+#include "System/TextureUploadBatch.h"
+#include "System/ThreadPool.h"
+#include "System/ThreadPrivateResources.h"
+
+#include "Interface/InstanceImpl.h"
+
+
+
+namespace vk2d {
+namespace _internal {
+
+// Waits for the GPU to finish the batch so upload progress can be reported
+// without anyone polling the textures.
+class TextureUploadBatchWaitTask : public vk2d::_internal::Task
+{
+public:
+	TextureUploadBatchWaitTask(
+		std::shared_ptr<vk2d::_internal::TextureUploadBatch>		upload_batch
+	) :
+		upload_batch( std::move( upload_batch ) )
+	{}
+
+	void											operator()(
+		[[maybe_unused]] vk2d::_internal::ThreadPrivateResource	*	thread_resource )
+	{
+		upload_batch->WaitAndReportUploaded();
+	}
+
+private:
+	std::shared_ptr<vk2d::_internal::TextureUploadBatch>			upload_batch;
+};
+
+} // _internal
+} // vk2d
+
+
+
+vk2d::_internal::TextureUploadBatch::TextureUploadBatch(
+	vk2d::_internal::InstanceImpl								*	instance,
+	std::function<void( const vk2d::TextureBatchLoadProgress & )>	progress_callback
+)
+{
+	assert( instance );
+
+	this->instance				= instance;
+	this->vk_device				= instance->GetVulkanDevice();
+	this->progress_callback		= std::move( progress_callback );
+	this->submit_result			= VK_NOT_READY;
+}
+
+vk2d::_internal::TextureUploadBatch::~TextureUploadBatch()
+{
+	// Textures wait for the batch before they unload, GPU is done with everything here.
+	for( auto & r : thread_recordings ) {
+		if( !r.loader_thread_resource ) continue;
+
+		r.loader_thread_resource->DeferredFreeCommandBuffer(
+			r.loader_thread_resource->GetPrimaryTransferCommandPool(),
+			r.command_buffers.primary_transfer
+		);
+		r.loader_thread_resource->DeferredFreeCommandBuffer(
+			r.loader_thread_resource->GetSecondaryRenderCommandPool(),
+			r.command_buffers.secondary_render
+		);
+		r.loader_thread_resource->DeferredFreeCommandBuffer(
+			r.loader_thread_resource->GetPrimaryRenderCommandPool(),
+			r.command_buffers.primary_render
+		);
+	}
+	vkDestroySemaphore(
+		vk_device,
+		vk_transfer_semaphore,
+		nullptr
+	);
+	vkDestroySemaphore(
+		vk_device,
+		vk_blit_semaphore,
+		nullptr
+	);
+	vkDestroyFence(
+		vk_device,
+		vk_upload_complete_fence,
+		nullptr
+	);
+}
+
+void vk2d::_internal::TextureUploadBatch::AddTexture(
+	uint32_t		loader_thread
+)
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	if( loader_thread >= uint32_t( thread_recordings.size() ) ) {
+		thread_recordings.resize( size_t( loader_thread ) + 1 );
+	}
+	++thread_recordings[ loader_thread ].remaining_texture_count;
+	++remaining_texture_count;
+	++total_count;
+}
+
+void vk2d::_internal::TextureUploadBatch::MTTextureDecoded()
+{
+	++decoded_count;
+	ReportProgress();
+}
+
+bool vk2d::_internal::TextureUploadBatch::MTBeginTextureUpload(
+	uint32_t												loader_thread,
+	vk2d::_internal::ThreadLoaderResource				*	loader_thread_resource,
+	bool													is_blit_needed,
+	vk2d::_internal::TextureUploadCommandBuffers		&	out_command_buffers
+)
+{
+	assert( loader_thread_resource );
+
+	std::lock_guard<std::mutex> lock( mutex );
+
+	assert( loader_thread < uint32_t( thread_recordings.size() ) );
+	auto & recording = thread_recordings[ loader_thread ];
+	assert( recording.remaining_texture_count );
+
+	if( recording.is_allocation_failed ) return false;
+
+	// Primary render command buffer receives ownership of textures from either
+	// the transfer queue or the secondary render queue, whichever finished them.
+	auto primary_render_queue_family_index	= instance->GetPrimaryRenderQueue().GetQueueFamilyIndex();
+	bool is_primary_render_needed			=
+		instance->GetPrimaryTransferQueue().GetQueueFamilyIndex() != primary_render_queue_family_index ||
+		instance->GetSecondaryRenderQueue().GetQueueFamilyIndex() != primary_render_queue_family_index;
+
+	// Not retried, whatever was allocated is freed with the batch.
+	if( !recording.is_recording ) {
+		recording.loader_thread_resource	= loader_thread_resource;
+		if( !AllocateCommandBuffer( loader_thread_resource->GetPrimaryTransferCommandPool(), recording.command_buffers.primary_transfer ) ||
+			( is_primary_render_needed &&
+			!AllocateCommandBuffer( loader_thread_resource->GetPrimaryRenderCommandPool(), recording.command_buffers.primary_render ) ) ) {
+			recording.is_allocation_failed	= true;
+			return false;
+		}
+		recording.is_recording				= true;
+	}
+	if( is_blit_needed && !recording.command_buffers.secondary_render ) {
+		if( !AllocateCommandBuffer( loader_thread_resource->GetSecondaryRenderCommandPool(), recording.command_buffers.secondary_render ) ) {
+			recording.is_allocation_failed	= true;
+			return false;
+		}
+	}
+
+	out_command_buffers		= recording.command_buffers;
+	return true;
+}
+
+void vk2d::_internal::TextureUploadBatch::MTFinishTexture(
+	uint32_t		loader_thread,
+	bool			success
+)
+{
+	if( !success ) {
+		++failed_count;
+		ReportProgress();
+	}
+
+	std::lock_guard<std::mutex> lock( mutex );
+
+	assert( loader_thread < uint32_t( thread_recordings.size() ) );
+	auto & recording = thread_recordings[ loader_thread ];
+	assert( recording.remaining_texture_count );
+	assert( remaining_texture_count );
+
+	if( success ) {
+		++submitted_texture_count;
+	}
+
+	// Command buffers must be ended in the thread that owns the command pools.
+	if( --recording.remaining_texture_count == 0 && recording.is_recording ) {
+		EndCommandBuffers( recording );
+	}
+
+	if( --remaining_texture_count == 0 ) {
+		submit_result		= Submit();
+		if( submit_result != VK_SUCCESS ) {
+			failed_count	+= submitted_texture_count;
+		}
+		submitted.Set();
+
+		if( submit_result == VK_SUCCESS ) {
+			instance->GetThreadPool()->ScheduleTask(
+				std::make_unique<vk2d::_internal::TextureUploadBatchWaitTask>( shared_from_this() ),
+				instance->GetGeneralThreads()
+			);
+		} else {
+			ReportProgress();
+		}
+	}
+}
+
+VkResult vk2d::_internal::TextureUploadBatch::GetUploadStatus()
+{
+	if( !submitted.IsSet() ) return VK_NOT_READY;
+	if( submit_result != VK_SUCCESS ) return submit_result;
+
+	return vkGetFenceStatus(
+		vk_device,
+		vk_upload_complete_fence
+	);
+}
+
+VkResult vk2d::_internal::TextureUploadBatch::WaitForUpload(
+	std::chrono::steady_clock::time_point		timeout
+)
+{
+	if( !submitted.Wait( timeout ) ) return VK_TIMEOUT;
+	if( submit_result != VK_SUCCESS ) return submit_result;
+
+	auto timeout_for_fences = ( timeout == std::chrono::steady_clock::time_point::max() ) ?
+		UINT64_MAX :
+		uint64_t( std::max( std::chrono::duration_cast<std::chrono::nanoseconds>( timeout - std::chrono::steady_clock::now() ).count(), int64_t( 0 ) ) );
+
+	return vkWaitForFences(
+		vk_device,
+		1, &vk_upload_complete_fence,
+		VK_TRUE,
+		timeout_for_fences
+	);
+}
+
+void vk2d::_internal::TextureUploadBatch::WaitAndReportUploaded()
+{
+	auto result = WaitForUpload( std::chrono::steady_clock::time_point::max() );
+	if( result == VK_SUCCESS ) {
+		uploaded_count		= submitted_texture_count;
+	} else {
+		instance->Report( result, "Internal error: Texture batch upload failed!" );
+		failed_count		+= submitted_texture_count;
+	}
+	ReportProgress();
+}
+
+bool vk2d::_internal::TextureUploadBatch::AllocateCommandBuffer(
+	VkCommandPool													command_pool,
+	VkCommandBuffer												&	out_command_buffer
+)
+{
+	VkCommandBufferAllocateInfo command_buffer_allocate_info {};
+	command_buffer_allocate_info.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	command_buffer_allocate_info.pNext					= nullptr;
+	command_buffer_allocate_info.commandPool			= command_pool;
+	command_buffer_allocate_info.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	command_buffer_allocate_info.commandBufferCount		= 1;
+	auto result = vkAllocateCommandBuffers(
+		vk_device,
+		&command_buffer_allocate_info,
+		&out_command_buffer
+	);
+	if( result != VK_SUCCESS ) {
+		out_command_buffer	= VK_NULL_HANDLE;
+		instance->Report( result, "Internal error: Cannot allocate command buffers for texture batch upload!" );
+		return false;
+	}
+
+	VkCommandBufferBeginInfo command_buffer_begin_info {};
+	command_buffer_begin_info.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	command_buffer_begin_info.pNext				= nullptr;
+	command_buffer_begin_info.flags				= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	command_buffer_begin_info.pInheritanceInfo	= nullptr;
+	result = vkBeginCommandBuffer(
+		out_command_buffer,
+		&command_buffer_begin_info
+	);
+	if( result != VK_SUCCESS ) {
+		instance->Report( result, "Internal error: Cannot begin command buffers for texture batch upload!" );
+		return false;
+	}
+	return true;
+}
+
+void vk2d::_internal::TextureUploadBatch::EndCommandBuffers(
+	vk2d::_internal::TextureUploadBatch::ThreadRecording		&	recording
+)
+{
+	recording.is_recording		= false;
+
+	for( auto command_buffer : {
+		recording.command_buffers.primary_transfer,
+		recording.command_buffers.secondary_render,
+		recording.command_buffers.primary_render } ) {
+		if( !command_buffer ) continue;
+
+		auto result = vkEndCommandBuffer(
+			command_buffer
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot compile command buffers for texture batch upload!" );
+			recording.is_end_failed	= true;
+			return;
+		}
+	}
+	recording.is_recorded		= true;
+}
+
+VkResult vk2d::_internal::TextureUploadBatch::Submit()
+{
+	std::vector<VkCommandBuffer> transfer_command_buffers;
+	std::vector<VkCommandBuffer> secondary_render_command_buffers;
+	std::vector<VkCommandBuffer> primary_render_command_buffers;
+	for( auto & r : thread_recordings ) {
+		// Command buffers that failed to end contain textures that can't be
+		// uploaded, the whole batch fails as textures only know the batch result.
+		if( r.is_end_failed ) return VK_ERROR_INITIALIZATION_FAILED;
+		if( !r.is_recorded ) continue;
+
+		transfer_command_buffers.push_back( r.command_buffers.primary_transfer );
+		if( r.command_buffers.secondary_render ) {
+			secondary_render_command_buffers.push_back( r.command_buffers.secondary_render );
+		}
+		if( r.command_buffers.primary_render ) {
+			primary_render_command_buffers.push_back( r.command_buffers.primary_render );
+		}
+	}
+	// Every texture failed before recording anything.
+	if( transfer_command_buffers.empty() ) return VK_ERROR_INITIALIZATION_FAILED;
+
+	// Without blits the render queues only wait for the transfer queue if
+	// ownership needs to be handed over, otherwise they're not used at all.
+	bool is_blit_needed				= !secondary_render_command_buffers.empty();
+	bool is_primary_render_needed	= !primary_render_command_buffers.empty();
+	bool is_transfer_last_submit	= !is_blit_needed && !is_primary_render_needed;
+
+	// Create synchronization primitives
+	{
+		VkSemaphoreCreateInfo semaphore_create_info {};
+		semaphore_create_info.sType		= VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		semaphore_create_info.pNext		= nullptr;
+		semaphore_create_info.flags		= 0;
+
+		VkFenceCreateInfo fence_create_info {};
+		fence_create_info.sType			= VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fence_create_info.pNext			= nullptr;
+		fence_create_info.flags			= 0;
+
+		auto result = VK_SUCCESS;
+		if( !is_transfer_last_submit ) {
+			result = vkCreateSemaphore(
+				vk_device,
+				&semaphore_create_info,
+				nullptr,
+				&vk_transfer_semaphore
+			);
+			if( result != VK_SUCCESS ) {
+				instance->Report( result, "Internal error: Cannot create semaphore for texture batch upload synchronization!" );
+				return result;
+			}
+		}
+
+		if( is_blit_needed && is_primary_render_needed ) {
+			result = vkCreateSemaphore(
+				vk_device,
+				&semaphore_create_info,
+				nullptr,
+				&vk_blit_semaphore
+			);
+			if( result != VK_SUCCESS ) {
+				instance->Report( result, "Internal error: Cannot create semaphore for texture batch upload synchronization!" );
+				return result;
+			}
+		}
+
+		result = vkCreateFence(
+			vk_device,
+			&fence_create_info,
+			nullptr,
+			&vk_upload_complete_fence
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot create fence for texture batch upload synchronization!" );
+			return result;
+		}
+	}
+
+	// Submit transfer command buffers
+	{
+		VkSubmitInfo submit_info {};
+		submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext					= nullptr;
+		submit_info.waitSemaphoreCount		= 0;
+		submit_info.pWaitSemaphores			= nullptr;
+		submit_info.pWaitDstStageMask		= nullptr;
+		submit_info.commandBufferCount		= uint32_t( transfer_command_buffers.size() );
+		submit_info.pCommandBuffers			= transfer_command_buffers.data();
+		submit_info.signalSemaphoreCount	= is_transfer_last_submit ? 0 : 1;
+		submit_info.pSignalSemaphores		= is_transfer_last_submit ? nullptr : &vk_transfer_semaphore;
+		auto result = instance->GetPrimaryTransferQueue().Submit(
+			submit_info,
+			is_transfer_last_submit ? vk_upload_complete_fence : VK_NULL_HANDLE
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot submit texture batch upload command buffers!" );
+			return result;
+		}
+	}
+
+	// Submit blit command buffers
+	if( is_blit_needed ) {
+		VkPipelineStageFlags wait_semaphore_dst	= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		VkSubmitInfo submit_info {};
+		submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext					= nullptr;
+		submit_info.waitSemaphoreCount		= 1;
+		submit_info.pWaitSemaphores			= &vk_transfer_semaphore;
+		submit_info.pWaitDstStageMask		= &wait_semaphore_dst;
+		submit_info.commandBufferCount		= uint32_t( secondary_render_command_buffers.size() );
+		submit_info.pCommandBuffers			= secondary_render_command_buffers.data();
+		submit_info.signalSemaphoreCount	= is_primary_render_needed ? 1 : 0;
+		submit_info.pSignalSemaphores		= is_primary_render_needed ? &vk_blit_semaphore : nullptr;
+		auto result = instance->GetSecondaryRenderQueue().Submit(
+			submit_info,
+			is_primary_render_needed ? VK_NULL_HANDLE : vk_upload_complete_fence
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot submit texture batch mipmap generation command buffers!" );
+			return result;
+		}
+	}
+
+	// Submit primary render command buffers
+	if( is_primary_render_needed ) {
+		VkPipelineStageFlags wait_semaphore_dst	= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		VkSubmitInfo submit_info {};
+		submit_info.sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext					= nullptr;
+		submit_info.waitSemaphoreCount		= 1;
+		submit_info.pWaitSemaphores			= is_blit_needed ? &vk_blit_semaphore : &vk_transfer_semaphore;
+		submit_info.pWaitDstStageMask		= &wait_semaphore_dst;
+		submit_info.commandBufferCount		= uint32_t( primary_render_command_buffers.size() );
+		submit_info.pCommandBuffers			= primary_render_command_buffers.data();
+		submit_info.signalSemaphoreCount	= 0;
+		submit_info.pSignalSemaphores		= nullptr;
+		auto result = instance->GetPrimaryRenderQueue().Submit(
+			submit_info,
+			vk_upload_complete_fence
+		);
+		if( result != VK_SUCCESS ) {
+			instance->Report( result, "Internal error: Cannot submit texture batch queue family handover command buffers!" );
+			return result;
+		}
+	}
+
+	return VK_SUCCESS;
+}
+
+void vk2d::_internal::TextureUploadBatch::ReportProgress()
+{
+	if( !progress_callback ) return;
+
+	// Serialized so the callback never sees counts go backwards.
+	std::lock_guard<std::mutex> progress_lock( progress_mutex );
+
+	vk2d::TextureBatchLoadProgress progress {};
+	progress.total_count		= total_count;
+	progress.decoded_count		= decoded_count;
+	progress.uploaded_count		= uploaded_count;
+	progress.failed_count		= failed_count;
+	progress_callback( progress );
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Core/SourceCommon.h"
+
+#include "Types/Synchronization.hpp"
+
+#include "Interface/ResourceManager/ResourceManager.h"
+
+
+
+namespace vk2d {
+
+namespace _internal {
+
+class InstanceImpl;
+class ThreadLoaderResource;
+
+
+
+// Command buffers a texture records its upload into, shared by every
+// texture of a batch that is loaded in the same loader thread.
+struct TextureUploadCommandBuffers {
+	VkCommandBuffer													primary_transfer			= {};
+	VkCommandBuffer													secondary_render			= {};	// VK_NULL_HANDLE until a texture of the loader thread needs blits.
+	VkCommandBuffer													primary_render				= {};	// VK_NULL_HANDLE if queue family handover is not needed.
+};
+
+
+
+// Uploads textures that were loaded together with a single set of GPU
+// submissions. Textures still decode in parallel in their own loader threads,
+// staging memory comes from the loader thread staging sub allocators, but
+// every texture of the batch in a loader thread records into the same command
+// buffers. Once the last texture of the batch is recorded everything is
+// submitted at once and a single fence tells when the whole batch is ready.
+class TextureUploadBatch :
+	public std::enable_shared_from_this<TextureUploadBatch>
+{
+public:
+																	TextureUploadBatch(
+		vk2d::_internal::InstanceImpl							*	instance,
+		std::function<void( const vk2d::TextureBatchLoadProgress & )>	progress_callback );
+
+																	~TextureUploadBatch();
+
+	// Call for every texture of the batch before any of them is scheduled to load.
+	void															AddTexture(
+		uint32_t													loader_thread );
+
+	// Called when a texture has been decoded into staging memory.
+	void															MTTextureDecoded();
+
+	// Gets command buffers to record a texture upload into, these are allocated
+	// and begun when the first texture of the batch is recorded in the loader
+	// thread. Secondary render command buffer is only created once a texture
+	// needs blits, batches of textures that don't are uploaded on the transfer
+	// queue alone. Returns false if command buffers could not be created.
+	bool															MTBeginTextureUpload(
+		uint32_t													loader_thread,
+		vk2d::_internal::ThreadLoaderResource					*	loader_thread_resource,
+		bool														is_blit_needed,
+		vk2d::_internal::TextureUploadCommandBuffers			&	out_command_buffers );
+
+	// Called once for every texture after it has recorded its upload or failed
+	// to load. Nothing may be recorded for the texture after this. Ends command
+	// buffers of the loader thread after its last texture and submits the batch
+	// after the last texture overall.
+	void															MTFinishTexture(
+		uint32_t													loader_thread,
+		bool														success );
+
+	// Non blocking, returns VK_NOT_READY until the batch has been submitted and
+	// the GPU has finished it.
+	VkResult														GetUploadStatus();
+
+	// Returns VK_TIMEOUT if the batch was not finished before timeout.
+	VkResult														WaitForUpload(
+		std::chrono::steady_clock::time_point						timeout );
+
+	// Runs in a general thread after submission, see TextureUploadBatchWaitTask.
+	void															WaitAndReportUploaded();
+
+private:
+	struct ThreadRecording {
+		vk2d::_internal::ThreadLoaderResource					*	loader_thread_resource		= {};
+		vk2d::_internal::TextureUploadCommandBuffers				command_buffers				= {};
+		uint32_t													remaining_texture_count		= {};
+		bool														is_recording				= {};
+		bool														is_recorded					= {};	// Ended successfully, can be submitted.
+		bool														is_allocation_failed		= {};
+		bool														is_end_failed				= {};
+	};
+
+	// Call with mutex locked.
+	bool															AllocateCommandBuffer(
+		VkCommandPool												command_pool,
+		VkCommandBuffer											&	out_command_buffer );
+
+	// Call with mutex locked.
+	void															EndCommandBuffers(
+		ThreadRecording											&	recording );
+
+	// Call with mutex locked, after every loader thread has ended recording.
+	VkResult														Submit();
+
+	void															ReportProgress();
+
+	vk2d::_internal::InstanceImpl								*	instance					= {};
+	VkDevice														vk_device					= {};
+	std::function<void( const vk2d::TextureBatchLoadProgress & )>	progress_callback			= {};
+
+	std::mutex														mutex;
+	std::vector<ThreadRecording>									thread_recordings			= {};	// Indexed by loader thread.
+	uint32_t														remaining_texture_count		= {};
+	uint32_t														submitted_texture_count		= {};
+
+	VkSemaphore														vk_transfer_semaphore		= {};
+	VkSemaphore														vk_blit_semaphore			= {};
+	VkFence															vk_upload_complete_fence	= {};
+	std::atomic<VkResult>											submit_result				= {};
+	vk2d::_internal::Fence											submitted;					// Set when Submit() has run, successfully or not.
+
+	std::mutex														progress_mutex;
+	std::atomic<uint32_t>											total_count					= {};
+	std::atomic<uint32_t>											decoded_count				= {};
+	std::atomic<uint32_t>											uploaded_count				= {};
+	std::atomic<uint32_t>											failed_count				= {};
+};
+
+
+
+} // _internal
+
+} // vk2d
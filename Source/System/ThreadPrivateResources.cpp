@@ -30,6 +30,16 @@ vk2d::_internal::DeviceMemoryPool * vk2d::_internal::ThreadLoaderResource::GetDe
 	return device_memory_pool.get();
 }
 
+vk2d::_internal::BufferSubAllocator * vk2d::_internal::ThreadLoaderResource::GetStagingBufferSubAllocator() const
+{
+	return staging_buffer_sub_allocator.get();
+}
+
+vk2d::_internal::StagingStream * vk2d::_internal::ThreadLoaderResource::GetStagingStream() const
+{
+	return staging_stream.get();
+}
+
 vk2d::_internal::DescriptorAutoPool * vk2d::_internal::ThreadLoaderResource::GetDescriptorAutoPool() const
 {
 	return descriptor_auto_pool.get();
@@ -55,6 +65,31 @@ FT_Library vk2d::_internal::ThreadLoaderResource::GetFreeTypeInstance() const
 	return freetype_instance;
 }
 
+void vk2d::_internal::ThreadLoaderResource::DeferredFreeCommandBuffer(
+	VkCommandPool			command_pool,
+	VkCommandBuffer			command_buffer
+)
+{
+	if( !command_buffer ) return;
+	deferred_command_buffer_frees.Push( { command_pool, command_buffer } );
+}
+
+void vk2d::_internal::ThreadLoaderResource::ProcessDeferredFrees()
+{
+	deferred_command_buffer_frees.Drain( [ this ]( std::pair<VkCommandPool, VkCommandBuffer> & f )
+		{
+			vkFreeCommandBuffers(
+				device,
+				f.first,
+				1, &f.second
+			);
+		} );
+
+	// Staging buffer pages return their memory to the device memory pool, process them first.
+	if( staging_buffer_sub_allocator ) staging_buffer_sub_allocator->ProcessDeferredFrees();
+	if( device_memory_pool ) device_memory_pool->ProcessDeferredFrees();
+}
+
 bool vk2d::_internal::ThreadLoaderResource::ThreadBegin()
 {
 	// Initialize Vulkan stuff here
@@ -150,6 +185,36 @@ bool vk2d::_internal::ThreadLoaderResource::ThreadBegin()
 		}
 	}
 
+	// Staging buffers, shared by all resources loaded in this thread.
+	{
+		staging_buffer_sub_allocator	= vk2d::_internal::CreateBufferSubAllocator(
+			device_memory_pool.get(),
+			vk2d::_internal::BufferUsageClass::STAGING
+		);
+		if( !staging_buffer_sub_allocator ) {
+			std::stringstream ss;
+			ss << "Internal error: Cannot create staging buffer sub allocator in thread: "
+				<< std::this_thread::get_id();
+			instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, ss.str() );
+			return false;
+		}
+	}
+
+	// Staging stream for images too large for staging buffers, its chunks come from the staging buffers above.
+	{
+		staging_stream		= std::make_unique<vk2d::_internal::StagingStream>(
+			instance,
+			staging_buffer_sub_allocator.get()
+		);
+		if( !staging_stream || !staging_stream->IsGood() ) {
+			std::stringstream ss;
+			ss << "Internal error: Cannot create staging stream in thread: "
+				<< std::this_thread::get_id();
+			instance->Report( vk2d::ReportSeverity::CRITICAL_ERROR, ss.str() );
+			return false;
+		}
+	}
+
 	// FreeType
 	{
 		auto ft_error = FT_Init_FreeType( &freetype_instance );
@@ -172,6 +237,9 @@ void vk2d::_internal::ThreadLoaderResource::ThreadEnd()
 	freetype_instance		= nullptr;
 
 	// De-initialize Vulkan stuff here
+	ProcessDeferredFrees();
+	staging_stream					= nullptr;
+	staging_buffer_sub_allocator	= nullptr;
 	device_memory_pool		= nullptr;
 	descriptor_auto_pool	= nullptr;
 
@@ -5,6 +5,8 @@
 #include "System/ThreadPool.h"
 #include "System/DescriptorSet.h"
 #include "System/VulkanMemoryManagement.h"
+#include "System/BufferSubAllocator.h"
+#include "System/StagingStream.h"
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -30,12 +32,24 @@ public:
 	vk2d::_internal::InstanceImpl							*	GetInstance() const;
 	VkDevice													GetVulkanDevice() const;
 	vk2d::_internal::DeviceMemoryPool						*	GetDeviceMemoryPool() const;
+	vk2d::_internal::BufferSubAllocator						*	GetStagingBufferSubAllocator() const;
+	vk2d::_internal::StagingStream							*	GetStagingStream() const;
 	vk2d::_internal::DescriptorAutoPool						*	GetDescriptorAutoPool() const;
 	VkCommandPool												GetPrimaryRenderCommandPool() const;
 	VkCommandPool												GetSecondaryRenderCommandPool() const;
 	VkCommandPool												GetPrimaryTransferCommandPool() const;
 	FT_Library													GetFreeTypeInstance() const;
 
+	// Can be called from any thread, command buffer is freed by this
+	// loader thread the next time it calls ProcessDeferredFrees().
+	void														DeferredFreeCommandBuffer(
+		VkCommandPool											command_pool,
+		VkCommandBuffer											command_buffer );
+
+	// Frees everything other threads have released to this thread's
+	// command pools and memory pools. Only call from this loader thread.
+	void														ProcessDeferredFrees();
+
 protected:
 	bool														ThreadBegin();
 	void														ThreadEnd();
@@ -45,12 +59,17 @@ private:
 	VkDevice													device								= {};
 	std::unique_ptr<vk2d::_internal::DescriptorAutoPool>		descriptor_auto_pool				= {};
 	std::unique_ptr<vk2d::_internal::DeviceMemoryPool>			device_memory_pool					= {};
+	std::unique_ptr<vk2d::_internal::BufferSubAllocator>		staging_buffer_sub_allocator		= {};
+	std::unique_ptr<vk2d::_internal::StagingStream>				staging_stream						= {};
 
 	VkCommandPool												primary_render_command_pool			= {};
 	VkCommandPool												secondary_render_command_pool		= {};
 	VkCommandPool												primary_transfer_command_pool		= {};
 
 	FT_Library													freetype_instance					= {};
+
+	vk2d::_internal::DeferredFreeQueue<std::pair<VkCommandPool, VkCommandBuffer>>
+																deferred_command_buffer_frees;
 };
 
 
@@ -61,6 +61,17 @@ VkMemoryRequirements GetImageMemoryRequirements(
 	return ret;
 }
 
+VkDeviceSize GetChunkUsedSize(
+	const vk2d::_internal::DeviceMemoryPoolChunk	&	chunk )
+{
+	// Dummy blocks at the front and back are zero sized so they don't affect this.
+	VkDeviceSize used_size = 0;
+	for( auto & b : chunk.blocks ) {
+		used_size		+= b.size;
+	}
+	return used_size;
+}
+
 void FreeChunkMemory(
 	VkDevice					device,
 	VkDeviceMemory				memory,
@@ -378,6 +389,193 @@ void vk2d::_internal::DeviceMemoryPool::FreeCompleteResource(
 	resource = {};
 }
 
+void vk2d::_internal::DeviceMemoryPool::DeferredFreeMemory(
+	vk2d::_internal::PoolMemory			&	memory )
+{
+	if( memory.isAllocated ) {
+		deferred_frees.Push( memory );
+	}
+	memory.isAllocated		= false;
+}
+
+void vk2d::_internal::DeviceMemoryPool::DeferredFreeCompleteResource(
+	vk2d::_internal::CompleteBufferResource		&	resource )
+{
+	vkDestroyBuffer(
+		data->refDevice,
+		resource.buffer,
+		nullptr
+	);
+	vkDestroyBufferView(
+		data->refDevice,
+		resource.view,
+		nullptr
+	);
+	DeferredFreeMemory( resource.memory );
+	resource = {};
+}
+
+void vk2d::_internal::DeviceMemoryPool::DeferredFreeCompleteResource(
+	vk2d::_internal::CompleteImageResource		&	resource )
+{
+	vkDestroyImage(
+		data->refDevice,
+		resource.image,
+		nullptr
+	);
+	vkDestroyImageView(
+		data->refDevice,
+		resource.view,
+		nullptr
+	);
+	DeferredFreeMemory( resource.memory );
+	resource = {};
+}
+
+void vk2d::_internal::DeviceMemoryPool::ProcessDeferredFrees()
+{
+	deferred_frees.Drain( [ this ]( vk2d::_internal::PoolMemory & memory )
+		{
+			FreeMemory( memory );
+		} );
+}
+
+bool vk2d::_internal::DeviceMemoryPool::IsDefragmentationCandidate(
+	const vk2d::_internal::PoolMemory			&	memory ) const
+{
+	if( !data ) return false;
+	if( !memory.isAllocated ) return false;
+
+	auto chunkGroup = GetChunkGroup( memory.isLinear, memory.memoryTypeIndex );
+	if( chunkGroup->size() < 2 ) return false;
+
+	// Find the least used chunk, compare with ratios so that dedicated
+	// chunks for very large allocations don't skew the selection.
+	const vk2d::_internal::DeviceMemoryPoolChunk	*	leastUsedChunk		= nullptr;
+	double												leastUsedRatio		= 1.0;
+	VkDeviceSize										leastUsedSize		= 0;
+	VkDeviceSize										totalFreeSize		= 0;
+	for( auto & c : *chunkGroup ) {
+		auto usedSize		= vk2d::_internal::GetChunkUsedSize( c );
+		auto usedRatio		= double( usedSize ) / double( c.size );
+		totalFreeSize		+= c.size - usedSize;
+		if( !leastUsedChunk || usedRatio < leastUsedRatio ) {
+			leastUsedChunk	= &c;
+			leastUsedRatio	= usedRatio;
+			leastUsedSize	= usedSize;
+		}
+	}
+
+	if( leastUsedChunk->id != memory.chunkID ) return false;
+	if( leastUsedRatio * 100.0 >= double( VK2D_BUILD_OPTION_MEMORY_DEFRAGMENTATION_CHUNK_USAGE_THRESHOLD ) ) return false;
+
+	// Free space is likely fragmented in the other chunks too, this is just an
+	// early out, actual placement is checked when the new memory is allocated.
+	auto otherFreeSize	= totalFreeSize - ( leastUsedChunk->size - leastUsedSize );
+	return otherFreeSize >= memory.size;
+}
+
+vk2d::_internal::CompleteImageResource vk2d::_internal::DeviceMemoryPool::CreateCompleteImageResourceForRelocation(
+	const vk2d::_internal::PoolMemory		&	relocate_from,
+	const VkImageCreateInfo					*	pImageCreateInfo,
+	VkMemoryPropertyFlags						propertyFlags,
+	const VkImageViewCreateInfo				*	pImageViewCreateInfo )
+{
+	assert( relocate_from.isAllocated );
+
+	VkImage object {};
+	auto result = vkCreateImage(
+		data->refDevice,
+		pImageCreateInfo,
+		nullptr,
+		&object
+	);
+	if( result != VK_SUCCESS ) {
+		return { result };
+	}
+
+	auto memoryRequirements			= vk2d::_internal::GetImageMemoryRequirements( data->refDevice, object );
+	auto memoryTypeIndex			= vk2d::_internal::FindMemoryTypeIndex( data->physicalDeviceMemoryProperties, memoryRequirements, propertyFlags );
+	vk2d::_internal::PoolMemory pool_memory {};
+	if( memoryTypeIndex != UINT32_MAX ) {
+		pool_memory = AllocateMemory(
+			pImageCreateInfo->tiling != VK_IMAGE_TILING_OPTIMAL,
+			memoryRequirements,
+			memoryTypeIndex,
+			relocate_from.chunkID,
+			false
+		);
+	}
+	if( pool_memory == VK_SUCCESS ) {
+		result = vkBindImageMemory(
+			data->refDevice,
+			object,
+			pool_memory.memory,
+			pool_memory.offset
+		);
+		if( result != VK_SUCCESS ) {
+			FreeMemory( pool_memory );
+			pool_memory.result = result;
+		}
+	}
+	if( pool_memory != VK_SUCCESS ) {
+		vkDestroyImage(
+			data->refDevice,
+			object,
+			nullptr
+		);
+		return { pool_memory.result };
+	}
+
+	VkImageView view {};
+	if( pImageViewCreateInfo ) {
+		VkImageViewCreateInfo view_create_info	= *pImageViewCreateInfo;
+		view_create_info.image					= object;
+		result = vkCreateImageView(
+			data->refDevice,
+			&view_create_info,
+			nullptr,
+			&view
+		);
+		if( result != VK_SUCCESS ) {
+			vkDestroyImage(
+				data->refDevice,
+				object,
+				nullptr
+			);
+			FreeMemory( pool_memory );
+			return { result };
+		}
+	}
+
+	vk2d::_internal::CompleteImageResource resource {};
+	resource.result			= VK_SUCCESS;
+	resource.image			= object;
+	resource.view			= view;
+	resource.memory			= pool_memory;
+	return resource;
+}
+
+vk2d::_internal::DeviceMemoryPoolStatistics vk2d::_internal::DeviceMemoryPool::GetStatistics() const
+{
+	vk2d::_internal::DeviceMemoryPoolStatistics statistics {};
+	if( !data ) return statistics;
+
+	auto CollectStatistics = [ &statistics ]( const std::vector<std::list<vk2d::_internal::DeviceMemoryPoolChunk>> & chunkGroups )
+	{
+		for( auto & g : chunkGroups ) {
+			for( auto & c : g ) {
+				++statistics.chunk_count;
+				statistics.reserved_size	+= c.size;
+				statistics.used_size		+= vk2d::_internal::GetChunkUsedSize( c );
+			}
+		}
+	};
+	CollectStatistics( data->linearChunks );
+	CollectStatistics( data->nonLinearChunks );
+	return statistics;
+}
+
 VkPhysicalDeviceProperties emptyVkPhysicalDeviceProperties {};
 const VkPhysicalDeviceProperties & vk2d::_internal::DeviceMemoryPool::GetPhysicalDeviceProperties()
 {
@@ -414,12 +612,34 @@ std::pair<VkResult, vk2d::_internal::DeviceMemoryPoolChunk*> vk2d::_internal::De
 		return { result, nullptr };
 	}
 
+	// Host visible memory gets mapped once for the lifetime of the chunk, a chunk
+	// is shared between many allocations and Vulkan doesn't allow mapping the
+	// same memory object more than once at a time.
+	auto memoryPropertyFlags	= data->physicalDeviceMemoryProperties.memoryTypes[ memoryTypeIndex ].propertyFlags;
+	void * mapped_data			= nullptr;
+	if( memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) {
+		result = vkMapMemory(
+			data->refDevice,
+			memory,
+			0,
+			VK_WHOLE_SIZE,
+			0,
+			&mapped_data
+		);
+		if( result != VK_SUCCESS ) {
+			vk2d::_internal::FreeChunkMemory( data->refDevice, memory, nullptr );
+			return { result, nullptr };
+		}
+	}
+
 	chunkGroup->push_back( vk2d::_internal::DeviceMemoryPoolChunk() );
 	auto new_chunk		= &chunkGroup->back();
 	new_chunk->id		= data->chunkIDCounter;
 	new_chunk->memory	= memory;
 	new_chunk->size		= size;
 	new_chunk->result	= result;
+	new_chunk->mapped_data		= mapped_data;
+	new_chunk->isHostCoherent	= !!( memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
 	// To make make the code more compact we're going to push some dummy limits in front and back.
 	// This will make sure we don't have to check if we're at the front or back of the list when searching for a free spot
 	new_chunk->blocks.push_front( { UINT64_MAX, 0, 0, 1 } );
@@ -461,27 +681,34 @@ vk2d::_internal::DeviceMemoryPoolChunk::Block * vk2d::_internal::DeviceMemoryPoo
 vk2d::_internal::PoolMemory vk2d::_internal::DeviceMemoryPool::AllocateMemory(
 	bool					isLinear,
 	VkMemoryRequirements	memoryRequirements,
-	uint32_t				memoryTypeIndex )
+	uint32_t				memoryTypeIndex,
+	uint64_t				excludeChunkID,
+	bool					allowNewChunk )
 {
 	// TODO: add tests and error reports
 
 	assert( memoryTypeIndex != UINT32_MAX );
 
-	std::list<vk2d::_internal::DeviceMemoryPoolChunk>	*	chunkGroup		= nullptr;
-	if( isLinear ) {
-		chunkGroup		= &data->linearChunks[ memoryTypeIndex ];
-	} else {
-		chunkGroup		= &data->nonLinearChunks[ memoryTypeIndex ];
-	}
+	// Memory freed by other threads may make room for this allocation.
+	ProcessDeferredFrees();
+
+	auto chunkGroup		= GetChunkGroup( isLinear, memoryTypeIndex );
 
 	vk2d::_internal::DeviceMemoryPoolChunk			*	selectedChunk	= nullptr;
 	vk2d::_internal::DeviceMemoryPoolChunk::Block	*	selectedBlock	= nullptr;
 	for( auto & c : *chunkGroup ) {
+		if( c.id == excludeChunkID ) continue;
 		selectedChunk	= &c;
 		selectedBlock					= AllocateBlockInChunk( selectedChunk, memoryRequirements );
 		if( selectedBlock ) break;
 	}
 
+	if( !selectedBlock && !allowNewChunk ) {
+		vk2d::_internal::PoolMemory pm {};
+		pm.result		= VK_ERROR_OUT_OF_DEVICE_MEMORY;
+		return pm;
+	}
+
 	// no chunks with free space, allocate a new chunk from the device
 	if( !selectedBlock ) {
 		auto				bufferImageGranularity	= data->physicalDeviceProperties.limits.bufferImageGranularity;
@@ -519,15 +746,32 @@ vk2d::_internal::PoolMemory vk2d::_internal::DeviceMemoryPool::AllocateMemory(
 	ret.offset				= selectedBlock->offset;
 	ret.size				= selectedBlock->size;
 	ret.alignment			= selectedBlock->alignment;
+	ret.chunkSize			= selectedChunk->size;
 	ret.chunkID				= selectedChunk->id;
 	ret.blockID				= selectedBlock->id;
 	ret.memoryTypeIndex		= memoryTypeIndex;
 	ret.result				= selectedChunk->result;
 	ret.isLinear			= isLinear;
 	ret.isAllocated			= true;
+	ret.isHostCoherent		= selectedChunk->isHostCoherent;
+	if( selectedChunk->mapped_data ) {
+		ret.mapped_data		= reinterpret_cast<uint8_t*>( selectedChunk->mapped_data ) + selectedBlock->offset;
+	}
 	return ret;
 }
 
+std::list<vk2d::_internal::DeviceMemoryPoolChunk> * vk2d::_internal::DeviceMemoryPool::GetChunkGroup(
+	bool		isLinear,
+	uint32_t	memoryTypeIndex
+) const
+{
+	if( isLinear ) {
+		return &data->linearChunks[ memoryTypeIndex ];
+	} else {
+		return &data->nonLinearChunks[ memoryTypeIndex ];
+	}
+}
+
 void vk2d::_internal::DeviceMemoryPool::FreeChunk(
 	std::list<vk2d::_internal::DeviceMemoryPoolChunk>	*	chunkGroup,
 	vk2d::_internal::DeviceMemoryPoolChunk				*	chunk
@@ -554,12 +798,7 @@ void vk2d::_internal::DeviceMemoryPool::FreeBlock(
 	assert( chunkID != UINT64_MAX );
 	assert( blockID != UINT64_MAX );
 
-	std::list<vk2d::_internal::DeviceMemoryPoolChunk>	*	chunkGroup		= nullptr;
-	if( isLinear ) {
-		chunkGroup						= &data->linearChunks[ memoryTypeIndex ];
-	} else {
-		chunkGroup						= &data->nonLinearChunks[ memoryTypeIndex ];
-	}
+	auto chunkGroup						= GetChunkGroup( isLinear, memoryTypeIndex );
 
 	vk2d::_internal::DeviceMemoryPoolChunk				*	selectedChunk	= nullptr;
 	for( auto & c : *chunkGroup ) {
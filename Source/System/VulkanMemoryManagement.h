@@ -2,6 +2,8 @@
 
 #include "Core/SourceCommon.h"
 
+#include "Types/Synchronization.hpp"
+
 
 
 namespace vk2d {
@@ -39,6 +41,11 @@ struct DeviceMemoryPoolChunk {
 	::std::list<vk2d::_internal::DeviceMemoryPoolChunk::Block>		blocks;
 	VkResult														result								= VK_RESULT_MAX_ENUM;
 
+	// Host visible chunks are mapped once when allocated and stay mapped until
+	// the chunk is freed, blocks get their pointers from this with an offset.
+	void														*	mapped_data							= {};
+	bool															isHostCoherent						= {};
+
 	uint64_t														blockIDCounter						= 0;
 };
 
@@ -60,6 +67,15 @@ struct DeviceMemoryPoolDataImpl {
 
 
 
+// Snapshot of how much memory a pool holds and how much of it is in use.
+struct DeviceMemoryPoolStatistics {
+	uint64_t										chunk_count							= {};
+	VkDeviceSize									reserved_size						= {};	// Total size of all chunks.
+	VkDeviceSize									used_size							= {};	// Total size of all blocks.
+};
+
+
+
 class PoolMemory {
 	friend class vk2d::_internal::DeviceMemoryPool;
 
@@ -70,6 +86,7 @@ private:
 	VkDeviceSize									offset								= 0;
 	VkDeviceSize									size								= 0;
 	VkDeviceSize									alignment							= 0;
+	VkDeviceSize									chunkSize							= 0;
 
 	uint64_t										chunkID								= UINT64_MAX;
 	uint64_t										blockID								= UINT64_MAX;
@@ -77,32 +94,65 @@ private:
 	VkResult										result								= VkResult( INT32_MIN );
 	bool											isLinear							= true;
 	bool											isAllocated							= false;
+	bool											isHostCoherent						= false;
+
+	void										*	mapped_data							= {};
 
 public:
-	// Can only map this memory if the memory is host visible
+	// Can only map this memory if the memory is host visible.
+	// Host visible memory is persistently mapped by the pool so this
+	// does not call vkMapMemory, it only returns a pointer to the
+	// beginning of this allocation. Returns nullptr if not host visible.
 	template<typename T>
 	inline T *										Map()
 	{
-		void * mapped_memory {};
-		if( vkMapMemory(
-			allocated_from->refDevice,
-			memory,
-			offset,
-			size,
-			0,
-			&mapped_memory
-		) != VK_SUCCESS ) {
-			return nullptr;
-		}
-		return reinterpret_cast<T*>( mapped_memory );
+		return reinterpret_cast<T*>( mapped_data );
 	}
 
+	// Memory stays mapped, this only makes host writes visible
+	// to the device if the memory is not host coherent.
 	inline void										Unmap()
 	{
-		vkUnmapMemory(
-			allocated_from->refDevice,
-			memory
-		);
+		Flush( 0, size );
+	}
+
+	// Makes host writes to a range of this allocation visible to the device
+	// if the memory is not host coherent. Offset is from the beginning of
+	// this allocation.
+	inline void										Flush(
+		VkDeviceSize								range_offset,
+		VkDeviceSize								range_size )
+	{
+		if( mapped_data && !isHostCoherent && range_size ) {
+			auto range		= GetMappedMemoryRange( range_offset, range_size );
+			vkFlushMappedMemoryRanges(
+				allocated_from->refDevice,
+				1, &range
+			);
+		}
+	}
+
+	// Makes device writes visible to the host if the memory is not
+	// host coherent, call before reading what the device wrote.
+	inline void										Invalidate()
+	{
+		Invalidate( 0, size );
+	}
+
+	// Makes device writes to a range of this allocation visible to the host
+	// if the memory is not host coherent. Offset is from the beginning of
+	// this allocation.
+	inline void										Invalidate(
+		VkDeviceSize								range_offset,
+		VkDeviceSize								range_size )
+	{
+		if( mapped_data && !isHostCoherent && range_size ) {
+			auto range		= GetMappedMemoryRange( range_offset, range_size );
+			vkInvalidateMappedMemoryRanges(
+				allocated_from->refDevice,
+				1, &range
+			);
+		}
 	}
 
 	// Can only copy to this memory if the memory is host visible
@@ -124,7 +174,7 @@ public:
 
 		VkDeviceSize	byte_size	= sizeof( T ) * count;
 		std::memcpy( mapped_data, data, byte_size );
-		Unmap();
+		Flush( 0, byte_size );
 		return VK_SUCCESS;
 	}
 
@@ -148,6 +198,26 @@ public:
 	{
 		return result;
 	};
+
+private:
+	// Flushed and invalidated ranges of memory that is not host coherent must
+	// be multiples of nonCoherentAtomSize or reach the end of the memory object.
+	inline VkMappedMemoryRange						GetMappedMemoryRange(
+		VkDeviceSize								range_offset,
+		VkDeviceSize								range_size ) const
+	{
+		auto atom_size		= allocated_from->physicalDeviceProperties.limits.nonCoherentAtomSize;
+		auto begin			= ( offset + range_offset ) / atom_size * atom_size;
+		auto end			= ( offset + range_offset + range_size + atom_size - 1 ) / atom_size * atom_size;
+
+		VkMappedMemoryRange range {};
+		range.sType		= VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+		range.pNext		= nullptr;
+		range.memory	= memory;
+		range.offset	= begin;
+		range.size		= end < chunkSize ? end - begin : VK_WHOLE_SIZE;
+		return range;
+	}
 };
 
 class CompleteBufferResource {
@@ -319,6 +389,40 @@ public:
 	void																	FreeCompleteResource(
 		vk2d::_internal::CompleteImageResource							&	resource );
 
+	// Deferred versions of the free functions above, these can be called from any thread.
+	// Vulkan objects are destroyed right away, memory is returned to the pool by the thread
+	// that owns this pool the next time it allocates or calls ProcessDeferredFrees().
+	void																	DeferredFreeMemory(
+		vk2d::_internal::PoolMemory										&	memory );
+
+	void																	DeferredFreeCompleteResource(
+		vk2d::_internal::CompleteBufferResource							&	resource );
+
+	void																	DeferredFreeCompleteResource(
+		vk2d::_internal::CompleteImageResource							&	resource );
+
+	// Returns memory freed by other threads back to the pool.
+	// Only call this from the thread that owns this pool.
+	void																	ProcessDeferredFrees();
+
+	// Checks if memory lives in a chunk that defragmentation should empty, that is
+	// the least used chunk of its kind, below the usage threshold, and the other
+	// chunks of the same kind have enough free space to take this allocation.
+	bool																	IsDefragmentationCandidate(
+		const vk2d::_internal::PoolMemory								&	memory ) const;
+
+	// Creates a new image to move an existing image into. Memory is allocated from
+	// an existing chunk other than the one the old memory is in, new chunks are never
+	// allocated. Does not copy or free anything, caller is responsible for copying
+	// the image contents and freeing the old image once the GPU is done with it.
+	vk2d::_internal::CompleteImageResource									CreateCompleteImageResourceForRelocation(
+		const vk2d::_internal::PoolMemory								&	relocate_from,
+		const VkImageCreateInfo											*	pImageCreateInfo,
+		VkMemoryPropertyFlags												propertyFlags,
+		const VkImageViewCreateInfo										*	pImageViewCreateInfo				= nullptr );
+
+	vk2d::_internal::DeviceMemoryPoolStatistics								GetStatistics() const;
+
 	const VkPhysicalDeviceProperties									&	GetPhysicalDeviceProperties();
 	const VkPhysicalDeviceMemoryProperties								&	GetPhysicalDeviceMemoryProperties();
 
@@ -332,10 +436,18 @@ private:
 		vk2d::_internal::DeviceMemoryPoolChunk							*	chunk,
 		VkMemoryRequirements											&	rMemoryRequirements );
 
+	// If excludeChunkID is given, memory is never allocated from that chunk. If
+	// allowNewChunk is false, allocation fails instead of allocating a new chunk.
 	vk2d::_internal::PoolMemory												AllocateMemory(
 		bool																isLinear,
 		VkMemoryRequirements												memoryRequirements,
-		uint32_t															memoryTypeIndex );
+		uint32_t															memoryTypeIndex,
+		uint64_t															excludeChunkID						= UINT64_MAX,
+		bool																allowNewChunk						= true );
+
+	std::list<vk2d::_internal::DeviceMemoryPoolChunk>					*	GetChunkGroup(
+		bool																isLinear,
+		uint32_t															memoryTypeIndex ) const;
 
 	void																	FreeChunk(
 		std::list<vk2d::_internal::DeviceMemoryPoolChunk>				*	chunkGroup,
@@ -348,6 +460,7 @@ private:
 		uint64_t															blockID );
 
 	std::unique_ptr<vk2d::_internal::DeviceMemoryPoolDataImpl>				data						= {};
+	vk2d::_internal::DeferredFreeQueue<vk2d::_internal::PoolMemory>			deferred_frees;
 
 	bool																	is_good								= {};
 };
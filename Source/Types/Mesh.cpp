@@ -1135,7 +1135,16 @@ VK2D_API vk2d::Mesh VK2D_APIENTRY vk2d::GenerateTextMesh(
 		if( fi->GetStatus() == vk2d::ResourceStatus::UNDETERMINED ) return {};
 	}
 	if( !fi->FaceExists( font_face ) ) return {};
-	
+
+	// Glyphs loaded on demand are added to the atlas here, the texture has them
+	// uploaded after that. Glyphs on atlas pages the texture doesn't have yet
+	// are left out until the font has loaded a larger texture.
+	for( auto c : text ) {
+		fi->GetGlyphInfo( font_face, c );
+	}
+	auto texture			= fi->GetTextureResource();
+	auto texture_layers		= texture ? texture->GetLayerCount() : 0;
+
 	vk2d::Mesh ret;
 	ret.vertices.reserve( text.size() * 4 );
 	ret.indices.reserve( text.size() * 6 );
@@ -1204,7 +1213,9 @@ VK2D_API vk2d::Mesh VK2D_APIENTRY vk2d::GenerateTextMesh(
 		}
 		for( auto c : text ) {
 			auto gi = fi->GetGlyphInfo( font_face, c );
-			AppendBox( location, gi->vertical_coords, gi->uv_coords, gi->atlas_index );
+			if( gi->atlas_index < texture_layers ) {
+				AppendBox( location, gi->vertical_coords, gi->uv_coords, gi->atlas_index );
+			}
 			location.y	+= ( gi->vertical_advance + kerning ) * scale.y;
 		}
 	} else {
@@ -1216,11 +1227,13 @@ VK2D_API vk2d::Mesh VK2D_APIENTRY vk2d::GenerateTextMesh(
 		}
 		for( auto c : text ) {
 			auto gi = fi->GetGlyphInfo( font_face, c );
-			AppendBox( location, gi->horisontal_coords, gi->uv_coords, gi->atlas_index );
+			if( gi->atlas_index < texture_layers ) {
+				AppendBox( location, gi->horisontal_coords, gi->uv_coords, gi->atlas_index );
+			}
 			location.x	+= ( gi->horisontal_advance + kerning ) * scale.x;
 		}
 	}
 
-	ret.SetTexture( fi->GetTextureResource() );
+	ret.SetTexture( texture );
 	return ret;
 }
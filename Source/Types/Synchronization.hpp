@@ -122,5 +122,82 @@ private:
 
 
 
+/// @brief		Lock-free multiple producer, single consumer queue used to hand objects back to
+///				the thread that owns them. Any thread may push, only the owning thread may drain.
+///				Draining takes the whole queue at once, objects are processed in push order.
+/// @tparam		T
+///				Type of object pushed into the queue, must be movable.
+template<typename T>
+class DeferredFreeQueue
+{
+public:
+	DeferredFreeQueue()										= default;
+	DeferredFreeQueue( const DeferredFreeQueue & other )	= delete;
+	DeferredFreeQueue( DeferredFreeQueue && other )			= delete;
+
+	~DeferredFreeQueue()
+	{
+		// Owner should have drained the queue by now, whatever is left is just released.
+		Drain( []( T & ) {} );
+	}
+
+	/// @brief		Adds an object to the queue, can be called from any thread.
+	/// @param		value
+	///				Object to be processed later by the owning thread.
+	void							Push(
+		T							value )
+	{
+		auto node		= new Node { std::move( value ), head.load( std::memory_order_relaxed ) };
+		while( !head.compare_exchange_weak(
+			node->next,
+			node,
+			std::memory_order_release,
+			std::memory_order_relaxed ) );
+	}
+
+	/// @brief		Tests without locking if there is anything in the queue.
+	/// @return		true if queue is empty, false otherwise.
+	bool							IsEmpty() const
+	{
+		return !head.load( std::memory_order_relaxed );
+	}
+
+	/// @brief		Removes all objects from the queue and calls a function for each of them.
+	///				Only call this from the owning thread.
+	/// @param		function
+	///				Called once per object in push order, takes T & as parameter.
+	template<typename FunctionT>
+	void							Drain(
+		FunctionT					function )
+	{
+		auto list		= head.exchange( nullptr, std::memory_order_acquire );
+
+		// List is in reverse push order, reverse it back.
+		Node * ordered	= nullptr;
+		while( list ) {
+			auto next		= list->next;
+			list->next		= ordered;
+			ordered			= list;
+			list			= next;
+		}
+		while( ordered ) {
+			auto next		= ordered->next;
+			function( ordered->value );
+			delete ordered;
+			ordered			= next;
+		}
+	}
+
+private:
+	struct Node {
+		T							value;
+		Node					*	next;
+	};
+
+	std::atomic<Node*>				head					= {};
+};
+
+
+
 } // _internal
 } // vk2d
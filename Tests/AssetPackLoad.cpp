@@ -0,0 +1,162 @@
+
+#include <System/AssetPack.hpp>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <fstream>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Compares reading many small loose files to finding them from a memory mapped
+// asset pack, and checks that the pack returns the same contents as the files.
+// "first" is the first pass over freshly written files, these are likely still
+// in the operating system file cache so this is not a true cold start, "repeat"
+// is a second pass. Times are printed, only content mismatches fail the test.
+
+
+
+constexpr size_t FILE_COUNT				= 2000;
+
+
+
+// Sum of all bytes so the work can't be optimized away.
+uint64_t Touch( const void * data, size_t size )
+{
+	uint64_t sum = 0;
+	auto bytes = reinterpret_cast<const uint8_t*>( data );
+	for( size_t i = 0; i < size; ++i ) sum += bytes[ i ];
+	return sum;
+}
+
+string GetFilePath( size_t index )
+{
+	return "Textures/" + to_string( index % 16 ) + "/Texture" + to_string( index ) + ".bin";
+}
+
+double LoadLooseFiles( const filesystem::path & root, uint64_t & out_sum )
+{
+	auto begin = chrono::steady_clock::now();
+	out_sum = 0;
+	vector<char> data;
+	for( size_t i = 0; i < FILE_COUNT; ++i ) {
+		ifstream file( root / GetFilePath( i ), ios::binary | ios::ate );
+		if( !file ) Fail( "Cannot open loose file.", ExitCodes::CANNOT_READ_FILE );
+		data.resize( size_t( file.tellg() ) );
+		file.seekg( 0 );
+		file.read( data.data(), streamsize( data.size() ) );
+		out_sum += Touch( data.data(), data.size() );
+	}
+	return chrono::duration<double, milli>( chrono::steady_clock::now() - begin ).count();
+}
+
+double LoadPackedFiles( const filesystem::path & pack_path, uint64_t & out_sum )
+{
+	auto begin = chrono::steady_clock::now();
+	out_sum = 0;
+	_internal::AssetPack pack( pack_path );
+	if( !pack.IsGood() ) Fail( "Cannot open asset pack.", ExitCodes::CANNOT_READ_FILE );
+	for( size_t i = 0; i < FILE_COUNT; ++i ) {
+		_internal::AssetPackItem item {};
+		if( !pack.Find( GetFilePath( i ), item ) ) Fail( "File not found from asset pack." );
+		out_sum += Touch( item.data, item.size );
+	}
+	return chrono::duration<double, milli>( chrono::steady_clock::now() - begin ).count();
+}
+
+void ContentCheck( const filesystem::path & root, const filesystem::path & pack_path )
+{
+	_internal::AssetPack pack( pack_path );
+	if( !pack.IsGood() ) Fail( "Cannot open asset pack.", ExitCodes::CANNOT_READ_FILE );
+	if( pack.GetEntryCount() != FILE_COUNT + 1 ) Fail( "Wrong asset pack entry count." );
+
+	for( size_t i = 0; i < FILE_COUNT; i += 97 ) {
+		ifstream file( root / GetFilePath( i ), ios::binary );
+		vector<char> data( ( istreambuf_iterator<char>( file ) ), istreambuf_iterator<char>() );
+
+		_internal::AssetPackItem item {};
+		if( !pack.Find( "./" + GetFilePath( i ), item ) ) Fail( "Path not normalized when searching." );
+		if( item.payload != _internal::AssetPackPayload::ENCODED ) Fail( "Wrong payload type." );
+		if( item.size != data.size() || memcmp( item.data, data.data(), data.size() ) ) Fail( "Asset pack content does not match file." );
+		if( uintptr_t( item.data ) % _internal::ASSET_PACK_DATA_ALIGNMENT ) Fail( "Asset pack data not aligned." );
+	}
+
+	_internal::AssetPackItem item {};
+	if( pack.Find( "Textures/Missing.bin", item ) ) Fail( "Found file that is not in the asset pack." );
+	if( !pack.Find( "Raw.bin", item ) ) Fail( "Raw texels not found." );
+	if( item.payload != _internal::AssetPackPayload::RAW_RGBA8 || item.width != 4 || item.height != 2 || item.size != 4 * 2 * 4 ) {
+		Fail( "Raw texel entry is wrong." );
+	}
+
+	// Broken pack must be rejected, not crash.
+	auto broken_path = pack_path;
+	broken_path.replace_extension( ".broken" );
+	filesystem::copy_file( pack_path, broken_path, filesystem::copy_options::overwrite_existing );
+	filesystem::resize_file( broken_path, filesystem::file_size( pack_path ) / 2 );
+	if( _internal::AssetPack( broken_path ).IsGood() ) Fail( "Truncated asset pack accepted." );
+}
+
+
+
+int main()
+{
+	auto root = filesystem::temp_directory_path() / "VK2DAssetPackLoad";
+	filesystem::remove_all( root );
+
+	vector<_internal::AssetPackSourceEntry> source_entries;
+	mt19937 random( 1234 );
+	uniform_int_distribution<size_t> file_size( 256, 16 * 1024 );
+	for( size_t i = 0; i < FILE_COUNT; ++i ) {
+		_internal::AssetPackSourceEntry entry {};
+		entry.path		= GetFilePath( i );
+		entry.payload	= _internal::AssetPackPayload::ENCODED;
+		entry.data.resize( file_size( random ) );
+		for( auto & b : entry.data ) b = uint8_t( random() );
+
+		filesystem::create_directories( ( root / entry.path ).parent_path() );
+		ofstream( root / entry.path, ios::binary ).write( reinterpret_cast<const char*>( entry.data.data() ), streamsize( entry.data.size() ) );
+		source_entries.push_back( std::move( entry ) );
+	}
+	{
+		_internal::AssetPackSourceEntry entry {};
+		entry.path		= "Raw.bin";
+		entry.payload	= _internal::AssetPackPayload::RAW_RGBA8;
+		entry.width		= 4;
+		entry.height	= 2;
+		entry.data.resize( 4 * 2 * 4 );
+		source_entries.push_back( std::move( entry ) );
+	}
+	auto duplicate_entries = vector<_internal::AssetPackSourceEntry>( 2 );
+	duplicate_entries[ 0 ].path = "a.bin";
+	duplicate_entries[ 1 ].path = "./a.bin";
+	if( _internal::WriteAssetPack( root / "Duplicate.pak", duplicate_entries ) ) Fail( "Duplicate paths accepted." );
+
+	auto pack_path = root / "Assets.pak";
+	if( !_internal::WriteAssetPack( pack_path, std::move( source_entries ) ) ) Fail( "Cannot write asset pack.", ExitCodes::CANNOT_WRITE_FILE );
+
+	ContentCheck( root, pack_path );
+
+	cout << fixed << setprecision( 1 );
+	cout << FILE_COUNT << " small files, milliseconds\n";
+	cout << setw( 10 ) << "pass" << setw( 14 ) << "loose files" << setw( 14 ) << "asset pack" << "\n";
+	for( auto pass : { "first", "repeat" } ) {
+		uint64_t loose_sum = 0;
+		uint64_t packed_sum = 0;
+		auto loose_time		= LoadLooseFiles( root, loose_sum );
+		auto packed_time	= LoadPackedFiles( pack_path, packed_sum );
+		if( loose_sum != packed_sum ) Fail( "Asset pack contents differ from loose files." );
+
+		cout << setw( 10 ) << pass << setw( 14 ) << loose_time << setw( 14 ) << packed_time << "\n";
+	}
+	cout << "\n";
+
+	filesystem::remove_all( root );
+
+	return 0;
+}
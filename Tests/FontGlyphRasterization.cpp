@@ -0,0 +1,75 @@
+
+#include <VK2D.h>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Loads the same font from a file and from memory. Glyphs are rendered in
+// parallel but placed into the atlas in glyph order, so both loads must end
+// up with identical glyph metrics. Prints glyph rasterization wall time next
+// to the time summed over every thread, which is the single threaded baseline.
+
+
+
+const filesystem::path FONT_PATH = filesystem::path( VK2D_TEST_DATA_DIRECTORY ) / "Fonts/ubuntu-font-family-0.83/Ubuntu-R.ttf";
+
+
+
+double ToMilliseconds( chrono::nanoseconds duration )
+{
+	return chrono::duration<double, milli>( duration ).count();
+}
+
+
+
+int main()
+{
+	InstanceCreateInfo instance_create_info {};
+	auto instance = CreateInstance( instance_create_info );
+	if( !instance ) ExitWithCode( ExitCodes::CANNOT_CREATE_INSTANCE );
+
+	vector<char> font_file;
+	{
+		ifstream file( FONT_PATH, ios::binary | ios::ate );
+		if( !file ) ExitWithCode( ExitCodes::CANNOT_READ_FILE );
+		font_file.resize( size_t( file.tellg() ) );
+		file.seekg( 0 );
+		file.read( font_file.data(), streamsize( font_file.size() ) );
+		if( !file ) ExitWithCode( ExitCodes::CANNOT_READ_FILE );
+	}
+
+	auto resource_manager	= instance->GetResourceManager();
+	auto file_font			= resource_manager->LoadFontResource( FONT_PATH );
+	auto memory_font		= resource_manager->LoadFontResourceFromMemory( font_file.data(), font_file.size() );
+	if( !file_font || file_font->WaitUntilLoaded() != ResourceStatus::LOADED ) Fail( "Cannot load font from file.", ExitCodes::CANNOT_READ_FILE );
+	if( !memory_font || memory_font->WaitUntilLoaded() != ResourceStatus::LOADED ) Fail( "Cannot load font from memory.", ExitCodes::CANNOT_READ_FILE );
+
+	for( auto font : { file_font, memory_font } ) {
+		auto timing = font->GetLoadTiming();
+		if( timing.glyph_rasterization.count() <= 0 || timing.glyph_rasterization_thread_total.count() <= 0 ) Fail( "Glyph rasterization was not timed." );
+		cout << "Test: Glyph rasterization " << ToMilliseconds( timing.glyph_rasterization ) << " ms, "
+			<< ToMilliseconds( timing.glyph_rasterization_thread_total ) << " ms on a single thread.\n";
+	}
+
+	for( auto text : { "The quick brown fox jumps over the lazy dog", "0123456789 !?*", "W" } ) {
+		for( auto vertical : { false, true } ) {
+			auto file_size		= file_font->CalculateRenderedSize( text, 0.0f, { 1.0f, 1.0f }, vertical );
+			auto memory_size	= memory_font->CalculateRenderedSize( text, 0.0f, { 1.0f, 1.0f }, vertical );
+			if( file_size.top_left != memory_size.top_left || file_size.bottom_right != memory_size.bottom_right ) {
+				Fail( "Fonts loaded from the same file have different glyph metrics." );
+			}
+		}
+	}
+
+	ExitWithCode( ExitCodes::SUCCESS );
+}
@@ -0,0 +1,153 @@
+
+#include <VK2D.h>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Loads a font that renders glyphs on demand next to one that renders every
+// glyph while loading and prints how long rendering glyphs took for both.
+// Text measured before and after its glyphs are in the atlas must be the same
+// size. Text generated on the main thread uploads its new glyphs, a
+// screenshot checks that the text actually shows up. A font with small atlas
+// pages gets enough glyphs to need a larger texture, glyphs added while that
+// texture loads must show up once the font has switched to it.
+
+
+
+const filesystem::path FONT_PATH = filesystem::path( VK2D_TEST_DATA_DIRECTORY ) / "Fonts/ubuntu-font-family-0.83/Ubuntu-R.ttf";
+
+constexpr uint32_t WINDOW_SIZE				= 512;
+
+const Vector2f TEXT_ORIGIN { 32.0f, 256.0f };
+const char * TEXT = "Quick brown fox";
+
+// Printable ASCII fills 3 atlas pages at this size and padding.
+constexpr uint32_t GROWTH_GLYPH_SIZE		= 20;
+constexpr uint32_t GROWTH_GLYPH_PADDING		= 4;
+const Vector2f LATE_TEXT_ORIGIN { 32.0f, 384.0f };
+const string LATE_TEXT = "WM@&#%";
+
+
+
+double ToMilliseconds( chrono::nanoseconds duration )
+{
+	return chrono::duration<double, milli>( duration ).count();
+}
+
+uint32_t CountLitTexels( const ImageData & image, Rect2f area )
+{
+	// Glyphs are white on black.
+	uint32_t lit_count = 0;
+	for( uint32_t y = uint32_t( area.top_left.y ); y < uint32_t( area.bottom_right.y ); ++y ) {
+		for( uint32_t x = uint32_t( area.top_left.x ); x < uint32_t( area.bottom_right.x ); ++x ) {
+			if( image.data[ size_t( y ) * image.size.x + x ].r > 128 ) ++lit_count;
+		}
+	}
+	return lit_count;
+}
+
+class EventHandler : public WindowEventHandler
+{
+public:
+	void VK2D_APIENTRY EventScreenshot(
+		Window							*	window,
+		const filesystem::path			&	screenshot_path,
+		const ImageData					&	screenshot_data,
+		bool								success,
+		const string					&	error_message
+	)
+	{
+		if( !success ) ExitWithCode( ExitCodes::CANNOT_READ_FILE );
+		if( screenshot_data.size.x < WINDOW_SIZE || screenshot_data.size.y < WINDOW_SIZE ) ExitWithCode( ExitCodes::RENDER_SAMPLE_OUT_OF_BOUNDS );
+
+		// Some texels around the text must be lit.
+		auto lit_count = CountLitTexels( screenshot_data, text_area );
+		if( lit_count < 100 ) {
+			cout << "Test: Only " << lit_count << " texels of the text are visible.\n";
+			ExitWithCode( ExitCodes::RENDER_DOES_NOT_MATCH_EXPECTED_RESULT );
+		}
+
+		// Late glyphs show up once the larger atlas texture has loaded, try again later until then.
+		late_text_lit_count = CountLitTexels( screenshot_data, late_text_area );
+		if( late_text_lit_count >= 50 ) ExitWithCode( ExitCodes::SUCCESS );
+	}
+
+	Rect2f									text_area;
+	Rect2f									late_text_area;
+	uint32_t								late_text_lit_count			= 0;
+};
+
+
+
+int main()
+{
+	InstanceCreateInfo instance_create_info {};
+	auto instance = CreateInstance( instance_create_info );
+	if( !instance ) ExitWithCode( ExitCodes::CANNOT_CREATE_INSTANCE );
+
+	EventHandler event_handler;
+	WindowCreateInfo window_create_info {};
+	window_create_info.size				= { WINDOW_SIZE, WINDOW_SIZE };
+	window_create_info.event_handler	= &event_handler;
+	window_create_info.coordinate_space	= RenderCoordinateSpace::TEXEL_SPACE;
+	auto window = instance->CreateOutputWindow( window_create_info );
+	if( !window ) ExitWithCode( ExitCodes::CANNOT_CREATE_WINDOW );
+
+	auto resource_manager	= instance->GetResourceManager();
+	auto baked_font			= resource_manager->LoadFontResource( FONT_PATH );
+	auto on_demand_font		= resource_manager->LoadFontResource( FONT_PATH, 32, true, '*', 8, true, "0123456789" );
+	if( !baked_font || baked_font->WaitUntilLoaded() != ResourceStatus::LOADED ) Fail( "Cannot load font.", ExitCodes::CANNOT_READ_FILE );
+	if( !on_demand_font || on_demand_font->WaitUntilLoaded() != ResourceStatus::LOADED ) Fail( "Cannot load font with glyphs on demand.", ExitCodes::CANNOT_READ_FILE );
+	auto growth_font		= resource_manager->LoadFontResource( FONT_PATH, GROWTH_GLYPH_SIZE, true, '*', GROWTH_GLYPH_PADDING, true, "" );
+	if( !growth_font || growth_font->WaitUntilLoaded() != ResourceStatus::LOADED ) Fail( "Cannot load font with small atlas pages.", ExitCodes::CANNOT_READ_FILE );
+
+	cout << "Test: Glyph rasterization " << ToMilliseconds( baked_font->GetLoadTiming().glyph_rasterization ) << " ms for every glyph, "
+		<< ToMilliseconds( on_demand_font->GetLoadTiming().glyph_rasterization ) << " ms on demand.\n";
+
+	// Preloaded glyphs and glyphs rendered by measuring must give the same size the second time.
+	for( auto text : { "0123456789", TEXT } ) {
+		auto first_size		= on_demand_font->CalculateRenderedSize( text );
+		auto second_size	= on_demand_font->CalculateRenderedSize( text );
+		if( first_size.bottom_right.x - first_size.top_left.x <= 0.0f ||
+			first_size.bottom_right.y - first_size.top_left.y <= 0.0f ) {
+			Fail( "Text has no size." );
+		}
+		if( first_size.top_left != second_size.top_left || first_size.bottom_right != second_size.bottom_right ) {
+			Fail( "Text size changed after its glyphs were loaded." );
+		}
+	}
+
+	auto text_size			= on_demand_font->CalculateRenderedSize( TEXT );
+	event_handler.text_area	= text_size + TEXT_ORIGIN;
+
+	// Measuring every other printable character adds atlas pages and starts
+	// loading a larger texture, late glyphs are added while that is loading.
+	string fill_text;
+	for( char c = '!'; c <= '~'; ++c ) {
+		if( LATE_TEXT.find( c ) == string::npos ) fill_text += c;
+	}
+	growth_font->CalculateRenderedSize( fill_text );
+	event_handler.late_text_area	= growth_font->CalculateRenderedSize( LATE_TEXT ) + LATE_TEXT_ORIGIN;
+
+	// Screenshot event ends the test.
+	for( uint32_t frame = 0; frame < 300; ++frame ) {
+		if( !window->BeginRender() ) ExitWithCode( ExitCodes::CANNOT_BEGIN_RENDER );
+		window->DrawMesh( GenerateTextMesh( on_demand_font, TEXT_ORIGIN, TEXT ) );
+		window->DrawMesh( GenerateTextMesh( growth_font, LATE_TEXT_ORIGIN, LATE_TEXT ) );
+		if( frame % 10 == 0 ) {
+			window->TakeScreenshotToData( false );
+		}
+		if( !window->EndRender() ) ExitWithCode( ExitCodes::CANNOT_END_RENDER );
+	}
+	cout << "Test: Only " << event_handler.late_text_lit_count << " texels of text added while the atlas grew are visible.\n";
+	ExitWithCode( ExitCodes::RENDER_DOES_NOT_MATCH_EXPECTED_RESULT );
+}
@@ -0,0 +1,150 @@
+
+#include <System/LoadBalancer.hpp>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <deque>
+#include <condition_variable>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Synthetic benchmark of loader thread selection. A burst of mixed size loads
+// is queued to a set of worker threads that "load" by sleeping in proportion
+// to the load cost. Compares plain round robin to the cost aware balancer the
+// resource manager uses. Times are printed, only accounting failures fail the test.
+
+
+
+constexpr size_t WORKER_COUNT			= 4;
+
+
+
+// Load cost is in microseconds of work here.
+vector<uint64_t> MakeMixedLoads( bool strided )
+{
+	vector<uint64_t> loads;
+	mt19937 random( 1234 );
+	uniform_int_distribution<uint64_t> small_load( 50, 400 );
+	uniform_int_distribution<uint64_t> large_load( 8000, 24000 );
+
+	for( size_t i = 0; i < 256; ++i ) {
+		// Strided case is the worst case for round robin, every large
+		// load lands on the same thread. Think of loading sets of textures
+		// where the first one is always a huge atlas.
+		bool large = strided ? ( i % ( WORKER_COUNT * 4 ) == 0 ) : ( random() % 16 == 0 );
+		loads.push_back( large ? large_load( random ) : small_load( random ) );
+	}
+	return loads;
+}
+
+struct Worker {
+	mutex								queue_mutex;
+	condition_variable					queue_condition;
+	deque<uint64_t>						queue;
+	bool								stop			= {};
+};
+
+double RunLoads( const vector<uint64_t> & loads, bool balanced )
+{
+	_internal::LoadBalancer balancer( WORKER_COUNT );
+	vector<unique_ptr<Worker>> workers;
+	vector<thread> threads;
+	for( size_t w = 0; w < WORKER_COUNT; ++w ) {
+		workers.push_back( make_unique<Worker>() );
+	}
+
+	auto begin = chrono::steady_clock::now();
+
+	for( size_t w = 0; w < WORKER_COUNT; ++w ) {
+		threads.emplace_back( [ &balancer, worker = workers[ w ].get(), w, balanced ]()
+			{
+				while( true ) {
+					uint64_t load = 0;
+					{
+						unique_lock<mutex> lock( worker->queue_mutex );
+						worker->queue_condition.wait( lock, [ worker ]() { return worker->stop || !worker->queue.empty(); } );
+						if( worker->queue.empty() ) return;
+						load = worker->queue.front();
+						worker->queue.pop_front();
+					}
+					this_thread::sleep_for( chrono::microseconds( load ) );
+					if( balanced ) balancer.Release( w, load );
+				}
+			} );
+	}
+
+	for( size_t i = 0; i < loads.size(); ++i ) {
+		size_t w = balanced ? balancer.Acquire( loads[ i ] ) : i % WORKER_COUNT;
+		if( w >= WORKER_COUNT ) Fail( "Balancer returned invalid worker." );
+		lock_guard<mutex> lock( workers[ w ]->queue_mutex );
+		workers[ w ]->queue.push_back( loads[ i ] );
+		workers[ w ]->queue_condition.notify_one();
+	}
+
+	for( auto & w : workers ) {
+		lock_guard<mutex> lock( w->queue_mutex );
+		w->stop = true;
+		w->queue_condition.notify_one();
+	}
+	for( auto & t : threads ) t.join();
+
+	auto end = chrono::steady_clock::now();
+
+	if( balanced ) {
+		for( size_t w = 0; w < WORKER_COUNT; ++w ) {
+			if( balancer.GetQueuedCost( w ) ) Fail( "Queued cost not released after all loads finished." );
+		}
+	}
+
+	return chrono::duration<double, milli>( end - begin ).count();
+}
+
+// Idle workers are picked in turn so small loads still spread out.
+void IdleRotationCheck()
+{
+	_internal::LoadBalancer balancer( WORKER_COUNT );
+	vector<size_t> picks( WORKER_COUNT );
+	for( size_t i = 0; i < WORKER_COUNT * 8; ++i ) {
+		auto w = balancer.Acquire( 1 );
+		++picks[ w ];
+		balancer.Release( w, 1 );
+	}
+	for( auto p : picks ) {
+		if( p != 8 ) Fail( "Idle workers not picked evenly." );
+	}
+}
+
+
+
+int main()
+{
+	IdleRotationCheck();
+
+	cout << fixed << setprecision( 1 );
+	cout << "Mixed size load burst on " << WORKER_COUNT << " loader threads, milliseconds\n";
+	cout << setw( 10 ) << "pattern" << setw( 14 ) << "round robin" << setw( 12 ) << "balanced" << setw( 10 ) << "ideal" << "\n";
+
+	for( bool strided : { false, true } ) {
+		auto loads = MakeMixedLoads( strided );
+		uint64_t total = 0;
+		for( auto l : loads ) total += l;
+
+		auto round_robin_time	= RunLoads( loads, false );
+		auto balanced_time		= RunLoads( loads, true );
+
+		cout << setw( 10 ) << ( strided ? "strided" : "random" ) << setw( 14 ) << round_robin_time << setw( 12 ) << balanced_time
+			<< setw( 10 ) << double( total ) / 1000.0 / WORKER_COUNT << "\n";
+	}
+
+	cout << "\n";
+
+	return 0;
+}
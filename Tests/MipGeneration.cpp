@@ -0,0 +1,202 @@
+
+#include <System/MipGenerator.hpp>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <filesystem>
+#include <cmath>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Checks CPU mip level generation against known averages, that every filter
+// keeps flat images flat and transparent texels out of colors, and that mip
+// cache files are only used when they match the image they were made from.
+
+
+
+const vector<TextureMipFilter> CPU_FILTERS {
+	TextureMipFilter::BOX,
+	TextureMipFilter::KAISER,
+	TextureMipFilter::LANCZOS,
+};
+
+vector<uint8_t> MakeImage( uint32_t width, uint32_t height, uint32_t seed )
+{
+	mt19937 random( seed );
+	vector<uint8_t> texels( size_t( width ) * height * 4 );
+	for( auto & t : texels ) t = uint8_t( random() );
+	return texels;
+}
+
+
+
+void BoxAverageCheck()
+{
+	// Black and white columns average to the middle in linear light, 188 in sRGB.
+	vector<uint8_t> texels {
+		0, 0, 0, 255,		255, 255, 255, 255,
+		0, 0, 0, 255,		255, 255, 255, 255,
+	};
+	vector<vector<uint8_t>> mip_levels;
+	if( !_internal::GenerateMipLevels( texels.data(), 2, 2, TextureMipFilter::BOX, false, mip_levels ) ) Fail( "Cannot generate mip levels." );
+	if( mip_levels.size() != 1 || mip_levels[ 0 ] != vector<uint8_t> { 128, 128, 128, 255 } ) Fail( "Box filter average is wrong." );
+
+	if( !_internal::GenerateMipLevels( texels.data(), 2, 2, TextureMipFilter::BOX, true, mip_levels ) ) Fail( "Cannot generate mip levels." );
+	if( mip_levels.size() != 1 || mip_levels[ 0 ] != vector<uint8_t> { 188, 188, 188, 255 } ) Fail( "Gamma correct box filter average is wrong." );
+
+	// Transparent texels have no say in the color.
+	texels = {
+		255, 0, 0, 255,		0, 255, 0, 0,
+		255, 0, 0, 255,		0, 255, 0, 0,
+	};
+	for( auto filter : CPU_FILTERS ) {
+		if( !_internal::GenerateMipLevels( texels.data(), 2, 2, filter, true, mip_levels ) ) Fail( "Cannot generate mip levels." );
+		auto & texel = mip_levels[ 0 ];
+		if( texel[ 0 ] != 255 || texel[ 1 ] != 0 || texel[ 2 ] != 0 ) Fail( "Transparent texels bled into the color." );
+		if( abs( int( texel[ 3 ] ) - 128 ) > 1 ) Fail( "Alpha average is wrong." );
+	}
+
+	if( _internal::GenerateMipLevels( texels.data(), 2, 2, TextureMipFilter::GPU_LINEAR, true, mip_levels ) ) Fail( "GPU filter generated mip levels on the CPU." );
+}
+
+void MipChainCheck()
+{
+	struct Size { uint32_t width; uint32_t height; uint32_t level_count; };
+	for( auto size : { Size { 1, 1, 1 }, Size { 7, 3, 3 }, Size { 64, 1, 7 }, Size { 5, 40, 6 }, Size { 33, 33, 6 } } ) {
+		if( _internal::GetCompleteMipLevelCount( size.width, size.height ) != size.level_count ) Fail( "Wrong mip level count." );
+
+		auto texels = MakeImage( size.width, size.height, size.width * 100 + size.height );
+		for( auto filter : CPU_FILTERS ) {
+			vector<vector<uint8_t>> mip_levels;
+			if( !_internal::GenerateMipLevels( texels.data(), size.width, size.height, filter, true, mip_levels ) ) Fail( "Cannot generate mip levels." );
+			if( mip_levels.size() != size.level_count - 1 ) Fail( "Wrong amount of mip levels generated." );
+			for( uint32_t level = 1; level < size.level_count; ++level ) {
+				auto texel_count = size_t( max( size.width >> level, 1U ) ) * max( size.height >> level, 1U );
+				if( mip_levels[ level - 1 ].size() != texel_count * 4 ) Fail( "Wrong mip level size." );
+			}
+		}
+	}
+}
+
+void FlatImageCheck()
+{
+	// Weights must add up to one everywhere, also at the edges and with odd sizes.
+	for( auto filter : CPU_FILTERS ) {
+		for( auto gamma_correct : { false, true } ) {
+			uint32_t width		= 37;
+			uint32_t height		= 21;
+			vector<uint8_t> texels( size_t( width ) * height * 4 );
+			for( size_t i = 0; i < texels.size(); i += 4 ) {
+				texels[ i + 0 ] = 10;
+				texels[ i + 1 ] = 100;
+				texels[ i + 2 ] = 200;
+				texels[ i + 3 ] = 77;
+			}
+			vector<vector<uint8_t>> mip_levels;
+			if( !_internal::GenerateMipLevels( texels.data(), width, height, filter, gamma_correct, mip_levels ) ) Fail( "Cannot generate mip levels." );
+			for( auto & level : mip_levels ) {
+				for( size_t i = 0; i < level.size(); ++i ) {
+					if( abs( int( level[ i ] ) - int( texels[ i % 4 ] ) ) > 1 ) Fail( "Flat image did not stay flat." );
+				}
+			}
+		}
+	}
+}
+
+void SharpFilterCheck()
+{
+	// Sharper filters keep more contrast of detail that still fits in the mip
+	// level, a wave 4 texels long at mip level 1, than the box filter does.
+	uint32_t width = 64;
+	vector<uint8_t> texels( size_t( width ) * 4 );
+	for( uint32_t x = 0; x < width; ++x ) {
+		auto value = uint8_t( 128.0 + 100.0 * cos( vk2d::PI * 2.0 * ( double( x ) - 0.5 ) / 8.0 ) );
+		texels[ x * 4 + 0 ] = value;
+		texels[ x * 4 + 1 ] = value;
+		texels[ x * 4 + 2 ] = value;
+		texels[ x * 4 + 3 ] = 255;
+	}
+	auto GetContrast = [ & ]( TextureMipFilter filter )
+	{
+		vector<vector<uint8_t>> mip_levels;
+		if( !_internal::GenerateMipLevels( texels.data(), width, 1, filter, false, mip_levels ) ) Fail( "Cannot generate mip levels." );
+		auto & level = mip_levels[ 0 ];
+		int lowest = 255;
+		int highest = 0;
+		for( size_t i = 0; i < level.size(); i += 4 ) {
+			lowest	= min( lowest, int( level[ i ] ) );
+			highest	= max( highest, int( level[ i ] ) );
+			if( level[ i + 3 ] != 255 ) Fail( "Opaque image became transparent." );
+		}
+		return highest - lowest;
+	};
+	auto box_contrast = GetContrast( TextureMipFilter::BOX );
+	if( GetContrast( TextureMipFilter::KAISER ) <= box_contrast + 5 ) Fail( "Kaiser filter is not sharper than box filter." );
+	if( GetContrast( TextureMipFilter::LANCZOS ) <= box_contrast + 5 ) Fail( "Lanczos filter is not sharper than box filter." );
+}
+
+void MipCacheCheck()
+{
+	uint32_t width	= 13;
+	uint32_t height	= 9;
+	auto texels = MakeImage( width, height, 42 );
+
+	_internal::MipCacheKey key {};
+	key.source_hash		= 0x0123456789ABCDEFull;
+	key.source_size		= 5000;
+	key.width			= width;
+	key.height			= height;
+	key.filter			= TextureMipFilter::KAISER;
+	key.gamma_correct	= true;
+
+	vector<vector<uint8_t>> mip_levels;
+	if( !_internal::GenerateMipLevels( texels.data(), width, height, key.filter, key.gamma_correct, mip_levels ) ) Fail( "Cannot generate mip levels." );
+
+	auto data = _internal::EncodeMipCache( key, mip_levels );
+	vector<vector<uint8_t>> cached_levels;
+	if( !_internal::DecodeMipCache( data.data(), data.size(), key, cached_levels ) ) Fail( "Cannot decode mip cache." );
+	if( cached_levels != mip_levels ) Fail( "Mip cache changed mip levels." );
+
+	auto other_key = key;
+	other_key.source_hash ^= 1;
+	if( _internal::DecodeMipCache( data.data(), data.size(), other_key, cached_levels ) ) Fail( "Mip cache of another image used." );
+	other_key = key;
+	other_key.filter = TextureMipFilter::LANCZOS;
+	if( _internal::DecodeMipCache( data.data(), data.size(), other_key, cached_levels ) ) Fail( "Mip cache of another filter used." );
+	other_key = key;
+	other_key.gamma_correct = false;
+	if( _internal::DecodeMipCache( data.data(), data.size(), other_key, cached_levels ) ) Fail( "Mip cache without gamma correction used." );
+	if( _internal::DecodeMipCache( data.data(), data.size() - 1, key, cached_levels ) ) Fail( "Truncated mip cache used." );
+
+	// Through a file in a cache directory.
+	auto cache_directory = filesystem::temp_directory_path() / "vk2d_mip_generation_test";
+	filesystem::remove_all( cache_directory );
+	auto path = _internal::GetMipCachePath( "Images/Image.png", cache_directory, key.source_hash );
+	if( path != cache_directory / "0123456789abcdef.vk2dmips" ) Fail( "Wrong mip cache path." );
+	if( _internal::GetMipCachePath( "Images/Image.png", {}, key.source_hash ) != filesystem::path( "Images/Image.png.vk2dmips" ) ) Fail( "Wrong mip cache path next to image." );
+
+	if( _internal::ReadMipCacheFile( path, key, cached_levels ) ) Fail( "Missing mip cache file read." );
+	if( !_internal::WriteMipCacheFile( path, key, mip_levels ) ) Fail( "Cannot write mip cache file.", ExitCodes::CANNOT_WRITE_FILE );
+	if( !_internal::ReadMipCacheFile( path, key, cached_levels ) || cached_levels != mip_levels ) Fail( "Cannot read mip cache file." );
+	if( distance( filesystem::directory_iterator( cache_directory ), filesystem::directory_iterator() ) != 1 ) Fail( "Temporary mip cache file left behind." );
+	filesystem::remove_all( cache_directory );
+}
+
+
+
+int main()
+{
+	BoxAverageCheck();
+	MipChainCheck();
+	FlatImageCheck();
+	SharpFilterCheck();
+	MipCacheCheck();
+
+	return 0;
+}
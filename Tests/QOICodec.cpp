@@ -0,0 +1,128 @@
+
+#include <System/QOI.hpp>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <vector>
+#include <random>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Decodes a QOI image written by another encoder, checks that encoding the
+// same texels gives the same chunks, and that random images survive a round
+// trip. Broken images must be rejected, not read out of bounds.
+
+
+
+// 4 * 3 RGBA image written by another QOI encoder.
+const vector<uint8_t> REFERENCE_TEXELS {
+	255, 0, 0, 255,		255, 0, 0, 255,		254, 1, 0, 255,		0, 0, 255, 128,
+	255, 0, 0, 255,		10, 20, 30, 255,	12, 40, 30, 255,	0, 0, 255, 128,
+	0, 0, 0, 0,			0, 0, 0, 0,			0, 0, 0, 0,			200, 100, 50, 255,
+};
+const vector<uint8_t> REFERENCE_QOI {
+	0x71, 0x6F, 0x69, 0x66, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x03, 0x04, 0x01,		// Header, linear colorspace.
+	0x5A, 0xC0, 0x5E, 0xFF, 0x00, 0x00, 0xFF, 0x80,											// Diff, run, diff, RGBA.
+	0x32, 0xFE, 0x0A, 0x14, 0x1E, 0xFE, 0x0C, 0x28, 0x1E, 0x39,								// Index, RGB, RGB, index.
+	0x00, 0xC1, 0xFF, 0xC8, 0x64, 0x32, 0xFF,												// Index, run, RGBA.
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01											// End marker.
+};
+
+
+
+void ReferenceCheck()
+{
+	vector<uint8_t> texels;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	if( !_internal::DecodeQOI( REFERENCE_QOI.data(), REFERENCE_QOI.size(), texels, width, height ) ) Fail( "Cannot decode reference image." );
+	if( width != 4 || height != 3 ) Fail( "Wrong reference image size." );
+	if( texels != REFERENCE_TEXELS ) Fail( "Reference image decoded wrong." );
+
+	// Only difference to the reference encoder is the colorspace, which is ignored.
+	vector<uint8_t> encoded;
+	if( !_internal::EncodeQOI( REFERENCE_TEXELS.data(), 4, 3, 4, encoded ) ) Fail( "Cannot encode reference image." );
+	auto expected = REFERENCE_QOI;
+	expected[ 13 ] = 0;
+	if( encoded != expected ) Fail( "Reference image encoded differently." );
+}
+
+void RoundTripCheck()
+{
+	mt19937 random( 1234 );
+	for( uint32_t i = 0; i < 200; ++i ) {
+		uint32_t width		= 1 + random() % 100;
+		uint32_t height		= 1 + random() % 100;
+		uint32_t channels	= 3 + i % 2;
+
+		// Mix of noise, flat areas and gradients so every chunk type is used.
+		vector<uint8_t> texels( size_t( width ) * height * channels );
+		for( size_t t = 0; t < texels.size(); ++t ) {
+			switch( i % 3 ) {
+				case 0:
+					texels[ t ] = uint8_t( random() );
+					break;
+				case 1:
+					texels[ t ] = uint8_t( ( t / ( channels * 37 ) ) % 5 * 60 );
+					break;
+				default:
+					texels[ t ] = t < channels ? 128 : uint8_t( texels[ t - channels ] + random() % 9 - 4 );
+					break;
+			}
+		}
+
+		vector<uint8_t> encoded;
+		if( !_internal::EncodeQOI( texels.data(), width, height, channels, encoded ) ) Fail( "Cannot encode image." );
+
+		vector<uint8_t> decoded;
+		uint32_t decoded_width = 0;
+		uint32_t decoded_height = 0;
+		if( !_internal::DecodeQOI( encoded.data(), encoded.size(), decoded, decoded_width, decoded_height ) ) Fail( "Cannot decode image." );
+		if( decoded_width != width || decoded_height != height ) Fail( "Round trip changed image size." );
+		for( size_t t = 0; t < size_t( width ) * height; ++t ) {
+			for( uint32_t c = 0; c < 4; ++c ) {
+				auto expected = c < channels ? texels[ t * channels + c ] : uint8_t( 255 );
+				if( decoded[ t * 4 + c ] != expected ) Fail( "Round trip changed texels." );
+			}
+		}
+
+		// Every truncated image must fail.
+		for( size_t size = 0; size < encoded.size() - sizeof( _internal::QOI_END_MARKER ); size += 1 + encoded.size() / 16 ) {
+			vector<uint8_t> truncated( encoded.begin(), encoded.begin() + size );
+			if( _internal::DecodeQOI( truncated.data(), truncated.size(), decoded, decoded_width, decoded_height ) ) Fail( "Truncated image decoded." );
+		}
+	}
+}
+
+void HeaderCheck()
+{
+	_internal::QOIHeader header {};
+	auto broken = REFERENCE_QOI;
+	broken[ 12 ] = 2;
+	if( _internal::ReadQOIHeader( broken.data(), broken.size(), header ) ) Fail( "Wrong channel count accepted." );
+	broken = REFERENCE_QOI;
+	broken[ 7 ] = 0;
+	if( _internal::ReadQOIHeader( broken.data(), broken.size(), header ) ) Fail( "Zero width accepted." );
+	broken = REFERENCE_QOI;
+	broken[ 4 ] = 0xFF;
+	broken[ 8 ] = 0xFF;
+	if( _internal::ReadQOIHeader( broken.data(), broken.size(), header ) ) Fail( "Too large image accepted." );
+
+	const char png_signature[] = "\x89PNG\r\n\x1a\n";
+	if( _internal::IsQOIImage( png_signature, sizeof( png_signature ) ) ) Fail( "PNG detected as QOI." );
+}
+
+
+
+int main()
+{
+	ReferenceCheck();
+	RoundTripCheck();
+	HeaderCheck();
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+
+#include <VK2D.h>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Renders a render target texture every frame and reads its contents back to
+// the host while the render loop keeps going. Readbacks must not block, the
+// callback arrives from a later BeginRender() and the texels must match what
+// was rendered. A full readback ring must refuse more requests.
+
+
+
+constexpr uint32_t TEXTURE_SIZE				= 128;
+
+const Rect2f RECTANGLE_AREA { 32.0f, 32.0f, 96.0f, 64.0f };
+
+
+
+
+
+int main()
+{
+	InstanceCreateInfo instance_create_info {};
+	auto instance = CreateInstance( instance_create_info );
+	if( !instance ) ExitWithCode( ExitCodes::CANNOT_CREATE_INSTANCE );
+
+	WindowCreateInfo window_create_info {};
+	window_create_info.size				= { 512, 512 };
+	window_create_info.coordinate_space	= RenderCoordinateSpace::TEXEL_SPACE;
+	auto window = instance->CreateOutputWindow( window_create_info );
+	if( !window ) ExitWithCode( ExitCodes::CANNOT_CREATE_WINDOW );
+
+	RenderTargetTextureCreateInfo render_target_create_info {};
+	render_target_create_info.size		= { TEXTURE_SIZE, TEXTURE_SIZE };
+	auto render_target = instance->CreateRenderTargetTexture( render_target_create_info );
+	if( !render_target ) Fail( "Cannot create render target texture." );
+
+	uint32_t	callback_count	= 0;
+	bool		is_good			= false;
+	auto callback = [ &callback_count, &is_good ]( const ImageData & image_data, bool success )
+	{
+		++callback_count;
+		if( !success ) return;
+		if( image_data.size.x != TEXTURE_SIZE || image_data.size.y != TEXTURE_SIZE ) return;
+		if( image_data.data.size() != size_t( TEXTURE_SIZE ) * TEXTURE_SIZE ) return;
+
+		// Sampled away from rectangle edges.
+		is_good =
+			VerifyImageWithSingleSample( { { 64, 48 }, Color8( 0, 255, 0, 255 ) }, image_data, 1 ) &&
+			VerifyImageWithSingleSample( { { 40, 60 }, Color8( 0, 255, 0, 255 ) }, image_data, 1 ) &&
+			VerifyImageWithSingleSample( { { 10, 10 }, Color8( 0, 0, 0, 0 ) }, image_data, 1 ) &&
+			VerifyImageWithSingleSample( { { 64, 100 }, Color8( 0, 0, 0, 0 ) }, image_data, 1 );
+	};
+
+	// Fill the whole ring, the next request must be refused until a readback finishes.
+	uint32_t request_count = 0;
+	while( render_target->RequestReadback( callback ) ) {
+		++request_count;
+		if( request_count > 64 ) Fail( "Readback ring never fills up." );
+	}
+	if( !request_count ) Fail( "Cannot request readback." );
+
+	for( uint32_t frame = 0; frame < 100 && callback_count < request_count; ++frame ) {
+		if( !render_target->BeginRender() ) Fail( "Cannot begin render target texture render.", ExitCodes::CANNOT_BEGIN_RENDER );
+		render_target->DrawRectangle( RECTANGLE_AREA, true, Colorf( 0.0f, 1.0f, 0.0f, 1.0f ) );
+		if( !render_target->EndRender() ) Fail( "Cannot end render target texture render.", ExitCodes::CANNOT_END_RENDER );
+
+		if( !window->BeginRender() ) ExitWithCode( ExitCodes::CANNOT_BEGIN_RENDER );
+		window->DrawTexture( { 0.0f, 0.0f }, render_target );
+		if( !window->EndRender() ) ExitWithCode( ExitCodes::CANNOT_END_RENDER );
+	}
+
+	if( callback_count != request_count ) Fail( "Readback callbacks never arrived." );
+	ExitWithCode( is_good ? ExitCodes::SUCCESS : ExitCodes::RENDER_DOES_NOT_MATCH_EXPECTED_RESULT );
+}
@@ -0,0 +1,69 @@
+
+#include <VK2D.h>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Renders a render target texture a single time and then only renders the
+// window. The readback requested for that one render must still arrive from
+// the window frames that follow, nothing renders the render target again.
+
+
+
+constexpr uint32_t TEXTURE_SIZE				= 64;
+
+
+
+int main()
+{
+	InstanceCreateInfo instance_create_info {};
+	auto instance = CreateInstance( instance_create_info );
+	if( !instance ) ExitWithCode( ExitCodes::CANNOT_CREATE_INSTANCE );
+
+	WindowCreateInfo window_create_info {};
+	window_create_info.size				= { 512, 512 };
+	window_create_info.coordinate_space	= RenderCoordinateSpace::TEXEL_SPACE;
+	auto window = instance->CreateOutputWindow( window_create_info );
+	if( !window ) ExitWithCode( ExitCodes::CANNOT_CREATE_WINDOW );
+
+	RenderTargetTextureCreateInfo render_target_create_info {};
+	render_target_create_info.size		= { TEXTURE_SIZE, TEXTURE_SIZE };
+	auto render_target = instance->CreateRenderTargetTexture( render_target_create_info );
+	if( !render_target ) Fail( "Cannot create render target texture." );
+
+	uint32_t	callback_count	= 0;
+	bool		is_good			= false;
+	auto callback = [ &callback_count, &is_good ]( const ImageData & image_data, bool success )
+	{
+		++callback_count;
+		if( !success ) return;
+		if( image_data.size.x != TEXTURE_SIZE || image_data.size.y != TEXTURE_SIZE ) return;
+
+		is_good =
+			VerifyImageWithSingleSample( { { 32, 32 }, Color8( 255, 0, 0, 255 ) }, image_data, 1 );
+	};
+	if( !render_target->RequestReadback( callback ) ) Fail( "Cannot request readback." );
+
+	if( !render_target->BeginRender() ) Fail( "Cannot begin render target texture render.", ExitCodes::CANNOT_BEGIN_RENDER );
+	render_target->DrawRectangle( { 0.0f, 0.0f, float( TEXTURE_SIZE ), float( TEXTURE_SIZE ) }, true, Colorf( 1.0f, 0.0f, 0.0f, 1.0f ) );
+	if( !render_target->EndRender() ) Fail( "Cannot end render target texture render.", ExitCodes::CANNOT_END_RENDER );
+
+	for( uint32_t frame = 0; frame < 100 && !callback_count; ++frame ) {
+		if( !window->BeginRender() ) ExitWithCode( ExitCodes::CANNOT_BEGIN_RENDER );
+		if( frame == 0 ) {
+			window->DrawTexture( { 0.0f, 0.0f }, render_target );
+		}
+		if( !window->EndRender() ) ExitWithCode( ExitCodes::CANNOT_END_RENDER );
+	}
+
+	if( !callback_count ) Fail( "Readback callback never arrived." );
+	if( callback_count != 1 ) Fail( "Readback callback called more than once." );
+	ExitWithCode( is_good ? ExitCodes::SUCCESS : ExitCodes::RENDER_DOES_NOT_MATCH_EXPECTED_RESULT );
+}
@@ -0,0 +1,159 @@
+
+#include <System/SlotMap.hpp>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <list>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// CPU benchmark of resource create/destroy churn. Compares the slot map the
+// resource manager uses with the previous list with linear search removal.
+// Times are printed, only correctness failures fail the test.
+
+
+
+struct FakeResource {
+	uint64_t							payload			= {};
+	_internal::SlotMapHandle			handle			= {};
+};
+
+
+
+double ChurnSlotMap( size_t resource_count, size_t rounds )
+{
+	_internal::SlotMap<FakeResource> slot_map;
+	vector<FakeResource*> live;
+	live.reserve( resource_count );
+	mt19937 random( 1234 );
+
+	auto begin = chrono::steady_clock::now();
+	for( size_t r = 0; r < rounds; ++r ) {
+		for( size_t i = 0; i < resource_count; ++i ) {
+			auto resource = make_unique<FakeResource>();
+			resource->payload = i;
+			auto raw = resource.get();
+			raw->handle = slot_map.Insert( std::move( resource ) );
+			if( !raw->handle ) Fail( "Slot map insert failed." );
+			live.push_back( raw );
+		}
+		shuffle( live.begin(), live.end(), random );
+		for( auto l : live ) {
+			auto handle = l->handle;
+			auto removed = slot_map.Remove( handle );
+			if( !removed ) Fail( "Slot map remove failed." );
+			if( slot_map.Get( handle ) ) Fail( "Stale handle still resolves." );
+		}
+		live.clear();
+	}
+	auto end = chrono::steady_clock::now();
+	if( slot_map.Size() ) Fail( "Slot map not empty after churn." );
+
+	return chrono::duration<double, nano>( end - begin ).count() / double( resource_count * rounds * 2 );
+}
+
+double ChurnList( size_t resource_count, size_t rounds )
+{
+	recursive_mutex mutex;
+	list<unique_ptr<FakeResource>> resources;
+	vector<FakeResource*> live;
+	live.reserve( resource_count );
+	mt19937 random( 1234 );
+
+	auto begin = chrono::steady_clock::now();
+	for( size_t r = 0; r < rounds; ++r ) {
+		for( size_t i = 0; i < resource_count; ++i ) {
+			auto resource = make_unique<FakeResource>();
+			resource->payload = i;
+			live.push_back( resource.get() );
+			lock_guard<recursive_mutex> lock( mutex );
+			resources.push_back( std::move( resource ) );
+		}
+		shuffle( live.begin(), live.end(), random );
+		for( auto l : live ) {
+			lock_guard<recursive_mutex> lock( mutex );
+			for( auto it = resources.begin(); it != resources.end(); ++it ) {
+				if( it->get() == l ) {
+					resources.erase( it );
+					break;
+				}
+			}
+		}
+		live.clear();
+	}
+	auto end = chrono::steady_clock::now();
+
+	return chrono::duration<double, nano>( end - begin ).count() / double( resource_count * rounds * 2 );
+}
+
+// Readers resolve handles while another thread keeps creating and destroying.
+void ConcurrentReadCheck()
+{
+	_internal::SlotMap<FakeResource> slot_map;
+
+	vector<_internal::SlotMapHandle> stable_handles;
+	for( size_t i = 0; i < 1024; ++i ) {
+		auto resource = make_unique<FakeResource>();
+		resource->payload = i;
+		stable_handles.push_back( slot_map.Insert( std::move( resource ) ) );
+	}
+
+	atomic<bool> stop = false;
+	atomic<bool> failed = false;
+	vector<thread> readers;
+	for( size_t t = 0; t < 4; ++t ) {
+		readers.emplace_back( [ &slot_map, &stable_handles, &stop, &failed ]()
+			{
+				while( !stop ) {
+					for( size_t i = 0; i < stable_handles.size(); ++i ) {
+						auto resource = slot_map.Get( stable_handles[ i ] );
+						if( !resource || resource->payload != i ) failed = true;
+					}
+				}
+			} );
+	}
+
+	for( size_t i = 0; i < 200000; ++i ) {
+		auto handle = slot_map.Insert( make_unique<FakeResource>() );
+		slot_map.Remove( handle );
+		if( slot_map.Get( handle ) ) failed = true;
+	}
+
+	stop = true;
+	for( auto & r : readers ) r.join();
+
+	if( failed ) Fail( "Concurrent reads resolved a wrong resource." );
+}
+
+
+
+int main()
+{
+	cout << fixed << setprecision( 1 );
+	cout << "Resource create/destroy churn, nanoseconds per operation\n";
+	cout << setw( 10 ) << "resources" << setw( 12 ) << "slot map" << setw( 12 ) << "list" << "\n";
+
+	for( size_t resource_count : { 1000, 10000, 40000 } ) {
+		size_t rounds = 400000 / resource_count;
+		auto slot_map_time = ChurnSlotMap( resource_count, rounds );
+
+		// List removal is quadratic, keep the large case short.
+		auto list_time = ChurnList( resource_count, resource_count > 10000 ? 1 : rounds );
+
+		cout << setw( 10 ) << resource_count << setw( 12 ) << slot_map_time << setw( 12 ) << list_time << "\n";
+	}
+
+	ConcurrentReadCheck();
+
+	cout << "\n";
+
+	return 0;
+}
@@ -4,6 +4,7 @@
 #include <random>
 #include <functional>
 #include <fstream>
+#include <iostream>
 
 
 using RandomEngine			= std::default_random_engine;
@@ -16,6 +17,15 @@ void ExitWithCode(
 	std::exit( static_cast<int>( code ) );
 }
 
+void Fail(
+	const char		*	message,
+	ExitCodes			code
+)
+{
+	std::cout << "Test: " << message << "\n";
+	ExitWithCode( code );
+}
+
 std::vector<ColorPoint> GenerateSamples(
 	const vk2d::ImageData		&	image_data,
 	uint32_t						sample_count
@@ -29,6 +29,11 @@ struct ColorPoint {
 void									ExitWithCode(
 	ExitCodes							code );
 
+// Prints why the test failed and exits with code.
+void									Fail(
+	const char						*	message,
+	ExitCodes							code						= ExitCodes::RENDER_DOES_NOT_MATCH_EXPECTED_RESULT );
+
 std::vector<ColorPoint>					GenerateSamples(
 	const vk2d::ImageData			&	image_data,
 	uint32_t							sample_count );
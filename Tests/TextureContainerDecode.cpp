@@ -0,0 +1,372 @@
+
+#include <System/TextureContainer.hpp>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cstring>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Parses KTX2 and DDS containers built in memory and decodes known block
+// compressed blocks on the CPU. Expected texels follow the BC format
+// specifications, no GPU is needed.
+
+
+
+template<typename T>
+void Append( vector<uint8_t> & data, T value )
+{
+	for( size_t i = 0; i < sizeof( T ); ++i ) {
+		data.push_back( uint8_t( uint64_t( value ) >> ( i * 8 ) ) );
+	}
+}
+
+template<typename T>
+void WriteAt( vector<uint8_t> & data, size_t offset, T value )
+{
+	for( size_t i = 0; i < sizeof( T ); ++i ) {
+		data[ offset + i ] = uint8_t( uint64_t( value ) >> ( i * 8 ) );
+	}
+}
+
+// Writes bits into a 128 bit block from the lowest bit up.
+struct BlockBitWriter {
+	array<uint8_t, 16>		block		= {};
+	uint32_t				position	= {};
+
+	void Write( uint32_t value, uint32_t count )
+	{
+		for( uint32_t i = 0; i < count; ++i, ++position ) {
+			if( ( value >> i ) & 1 ) block[ position / 8 ] |= uint8_t( 1 << ( position % 8 ) );
+		}
+	}
+};
+
+array<uint8_t, 64> DecodeBlock( _internal::TextureContainerFormat format, const uint8_t * block )
+{
+	_internal::TextureContainerImage image {};
+	image.data		= block;
+	image.size		= _internal::GetTextureContainerBlockSize( format );
+	image.width		= 4;
+	image.height	= 4;
+
+	array<uint8_t, 64> texels {};
+	if( !_internal::DecodeTextureContainerImage( format, image, texels.data() ) ) Fail( "Cannot decode block." );
+	return texels;
+}
+
+void ExpectTexel( const array<uint8_t, 64> & texels, size_t index, array<uint8_t, 4> expected, const char * message )
+{
+	if( memcmp( texels.data() + index * 4, expected.data(), 4 ) ) {
+		cout << "Texel " << index << ": " << int( texels[ index * 4 ] ) << ", " << int( texels[ index * 4 + 1 ] ) << ", "
+			<< int( texels[ index * 4 + 2 ] ) << ", " << int( texels[ index * 4 + 3 ] ) << "\n";
+		Fail( message );
+	}
+}
+
+
+
+void KTX2Check()
+{
+	// 8 * 4 BC7 array texture with 2 layers and 3 mip levels, levels stored smallest first.
+	const uint32_t layer_count = 2;
+	const uint32_t level_count = 3;
+	const uint32_t level_sizes[ level_count ] = { 2 * 16, 16, 16 };
+
+	vector<uint8_t> file( begin( _internal::KTX2_IDENTIFIER ), end( _internal::KTX2_IDENTIFIER ) );
+	Append<uint32_t>( file, 145 );			// VK_FORMAT_BC7_UNORM_BLOCK
+	Append<uint32_t>( file, 1 );			// typeSize
+	Append<uint32_t>( file, 8 );			// pixelWidth
+	Append<uint32_t>( file, 4 );			// pixelHeight
+	Append<uint32_t>( file, 0 );			// pixelDepth
+	Append<uint32_t>( file, layer_count );
+	Append<uint32_t>( file, 1 );			// faceCount
+	Append<uint32_t>( file, level_count );
+	Append<uint32_t>( file, 0 );			// supercompressionScheme
+	for( size_t i = 0; i < 4; ++i ) Append<uint32_t>( file, 0 );	// Data format descriptor and key value data.
+	for( size_t i = 0; i < 2; ++i ) Append<uint64_t>( file, 0 );	// Supercompression global data.
+	auto level_index_offset = file.size();
+	file.resize( file.size() + 24 * level_count );
+
+	size_t level_offsets[ level_count ] {};
+	for( int32_t level = level_count - 1; level >= 0; --level ) {
+		level_offsets[ level ] = file.size();
+		WriteAt<uint64_t>( file, level_index_offset + 24 * level + 0, file.size() );
+		WriteAt<uint64_t>( file, level_index_offset + 24 * level + 8, level_sizes[ level ] * layer_count );
+		WriteAt<uint64_t>( file, level_index_offset + 24 * level + 16, level_sizes[ level ] * layer_count );
+		for( uint32_t i = 0; i < level_sizes[ level ] * layer_count; ++i ) {
+			file.push_back( uint8_t( level * 16 + i ) );
+		}
+	}
+
+	if( !_internal::IsTextureContainer( file.data(), file.size() ) ) Fail( "KTX2 file not detected." );
+
+	_internal::TextureContainer container {};
+	string error;
+	if( !_internal::ParseTextureContainer( file.data(), file.size(), container, error ) ) Fail( error.c_str() );
+	if( container.format != _internal::TextureContainerFormat::BC7_UNORM ) Fail( "Wrong KTX2 format." );
+	if( container.width != 8 || container.height != 4 ) Fail( "Wrong KTX2 size." );
+	if( container.layer_count != layer_count || container.mip_level_count != level_count ) Fail( "Wrong KTX2 layer or mip level count." );
+	if( container.images.size() != layer_count * level_count ) Fail( "Wrong KTX2 image count." );
+	for( uint32_t level = 0; level < level_count; ++level ) {
+		for( uint32_t layer = 0; layer < layer_count; ++layer ) {
+			auto & image = container.images[ level * layer_count + layer ];
+			if( image.data != file.data() + level_offsets[ level ] + level_sizes[ level ] * layer ) Fail( "Wrong KTX2 image location." );
+			if( image.size != level_sizes[ level ] ) Fail( "Wrong KTX2 image size." );
+			if( image.width != max( 8U >> level, 1U ) || image.height != max( 4U >> level, 1U ) ) Fail( "Wrong KTX2 image extent." );
+		}
+	}
+
+	// Level count 0 means the loader generates mip maps.
+	auto no_levels = file;
+	WriteAt<uint32_t>( no_levels, 40, 0 );
+	if( !_internal::ParseTextureContainer( no_levels.data(), no_levels.size(), container, error ) ) Fail( error.c_str() );
+	if( container.mip_level_count != 1 ) Fail( "KTX2 without levels should have one mip level." );
+
+	auto broken = file;
+	WriteAt<uint32_t>( broken, 36, 6 );
+	if( _internal::ParseTextureContainer( broken.data(), broken.size(), container, error ) ) Fail( "KTX2 cube map accepted." );
+	broken = file;
+	WriteAt<uint32_t>( broken, 44, 2 );
+	if( _internal::ParseTextureContainer( broken.data(), broken.size(), container, error ) ) Fail( "Supercompressed KTX2 accepted." );
+	broken = file;
+	WriteAt<uint32_t>( broken, 40, 5 );
+	if( _internal::ParseTextureContainer( broken.data(), broken.size(), container, error ) ) Fail( "KTX2 with too many levels accepted." );
+	broken = file;
+	broken.resize( broken.size() - 1 );
+	if( _internal::ParseTextureContainer( broken.data(), broken.size(), container, error ) ) Fail( "Truncated KTX2 accepted." );
+}
+
+
+
+vector<uint8_t> CreateDDSHeader( uint32_t width, uint32_t height, uint32_t mip_count, uint32_t four_cc )
+{
+	vector<uint8_t> file { 'D', 'D', 'S', ' ' };
+	Append<uint32_t>( file, 124 );
+	Append<uint32_t>( file, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 );	// Caps, height, width, pixel format, mip map count.
+	Append<uint32_t>( file, height );
+	Append<uint32_t>( file, width );
+	Append<uint32_t>( file, 0 );
+	Append<uint32_t>( file, 0 );
+	Append<uint32_t>( file, mip_count );
+	for( size_t i = 0; i < 11; ++i ) Append<uint32_t>( file, 0 );
+	Append<uint32_t>( file, 32 );
+	Append<uint32_t>( file, 0x4 );									// DDPF_FOURCC
+	Append<uint32_t>( file, four_cc );
+	for( size_t i = 0; i < 5; ++i ) Append<uint32_t>( file, 0 );
+	Append<uint32_t>( file, 0x1000 );
+	for( size_t i = 0; i < 4; ++i ) Append<uint32_t>( file, 0 );
+	return file;
+}
+
+void DDSCheck()
+{
+	auto FourCC = []( const char * code ) { uint32_t v = 0; memcpy( &v, code, 4 ); return v; };
+
+	// 4 * 4 RGBA8 array texture with 2 layers and 3 mip levels, stored layer by layer.
+	{
+		auto file = CreateDDSHeader( 4, 4, 3, FourCC( "DX10" ) );
+		Append<uint32_t>( file, 28 );	// DXGI_FORMAT_R8G8B8A8_UNORM
+		Append<uint32_t>( file, 3 );	// D3D10_RESOURCE_DIMENSION_TEXTURE2D
+		Append<uint32_t>( file, 0 );
+		Append<uint32_t>( file, 2 );	// Array size.
+		Append<uint32_t>( file, 0 );
+		auto data_offset = file.size();
+		const size_t level_sizes[ 3 ] = { 4 * 4 * 4, 2 * 2 * 4, 1 * 1 * 4 };
+		const size_t layer_size = level_sizes[ 0 ] + level_sizes[ 1 ] + level_sizes[ 2 ];
+		file.resize( data_offset + layer_size * 2 );
+
+		_internal::TextureContainer container {};
+		string error;
+		if( !_internal::ParseTextureContainer( file.data(), file.size(), container, error ) ) Fail( error.c_str() );
+		if( container.format != _internal::TextureContainerFormat::R8G8B8A8_UNORM ) Fail( "Wrong DDS format." );
+		if( container.layer_count != 2 || container.mip_level_count != 3 ) Fail( "Wrong DDS layer or mip level count." );
+		for( uint32_t level = 0; level < 3; ++level ) {
+			size_t level_offset = 0;
+			for( uint32_t m = 0; m < level; ++m ) level_offset += level_sizes[ m ];
+			for( uint32_t layer = 0; layer < 2; ++layer ) {
+				auto & image = container.images[ level * 2 + layer ];
+				if( image.data != file.data() + data_offset + layer_size * layer + level_offset ) Fail( "Wrong DDS image location." );
+				if( image.size != level_sizes[ level ] ) Fail( "Wrong DDS image size." );
+			}
+		}
+
+		auto broken = file;
+		broken.resize( broken.size() - 1 );
+		if( _internal::ParseTextureContainer( broken.data(), broken.size(), container, error ) ) Fail( "Truncated DDS accepted." );
+	}
+
+	// Legacy header, DXT5 is BC3.
+	{
+		auto file = CreateDDSHeader( 6, 5, 1, FourCC( "DXT5" ) );
+		file.resize( file.size() + 2 * 2 * 16 );
+
+		_internal::TextureContainer container {};
+		string error;
+		if( !_internal::ParseTextureContainer( file.data(), file.size(), container, error ) ) Fail( error.c_str() );
+		if( container.format != _internal::TextureContainerFormat::BC3_UNORM ) Fail( "DXT5 is not BC3." );
+		if( container.images.size() != 1 || container.images[ 0 ].size != 2 * 2 * 16 ) Fail( "Wrong DXT5 image size." );
+
+		auto unknown = CreateDDSHeader( 4, 4, 1, FourCC( "XXXX" ) );
+		unknown.resize( unknown.size() + 16 );
+		if( _internal::ParseTextureContainer( unknown.data(), unknown.size(), container, error ) ) Fail( "Unknown DDS format accepted." );
+	}
+
+	const char png_signature[] = "\x89PNG\r\n\x1a\n";
+	if( _internal::IsTextureContainer( png_signature, sizeof( png_signature ) ) ) Fail( "PNG detected as texture container." );
+}
+
+
+
+void BlockDecodeCheck()
+{
+	// BC1 4 color mode, red and blue endpoints, each row has indices 0, 1, 2, 3.
+	{
+		const uint8_t block[ 8 ] = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4 };
+		auto texels = DecodeBlock( _internal::TextureContainerFormat::BC1_RGBA_UNORM, block );
+		ExpectTexel( texels, 0, { 255, 0, 0, 255 }, "BC1 endpoint 0 is wrong." );
+		ExpectTexel( texels, 1, { 0, 0, 255, 255 }, "BC1 endpoint 1 is wrong." );
+		ExpectTexel( texels, 2, { 170, 0, 85, 255 }, "BC1 2/3 interpolation is wrong." );
+		ExpectTexel( texels, 15, { 85, 0, 170, 255 }, "BC1 1/3 interpolation is wrong." );
+	}
+	// BC1 3 color mode, index 3 is transparent black, or opaque black without alpha.
+	{
+		const uint8_t block[ 8 ] = { 0x1F, 0x00, 0x00, 0xF8, 0xE4, 0xE4, 0xE4, 0xE4 };
+		auto texels = DecodeBlock( _internal::TextureContainerFormat::BC1_RGBA_UNORM, block );
+		ExpectTexel( texels, 2, { 127, 0, 127, 255 }, "BC1 3 color interpolation is wrong." );
+		ExpectTexel( texels, 3, { 0, 0, 0, 0 }, "BC1 transparent texel is wrong." );
+		texels = DecodeBlock( _internal::TextureContainerFormat::BC1_RGB_UNORM, block );
+		ExpectTexel( texels, 3, { 0, 0, 0, 255 }, "BC1 without alpha must be opaque." );
+	}
+	// BC2 explicit alpha, BC2 colors always use 4 color mode.
+	{
+		const uint8_t block[ 16 ] = {
+			0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE,
+			0x1F, 0x00, 0x00, 0xF8, 0xE4, 0xE4, 0xE4, 0xE4
+		};
+		auto texels = DecodeBlock( _internal::TextureContainerFormat::BC2_UNORM, block );
+		ExpectTexel( texels, 0, { 0, 0, 255, 0 }, "BC2 texel 0 is wrong." );
+		ExpectTexel( texels, 3, { 170, 0, 85, 51 }, "BC2 texel 3 is wrong." );
+		ExpectTexel( texels, 15, { 170, 0, 85, 255 }, "BC2 texel 15 is wrong." );
+	}
+	// BC3 alpha with 8 values, texel i uses alpha index i % 8.
+	{
+		uint64_t alpha_indices = 0;
+		for( uint32_t i = 0; i < 16; ++i ) alpha_indices |= uint64_t( i % 8 ) << ( i * 3 );
+		uint8_t block[ 16 ] = { 255, 0 };
+		for( uint32_t i = 0; i < 6; ++i ) block[ 2 + i ] = uint8_t( alpha_indices >> ( i * 8 ) );
+		const uint8_t colors[ 8 ] = { 0x00, 0xF8, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00 };
+		memcpy( block + 8, colors, 8 );
+
+		auto texels = DecodeBlock( _internal::TextureContainerFormat::BC3_UNORM, block );
+		const uint8_t expected_alpha[ 8 ] = { 255, 0, 218, 182, 145, 109, 72, 36 };
+		for( uint32_t i = 0; i < 16; ++i ) {
+			ExpectTexel( texels, i, { 255, 0, 0, expected_alpha[ i % 8 ] }, "BC3 alpha is wrong." );
+		}
+
+		// 6 value mode has 0 and 255 at the end.
+		block[ 0 ] = 0;
+		block[ 1 ] = 255;
+		texels = DecodeBlock( _internal::TextureContainerFormat::BC3_UNORM, block );
+		ExpectTexel( texels, 2, { 255, 0, 0, 51 }, "BC3 6 value alpha interpolation is wrong." );
+		ExpectTexel( texels, 6, { 255, 0, 0, 0 }, "BC3 6 value alpha 0 is wrong." );
+		ExpectTexel( texels, 7, { 255, 0, 0, 255 }, "BC3 6 value alpha 255 is wrong." );
+
+		// Same block as BC4 goes to red, BC5 second channel to green.
+		texels = DecodeBlock( _internal::TextureContainerFormat::BC4_UNORM, block );
+		ExpectTexel( texels, 2, { 51, 0, 0, 255 }, "BC4 is wrong." );
+		uint8_t bc5_block[ 16 ] {};
+		memcpy( bc5_block, block, 8 );
+		memcpy( bc5_block + 8, block, 8 );
+		bc5_block[ 8 ] = 255;
+		bc5_block[ 9 ] = 0;
+		texels = DecodeBlock( _internal::TextureContainerFormat::BC5_UNORM, bc5_block );
+		ExpectTexel( texels, 2, { 51, 218, 0, 255 }, "BC5 is wrong." );
+	}
+	// BC7 mode 6, endpoints 0 and 127 with p-bit 1, 4 bit index i for texel i.
+	{
+		BlockBitWriter writer;
+		writer.Write( 1 << 6, 7 );
+		for( uint32_t c = 0; c < 4; ++c ) {
+			writer.Write( 0, 7 );
+			writer.Write( 127, 7 );
+		}
+		writer.Write( 1, 1 );
+		writer.Write( 1, 1 );
+		for( uint32_t i = 0; i < 16; ++i ) writer.Write( i, i == 0 ? 3 : 4 );
+		if( writer.position != 128 ) Fail( "BC7 test block is not 128 bits." );
+
+		auto texels = DecodeBlock( _internal::TextureContainerFormat::BC7_UNORM, writer.block.data() );
+		ExpectTexel( texels, 0, { 1, 1, 1, 1 }, "BC7 endpoint 0 is wrong." );
+		ExpectTexel( texels, 8, { 136, 136, 136, 136 }, "BC7 interpolation is wrong." );
+		ExpectTexel( texels, 15, { 255, 255, 255, 255 }, "BC7 endpoint 1 is wrong." );
+
+		// Reserved mode.
+		const uint8_t reserved[ 16 ] = {};
+		texels = DecodeBlock( _internal::TextureContainerFormat::BC7_UNORM, reserved );
+		ExpectTexel( texels, 5, { 0, 0, 0, 0 }, "BC7 reserved mode must decode to zero." );
+	}
+	// BC6H mode 11, unsigned endpoints 0 and ( 1023, 512, 1023 ), 4 bit index i for texel i.
+	// Values above 1.0 are clamped.
+	{
+		BlockBitWriter writer;
+		writer.Write( 0x03, 5 );
+		for( uint32_t c = 0; c < 3; ++c ) writer.Write( 0, 10 );
+		writer.Write( 1023, 10 );
+		writer.Write( 512, 10 );
+		writer.Write( 1023, 10 );
+		for( uint32_t i = 0; i < 16; ++i ) writer.Write( i, i == 0 ? 3 : 4 );
+
+		auto texels = DecodeBlock( _internal::TextureContainerFormat::BC6H_UFLOAT, writer.block.data() );
+		ExpectTexel( texels, 0, { 0, 0, 0, 255 }, "BC6H endpoint 0 is wrong." );
+		ExpectTexel( texels, 6, { 51, 1, 51, 255 }, "BC6H interpolation is wrong." );
+		ExpectTexel( texels, 7, { 195, 1, 195, 255 }, "BC6H interpolation is wrong." );
+		ExpectTexel( texels, 15, { 255, 255, 255, 255 }, "BC6H endpoint 1 is wrong." );
+	}
+}
+
+void EdgeBlockCheck()
+{
+	// 6 * 5 BC1 image is 2 * 2 blocks, blocks at the edges are partially used.
+	const uint8_t red[ 8 ]		= { 0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00 };
+	const uint8_t blue[ 8 ]		= { 0x1F, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	vector<uint8_t> blocks;
+	for( auto block : { red, blue, blue, red } ) blocks.insert( blocks.end(), block, block + 8 );
+
+	_internal::TextureContainerImage image {};
+	image.data		= blocks.data();
+	image.size		= blocks.size();
+	image.width		= 6;
+	image.height	= 5;
+	vector<uint8_t> texels( 6 * 5 * 4 );
+	if( !_internal::DecodeTextureContainerImage( _internal::TextureContainerFormat::BC1_RGB_UNORM, image, texels.data() ) ) Fail( "Cannot decode edge blocks." );
+
+	for( uint32_t y = 0; y < 5; ++y ) {
+		for( uint32_t x = 0; x < 6; ++x ) {
+			bool is_red = ( x < 4 ) == ( y < 4 );
+			auto texel = texels.data() + ( y * 6 + x ) * 4;
+			if( texel[ 0 ] != ( is_red ? 255 : 0 ) || texel[ 2 ] != ( is_red ? 0 : 255 ) ) Fail( "Edge block texels are wrong." );
+		}
+	}
+
+	image.size = blocks.size() - 1;
+	if( _internal::DecodeTextureContainerImage( _internal::TextureContainerFormat::BC1_RGB_UNORM, image, texels.data() ) ) Fail( "Too small image decoded." );
+}
+
+
+
+int main()
+{
+	KTX2Check();
+	DDSCheck();
+	BlockDecodeCheck();
+	EdgeBlockCheck();
+
+	return 0;
+}
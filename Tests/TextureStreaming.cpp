@@ -0,0 +1,99 @@
+
+#include <VK2D.h>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Loads a texture larger than a staging buffer page, which is streamed to the
+// GPU in chunks through the loader thread staging stream, several times over
+// the stream's chunk ring. Every texel row has its own color, a screenshot of
+// the bottom of the texture checks that rows from every chunk landed where
+// they belong.
+
+
+
+constexpr uint32_t TEXTURE_WIDTH			= 8192;
+constexpr uint32_t TEXTURE_HEIGHT			= 1100;
+constexpr uint32_t WINDOW_SIZE				= 512;
+
+// Texture row shown at the top of the window.
+constexpr uint32_t FIRST_VISIBLE_ROW		= TEXTURE_HEIGHT - WINDOW_SIZE;
+
+
+
+Color8 GetRowColor( uint32_t row )
+{
+	return Color8( uint8_t( row ), uint8_t( row >> 8 ), 128, 255 );
+}
+
+class EventHandler : public WindowEventHandler
+{
+public:
+	void VK2D_APIENTRY EventScreenshot(
+		Window							*	window,
+		const filesystem::path			&	screenshot_path,
+		const ImageData					&	screenshot_data,
+		bool								success,
+		const string					&	error_message
+	)
+	{
+		if( !success ) ExitWithCode( ExitCodes::CANNOT_READ_FILE );
+		if( screenshot_data.size.x < WINDOW_SIZE || screenshot_data.size.y < WINDOW_SIZE ) ExitWithCode( ExitCodes::RENDER_SAMPLE_OUT_OF_BOUNDS );
+
+		for( uint32_t y = 0; y < WINDOW_SIZE; y += 7 ) {
+			auto expected	= GetRowColor( FIRST_VISIBLE_ROW + y );
+			auto & texel	= screenshot_data.data[ size_t( y ) * screenshot_data.size.x + ( y * 13 ) % WINDOW_SIZE ];
+			if( abs( int( texel.r ) - int( expected.r ) ) > 1 ||
+				abs( int( texel.g ) - int( expected.g ) ) > 1 ) {
+				cout << "Test: Row " << FIRST_VISIBLE_ROW + y << " has wrong texels.\n";
+				ExitWithCode( ExitCodes::RENDER_DOES_NOT_MATCH_EXPECTED_RESULT );
+			}
+		}
+		ExitWithCode( ExitCodes::SUCCESS );
+	}
+};
+
+
+
+int main()
+{
+	InstanceCreateInfo instance_create_info {};
+	auto instance = CreateInstance( instance_create_info );
+	if( !instance ) ExitWithCode( ExitCodes::CANNOT_CREATE_INSTANCE );
+
+	EventHandler event_handler;
+	WindowCreateInfo window_create_info {};
+	window_create_info.size				= { WINDOW_SIZE, WINDOW_SIZE };
+	window_create_info.event_handler	= &event_handler;
+	window_create_info.coordinate_space	= RenderCoordinateSpace::TEXEL_SPACE;
+	auto window = instance->CreateOutputWindow( window_create_info );
+	if( !window ) ExitWithCode( ExitCodes::CANNOT_CREATE_WINDOW );
+
+	vector<Color8> texels( size_t( TEXTURE_WIDTH ) * TEXTURE_HEIGHT );
+	for( uint32_t row = 0; row < TEXTURE_HEIGHT; ++row ) {
+		fill( texels.begin() + size_t( row ) * TEXTURE_WIDTH, texels.begin() + size_t( row + 1 ) * TEXTURE_WIDTH, GetRowColor( row ) );
+	}
+
+	auto resource_manager = instance->GetResourceManager();
+	auto texture = resource_manager->CreateTextureResource( { TEXTURE_WIDTH, TEXTURE_HEIGHT }, texels );
+	if( !texture || texture->WaitUntilLoaded() != ResourceStatus::LOADED ) Fail( "Cannot load texture." );
+
+	// Screenshot event ends the test.
+	for( uint32_t frame = 0; frame < 100; ++frame ) {
+		if( !window->BeginRender() ) ExitWithCode( ExitCodes::CANNOT_BEGIN_RENDER );
+		window->DrawTexture( { 0.0f, -float( FIRST_VISIBLE_ROW ) }, texture );
+		if( frame == 0 ) {
+			window->TakeScreenshotToData( false );
+		}
+		if( !window->EndRender() ) ExitWithCode( ExitCodes::CANNOT_END_RENDER );
+	}
+	ExitWithCode( ExitCodes::RENDER_DOES_NOT_MATCH_EXPECTED_RESULT );
+}
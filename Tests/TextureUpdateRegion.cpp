@@ -0,0 +1,103 @@
+
+#include <VK2D.h>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Updates an area of a loaded texture every frame and checks from a screenshot
+// that the area shows the texels of the last update while the rest of the
+// texture keeps its original texels. Updates outside of the texture must fail.
+
+
+
+constexpr uint32_t TEXTURE_SIZE				= 256;
+constexpr uint32_t UPDATE_FRAME_COUNT		= 20;
+
+const Rect2u UPDATE_AREA { 64, 64, 160, 128 };
+
+
+
+class EventHandler : public WindowEventHandler
+{
+public:
+	void VK2D_APIENTRY EventScreenshot(
+		Window							*	window,
+		const filesystem::path			&	screenshot_path,
+		const ImageData					&	screenshot_data,
+		bool								success,
+		const string					&	error_message
+	)
+	{
+		if( !success ) ExitWithCode( ExitCodes::CANNOT_READ_FILE );
+		if( screenshot_data.size.x < TEXTURE_SIZE || screenshot_data.size.y < TEXTURE_SIZE ) ExitWithCode( ExitCodes::RENDER_SAMPLE_OUT_OF_BOUNDS );
+
+		// Sampled away from area edges, texture may be filtered there.
+		bool is_good =
+			VerifyImageWithSingleSample( { { 100, 90 }, Color8( 0, 0, 255, 255 ) }, screenshot_data ) &&
+			VerifyImageWithSingleSample( { { 150, 120 }, Color8( 0, 0, 255, 255 ) }, screenshot_data ) &&
+			VerifyImageWithSingleSample( { { 30, 30 }, Color8( 255, 0, 0, 255 ) }, screenshot_data ) &&
+			VerifyImageWithSingleSample( { { 200, 200 }, Color8( 255, 0, 0, 255 ) }, screenshot_data ) &&
+			VerifyImageWithSingleSample( { { 100, 150 }, Color8( 255, 0, 0, 255 ) }, screenshot_data );
+		ExitWithCode( is_good ? ExitCodes::SUCCESS : ExitCodes::RENDER_DOES_NOT_MATCH_EXPECTED_RESULT );
+	}
+};
+
+
+
+int main()
+{
+	InstanceCreateInfo instance_create_info {};
+	auto instance = CreateInstance( instance_create_info );
+	if( !instance ) ExitWithCode( ExitCodes::CANNOT_CREATE_INSTANCE );
+
+	EventHandler event_handler;
+	WindowCreateInfo window_create_info {};
+	window_create_info.size				= { 512, 512 };
+	window_create_info.event_handler	= &event_handler;
+	window_create_info.coordinate_space	= RenderCoordinateSpace::TEXEL_SPACE;
+	auto window = instance->CreateOutputWindow( window_create_info );
+	if( !window ) ExitWithCode( ExitCodes::CANNOT_CREATE_WINDOW );
+
+	auto resource_manager = instance->GetResourceManager();
+	auto texture = resource_manager->CreateTextureResource(
+		{ TEXTURE_SIZE, TEXTURE_SIZE },
+		vector<Color8>( size_t( TEXTURE_SIZE ) * TEXTURE_SIZE, Color8( 255, 0, 0, 255 ) )
+	);
+	if( !texture || texture->WaitUntilLoaded() != ResourceStatus::LOADED ) Fail( "Cannot load texture." );
+
+	auto area_size = UPDATE_AREA.bottom_right - UPDATE_AREA.top_left;
+	vector<Color8> texels( size_t( area_size.x ) * area_size.y );
+
+	if( texture->UpdateRegion( { 200, 200, 300, 210 }, 0, texels ) ) Fail( "Update outside of the texture succeeded." );
+	if( texture->UpdateRegion( UPDATE_AREA, 1, texels ) ) Fail( "Update of a missing layer succeeded." );
+	if( texture->UpdateRegion( UPDATE_AREA, 0, vector<Color8>( 10 ) ) ) Fail( "Update with too few texels succeeded." );
+
+	// Changes every frame like video would, last update is blue.
+	for( uint32_t frame = 0; frame < UPDATE_FRAME_COUNT; ++frame ) {
+		auto color = frame + 1 == UPDATE_FRAME_COUNT ? Color8( 0, 0, 255, 255 ) : Color8( uint8_t( frame * 10 ), 255, 0, 255 );
+		fill( texels.begin(), texels.end(), color );
+		if( !texture->UpdateRegion( UPDATE_AREA, 0, texels, frame % 2 == 0 ) ) Fail( "Cannot update texture." );
+
+		if( !window->BeginRender() ) ExitWithCode( ExitCodes::CANNOT_BEGIN_RENDER );
+		window->DrawTexture( { 0.0f, 0.0f }, texture );
+		if( frame + 1 == UPDATE_FRAME_COUNT ) {
+			window->TakeScreenshotToData( false );
+		}
+		if( !window->EndRender() ) ExitWithCode( ExitCodes::CANNOT_END_RENDER );
+	}
+
+	// Screenshot event ends the test.
+	for( uint32_t frame = 0; frame < 100; ++frame ) {
+		if( !window->BeginRender() ) ExitWithCode( ExitCodes::CANNOT_BEGIN_RENDER );
+		window->DrawTexture( { 0.0f, 0.0f }, texture );
+		if( !window->EndRender() ) ExitWithCode( ExitCodes::CANNOT_END_RENDER );
+	}
+	ExitWithCode( ExitCodes::RENDER_DOES_NOT_MATCH_EXPECTED_RESULT );
+}
@@ -0,0 +1,162 @@
+
+#include <VK2D.h>
+
+#include "TestCommon.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+using namespace vk2d;
+
+
+
+// Measures how much texture uploads get in the way of rendering. Frames are
+// rendered without vsync while a burst of large textures loads, once with mip
+// levels blitted on the render queues and once with mip levels generated on the
+// CPU, which uploads on the transfer queue alone. Frame times of both are
+// compared to frames rendered while nothing loads. Times are printed, only
+// rendering and loading failures fail the test.
+
+
+
+constexpr uint32_t TEXTURE_SIZE				= 1024;
+constexpr uint32_t TEXTURE_COUNT			= 24;
+constexpr uint32_t IDLE_FRAME_COUNT			= 200;
+
+
+
+vector<vector<Color8>> MakeTextures( uint32_t seed )
+{
+	// Every texture is different, same texel data would return the same resource.
+	mt19937 random( seed );
+	vector<vector<Color8>> textures( TEXTURE_COUNT );
+	for( auto & t : textures ) {
+		t.resize( size_t( TEXTURE_SIZE ) * TEXTURE_SIZE );
+		for( auto & c : t ) {
+			auto r = random();
+			c = Color8( uint8_t( r ), uint8_t( r >> 8 ), uint8_t( r >> 16 ), 255 );
+		}
+	}
+	return textures;
+}
+
+void RenderFrame( Window * window, uint32_t frame )
+{
+	if( !window->BeginRender() ) ExitWithCode( ExitCodes::CANNOT_BEGIN_RENDER );
+	for( uint32_t i = 0; i < 64; ++i ) {
+		auto x = float( ( i * 37 + frame * 3 ) % 480 );
+		auto y = float( ( i * 53 + frame * 5 ) % 480 );
+		window->DrawRectangle( { x, y, x + 32.0f, y + 32.0f }, true, { 0.2f, 0.5f, 1.0f, 0.5f } );
+	}
+	if( !window->EndRender() ) ExitWithCode( ExitCodes::CANNOT_END_RENDER );
+}
+
+struct FrameTimes {
+	vector<double>					frame_ms;
+	double							total_ms		= {};
+};
+
+void PrintFrameTimes( const char * name, FrameTimes times )
+{
+	if( times.frame_ms.empty() ) times.frame_ms.push_back( 0.0 );
+	sort( times.frame_ms.begin(), times.frame_ms.end() );
+	auto Percentile = [ & ]( double p )
+	{
+		return times.frame_ms[ min( times.frame_ms.size() - 1, size_t( p * double( times.frame_ms.size() ) ) ) ];
+	};
+	cout << fixed << setprecision( 2 );
+	cout << setw( 22 ) << name
+		<< setw( 10 ) << times.frame_ms.size()
+		<< setw( 12 ) << Percentile( 0.5 )
+		<< setw( 12 ) << Percentile( 0.99 )
+		<< setw( 12 ) << times.frame_ms.back()
+		<< setw( 12 ) << times.total_ms << "\n";
+}
+
+FrameTimes RenderIdle( Window * window )
+{
+	FrameTimes times;
+	auto begin = chrono::steady_clock::now();
+	auto previous = begin;
+	for( uint32_t frame = 0; frame < IDLE_FRAME_COUNT; ++frame ) {
+		RenderFrame( window, frame );
+		auto now = chrono::steady_clock::now();
+		times.frame_ms.push_back( chrono::duration<double, milli>( now - previous ).count() );
+		previous = now;
+	}
+	times.total_ms = chrono::duration<double, milli>( previous - begin ).count();
+	return times;
+}
+
+FrameTimes RenderWhileLoading( Instance * instance, Window * window, TextureMipFilter filter, uint32_t seed )
+{
+	auto resource_manager = instance->GetResourceManager();
+
+	TextureMipGenerationSettings mip_settings {};
+	mip_settings.filter = filter;
+	resource_manager->SetTextureMipGeneration( mip_settings );
+
+	auto texels = MakeTextures( seed );
+
+	FrameTimes times;
+	auto begin = chrono::steady_clock::now();
+	vector<TextureResource*> textures;
+	for( auto & t : texels ) {
+		textures.push_back( resource_manager->CreateTextureResource( { TEXTURE_SIZE, TEXTURE_SIZE }, t ) );
+		if( !textures.back() ) Fail( "Cannot create texture." );
+	}
+
+	auto previous = chrono::steady_clock::now();
+	uint32_t frame = 0;
+	while( any_of( textures.begin(), textures.end(), []( TextureResource * t ) { return t->GetStatus() == ResourceStatus::UNDETERMINED; } ) ) {
+		RenderFrame( window, frame++ );
+		auto now = chrono::steady_clock::now();
+		times.frame_ms.push_back( chrono::duration<double, milli>( now - previous ).count() );
+		previous = now;
+	}
+	times.total_ms = chrono::duration<double, milli>( chrono::steady_clock::now() - begin ).count();
+
+	for( auto t : textures ) {
+		if( t->GetStatus() != ResourceStatus::LOADED ) Fail( "Texture failed to load." );
+		resource_manager->DestroyResource( t );
+	}
+	resource_manager->SetTextureMipGeneration( {} );
+	return times;
+}
+
+
+
+int main()
+{
+	InstanceCreateInfo instance_create_info {};
+	auto instance = CreateInstance( instance_create_info );
+	if( !instance ) ExitWithCode( ExitCodes::CANNOT_CREATE_INSTANCE );
+
+	WindowCreateInfo window_create_info {};
+	window_create_info.size				= { 512, 512 };
+	window_create_info.coordinate_space	= RenderCoordinateSpace::TEXEL_SPACE;
+	window_create_info.vsync			= false;
+	auto window = instance->CreateOutputWindow( window_create_info );
+	if( !window ) ExitWithCode( ExitCodes::CANNOT_CREATE_WINDOW );
+
+	// Warm up so first frames and first loads don't skew the results.
+	RenderIdle( window );
+	RenderWhileLoading( instance.get(), window, TextureMipFilter::GPU_LINEAR, 1 );
+
+	auto idle			= RenderIdle( window );
+	auto render_queue	= RenderWhileLoading( instance.get(), window, TextureMipFilter::GPU_LINEAR, 2 );
+	auto transfer_queue	= RenderWhileLoading( instance.get(), window, TextureMipFilter::BOX, 3 );
+
+	cout << TEXTURE_COUNT << " textures of " << TEXTURE_SIZE << " * " << TEXTURE_SIZE << ".\n";
+	cout << setw( 22 ) << "" << setw( 10 ) << "frames" << setw( 12 ) << "median ms" << setw( 12 ) << "99% ms" << setw( 12 ) << "worst ms" << setw( 12 ) << "total ms" << "\n";
+	PrintFrameTimes( "idle", idle );
+	PrintFrameTimes( "render queue mips", render_queue );
+	PrintFrameTimes( "transfer queue only", transfer_queue );
+
+	ExitWithCode( ExitCodes::SUCCESS );
+}
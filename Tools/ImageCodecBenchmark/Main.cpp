@@ -0,0 +1,226 @@
+
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+#include <System/QOI.hpp>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+
+// Measures how fast images of a directory decode and encode with QOI compared
+// to the stb paths VK2D otherwise uses, see Source/System/QOI.hpp.
+//
+// Usage: ImageCodecBenchmark -input <directory> [-repeat <count>]
+//
+// "stb decode" decodes the original file like texture loading does,
+// "stb encode" encodes PNG like screenshots do. Every image is also checked
+// to survive a QOI round trip unchanged. Throughput is in megabytes of RGBA
+// texels per second, best of -repeat runs.
+
+
+fs::path	input_location		= {};
+uint32_t	repeat_count		= 5;
+
+
+struct CodecTimes {
+	double		stb_decode			= {};
+	double		stb_encode			= {};
+	double		qoi_decode			= {};
+	double		qoi_encode			= {};
+	uint64_t	texel_bytes			= {};
+	uint64_t	source_bytes		= {};
+	uint64_t	png_bytes			= {};
+	uint64_t	qoi_bytes			= {};
+};
+
+
+vector<uint8_t>		ReadFile( const fs::path & path );
+double				GetBestTime( const function<void()> & work );
+bool				BenchmarkFile( const fs::path & path, CodecTimes & times );
+void				PrintThroughput( const string & name, double seconds, uint64_t bytes );
+
+
+
+int main( int argc, char * argv[] )
+{
+	{
+		vector<string> args;
+		for( int i = 0; i < argc; ++i ) {
+			args.push_back( argv[ i ] );
+		}
+		auto argit = args.begin();
+		while( argit != args.end() ) {
+			string a = *argit;
+			transform( a.begin(), a.end(), a.begin(), []( unsigned char c )
+				{
+					return tolower( c );
+				} );
+
+			if( a == "-input" || a == "-repeat" ) {
+				++argit;
+				if( argit == args.end() ) {
+					cout << a << " option needs to be followed with a value.\n";
+					exit( -1 );
+				}
+				if( a == "-input" )		input_location	= *argit;
+				else					repeat_count	= uint32_t( max( 1, atoi( argit->c_str() ) ) );
+			}
+
+			++argit;
+		}
+	}
+
+	if( input_location.empty() ) {
+		cout << "Usage: ImageCodecBenchmark -input <directory> [-repeat <count>]\n";
+		exit( -1 );
+	}
+	if( !fs::is_directory( input_location ) ) {
+		cout << "Input directory not found: " << input_location << "\n";
+		exit( -1 );
+	}
+
+	CodecTimes total {};
+	uint64_t image_count = 0;
+	for( auto & file : fs::recursive_directory_iterator( input_location ) ) {
+		if( !file.is_regular_file() ) continue;
+		if( BenchmarkFile( file.path(), total ) ) {
+			++image_count;
+		}
+	}
+	if( !image_count ) {
+		cout << "No images found in: " << input_location << "\n";
+		exit( -1 );
+	}
+
+	cout << image_count << " images, " << total.texel_bytes / ( 1024 * 1024 ) << " MB of RGBA texels.\n";
+	cout << "Encoded size: source files " << total.source_bytes / 1024 << " KB, PNG " << total.png_bytes / 1024
+		<< " KB, QOI " << total.qoi_bytes / 1024 << " KB.\n\n";
+	cout << setw( 14 ) << "" << setw( 14 ) << "MB/s" << setw( 14 ) << "ms" << "\n";
+	PrintThroughput( "stb decode", total.stb_decode, total.texel_bytes );
+	PrintThroughput( "QOI decode", total.qoi_decode, total.texel_bytes );
+	PrintThroughput( "stb encode", total.stb_encode, total.texel_bytes );
+	PrintThroughput( "QOI encode", total.qoi_encode, total.texel_bytes );
+
+	return 0;
+}
+
+
+vector<uint8_t> ReadFile( const fs::path & path )
+{
+	auto file = ifstream( path, ios::binary );
+	if( !file.is_open() ) {
+		cout << "Couldn't open file: " << path << "\n";
+		exit( -1 );
+	}
+	return vector<uint8_t>( istreambuf_iterator<char>( file ), istreambuf_iterator<char>() );
+}
+
+
+double GetBestTime( const function<void()> & work )
+{
+	double best = numeric_limits<double>::max();
+	for( uint32_t i = 0; i < repeat_count; ++i ) {
+		auto begin = chrono::steady_clock::now();
+		work();
+		best = min( best, chrono::duration<double>( chrono::steady_clock::now() - begin ).count() );
+	}
+	return best;
+}
+
+
+bool BenchmarkFile( const fs::path & path, CodecTimes & times )
+{
+	auto source = ReadFile( path );
+	if( source.empty() || source.size() > size_t( INT32_MAX ) ) return false;
+
+	// QOI files are measured against the PNG encoded from their texels.
+	bool is_qoi_source = vk2d::_internal::IsQOIImage( source.data(), source.size() );
+
+	vector<uint8_t> texels;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	if( is_qoi_source ) {
+		if( !vk2d::_internal::DecodeQOI( source.data(), source.size(), texels, width, height ) ) return false;
+	} else {
+		int x = 0;
+		int y = 0;
+		int channels = 0;
+		auto stbi_texels = stbi_load_from_memory( source.data(), int( source.size() ), &x, &y, &channels, 4 );
+		if( !stbi_texels ) return false;
+		width	= uint32_t( x );
+		height	= uint32_t( y );
+		texels.assign( stbi_texels, stbi_texels + size_t( x ) * size_t( y ) * 4 );
+		stbi_image_free( stbi_texels );
+	}
+
+	int png_size = 0;
+	auto png = stbi_write_png_to_mem( texels.data(), 0, int( width ), int( height ), 4, &png_size );
+	if( !png ) {
+		cout << "Couldn't encode PNG: " << path << "\n";
+		exit( -1 );
+	}
+
+	vector<uint8_t> qoi;
+	if( !vk2d::_internal::EncodeQOI( texels.data(), width, height, 4, qoi ) ) {
+		cout << "Couldn't encode QOI: " << path << "\n";
+		exit( -1 );
+	}
+
+	vector<uint8_t> qoi_texels( texels.size() );
+	if( !vk2d::_internal::DecodeQOI( qoi.data(), qoi.size(), qoi_texels.data(), qoi_texels.size() ) || qoi_texels != texels ) {
+		cout << "QOI round trip changed the image: " << path << "\n";
+		exit( -1 );
+	}
+
+	auto stb_decode_data = is_qoi_source ? png : source.data();
+	auto stb_decode_size = is_qoi_source ? png_size : int( source.size() );
+	times.stb_decode += GetBestTime( [ & ]()
+		{
+			int x = 0;
+			int y = 0;
+			int channels = 0;
+			stbi_image_free( stbi_load_from_memory( stb_decode_data, stb_decode_size, &x, &y, &channels, 4 ) );
+		} );
+	times.qoi_decode += GetBestTime( [ & ]()
+		{
+			vk2d::_internal::DecodeQOI( qoi.data(), qoi.size(), qoi_texels.data(), qoi_texels.size() );
+		} );
+	times.stb_encode += GetBestTime( [ & ]()
+		{
+			int size = 0;
+			free( stbi_write_png_to_mem( texels.data(), 0, int( width ), int( height ), 4, &size ) );
+		} );
+	vector<uint8_t> qoi_encoded;
+	times.qoi_encode += GetBestTime( [ & ]()
+		{
+			vk2d::_internal::EncodeQOI( texels.data(), width, height, 4, qoi_encoded );
+		} );
+
+	times.texel_bytes	+= texels.size();
+	times.source_bytes	+= source.size();
+	times.png_bytes		+= uint64_t( png_size );
+	times.qoi_bytes		+= qoi.size();
+	free( png );
+	return true;
+}
+
+
+void PrintThroughput( const string & name, double seconds, uint64_t bytes )
+{
+	cout << fixed << setprecision( 1 );
+	cout << setw( 14 ) << name << setw( 14 ) << double( bytes ) / ( 1024.0 * 1024.0 ) / seconds << setw( 14 ) << seconds * 1000.0 << "\n";
+}
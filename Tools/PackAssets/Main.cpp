@@ -0,0 +1,157 @@
+
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <string>
+
+#include <System/AssetPack.hpp>
+#include <System/QOI.hpp>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+
+// Builds an asset pack from every file in a directory, see Source/System/AssetPack.hpp.
+//
+// Usage: PackAssets -input <directory> -output <pack file> [-prefix <path>] [-raw]
+//
+// Paths in the pack are relative to the input directory, optionally prefixed
+// with -prefix, eg. "-input Data -prefix Data" stores "Data/Textures/Icon.png"
+// so the same path works with and without the pack mounted.
+// -raw stores images decoded to RGBA texels so they're copied to the GPU
+// without decoding at load time, takes more space. Files that are not images
+// are stored as is.
+
+
+fs::path	input_location		= {};
+fs::path	output_file			= {};
+fs::path	path_prefix			= {};
+bool		store_raw_images	= {};
+
+
+vector<uint8_t>								ReadFile( const fs::path & path );
+vk2d::_internal::AssetPackSourceEntry		GetSourceEntryForFile( const fs::path & path );
+
+
+
+int main( int argc, char * argv[] )
+{
+	{
+		vector<string> args;
+		for( int i = 0; i < argc; ++i ) {
+			args.push_back( argv[ i ] );
+		}
+		auto argit = args.begin();
+		while( argit != args.end() ) {
+			string a = *argit;
+			transform( a.begin(), a.end(), a.begin(), []( unsigned char c )
+				{
+					return tolower( c );
+				} );
+
+			if( a == "-raw" ) {
+				store_raw_images = true;
+			} else if( a == "-input" || a == "-output" || a == "-prefix" ) {
+				++argit;
+				if( argit == args.end() ) {
+					cout << a << " option needs to be followed with a path.\n";
+					exit( -1 );
+				}
+				if( a == "-input" )			input_location	= *argit;
+				else if( a == "-output" )	output_file		= *argit;
+				else						path_prefix		= *argit;
+			}
+
+			++argit;
+		}
+	}
+
+	if( input_location.empty() || output_file.empty() ) {
+		cout << "Usage: PackAssets -input <directory> -output <pack file> [-prefix <path>] [-raw]\n";
+		exit( -1 );
+	}
+	if( !fs::is_directory( input_location ) ) {
+		cout << "Input directory not found: " << input_location << "\n";
+		exit( -1 );
+	}
+
+	cout << "Running asset packer.\n"
+		<< "    Input directory: " << input_location << "\n"
+		<< "    Output file: " << output_file << "\n\n";
+
+	vector<vk2d::_internal::AssetPackSourceEntry> source_entries;
+	uint64_t raw_image_count = 0;
+	for( auto & file : fs::recursive_directory_iterator( input_location ) ) {
+		if( !file.is_regular_file() ) continue;
+		std::error_code error;
+		if( fs::equivalent( file.path(), output_file, error ) ) continue;
+
+		source_entries.push_back( GetSourceEntryForFile( file.path() ) );
+		if( source_entries.back().payload == vk2d::_internal::AssetPackPayload::RAW_RGBA8 ) {
+			++raw_image_count;
+		}
+	}
+
+	if( !vk2d::_internal::WriteAssetPack( output_file, std::move( source_entries ) ) ) {
+		cout << "Couldn't write asset pack: " << output_file << "\n";
+		exit( -1 );
+	}
+
+	vk2d::_internal::AssetPack verify( output_file );
+	if( !verify.IsGood() ) {
+		cout << "Written asset pack is not valid: " << output_file << "\n";
+		exit( -1 );
+	}
+
+	cout << "Packed " << verify.GetEntryCount() << " files, " << raw_image_count << " as raw images, "
+		<< fs::file_size( output_file ) << " bytes.\n";
+	cout << "Asset packer completed successfully." << endl;
+
+	return 0;
+}
+
+
+vector<uint8_t> ReadFile( const fs::path & path )
+{
+	auto file = ifstream( path, ios::binary );
+	if( !file.is_open() ) {
+		cout << "Couldn't open file: " << path << "\n";
+		exit( -1 );
+	}
+	return vector<uint8_t>( istreambuf_iterator<char>( file ), istreambuf_iterator<char>() );
+}
+
+
+vk2d::_internal::AssetPackSourceEntry GetSourceEntryForFile( const fs::path & path )
+{
+	vk2d::_internal::AssetPackSourceEntry entry {};
+	entry.path		= ( path_prefix / fs::relative( path, input_location ) ).generic_string();
+	entry.payload	= vk2d::_internal::AssetPackPayload::ENCODED;
+	entry.data		= ReadFile( path );
+
+	if( store_raw_images && vk2d::_internal::IsQOIImage( entry.data.data(), entry.data.size() ) ) {
+		std::vector<uint8_t> texels;
+		if( vk2d::_internal::DecodeQOI( entry.data.data(), entry.data.size(), texels, entry.width, entry.height ) ) {
+			entry.payload	= vk2d::_internal::AssetPackPayload::RAW_RGBA8;
+			entry.data		= std::move( texels );
+		}
+	} else if( store_raw_images && entry.data.size() <= size_t( INT32_MAX ) ) {
+		int x = 0;
+		int y = 0;
+		int channels = 0;
+		auto texels = stbi_load_from_memory( entry.data.data(), int( entry.data.size() ), &x, &y, &channels, 4 );
+		if( texels ) {
+			entry.payload	= vk2d::_internal::AssetPackPayload::RAW_RGBA8;
+			entry.width		= uint32_t( x );
+			entry.height	= uint32_t( y );
+			entry.data.assign( texels, texels + size_t( x ) * size_t( y ) * 4 );
+			stbi_image_free( texels );
+		}
+	}
+	return entry;
+}